@@ -0,0 +1,238 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "DStarDefines.h"
+#include "AMBEFEC.h"
+#include "Bench.h"
+#include "Golay.h"
+#include "Utils.h"
+
+#include <wx/wx.h>
+
+#include <cstdlib>
+
+const char BENCH_NAME[] = "ambefecbench";
+
+const CBenchOption BENCH_OPTIONS[] = {
+	{wxT("codes"),  wxT("received Golay codewords to decode"),             10000000L, 1L, 100000000L},
+	{wxT("frames"), wxT("voice frames to regenerate"),                      1000000L, 1L, 100000000L},
+	{wxT("ber"),    wxT("bit error rate of the received data in 1/1000"),        20L, 0L, 1000L}};
+
+const unsigned int BENCH_OPTION_COUNT = 3U;
+
+const unsigned int CODE_COUNT = 0x1000000U;
+
+// FNV-1a of decode24128() over every 24 bit word in order, from the Golay code before the syndrome table
+const unsigned int GOLAY_HASH = 0x4FDCD885U;
+
+struct CAMBEVector {
+	unsigned char m_in[VOICE_FRAME_LENGTH_BYTES];
+	unsigned char m_out[VOICE_FRAME_LENGTH_BYTES];
+	unsigned int  m_errors;
+};
+
+// Voice frames with up to seven bits in error and what the AMBE FEC before the change made of them
+const CAMBEVector AMBE_VECTORS[] = {
+	{{0xDAU, 0xE2U, 0xD6U, 0xC9U, 0x39U, 0x96U, 0xE3U, 0xEBU, 0x73U}, {0xDAU, 0xE2U, 0xD6U, 0xC9U, 0x39U, 0x96U, 0xE3U, 0xEBU, 0x73U}, 0U},
+	{{0xF9U, 0x09U, 0xE9U, 0xD0U, 0x24U, 0xB1U, 0x6DU, 0x67U, 0x7FU}, {0xF9U, 0x09U, 0xE9U, 0xD1U, 0x24U, 0xB1U, 0x6DU, 0x67U, 0x7FU}, 1U},
+	{{0xC8U, 0x9CU, 0xF8U, 0x83U, 0x9AU, 0xCBU, 0x68U, 0x4BU, 0x7FU}, {0xCAU, 0x9CU, 0xF8U, 0xC3U, 0x9AU, 0xCBU, 0x68U, 0x4BU, 0x7FU}, 2U},
+	{{0xD3U, 0xD5U, 0x17U, 0x2FU, 0x13U, 0xEBU, 0x18U, 0x8FU, 0x54U}, {0xD2U, 0xD4U, 0x17U, 0x2FU, 0x1BU, 0xEBU, 0x18U, 0x8FU, 0x54U}, 3U},
+	{{0x28U, 0x5EU, 0x01U, 0xB7U, 0x75U, 0xDAU, 0xDEU, 0xE6U, 0x00U}, {0x29U, 0x1EU, 0x01U, 0xB7U, 0x75U, 0xDAU, 0xDEU, 0xE6U, 0x00U}, 2U},
+	{{0xF2U, 0xE1U, 0x8EU, 0x9FU, 0xE3U, 0x5DU, 0xA8U, 0x36U, 0x4EU}, {0xB3U, 0xE1U, 0x8EU, 0x9DU, 0xE3U, 0x5DU, 0xA8U, 0x36U, 0x4EU}, 3U},
+	{{0x55U, 0x8BU, 0xDBU, 0xDBU, 0x77U, 0xB3U, 0xA7U, 0x36U, 0xA9U}, {0x55U, 0x8BU, 0xDBU, 0xDBU, 0x77U, 0xB3U, 0xA7U, 0x36U, 0xA9U}, 0U},
+	{{0xB5U, 0xC8U, 0x5BU, 0x36U, 0x9FU, 0x8DU, 0x66U, 0x3BU, 0x21U}, {0xB7U, 0xC8U, 0x57U, 0x36U, 0x9FU, 0x99U, 0x26U, 0x3BU, 0x21U}, 6U},
+	{{0xA1U, 0xE8U, 0x0DU, 0x8CU, 0x64U, 0x5FU, 0xD9U, 0x9CU, 0x11U}, {0xA1U, 0xE8U, 0x0DU, 0x8CU, 0x64U, 0x5FU, 0xD9U, 0x9CU, 0x11U}, 0U},
+	{{0xFBU, 0x39U, 0xBDU, 0xF6U, 0x4AU, 0x96U, 0x69U, 0xA7U, 0xF5U}, {0xFBU, 0x31U, 0xBDU, 0xF6U, 0x4AU, 0x96U, 0x69U, 0xA7U, 0xF5U}, 1U},
+	{{0x80U, 0x34U, 0x8AU, 0x47U, 0x3BU, 0x27U, 0xBAU, 0x9FU, 0xA7U}, {0x80U, 0x34U, 0x8AU, 0x47U, 0x3BU, 0x2FU, 0xBAU, 0x9FU, 0xA7U}, 1U},
+	{{0x52U, 0x79U, 0x10U, 0xA8U, 0x45U, 0x4DU, 0x2EU, 0x89U, 0x4EU}, {0x52U, 0x79U, 0x10U, 0xA8U, 0x45U, 0x4DU, 0x3EU, 0x89U, 0x4EU}, 1U},
+	{{0xD1U, 0x7FU, 0xB2U, 0x69U, 0xB9U, 0x1DU, 0x47U, 0xB7U, 0x60U}, {0xD1U, 0x7BU, 0xB2U, 0x69U, 0xB9U, 0x1DU, 0xC7U, 0xF7U, 0x60U}, 3U},
+	{{0xF3U, 0x0EU, 0xBFU, 0xCAU, 0xBFU, 0x4CU, 0x47U, 0x5CU, 0x5FU}, {0xF1U, 0x0EU, 0xBFU, 0xCAU, 0xBBU, 0x4CU, 0x47U, 0x5CU, 0x4BU}, 4U},
+	{{0xCDU, 0xFEU, 0xB2U, 0x1FU, 0x70U, 0x51U, 0xADU, 0x79U, 0x77U}, {0xCDU, 0xFEU, 0x92U, 0x1FU, 0x70U, 0x55U, 0x0CU, 0xF9U, 0x77U}, 6U},
+	{{0x45U, 0xDCU, 0x1CU, 0x0EU, 0x4EU, 0x7CU, 0x0CU, 0xA3U, 0xA4U}, {0x45U, 0xDCU, 0x1CU, 0x4EU, 0x4EU, 0x78U, 0x0CU, 0x63U, 0xA4U}, 4U}
+};
+
+const unsigned int AMBE_VECTOR_COUNT = 16U;
+
+static unsigned int random24()
+{
+	return ((unsigned int)(::rand() & 0xFFF) << 12) | (unsigned int)(::rand() & 0xFFF);
+}
+
+static void report(const wxChar* name, wxUint64 time, unsigned int count, const wxChar* unit)
+{
+	double ns = CBench::perItem(time, count);
+
+	wxPrintf(wxT("%-22s %6.1f ns a %s, %.0f a second\n"), name, ns, unit, 1.0E9 / ns);
+}
+
+// Every 24 bit word, in order, both to check the decoder against the old one and to time it over all syndromes
+static bool decodeAll()
+{
+	unsigned int hash = 2166136261U;
+
+	wxUint64 start = CUtils::getTimestamp();
+	for (unsigned int i = 0U; i < CODE_COUNT; i++)
+		hash = (hash ^ CGolay::decode24128(i)) * 16777619U;
+	wxUint64 time = CUtils::getTimestamp() - start;
+
+	report(wxT("Golay all words"), time, CODE_COUNT, wxT("decode"));
+
+	if (hash != GOLAY_HASH) {
+		wxPrintf(wxT("Golay decode of all words hashes to %08X, not %08X\n"), hash, GOLAY_HASH);
+		return false;
+	}
+
+	return true;
+}
+
+// Codewords as they come off the air, mostly clean with the odd bit in error
+static void decodeReceived(unsigned int count, unsigned int ber)
+{
+	unsigned int* codes = new unsigned int[count];
+	for (unsigned int i = 0U; i < count; i++) {
+		unsigned int code = CGolay::encode24128(random24() & 0xFFFU);
+
+		for (unsigned int j = 0U; j < 24U; j++) {
+			if ((unsigned int)(::rand() % 1000) < ber)
+				code ^= 0x01U << j;
+		}
+
+		codes[i] = code;
+	}
+
+	unsigned int* data = new unsigned int[count];
+
+	wxUint64 start = CUtils::getTimestamp();
+	for (unsigned int i = 0U; i < count; i++)
+		data[i] = CGolay::decode24128(codes[i]);
+	wxUint64 time = CUtils::getTimestamp() - start;
+
+	report(wxT("Golay received"), time, count, wxT("decode"));
+
+	CBench::sink(data[count - 1U]);
+
+	delete[] codes;
+	delete[] data;
+}
+
+// The vectors one at a time and as a run, laid out as DV frames with their slow data
+static bool checkVectors()
+{
+	CAMBEFEC ambe;
+
+	unsigned char frames[AMBE_VECTOR_COUNT * DV_FRAME_LENGTH_BYTES];
+	unsigned int errors[AMBE_VECTOR_COUNT * 2U];
+	for (unsigned int i = 0U; i < AMBE_VECTOR_COUNT; i++) {
+		::memcpy(frames + i * DV_FRAME_LENGTH_BYTES, AMBE_VECTORS[i].m_in, VOICE_FRAME_LENGTH_BYTES);
+		::memcpy(frames + i * DV_FRAME_LENGTH_BYTES + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
+	}
+
+	ambe.regenerate(frames, AMBE_VECTOR_COUNT, DV_FRAME_LENGTH_BYTES, errors);
+
+	unsigned int mismatches = 0U;
+	for (unsigned int i = 0U; i < AMBE_VECTOR_COUNT; i++) {
+		unsigned char frame[VOICE_FRAME_LENGTH_BYTES];
+		::memcpy(frame, AMBE_VECTORS[i].m_in, VOICE_FRAME_LENGTH_BYTES);
+
+		unsigned int frameErrors = ambe.regenerate(frame);
+
+		unsigned char* run = frames + i * DV_FRAME_LENGTH_BYTES;
+
+		if (frameErrors != AMBE_VECTORS[i].m_errors || ::memcmp(frame, AMBE_VECTORS[i].m_out, VOICE_FRAME_LENGTH_BYTES) != 0)
+			mismatches++;
+		else if (errors[i * 2U + 0U] + errors[i * 2U + 1U] != AMBE_VECTORS[i].m_errors || ::memcmp(run, AMBE_VECTORS[i].m_out, VOICE_FRAME_LENGTH_BYTES) != 0)
+			mismatches++;
+		else if (::memcmp(run + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES) != 0)
+			mismatches++;
+	}
+
+	if (mismatches != 0U) {
+		wxPrintf(wxT("%u of the %u AMBE vectors do not match\n"), mismatches, AMBE_VECTOR_COUNT);
+		return false;
+	}
+
+	return true;
+}
+
+// Voice frames as they come from the network, each followed by its slow data as in a DV frame
+static void regenerateFrames(unsigned int count, unsigned int ber)
+{
+	unsigned int length = count * DV_FRAME_LENGTH_BYTES;
+
+	CAMBEFEC ambe;
+
+	unsigned char* frames = new unsigned char[length];
+	for (unsigned int i = 0U; i < count; i++) {
+		unsigned char* frame = frames + i * DV_FRAME_LENGTH_BYTES;
+
+		ambe.encode(random24() & 0xFFFU, random24() & 0xFFFU, random24(), frame);
+
+		for (unsigned int j = 0U; j < VOICE_FRAME_LENGTH_BYTES * 8U; j++) {
+			if ((unsigned int)(::rand() % 1000) < ber)
+				frame[j / 8U] ^= 0x01U << (j % 8U);
+		}
+
+		for (unsigned int j = VOICE_FRAME_LENGTH_BYTES; j < DV_FRAME_LENGTH_BYTES; j++)
+			frame[j] = ::rand() & 0xFF;
+	}
+
+	unsigned char* run = new unsigned char[length];
+	::memcpy(run, frames, length);
+
+	unsigned int frameErrors = 0U;
+	wxUint64 start = CUtils::getTimestamp();
+	for (unsigned int i = 0U; i < count; i++)
+		frameErrors += ambe.regenerate(frames + i * DV_FRAME_LENGTH_BYTES);
+	wxUint64 frameTime = CUtils::getTimestamp() - start;
+
+	start = CUtils::getTimestamp();
+	unsigned int runErrors = ambe.regenerate(run, count, DV_FRAME_LENGTH_BYTES, NULL);
+	wxUint64 runTime = CUtils::getTimestamp() - start;
+
+	report(wxT("AMBE regenerate"), frameTime, count, wxT("frame"));
+	report(wxT("AMBE regenerate run"), runTime, count, wxT("frame"));
+
+	wxPrintf(wxT("%u errors corrected in %u frames\n"), frameErrors, count);
+
+	CBench::sink(frameErrors + runErrors);
+
+	delete[] frames;
+	delete[] run;
+}
+
+int run()
+{
+	long codes  = CBench::getOption(wxT("codes"));
+	long frames = CBench::getOption(wxT("frames"));
+	long ber    = CBench::getOption(wxT("ber"));
+
+	wxPrintf(wxT("%ld codewords and %ld voice frames at a bit error rate of %ld/1000\n"), codes, frames, ber);
+
+	bool ok = decodeAll();
+	ok = checkVectors() && ok;
+
+	decodeReceived((unsigned int)codes, (unsigned int)ber);
+	regenerateFrames((unsigned int)frames, (unsigned int)ber);
+
+	if (!ok) {
+		wxPrintf(wxT("The new code does not give the same results as the old\n"));
+		return 1;
+	}
+
+	return 0;
+}
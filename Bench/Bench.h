@@ -0,0 +1,55 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	Bench_H
+#define	Bench_H
+
+#include <wx/wx.h>
+
+// A numeric command line option of a bench, given as --name=value
+struct CBenchOption {
+	const wxChar* m_name;
+	const wxChar* m_description;
+	long          m_default;
+	long          m_min;
+	long          m_max;
+};
+
+// Each bench defines these, and BenchMain.cpp has the main() that parses the options and calls run()
+extern const char         BENCH_NAME[];
+extern const CBenchOption BENCH_OPTIONS[];
+extern const unsigned int BENCH_OPTION_COUNT;
+
+extern int run();
+
+class CBench {
+public:
+	// The value given for an option in BENCH_OPTIONS, or its default
+	static long getOption(const wxChar* name);
+
+	// The time for each of count items in ns, from a span of CUtils::getTimestamp()
+	static double perItem(wxUint64 time, unsigned int count);
+
+	// Stops the compiler from removing work whose result is otherwise unused
+	static void sink(unsigned int value);
+	static void sink(wxFloat32 value);
+
+	static void error(const char* text);
+};
+
+#endif
@@ -0,0 +1,24 @@
+# The rules shared by the benches. A bench Makefile sets BENCH to the program and OBJECTS to its own
+# objects, then includes this file.
+
+vpath %.cpp ../Bench
+
+OBJECTS += BenchMain.o
+
+.PHONY: all clean
+
+all: $(BENCH)
+
+$(BENCH):	$(OBJECTS) ../Common/Common.a
+		$(CXX) $(OBJECTS) ../Common/Common.a $(LDFLAGS) $(LIBS) -o $(BENCH)
+
+-include $(OBJECTS:.o=.d)
+
+%.o: %.cpp
+		$(CXX) -DwxUSE_GUI=0 $(CFLAGS) -I../Common -I../Bench -c -o $@ $<
+		$(CXX) -MM -DwxUSE_GUI=0 $(CFLAGS) -I../Common -I../Bench $< > $*.d
+
+clean:
+		$(RM) $(BENCH) *.o *.d *.bak *~
+
+../Common/Common.a:
@@ -0,0 +1,100 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "Bench.h"
+
+#include <wx/init.h>
+#include <wx/cmdline.h>
+
+#include <cstdio>
+
+static long* m_values = NULL;
+
+static volatile unsigned int m_uintSink  = 0U;
+static volatile wxFloat32    m_floatSink = 0.0F;
+
+long CBench::getOption(const wxChar* name)
+{
+	wxASSERT(name != NULL);
+
+	for (unsigned int i = 0U; i < BENCH_OPTION_COUNT; i++) {
+		if (::wxStrcmp(BENCH_OPTIONS[i].m_name, name) == 0)
+			return m_values[i];
+	}
+
+	wxASSERT(false);
+
+	return 0L;
+}
+
+double CBench::perItem(wxUint64 time, unsigned int count)
+{
+	return double(time) * 1000.0 / double(count);
+}
+
+void CBench::sink(unsigned int value)
+{
+	m_uintSink = value;
+}
+
+void CBench::sink(wxFloat32 value)
+{
+	m_floatSink = value;
+}
+
+void CBench::error(const char* text)
+{
+	wxASSERT(text != NULL);
+
+	::fprintf(stderr, "%s: %s\n", BENCH_NAME, text);
+}
+
+int main(int argc, char** argv)
+{
+	wxInitializer initializer(argc, argv);
+	if (!initializer.IsOk()) {
+		CBench::error("failed to initialise wxWidgets");
+		return 1;
+	}
+
+	wxCmdLineParser parser(argc, argv);
+	for (unsigned int i = 0U; i < BENCH_OPTION_COUNT; i++)
+		parser.AddOption(BENCH_OPTIONS[i].m_name, wxEmptyString, BENCH_OPTIONS[i].m_description, wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_PARAM_OPTIONAL);
+
+	if (parser.Parse() != 0)
+		return 1;
+
+	m_values = new long[BENCH_OPTION_COUNT];
+
+	for (unsigned int i = 0U; i < BENCH_OPTION_COUNT; i++) {
+		m_values[i] = BENCH_OPTIONS[i].m_default;
+		parser.Found(BENCH_OPTIONS[i].m_name, &m_values[i]);
+
+		if (m_values[i] < BENCH_OPTIONS[i].m_min || m_values[i] > BENCH_OPTIONS[i].m_max) {
+			parser.Usage();
+			delete[] m_values;
+			return 1;
+		}
+	}
+
+	int ret = run();
+
+	delete[] m_values;
+
+	return ret;
+}
@@ -0,0 +1,222 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+#include "ReferenceCallsignList.h"
+#include "CallsignList.h"
+#include "DStarDefines.h"
+#include "Bench.h"
+#include "Utils.h"
+
+#include <wx/wx.h>
+
+#include <cstdlib>
+#include <cstdio>
+
+#include <unistd.h>
+
+const char BENCH_NAME[] = "callsignlistbench";
+
+// Two letters, a digit and three letters, 118,813,760 callsigns in all, and the misses need the other half
+const CBenchOption BENCH_OPTIONS[] = {
+	{wxT("entries"), wxT("callsigns in the list"),  100000L, 1L, 59406880L},
+	{wxT("lookups"), wxT("lookups of each kind"),  1000000L, 1L, 100000000L}};
+
+const unsigned int BENCH_OPTION_COUNT = 2U;
+
+// The old list scans every entry on a miss, so it is only given this many of the lookups
+const unsigned int REFERENCE_LOOKUPS = 1000U;
+
+// Two letters, a digit and three letters, 118,813,760 callsigns in all
+const wxUint64 CALLSIGN_SPACE = wxULL(26) * 26U * 10U * 26U * 26U * 26U;
+
+// Each n gives a different callsign, the multiplier has no factor in common with the callsign space
+static void makeCallsign(unsigned int n, unsigned char* callsign)
+{
+	wxUint64 v = (wxUint64(n) * wxULL(2654435761)) % CALLSIGN_SPACE;
+
+	callsign[5] = 'A' + (unsigned char)(v % 26U); v /= 26U;
+	callsign[4] = 'A' + (unsigned char)(v % 26U); v /= 26U;
+	callsign[3] = 'A' + (unsigned char)(v % 26U); v /= 26U;
+	callsign[2] = '0' + (unsigned char)(v % 10U); v /= 10U;
+	callsign[1] = 'A' + (unsigned char)(v % 26U); v /= 26U;
+	callsign[0] = 'A' + (unsigned char)(v % 26U);
+	callsign[6] = ' ';
+	callsign[7] = ' ';
+}
+
+static bool writeList(const char* filename, unsigned int entries)
+{
+	FILE* fp = ::fopen(filename, "wt");
+	if (fp == NULL) {
+		CBench::error("cannot create the list file");
+		return false;
+	}
+
+	// Written the way people keep them, in lower case and without the padding
+	for (unsigned int i = 0U; i < entries; i++) {
+		unsigned char callsign[LONG_CALLSIGN_LENGTH];
+		makeCallsign(i, callsign);
+
+		::fprintf(fp, "%c%c%c%c%c%c\n", ::tolower(callsign[0]), ::tolower(callsign[1]), callsign[2],
+			::tolower(callsign[3]), ::tolower(callsign[4]), ::tolower(callsign[5]));
+	}
+
+	::fclose(fp);
+
+	return true;
+}
+
+static void reportTime(const wxChar* name, wxUint64 time, unsigned int count, const wxChar* unit)
+{
+	if (count == 1U)
+		wxPrintf(wxT("%-26s %10.3f ms\n"), name, double(time) / 1000.0);
+	else
+		wxPrintf(wxT("%-26s %10.1f ns a %s\n"), name, CBench::perItem(time, count), unit);
+}
+
+// Half of the lookups are for callsigns in the list, in a random order, and half for callsigns that are not
+static bool lookup(const CReferenceCallsignList& oldList, const CCallsignList& newList, unsigned int entries, unsigned int lookups, bool hits)
+{
+	unsigned char* callsigns = new unsigned char[lookups * LONG_CALLSIGN_LENGTH];
+	wxString* strings = new wxString[lookups];
+
+	for (unsigned int i = 0U; i < lookups; i++) {
+		unsigned int n = (unsigned int)(((wxUint64(::rand()) << 16) ^ wxUint64(::rand())) % entries);
+		if (!hits)
+			n += entries;
+
+		makeCallsign(n, callsigns + i * LONG_CALLSIGN_LENGTH);
+		strings[i] = wxString((const char*)(callsigns + i * LONG_CALLSIGN_LENGTH), wxConvLocal, LONG_CALLSIGN_LENGTH);
+	}
+
+	unsigned int oldLookups = lookups < REFERENCE_LOOKUPS ? lookups : REFERENCE_LOOKUPS;
+
+	bool* oldFound = new bool[oldLookups];
+
+	wxUint64 start = CUtils::getTimestamp();
+	for (unsigned int i = 0U; i < oldLookups; i++)
+		oldFound[i] = oldList.isInList(strings[i]);
+	wxUint64 oldTime = CUtils::getTimestamp() - start;
+
+	unsigned int stringFound = 0U;
+	start = CUtils::getTimestamp();
+	for (unsigned int i = 0U; i < lookups; i++) {
+		if (newList.isInList(strings[i]))
+			stringFound++;
+	}
+	wxUint64 stringTime = CUtils::getTimestamp() - start;
+
+	unsigned int bytesFound = 0U;
+	start = CUtils::getTimestamp();
+	for (unsigned int i = 0U; i < lookups; i++) {
+		if (newList.isInList(callsigns + i * LONG_CALLSIGN_LENGTH))
+			bytesFound++;
+	}
+	wxUint64 bytesTime = CUtils::getTimestamp() - start;
+
+	unsigned int expected = hits ? lookups : 0U;
+
+	unsigned int mismatches = 0U;
+	for (unsigned int i = 0U; i < oldLookups; i++) {
+		if (oldFound[i] != hits || newList.isInList(strings[i]) != hits)
+			mismatches++;
+	}
+	if (stringFound != expected)
+		mismatches++;
+	if (bytesFound != expected)
+		mismatches++;
+
+	const wxChar* kind = hits ? wxT("hit") : wxT("miss");
+
+	reportTime(wxString::Format(wxT("Before, wxString %s"), kind), oldTime, oldLookups, wxT("lookup"));
+	reportTime(wxString::Format(wxT("After, wxString %s"), kind), stringTime, lookups, wxT("lookup"));
+	reportTime(wxString::Format(wxT("After, bytes %s"), kind), bytesTime, lookups, wxT("lookup"));
+
+	if (mismatches > 0U)
+		wxPrintf(wxT("%u %s lookups gave the wrong answer\n"), mismatches, kind);
+
+	CBench::sink(stringFound + bytesFound);
+
+	delete[] callsigns;
+	delete[] strings;
+	delete[] oldFound;
+
+	return mismatches == 0U;
+}
+
+int run()
+{
+	long entries = CBench::getOption(wxT("entries"));
+	long lookups = CBench::getOption(wxT("lookups"));
+
+	char filename[] = "/tmp/callsignlistbenchXXXXXX";
+	int fd = ::mkstemp(filename);
+	if (fd < 0) {
+		CBench::error("cannot create a temporary file");
+		return 1;
+	}
+
+	::close(fd);
+
+	if (!writeList(filename, (unsigned int)entries)) {
+		::unlink(filename);
+		return 1;
+	}
+
+	wxPrintf(wxT("%ld entries, %ld lookups of each kind, %u for the old list\n"), entries, lookups,
+		(unsigned int)lookups < REFERENCE_LOOKUPS ? (unsigned int)lookups : REFERENCE_LOOKUPS);
+
+	wxString name(filename, wxConvLocal);
+
+	CReferenceCallsignList oldList(name);
+	CCallsignList newList(name);
+
+	wxUint64 start = CUtils::getTimestamp();
+	bool ok = oldList.load();
+	reportTime(wxT("Before, load"), CUtils::getTimestamp() - start, 1U, NULL);
+
+	start = CUtils::getTimestamp();
+	ok = newList.load() && ok;
+	reportTime(wxT("After, load"), CUtils::getTimestamp() - start, 1U, NULL);
+
+	// The same as a reload of a changed file, a new index is built and the old one freed
+	start = CUtils::getTimestamp();
+	ok = newList.load() && ok;
+	reportTime(wxT("After, load over a list"), CUtils::getTimestamp() - start, 1U, NULL);
+
+	// What the reloader does each minute when nothing has changed
+	start = CUtils::getTimestamp();
+	newList.reload();
+	reportTime(wxT("After, unchanged reload"), CUtils::getTimestamp() - start, 1U, NULL);
+
+	::unlink(filename);
+
+	if (!ok) {
+		wxPrintf(wxT("The list could not be loaded\n"));
+		return 1;
+	}
+
+	if (oldList.getCount() != newList.getCount()) {
+		wxPrintf(wxT("The old list has %u entries and the new one %u\n"), oldList.getCount(), newList.getCount());
+		return 1;
+	}
+
+	ok = lookup(oldList, newList, (unsigned int)entries, (unsigned int)lookups, true);
+	ok = lookup(oldList, newList, (unsigned int)entries, (unsigned int)lookups, false) && ok;
+
+	return ok ? 0 : 1;
+}
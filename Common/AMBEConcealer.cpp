@@ -0,0 +1,94 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "AMBEConcealer.h"
+#include "DStarDefines.h"
+
+// The top six bits of a hold the pitch, values of 60 and above are the erasure, silence and tone frames
+const unsigned int PITCH_SHIFT   = 6U;
+const unsigned int SPECIAL_PITCH = 60U;
+
+// The five bit differential gain index is ambe_d[10] to ambe_d[14], its top two bits are the bottom
+// two bits of a and the rest are the top three bits of b
+const unsigned int GAIN_A_MASK  = 0x03U;
+const unsigned int GAIN_B_BITS  = 3U;
+const unsigned int GAIN_B_SHIFT = 9U;
+const unsigned int GAIN_B_MASK  = 0x07U;
+
+CAMBEConcealer::CAMBEConcealer(unsigned int fadeFrames) :
+m_fec(),
+m_fadeFrames(fadeFrames),
+m_valid(false),
+m_dataA(0U),
+m_dataB(0U),
+m_c(0U),
+m_count(0U)
+{
+}
+
+CAMBEConcealer::~CAMBEConcealer()
+{
+}
+
+void CAMBEConcealer::setFadeFrames(unsigned int fadeFrames)
+{
+	m_fadeFrames = fadeFrames;
+}
+
+void CAMBEConcealer::reset()
+{
+	m_valid = false;
+	m_count = 0U;
+}
+
+void CAMBEConcealer::good(const unsigned char* data)
+{
+	wxASSERT(data != NULL);
+
+	unsigned int a, b, errors;
+	m_fec.unpack(data, a, b, m_c);
+
+	m_dataA = m_fec.decodeA(a, errors);
+	m_dataB = m_fec.decodeB(b, m_dataA, errors);
+
+	// A special frame is not repeated
+	m_valid = (m_dataA >> PITCH_SHIFT) < SPECIAL_PITCH;
+	m_count = 0U;
+}
+
+void CAMBEConcealer::conceal(unsigned char* data)
+{
+	wxASSERT(data != NULL);
+
+	m_count++;
+
+	if (!m_valid || m_count > m_fadeFrames) {
+		::memcpy(data, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
+		return;
+	}
+
+	// Step the gain index down in equal steps, the vocoder smooths it across the frames
+	unsigned int gain = ((m_dataA & GAIN_A_MASK) << GAIN_B_BITS) | ((m_dataB >> GAIN_B_SHIFT) & GAIN_B_MASK);
+	gain = (gain * (m_fadeFrames + 1U - m_count)) / (m_fadeFrames + 1U);
+
+	unsigned int dataA = (m_dataA & ~GAIN_A_MASK) | (gain >> GAIN_B_BITS);
+	unsigned int dataB = (m_dataB & ~(GAIN_B_MASK << GAIN_B_SHIFT)) | ((gain & GAIN_B_MASK) << GAIN_B_SHIFT);
+
+	// Changing a changes the scrambling of b, so the whole frame is encoded again
+	m_fec.encode(dataA, dataB, m_c, data);
+}
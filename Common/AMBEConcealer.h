@@ -0,0 +1,55 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	AMBEConcealer_H
+#define	AMBEConcealer_H
+
+#include "AMBEFEC.h"
+
+#include <wx/wx.h>
+
+// Fills the gaps in a stream of AMBE frames. The last good frame is repeated with its gain stepped
+// down over a number of frames, after that the gap becomes silence. Only the voice part of a frame
+// is written, the slow data is left to the caller.
+class CAMBEConcealer {
+public:
+	CAMBEConcealer(unsigned int fadeFrames);
+	~CAMBEConcealer();
+
+	void setFadeFrames(unsigned int fadeFrames);
+
+	// Forget the last good frame, at the start of a transmission
+	void reset();
+
+	// Remember a frame that arrived
+	void good(const unsigned char* data);
+
+	// Replace a frame that did not arrive
+	void conceal(unsigned char* data);
+
+private:
+	CAMBEFEC     m_fec;
+	unsigned int m_fadeFrames;
+	bool         m_valid;
+	unsigned int m_dataA;
+	unsigned int m_dataB;
+	unsigned int m_c;
+	unsigned int m_count;
+};
+
+#endif
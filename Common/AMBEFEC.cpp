@@ -17,9 +17,12 @@
  */
 
 #include "AMBEFEC.h"
+#include "DStarDefines.h"
 
 #include <wx/wx.h>
 
+const unsigned int AMBE_BLOCK_FRAMES = 32U;
+
 static const unsigned int PRNG_TABLE[] = {
 	0x42CC47U, 0x19D6FEU, 0x304729U, 0x6B2CD0U, 0x60BF47U, 0x39650EU, 0x7354F1U, 0xEACF60U, 0x819C9FU, 0xDE25CEU, 
 	0xD7B745U, 0x8CC8B8U, 0x8D592BU, 0xF71257U, 0xBCA084U, 0xA5B329U, 0xEE6AFAU, 0xF7D9A7U, 0xBCC21CU, 0x4712D9U, 
@@ -444,47 +447,148 @@ unsigned int CAMBEFEC::regenerate(unsigned char* bytes) const
 {
 	wxASSERT(bytes != NULL);
 
-	unsigned int a = ((bytes[0] & 0x80) ? 0x800000 : 0x000000) | ((bytes[0] & 0x02) ? 0x400000 : 0x000000) |
-					 ((bytes[1] & 0x08) ? 0x200000 : 0x000000) | ((bytes[2] & 0x20) ? 0x100000 : 0x000000) |
-					 ((bytes[3] & 0x80) ? 0x080000 : 0x000000) | ((bytes[3] & 0x02) ? 0x040000 : 0x000000) |
-					 ((bytes[4] & 0x08) ? 0x020000 : 0x000000) | ((bytes[5] & 0x20) ? 0x010000 : 0x000000) |
-					 ((bytes[6] & 0x80) ? 0x008000 : 0x000000) | ((bytes[6] & 0x02) ? 0x004000 : 0x000000) |
-					 ((bytes[7] & 0x08) ? 0x002000 : 0x000000) | ((bytes[8] & 0x20) ? 0x001000 : 0x000000) |
-					 ((bytes[0] & 0x40) ? 0x000800 : 0x000000) | ((bytes[0] & 0x01) ? 0x000400 : 0x000000) |
-					 ((bytes[1] & 0x04) ? 0x000200 : 0x000000) | ((bytes[2] & 0x10) ? 0x000100 : 0x000000) |
-					 ((bytes[3] & 0x40) ? 0x000080 : 0x000000) | ((bytes[3] & 0x01) ? 0x000040 : 0x000000) |
-					 ((bytes[4] & 0x04) ? 0x000020 : 0x000000) | ((bytes[5] & 0x10) ? 0x000010 : 0x000000) |
-					 ((bytes[6] & 0x40) ? 0x000008 : 0x000000) | ((bytes[6] & 0x01) ? 0x000004 : 0x000000) |
-					 ((bytes[7] & 0x04) ? 0x000002 : 0x000000) | ((bytes[8] & 0x10) ? 0x000001 : 0x000000);
-
-	unsigned int b = ((bytes[0] & 0x20) ? 0x800000 : 0x000000) | ((bytes[1] & 0x80) ? 0x400000 : 0x000000) |
-					 ((bytes[1] & 0x02) ? 0x200000 : 0x000000) | ((bytes[2] & 0x08) ? 0x100000 : 0x000000) |
-					 ((bytes[3] & 0x20) ? 0x080000 : 0x000000) | ((bytes[4] & 0x80) ? 0x040000 : 0x000000) |
-					 ((bytes[4] & 0x02) ? 0x020000 : 0x000000) | ((bytes[5] & 0x08) ? 0x010000 : 0x000000) |
-					 ((bytes[6] & 0x20) ? 0x008000 : 0x000000) | ((bytes[7] & 0x80) ? 0x004000 : 0x000000) |
-					 ((bytes[7] & 0x02) ? 0x002000 : 0x000000) | ((bytes[8] & 0x08) ? 0x001000 : 0x000000) |
-					 ((bytes[0] & 0x10) ? 0x000800 : 0x000000) | ((bytes[1] & 0x40) ? 0x000400 : 0x000000) |
-					 ((bytes[1] & 0x01) ? 0x000200 : 0x000000) | ((bytes[2] & 0x04) ? 0x000100 : 0x000000) |
-					 ((bytes[3] & 0x10) ? 0x000080 : 0x000000) | ((bytes[4] & 0x40) ? 0x000040 : 0x000000) |
-					 ((bytes[4] & 0x01) ? 0x000020 : 0x000000) | ((bytes[5] & 0x04) ? 0x000010 : 0x000000) |
-					 ((bytes[6] & 0x10) ? 0x000008 : 0x000000) | ((bytes[7] & 0x40) ? 0x000004 : 0x000000) |
-					 ((bytes[7] & 0x01) ? 0x000002 : 0x000000) | ((bytes[8] & 0x04) ? 0x000001 : 0x000000);
-
-	unsigned int c = ((bytes[0] & 0x08) ? 0x800000 : 0x000000) | ((bytes[1] & 0x20) ? 0x400000 : 0x000000) |
-					 ((bytes[2] & 0x80) ? 0x200000 : 0x000000) | ((bytes[2] & 0x02) ? 0x100000 : 0x000000) |
-					 ((bytes[3] & 0x08) ? 0x080000 : 0x000000) | ((bytes[4] & 0x20) ? 0x040000 : 0x000000) |
-					 ((bytes[5] & 0x80) ? 0x020000 : 0x000000) | ((bytes[5] & 0x02) ? 0x010000 : 0x000000) |
-					 ((bytes[6] & 0x08) ? 0x008000 : 0x000000) | ((bytes[7] & 0x20) ? 0x004000 : 0x000000) |
-					 ((bytes[8] & 0x80) ? 0x002000 : 0x000000) | ((bytes[8] & 0x02) ? 0x001000 : 0x000000) |
-					 ((bytes[0] & 0x04) ? 0x000800 : 0x000000) | ((bytes[1] & 0x10) ? 0x000400 : 0x000000) |
-					 ((bytes[2] & 0x40) ? 0x000200 : 0x000000) | ((bytes[2] & 0x01) ? 0x000100 : 0x000000) |
-					 ((bytes[3] & 0x04) ? 0x000080 : 0x000000) | ((bytes[4] & 0x10) ? 0x000040 : 0x000000) |
-					 ((bytes[5] & 0x40) ? 0x000020 : 0x000000) | ((bytes[5] & 0x01) ? 0x000010 : 0x000000) |
-					 ((bytes[6] & 0x04) ? 0x000008 : 0x000000) | ((bytes[7] & 0x10) ? 0x000004 : 0x000000) |
-					 ((bytes[8] & 0x40) ? 0x000002 : 0x000000) | ((bytes[8] & 0x01) ? 0x000001 : 0x000000);
-
-	unsigned int errors = regenerate(a, b, c);
+	return regenerate(bytes, 1U, VOICE_FRAME_LENGTH_BYTES, NULL);
+}
+
+unsigned int CAMBEFEC::count(const unsigned char* bytes) const
+{
+	wxASSERT(bytes != NULL);
+
+	unsigned int a, b, c;
+	unpack(bytes, a, b, c);
+
+	unsigned int errorsA, errorsB;
+	unsigned int dataA = decodeA(a, errorsA);
+	decodeB(b, dataA, errorsB);
+
+	return errorsA + errorsB;
+}
+
+// Each stage is run over a block of frames before the next, so the table lookups of one stage are not
+// waiting on those of the last
+unsigned int CAMBEFEC::regenerate(unsigned char* frames, unsigned int n, unsigned int stride, unsigned int* errors) const
+{
+	wxASSERT(frames != NULL);
+	wxASSERT(stride >= VOICE_FRAME_LENGTH_BYTES);
+
+	unsigned int a[AMBE_BLOCK_FRAMES];
+	unsigned int b[AMBE_BLOCK_FRAMES];
+	unsigned int c[AMBE_BLOCK_FRAMES];
+	unsigned int dataA[AMBE_BLOCK_FRAMES];
+	unsigned int dataB[AMBE_BLOCK_FRAMES];
+
+	unsigned int total = 0U;
+
+	for (unsigned int start = 0U; start < n; start += AMBE_BLOCK_FRAMES) {
+		unsigned int length = n - start;
+		if (length > AMBE_BLOCK_FRAMES)
+			length = AMBE_BLOCK_FRAMES;
+
+		unsigned char* bytes = frames + start * stride;
+
+		for (unsigned int i = 0U; i < length; i++)
+			unpack(bytes + i * stride, a[i], b[i], c[i]);
+
+		for (unsigned int i = 0U; i < length; i++)
+			dataA[i] = CGolay::decode24128(a[i]);
+
+		for (unsigned int i = 0U; i < length; i++) {
+			b[i] ^= PRNG_TABLE[dataA[i]];
+			dataB[i] = CGolay::decode24128(b[i]);
+		}
+
+		for (unsigned int i = 0U; i < length; i++) {
+			unsigned int errorsA = countBits(a[i] ^ CGolay::encode24128(dataA[i]));
+			unsigned int errorsB = countBits(b[i] ^ CGolay::encode24128(dataB[i]));
+
+			total += errorsA + errorsB;
+
+			if (errors != NULL) {
+				errors[(start + i) * 2U + 0U] = errorsA;
+				errors[(start + i) * 2U + 1U] = errorsB;
+			}
+
+			encode(dataA[i], dataB[i], c[i], bytes + i * stride);
+		}
+	}
+
+	return total;
+}
+
+unsigned int CAMBEFEC::decodeA(unsigned int a, unsigned int& errors) const
+{
+	unsigned int data = CGolay::decode24128(a);
+
+	errors = countBits(a ^ CGolay::encode24128(data));
+
+	return data;
+}
+
+unsigned int CAMBEFEC::decodeB(unsigned int b, unsigned int dataA, unsigned int& errors) const
+{
+	b ^= PRNG_TABLE[dataA];
+
+	unsigned int data = CGolay::decode24128(b);
+
+	errors = countBits(b ^ CGolay::encode24128(data));
+
+	return data;
+}
+
+void CAMBEFEC::encode(unsigned int dataA, unsigned int dataB, unsigned int c, unsigned char* bytes) const
+{
+	wxASSERT(bytes != NULL);
+
+	unsigned int a = CGolay::encode24128(dataA);
+	unsigned int b = CGolay::encode24128(dataB) ^ PRNG_TABLE[dataA];
+
+	pack(a, b, c, bytes);
+}
+
+void CAMBEFEC::unpack(const unsigned char* bytes, unsigned int& a, unsigned int& b, unsigned int& c) const
+{
+	a = ((bytes[0] & 0x80) ? 0x800000 : 0x000000) | ((bytes[0] & 0x02) ? 0x400000 : 0x000000) |
+	    ((bytes[1] & 0x08) ? 0x200000 : 0x000000) | ((bytes[2] & 0x20) ? 0x100000 : 0x000000) |
+	    ((bytes[3] & 0x80) ? 0x080000 : 0x000000) | ((bytes[3] & 0x02) ? 0x040000 : 0x000000) |
+	    ((bytes[4] & 0x08) ? 0x020000 : 0x000000) | ((bytes[5] & 0x20) ? 0x010000 : 0x000000) |
+	    ((bytes[6] & 0x80) ? 0x008000 : 0x000000) | ((bytes[6] & 0x02) ? 0x004000 : 0x000000) |
+	    ((bytes[7] & 0x08) ? 0x002000 : 0x000000) | ((bytes[8] & 0x20) ? 0x001000 : 0x000000) |
+	    ((bytes[0] & 0x40) ? 0x000800 : 0x000000) | ((bytes[0] & 0x01) ? 0x000400 : 0x000000) |
+	    ((bytes[1] & 0x04) ? 0x000200 : 0x000000) | ((bytes[2] & 0x10) ? 0x000100 : 0x000000) |
+	    ((bytes[3] & 0x40) ? 0x000080 : 0x000000) | ((bytes[3] & 0x01) ? 0x000040 : 0x000000) |
+	    ((bytes[4] & 0x04) ? 0x000020 : 0x000000) | ((bytes[5] & 0x10) ? 0x000010 : 0x000000) |
+	    ((bytes[6] & 0x40) ? 0x000008 : 0x000000) | ((bytes[6] & 0x01) ? 0x000004 : 0x000000) |
+	    ((bytes[7] & 0x04) ? 0x000002 : 0x000000) | ((bytes[8] & 0x10) ? 0x000001 : 0x000000);
+
+	b = ((bytes[0] & 0x20) ? 0x800000 : 0x000000) | ((bytes[1] & 0x80) ? 0x400000 : 0x000000) |
+	    ((bytes[1] & 0x02) ? 0x200000 : 0x000000) | ((bytes[2] & 0x08) ? 0x100000 : 0x000000) |
+	    ((bytes[3] & 0x20) ? 0x080000 : 0x000000) | ((bytes[4] & 0x80) ? 0x040000 : 0x000000) |
+	    ((bytes[4] & 0x02) ? 0x020000 : 0x000000) | ((bytes[5] & 0x08) ? 0x010000 : 0x000000) |
+	    ((bytes[6] & 0x20) ? 0x008000 : 0x000000) | ((bytes[7] & 0x80) ? 0x004000 : 0x000000) |
+	    ((bytes[7] & 0x02) ? 0x002000 : 0x000000) | ((bytes[8] & 0x08) ? 0x001000 : 0x000000) |
+	    ((bytes[0] & 0x10) ? 0x000800 : 0x000000) | ((bytes[1] & 0x40) ? 0x000400 : 0x000000) |
+	    ((bytes[1] & 0x01) ? 0x000200 : 0x000000) | ((bytes[2] & 0x04) ? 0x000100 : 0x000000) |
+	    ((bytes[3] & 0x10) ? 0x000080 : 0x000000) | ((bytes[4] & 0x40) ? 0x000040 : 0x000000) |
+	    ((bytes[4] & 0x01) ? 0x000020 : 0x000000) | ((bytes[5] & 0x04) ? 0x000010 : 0x000000) |
+	    ((bytes[6] & 0x10) ? 0x000008 : 0x000000) | ((bytes[7] & 0x40) ? 0x000004 : 0x000000) |
+	    ((bytes[7] & 0x01) ? 0x000002 : 0x000000) | ((bytes[8] & 0x04) ? 0x000001 : 0x000000);
+
+	c = ((bytes[0] & 0x08) ? 0x800000 : 0x000000) | ((bytes[1] & 0x20) ? 0x400000 : 0x000000) |
+	    ((bytes[2] & 0x80) ? 0x200000 : 0x000000) | ((bytes[2] & 0x02) ? 0x100000 : 0x000000) |
+	    ((bytes[3] & 0x08) ? 0x080000 : 0x000000) | ((bytes[4] & 0x20) ? 0x040000 : 0x000000) |
+	    ((bytes[5] & 0x80) ? 0x020000 : 0x000000) | ((bytes[5] & 0x02) ? 0x010000 : 0x000000) |
+	    ((bytes[6] & 0x08) ? 0x008000 : 0x000000) | ((bytes[7] & 0x20) ? 0x004000 : 0x000000) |
+	    ((bytes[8] & 0x80) ? 0x002000 : 0x000000) | ((bytes[8] & 0x02) ? 0x001000 : 0x000000) |
+	    ((bytes[0] & 0x04) ? 0x000800 : 0x000000) | ((bytes[1] & 0x10) ? 0x000400 : 0x000000) |
+	    ((bytes[2] & 0x40) ? 0x000200 : 0x000000) | ((bytes[2] & 0x01) ? 0x000100 : 0x000000) |
+	    ((bytes[3] & 0x04) ? 0x000080 : 0x000000) | ((bytes[4] & 0x10) ? 0x000040 : 0x000000) |
+	    ((bytes[5] & 0x40) ? 0x000020 : 0x000000) | ((bytes[5] & 0x01) ? 0x000010 : 0x000000) |
+	    ((bytes[6] & 0x04) ? 0x000008 : 0x000000) | ((bytes[7] & 0x10) ? 0x000004 : 0x000000) |
+	    ((bytes[8] & 0x40) ? 0x000002 : 0x000000) | ((bytes[8] & 0x01) ? 0x000001 : 0x000000);
+}
 
+void CAMBEFEC::pack(unsigned int a, unsigned int b, unsigned int c, unsigned char* bytes) const
+{
 	bytes[0] = ((a & 0x800000) ? 0x80 : 0x00) | ((a & 0x000800) ? 0x40 : 0x00) | ((b & 0x800000) ? 0x20 : 0x00) |
 			   ((b & 0x000800) ? 0x10 : 0x00) | ((c & 0x800000) ? 0x08 : 0x00) | ((c & 0x000800) ? 0x04 : 0x00) |
 			   ((a & 0x400000) ? 0x02 : 0x00) | ((a & 0x000400) ? 0x01 : 0x00);
@@ -520,119 +624,16 @@ unsigned int CAMBEFEC::regenerate(unsigned char* bytes) const
 	bytes[8] = ((c & 0x002000) ? 0x80 : 0x00) | ((c & 0x000002) ? 0x40 : 0x00) | ((a & 0x001000) ? 0x20 : 0x00) |
 			   ((a & 0x000001) ? 0x10 : 0x00) | ((b & 0x001000) ? 0x08 : 0x00) | ((b & 0x000001) ? 0x04 : 0x00) |
 			   ((c & 0x001000) ? 0x02 : 0x00) | ((c & 0x000001) ? 0x01 : 0x00);
-
-	return errors;
 }
 
-unsigned int CAMBEFEC::count(const unsigned char* bytes) const
-{
-	wxASSERT(bytes != NULL);
-
-	unsigned int a = ((bytes[0] & 0x80) ? 0x800000 : 0x000000) | ((bytes[0] & 0x02) ? 0x400000 : 0x000000) |
-					 ((bytes[1] & 0x08) ? 0x200000 : 0x000000) | ((bytes[2] & 0x20) ? 0x100000 : 0x000000) |
-					 ((bytes[3] & 0x80) ? 0x080000 : 0x000000) | ((bytes[3] & 0x02) ? 0x040000 : 0x000000) |
-					 ((bytes[4] & 0x08) ? 0x020000 : 0x000000) | ((bytes[5] & 0x20) ? 0x010000 : 0x000000) |
-					 ((bytes[6] & 0x80) ? 0x008000 : 0x000000) | ((bytes[6] & 0x02) ? 0x004000 : 0x000000) |
-					 ((bytes[7] & 0x08) ? 0x002000 : 0x000000) | ((bytes[8] & 0x20) ? 0x001000 : 0x000000) |
-					 ((bytes[0] & 0x40) ? 0x000800 : 0x000000) | ((bytes[0] & 0x01) ? 0x000400 : 0x000000) |
-					 ((bytes[1] & 0x04) ? 0x000200 : 0x000000) | ((bytes[2] & 0x10) ? 0x000100 : 0x000000) |
-					 ((bytes[3] & 0x40) ? 0x000080 : 0x000000) | ((bytes[3] & 0x01) ? 0x000040 : 0x000000) |
-					 ((bytes[4] & 0x04) ? 0x000020 : 0x000000) | ((bytes[5] & 0x10) ? 0x000010 : 0x000000) |
-					 ((bytes[6] & 0x40) ? 0x000008 : 0x000000) | ((bytes[6] & 0x01) ? 0x000004 : 0x000000) |
-					 ((bytes[7] & 0x04) ? 0x000002 : 0x000000) | ((bytes[8] & 0x10) ? 0x000001 : 0x000000);
-
-	unsigned int b = ((bytes[0] & 0x20) ? 0x800000 : 0x000000) | ((bytes[1] & 0x80) ? 0x400000 : 0x000000) |
-					 ((bytes[1] & 0x02) ? 0x200000 : 0x000000) | ((bytes[2] & 0x08) ? 0x100000 : 0x000000) |
-					 ((bytes[3] & 0x20) ? 0x080000 : 0x000000) | ((bytes[4] & 0x80) ? 0x040000 : 0x000000) |
-					 ((bytes[4] & 0x02) ? 0x020000 : 0x000000) | ((bytes[5] & 0x08) ? 0x010000 : 0x000000) |
-					 ((bytes[6] & 0x20) ? 0x008000 : 0x000000) | ((bytes[7] & 0x80) ? 0x004000 : 0x000000) |
-					 ((bytes[7] & 0x02) ? 0x002000 : 0x000000) | ((bytes[8] & 0x08) ? 0x001000 : 0x000000) |
-					 ((bytes[0] & 0x10) ? 0x000800 : 0x000000) | ((bytes[1] & 0x40) ? 0x000400 : 0x000000) |
-					 ((bytes[1] & 0x01) ? 0x000200 : 0x000000) | ((bytes[2] & 0x04) ? 0x000100 : 0x000000) |
-					 ((bytes[3] & 0x10) ? 0x000080 : 0x000000) | ((bytes[4] & 0x40) ? 0x000040 : 0x000000) |
-					 ((bytes[4] & 0x01) ? 0x000020 : 0x000000) | ((bytes[5] & 0x04) ? 0x000010 : 0x000000) |
-					 ((bytes[6] & 0x10) ? 0x000008 : 0x000000) | ((bytes[7] & 0x40) ? 0x000004 : 0x000000) |
-					 ((bytes[7] & 0x01) ? 0x000002 : 0x000000) | ((bytes[8] & 0x04) ? 0x000001 : 0x000000);
-
-	unsigned int c = ((bytes[0] & 0x08) ? 0x800000 : 0x000000) | ((bytes[1] & 0x20) ? 0x400000 : 0x000000) |
-					 ((bytes[2] & 0x80) ? 0x200000 : 0x000000) | ((bytes[2] & 0x02) ? 0x100000 : 0x000000) |
-					 ((bytes[3] & 0x08) ? 0x080000 : 0x000000) | ((bytes[4] & 0x20) ? 0x040000 : 0x000000) |
-					 ((bytes[5] & 0x80) ? 0x020000 : 0x000000) | ((bytes[5] & 0x02) ? 0x010000 : 0x000000) |
-					 ((bytes[6] & 0x08) ? 0x008000 : 0x000000) | ((bytes[7] & 0x20) ? 0x004000 : 0x000000) |
-					 ((bytes[8] & 0x80) ? 0x002000 : 0x000000) | ((bytes[8] & 0x02) ? 0x001000 : 0x000000) |
-					 ((bytes[0] & 0x04) ? 0x000800 : 0x000000) | ((bytes[1] & 0x10) ? 0x000400 : 0x000000) |
-					 ((bytes[2] & 0x40) ? 0x000200 : 0x000000) | ((bytes[2] & 0x01) ? 0x000100 : 0x000000) |
-					 ((bytes[3] & 0x04) ? 0x000080 : 0x000000) | ((bytes[4] & 0x10) ? 0x000040 : 0x000000) |
-					 ((bytes[5] & 0x40) ? 0x000020 : 0x000000) | ((bytes[5] & 0x01) ? 0x000010 : 0x000000) |
-					 ((bytes[6] & 0x04) ? 0x000008 : 0x000000) | ((bytes[7] & 0x10) ? 0x000004 : 0x000000) |
-					 ((bytes[8] & 0x40) ? 0x000002 : 0x000000) | ((bytes[8] & 0x01) ? 0x000001 : 0x000000);
-
-	return count(a, b, c);
-}
-
-unsigned int CAMBEFEC::regenerate(unsigned int& a, unsigned int& b, unsigned int&) const
+unsigned int CAMBEFEC::countBits(unsigned int v) const
 {
-	unsigned int old_a = a;
-	unsigned int old_b = b;
-
-	unsigned int data = CGolay::decode24128(a);
-
-	unsigned int new_a = CGolay::encode24128(data);
-
-	// The PRNG
-	unsigned int p = PRNG_TABLE[data];
-
-	b ^= p;
-
-	unsigned int datb = CGolay::decode24128(b);
-
-	unsigned int new_b = CGolay::encode24128(datb);
-
-	new_b ^= p;
-
-	unsigned int errors = 0U;
-	unsigned int mask = 0x01;
-	for (unsigned int i = 0U; i < 24U; i++, mask <<= 1) {
-		if ((old_a & mask) != (new_a & mask))
-			errors++;
-		if ((old_b & mask) != (new_b & mask))
-			errors++;
-	}
-
-	a = new_a;
-	b = new_b;
-
-	return errors;
-}
-
-unsigned int CAMBEFEC::count(unsigned int a, unsigned int b, unsigned int) const
-{
-	unsigned int old_a = a;
-	unsigned int old_b = b;
-
-	unsigned int data = CGolay::decode24128(a);
-
-	unsigned int new_a = CGolay::encode24128(data);
-
-	// The PRNG
-	unsigned int p = PRNG_TABLE[data];
-
-	b ^= p;
-
-	unsigned int datb = CGolay::decode24128(b);
-
-	unsigned int new_b = CGolay::encode24128(datb);
-
-	new_b ^= p;
+	unsigned int count = 0U;
 
-	unsigned int errors = 0U;
-	unsigned int mask = 0x01;
-	for (unsigned int i = 0U; i < 24U; i++, mask <<= 1) {
-		if ((old_a & mask) != (new_a & mask))
-			errors++;
-		if ((old_b & mask) != (new_b & mask))
-			errors++;
+	while (v != 0U) {
+		v &= v - 1U;
+		count++;
 	}
 
-	return errors;
+	return count;
 }
@@ -29,9 +29,20 @@ public:
 	unsigned int regenerate(unsigned char* bytes) const;
 	unsigned int count(const unsigned char* bytes) const;
 
+	// Regenerate a run of frames that are stride bytes apart, returning the total errors. If errors is
+	// not NULL, it receives the errors in a and b for each frame, two entries per frame.
+	unsigned int regenerate(unsigned char* frames, unsigned int n, unsigned int stride, unsigned int* errors) const;
+
+	// Per codeword access, a and b are Golay codewords and c is unprotected. The data from a seeds
+	// the PRNG that scrambles b.
+	void         unpack(const unsigned char* bytes, unsigned int& a, unsigned int& b, unsigned int& c) const;
+	unsigned int decodeA(unsigned int a, unsigned int& errors) const;
+	unsigned int decodeB(unsigned int b, unsigned int dataA, unsigned int& errors) const;
+	void         encode(unsigned int dataA, unsigned int dataB, unsigned int c, unsigned char* bytes) const;
+
 private:
-	unsigned int regenerate(unsigned int& a, unsigned int& b, unsigned int& c) const;
-	unsigned int count(unsigned int a, unsigned int b, unsigned int c) const;
+	void         pack(unsigned int a, unsigned int b, unsigned int c, unsigned char* bytes) const;
+	unsigned int countBits(unsigned int v) const;
 };
 
 #endif
@@ -18,7 +18,7 @@
 
 class IAnnouncementCallback {
 public:
-	virtual void transmitAnnouncementHeader(CHeaderData* header) = 0;
+	virtual void transmitAnnouncementHeader(const CHeaderData& header) = 0;
 
 	virtual void transmitAnnouncementData(const unsigned char* data, unsigned int length, bool end) = 0;
 
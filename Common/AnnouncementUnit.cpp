@@ -28,6 +28,17 @@ m_handler(handler),
 m_localFileName(),
 m_reader(),
 m_writer(),
+m_fileName(),
+m_modified(),
+m_mutex(),
+m_changed(true),
+m_loaded(false),
+m_newHeader(),
+m_newData(NULL),
+m_newLength(0U),
+m_header(),
+m_data(NULL),
+m_length(0U),
 m_time(),
 m_out(0U),
 m_sending(false)
@@ -40,10 +51,15 @@ m_sending(false)
 #endif
 
 	m_writer.setDirectory(wxFileName::GetHomeDir());
+
+	// The repeater thread has not started yet, so the first one is read here
+	reload(true);
 }
 
 CAnnouncementUnit::~CAnnouncementUnit()
 {
+	delete[] m_newData;
+	delete[] m_data;
 }
 
 bool CAnnouncementUnit::writeHeader(const CHeaderData& header)
@@ -57,9 +73,13 @@ bool CAnnouncementUnit::writeData(const unsigned char* data, unsigned int length
 	if (!ret)
 		return false;
 
-	if (end)
+	if (end) {
 		m_writer.close();
 
+		wxMutexLocker locker(m_mutex);
+		m_changed = true;
+	}
+
 	return true;
 }
 
@@ -69,43 +89,35 @@ void CAnnouncementUnit::deleteAnnouncement()
 
 	if (wxFile::Exists(fileName.GetFullPath()))
 		::wxRemoveFile(fileName.GetFullPath());
+
+	wxMutexLocker locker(m_mutex);
+	m_changed = true;
 }
 
 void CAnnouncementUnit::startAnnouncement()
 {
-	wxFileName fileName1(wxFileName::GetHomeDir(), m_localFileName, wxT("dvtool"));
-	wxFileName fileName2(wxFileName::GetHomeDir(), GLOBAL_FILE_NAME, wxT("dvtool"));
+	unsigned char* old = NULL;
 
-	if (wxFile::Exists(fileName1.GetFullPath())) {
-		bool ret = m_reader.open(fileName1.GetFullPath());
-		if (!ret)
-			return;
-	} else if (wxFile::Exists(fileName2.GetFullPath())) {
-		bool ret = m_reader.open(fileName2.GetFullPath());
-		if (!ret)
-			return;
-	} else {
-		return;
-	}
+	// Nothing is being sent, so this is the time to take up anything the reloader has read
+	m_mutex.Lock();
+	if (m_loaded) {
+		old      = m_data;
+		m_header = m_newHeader;
+		m_data   = m_newData;
+		m_length = m_newLength;
 
-	DVTFR_TYPE type = m_reader.read();
-	if (type != DVTFR_HEADER) {
-		wxLogError(wxT("Invalid header element in the file - %d"), int(type));
-		m_reader.close();
-		return;
+		m_newData   = NULL;
+		m_newLength = 0U;
+		m_loaded    = false;
 	}
+	m_mutex.Unlock();
 
-	CHeaderData* header = m_reader.readHeader();
-	if (header == NULL) {
-		wxLogError(wxT("NULL header element in the file"));
-		m_reader.close();
-		return;
-	}
+	delete[] old;
 
-	// Remove the repeater bit
-	header->setFlag1(header->getFlag1() & ~REPEATER_MASK);
+	if (m_length == 0U)
+		return;
 
-	m_handler->transmitAnnouncementHeader(header);
+	m_handler->transmitAnnouncementHeader(m_header);
 
 	m_time.Start();
 
@@ -121,29 +133,131 @@ void CAnnouncementUnit::clock()
 	unsigned int needed = m_time.Time() / DSTAR_FRAME_TIME_MS;
 
 	while (m_out < needed) {
-		DVTFR_TYPE type = m_reader.read();
-		if (type != DVTFR_DATA) {
-			wxLogError(wxT("Invalid data element in the file - %d"), int(type));
+		m_handler->transmitAnnouncementData(m_data + m_out * DV_FRAME_LENGTH_BYTES, DV_FRAME_LENGTH_BYTES, false);
+		m_out++;
+
+		if (m_out >= m_length) {
 			m_handler->transmitAnnouncementData(END_PATTERN_BYTES, DV_FRAME_LENGTH_BYTES, true);
-			m_reader.close();
 			m_sending = false;
 			m_out = 0U;
 			return;
 		}
+	}
+}
 
-		unsigned char data[DV_FRAME_MAX_LENGTH_BYTES];
-		bool end;
-		m_reader.readData(data, DV_FRAME_MAX_LENGTH_BYTES, end);
+bool CAnnouncementUnit::isSending() const
+{
+	return m_sending;
+}
 
-		m_handler->transmitAnnouncementData(data, DV_FRAME_LENGTH_BYTES, false);
-		m_out++;
+bool CAnnouncementUnit::reload(bool external)
+{
+	bool changed;
 
-		if (end) {
-			m_handler->transmitAnnouncementData(END_PATTERN_BYTES, DV_FRAME_LENGTH_BYTES, true);
-			m_reader.close();
-			m_sending = false;
-			m_out = 0U;
-			return;
+	m_mutex.Lock();
+	changed   = m_changed;
+	m_changed = false;
+	m_mutex.Unlock();
+
+	if (!changed && !external)
+		return false;
+
+	// The file is only read again if it has been changed since it was last loaded
+	wxString fileName = findFile();
+	if (!changed && fileName == m_fileName && (fileName.IsEmpty() || wxFileName(fileName).GetModificationTime() == m_modified))
+		return false;
+
+	m_fileName = fileName;
+
+	CHeaderData header;
+	unsigned char* data = NULL;
+	unsigned int length = 0U;
+	load(header, data, length);
+
+	wxMutexLocker locker(m_mutex);
+
+	// One read before it has been taken up is simply replaced
+	delete[] m_newData;
+
+	m_newHeader = header;
+	m_newData   = data;
+	m_newLength = length;
+	m_loaded    = true;
+
+	return true;
+}
+
+wxString CAnnouncementUnit::findFile() const
+{
+	wxFileName fileName1(wxFileName::GetHomeDir(), m_localFileName, wxT("dvtool"));
+	if (wxFile::Exists(fileName1.GetFullPath()))
+		return fileName1.GetFullPath();
+
+	wxFileName fileName2(wxFileName::GetHomeDir(), GLOBAL_FILE_NAME, wxT("dvtool"));
+	if (wxFile::Exists(fileName2.GetFullPath()))
+		return fileName2.GetFullPath();
+
+	return wxEmptyString;
+}
+
+// Reads the whole announcement into memory, so that playing it needs no file access. No file, or one
+// that cannot be read, gives a length of zero.
+void CAnnouncementUnit::load(CHeaderData& header, unsigned char*& data, unsigned int& length)
+{
+	if (m_fileName.IsEmpty())
+		return;
+
+	// Take the time first so that a change made while reading is picked up next time
+	m_modified = wxFileName(m_fileName).GetModificationTime();
+
+	bool ret = m_reader.open(m_fileName);
+	if (!ret) {
+		wxLogError(wxT("Cannot open the announcement file %s"), m_fileName.c_str());
+		return;
+	}
+
+	DVTFR_TYPE type = m_reader.read();
+	if (type != DVTFR_HEADER) {
+		wxLogError(wxT("Invalid header element in the file - %d"), int(type));
+		m_reader.close();
+		return;
+	}
+
+	bool valid = m_reader.readHeader(header);
+	if (!valid) {
+		wxLogError(wxT("Invalid header element in the file"));
+		m_reader.close();
+		return;
+	}
+
+	// Remove the repeater bit
+	header.setFlag1(header.getFlag1() & ~REPEATER_MASK);
+
+	// The record count includes the header, so there is always room for the data
+	unsigned int records = m_reader.getRecords();
+
+	data = new unsigned char[records * DV_FRAME_LENGTH_BYTES];
+	::memset(data, 0x00U, records * DV_FRAME_LENGTH_BYTES);
+
+	bool end = false;
+	while (!end && length < records) {
+		type = m_reader.read();
+		if (type != DVTFR_DATA) {
+			wxLogError(wxT("Invalid data element in the file - %d"), int(type));
+			break;
 		}
+
+		m_reader.readData(data + length * DV_FRAME_LENGTH_BYTES, DV_FRAME_LENGTH_BYTES, end);
+		length++;
 	}
+
+	m_reader.close();
+
+	if (length == 0U) {
+		delete[] data;
+		data = NULL;
+		return;
+	}
+
+	wxLogMessage(wxT("Loaded the announcement in %s, %u frames"), m_fileName.c_str(), length);
 }
@@ -27,6 +27,8 @@
 
 #include <wx/wx.h>
 
+// The file is read by the callsign list reloader, away from the repeater thread, and the new frames are
+// swapped in when the next announcement is started
 class CAnnouncementUnit {
 public:
 	CAnnouncementUnit(IAnnouncementCallback* handler, const wxString& callsign);
@@ -41,14 +43,34 @@ public:
 
 	void clock();
 
+	bool isSending() const;
+
+	// Called from the reloader thread. A new recording or a deletion is always picked up, changes made
+	// to the files from outside only if external is set. Returns true if the file was read again.
+	bool reload(bool external);
+
 private:
 	IAnnouncementCallback* m_handler;
 	wxString               m_localFileName;
 	CDVTOOLFileReader      m_reader;
 	CDVTOOLFileWriter      m_writer;
+	wxString               m_fileName;
+	wxDateTime             m_modified;
+	wxMutex                m_mutex;
+	bool                   m_changed;
+	bool                   m_loaded;
+	CHeaderData            m_newHeader;
+	unsigned char*         m_newData;
+	unsigned int           m_newLength;
+	CHeaderData            m_header;
+	unsigned char*         m_data;
+	unsigned int           m_length;
 	wxStopWatch            m_time;
 	unsigned int           m_out;
 	bool                   m_sending;
+
+	wxString findFile() const;
+	void     load(CHeaderData& header, unsigned char*& data, unsigned int& length);
 };
 
 #endif
@@ -22,41 +22,10 @@
 #include "SlowDataEncoder.h"
 #include "BeaconCallback.h"
 #include "DStarDefines.h"
+#include "BeaconVoice.h"
 
 #include <wx/wx.h>
 
-class CIndexRecord {
-public:
-	CIndexRecord(const wxString& name, unsigned int start, unsigned int length) :
-	m_name(name),
-	m_start(start),
-	m_length(length)
-	{
-	}
-
-	wxString getName() const
-	{
-		return m_name;
-	}
-
-	unsigned int getStart() const
-	{
-		return m_start;
-	}
-
-	unsigned int getLength() const
-	{
-		return m_length;
-	}
-
-private:
-	wxString     m_name;
-	unsigned int m_start;
-	unsigned int m_length;
-};
-
-WX_DECLARE_STRING_HASH_MAP(CIndexRecord*, CIndexList_t);
-
 class CBeaconUnit {
 public:
 	CBeaconUnit(IBeaconCallback* handler, const wxString& callsign, const wxString& text, bool voice, TEXT_LANG language);
@@ -66,12 +35,11 @@ public:
 
 	void clock();
 
+	bool isSending() const;
+
 private:
-	unsigned char*   m_ambe;
-	unsigned int     m_ambeLength;
+	CBeaconVoice*    m_voice;
 	unsigned char*   m_data;
-	unsigned int     m_dataLength;
-	CIndexList_t     m_index;
 	TEXT_LANG        m_language;
 	IBeaconCallback* m_handler;
 	wxString         m_callsign;
@@ -82,11 +50,9 @@ private:
 	wxStopWatch      m_time;
 	bool             m_sending;
 
+	void build();
 	bool lookup(const wxString& id);
 	void spellCallsign(const wxString& callsign);
-
-	bool readAMBE(const wxString& name);
-	bool readIndex(const wxString& name);
 };
 
 #endif
@@ -0,0 +1,592 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "BeaconVoice.h"
+
+#include <wx/filename.h>
+#include <wx/textfile.h>
+#include <wx/tokenzr.h>
+#include <wx/ffile.h>
+
+#if !defined(__WINDOWS__)
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+const unsigned int SILENCE_LENGTH = 10U;
+
+// How many seeds are tried before the hash table is made bigger
+const unsigned int MAX_SEEDS = 1000U;
+
+// The offsets in a voice file are 32 bits
+const wxUint64 MAX_VOICE_SIZE = 0xFFFFFFFFU;
+
+const wxUint32 FNV_OFFSET = 2166136261U;
+const wxUint32 FNV_PRIME  = 16777619U;
+
+CBeaconVoiceList_t CBeaconVoice::m_voices;
+wxMutex            CBeaconVoice::m_mutex;
+
+CBeaconVoice* CBeaconVoice::acquire(TEXT_LANG language)
+{
+	wxMutexLocker locker(m_mutex);
+
+	CBeaconVoiceList_t::iterator it = m_voices.find(int(language));
+	if (it != m_voices.end()) {
+		it->second->m_count++;
+		return it->second;
+	}
+
+	CBeaconVoice* voice = new CBeaconVoice(language);
+
+	bool ret = voice->load();
+	if (!ret) {
+		delete voice;
+		return NULL;
+	}
+
+	voice->m_count = 1U;
+	m_voices[int(language)] = voice;
+
+	return voice;
+}
+
+void CBeaconVoice::release(CBeaconVoice* voice)
+{
+	wxASSERT(voice != NULL);
+
+	wxMutexLocker locker(m_mutex);
+
+	wxASSERT(voice->m_count > 0U);
+
+	voice->m_count--;
+	if (voice->m_count > 0U)
+		return;
+
+	m_voices.erase(int(voice->m_language));
+
+	delete voice;
+}
+
+CBeaconVoice::CBeaconVoice(TEXT_LANG language) :
+m_language(language),
+m_count(0U),
+m_image(NULL),
+m_size(0U),
+m_mapped(false),
+m_header(NULL),
+m_slots(NULL),
+m_names(NULL),
+m_frames(NULL)
+{
+}
+
+CBeaconVoice::~CBeaconVoice()
+{
+#if !defined(__WINDOWS__)
+	if (m_mapped) {
+		::munmap(m_image, m_size);
+		return;
+	}
+#endif
+
+	delete[] m_image;
+}
+
+bool CBeaconVoice::find(const wxString& id, unsigned int& start, unsigned int& length) const
+{
+	const CVoiceSlot& slot = m_slots[hash(id, m_header->m_seed) & (m_header->m_slots - 1U)];
+
+	if (slot.m_nameLength != id.Len())
+		return false;
+
+	const char* name = m_names + slot.m_name;
+	for (unsigned int i = 0U; i < slot.m_nameLength; i++) {
+		if (wxChar(name[i]) != id.GetChar(i))
+			return false;
+	}
+
+	start  = slot.m_start;
+	length = slot.m_length;
+
+	return true;
+}
+
+const unsigned char* CBeaconVoice::getFrames(unsigned int start) const
+{
+	return m_frames + start * DV_FRAME_LENGTH_BYTES;
+}
+
+bool CBeaconVoice::load()
+{
+	wxString name;
+
+	switch (m_language) {
+		case TL_DEUTSCH:
+			name = wxT("de_DE");
+			break;
+		case TL_DANSK:
+			name = wxT("dk_DK");
+			break;
+		case TL_ITALIANO:
+			name = wxT("it_IT");
+			break;
+		case TL_FRANCAIS:
+			name = wxT("fr_FR");
+			break;
+		case TL_ESPANOL:
+			name = wxT("es_ES");
+			break;
+		case TL_SVENSKA:
+			name = wxT("se_SE");
+			break;
+		case TL_POLSKI:
+			name = wxT("pl_PL");
+			break;
+		case TL_ENGLISH_US:
+			name = wxT("en_US");
+			break;
+		case TL_NORSK:
+			name = wxT("no_NO");
+			break;
+//		case TL_NEDERLANDS_NL:
+//			name = wxT("nl_NL");
+//			break;
+//		case TL_NEDERLANDS_BE:
+//			name = wxT("nl_BE");
+//			break;
+		default:
+			name = wxT("en_GB");
+			break;
+	}
+
+	// Use the compiled voice if there is one, it is shared with every other process that maps it
+	wxString voiceFileName = findFile(name + wxT(".voice"));
+	if (!voiceFileName.IsEmpty()) {
+		bool ret = map(voiceFileName);
+		if (ret) {
+			ret = check();
+			if (ret)
+				return true;
+
+			wxLogError(wxT("The voice file %s is invalid"), voiceFileName.c_str());
+		}
+
+#if !defined(__WINDOWS__)
+		if (m_mapped)
+			::munmap(m_image, m_size);
+		else
+#endif
+			delete[] m_image;
+
+		m_image  = NULL;
+		m_mapped = false;
+	}
+
+	wxString ambeFileName = findFile(name + wxT(".ambe"));
+	if (ambeFileName.IsEmpty())
+		return false;
+
+	wxString indxFileName = findFile(name + wxT(".indx"));
+	if (indxFileName.IsEmpty())
+		return false;
+
+	m_image = compile(ambeFileName, indxFileName, m_size);
+	if (m_image == NULL)
+		return false;
+
+	return check();
+}
+
+bool CBeaconVoice::map(const wxString& fileName)
+{
+	wxLogMessage(wxT("Reading %s"), fileName.c_str());
+
+#if defined(__WINDOWS__)
+	wxFFile file;
+
+	bool ret = file.Open(fileName.c_str(), wxT("rb"));
+	if (!ret) {
+		wxLogMessage(wxT("Cannot open %s for reading"), fileName.c_str());
+		return false;
+	}
+
+	m_size  = file.Length();
+	m_image = new unsigned char[m_size];
+
+	size_t n = file.Read(m_image, m_size);
+	if (n != m_size) {
+		wxLogMessage(wxT("Unable to read the voice data from %s"), fileName.c_str());
+		file.Close();
+		return false;
+	}
+
+	file.Close();
+#else
+	int fd = ::open(fileName.mb_str(), O_RDONLY);
+	if (fd < 0) {
+		wxLogMessage(wxT("Cannot open %s for reading, errno=%d"), fileName.c_str(), errno);
+		return false;
+	}
+
+	struct stat st;
+	if (::fstat(fd, &st) < 0 || st.st_size == 0) {
+		wxLogMessage(wxT("Cannot find the size of %s, errno=%d"), fileName.c_str(), errno);
+		::close(fd);
+		return false;
+	}
+
+	m_size = st.st_size;
+
+	void* map = ::mmap(NULL, m_size, PROT_READ, MAP_SHARED, fd, 0);
+	if (map == MAP_FAILED) {
+		wxLogMessage(wxT("Cannot map %s, errno=%d"), fileName.c_str(), errno);
+		::close(fd);
+		return false;
+	}
+
+	// The mapping outlives the descriptor
+	::close(fd);
+
+	m_image  = (unsigned char*)map;
+	m_mapped = true;
+#endif
+
+	return true;
+}
+
+// Nothing in the image is used until every offset in it has been checked against its size
+bool CBeaconVoice::check()
+{
+	if (m_size < sizeof(CVoiceHeader))
+		return false;
+
+	m_header = (const CVoiceHeader*)m_image;
+
+	if (::memcmp(m_header->m_magic, VOICE_MAGIC, 8U) != 0 || m_header->m_version != VOICE_VERSION)
+		return false;
+
+	wxUint32 slots = m_header->m_slots;
+	if (slots == 0U || (slots & (slots - 1U)) != 0U)
+		return false;
+
+	// Bound the slots first, so that the size of the table cannot overflow
+	if (slots > (m_size - sizeof(CVoiceHeader)) / sizeof(CVoiceSlot))
+		return false;
+
+	if (m_header->m_names < sizeof(CVoiceHeader) + slots * sizeof(CVoiceSlot) || m_header->m_data < m_header->m_names || m_header->m_data > m_size)
+		return false;
+
+	if (m_header->m_frames > (m_size - m_header->m_data) / DV_FRAME_LENGTH_BYTES)
+		return false;
+
+	m_slots  = (const CVoiceSlot*)(m_image + sizeof(CVoiceHeader));
+	m_names  = (const char*)(m_image + m_header->m_names);
+	m_frames = m_image + m_header->m_data;
+
+	wxUint32 namesLength = m_header->m_data - m_header->m_names;
+
+	for (wxUint32 i = 0U; i < slots; i++) {
+		const CVoiceSlot& slot = m_slots[i];
+
+		if (slot.m_nameLength == 0U)
+			continue;
+
+		if (slot.m_name > namesLength || slot.m_nameLength > (namesLength - slot.m_name))
+			return false;
+
+		if (slot.m_start > m_header->m_frames || slot.m_length > (m_header->m_frames - slot.m_start))
+			return false;
+	}
+
+	return true;
+}
+
+unsigned char* CBeaconVoice::compile(const wxString& ambeFileName, const wxString& indxFileName, size_t& size)
+{
+	unsigned int frames;
+	unsigned char* ambe = readAMBE(ambeFileName, frames);
+	if (ambe == NULL)
+		return NULL;
+
+	CIndexList_t index;
+	bool ret = readIndex(indxFileName, frames, index);
+	if (!ret) {
+		delete[] ambe;
+		return NULL;
+	}
+
+	// The names are only held as bytes, so anything else cannot be found
+	wxUint32 namesLength = 0U;
+	for (CIndexList_t::iterator it = index.begin(); it != index.end(); ++it) {
+		wxString name = it->first;
+
+		bool ascii = name.Len() <= 0xFFFFU;
+		for (unsigned int i = 0U; ascii && i < name.Len(); i++)
+			ascii = wxUint32(name.GetChar(i)) < 0x80U;
+
+		if (!ascii) {
+			wxLogError(wxT("The name *%s* cannot be held in a voice file"), name.c_str());
+			delete it->second;
+			it->second = NULL;
+			continue;
+		}
+
+		namesLength += name.Len();
+	}
+
+	// Keep trying seeds until no two names share a slot, the table is made bigger if none is found
+	wxUint32 words = index.size();
+	wxUint32 slots = 16U;
+	while (slots < words * 2U)
+		slots *= 2U;
+
+	wxUint32 seed = 0U;
+	bool* used = NULL;
+	for (bool found = false; !found;) {
+		delete[] used;
+		used = new bool[slots];
+
+		for (seed = 0U; !found && seed < MAX_SEEDS; seed++) {
+			::memset(used, 0x00U, slots * sizeof(bool));
+
+			found = true;
+			for (CIndexList_t::iterator it = index.begin(); found && it != index.end(); ++it) {
+				if (it->second == NULL)
+					continue;
+
+				wxUint32 n = hash(it->first, seed) & (slots - 1U);
+				found = !used[n];
+				used[n] = true;
+			}
+		}
+
+		if (found)
+			seed--;
+		else if (wxUint64(slots) * 2U * sizeof(CVoiceSlot) > MAX_VOICE_SIZE)
+			break;
+		else
+			slots *= 2U;
+	}
+
+	delete[] used;
+
+	// Check the size in 64 bits before working out the 32 bit offsets
+	wxUint64 total = wxUint64(sizeof(CVoiceHeader)) + wxUint64(slots) * sizeof(CVoiceSlot) + namesLength + 3U + wxUint64(frames) * DV_FRAME_LENGTH_BYTES;
+	if (seed >= MAX_SEEDS || total > MAX_VOICE_SIZE) {
+		wxLogError(wxT("The voice file for %s is too large"), ambeFileName.c_str());
+
+		for (CIndexList_t::iterator it = index.begin(); it != index.end(); ++it)
+			delete it->second;
+
+		delete[] ambe;
+		return NULL;
+	}
+
+	wxUint32 names = sizeof(CVoiceHeader) + slots * sizeof(CVoiceSlot);
+	wxUint32 data  = (names + namesLength + 3U) & ~3U;
+
+	size = data + frames * DV_FRAME_LENGTH_BYTES;
+
+	unsigned char* image = new unsigned char[size];
+	::memset(image, 0x00U, size);
+
+	CVoiceHeader* header = (CVoiceHeader*)image;
+	::memcpy(header->m_magic, VOICE_MAGIC, 8U);
+	header->m_version = VOICE_VERSION;
+	header->m_seed    = seed;
+	header->m_slots   = slots;
+	header->m_frames  = frames;
+	header->m_names   = names;
+	header->m_data    = data;
+
+	CVoiceSlot* slot = (CVoiceSlot*)(image + sizeof(CVoiceHeader));
+
+	wxUint32 offset = 0U;
+	for (CIndexList_t::iterator it = index.begin(); it != index.end(); ++it) {
+		CIndexRecord* record = it->second;
+		if (record == NULL)
+			continue;
+
+		wxString name = it->first;
+
+		CVoiceSlot& entry = slot[hash(name, seed) & (slots - 1U)];
+		entry.m_name       = offset;
+		entry.m_nameLength = name.Len();
+		entry.m_length     = record->getLength();
+		entry.m_start      = record->getStart();
+
+		for (unsigned int i = 0U; i < name.Len(); i++)
+			image[names + offset++] = (unsigned char)name.GetChar(i);
+
+		delete record;
+	}
+
+	// The slow data is left as zeros, it is filled in when the beacon is assembled
+	for (unsigned int i = 0U; i < frames; i++)
+		::memcpy(image + data + i * DV_FRAME_LENGTH_BYTES, ambe + i * VOICE_FRAME_LENGTH_BYTES, VOICE_FRAME_LENGTH_BYTES);
+
+	delete[] ambe;
+
+	return image;
+}
+
+wxUint32 CBeaconVoice::hash(const wxString& name, wxUint32 seed)
+{
+	wxUint32 h = FNV_OFFSET ^ seed;
+
+	for (unsigned int i = 0U; i < name.Len(); i++) {
+		h ^= wxUint32(name.GetChar(i));
+		h *= FNV_PRIME;
+	}
+
+	return h;
+}
+
+wxString CBeaconVoice::findFile(const wxString& name)
+{
+	wxFileName fileName(wxFileName::GetHomeDir(), name);
+
+	if (!fileName.IsFileReadable()) {
+		wxLogMessage(wxT("File %s not readable"), fileName.GetFullPath().c_str());
+#if defined(__WINDOWS__)
+		fileName.Assign(::wxGetCwd(), name);
+#else
+		fileName.Assign(wxT(DATA_DIR), name);
+#endif
+		if (!fileName.IsFileReadable()) {
+			wxLogMessage(wxT("File %s not readable"), fileName.GetFullPath().c_str());
+			return wxEmptyString;
+		}
+	}
+
+	return fileName.GetFullPath();
+}
+
+// Returns the AMBE data with the silence at the start, frames is the number of frames in the file
+unsigned char* CBeaconVoice::readAMBE(const wxString& fileName, unsigned int& frames)
+{
+	wxFFile file;
+
+	bool ret = file.Open(fileName.c_str(), wxT("rb"));
+	if (!ret) {
+		wxLogMessage(wxT("Cannot open %s for reading"), fileName.c_str());
+		return NULL;
+	}
+
+	wxLogMessage(wxT("Reading %s"), fileName.c_str());
+
+	unsigned char buffer[VOICE_FRAME_LENGTH_BYTES];
+
+	size_t n = file.Read(buffer, 4U);
+	if (n != 4U) {
+		wxLogMessage(wxT("Unable to read the header from %s"), fileName.c_str());
+		file.Close();
+		return NULL;
+	}
+
+	if (::memcmp(buffer, "AMBE", 4U) != 0) {
+		wxLogMessage(wxT("Invalid header from %s"), fileName.c_str());
+		file.Close();
+		return NULL;
+	}
+
+	// Length of the file minus the header
+	unsigned int length = file.Length() - 4U;
+
+	frames = length / VOICE_FRAME_LENGTH_BYTES;
+	length = frames * VOICE_FRAME_LENGTH_BYTES;
+
+	// Hold the file data plus silence at the beginning
+	unsigned char* ambe = new unsigned char[length + SILENCE_LENGTH * VOICE_FRAME_LENGTH_BYTES];
+
+	unsigned char* p = ambe;
+	for (unsigned int i = 0U; i < SILENCE_LENGTH; i++, p += VOICE_FRAME_LENGTH_BYTES)
+		::memcpy(p, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
+
+	n = file.Read(p, length);
+	if (n != length) {
+		wxLogMessage(wxT("Unable to read the AMBE data from %s"), fileName.c_str());
+		file.Close();
+		delete[] ambe;
+		return NULL;
+	}
+
+	file.Close();
+
+	frames += SILENCE_LENGTH;
+
+	return ambe;
+}
+
+bool CBeaconVoice::readIndex(const wxString& fileName, unsigned int frames, CIndexList_t& index)
+{
+	wxTextFile file;
+
+	bool ret = file.Open(fileName);
+	if (!ret) {
+		wxLogMessage(wxT("Cannot open %s for reading"), fileName.c_str());
+		return false;
+	}
+
+	// Add a silence entry at the beginning
+	index[wxT(" ")] = new CIndexRecord(wxT(" "), 0U, SILENCE_LENGTH);
+
+	wxLogMessage(wxT("Reading %s"), fileName.c_str());
+
+	unsigned int ambeLength = frames - SILENCE_LENGTH;
+
+	unsigned int nLines = file.GetLineCount();
+
+	for (unsigned int i = 0; i < nLines; i++) {
+		wxString line = file.GetLine(i);
+
+		if (line.length() > 0 && line.GetChar(0) != wxT('#')) {
+			wxStringTokenizer t(line, wxT(" \t\r\n"), wxTOKEN_STRTOK);
+			wxString name      = t.GetNextToken();
+			wxString startTxt  = t.GetNextToken();
+			wxString lengthTxt = t.GetNextToken();
+
+			if (!name.IsEmpty() && !startTxt.IsEmpty() && !lengthTxt.IsEmpty()) {
+				unsigned long start;
+				startTxt.ToULong(&start);
+
+				unsigned long length;
+				lengthTxt.ToULong(&length);
+
+				if (start >= ambeLength || (start + length) >= ambeLength) {
+					wxLogError(wxT("The start or end for *%s* is out of range, start: %lu, end: %lu"), name.c_str(), start, start + length);
+				} else {
+					CIndexList_t::iterator it = index.find(name);
+					if (it != index.end())
+						delete it->second;
+
+					index[name] = new CIndexRecord(name, start + SILENCE_LENGTH, length);
+				}
+			}
+		}
+	}
+
+	file.Close();
+
+	return true;
+}
@@ -0,0 +1,132 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	BeaconVoice_H
+#define	BeaconVoice_H
+
+#include "DStarDefines.h"
+
+#include <wx/wx.h>
+
+const char         VOICE_MAGIC[] = "DSRVOICE";
+const unsigned int VOICE_VERSION = 1U;
+
+// A compiled voice file is this header, the hash table, the names and then the frames, in the byte
+// order of the machine that built it. Each frame is a full DV frame, the slow data is left for the
+// beacon to fill in. The hash table is perfect, the seed was chosen when the file was built so that
+// no two words share a slot.
+struct CVoiceHeader {
+	char     m_magic[8U];
+	wxUint32 m_version;
+	wxUint32 m_seed;
+	wxUint32 m_slots;		// Entries in the hash table, a power of two
+	wxUint32 m_frames;
+	wxUint32 m_names;		// Offset of the names from the start of the file
+	wxUint32 m_data;		// Offset of the frames from the start of the file
+};
+
+struct CVoiceSlot {
+	wxUint32 m_name;		// Offset of the name from the start of the names
+	wxUint16 m_nameLength;	// Zero for an empty slot
+	wxUint16 m_length;		// In frames
+	wxUint32 m_start;		// The first frame
+};
+
+class CIndexRecord {
+public:
+	CIndexRecord(const wxString& name, unsigned int start, unsigned int length) :
+	m_name(name),
+	m_start(start),
+	m_length(length)
+	{
+	}
+
+	wxString getName() const
+	{
+		return m_name;
+	}
+
+	unsigned int getStart() const
+	{
+		return m_start;
+	}
+
+	unsigned int getLength() const
+	{
+		return m_length;
+	}
+
+private:
+	wxString     m_name;
+	unsigned int m_start;
+	unsigned int m_length;
+};
+
+WX_DECLARE_STRING_HASH_MAP(CIndexRecord*, CIndexList_t);
+
+class CBeaconVoice;
+
+WX_DECLARE_HASH_MAP(int, CBeaconVoice*, wxIntegerHash, wxIntegerEqual, CBeaconVoiceList_t);
+
+// The voice of one language, shared read only by every beacon in the process that uses it. The compiled
+// voice file is mapped into memory where there is one, otherwise the same image is built on the heap
+// from the .ambe and .indx files.
+class CBeaconVoice {
+public:
+	// Returns NULL if the files for the language cannot be read
+	static CBeaconVoice* acquire(TEXT_LANG language);
+	static void release(CBeaconVoice* voice);
+
+	// Builds the image of a compiled voice file, returns NULL if the files cannot be read
+	static unsigned char* compile(const wxString& ambeFileName, const wxString& indxFileName, size_t& size);
+
+	// Returns false if there is no entry for the word
+	bool find(const wxString& id, unsigned int& start, unsigned int& length) const;
+
+	// The frames of a word follow each other, DV_FRAME_LENGTH_BYTES apart
+	const unsigned char* getFrames(unsigned int start) const;
+
+private:
+	TEXT_LANG            m_language;
+	unsigned int         m_count;
+	unsigned char*       m_image;
+	size_t               m_size;
+	bool                 m_mapped;
+	const CVoiceHeader*  m_header;
+	const CVoiceSlot*    m_slots;
+	const char*          m_names;
+	const unsigned char* m_frames;
+
+	static CBeaconVoiceList_t m_voices;
+	static wxMutex            m_mutex;
+
+	CBeaconVoice(TEXT_LANG language);
+	~CBeaconVoice();
+
+	bool load();
+	bool map(const wxString& fileName);
+	bool check();
+
+	static wxUint32 hash(const wxString& name, wxUint32 seed);
+	static wxString findFile(const wxString& name);
+
+	static unsigned char* readAMBE(const wxString& fileName, unsigned int& frames);
+	static bool readIndex(const wxString& fileName, unsigned int frames, CIndexList_t& index);
+};
+
+#endif
@@ -19,58 +19,277 @@
 #include "CallsignList.h"
 #include "DStarDefines.h"
 
-#include <wx/textfile.h>
+#include <wx/filename.h>
+#include <wx/ffile.h>
+
+// A wildcard entry has its length, with the top bit set, in the last byte, which a callsign character cannot have
+const wxUint64 WILDCARD_FLAG = 0x80U;
+
+const unsigned int MIN_INDEX_BITS = 4U;
+
+// An open addressing hash of callsigns held as eight bytes, with linear probing. Once built it is never
+// changed, so it may be read from any thread.
+class CCallsignIndex {
+public:
+	CCallsignIndex(unsigned int size) :
+	m_table(NULL),
+	m_bits(MIN_INDEX_BITS),
+	m_count(0U),
+	m_wildcards(0U)
+	{
+		// Keep the table no more than half full
+		while ((1U << m_bits) < (size * 2U))
+			m_bits++;
+
+		m_table = new wxUint64[1U << m_bits];
+		::memset(m_table, 0x00, (1U << m_bits) * sizeof(wxUint64));
+	}
+
+	~CCallsignIndex()
+	{
+		delete[] m_table;
+	}
+
+	void add(wxUint64 key)
+	{
+		unsigned int mask = (1U << m_bits) - 1U;
+
+		unsigned int n = hash(key);
+		while (m_table[n] != 0U) {
+			if (m_table[n] == key)
+				return;
+
+			n = (n + 1U) & mask;
+		}
+
+		m_table[n] = key;
+
+		m_count++;
+	}
+
+	void addWildcard(wxUint64 key, unsigned int length)
+	{
+		add(wildcard(key, length));
+
+		m_wildcards |= 1U << length;
+	}
+
+	bool find(wxUint64 key) const
+	{
+		if (contains(key))
+			return true;
+
+		for (unsigned int length = 0U; length < LONG_CALLSIGN_LENGTH; length++) {
+			if ((m_wildcards & (1U << length)) != 0U && contains(wildcard(key, length)))
+				return true;
+		}
+
+		return false;
+	}
+
+	unsigned int getCount() const
+	{
+		return m_count;
+	}
+
+private:
+	wxUint64*    m_table;
+	unsigned int m_bits;
+	unsigned int m_count;
+	unsigned int m_wildcards;
+
+	unsigned int hash(wxUint64 key) const
+	{
+		return (unsigned int)((key * wxULL(0x9E3779B97F4A7C15)) >> (64U - m_bits));
+	}
+
+	bool contains(wxUint64 key) const
+	{
+		unsigned int mask = (1U << m_bits) - 1U;
+
+		for (unsigned int n = hash(key); m_table[n] != 0U; n = (n + 1U) & mask) {
+			if (m_table[n] == key)
+				return true;
+		}
+
+		return false;
+	}
+
+	static wxUint64 wildcard(wxUint64 key, unsigned int length)
+	{
+		wxUint64 mask = (length == 0U) ? 0U : (~wxULL(0) >> (64U - length * 8U));
+
+		return (key & mask) | ((WILDCARD_FLAG | length) << 56);
+	}
+};
 
 CCallsignList::CCallsignList(const wxString& filename) :
 m_filename(filename),
-m_callsigns()
+m_modified(),
+m_index(NULL),
+m_readers(0U)
 {
 }
 
-
 CCallsignList::~CCallsignList()
 {
+	delete m_index.load();
 }
 
 bool CCallsignList::load()
 {
-	wxTextFile file;
+	wxFileName fileName(m_filename);
+
+	// Take the time first so that a change made while reading is picked up next time
+	wxDateTime modified = fileName.GetModificationTime();
+
+	wxFFile file;
 
-	bool res = file.Open(m_filename);
+	bool res = file.Open(m_filename, wxT("rb"));
 	if (!res)
 		return false;
 
-	unsigned int lines = file.GetLineCount();
-	if (lines == 0U) {
-		file.Close();
-		return true;
+	unsigned int length = file.Length();
+
+	unsigned char* buffer = new unsigned char[length + 1U];
+
+	size_t n = file.Read(buffer, length);
+
+	file.Close();
+
+	if (n != length) {
+		delete[] buffer;
+		return false;
+	}
+
+	buffer[length] = '\n';
+
+	unsigned int lines = 0U;
+	for (unsigned int i = 0U; i <= length; i++) {
+		if (buffer[i] == '\n')
+			lines++;
 	}
 
-	m_callsigns.Alloc(lines);
+	CCallsignIndex* index = new CCallsignIndex(lines);
+
+	unsigned int start = 0U;
+	for (unsigned int i = 0U; i <= length; i++) {
+		if (buffer[i] != '\n')
+			continue;
+
+		unsigned int end = i;
+		while (end > start && ::isspace(buffer[end - 1U]))
+			end--;
 
-	wxString callsign = file.GetFirstLine();
+		bool wildcard = end > start && buffer[end - 1U] == '*';
+		if (wildcard)
+			end--;
 
-	while (!file.Eof()) {
-		callsign.MakeUpper();
-		callsign.Append(wxT("        "));
-		callsign.Truncate(LONG_CALLSIGN_LENGTH);
+		if (end > (start + LONG_CALLSIGN_LENGTH))
+			end = start + LONG_CALLSIGN_LENGTH;
 
-		m_callsigns.Add(callsign);
+		bool valid = wildcard || end > start;
 
-		callsign = file.GetNextLine();
+		wxUint64 key = 0U;
+		for (unsigned int j = 0U; j < LONG_CALLSIGN_LENGTH; j++) {
+			unsigned char c = (start + j) < end ? buffer[start + j] : ' ';
+			if (c >= 0x80U)
+				valid = false;
+
+			key |= wxUint64(::toupper(c)) << (j * 8U);
+		}
+
+		if (valid) {
+			if (wildcard && (end - start) < LONG_CALLSIGN_LENGTH)
+				index->addWildcard(key, end - start);
+			else
+				index->add(key);
+		}
+
+		start = i + 1U;
 	}
 
-	file.Close();
+	delete[] buffer;
+
+	// Any lookup that starts from now on uses the new index, so once no lookup is running the old one
+	// cannot be in use. Lookups are short, this only waits for the ones already started.
+	CCallsignIndex* old = m_index.exchange(index);
+
+	while (m_readers.load() > 0U)
+		::wxMilliSleep(1UL);
+
+	delete old;
+
+	m_modified = modified;
 
 	return true;
 }
 
+bool CCallsignList::reload()
+{
+	wxFileName fileName(m_filename);
+	if (!fileName.FileExists())
+		return false;
+
+	if (fileName.GetModificationTime() == m_modified)
+		return false;
+
+	return load();
+}
+
 unsigned int CCallsignList::getCount() const
 {
-	return m_callsigns.GetCount();
+	m_readers++;
+
+	CCallsignIndex* index = m_index.load();
+	unsigned int count = index != NULL ? index->getCount() : 0U;
+
+	m_readers--;
+
+	return count;
 }
 
 bool CCallsignList::isInList(const wxString& callsign) const
 {
-	return m_callsigns.Index(callsign) != wxNOT_FOUND;
+	if (callsign.Len() != LONG_CALLSIGN_LENGTH)
+		return false;
+
+	wxUint64 key = 0U;
+	for (unsigned int i = 0U; i < LONG_CALLSIGN_LENGTH; i++) {
+		unsigned int c = (unsigned int)(wxChar)callsign.GetChar(i);
+		if (c >= 0x80U)
+			return false;
+
+		key |= wxUint64(c) << (i * 8U);
+	}
+
+	return find(key);
+}
+
+bool CCallsignList::isInList(const unsigned char* callsign) const
+{
+	wxASSERT(callsign != NULL);
+
+	wxUint64 key = 0U;
+	for (unsigned int i = 0U; i < LONG_CALLSIGN_LENGTH; i++) {
+		if (callsign[i] >= 0x80U)
+			return false;
+
+		key |= wxUint64(callsign[i]) << (i * 8U);
+	}
+
+	return find(key);
+}
+
+bool CCallsignList::find(wxUint64 key) const
+{
+	// The index is not deleted while the count is held
+	m_readers++;
+
+	CCallsignIndex* index = m_index.load();
+	bool found = index != NULL && index->find(key);
+
+	m_readers--;
+
+	return found;
 }
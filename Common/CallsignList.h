@@ -21,6 +21,12 @@
 
 #include <wx/wx.h>
 
+#include <atomic>
+
+class CCallsignIndex;
+
+// A list of callsigns, an entry ending in a * matches every callsign that begins with the rest of it.
+// The list may be reloaded from another thread while it is being used.
 class CCallsignList {
 public:
 	CCallsignList(const wxString& filename);
@@ -28,13 +34,21 @@ public:
 
 	bool load();
 
+	// Loads the file again if it has been changed since the last load
+	bool reload();
+
 	unsigned int getCount() const;
 
 	bool isInList(const wxString& callsign) const;
+	bool isInList(const unsigned char* callsign) const;
 
 private:
-	wxString      m_filename;
-	wxArrayString m_callsigns;
+	wxString                          m_filename;
+	wxDateTime                        m_modified;
+	std::atomic<CCallsignIndex*>      m_index;
+	mutable std::atomic<unsigned int> m_readers;
+
+	bool find(wxUint64 key) const;
 };
 
 #endif
@@ -0,0 +1,112 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "CallsignListReloader.h"
+#include "Logger.h"
+
+CCallsignListReloader::CCallsignListReloader(unsigned int interval) :
+wxThread(wxTHREAD_JOINABLE),
+m_interval(interval),
+m_names(),
+m_count(0U),
+m_announcementCount(0U),
+m_killed(false)
+{
+	wxASSERT(interval > 0U);
+
+	for (unsigned int i = 0U; i < MAX_CALLSIGN_LISTS; i++)
+		m_lists[i] = NULL;
+
+	for (unsigned int i = 0U; i < MAX_ANNOUNCEMENTS; i++)
+		m_announcements[i] = NULL;
+}
+
+CCallsignListReloader::~CCallsignListReloader()
+{
+}
+
+void CCallsignListReloader::addList(CCallsignList* list, const wxString& name)
+{
+	wxASSERT(list != NULL);
+
+	if (m_count >= MAX_CALLSIGN_LISTS) {
+		wxLogWarning(wxT("Too many callsign lists, the %s will not be reloaded"), name.c_str());
+		return;
+	}
+
+	m_lists[m_count] = list;
+	m_names[m_count] = name;
+	m_count++;
+}
+
+void CCallsignListReloader::addAnnouncement(CAnnouncementUnit* announcement)
+{
+	wxASSERT(announcement != NULL);
+
+	if (m_announcementCount >= MAX_ANNOUNCEMENTS) {
+		wxLogWarning(wxT("Too many announcements, a changed announcement will not be reloaded"));
+		return;
+	}
+
+	m_announcements[m_announcementCount] = announcement;
+	m_announcementCount++;
+}
+
+void CCallsignListReloader::start()
+{
+	Create();
+	Run();
+}
+
+void* CCallsignListReloader::Entry()
+{
+	CLogger::startThread();
+
+	unsigned int seconds = 0U;
+
+	while (!m_killed) {
+		Sleep(1000UL);
+
+		seconds++;
+
+		bool external = seconds >= m_interval;
+
+		for (unsigned int i = 0U; i < m_announcementCount && !m_killed; i++)
+			m_announcements[i]->reload(external);
+
+		if (!external)
+			continue;
+
+		seconds = 0U;
+
+		for (unsigned int i = 0U; i < m_count && !m_killed; i++) {
+			bool res = m_lists[i]->reload();
+			if (res)
+				wxLogInfo(wxT("%u callsigns reloaded into the %s"), m_lists[i]->getCount(), m_names[i].c_str());
+		}
+	}
+
+	return NULL;
+}
+
+void CCallsignListReloader::kill()
+{
+	m_killed = true;
+
+	Wait();
+}
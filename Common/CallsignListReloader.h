@@ -0,0 +1,57 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	CallsignListReloader_H
+#define	CallsignListReloader_H
+
+#include "AnnouncementUnit.h"
+#include "CallsignList.h"
+
+#include <wx/wx.h>
+
+const unsigned int MAX_CALLSIGN_LISTS = 4U;
+const unsigned int MAX_ANNOUNCEMENTS  = 4U;
+
+// Checks the callsign lists for changes to their files every interval seconds, and reloads them away
+// from the repeater thread. The announcements are read here too, a new recording within a second.
+class CCallsignListReloader : public wxThread {
+public:
+	CCallsignListReloader(unsigned int interval);
+	virtual ~CCallsignListReloader();
+
+	// The lists must all be added before the thread is started
+	void addList(CCallsignList* list, const wxString& name);
+	void addAnnouncement(CAnnouncementUnit* announcement);
+
+	void start();
+
+	virtual void* Entry();
+
+	void kill();
+
+private:
+	unsigned int       m_interval;
+	CCallsignList*     m_lists[MAX_CALLSIGN_LISTS];
+	wxString           m_names[MAX_CALLSIGN_LISTS];
+	unsigned int       m_count;
+	CAnnouncementUnit* m_announcements[MAX_ANNOUNCEMENTS];
+	unsigned int       m_announcementCount;
+	bool               m_killed;
+};
+
+#endif
@@ -95,7 +95,7 @@ const unsigned int  GMSK_MODEM_DATA_LENGTH = 8U;
 
 const unsigned int  RADIO_RUN_FRAME_COUNT   = 5U;
 const unsigned int  LOCAL_RUN_FRAME_COUNT   = 1U;
-const unsigned int  NETWORK_RUN_FRAME_COUNT = 25U;
+const unsigned int  NETWORK_RUN_FRAME_COUNT = 2U;
 
 const unsigned int  DSTAR_BLEEP_FREQ   = 2000U;
 const unsigned int  DSTAR_BLEEP_LENGTH = 100U;
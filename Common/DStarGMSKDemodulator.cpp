@@ -13,19 +13,6 @@
 
 #include "DStarGMSKDemodulator.h"
 
-// Generated by gaussfir(0.5, 4, 10)
-const wxFloat32 COEFFS_TABLE[] = {
-	0.000000000000003F, 0.000000000000065F, 0.000000000001037F, 0.000000000014448F, 0.000000000174579F,
-	0.000000001829471F, 0.000000016627294F, 0.000000131062698F, 0.000000895979719F, 0.000005312253663F, 0.000027316243802F,
-	0.000121821714020F, 0.000471183399421F, 0.001580581180127F, 0.004598383433830F, 0.011602594308899F, 0.025390226926262F,
-	0.048188078330624F, 0.079318443411643F, 0.113232294527059F, 0.140193533802410F, 0.150538369557851F, 0.140193533802410F,
-	0.113232294527059F, 0.079318443411643F, 0.048188078330623F, 0.025390226926262F, 0.011602594308899F, 0.004598383433830F,
-	0.001580581180127F, 0.000471183399421F, 0.000121821714020F, 0.000027316243802F, 0.000005312253663F, 0.000000895979719F,
-	0.000000131062698F, 0.000000016627294F, 0.000000001829471F, 0.000000000174579F, 0.000000000014448F, 0.000000000001037F,
-	0.000000000000065F, 0.000000000000003F};
-
-const unsigned int COEFFS_LENGTH = 43U;
-
 const unsigned int DCOFFSET_COUNT = 4800U;		// 5 seconds
 
 const unsigned int PLLMAX     = 0x10000U;
@@ -34,7 +21,7 @@ const unsigned int INC_LOCK   = PLLINC / 64U;
 const unsigned int INC_UNLOCK = PLLINC / 32U;
 
 CDStarGMSKDemodulator::CDStarGMSKDemodulator() :
-m_filter(COEFFS_TABLE, COEFFS_LENGTH),
+m_filter(),
 m_invert(false),
 m_pll(0U),
 m_prev(false),
@@ -42,12 +29,15 @@ m_inc(INC_UNLOCK),
 m_locked(false),
 m_offset(0.0F),
 m_accum(0.0F),
-m_count(0U)
+m_count(0U),
+m_buffer(NULL)
 {
+	m_buffer = new wxFloat32[DSTAR_RADIO_BLOCK_SIZE];
 }
 
 CDStarGMSKDemodulator::~CDStarGMSKDemodulator()
 {
+	delete[] m_buffer;
 }
 
 TRISTATE CDStarGMSKDemodulator::decode(wxFloat32 val)
@@ -96,6 +86,69 @@ TRISTATE CDStarGMSKDemodulator::decode(wxFloat32 val)
 	return state;
 }
 
+// The bits are packed in arrival order, least significant bit first, and there can never be more
+// bits than samples. Changes to the lock state take effect at the start of the next block. The
+// optional soft values are the filter output at each decision, positive for a one.
+unsigned int CDStarGMSKDemodulator::decode(const wxFloat32* in, unsigned int length, unsigned char* bits, wxFloat32* soft)
+{
+	wxASSERT(in != NULL);
+	wxASSERT(bits != NULL);
+	wxASSERT(length <= DSTAR_RADIO_BLOCK_SIZE);
+
+	for (unsigned int i = 0U; i < length; i++) {
+		// Calculate the DC offset when we are locked
+		if (m_locked) {
+			m_accum += in[i];
+			m_count++;
+
+			if (m_count >= DCOFFSET_COUNT) {
+				m_accum /= wxFloat32(DCOFFSET_COUNT);
+
+				m_offset = m_offset * 0.9F + m_accum * 0.1F;
+
+				m_accum = 0.0F;
+				m_count = 0U;
+			}
+		}
+
+		m_buffer[i] = in[i] - m_offset;
+	}
+
+	m_filter.process(m_buffer, length);
+
+	unsigned int n = 0U;
+	for (unsigned int i = 0U; i < length; i++) {
+		bool bit = m_buffer[i] > 0.0F;
+
+		if (bit != m_prev) {
+			if (m_pll < (PLLMAX / 2U))
+				m_pll += m_inc;
+			else
+				m_pll -= m_inc;
+		}
+
+		m_prev = bit;
+
+		m_pll += PLLINC;
+
+		if (m_pll >= PLLMAX) {
+			if (m_invert == bit)
+				bits[n / 8U] |= (0x01U << (n % 8U));
+			else
+				bits[n / 8U] &= ~(0x01U << (n % 8U));
+
+			if (soft != NULL)
+				soft[n] = m_invert ? m_buffer[i] : -m_buffer[i];
+
+			n++;
+
+			m_pll -= PLLMAX;
+		}
+	}
+
+	return n;
+}
+
 void CDStarGMSKDemodulator::reset()
 {
 	m_pll    = 0U;
@@ -15,7 +15,7 @@
 #define	DStarGMSKDemodulator_H
 
 #include "DStarDefines.h"
-#include "FIRFilter.h"
+#include "DStarGMSKFilter.h"
 #include "Utils.h"
 
 class CDStarGMSKDemodulator {
@@ -25,6 +25,8 @@ public:
 
 	TRISTATE decode(wxFloat32 val);
 
+	unsigned int decode(const wxFloat32* in, unsigned int length, unsigned char* bits, wxFloat32* soft = NULL);
+
 	void setInvert(bool set);
 
 	void reset();
@@ -32,15 +34,16 @@ public:
 	void lock(bool on);
 
 private:
-	CFIRFilter     m_filter;
-	bool           m_invert;
-	unsigned int   m_pll;
-	bool           m_prev;
-	unsigned int   m_inc;
-	bool           m_locked;
-	wxFloat32      m_offset;
-	wxFloat32      m_accum;
-	unsigned int   m_count;
+	CDStarGMSKFilter       m_filter;
+	bool                   m_invert;
+	unsigned int           m_pll;
+	bool                   m_prev;
+	unsigned int           m_inc;
+	bool                   m_locked;
+	wxFloat32              m_offset;
+	wxFloat32              m_accum;
+	unsigned int           m_count;
+	wxFloat32*             m_buffer;
 };
 
 #endif
@@ -0,0 +1,220 @@
+/*
+ *  Copyright (C) 2001, 2002, 2003 by Tomi Manninen, OH2BNS
+ *	Copyright (C) 2009,2015 by Jonathan Naylor, G4KLX
+ *
+ *	This program is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; version 2 of the License.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ */
+
+#include "DStarGMSKFilter.h"
+#include "DStarDefines.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define	FIR_USE_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define	FIR_USE_NEON
+#endif
+
+// Generated by gaussfir(0.5, 4, 10), the filter is symmetrical so only the first half is stored,
+// and the five taps at each end that are below 1e-9 are left out
+const wxFloat32 COEFFS_TABLE[] = {
+	0.000000001829471F, 0.000000016627294F, 0.000000131062698F, 0.000000895979719F, 0.000005312253663F, 0.000027316243802F,
+	0.000121821714020F, 0.000471183399421F, 0.001580581180127F, 0.004598383433830F, 0.011602594308899F, 0.025390226926262F,
+	0.048188078330624F, 0.079318443411643F, 0.113232294527059F, 0.140193533802410F};
+
+const wxFloat32 COEFFS_CENTRE = 0.150538369557851F;
+
+const unsigned int COEFFS_HALF   = sizeof(COEFFS_TABLE) / sizeof(wxFloat32);	// 16
+const unsigned int COEFFS_OFFSET = 5U;						// Taps removed from each end
+const unsigned int COEFFS_LENGTH = 2U * (COEFFS_OFFSET + COEFFS_HALF) + 1U;	// 43, the original length
+
+const unsigned int BUFFER_LENGTH = COEFFS_LENGTH + DSTAR_RADIO_BLOCK_SIZE;
+
+const unsigned int SYMBOL_SPAN = GMSK_SYMBOL_SPAN;
+
+static wxFloat32 getTap(unsigned int n)
+{
+	if (n < COEFFS_OFFSET || n >= (COEFFS_LENGTH - COEFFS_OFFSET))
+		return 0.0F;
+
+	if (n < (COEFFS_OFFSET + COEFFS_HALF))
+		return COEFFS_TABLE[n - COEFFS_OFFSET];
+
+	if (n > (COEFFS_OFFSET + COEFFS_HALF))
+		return COEFFS_TABLE[COEFFS_LENGTH - COEFFS_OFFSET - 1U - n];
+
+	return COEFFS_CENTRE;
+}
+
+CDStarGMSKFilter::CDStarGMSKFilter() :
+m_buffer(NULL),
+m_phases(NULL),
+m_symbols(NULL),
+m_pointer(0U)
+{
+	m_buffer  = new wxFloat32[BUFFER_LENGTH];
+	m_phases  = new wxFloat32[DSTAR_RADIO_BIT_LENGTH * SYMBOL_SPAN];
+	m_symbols = new wxFloat32[SYMBOL_SPAN];
+
+	wxASSERT(SYMBOL_SPAN == (COEFFS_LENGTH + DSTAR_RADIO_BIT_LENGTH - 1U) / DSTAR_RADIO_BIT_LENGTH + 1U);
+
+	// Sum the taps that fall on each of the held symbols, for each output phase
+	::memset(m_phases, 0x00, DSTAR_RADIO_BIT_LENGTH * SYMBOL_SPAN * sizeof(wxFloat32));
+	for (unsigned int p = 0U; p < DSTAR_RADIO_BIT_LENGTH; p++) {
+		for (unsigned int n = 0U; n < COEFFS_LENGTH; n++) {
+			int pos = int(p) + int(n) - int(COEFFS_LENGTH);
+			unsigned int age = (pos >= 0) ? 0U : (unsigned int)(-pos + int(DSTAR_RADIO_BIT_LENGTH) - 1) / DSTAR_RADIO_BIT_LENGTH;
+
+			m_phases[p * SYMBOL_SPAN + age] += getTap(n);
+		}
+	}
+
+	reset();
+}
+
+CDStarGMSKFilter::~CDStarGMSKFilter()
+{
+	delete[] m_buffer;
+	delete[] m_phases;
+	delete[] m_symbols;
+}
+
+// Each sample is filtered where it lands in the history, which is only moved back once a block has
+// been filled, so filtering a sample at a time costs no more than in a block
+wxFloat32 CDStarGMSKFilter::process(wxFloat32 val)
+{
+	m_buffer[COEFFS_LENGTH + m_pointer] = val;
+
+	filter(m_buffer + m_pointer, &val, 1U);
+
+	if (++m_pointer == DSTAR_RADIO_BLOCK_SIZE) {
+		::memcpy(m_buffer, m_buffer + DSTAR_RADIO_BLOCK_SIZE, COEFFS_LENGTH * sizeof(wxFloat32));
+		m_pointer = 0U;
+	}
+
+	return val;
+}
+
+void CDStarGMSKFilter::process(wxFloat32* inOut, unsigned int length)
+{
+	wxASSERT(inOut != NULL);
+
+	while (length > 0U) {
+		unsigned int n = DSTAR_RADIO_BLOCK_SIZE - m_pointer;
+		if (n > length)
+			n = length;
+
+		::memcpy(m_buffer + COEFFS_LENGTH + m_pointer, inOut, n * sizeof(wxFloat32));
+
+		filter(m_buffer + m_pointer, inOut, n);
+
+		m_pointer += n;
+		if (m_pointer == DSTAR_RADIO_BLOCK_SIZE) {
+			::memcpy(m_buffer, m_buffer + DSTAR_RADIO_BLOCK_SIZE, COEFFS_LENGTH * sizeof(wxFloat32));
+			m_pointer = 0U;
+		}
+
+		inOut  += n;
+		length -= n;
+	}
+}
+
+// The output has the same one sample delay as the original direct form filter. Each vector lane
+// accumulates the taps in the same order as the scalar loop so that all paths give the same result.
+void CDStarGMSKFilter::filter(const wxFloat32* history, wxFloat32* out, unsigned int length) const
+{
+	const wxFloat32* in = history + COEFFS_OFFSET;
+
+	const unsigned int centre = COEFFS_HALF;
+	const unsigned int last   = COEFFS_LENGTH - 2U * COEFFS_OFFSET - 1U;
+
+	unsigned int i = 0U;
+
+#if defined(__AVX__)
+	for (; (i + 8U) <= length; i += 8U) {
+		__m256 acc = _mm256_mul_ps(_mm256_loadu_ps(in + i + centre), _mm256_set1_ps(COEFFS_CENTRE));
+
+		for (unsigned int j = 0U; j < COEFFS_HALF; j++) {
+			__m256 sum = _mm256_add_ps(_mm256_loadu_ps(in + i + j), _mm256_loadu_ps(in + i + last - j));
+			acc = _mm256_add_ps(acc, _mm256_mul_ps(sum, _mm256_set1_ps(COEFFS_TABLE[j])));
+		}
+
+		_mm256_storeu_ps(out + i, acc);
+	}
+#endif
+
+#if defined(FIR_USE_SSE)
+	for (; (i + 4U) <= length; i += 4U) {
+		__m128 acc = _mm_mul_ps(_mm_loadu_ps(in + i + centre), _mm_set1_ps(COEFFS_CENTRE));
+
+		for (unsigned int j = 0U; j < COEFFS_HALF; j++) {
+			__m128 sum = _mm_add_ps(_mm_loadu_ps(in + i + j), _mm_loadu_ps(in + i + last - j));
+			acc = _mm_add_ps(acc, _mm_mul_ps(sum, _mm_set1_ps(COEFFS_TABLE[j])));
+		}
+
+		_mm_storeu_ps(out + i, acc);
+	}
+#elif defined(FIR_USE_NEON)
+	for (; (i + 4U) <= length; i += 4U) {
+		float32x4_t acc = vmulq_f32(vld1q_f32(in + i + centre), vdupq_n_f32(COEFFS_CENTRE));
+
+		for (unsigned int j = 0U; j < COEFFS_HALF; j++) {
+			float32x4_t sum = vaddq_f32(vld1q_f32(in + i + j), vld1q_f32(in + i + last - j));
+			acc = vaddq_f32(acc, vmulq_f32(sum, vdupq_n_f32(COEFFS_TABLE[j])));
+		}
+
+		vst1q_f32(out + i, acc);
+	}
+#endif
+
+	for (; i < length; i++) {
+		const wxFloat32* a = in + i;
+
+		wxFloat32 val = a[centre] * COEFFS_CENTRE;
+		for (unsigned int j = 0U; j < COEFFS_HALF; j++)
+			val += (a[j] + a[last - j]) * COEFFS_TABLE[j];
+
+		out[i] = val;
+	}
+}
+
+unsigned int CDStarGMSKFilter::interpolate(wxFloat32 val, wxFloat32* out, unsigned int length)
+{
+	wxASSERT(out != NULL);
+	wxASSERT(length >= DSTAR_RADIO_BIT_LENGTH);
+
+	for (unsigned int i = SYMBOL_SPAN - 1U; i > 0U; i--)
+		m_symbols[i] = m_symbols[i - 1U];
+	m_symbols[0U] = val;
+
+	for (unsigned int p = 0U; p < DSTAR_RADIO_BIT_LENGTH; p++) {
+		const wxFloat32* phase = m_phases + p * SYMBOL_SPAN;
+
+		wxFloat32 sum = 0.0F;
+		for (unsigned int i = 0U; i < SYMBOL_SPAN; i++)
+			sum += m_symbols[i] * phase[i];
+
+		out[p] = sum;
+	}
+
+	return DSTAR_RADIO_BIT_LENGTH;
+}
+
+void CDStarGMSKFilter::reset()
+{
+	::memset(m_buffer,  0x00, BUFFER_LENGTH * sizeof(wxFloat32));
+	::memset(m_symbols, 0x00, SYMBOL_SPAN * sizeof(wxFloat32));
+
+	m_pointer = 0U;
+}
@@ -0,0 +1,44 @@
+/*
+ *	Copyright (C) 2009,2013 by Jonathan Naylor, G4KLX
+ *
+ *	This program is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; version 2 of the License.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ */
+
+#ifndef	DStarGMSKFilter_H
+#define	DStarGMSKFilter_H
+
+#include <wx/wx.h>
+
+const unsigned int GMSK_SYMBOL_SPAN = 6U;		// Symbols covered by the filter when interpolating
+
+class CDStarGMSKFilter {
+public:
+	CDStarGMSKFilter();
+	~CDStarGMSKFilter();
+
+	// Filter at the sample rate, in place
+	wxFloat32    process(wxFloat32 val);
+	void         process(wxFloat32* inOut, unsigned int length);
+
+	// Filter one symbol held for DSTAR_RADIO_BIT_LENGTH samples
+	unsigned int interpolate(wxFloat32 val, wxFloat32* out, unsigned int length);
+
+	void         reset();
+
+private:
+	wxFloat32*   m_buffer;
+	wxFloat32*   m_phases;
+	wxFloat32*   m_symbols;
+	unsigned int m_pointer;
+
+	void         filter(const wxFloat32* history, wxFloat32* out, unsigned int length) const;
+};
+
+#endif
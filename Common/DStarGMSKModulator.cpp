@@ -15,27 +15,23 @@
 
 #include "DStarDefines.h"
 
-// Generated by gaussfir(0.5, 4, 10)
-const wxFloat32 COEFFS_TABLE[] = {
-	0.000000000000003F, 0.000000000000065F, 0.000000000001037F, 0.000000000014448F, 0.000000000174579F,
-	0.000000001829471F, 0.000000016627294F, 0.000000131062698F, 0.000000895979719F, 0.000005312253663F, 0.000027316243802F,
-	0.000121821714020F, 0.000471183399421F, 0.001580581180127F, 0.004598383433830F, 0.011602594308899F, 0.025390226926262F,
-	0.048188078330624F, 0.079318443411643F, 0.113232294527059F, 0.140193533802410F, 0.150538369557851F, 0.140193533802410F,
-	0.113232294527059F, 0.079318443411643F, 0.048188078330623F, 0.025390226926262F, 0.011602594308899F, 0.004598383433830F,
-	0.001580581180127F, 0.000471183399421F, 0.000121821714020F, 0.000027316243802F, 0.000005312253663F, 0.000000895979719F,
-	0.000000131062698F, 0.000000016627294F, 0.000000001829471F, 0.000000000174579F, 0.000000000014448F, 0.000000000001037F,
-	0.000000000000065F, 0.000000000000003F};
-
-const unsigned int COEFFS_LENGTH = 43U;
+const unsigned int HISTORY_LENGTH = 1U << GMSK_SYMBOL_SPAN;
+const unsigned int HISTORY_MASK   = HISTORY_LENGTH - 1U;
 
 CDStarGMSKModulator::CDStarGMSKModulator() :
-m_filter(COEFFS_TABLE, COEFFS_LENGTH),
-m_invert(false)
+m_table(NULL),
+m_history(0U),
+m_invert(false),
+m_level(1.0F)
 {
+	m_table = new wxFloat32[HISTORY_LENGTH * DSTAR_RADIO_BIT_LENGTH];
+
+	createTable();
 }
 
 CDStarGMSKModulator::~CDStarGMSKModulator()
 {
+	delete[] m_table;
 }
 
 unsigned int CDStarGMSKModulator::code(bool bit, wxFloat32* buffer, unsigned int length)
@@ -43,20 +39,72 @@ unsigned int CDStarGMSKModulator::code(bool bit, wxFloat32* buffer, unsigned int
 	wxASSERT(buffer != NULL);
 	wxASSERT(length == DSTAR_RADIO_BIT_LENGTH);
 
-	if (m_invert)
-		bit = !bit;
+	m_history = ((m_history << 1) | (bit ? 0x01U : 0x00U)) & HISTORY_MASK;
 
-	for (unsigned int i = 0U; i < DSTAR_RADIO_BIT_LENGTH; i++) {
-		if (bit)
-			buffer[i] = m_filter.process(-0.5F);
-		else
-			buffer[i] = m_filter.process(0.5F);
-	}
+	::memcpy(buffer, m_table + m_history * DSTAR_RADIO_BIT_LENGTH, DSTAR_RADIO_BIT_LENGTH * sizeof(wxFloat32));
 
 	return DSTAR_RADIO_BIT_LENGTH;
 }
 
+// The bits of each byte are sent least significant first
+unsigned int CDStarGMSKModulator::code(const unsigned char* data, unsigned int length, wxFloat32* buffer, unsigned int size)
+{
+	wxASSERT(data != NULL);
+	wxASSERT(buffer != NULL);
+	wxASSERT(size >= length * 8U * DSTAR_RADIO_BIT_LENGTH);
+
+	wxFloat32* out = buffer;
+
+	for (unsigned int i = 0U; i < length; i++) {
+		unsigned char c = data[i];
+
+		for (unsigned int j = 0U; j < 8U; j++) {
+			m_history = ((m_history << 1) | (c & 0x01U)) & HISTORY_MASK;
+
+			::memcpy(out, m_table + m_history * DSTAR_RADIO_BIT_LENGTH, DSTAR_RADIO_BIT_LENGTH * sizeof(wxFloat32));
+
+			out += DSTAR_RADIO_BIT_LENGTH;
+			c  >>= 1;
+		}
+	}
+
+	return length * 8U * DSTAR_RADIO_BIT_LENGTH;
+}
+
 void CDStarGMSKModulator::setInvert(bool set)
 {
 	m_invert = set;
+
+	createTable();
+}
+
+void CDStarGMSKModulator::setLevel(wxFloat32 level)
+{
+	m_level = level;
+
+	createTable();
+}
+
+// The filter output for a bit depends only on that bit and the ones just before it, so the waveform
+// for every possible bit history is generated once with the inversion and TX level already applied
+void CDStarGMSKModulator::createTable()
+{
+	CDStarGMSKFilter filter;
+
+	for (unsigned int history = 0U; history < HISTORY_LENGTH; history++) {
+		wxFloat32* out = m_table + history * DSTAR_RADIO_BIT_LENGTH;
+
+		filter.reset();
+
+		for (unsigned int i = GMSK_SYMBOL_SPAN; i > 0U; i--) {
+			bool bit = (history & (0x01U << (i - 1U))) != 0x00U;
+			if (m_invert)
+				bit = !bit;
+
+			filter.interpolate(bit ? -0.5F : 0.5F, out, DSTAR_RADIO_BIT_LENGTH);
+		}
+
+		for (unsigned int i = 0U; i < DSTAR_RADIO_BIT_LENGTH; i++)
+			out[i] *= m_level;
+	}
 }
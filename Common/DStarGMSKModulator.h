@@ -14,7 +14,7 @@
 #ifndef	DStarGMSKModulator_H
 #define	DStarGMSKModulator_H
 
-#include "FIRFilter.h"
+#include "DStarGMSKFilter.h"
 
 class CDStarGMSKModulator {
 public:
@@ -22,12 +22,18 @@ public:
 	~CDStarGMSKModulator();
 
 	unsigned int code(bool bit, wxFloat32* buffer, unsigned int length);
+	unsigned int code(const unsigned char* data, unsigned int length, wxFloat32* buffer, unsigned int size);
 
 	void setInvert(bool set);
+	void setLevel(wxFloat32 level);
 
 private:
-	CFIRFilter m_filter;
-	bool       m_invert;
+	wxFloat32*   m_table;
+	unsigned int m_history;
+	bool         m_invert;
+	wxFloat32    m_level;
+
+	void createTable();
 };
 
 #endif
@@ -38,6 +38,7 @@ const wxString  KEY_NETWORK_NAME       = wxT("networkName");
 const wxString  KEY_MODEM_TYPE         = wxT("modemType");
 const wxString  KEY_TIMEOUT            = wxT("timeout");
 const wxString  KEY_ACK_TIME           = wxT("ackTime");
+const wxString  KEY_CONCEAL_FRAMES     = wxT("concealFrames");
 const wxString  KEY_BEACON_TIME        = wxT("beaconTime");
 const wxString  KEY_BEACON_TEXT        = wxT("beaconText");
 const wxString  KEY_BEACON_VOICE       = wxT("beaconVoice");
@@ -168,6 +169,7 @@ const wxString        DEFAULT_NETWORK_NAME       = wxEmptyString;
 const wxString        DEFAULT_MODEM_TYPE         = wxT("DVAP");
 const unsigned int    DEFAULT_TIMEOUT            = 180U;
 const unsigned int    DEFAULT_ACK_TIME           = 500U;
+const unsigned int    DEFAULT_CONCEAL_FRAMES     = 5U;
 const unsigned int    DEFAULT_BEACON_TIME        = 600U;
 const wxString        DEFAULT_BEACON_TEXT        = wxT("D-Star Repeater");
 const bool            DEFAULT_BEACON_VOICE       = false;
@@ -287,6 +289,7 @@ m_networkName(DEFAULT_NETWORK_NAME),
 m_modemType(DEFAULT_MODEM_TYPE),
 m_timeout(DEFAULT_TIMEOUT),
 m_ackTime(DEFAULT_ACK_TIME),
+m_concealFrames(DEFAULT_CONCEAL_FRAMES),
 m_beaconTime(DEFAULT_BEACON_TIME),
 m_beaconText(DEFAULT_BEACON_TEXT),
 m_beaconVoice(DEFAULT_BEACON_VOICE),
@@ -443,6 +446,9 @@ m_icomPort(DEFAULT_ICOM_PORT)
 	m_config->Read(m_name + KEY_ACK_TIME, &temp, long(DEFAULT_ACK_TIME));
 	m_ackTime = (unsigned int)temp;
 
+	m_config->Read(m_name + KEY_CONCEAL_FRAMES, &temp, long(DEFAULT_CONCEAL_FRAMES));
+	m_concealFrames = (unsigned int)temp;
+
 	m_config->Read(m_name + KEY_BEACON_TIME, &temp, long(DEFAULT_BEACON_TIME));
 	m_beaconTime = (unsigned int)temp;
 
@@ -723,6 +729,7 @@ m_networkName(DEFAULT_NETWORK_NAME),
 m_modemType(DEFAULT_MODEM_TYPE),
 m_timeout(DEFAULT_TIMEOUT),
 m_ackTime(DEFAULT_ACK_TIME),
+m_concealFrames(DEFAULT_CONCEAL_FRAMES),
 m_beaconTime(DEFAULT_BEACON_TIME),
 m_beaconText(DEFAULT_BEACON_TEXT),
 m_beaconVoice(DEFAULT_BEACON_VOICE),
@@ -912,6 +919,9 @@ m_icomPort(DEFAULT_ICOM_PORT)
 		} else if (key.IsSameAs(KEY_ACK_TIME)) {
 			val.ToULong(&temp2);
 			m_ackTime = (unsigned int)temp2;
+		} else if (key.IsSameAs(KEY_CONCEAL_FRAMES)) {
+			val.ToULong(&temp2);
+			m_concealFrames = (unsigned int)temp2;
 		} else if (key.IsSameAs(KEY_BEACON_TIME)) {
 			val.ToULong(&temp2);
 			m_beaconTime = (unsigned int)temp2;
@@ -1265,6 +1275,16 @@ void CDStarRepeaterConfig::setTimes(unsigned int timeout, unsigned int ackTime)
 	m_ackTime = ackTime;
 }
 
+void CDStarRepeaterConfig::getConcealment(unsigned int& frames) const
+{
+	frames = m_concealFrames;
+}
+
+void CDStarRepeaterConfig::setConcealment(unsigned int frames)
+{
+	m_concealFrames = frames;
+}
+
 void CDStarRepeaterConfig::getBeacon(unsigned int& time, wxString& text, bool& voice, TEXT_LANG& language) const
 {
 	time     = m_beaconTime;
@@ -1627,6 +1647,7 @@ bool CDStarRepeaterConfig::write()
 	m_config->Write(m_name + KEY_MODEM_TYPE, m_modemType);
 	m_config->Write(m_name + KEY_TIMEOUT, long(m_timeout));
 	m_config->Write(m_name + KEY_ACK_TIME, long(m_ackTime));
+	m_config->Write(m_name + KEY_CONCEAL_FRAMES, long(m_concealFrames));
 	m_config->Write(m_name + KEY_BEACON_TIME, long(m_beaconTime));
 	m_config->Write(m_name + KEY_BEACON_TEXT, m_beaconText);
 	m_config->Write(m_name + KEY_BEACON_VOICE, m_beaconVoice);
@@ -1793,6 +1814,7 @@ bool CDStarRepeaterConfig::write()
 	buffer.Printf(wxT("%s=%s"), KEY_MODEM_TYPE.c_str(), m_modemType.c_str()); file.AddLine(buffer);
 	buffer.Printf(wxT("%s=%u"), KEY_TIMEOUT.c_str(), m_timeout); file.AddLine(buffer);
 	buffer.Printf(wxT("%s=%u"), KEY_ACK_TIME.c_str(), m_ackTime); file.AddLine(buffer);
+	buffer.Printf(wxT("%s=%u"), KEY_CONCEAL_FRAMES.c_str(), m_concealFrames); file.AddLine(buffer);
 	buffer.Printf(wxT("%s=%u"), KEY_BEACON_TIME.c_str(), m_beaconTime); file.AddLine(buffer);
 	buffer.Printf(wxT("%s=%s"), KEY_BEACON_TEXT.c_str(), m_beaconText.c_str()); file.AddLine(buffer);
 	buffer.Printf(wxT("%s=%d"), KEY_BEACON_VOICE.c_str(), m_beaconVoice ? 1 : 0); file.AddLine(buffer);
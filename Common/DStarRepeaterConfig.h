@@ -46,6 +46,9 @@ public:
 	void getTimes(unsigned int& timeout, unsigned int& ackTime) const;
 	void setTimes(unsigned int timeout, unsigned int ackTime);
 
+	void getConcealment(unsigned int& frames) const;
+	void setConcealment(unsigned int frames);
+
 	void getBeacon(unsigned int& time, wxString& text, bool& voice, TEXT_LANG& language) const;
 	void setBeacon(unsigned int time, const wxString& text, bool voice, TEXT_LANG language);
 
@@ -122,6 +125,7 @@ private:
 	wxString      m_modemType;
 	unsigned int  m_timeout;
 	unsigned int  m_ackTime;
+	unsigned int  m_concealFrames;
 	unsigned int  m_beaconTime;
 	wxString      m_beaconText;
 	bool          m_beaconVoice;
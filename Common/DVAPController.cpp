@@ -19,6 +19,7 @@
 #include "CCITTChecksumReverse.h"
 #include "DVAPController.h"
 #include "DStarDefines.h"
+#include "Logger.h"
 #include "Timer.h"
 
 const unsigned char DVAP_REQ_NAME[] = {0x04, 0x20, 0x01, 0x00};
@@ -134,6 +135,8 @@ m_squelch(squelch),
 m_squelchOpen(false),
 m_signal(0),
 m_buffer(NULL),
+m_framer(this, BUFFER_LENGTH),
+m_resync(false),
 m_streamId(0U),
 m_framePos(0U),
 m_seq(0U),
@@ -152,8 +155,6 @@ m_dvapIndex(0U)
 	wxASSERT(power >= -12 && power <= 10);
 	wxASSERT(squelch >= -128 && squelch <= -45);
 
-	m_buffer = new unsigned char[BUFFER_LENGTH];
-
 #if defined(DVAP_DUMP)
 	m_dvapData = new unsigned char*[DVAP_DUMP_LENGTH];
 	for (unsigned int i = 0U; i < DVAP_DUMP_LENGTH; i++)
@@ -167,8 +168,6 @@ m_dvapIndex(0U)
 
 CDVAPController::~CDVAPController()
 {
-	delete[] m_buffer;
-
 #if defined(DVAP_DUMP)
 	for (unsigned int i = 0U; i < DVAP_DUMP_LENGTH; i++)
 		delete[] m_dvapData[i];
@@ -184,6 +183,10 @@ bool CDVAPController::start()
 	if (!res)
 		return false;
 
+	m_framer.reset();
+
+	addPort(m_serial.getFD());
+
 	res = getName();
 	if (!res) {
 		m_serial.close();
@@ -247,10 +250,11 @@ bool CDVAPController::start()
 
 void* CDVAPController::Entry()
 {
+	CLogger::startThread();
+
 	wxLogMessage(wxT("Starting DVAP Controller thread"));
 
-	// Clock every 5ms-ish
-	CTimer pollTimer(200U, 2U);
+	CTimer pollTimer(1000U, 2U);
 	pollTimer.start();
 
 	unsigned char  writeLength = 0U;
@@ -296,34 +300,17 @@ void* CDVAPController::Entry()
 				startDVAP();
 				break;
 			case RT_HEADER: {
-					wxMutexLocker locker(m_mutex);
-
-					unsigned char hdr[2U];
-					hdr[0U] = DSMTT_HEADER;
-					hdr[1U] = RADIO_HEADER_LENGTH_BYTES;
-					m_rxData.addData(hdr, 2U);
-
-					m_rxData.addData(m_buffer + 6U, RADIO_HEADER_LENGTH_BYTES);
+					writeRX(DSMTT_HEADER, m_buffer + 6U, RADIO_HEADER_LENGTH_BYTES);
 				}
 				break;
 			case RT_HEADER_ACK:
 				break;
 			case RT_GMSK_DATA: {
-					wxMutexLocker locker(m_mutex);
-
 					bool end = (m_buffer[4U] & 0x40U) == 0x40U;
 					if (end) {
-						unsigned char hdr[2U];
-						hdr[0U] = DSMTT_EOT;
-						hdr[1U] = 0U;
-						m_rxData.addData(hdr, 2U);
+						writeRX(DSMTT_EOT);
 					} else {
-						unsigned char hdr[2U];
-						hdr[0U] = DSMTT_DATA;
-						hdr[1U] = length - 6U;
-						m_rxData.addData(hdr, 2U);
-
-						m_rxData.addData(m_buffer + 6U, length - 6U);
+						writeRX(DSMTT_DATA, m_buffer + 6U, length - 6U);
 					}
 				}
 				break;
@@ -345,11 +332,12 @@ void* CDVAPController::Entry()
 				break;
 		}
 
+		// Keep going while there is more to read or write, otherwise sleep until there is
+		bool idle = type == RT_TIMEOUT;
+
 		// Use the status packet every 20ms to trigger the sending of data to the DVAP
 		if (space > 0U && type == RT_STATE) {
 			if (writeLength == 0U && m_txData.hasData()) {
-				wxMutexLocker locker(m_mutex);
-
 				m_txData.getData(&writeLength, 1U);
 				m_txData.getData(writeBuffer, writeLength);
 			}
@@ -384,9 +372,11 @@ void* CDVAPController::Entry()
 			}
 		}
 
-		Sleep(5UL);
+		// The DVAP sends its state every 20ms, which wakes the thread for anything waiting to be sent
+		if (idle)
+			waitForEvent(pollTimer.getRemainingTicks());
 
-		pollTimer.clock();
+		pollTimer.clock(getElapsed());
 	}
 
 	wxLogMessage(wxT("Stopping DVAP Controller thread"));
@@ -422,43 +412,13 @@ bool CDVAPController::writeHeader(const CHeaderData& header)
 
 	::memset(buffer + 6U, ' ', RADIO_HEADER_LENGTH_BYTES);
 
-	buffer[6U] = header.getFlag1();
-	buffer[7U] = header.getFlag2();
-	buffer[8U] = header.getFlag3();
-
-	wxString rpt2 = header.getRptCall2();
-	for (unsigned int i = 0U; i < rpt2.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 9U]  = rpt2.GetChar(i);
-
-	wxString rpt1 = header.getRptCall1();
-	for (unsigned int i = 0U; i < rpt1.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 17U] = rpt1.GetChar(i);
-
-	wxString your = header.getYourCall();
-	for (unsigned int i = 0U; i < your.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 25U] = your.GetChar(i);
-
-	wxString my1 = header.getMyCall1();
-	for (unsigned int i = 0U; i < my1.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 33U] = my1.GetChar(i);
-
-	wxString my2 = header.getMyCall2();
-	for (unsigned int i = 0U; i < my2.Len() && i < SHORT_CALLSIGN_LENGTH; i++)
-		buffer[i + 41U] = my2.GetChar(i);
-
-	CCCITTChecksumReverse cksum;
-	cksum.update(buffer + 6U, RADIO_HEADER_LENGTH_BYTES - 2U);
-	cksum.result(buffer + 45U);
+	header.getData(buffer + 6U, RADIO_HEADER_LENGTH_BYTES, true);
 
 	m_framePos = 0U;
 	m_seq = 0U;
 
-	wxMutexLocker locker(m_mutex);
-
 	unsigned char len = DVAP_HEADER_LEN;
-	m_txData.addData(&len, 1U);
-
-	m_txData.addData(buffer, DVAP_HEADER_LEN);
+	m_txData.addData(&len, 1U, buffer, DVAP_HEADER_LEN);
 
 	return true;
 }
@@ -489,12 +449,8 @@ bool CDVAPController::writeData(const unsigned char* data, unsigned int, bool en
 
 	::memcpy(buffer + 6U, data, DV_FRAME_LENGTH_BYTES);
 
-	wxMutexLocker locker(m_mutex);
-
 	unsigned char len = DVAP_GMSK_DATA_LEN;
-	m_txData.addData(&len, 1U);
-
-	m_txData.addData(buffer, DVAP_GMSK_DATA_LEN);
+	m_txData.addData(&len, 1U, buffer, DVAP_GMSK_DATA_LEN);
 
 	m_framePos++;
 	m_seq++;
@@ -876,44 +832,32 @@ bool CDVAPController::setFrequency()
 	return true;
 }
 
-RESP_TYPE CDVAPController::getResponse(unsigned char *buffer, unsigned int& length)
+RESP_TYPE CDVAPController::getResponse(unsigned char*& buffer, unsigned int& length)
 {
-	int ret = m_serial.read(buffer, DVAP_HEADER_LENGTH);
-	if (ret == 0)
-		return RT_TIMEOUT;
-	if (ret != int(DVAP_HEADER_LENGTH))
-		return RT_ERROR;
-
-	unsigned int offset = DVAP_HEADER_LENGTH;
+	// Only go to the port when there is no whole frame left from the last read
+	buffer = m_framer.getFrame(length);
+	if (buffer == NULL) {
+		unsigned int space;
+		unsigned char* data = m_framer.getSpace(space);
 
-	// First byte has gone missing from the operation status message, fix it
-	if (buffer[0U] == 0x20U && buffer[1U] == 0x90U) {
-		buffer[0U] = 0x07U;
-		buffer[1U] = 0x20U;
-		buffer[2U] = 0x90U;
-		offset = DVAP_HEADER_LENGTH + 1U;
-	}
+		int ret = m_serial.readNonblock(data, space);
+		if (ret < 0)
+			return RT_ERROR;
 
-	length = buffer[0U] + (buffer[1U] & 0x1FU) * 256U;
+		m_framer.addData(ret);
 
-	// Check for silliness
-	if (length > 50U) {
-		CUtils::dump(wxT("Bad DVAP header"), buffer, DVAP_HEADER_LENGTH);
-#if defined(DVAP_DUMP)
-		dumpPackets();
-#endif
-		resync();
-		return RT_TIMEOUT;
+		buffer = m_framer.getFrame(length);
+		if (buffer == NULL)
+			return RT_TIMEOUT;
 	}
 
-	while (offset < length) {
-		ret = m_serial.read(buffer + offset, length - offset);
-		if (ret < 0)
-			return RT_ERROR;
-		if (ret > 0)
-			offset += ret;
-		if (ret == 0)
-			Sleep(5UL);
+	// First byte has gone missing from the operation status message, fix it
+	if (buffer[0U] == 0x20U && buffer[1U] == 0x90U) {
+		m_status[0U] = 0x07U;
+		::memcpy(m_status + 1U, buffer, DVAP_STATUS_LEN - 1U);
+
+		buffer = m_status;
+		length = DVAP_STATUS_LEN;
 	}
 
 	// CUtils::dump(wxT("Received"), buffer, length);
@@ -968,26 +912,42 @@ void CDVAPController::resync()
 {
 	wxLogWarning(wxT("Resynchronising the DVAP data stream"));
 
-	unsigned char data[DVAP_STATUS_LEN];
-	::memset(data, 0x00U, DVAP_STATUS_LEN);
-
-	while (::memcmp(data, DVAP_STATUS, 4U) != 0) {
-		unsigned char c;
-		int n = m_serial.read(&c, 1U);
-		if (n > 0) {
-			data[0U] = data[1U];
-			data[1U] = data[2U];
-			data[2U] = data[3U];
-			data[3U] = data[4U];
-			data[4U] = data[5U];
-			data[5U] = data[6U];
-			data[6U] = c;
-
-			// CUtils::dump(wxT("Resync buffer"), data, DVAP_STATUS_LEN);
-		}
+	// The framer throws the data away until the next status message
+	m_resync = true;
+}
+
+int CDVAPController::getFrameLength(const unsigned char* data, unsigned int length)
+{
+	if (m_resync) {
+		if (length < 4U)
+			return 0;
+
+		if (::memcmp(data, DVAP_STATUS, 4U) != 0)
+			return -1;
+
+		wxLogMessage(wxT("End resynchronising"));
+		m_resync = false;
+	}
+
+	if (length < DVAP_HEADER_LENGTH)
+		return 0;
+
+	if (data[0U] == 0x20U && data[1U] == 0x90U)
+		return int(DVAP_STATUS_LEN - 1U);
+
+	unsigned int frameLength = data[0U] + (data[1U] & 0x1FU) * 256U;
+
+	// Check for silliness
+	if (frameLength > 50U || frameLength < DVAP_HEADER_LENGTH) {
+		CUtils::dump(wxT("Bad DVAP header"), data, DVAP_HEADER_LENGTH);
+#if defined(DVAP_DUMP)
+		dumpPackets();
+#endif
+		resync();
+		return -int(DVAP_HEADER_LENGTH);
 	}
 
-	wxLogMessage(wxT("End resynchronising"));
+	return int(frameLength);
 }
 
 #if defined(DVAP_DUMP)
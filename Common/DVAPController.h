@@ -22,6 +22,7 @@
 #define	DVAP_DUMP
 
 #include "SerialDataController.h"
+#include "SerialFramer.h"
 #include "RingBuffer.h"
 #include "HeaderData.h"
 #include "Modem.h"
@@ -53,7 +54,7 @@ enum RESP_TYPE {
 	RT_FM_DATA
 };
 
-class CDVAPController : public CModem {
+class CDVAPController : public CModem, public ISerialProtocol {
 public:
 	CDVAPController(const wxString& port, unsigned int frequency, int power, int squelch);
 	virtual ~CDVAPController();
@@ -71,6 +72,8 @@ public:
 	virtual bool writeHeader(const CHeaderData& header);
 	virtual bool writeData(const unsigned char* data, unsigned int length, bool end);
 
+	virtual int getFrameLength(const unsigned char* data, unsigned int length);
+
 private:
 	CSerialDataController      m_serial;
 	wxUint32                   m_frequency;
@@ -79,6 +82,9 @@ private:
 	bool                       m_squelchOpen;
 	int                        m_signal;
 	unsigned char*             m_buffer;
+	CSerialFramer              m_framer;
+	bool                       m_resync;
+	unsigned char              m_status[7U];
 	wxUint16                   m_streamId;
 	wxUint8                    m_framePos;
 	wxUint8                    m_seq;
@@ -107,7 +113,7 @@ private:
 
 	void resync();
 
-	RESP_TYPE getResponse(unsigned char* buffer, unsigned int& length);
+	RESP_TYPE getResponse(unsigned char*& buffer, unsigned int& length);
 
 #if defined(DVAP_DUMP)
 	void storePacket(const unsigned char* data, unsigned int length);
@@ -20,6 +20,7 @@
 #include "DVMegaController.h"
 #include "CCITTChecksum.h"
 #include "DStarDefines.h"
+#include "Logger.h"
 #include "Timer.h"
 #include "Utils.h"
 
@@ -57,6 +58,9 @@ const unsigned int MAX_RESPONSES = 30U;
 
 const unsigned int BUFFER_LENGTH = 200U;
 
+// Slots kept in the modem, enough to cover a status poll arriving late
+const unsigned int TX_FILL = 8U;
+
 CDVMegaController::CDVMegaController(const wxString& port, const wxString& path, bool rxInvert, bool txInvert, unsigned int txDelay) :
 CModem(),
 m_port(port),
@@ -69,7 +73,9 @@ m_txFrequency(0U),
 m_power(0U),
 m_serial(port, SERIAL_115200, true),
 m_buffer(NULL),
+m_framer(this, BUFFER_LENGTH),
 m_txData(1000U),
+m_credit(TX_FILL),
 m_txCounter(0U),
 m_pktCounter(0U),
 m_rx(false),
@@ -78,8 +84,6 @@ m_txEnabled(false),
 m_checksum(false)
 {
 	wxASSERT(!port.IsEmpty());
-
-	m_buffer = new unsigned char[BUFFER_LENGTH];
 }
 
 CDVMegaController::CDVMegaController(const wxString& port, const wxString& path, unsigned int txDelay, unsigned int rxFrequency, unsigned int txFrequency, unsigned int power) :
@@ -94,7 +98,9 @@ m_txFrequency(txFrequency),
 m_power(power),
 m_serial(port, SERIAL_115200, true),
 m_buffer(NULL),
+m_framer(this, BUFFER_LENGTH),
 m_txData(1000U),
+m_credit(TX_FILL),
 m_txCounter(0U),
 m_pktCounter(0U),
 m_rx(false),
@@ -107,13 +113,10 @@ m_checksum(false)
 			 (rxFrequency >= 420000000U && rxFrequency <= 450000000U));
 	wxASSERT((txFrequency >= 144000000U && txFrequency <= 148000000U) ||
 			 (txFrequency >= 420000000U && txFrequency <= 450000000U));
-
-	m_buffer = new unsigned char[BUFFER_LENGTH];
 }
 
 CDVMegaController::~CDVMegaController()
 {
-	delete[] m_buffer;
 }
 
 bool CDVMegaController::start()
@@ -135,18 +138,17 @@ bool CDVMegaController::start()
 
 void* CDVMegaController::Entry()
 {
+	CLogger::startThread();
+
 	wxLogMessage(wxT("Starting DVMEGA Controller thread"));
 
-	// Clock every 5ms-ish
-	CTimer pollTimer(200U, 0U, 100U);
+	CTimer pollTimer(1000U, 0U, 100U);
 	pollTimer.start();
 
 	unsigned char  writeType   = DSMTT_NONE;
 	unsigned char  writeLength = 0U;
 	unsigned char* writeBuffer = new unsigned char[BUFFER_LENGTH];
 
-	unsigned int space = 0U;
-
 	while (!m_stopped) {
 		// Poll the modem status every 100ms
 		if (pollTimer.hasExpired()) {
@@ -194,14 +196,7 @@ void* CDVMegaController::Entry()
 				} else {
 					bool correct = (m_buffer[5U] & 0x80U) == 0x00U;
 					if (correct) {
-						wxMutexLocker locker(m_mutex);
-
-						unsigned char data[2U];
-						data[0U] = DSMTT_HEADER;
-						data[1U] = RADIO_HEADER_LENGTH_BYTES;
-						m_rxData.addData(data, 2U);
-
-						m_rxData.addData(m_buffer + 8U, RADIO_HEADER_LENGTH_BYTES);
+						writeRX(DSMTT_HEADER, m_buffer + 8U, RADIO_HEADER_LENGTH_BYTES);
 
 						m_rx = true;
 					}
@@ -218,14 +213,7 @@ void* CDVMegaController::Entry()
 					if (m_buffer[4U] == DVRPTR_NAK)
 						wxLogWarning(wxT("Received a data NAK from the DVMEGA"));
 				} else {
-					wxMutexLocker locker(m_mutex);
-
-					unsigned char data[2U];
-					data[0U] = DSMTT_DATA;
-					data[1U] = DV_FRAME_LENGTH_BYTES;
-					m_rxData.addData(data, 2U);
-
-					m_rxData.addData(m_buffer + 8U, DV_FRAME_LENGTH_BYTES);
+					writeRX(DSMTT_DATA, m_buffer + 8U, DV_FRAME_LENGTH_BYTES);
 
 					m_rx = true;
 				}
@@ -233,12 +221,7 @@ void* CDVMegaController::Entry()
 
 			case RTM_EOT: {
 					// wxLogMessage(wxT("RT_EOT"));
-					wxMutexLocker locker(m_mutex);
-
-					unsigned char data[2U];
-					data[0U] = DSMTT_EOT;
-					data[1U] = 0U;
-					m_rxData.addData(data, 2U);
+					writeRX(DSMTT_EOT);
 
 					m_rx = false;
 				}
@@ -246,12 +229,7 @@ void* CDVMegaController::Entry()
 
 			case RTM_RXLOST: {
 					// wxLogMessage(wxT("RT_LOST"));
-					wxMutexLocker locker(m_mutex);
-
-					unsigned char data[2U];
-					data[0U] = DSMTT_LOST;
-					data[1U] = 0U;
-					m_rxData.addData(data, 2U);
+					writeRX(DSMTT_LOST);
 
 					m_rx = false;
 				}
@@ -262,9 +240,9 @@ void* CDVMegaController::Entry()
 					m_checksum  = (m_buffer[4U] & 0x08U) == 0x08U;
 					m_tx        = (m_buffer[5U] & 0x02U) == 0x02U;
 					m_txSpace   = m_buffer[8U];
-					space       = m_txSpace - m_buffer[9U];
+					m_credit.setSpace(m_txSpace - m_buffer[9U]);
 					// CUtils::dump(wxT("GET_STATUS"), m_buffer, length);
-					// wxLogMessage(wxT("PTT=%d tx=%u space=%u cksum=%d, tx enabled=%d"), int(m_tx), m_txSpace, space, int(m_checksum), int(m_txEnabled));
+					// wxLogMessage(wxT("PTT=%d tx=%u space=%u cksum=%d, tx enabled=%d"), int(m_tx), m_txSpace, m_txSpace - m_buffer[9U], int(m_checksum), int(m_txEnabled));
 				}
 				break;
 
@@ -280,10 +258,11 @@ void* CDVMegaController::Entry()
 				break;
 		}
 
-		if (space > 0U) {
-			if (writeType == DSMTT_NONE && m_txData.hasData()) {
-				wxMutexLocker locker(m_mutex);
+		// Keep going while there is more to read or write, otherwise sleep until there is
+		bool idle = type == RTM_TIMEOUT;
 
+		if (m_credit.getSpace() > 0U) {
+			if (writeType == DSMTT_NONE && m_txData.hasData()) {
 				m_txData.getData(&writeType, 1U);
 				m_txData.getData(&writeLength, 1U);
 				m_txData.getData(writeBuffer, writeLength);
@@ -297,19 +276,21 @@ void* CDVMegaController::Entry()
 				if (ret != int(writeLength))
 					wxLogWarning(wxT("Error when writing the header to the DVMEGA"));
 
+				m_credit.write(1U);
 				writeType = DSMTT_NONE;
-				space--;
+				idle = false;
 			}
 
-			if (space > 4U && writeType == DSMTT_HEADER) {
+			if (m_credit.getSpace() > 4U && writeType == DSMTT_HEADER) {
 				// CUtils::dump(wxT("Write Header"), writeBuffer, writeLength);
 
 				int ret = m_serial.write(writeBuffer, writeLength);
 				if (ret != int(writeLength))
 					wxLogWarning(wxT("Error when writing the header to the DVMEGA"));
 
+				m_credit.write(4U);
 				writeType = DSMTT_NONE;
-				space -= 4U;
+				idle = false;
 			}
 
 			if (writeType == DSMTT_DATA || writeType == DSMTT_EOT) {
@@ -319,14 +300,28 @@ void* CDVMegaController::Entry()
 				if (ret != int(writeLength))
 					wxLogWarning(wxT("Error when writing data to the DVMEGA"));
 
+				m_credit.write(1U, writeType == DSMTT_EOT);
+				if (writeType == DSMTT_EOT)
+					m_credit.log(wxT("DVMEGA TX buffer"));
+
 				writeType = DSMTT_NONE;
-				space--;
+				idle = false;
 			}
 		}
 
-		Sleep(5UL);
+		if (idle) {
+			unsigned int timeout = pollTimer.getRemainingTicks();
+
+			// A write held back for want of space can go once the modem has sent the next slot
+			if (writeType != DSMTT_NONE || m_txData.hasData())
+				timeout = m_credit.getNext(timeout);
+
+			waitForEvent(timeout);
+		}
 
-		pollTimer.clock();
+		unsigned int ms = getElapsed();
+		pollTimer.clock(ms);
+		m_credit.clock(ms);
 	}
 
 	wxLogMessage(wxT("Stopping DVMEGA Controller thread"));
@@ -393,33 +388,7 @@ bool CDVMegaController::writeHeader(const CHeaderData& header)
 
 	::memset(buffer2 + 8U, ' ', RADIO_HEADER_LENGTH_BYTES);
 
-	buffer2[8U]  = header.getFlag1();
-	buffer2[9U]  = header.getFlag2();
-	buffer2[10U] = header.getFlag3();
-
-	wxString rpt2 = header.getRptCall2();
-	for (unsigned int i = 0U; i < rpt2.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer2[i + 11U]  = rpt2.GetChar(i);
-
-	wxString rpt1 = header.getRptCall1();
-	for (unsigned int i = 0U; i < rpt1.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer2[i + 19U] = rpt1.GetChar(i);
-
-	wxString your = header.getYourCall();
-	for (unsigned int i = 0U; i < your.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer2[i + 27U] = your.GetChar(i);
-
-	wxString my1 = header.getMyCall1();
-	for (unsigned int i = 0U; i < my1.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer2[i + 35U] = my1.GetChar(i);
-
-	wxString my2 = header.getMyCall2();
-	for (unsigned int i = 0U; i < my2.Len() && i < SHORT_CALLSIGN_LENGTH; i++)
-		buffer2[i + 43U] = my2.GetChar(i);
-
-	CCCITTChecksumReverse cksum1;
-	cksum1.update(buffer2 + 8U, RADIO_HEADER_LENGTH_BYTES - 2U);
-	cksum1.result(buffer2 + 47U);
+	header.getData(buffer2 + 8U, RADIO_HEADER_LENGTH_BYTES, true);
 
 	buffer2[49U] = 0x00U;
 
@@ -434,23 +403,16 @@ bool CDVMegaController::writeHeader(const CHeaderData& header)
 
 	m_pktCounter = 0U;
 
-	wxMutexLocker locker(m_mutex);
-
-	unsigned char type1 = DSMTT_START;
-	m_txData.addData(&type1, 1U);
-
-	unsigned char len1 = 8U;
-	m_txData.addData(&len1, 1U);
+	unsigned char hdr1[2U];
+	hdr1[0U] = DSMTT_START;
+	hdr1[1U] = 8U;
+	m_txData.addData(hdr1, 2U, buffer1, 8U);
 
-	m_txData.addData(buffer1, 8U);
-
-	unsigned char type2 = DSMTT_HEADER;
-	m_txData.addData(&type2, 1U);
-
-	unsigned char len2 = 52U;
-	m_txData.addData(&len2, 1U);
-
-	m_txData.addData(buffer2, 52U);
+	unsigned char hdr2[2U];
+	hdr2[0U] = DSMTT_HEADER;
+	hdr2[1U] = 52U;
+	m_txData.addData(hdr2, 2U, buffer2, 52U);
+	m_events.signal();
 
 	return true;
 }
@@ -488,15 +450,11 @@ bool CDVMegaController::writeData(const unsigned char* data, unsigned int, bool
 			buffer[7U] = 0x0BU;
 		}
 
-		wxMutexLocker locker(m_mutex);
-
-		unsigned char type = DSMTT_EOT;
-		m_txData.addData(&type, 1U);
-
-		unsigned char len = 8U;
-		m_txData.addData(&len, 1U);
-
-		m_txData.addData(buffer, 8U);
+		unsigned char hdr[2U];
+		hdr[0U] = DSMTT_EOT;
+		hdr[1U] = 8U;
+		m_txData.addData(hdr, 2U, buffer, 8U);
+		m_events.signal();
 
 		return true;
 	}
@@ -532,15 +490,11 @@ bool CDVMegaController::writeData(const unsigned char* data, unsigned int, bool
 		buffer[23U] = 0x0BU;
 	}
 
-	wxMutexLocker locker(m_mutex);
-
-	unsigned char type = DSMTT_DATA;
-	m_txData.addData(&type, 1U);
-
-	unsigned char len = 24U;
-	m_txData.addData(&len, 1U);
-
-	m_txData.addData(buffer, 24U);
+	unsigned char hdr[2U];
+	hdr[0U] = DSMTT_DATA;
+	hdr[1U] = 24U;
+	m_txData.addData(hdr, 2U, buffer, 24U);
+	m_events.signal();
 
 	return true;
 }
@@ -833,65 +787,30 @@ bool CDVMegaController::setEnabled(bool enable)
 	return true;
 }
 
-RESP_TYPE_MEGA CDVMegaController::getResponse(unsigned char *buffer, unsigned int& length)
+RESP_TYPE_MEGA CDVMegaController::getResponse(unsigned char*& buffer, unsigned int& length)
 {
-	// Get the start of the frame or nothing at all
-	int ret = m_serial.read(buffer, 1U);
-	if (ret < 0) {
-		wxLogError(wxT("Error when reading from the DVMEGA"));
-		return RTM_ERROR;
-	}
-
-	if (ret == 0)
-		return RTM_TIMEOUT;
+	// Only go to the port when there is no whole frame left from the last read
+	buffer = m_framer.getFrame(length);
+	if (buffer == NULL) {
+		unsigned int space;
+		unsigned char* data = m_framer.getSpace(space);
 
-	if (buffer[0U] != DVRPTR_FRAME_START)
-		return RTM_TIMEOUT;
-
-	unsigned int offset = 1U;
-
-	while (offset < DVRPTR_HEADER_LENGTH) {
-		ret = m_serial.read(buffer + offset, DVRPTR_HEADER_LENGTH - offset);
+		int ret = m_serial.readNonblock(data, space);
 		if (ret < 0) {
 			wxLogError(wxT("Error when reading from the DVMEGA"));
 			return RTM_ERROR;
 		}
 
-		if (ret > 0)
-			offset += ret;
-
-		if (ret == 0)
-			Sleep(5UL);
-	}
-
-	length = buffer[1U] + buffer[2U] * 256U;
+		m_framer.addData(ret);
 
-	if (length >= 100U) {
-		wxLogError(wxT("Invalid data received from the DVMEGA"));
-		return RTM_ERROR;
+		buffer = m_framer.getFrame(length);
+		if (buffer == NULL)
+			return RTM_TIMEOUT;
 	}
 
 	// Remove the response bit
 	unsigned int type = buffer[3U] & 0x7FU;
 
-	offset = 0U;
-
-	while (offset < length) {
-		ret = m_serial.read(buffer + offset + DVRPTR_HEADER_LENGTH, length - offset);
-		if (ret < 0) {
-			wxLogError(wxT("Error when reading from the DVMEGA"));
-			return RTM_ERROR;
-		}
-
-		if (ret > 0)
-			offset += ret;
-
-		if (ret == 0)
-			Sleep(5UL);
-	}
-
-	length += DVRPTR_HEADER_LENGTH;
-
 	// CUtils::dump(wxT("Received"), buffer, length);
 
 	switch (type) {
@@ -926,6 +845,24 @@ RESP_TYPE_MEGA CDVMegaController::getResponse(unsigned char *buffer, unsigned in
 	}
 }
 
+int CDVMegaController::getFrameLength(const unsigned char* data, unsigned int length)
+{
+	if (data[0U] != DVRPTR_FRAME_START)
+		return -1;
+
+	if (length < DVRPTR_HEADER_LENGTH)
+		return 0;
+
+	unsigned int frameLength = data[1U] + data[2U] * 256U;
+
+	if (frameLength >= 100U) {
+		wxLogError(wxT("Invalid data received from the DVMEGA"));
+		return -1;
+	}
+
+	return int(frameLength + DVRPTR_HEADER_LENGTH);
+}
+
 wxString CDVMegaController::getPath() const
 {
 	return m_path;
@@ -1079,12 +1016,7 @@ bool CDVMegaController::findModem()
 
 	// Tell the repeater that the signal has gone away
 	if (m_rx) {
-		wxMutexLocker locker(m_mutex);
-
-		unsigned char data[2U];
-		data[0U] = DSMTT_EOT;
-		data[1U] = 0U;
-		m_rxData.addData(data, 2U);
+		writeRX(DSMTT_EOT);
 
 		m_rx = false;
 	}
@@ -1119,6 +1051,11 @@ bool CDVMegaController::openModem()
 	if (!ret)
 		return false;
 
+	m_framer.reset();
+	m_credit.reset();
+
+	addPort(m_serial.getFD());
+
 	ret = readVersion();
 	if (!ret) {
 		m_serial.close();
@@ -20,7 +20,9 @@
 #define	DVMegaController_H
 
 #include "SerialDataController.h"
+#include "SerialFramer.h"
 #include "RingBuffer.h"
+#include "TXCredit.h"
 #include "Modem.h"
 #include "Utils.h"
 
@@ -45,7 +47,7 @@ enum RESP_TYPE_MEGA {
 	RTM_SET_TESTMDE
 };
 
-class CDVMegaController : public CModem {
+class CDVMegaController : public CModem, public ISerialProtocol {
 public:
 	CDVMegaController(const wxString& port, const wxString& path, bool rxInvert, bool txInvert, unsigned int txDelay);
 	CDVMegaController(const wxString& port, const wxString& path, unsigned int txDelay, unsigned int rxFrequency, unsigned int txFrequency, unsigned int power);
@@ -63,6 +65,8 @@ public:
 
 	virtual wxString getPath() const;
 
+	virtual int getFrameLength(const unsigned char* data, unsigned int length);
+
 private:
 	wxString                   m_port;
 	wxString                   m_path;
@@ -74,7 +78,9 @@ private:
 	unsigned int               m_power;
 	CSerialDataController      m_serial;
 	unsigned char*             m_buffer;
+	CSerialFramer              m_framer;
 	CRingBuffer<unsigned char> m_txData;
+	CTXCredit                  m_credit;
 	unsigned char              m_txCounter;
 	unsigned char              m_pktCounter;
 	bool                       m_rx;
@@ -88,7 +94,7 @@ private:
 	bool setFrequencyAndPower();
 	bool setEnabled(bool enable);
 
-	RESP_TYPE_MEGA getResponse(unsigned char* buffer, unsigned int& length);
+	RESP_TYPE_MEGA getResponse(unsigned char*& buffer, unsigned int& length);
 
 	bool findPort();
 	bool findPath();
@@ -20,6 +20,7 @@
 #include "DVRPTRV1Controller.h"
 #include "CCITTChecksum.h"
 #include "DStarDefines.h"
+#include "Logger.h"
 #include "Timer.h"
 
 #if defined(__WINDOWS__)
@@ -56,6 +57,9 @@ const unsigned int MAX_RESPONSES = 30U;
 
 const unsigned int BUFFER_LENGTH = 200U;
 
+// Slots kept in the modem, enough to cover a status poll arriving late
+const unsigned int TX_FILL = 8U;
+
 CDVRPTRV1Controller::CDVRPTRV1Controller(const wxString& port, const wxString& path, bool rxInvert, bool txInvert, bool channel, unsigned int modLevel, unsigned int txDelay) :
 CModem(),
 m_port(port),
@@ -67,7 +71,9 @@ m_modLevel(modLevel),
 m_txDelay(txDelay),
 m_serial(port, SERIAL_115200),
 m_buffer(NULL),
+m_framer(this, BUFFER_LENGTH),
 m_txData(1000U),
+m_credit(TX_FILL),
 m_txCounter(0U),
 m_pktCounter(0U),
 m_rx(false),
@@ -76,13 +82,10 @@ m_txEnabled(false),
 m_checksum(false)
 {
 	wxASSERT(!port.IsEmpty());
-
-	m_buffer = new unsigned char[BUFFER_LENGTH];
 }
 
 CDVRPTRV1Controller::~CDVRPTRV1Controller()
 {
-	delete[] m_buffer;
 }
 
 bool CDVRPTRV1Controller::start()
@@ -104,18 +107,17 @@ bool CDVRPTRV1Controller::start()
 
 void* CDVRPTRV1Controller::Entry()
 {
+	CLogger::startThread();
+
 	wxLogMessage(wxT("Starting DV-RPTR1 Modem Controller thread"));
 
-	// Clock every 5ms-ish
-	CTimer pollTimer(200U, 0U, 100U);
+	CTimer pollTimer(1000U, 0U, 100U);
 	pollTimer.start();
 
 	unsigned char  writeType   = DSMTT_NONE;
 	unsigned char  writeLength = 0U;
 	unsigned char* writeBuffer = new unsigned char[BUFFER_LENGTH];
 
-	unsigned int space = 0U;
-
 	while (!m_stopped) {
 		// Poll the modem status every 100ms
 		if (pollTimer.hasExpired()) {
@@ -163,14 +165,7 @@ void* CDVRPTRV1Controller::Entry()
 				} else {
 					bool correct = (m_buffer[5U] & 0x80U) == 0x00U;
 					if (correct) {
-						wxMutexLocker locker(m_mutex);
-
-						unsigned char data[2U];
-						data[0U] = DSMTT_HEADER;
-						data[1U] = RADIO_HEADER_LENGTH_BYTES;
-						m_rxData.addData(data, 2U);
-
-						m_rxData.addData(m_buffer + 8U, RADIO_HEADER_LENGTH_BYTES);
+						writeRX(DSMTT_HEADER, m_buffer + 8U, RADIO_HEADER_LENGTH_BYTES);
 
 						m_rx = true;
 					}
@@ -187,14 +182,7 @@ void* CDVRPTRV1Controller::Entry()
 					if (m_buffer[4U] == DVRPTR_NAK)
 						wxLogWarning(wxT("Received a data NAK from the modem"));
 				} else {
-					wxMutexLocker locker(m_mutex);
-
-					unsigned char data[2U];
-					data[0U] = DSMTT_DATA;
-					data[1U] = DV_FRAME_LENGTH_BYTES;
-					m_rxData.addData(data, 2U);
-
-					m_rxData.addData(m_buffer + 8U, DV_FRAME_LENGTH_BYTES);
+					writeRX(DSMTT_DATA, m_buffer + 8U, DV_FRAME_LENGTH_BYTES);
 
 					m_rx = true;
 				}
@@ -202,12 +190,7 @@ void* CDVRPTRV1Controller::Entry()
 
 			case RT1_EOT: {
 					// wxLogMessage(wxT("RT_EOT"));
-					wxMutexLocker locker(m_mutex);
-
-					unsigned char data[2U];
-					data[0U] = DSMTT_EOT;
-					data[1U] = 0U;
-					m_rxData.addData(data, 2U);
+					writeRX(DSMTT_EOT);
 
 					m_rx = false;
 				}
@@ -215,12 +198,7 @@ void* CDVRPTRV1Controller::Entry()
 
 			case RT1_RXLOST: {
 					// wxLogMessage(wxT("RT_LOST"));
-					wxMutexLocker locker(m_mutex);
-
-					unsigned char data[2U];
-					data[0U] = DSMTT_LOST;
-					data[1U] = 0U;
-					m_rxData.addData(data, 2U);
+					writeRX(DSMTT_LOST);
 
 					m_rx = false;
 				}
@@ -231,9 +209,9 @@ void* CDVRPTRV1Controller::Entry()
 					m_checksum  = (m_buffer[4U] & 0x08U) == 0x08U;
 					m_tx        = (m_buffer[5U] & 0x02U) == 0x02U;
 					m_txSpace   = m_buffer[8U];
-					space       = m_txSpace - m_buffer[9U];
+					m_credit.setSpace(m_txSpace - m_buffer[9U]);
 					// CUtils::dump(wxT("GET_STATUS"), m_buffer, length);
-					// wxLogMessage(wxT("PTT=%d tx=%u space=%u cksum=%d, tx enabled=%d"), int(m_tx), m_txSpace, space, int(m_checksum), int(m_txEnabled));
+					// wxLogMessage(wxT("PTT=%d tx=%u space=%u cksum=%d, tx enabled=%d"), int(m_tx), m_txSpace, m_txSpace - m_buffer[9U], int(m_checksum), int(m_txEnabled));
 				}
 				break;
 
@@ -249,10 +227,11 @@ void* CDVRPTRV1Controller::Entry()
 				break;
 		}
 
-		if (space > 0U) {
-			if (writeType == DSMTT_NONE && m_txData.hasData()) {
-				wxMutexLocker locker(m_mutex);
+		// Keep going while there is more to read or write, otherwise sleep until there is
+		bool idle = type == RT1_TIMEOUT;
 
+		if (m_credit.getSpace() > 0U) {
+			if (writeType == DSMTT_NONE && m_txData.hasData()) {
 				m_txData.getData(&writeType, 1U);
 				m_txData.getData(&writeLength, 1U);
 				m_txData.getData(writeBuffer, writeLength);
@@ -266,19 +245,21 @@ void* CDVRPTRV1Controller::Entry()
 				if (ret != int(writeLength))
 					wxLogWarning(wxT("Error when writing the header to the DV-RPTR modem"));
 
+				m_credit.write(1U);
 				writeType = DSMTT_NONE;
-				space--;
+				idle = false;
 			}
 
-			if (space > 4U && writeType == DSMTT_HEADER) {
+			if (m_credit.getSpace() > 4U && writeType == DSMTT_HEADER) {
 				// CUtils::dump(wxT("Write Header"), writeBuffer, writeLength);
 
 				int ret = m_serial.write(writeBuffer, writeLength);
 				if (ret != int(writeLength))
 					wxLogWarning(wxT("Error when writing the header to the DV-RPTR modem"));
 
+				m_credit.write(4U);
 				writeType = DSMTT_NONE;
-				space -= 4U;
+				idle = false;
 			}
 
 			if (writeType == DSMTT_DATA || writeType == DSMTT_EOT) {
@@ -288,14 +269,28 @@ void* CDVRPTRV1Controller::Entry()
 				if (ret != int(writeLength))
 					wxLogWarning(wxT("Error when writing data to the DV-RPTR modem"));
 
+				m_credit.write(1U, writeType == DSMTT_EOT);
+				if (writeType == DSMTT_EOT)
+					m_credit.log(wxT("DV-RPTR1 TX buffer"));
+
 				writeType = DSMTT_NONE;
-				space--;
+				idle = false;
 			}
 		}
 
-		Sleep(5UL);
+		if (idle) {
+			unsigned int timeout = pollTimer.getRemainingTicks();
+
+			// A write held back for want of space can go once the modem has sent the next slot
+			if (writeType != DSMTT_NONE || m_txData.hasData())
+				timeout = m_credit.getNext(timeout);
+
+			waitForEvent(timeout);
+		}
 
-		pollTimer.clock();
+		unsigned int ms = getElapsed();
+		pollTimer.clock(ms);
+		m_credit.clock(ms);
 	}
 
 	wxLogMessage(wxT("Stopping DV-RPTR1 Modem Controller thread"));
@@ -362,33 +357,7 @@ bool CDVRPTRV1Controller::writeHeader(const CHeaderData& header)
 
 	::memset(buffer2 + 8U, ' ', RADIO_HEADER_LENGTH_BYTES);
 
-	buffer2[8U]  = header.getFlag1();
-	buffer2[9U]  = header.getFlag2();
-	buffer2[10U] = header.getFlag3();
-
-	wxString rpt2 = header.getRptCall2();
-	for (unsigned int i = 0U; i < rpt2.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer2[i + 11U]  = rpt2.GetChar(i);
-
-	wxString rpt1 = header.getRptCall1();
-	for (unsigned int i = 0U; i < rpt1.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer2[i + 19U] = rpt1.GetChar(i);
-
-	wxString your = header.getYourCall();
-	for (unsigned int i = 0U; i < your.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer2[i + 27U] = your.GetChar(i);
-
-	wxString my1 = header.getMyCall1();
-	for (unsigned int i = 0U; i < my1.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer2[i + 35U] = my1.GetChar(i);
-
-	wxString my2 = header.getMyCall2();
-	for (unsigned int i = 0U; i < my2.Len() && i < SHORT_CALLSIGN_LENGTH; i++)
-		buffer2[i + 43U] = my2.GetChar(i);
-
-	CCCITTChecksumReverse cksum1;
-	cksum1.update(buffer2 + 8U, RADIO_HEADER_LENGTH_BYTES - 2U);
-	cksum1.result(buffer2 + 47U);
+	header.getData(buffer2 + 8U, RADIO_HEADER_LENGTH_BYTES, true);
 
 	buffer2[49U] = 0x00U;
 
@@ -403,23 +372,16 @@ bool CDVRPTRV1Controller::writeHeader(const CHeaderData& header)
 
 	m_pktCounter = 0U;
 
-	wxMutexLocker locker(m_mutex);
-
-	unsigned char type1 = DSMTT_START;
-	m_txData.addData(&type1, 1U);
+	unsigned char hdr1[2U];
+	hdr1[0U] = DSMTT_START;
+	hdr1[1U] = 8U;
+	m_txData.addData(hdr1, 2U, buffer1, 8U);
 
-	unsigned char len1 = 8U;
-	m_txData.addData(&len1, 1U);
-
-	m_txData.addData(buffer1, 8U);
-
-	unsigned char type2 = DSMTT_HEADER;
-	m_txData.addData(&type2, 1U);
-
-	unsigned char len2 = 52U;
-	m_txData.addData(&len2, 1U);
-
-	m_txData.addData(buffer2, 52U);
+	unsigned char hdr2[2U];
+	hdr2[0U] = DSMTT_HEADER;
+	hdr2[1U] = 52U;
+	m_txData.addData(hdr2, 2U, buffer2, 52U);
+	m_events.signal();
 
 	return true;
 }
@@ -457,15 +419,11 @@ bool CDVRPTRV1Controller::writeData(const unsigned char* data, unsigned int, boo
 			buffer[7U] = 0x0BU;
 		}
 
-		wxMutexLocker locker(m_mutex);
-
-		unsigned char type = DSMTT_EOT;
-		m_txData.addData(&type, 1U);
-
-		unsigned char len = 8U;
-		m_txData.addData(&len, 1U);
-
-		m_txData.addData(buffer, 8U);
+		unsigned char hdr[2U];
+		hdr[0U] = DSMTT_EOT;
+		hdr[1U] = 8U;
+		m_txData.addData(hdr, 2U, buffer, 8U);
+		m_events.signal();
 
 		return true;
 	}
@@ -501,15 +459,11 @@ bool CDVRPTRV1Controller::writeData(const unsigned char* data, unsigned int, boo
 		buffer[23U] = 0x0BU;
 	}
 
-	wxMutexLocker locker(m_mutex);
-
-	unsigned char type = DSMTT_DATA;
-	m_txData.addData(&type, 1U);
-
-	unsigned char len = 24U;
-	m_txData.addData(&len, 1U);
-
-	m_txData.addData(buffer, 24U);
+	unsigned char hdr[2U];
+	hdr[0U] = DSMTT_DATA;
+	hdr[1U] = 24U;
+	m_txData.addData(hdr, 2U, buffer, 24U);
+	m_events.signal();
 
 	return true;
 }
@@ -738,60 +692,30 @@ bool CDVRPTRV1Controller::setEnabled(bool enable)
 	return true;
 }
 
-RESP_TYPE_V1 CDVRPTRV1Controller::getResponse(unsigned char *buffer, unsigned int& length)
+RESP_TYPE_V1 CDVRPTRV1Controller::getResponse(unsigned char*& buffer, unsigned int& length)
 {
-	// Get the start of the frame or nothing at all
-	int ret = m_serial.read(buffer, 1U);
-	if (ret < 0) {
-		wxLogError(wxT("Error when reading from the DV-RPTR"));
-		return RT1_ERROR;
-	}
-
-	if (ret == 0)
-		return RT1_TIMEOUT;
-
-	if (buffer[0U] != DVRPTR_FRAME_START)
-		return RT1_TIMEOUT;
-
-	unsigned int offset = 1U;
+	// Only go to the port when there is no whole frame left from the last read
+	buffer = m_framer.getFrame(length);
+	if (buffer == NULL) {
+		unsigned int space;
+		unsigned char* data = m_framer.getSpace(space);
 
-	while (offset < DVRPTR_HEADER_LENGTH) {
-		ret = m_serial.read(buffer + offset, DVRPTR_HEADER_LENGTH - offset);
+		int ret = m_serial.readNonblock(data, space);
 		if (ret < 0) {
 			wxLogError(wxT("Error when reading from the DV-RPTR"));
 			return RT1_ERROR;
 		}
 
-		if (ret > 0)
-			offset += ret;
+		m_framer.addData(ret);
 
-		if (ret == 0)
-			Sleep(5UL);
+		buffer = m_framer.getFrame(length);
+		if (buffer == NULL)
+			return RT1_TIMEOUT;
 	}
 
-	length = buffer[1U] + buffer[2U] * 256U;
-
 	// Remove the response bit
 	unsigned int type = buffer[3U] & 0x7FU;
 
-	offset = 0U;
-
-	while (offset < length) {
-		ret = m_serial.read(buffer + offset + DVRPTR_HEADER_LENGTH, length - offset);
-		if (ret < 0) {
-			wxLogError(wxT("Error when reading from the DV-RPTR"));
-			return RT1_ERROR;
-		}
-
-		if (ret > 0)
-			offset += ret;
-
-		if (ret == 0)
-			Sleep(5UL);
-	}
-
-	length += DVRPTR_HEADER_LENGTH;
-
 	// CUtils::dump(wxT("Received"), buffer, length);
 
 	switch (type) {
@@ -826,6 +750,24 @@ RESP_TYPE_V1 CDVRPTRV1Controller::getResponse(unsigned char *buffer, unsigned in
 	}
 }
 
+int CDVRPTRV1Controller::getFrameLength(const unsigned char* data, unsigned int length)
+{
+	if (data[0U] != DVRPTR_FRAME_START)
+		return -1;
+
+	if (length < DVRPTR_HEADER_LENGTH)
+		return 0;
+
+	unsigned int frameLength = data[1U] + data[2U] * 256U;
+
+	if ((frameLength + DVRPTR_HEADER_LENGTH) > BUFFER_LENGTH) {
+		wxLogError(wxT("Invalid data received from the DV-RPTR"));
+		return -1;
+	}
+
+	return int(frameLength + DVRPTR_HEADER_LENGTH);
+}
+
 wxString CDVRPTRV1Controller::getPath() const
 {
 	return m_path;
@@ -979,12 +921,7 @@ bool CDVRPTRV1Controller::findModem()
 
 	// Tell the repeater that the signal has gone away
 	if (m_rx) {
-		wxMutexLocker locker(m_mutex);
-
-		unsigned char data[2U];
-		data[0U] = DSMTT_EOT;
-		data[1U] = 0U;
-		m_rxData.addData(data, 2U);
+		writeRX(DSMTT_EOT);
 
 		m_rx = false;
 	}
@@ -1019,6 +956,11 @@ bool CDVRPTRV1Controller::openModem()
 	if (!ret)
 		return false;
 
+	m_framer.reset();
+	m_credit.reset();
+
+	addPort(m_serial.getFD());
+
 	ret = readVersion();
 	if (!ret) {
 		m_serial.close();
@@ -20,7 +20,9 @@
 #define	DVRPTRV1Controller_H
 
 #include "SerialDataController.h"
+#include "SerialFramer.h"
 #include "RingBuffer.h"
+#include "TXCredit.h"
 #include "Modem.h"
 #include "Utils.h"
 
@@ -45,7 +47,7 @@ enum RESP_TYPE_V1 {
 	RT1_SET_TESTMDE
 };
 
-class CDVRPTRV1Controller : public CModem {
+class CDVRPTRV1Controller : public CModem, public ISerialProtocol {
 public:
 	CDVRPTRV1Controller(const wxString& port, const wxString& path, bool rxInvert, bool txInvert, bool channel, unsigned int modLevel, unsigned int txDelay);
 	virtual ~CDVRPTRV1Controller();
@@ -62,6 +64,8 @@ public:
 
 	virtual wxString getPath() const;
 
+	virtual int getFrameLength(const unsigned char* data, unsigned int length);
+
 private:
 	wxString                   m_port;
 	wxString                   m_path;
@@ -72,7 +76,9 @@ private:
 	unsigned int               m_txDelay;
 	CSerialDataController      m_serial;
 	unsigned char*             m_buffer;
+	CSerialFramer              m_framer;
 	CRingBuffer<unsigned char> m_txData;
+	CTXCredit                  m_credit;
 	unsigned char              m_txCounter;
 	unsigned char              m_pktCounter;
 	bool                       m_rx;
@@ -85,7 +91,7 @@ private:
 	bool setConfig();
 	bool setEnabled(bool enable);
 
-	RESP_TYPE_V1 getResponse(unsigned char* buffer, unsigned int& length);
+	RESP_TYPE_V1 getResponse(unsigned char*& buffer, unsigned int& length);
 
 	bool findPort();
 	bool findPath();
@@ -18,6 +18,7 @@
 
 #include "DVRPTRV3Controller.h"
 #include "DStarDefines.h"
+#include "Logger.h"
 #include "Timer.h"
 
 #if defined(__WINDOWS__)
@@ -30,6 +31,9 @@ const unsigned int MAX_RESPONSES = 30U;
 
 const unsigned int BUFFER_LENGTH = 200U;
 
+// Slots kept in the modem, enough to cover a status poll arriving late
+const unsigned int TX_FILL = 8U;
+
 CDVRPTRV3Controller::CDVRPTRV3Controller(const wxString& port, const wxString& path, bool txInvert, unsigned int modLevel, bool duplex, const wxString& callsign, unsigned int txDelay) :
 CModem(),
 m_connection(CT_USB),
@@ -45,14 +49,14 @@ m_txDelay(txDelay),
 m_usb(NULL),
 m_network(NULL),
 m_buffer(NULL),
+m_framer(this, BUFFER_LENGTH),
 m_txData(1000U),
+m_credit(TX_FILL),
 m_rx(false)
 {
 	wxASSERT(!port.IsEmpty());
 
 	m_usb = new CSerialDataController(port, SERIAL_115200);
-
-	m_buffer = new unsigned char[BUFFER_LENGTH];
 }
 
 CDVRPTRV3Controller::CDVRPTRV3Controller(const wxString& address, unsigned int port, bool txInvert, unsigned int modLevel, bool duplex, const wxString& callsign, unsigned int txDelay) :
@@ -70,15 +74,15 @@ m_txDelay(txDelay),
 m_usb(NULL),
 m_network(NULL),
 m_buffer(NULL),
+m_framer(this, BUFFER_LENGTH),
 m_txData(1000U),
+m_credit(TX_FILL),
 m_rx(false)
 {
 	wxASSERT(!address.IsEmpty());
 	wxASSERT(port > 0U);
 
 	m_network = new CTCPReaderWriter(address, port);
-
-	m_buffer = new unsigned char[BUFFER_LENGTH];
 }
 
 CDVRPTRV3Controller::~CDVRPTRV3Controller()
@@ -86,7 +90,6 @@ CDVRPTRV3Controller::~CDVRPTRV3Controller()
 	delete m_usb;
 	delete m_network;
 
-	delete[] m_buffer;
 }
 
 bool CDVRPTRV3Controller::start()
@@ -108,14 +111,13 @@ bool CDVRPTRV3Controller::start()
 
 void* CDVRPTRV3Controller::Entry()
 {
+	CLogger::startThread();
+
 	wxLogMessage(wxT("Starting DV-RPTR3 Modem Controller thread"));
 
-	// Clock every 5ms-ish
-	CTimer pollTimer(200U, 0U, 250U);
+	CTimer pollTimer(1000U, 0U, 250U);
 	pollTimer.start();
 
-	unsigned int space = 0U;
-
 	while (!m_stopped) {
 		// Poll the modem status every 250ms
 		if (pollTimer.hasExpired()) {
@@ -149,25 +151,15 @@ void* CDVRPTRV3Controller::Entry()
 
 			case RT3_HEADER: {
 					// CUtils::dump(wxT("RT3_HEADER"), m_buffer, length);
-					wxMutexLocker locker(m_mutex);
-
-					unsigned char data[2U];
-					data[0U] = DSMTT_HEADER;
-					data[1U] = RADIO_HEADER_LENGTH_BYTES;
-					m_rxData.addData(data, 2U);
-
-					m_rxData.addData(m_buffer + 9U, RADIO_HEADER_LENGTH_BYTES - 2U);
+					unsigned char header[RADIO_HEADER_LENGTH_BYTES];
+					::memcpy(header, m_buffer + 9U, RADIO_HEADER_LENGTH_BYTES - 2U);
 
 					// Dummy checksum
-					data[0U] = 0xFFU;
-					data[1U] = 0xFFU;
-					m_rxData.addData(data, 2U);
-
-					data[0U] = DSMTT_DATA;
-					data[1U] = DV_FRAME_LENGTH_BYTES;
-					m_rxData.addData(data, 2U);
+					header[RADIO_HEADER_LENGTH_BYTES - 2U] = 0xFFU;
+					header[RADIO_HEADER_LENGTH_BYTES - 1U] = 0xFFU;
+					writeRX(DSMTT_HEADER, header, RADIO_HEADER_LENGTH_BYTES);
 
-					m_rxData.addData(m_buffer + 51U, DV_FRAME_LENGTH_BYTES);
+					writeRX(DSMTT_DATA, m_buffer + 51U, DV_FRAME_LENGTH_BYTES);
 
 					m_rx = true;
 				}
@@ -175,23 +167,14 @@ void* CDVRPTRV3Controller::Entry()
 
 			case RT3_DATA: {
 					// CUtils::dump(wxT("RT3_DATA"), m_buffer, length);
-					wxMutexLocker locker(m_mutex);
-
-					unsigned char data[2U];
-					data[0U] = DSMTT_DATA;
-					data[1U] = DV_FRAME_LENGTH_BYTES;
-					m_rxData.addData(data, 2U);
-
-					m_rxData.addData(m_buffer + 5U, DV_FRAME_LENGTH_BYTES);
+					writeRX(DSMTT_DATA, m_buffer + 5U, DV_FRAME_LENGTH_BYTES);
 
 					m_rx = true;
 
 					// End of transmission?
 					bool end = (m_buffer[19U] & 0x40U) == 0x40U;
 					if (end) {
-						data[0U] = DSMTT_EOT;
-						data[1U] = 0U;
-						m_rxData.addData(data, 2U);
+						writeRX(DSMTT_EOT);
 
 						m_rx = false;
 					}
@@ -199,7 +182,7 @@ void* CDVRPTRV3Controller::Entry()
 				break;
 
 			case RT3_SPACE:
-				space = m_buffer[9U];
+				m_credit.setSpace(m_buffer[9U]);
 				// CUtils::dump(wxT("RT3_SPACE"), m_buffer, length);
 				break;
 
@@ -214,17 +197,16 @@ void* CDVRPTRV3Controller::Entry()
 				break;
 		}
 
-		if (space >= 4U) {
+		// Keep going while there is more to read or write, otherwise sleep until there is
+		bool idle = type == RT3_TIMEOUT;
+
+		if (m_credit.getSpace() >= 4U) {
 			if (m_txData.hasData()) {
 				unsigned char len = 0U;
 				unsigned char data[200U];
 
-				{
-					wxMutexLocker locker(m_mutex);
-
-					m_txData.getData(&len, 1U);
-					m_txData.getData(data, len);
-				}
+				m_txData.getData(&len, 1U);
+				m_txData.getData(data, len);
 
 				// CUtils::dump(wxT("Write"), data, len);
 
@@ -236,17 +218,31 @@ void* CDVRPTRV3Controller::Entry()
 						return NULL;
 					}
 				} else {
-					if (len > 100U)
-						space -= 4U;
-					else
-						space--;
+					// The last data frame has 0x55s in place of the slow data
+					bool end = len == 17U && data[14U] == 0x55U && data[15U] == 0x55U && data[16U] == 0x55U;
+
+					m_credit.write(len > 100U ? 4U : 1U, end);
+					if (end)
+						m_credit.log(wxT("DV-RPTR3 TX buffer"));
+
+					idle = false;
 				}
 			}
 		}
 
-		Sleep(5UL);
+		if (idle) {
+			unsigned int timeout = pollTimer.getRemainingTicks();
+
+			// A write held back for want of space can go once the modem has sent the next slot
+			if (m_txData.hasData())
+				timeout = m_credit.getNext(timeout);
 
-		pollTimer.clock();
+			waitForEvent(timeout);
+		}
+
+		unsigned int ms = getElapsed();
+		pollTimer.clock(ms);
+		m_credit.clock(ms);
 	}
 
 	wxLogMessage(wxT("Stopping DV-RPTR3 Modem Controller thread"));
@@ -280,36 +276,11 @@ bool CDVRPTRV3Controller::writeHeader(const CHeaderData& header)
 
 	::memset(buffer + 9U, ' ', RADIO_HEADER_LENGTH_BYTES);
 
-	buffer[9U]  = header.getFlag1();
-	buffer[10U] = header.getFlag2();
-	buffer[11U] = header.getFlag3();
-
-	wxString rpt2 = header.getRptCall2();
-	for (unsigned int i = 0U; i < rpt2.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 12U]  = rpt2.GetChar(i);
-
-	wxString rpt1 = header.getRptCall1();
-	for (unsigned int i = 0U; i < rpt1.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 20U] = rpt1.GetChar(i);
-
-	wxString your = header.getYourCall();
-	for (unsigned int i = 0U; i < your.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 28U] = your.GetChar(i);
-
-	wxString my1 = header.getMyCall1();
-	for (unsigned int i = 0U; i < my1.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 36U] = my1.GetChar(i);
-
-	wxString my2 = header.getMyCall2();
-	for (unsigned int i = 0U; i < my2.Len() && i < SHORT_CALLSIGN_LENGTH; i++)
-		buffer[i + 44U] = my2.GetChar(i);
-
-	wxMutexLocker locker(m_mutex);
+	header.getData(buffer + 9U, RADIO_HEADER_LENGTH_BYTES - 2U, false);
 
 	unsigned char len = 105U;
-	m_txData.addData(&len, 1U);
-
-	m_txData.addData(buffer, 105U);
+	m_txData.addData(&len, 1U, buffer, 105U);
+	m_events.signal();
 
 	m_tx = true;
 
@@ -344,12 +315,9 @@ bool CDVRPTRV3Controller::writeData(const unsigned char* data, unsigned int, boo
 		m_tx = false;
 	}
 
-	wxMutexLocker locker(m_mutex);
-
 	unsigned char len = 17U;
-	m_txData.addData(&len, 1U);
-
-	m_txData.addData(buffer, 17U);
+	m_txData.addData(&len, 1U, buffer, 17U);
+	m_events.signal();
 
 	return true;
 }
@@ -498,63 +466,25 @@ bool CDVRPTRV3Controller::setConfig()
 	return true;
 }
 
-RESP_TYPE_V3 CDVRPTRV3Controller::getResponse(unsigned char *buffer, unsigned int& length)
+RESP_TYPE_V3 CDVRPTRV3Controller::getResponse(unsigned char*& buffer, unsigned int& length)
 {
-	// Get the start of the frame or nothing at all
-	int ret = readModem(buffer + 0U, 5U);
-	if (ret < 0) {
-		wxLogError(wxT("Error when reading from the DV-RPTR"));
-		return RT3_ERROR;
-	}
-
-	if (ret == 0)
-		return RT3_TIMEOUT;
-
-	while (::memcmp(buffer + 0U, "HEAD", 4U) != 0) {
-		buffer[0U] = buffer[1U];
-		buffer[1U] = buffer[2U];
-		buffer[2U] = buffer[3U];
-		buffer[3U] = buffer[4U];
+	// Only go to the modem when there is no whole frame left from the last read
+	buffer = m_framer.getFrame(length);
+	if (buffer == NULL) {
+		unsigned int space;
+		unsigned char* data = m_framer.getSpace(space);
 
-		ret = readModem(buffer + 4U, 1U);
+		int ret = readModem(data, space);
 		if (ret < 0) {
 			wxLogError(wxT("Error when reading from the DV-RPTR"));
 			return RT3_ERROR;
 		}
 
-		if (ret == 0)
-			return RT3_TIMEOUT;
-	}
-
-	switch (buffer[4U]) {
-		case 'X':
-			length = 105U;
-			break;
-		case 'Y':
-			length = 10U;
-			break;
-		case 'Z':
-			length = 20U;
-			break;
-		default:
-			wxLogError(wxT("DV-RPTR frame type is incorrect - 0x%02X"), buffer[4U]);
-			return RT3_UNKNOWN;
-	}
-
-	unsigned int offset = 5U;
+		m_framer.addData(ret);
 
-	while (offset < length) {
-		ret = readModem(buffer + offset, length - offset);
-		if (ret < 0) {
-			wxLogError(wxT("Error when reading from the DV-RPTR"));
-			return RT3_ERROR;
-		}
-
-		if (ret > 0)
-			offset += ret;
-
-		if (ret == 0)
-			Sleep(5UL);
+		buffer = m_framer.getFrame(length);
+		if (buffer == NULL)
+			return RT3_TIMEOUT;
 	}
 
 	// CUtils::dump(wxT("Received"), buffer, length);
@@ -577,6 +507,29 @@ RESP_TYPE_V3 CDVRPTRV3Controller::getResponse(unsigned char *buffer, unsigned in
 	return RT3_UNKNOWN;
 }
 
+int CDVRPTRV3Controller::getFrameLength(const unsigned char* data, unsigned int length)
+{
+	// A partial match at the end of the data may still be the start of a frame
+	unsigned int n = length < 4U ? length : 4U;
+	if (::memcmp(data, "HEAD", n) != 0)
+		return -1;
+
+	if (length < 5U)
+		return 0;
+
+	switch (data[4U]) {
+		case 'X':
+			return 105;
+		case 'Y':
+			return 10;
+		case 'Z':
+			return 20;
+		default:
+			wxLogError(wxT("DV-RPTR frame type is incorrect - 0x%02X"), data[4U]);
+			return -5;
+	}
+}
+
 wxString CDVRPTRV3Controller::getPath() const
 {
 	return m_usbPath;
@@ -736,12 +689,7 @@ bool CDVRPTRV3Controller::findModem()
 
 	// Tell the repeater that the signal has gone away
 	if (m_rx) {
-		wxMutexLocker locker(m_mutex);
-
-		unsigned char data[2U];
-		data[0U] = DSMTT_EOT;
-		data[1U] = 0U;
-		m_rxData.addData(data, 2U);
+		writeRX(DSMTT_EOT);
 
 		m_rx = false;
 	}
@@ -777,9 +725,13 @@ bool CDVRPTRV3Controller::openModem()
 	switch (m_connection) {
 		case CT_USB:
 			ret = m_usb->open();
+			if (ret)
+				addPort(m_usb->getFD());
 			break;
 		case CT_NETWORK:
 			ret = m_network->open();
+			if (ret)
+				addPort(m_network->getFD());
 			break;
 		default:
 			wxLogError(wxT("Invalid connection type: %d"), int(m_connection));
@@ -789,6 +741,9 @@ bool CDVRPTRV3Controller::openModem()
 	if (!ret)
 		return false;
 
+	m_framer.reset();
+	m_credit.reset();
+
 	ret = readSerial();
 	if (!ret) {
 		closeModem();
@@ -808,7 +763,7 @@ int CDVRPTRV3Controller::readModem(unsigned char* buffer, unsigned int length)
 {
 	switch (m_connection) {
 		case CT_USB:
-			return m_usb->read(buffer, length);
+			return m_usb->readNonblock(buffer, length);
 		case CT_NETWORK:
 			return m_network->read(buffer, length, 0U);
 		default:
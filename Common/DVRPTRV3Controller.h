@@ -20,9 +20,11 @@
 #define	DVRPTRV3Controller_H
 
 #include "SerialDataController.h"
+#include "SerialFramer.h"
 #include "TCPReaderWriter.h"
 #include "DStarDefines.h"
 #include "RingBuffer.h"
+#include "TXCredit.h"
 #include "Modem.h"
 #include "Utils.h"
 
@@ -39,7 +41,7 @@ enum RESP_TYPE_V3 {
 	RT3_DATA
 };
 
-class CDVRPTRV3Controller : public CModem {
+class CDVRPTRV3Controller : public CModem, public ISerialProtocol {
 public:
 	CDVRPTRV3Controller(const wxString& port, const wxString& path, bool txInvert, unsigned int modLevel, bool duplex, const wxString& callsign, unsigned int txDelay);
 	CDVRPTRV3Controller(const wxString& address, unsigned int port, bool txInvert, unsigned int modLevel, bool duplex, const wxString& callsign, unsigned int txDelay);
@@ -57,6 +59,8 @@ public:
 
 	virtual wxString getPath() const;
 
+	virtual int getFrameLength(const unsigned char* data, unsigned int length);
+
 private:
 	CONNECTION_TYPE            m_connection;
 	wxString                   m_usbPort;
@@ -71,14 +75,16 @@ private:
 	CSerialDataController*     m_usb;
 	CTCPReaderWriter*          m_network;
 	unsigned char*             m_buffer;
+	CSerialFramer              m_framer;
 	CRingBuffer<unsigned char> m_txData;
+	CTXCredit                  m_credit;
 	bool                       m_rx;
 
 	bool readSerial();
 	bool setConfig();
 	bool readSpace();
 
-	RESP_TYPE_V3 getResponse(unsigned char* buffer, unsigned int& length);
+	RESP_TYPE_V3 getResponse(unsigned char*& buffer, unsigned int& length);
 
 	bool findPort();
 	bool findPath();
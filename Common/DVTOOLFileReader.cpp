@@ -143,24 +143,27 @@ DVTFR_TYPE CDVTOOLFileReader::read()
 	return m_type;
 }
 
-CHeaderData* CDVTOOLFileReader::readHeader()
+bool CDVTOOLFileReader::readHeader(CHeaderData& header)
 {
 	if (m_type != DVTFR_HEADER)
-		return NULL;
+		return false;
 
-	if (m_buffer[39U] == 0xFFU && m_buffer[40U] == 0xFFU)
-		return new CHeaderData(m_buffer, RADIO_HEADER_LENGTH_BYTES, false);
+	if (m_buffer[39U] == 0xFFU && m_buffer[40U] == 0xFFU) {
+		header = CHeaderData(m_buffer, RADIO_HEADER_LENGTH_BYTES, false);
+		return true;
+	}
 
 	// Header checksum testing is enabled
-	CHeaderData* header = new CHeaderData(m_buffer, RADIO_HEADER_LENGTH_BYTES, true);
+	CHeaderData temp(m_buffer, RADIO_HEADER_LENGTH_BYTES, true);
 
-	if (!header->isValid()) {
+	if (!temp.isValid()) {
 		CUtils::dump(wxT("Header checksum failure"), m_buffer, RADIO_HEADER_LENGTH_BYTES);
-		delete header;
-		return NULL;
+		return false;
 	}
 
-	return header;
+	header = temp;
+
+	return true;
 }
 
 unsigned int CDVTOOLFileReader::readData(unsigned char* buffer, unsigned int length, bool& end)
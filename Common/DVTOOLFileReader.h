@@ -40,7 +40,7 @@ public:
 
 	bool         open(const wxString& fileName);
 	DVTFR_TYPE   read();
-	CHeaderData* readHeader();
+	bool         readHeader(CHeaderData& header);
 	unsigned int readData(unsigned char* buffer, unsigned int length, bool& end);
 	void         close();
 
@@ -237,20 +237,12 @@ bool CDVTOOLFileWriter::writeHeader(const CHeaderData& header)
 	buffer[1] = header.getFlag2();
 	buffer[2] = header.getFlag3();
 
-	for (unsigned int i = 0U; i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[3 + i] = header.getRptCall1().GetChar(i);
-
-	for (unsigned int i = 0U; i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[11 + i] = header.getRptCall2().GetChar(i);
-
-	for (unsigned int i = 0U; i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[19 + i] = header.getYourCall().GetChar(i);
-
-	for (unsigned int i = 0U; i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[27 + i] = header.getMyCall1().GetChar(i);
-
-	for (unsigned int i = 0U; i < SHORT_CALLSIGN_LENGTH; i++)
-		buffer[35 + i] = header.getMyCall2().GetChar(i);
+	// The repeaters are the other way round from a radio header
+	header.getRptCall1(buffer + 3U);
+	header.getRptCall2(buffer + 11U);
+	header.getYourCall(buffer + 19U);
+	header.getMyCall1(buffer + 27U);
+	header.getMyCall2(buffer + 35U);
 
 	// Get the checksum for the header
 	CCCITTChecksumReverse csum;
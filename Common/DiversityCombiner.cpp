@@ -0,0 +1,319 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "DiversityCombiner.h"
+
+// How far ahead of the playout point a frame may be
+const unsigned int WINDOW_FRAMES = DIVERSITY_SLOTS - 3U;
+
+// The latency is held as eight times the value, and the jitter as four times, as in the TCP RTT estimator
+const unsigned int LATENCY_SHIFT = 3U;
+const unsigned int JITTER_SHIFT  = 2U;
+
+CDiversityCombiner::CDiversityCombiner(unsigned int rxCount, unsigned int maxDelay) :
+m_rxCount(rxCount),
+m_maxDelay(maxDelay),
+m_fec(),
+m_frames(NULL),
+m_active(NULL),
+m_sampled(NULL),
+m_latency(NULL),
+m_jitter(NULL),
+m_time(0U),
+m_delay(maxDelay),
+m_outSeqNo(0U),
+m_outFrame(0U)
+{
+	wxASSERT(rxCount > 0U);
+
+	// One arena holds every receiver's copy of every slot
+	m_frames  = new CDiversityFrame[DIVERSITY_SLOTS * rxCount];
+	m_active  = new bool[rxCount];
+	m_sampled = new bool[rxCount];
+	m_latency = new int[rxCount];
+	m_jitter  = new int[rxCount];
+
+	for (unsigned int i = 0U; i < rxCount; i++) {
+		m_sampled[i] = false;
+		m_latency[i] = 0;
+		m_jitter[i]  = 0;
+	}
+
+	reset();
+}
+
+CDiversityCombiner::~CDiversityCombiner()
+{
+	delete[] m_frames;
+	delete[] m_active;
+	delete[] m_sampled;
+	delete[] m_latency;
+	delete[] m_jitter;
+}
+
+void CDiversityCombiner::reset()
+{
+	for (unsigned int i = 0U; i < DIVERSITY_SLOTS; i++)
+		clearSlot(i);
+
+	// The latency of each receiver is carried over from the last transmission
+	for (unsigned int i = 0U; i < m_rxCount; i++)
+		m_active[i] = false;
+
+	m_time     = 0U;
+	m_outSeqNo = 0U;
+	m_outFrame = 0U;
+
+	calculateDelay();
+}
+
+void CDiversityCombiner::setActive(unsigned int rx, bool active)
+{
+	wxASSERT(rx < m_rxCount);
+
+	m_active[rx] = active;
+}
+
+bool CDiversityCombiner::write(unsigned int rx, unsigned int seqNo, bool end, const unsigned char* data, unsigned int length)
+{
+	wxASSERT(rx < m_rxCount);
+	wxASSERT(data != NULL);
+
+	if (seqNo >= DIVERSITY_SLOTS)
+		return false;
+
+	// The sequence number only covers 420ms, so a frame that would be ahead of the playout point but
+	// has arrived much too early must really be from a slow receiver and has missed it. It still shows
+	// how late that receiver is.
+	int offset = int((seqNo + DIVERSITY_SLOTS - m_outSeqNo) % DIVERSITY_SLOTS);
+	if (offset >= int(WINDOW_FRAMES) || getLate(m_outFrame + offset) < -int(m_maxDelay))
+		offset -= int(DIVERSITY_SLOTS);
+
+	int frameNo = int(m_outFrame) + offset;
+	if (frameNo < 0)
+		return false;
+
+	int late = getLate(frameNo);
+
+	if (m_sampled[rx]) {
+		int err = late - (m_latency[rx] >> LATENCY_SHIFT);
+		m_latency[rx] += err;
+
+		if (err < 0)
+			err = -err;
+		m_jitter[rx] += err - (m_jitter[rx] >> JITTER_SHIFT);
+	} else {
+		m_latency[rx] = late * int(1U << LATENCY_SHIFT);
+		m_jitter[rx]  = 0;
+		m_sampled[rx] = true;
+	}
+
+	if (offset < 0)
+		return false;
+
+	CDiversityFrame& frame = getSlot(seqNo)[rx];
+	frame.m_valid = true;
+	frame.m_end   = end;
+
+	// An end packet removes the receiver from all future data
+	if (end) {
+		m_active[rx] = false;
+		return true;
+	}
+
+	if (length < DV_FRAME_LENGTH_BYTES) {
+		frame.m_valid = false;
+		return true;
+	}
+
+	::memcpy(frame.m_data, data, DV_FRAME_LENGTH_BYTES);
+
+	m_fec.unpack(data, frame.m_a, frame.m_b, frame.m_c);
+	frame.m_dataA = m_fec.decodeA(frame.m_a, frame.m_errorsA);
+
+	return true;
+}
+
+DIVERSITY_FRAME CDiversityCombiner::read(unsigned char* data, unsigned int& best)
+{
+	wxASSERT(data != NULL);
+
+	CDiversityFrame* slot = getSlot(m_outSeqNo);
+
+	calculateDelay();
+
+	bool release = m_time >= ((m_outFrame + 1U) * DSTAR_FRAME_TIME_MS + m_delay);
+
+	// Release early once every receiver that keeps up has sent this frame, but not until the
+	// others have had time to send their headers
+	if (!release && m_time >= m_maxDelay) {
+		unsigned int expected = 0U;
+		unsigned int received = 0U;
+
+		for (unsigned int i = 0U; i < m_rxCount; i++) {
+			if (slot[i].m_valid)
+				received++;
+			else if (m_active[i] && !isSlow(i))
+				expected++;
+		}
+
+		release = received > 0U && expected == 0U;
+	}
+
+	if (!release)
+		return DF_NONE;
+
+	DIVERSITY_FRAME type = combine(slot, data, best);
+
+	clearSlot(m_outSeqNo);
+
+	m_outSeqNo++;
+	if (m_outSeqNo >= DIVERSITY_SLOTS)
+		m_outSeqNo = 0U;
+
+	m_outFrame++;
+
+	return type;
+}
+
+void CDiversityCombiner::clock(unsigned int ms)
+{
+	m_time += ms;
+}
+
+unsigned int CDiversityCombiner::getDelay() const
+{
+	return m_delay;
+}
+
+int CDiversityCombiner::getLatency(unsigned int rx) const
+{
+	wxASSERT(rx < m_rxCount);
+
+	return m_latency[rx] >> LATENCY_SHIFT;
+}
+
+// How late a frame is compared to when it was sent, assuming the header was sent just before the first frame
+int CDiversityCombiner::getLate(int frameNo) const
+{
+	return int(m_time) - (frameNo + 1) * int(DSTAR_FRAME_TIME_MS);
+}
+
+CDiversityFrame* CDiversityCombiner::getSlot(unsigned int seqNo) const
+{
+	return m_frames + seqNo * m_rxCount;
+}
+
+void CDiversityCombiner::clearSlot(unsigned int seqNo)
+{
+	CDiversityFrame* slot = getSlot(seqNo);
+
+	for (unsigned int i = 0U; i < m_rxCount; i++) {
+		slot[i].m_valid = false;
+		slot[i].m_end   = false;
+	}
+}
+
+// A receiver whose latency plus twice its jitter is more than the maximum delay is not waited for
+bool CDiversityCombiner::isSlow(unsigned int rx) const
+{
+	if (!m_sampled[rx])
+		return false;
+
+	int delay = (m_latency[rx] >> LATENCY_SHIFT) + (m_jitter[rx] >> (JITTER_SHIFT - 1U));
+
+	return delay > int(m_maxDelay);
+}
+
+void CDiversityCombiner::calculateDelay()
+{
+	bool found = false;
+	int  delay = 0;
+
+	for (unsigned int i = 0U; i < m_rxCount; i++) {
+		if (!m_sampled[i] || isSlow(i))
+			continue;
+
+		int rxDelay = (m_latency[i] >> LATENCY_SHIFT) + (m_jitter[i] >> (JITTER_SHIFT - 1U));
+		if (rxDelay > delay)
+			delay = rxDelay;
+
+		found = true;
+	}
+
+	// Until a receiver has been heard from, wait for as long as allowed
+	m_delay = found ? (unsigned int)delay : m_maxDelay;
+}
+
+DIVERSITY_FRAME CDiversityCombiner::combine(CDiversityFrame* slot, unsigned char* data, unsigned int& best)
+{
+	unsigned int bestA = m_rxCount;
+
+	bool hasEnd   = false;
+	bool hasNoEnd = false;
+
+	for (unsigned int i = 0U; i < m_rxCount; i++) {
+		const CDiversityFrame& frame = slot[i];
+		if (!frame.m_valid)
+			continue;
+
+		if (frame.m_end) {
+			hasEnd = true;
+			continue;
+		}
+
+		hasNoEnd = true;
+
+		if (bestA == m_rxCount || frame.m_errorsA < slot[bestA].m_errorsA)
+			bestA = i;
+	}
+
+	if (hasEnd && !hasNoEnd)
+		return DF_END;
+
+	if (!hasNoEnd)
+		return DF_SILENCE;
+
+	// Every copy of b is unscrambled with the chosen a, a wrong a at one receiver would spoil its b
+	unsigned int dataA = slot[bestA].m_dataA;
+	unsigned int bestB = m_rxCount;
+	unsigned int bestC = m_rxCount;
+
+	for (unsigned int i = 0U; i < m_rxCount; i++) {
+		CDiversityFrame& frame = slot[i];
+		if (!frame.m_valid || frame.m_end)
+			continue;
+
+		frame.m_dataB = m_fec.decodeB(frame.m_b, dataA, frame.m_errorsB);
+
+		if (bestB == m_rxCount || frame.m_errorsB < slot[bestB].m_errorsB)
+			bestB = i;
+
+		if (bestC == m_rxCount || (frame.m_errorsA + frame.m_errorsB) < (slot[bestC].m_errorsA + slot[bestC].m_errorsB))
+			bestC = i;
+	}
+
+	// The unprotected bits and the slow data come from the best receiver overall
+	::memcpy(data, slot[bestC].m_data, DV_FRAME_LENGTH_BYTES);
+
+	m_fec.encode(dataA, slot[bestB].m_dataB, slot[bestC].m_c, data);
+
+	best = bestC;
+
+	return DF_DATA;
+}
@@ -0,0 +1,96 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	DiversityCombiner_H
+#define	DiversityCombiner_H
+
+#include "DStarDefines.h"
+#include "AMBEFEC.h"
+
+#include <wx/wx.h>
+
+const unsigned int DIVERSITY_SLOTS = 21U;
+
+enum DIVERSITY_FRAME {
+	DF_NONE,
+	DF_DATA,
+	DF_SILENCE,
+	DF_END
+};
+
+struct CDiversityFrame {
+	bool          m_valid;
+	bool          m_end;
+	unsigned int  m_a;
+	unsigned int  m_b;
+	unsigned int  m_c;
+	unsigned int  m_dataA;
+	unsigned int  m_errorsA;
+	unsigned int  m_dataB;
+	unsigned int  m_errorsB;
+	unsigned char m_data[DV_FRAME_LENGTH_BYTES];
+};
+
+// Combines the copies of a transmission heard by several receivers. Each Golay codeword is taken from
+// the receiver that has the fewest errors in it. A single playout clock releases the frames, its delay
+// follows the latency of the receivers so that a receiver which is slower than the maximum delay
+// cannot hold up the others.
+class CDiversityCombiner {
+public:
+	CDiversityCombiner(unsigned int rxCount, unsigned int maxDelay);
+	~CDiversityCombiner();
+
+	// Start a new transmission, with no receivers active
+	void            reset();
+
+	void            setActive(unsigned int rx, bool active);
+
+	// Returns false if the frame is too late or out of order
+	bool            write(unsigned int rx, unsigned int seqNo, bool end, const unsigned char* data, unsigned int length);
+
+	// The best receiver is the one that gave the most to the frame
+	DIVERSITY_FRAME read(unsigned char* data, unsigned int& best);
+
+	void            clock(unsigned int ms);
+
+	unsigned int    getDelay() const;
+	int             getLatency(unsigned int rx) const;
+
+private:
+	unsigned int     m_rxCount;
+	unsigned int     m_maxDelay;
+	CAMBEFEC         m_fec;
+	CDiversityFrame* m_frames;
+	bool*            m_active;
+	bool*            m_sampled;
+	int*             m_latency;
+	int*             m_jitter;
+	unsigned int     m_time;
+	unsigned int     m_delay;
+	unsigned int     m_outSeqNo;
+	unsigned int     m_outFrame;
+
+	int              getLate(int frameNo) const;
+	CDiversityFrame* getSlot(unsigned int seqNo) const;
+	void             clearSlot(unsigned int seqNo);
+	bool             isSlow(unsigned int rx) const;
+	void             calculateDelay();
+	DIVERSITY_FRAME  combine(CDiversityFrame* slot, unsigned char* data, unsigned int& best);
+};
+
+#endif
@@ -0,0 +1,196 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "EventPoller.h"
+
+#if defined(__linux__)
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+#if defined(__linux__)
+const unsigned int MAX_EVENTS = 8U;
+#endif
+
+CEventPoller::CEventPoller() :
+#if defined(__linux__)
+m_pollFD(-1),
+m_eventFD(-1),
+m_timerFD(-1)
+#else
+m_semaphore(0, 1)
+#endif
+{
+}
+
+CEventPoller::~CEventPoller()
+{
+	close();
+}
+
+#if defined(__linux__)
+bool CEventPoller::open()
+{
+	m_pollFD = ::epoll_create1(EPOLL_CLOEXEC);
+	if (m_pollFD < 0) {
+		wxLogError(wxT("Cannot create the epoll instance, err: %d"), errno);
+		return false;
+	}
+
+	m_eventFD = ::eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (m_eventFD < 0) {
+		wxLogError(wxT("Cannot create the eventfd, err: %d"), errno);
+		close();
+		return false;
+	}
+
+	m_timerFD = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (m_timerFD < 0) {
+		wxLogError(wxT("Cannot create the timerfd, err: %d"), errno);
+		close();
+		return false;
+	}
+
+	if (!addReader(m_eventFD) || !addReader(m_timerFD)) {
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+bool CEventPoller::addReader(int fd)
+{
+	wxASSERT(m_pollFD >= 0);
+	wxASSERT(fd >= 0);
+
+	epoll_event event;
+	::memset(&event, 0x00, sizeof(epoll_event));
+	event.events  = EPOLLIN;
+	event.data.fd = fd;
+
+	if (::epoll_ctl(m_pollFD, EPOLL_CTL_ADD, fd, &event) < 0) {
+		wxLogError(wxT("Cannot add fd %d to the epoll instance, err: %d"), fd, errno);
+		return false;
+	}
+
+	return true;
+}
+
+void CEventPoller::signal()
+{
+	if (m_eventFD < 0)
+		return;
+
+	uint64_t value = 1U;
+	ssize_t n = ::write(m_eventFD, &value, sizeof(uint64_t));
+	if (n < 0 && errno != EAGAIN)
+		wxLogWarning(wxT("Error writing to the eventfd, err: %d"), errno);
+}
+
+void CEventPoller::wait(unsigned int timeout)
+{
+	wxASSERT(m_pollFD >= 0);
+
+	// The timer is one shot and armed afresh each time, which also clears an expiry not yet read.
+	// A zero timeout would disarm it, so that only looks at what is already pending.
+	if (timeout > 0U) {
+		itimerspec spec;
+		spec.it_interval.tv_sec  = 0;
+		spec.it_interval.tv_nsec = 0L;
+		spec.it_value.tv_sec     = timeout / 1000U;
+		spec.it_value.tv_nsec    = (timeout % 1000U) * 1000000L;
+		if (::timerfd_settime(m_timerFD, 0, &spec, NULL) < 0) {
+			wxLogWarning(wxT("Cannot set the timerfd, err: %d"), errno);
+			return;
+		}
+	}
+
+	epoll_event events[MAX_EVENTS];
+	int n = ::epoll_wait(m_pollFD, events, MAX_EVENTS, (timeout > 0U) ? -1 : 0);
+	if (n < 0) {
+		if (errno != EINTR)
+			wxLogWarning(wxT("Error from epoll_wait, err: %d"), errno);
+		return;
+	}
+
+	// The eventfd and the timerfd are level triggered, read them to clear them. Other descriptors
+	// are left to their owners, except that one which has hung up would wake us forever, so it is
+	// dropped and its owner finds out the next time it uses it.
+	for (int i = 0; i < n; i++) {
+		int fd = events[i].data.fd;
+		if (fd == m_eventFD || fd == m_timerFD) {
+			uint64_t value;
+			ssize_t ret = ::read(fd, &value, sizeof(uint64_t));
+			if (ret < 0 && errno != EAGAIN)
+				wxLogWarning(wxT("Error reading from fd %d, err: %d"), fd, errno);
+		} else if ((events[i].events & EPOLLHUP) == EPOLLHUP) {
+			wxLogWarning(wxT("Fd %d has hung up, no longer waiting on it"), fd);
+			::epoll_ctl(m_pollFD, EPOLL_CTL_DEL, fd, NULL);
+		}
+	}
+}
+
+void CEventPoller::close()
+{
+	if (m_timerFD >= 0) {
+		::close(m_timerFD);
+		m_timerFD = -1;
+	}
+
+	if (m_eventFD >= 0) {
+		::close(m_eventFD);
+		m_eventFD = -1;
+	}
+
+	if (m_pollFD >= 0) {
+		::close(m_pollFD);
+		m_pollFD = -1;
+	}
+}
+#else
+bool CEventPoller::open()
+{
+	return true;
+}
+
+bool CEventPoller::addReader(int)
+{
+	return false;
+}
+
+void CEventPoller::signal()
+{
+	m_semaphore.Post();
+}
+
+void CEventPoller::wait(unsigned int timeout)
+{
+	if (timeout > 0U)
+		m_semaphore.WaitTimeout(timeout);
+	else
+		m_semaphore.TryWait();
+}
+
+void CEventPoller::close()
+{
+}
+#endif
@@ -0,0 +1,53 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	EventPoller_H
+#define	EventPoller_H
+
+#include <wx/wx.h>
+
+// Wakes a thread as soon as another thread signals it, a registered descriptor becomes readable,
+// or the timeout given to wait() passes. Under Linux this is epoll with an eventfd and a one shot
+// timerfd, elsewhere only the signal and the timeout are available.
+class CEventPoller {
+public:
+	CEventPoller();
+	~CEventPoller();
+
+	bool open();
+
+	bool addReader(int fd);
+
+	void signal();
+
+	// The timeout is in milliseconds, normally the time to the caller's next deadline
+	void wait(unsigned int timeout);
+
+	void close();
+
+private:
+#if defined(__linux__)
+	int          m_pollFD;
+	int          m_eventFD;
+	int          m_timerFD;
+#else
+	wxSemaphore  m_semaphore;
+#endif
+};
+
+#endif
@@ -0,0 +1,145 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "EventTrace.h"
+#include "Utils.h"
+
+#if defined(__WINDOWS__)
+#include <wx/ffile.h>
+#else
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+
+CEventTrace::CEventTrace(const wxString& fileName, unsigned int length) :
+m_fileName(fileName),
+m_length(length),
+m_header(NULL),
+m_records(NULL),
+m_size(0U)
+#if !defined(__WINDOWS__)
+,m_fd(-1)
+#endif
+{
+	wxASSERT(length > 0U);
+
+	m_size = sizeof(CTraceHeader) + m_length * sizeof(CTraceRecord);
+}
+
+CEventTrace::~CEventTrace()
+{
+	close();
+}
+
+bool CEventTrace::open()
+{
+#if defined(__WINDOWS__)
+	// There is no mapping here, the ring is only written to the file when it is closed
+	m_header = (CTraceHeader*)new unsigned char[m_size];
+#else
+	m_fd = ::open(m_fileName.mb_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (m_fd < 0) {
+		wxLogError(wxT("Cannot open the trace file %s, errno=%d"), m_fileName.c_str(), errno);
+		return false;
+	}
+
+	if (::ftruncate(m_fd, m_size) < 0) {
+		wxLogError(wxT("Cannot size the trace file %s, errno=%d"), m_fileName.c_str(), errno);
+		::close(m_fd);
+		m_fd = -1;
+		return false;
+	}
+
+	void* map = ::mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+	if (map == MAP_FAILED) {
+		wxLogError(wxT("Cannot map the trace file %s, errno=%d"), m_fileName.c_str(), errno);
+		::close(m_fd);
+		m_fd = -1;
+		return false;
+	}
+
+	m_header = (CTraceHeader*)map;
+#endif
+
+	m_records = (CTraceRecord*)(m_header + 1);
+
+	::memset(m_header, 0x00U, m_size);
+
+	::memcpy(m_header->m_magic, TRACE_MAGIC, 8U);
+	m_header->m_version = TRACE_VERSION;
+	m_header->m_length  = m_length;
+	m_header->m_count   = 0U;
+	m_header->m_clock   = CUtils::getTimestamp();
+	m_header->m_time    = wxUint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+
+	wxLogInfo(wxT("Tracing %u events into %s"), m_length, m_fileName.c_str());
+
+	return true;
+}
+
+void CEventTrace::write(TRACE_EVENT event, unsigned int arg1, unsigned int arg2, unsigned int arg3)
+{
+	if (m_header == NULL)
+		return;
+
+	wxUint64 count = m_header->m_count;
+
+	CTraceRecord& record = m_records[count % m_length];
+	record.m_timestamp = CUtils::getTimestamp();
+	record.m_event     = wxUint8(event);
+	record.m_arg1      = wxUint8(arg1);
+	record.m_arg2      = wxUint16(arg2);
+	record.m_arg3      = wxUint32(arg3);
+
+	// The record must be complete before a reader of the live file can see it
+	std::atomic_thread_fence(std::memory_order_release);
+
+	m_header->m_count = count + 1U;
+}
+
+void CEventTrace::close()
+{
+	if (m_header == NULL)
+		return;
+
+#if defined(__WINDOWS__)
+	wxFFile file;
+	if (file.Open(m_fileName, wxT("wb"))) {
+		file.Write(m_header, m_size);
+		file.Close();
+	} else {
+		wxLogError(wxT("Cannot open the trace file %s"), m_fileName.c_str());
+	}
+
+	delete[] (unsigned char*)m_header;
+#else
+	::munmap(m_header, m_size);
+	::close(m_fd);
+	m_fd = -1;
+#endif
+
+	m_header  = NULL;
+	m_records = NULL;
+}
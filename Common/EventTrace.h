@@ -0,0 +1,92 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	EventTrace_H
+#define	EventTrace_H
+
+#include <wx/wx.h>
+
+const char         TRACE_MAGIC[]  = "DSRTRACE";
+const unsigned int TRACE_VERSION  = 1U;
+
+enum TRACE_EVENT {
+	TE_NONE,
+	TE_RPT_STATE,		// arg1 = new state, arg2 = old state
+	TE_RX_STATE,		// arg1 = new state, arg2 = old state
+	TE_MODEM_READ,		// arg1 = DSMT_TYPE
+	TE_NETWORK_READ,	// arg1 = NETWORK_TYPE, arg2 = sequence number, arg3 = length
+	TE_SILENCE,			// arg1 = TRACE_SILENCE, arg2 = sequence number, arg3 = frames
+	TE_QUEUE			// arg1 = TRACE_QUEUE, arg3 = bytes
+};
+
+enum TRACE_SILENCE {
+	TS_MISSING,			// Not there when due, a filler was played
+	TS_LATE				// Arrived after its turn, dropped
+};
+
+enum TRACE_QUEUE {
+	TQ_MODEM_SPACE,
+	TQ_RADIO,
+	TQ_LOCAL,
+	TQ_NETWORK
+};
+
+// The file is this header followed by the ring of records. The timestamps are from CUtils::getTimestamp()
+// and m_clock/m_time tie them to the wall clock.
+struct CTraceHeader {
+	char     m_magic[8U];
+	wxUint32 m_version;
+	wxUint32 m_length;		// Records in the ring
+	wxUint64 m_count;		// Records ever written, the next one goes at m_count % m_length
+	wxUint64 m_clock;		// Microseconds from CUtils::getTimestamp()
+	wxUint64 m_time;		// The same moment in microseconds since 1970
+};
+
+struct CTraceRecord {
+	wxUint64 m_timestamp;
+	wxUint8  m_event;
+	wxUint8  m_arg1;
+	wxUint16 m_arg2;
+	wxUint32 m_arg3;
+};
+
+// A ring of fixed size binary records kept in a memory mapped file, so that the last few minutes survive
+// a crash and can be read with dstarrepeatertrace. Only one thread may write to it.
+class CEventTrace {
+public:
+	CEventTrace(const wxString& fileName, unsigned int length);
+	~CEventTrace();
+
+	bool open();
+
+	void write(TRACE_EVENT event, unsigned int arg1 = 0U, unsigned int arg2 = 0U, unsigned int arg3 = 0U);
+
+	void close();
+
+private:
+	wxString      m_fileName;
+	unsigned int  m_length;
+	CTraceHeader* m_header;
+	CTraceRecord* m_records;
+	size_t        m_size;
+#if !defined(__WINDOWS__)
+	int           m_fd;
+#endif
+};
+
+#endif
@@ -12,6 +12,7 @@
  */
 
 #include "ExternalController.h"
+#include "Logger.h"
 
 #include "DStarDefines.h"
 
@@ -54,6 +55,8 @@ bool CExternalController::open()
 
 void* CExternalController::Entry()
 {
+	CLogger::startThread();
+
 	wxASSERT(m_controller != NULL);
 
 	bool dummy1, dummy2, dummy3, dummy4;
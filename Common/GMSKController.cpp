@@ -17,6 +17,7 @@
  */
 
 #include "GMSKController.h"
+#include "Logger.h"
 #if defined(__WINDOWS__)
 #include "GMSKModemWinUSB.h"
 #endif
@@ -82,9 +83,15 @@ bool CGMSKController::start()
 
 void* CGMSKController::Entry()
 {
+	CLogger::startThread();
+
 	wxLogMessage(wxT("Starting GMSK Modem Controller thread"));
 
+#if defined(WIN32)
 	CTimer hdrTimer(1000U, 0U, 100U);
+#else
+	CTimer hdrTimer(1000U, 0U, CYCLE_TIME);
+#endif
 	hdrTimer.start();
 
 	CTimer dataTimer(1000U, 0U, 100U);
@@ -113,12 +120,7 @@ void* CGMSKController::Entry()
 					// CUtils::dump(wxT("Read Data"), buffer, ret);
 
 					if (end) {
-						wxMutexLocker locker(m_mutex);
-
-						unsigned char data[2U];
-						data[0U] = DSMTT_EOT;
-						data[1U] = 0U;
-						m_rxData.addData(data, 2U);
+						writeRX(DSMTT_EOT);
 
 						hdrTimer.start();
 						readLength = 0U;
@@ -129,14 +131,7 @@ void* CGMSKController::Entry()
 
 							readLength++;
 							if (readLength >= DV_FRAME_LENGTH_BYTES) {
-								wxMutexLocker locker(m_mutex);
-
-								unsigned char data[2U];
-								data[0U] = DSMTT_DATA;
-								data[1U] = DV_FRAME_LENGTH_BYTES;
-								m_rxData.addData(data, 2U);
-
-								m_rxData.addData(readBuffer, DV_FRAME_LENGTH_BYTES);
+								writeRX(DSMTT_DATA, readBuffer, DV_FRAME_LENGTH_BYTES);
 								readLength = 0U;
 							}
 						}
@@ -147,21 +142,14 @@ void* CGMSKController::Entry()
 						break;
 				}
 			} else {
-				// Check for a header every 100ms or so
+				// Check for a header every 100ms or so, or every cycle under Linux where the modem is polled in the background
 				if (hdrTimer.isRunning() && hdrTimer.hasExpired()) {
 					unsigned char buffer[90U];
 					bool ret = m_modem->readHeader(buffer, 90U);
 					if (ret) {
 						// CUtils::dump(wxT("Read Header"), buffer, RADIO_HEADER_LENGTH_BYTES);
 
-						wxMutexLocker locker(m_mutex);
-
-						unsigned char data[2U];
-						data[0U] = DSMTT_HEADER;
-						data[1U] = RADIO_HEADER_LENGTH_BYTES - 2U;
-						m_rxData.addData(data, 2U);
-
-						m_rxData.addData(buffer, RADIO_HEADER_LENGTH_BYTES - 2U);
+						writeRX(DSMTT_HEADER, buffer, RADIO_HEADER_LENGTH_BYTES - 2U);
 
 						hdrTimer.stop();
 						readLength = 0U;
@@ -176,8 +164,6 @@ void* CGMSKController::Entry()
 		// Only transmit when not receiving or when in duplex mode
 		if (!rx || m_duplex) {
 			if (writeLength == 0U && m_txData.hasData()) {
-				wxMutexLocker locker(m_mutex);
-
 				unsigned char type = DSMTT_NONE;
 				m_txData.getData(&type, 1U);
 				writeType = DSMT_TYPE(type);
@@ -274,40 +260,12 @@ bool CGMSKController::writeHeader(const CHeaderData& header)
 
 	unsigned char buffer[50U];
 
-	::memset(buffer, ' ', RADIO_HEADER_LENGTH_BYTES - 2U);
-
-	buffer[0U] = header.getFlag1();
-	buffer[1U] = header.getFlag2();
-	buffer[2U] = header.getFlag3();
-
-	wxString rpt2 = header.getRptCall2();
-	for (unsigned int i = 0U; i < rpt2.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 3U]  = rpt2.GetChar(i);
-
-	wxString rpt1 = header.getRptCall1();
-	for (unsigned int i = 0U; i < rpt1.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 11U] = rpt1.GetChar(i);
-
-	wxString your = header.getYourCall();
-	for (unsigned int i = 0U; i < your.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 19U] = your.GetChar(i);
-
-	wxString my1 = header.getMyCall1();
-	for (unsigned int i = 0U; i < my1.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 27U] = my1.GetChar(i);
-
-	wxString my2 = header.getMyCall2();
-	for (unsigned int i = 0U; i < my2.Len() && i < SHORT_CALLSIGN_LENGTH; i++)
-		buffer[i + 35U] = my2.GetChar(i);
-
-	wxMutexLocker locker(m_mutex);
+	header.getData(buffer, RADIO_HEADER_LENGTH_BYTES - 2U, false);
 
 	unsigned char data[2U];
 	data[0U] = DSMTT_HEADER;
 	data[1U] = RADIO_HEADER_LENGTH_BYTES - 2U;
-	m_txData.addData(data, 2U);
-
-	m_txData.addData(buffer, RADIO_HEADER_LENGTH_BYTES - 2U);
+	m_txData.addData(data, 2U, buffer, RADIO_HEADER_LENGTH_BYTES - 2U);
 
 	return true;
 }
@@ -320,14 +278,10 @@ bool CGMSKController::writeData(const unsigned char* data, unsigned int, bool en
 		return false;
 	}
 
-	wxMutexLocker locker(m_mutex);
-
 	unsigned char buffer[2U];
 	buffer[0U] = end ? DSMTT_EOT : DSMTT_DATA;
 	buffer[1U] = DV_FRAME_LENGTH_BYTES;
-	m_txData.addData(buffer, 2U);
-
-	m_txData.addData(data, DV_FRAME_LENGTH_BYTES);
+	m_txData.addData(buffer, 2U, data, DV_FRAME_LENGTH_BYTES);
 
 	return true;
 }
@@ -357,9 +311,7 @@ bool CGMSKController::reopenModem()
 			return true;
 
 		// Reset the drivers state
-		m_mutex.Lock();
 		m_txData.clear();
-		m_mutex.Unlock();
 
 		m_tx = false;
 
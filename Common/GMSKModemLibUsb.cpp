@@ -46,6 +46,9 @@ const char PTT_OnOff  = 0x20;
 const int PTT_ON  = 1;
 const int PTT_OFF = 0;
 
+// How often a transfer is tried before it is given up
+const unsigned int USB_TRIES = 4U;
+
 #if defined(WIN32)
 const wxString LIBNAME = wxT("libusb0");
 
@@ -78,6 +81,13 @@ m_address(address),
 m_context(NULL),
 #endif
 m_dev(NULL),
+#if !defined(WIN32)
+m_header(NULL),
+m_headerBusy(false),
+m_headerDone(false),
+m_writes(),
+m_writeError(0),
+#endif
 m_brokenSpace(false)
 {
 
@@ -122,6 +132,18 @@ m_brokenSpace(false)
 	m_loaded = true;
 #else
 	::libusb_init(&m_context);
+
+	m_header = ::libusb_alloc_transfer(0);
+	m_header->buffer = new unsigned char[LIBUSB_CONTROL_SETUP_SIZE + GMSK_MODEM_DATA_LENGTH];
+
+	for (unsigned int i = 0U; i < GMSK_MODEM_WRITES; i++) {
+		m_writes[i].m_modem    = this;
+		m_writes[i].m_transfer = ::libusb_alloc_transfer(0);
+		m_writes[i].m_transfer->buffer = new unsigned char[LIBUSB_CONTROL_SETUP_SIZE + GMSK_MODEM_DATA_LENGTH];
+		m_writes[i].m_name     = NULL;
+		m_writes[i].m_tries    = 0U;
+		m_writes[i].m_busy     = false;
+	}
 #endif
 }
 
@@ -130,6 +152,17 @@ CGMSKModemLibUsb::~CGMSKModemLibUsb()
 {
 #if !defined(WIN32)
 	wxASSERT(m_context != NULL);
+
+	delete[] m_header->buffer;
+	m_header->buffer = NULL;
+	::libusb_free_transfer(m_header);
+
+	for (unsigned int i = 0U; i < GMSK_MODEM_WRITES; i++) {
+		delete[] m_writes[i].m_transfer->buffer;
+		m_writes[i].m_transfer->buffer = NULL;
+		::libusb_free_transfer(m_writes[i].m_transfer);
+	}
+
 	::libusb_exit(m_context);
 #endif
 }
@@ -189,6 +222,17 @@ bool CGMSKModemLibUsb::readHeader(unsigned char* header, unsigned int length)
 
 	unsigned int offset = 0U;
 
+#if !defined(WIN32)
+	// Don't wait for the modem until the poll has found the start of a header
+	int first = pollHeader(header);
+	if (first < 0)
+		::libUsbLogError(first, "GET_HEADER");
+	if (first <= 0)
+		return false;
+
+	offset = first;
+#endif
+
 	while (offset < RADIO_HEADER_LENGTH_BYTES) {
 		int ret = io(0xC0, GET_HEADER, 0, 0, (header + offset), 8, USB_TIMEOUT);
 		if (ret < 0) {
@@ -276,12 +320,27 @@ void CGMSKModemLibUsb::writeHeader(unsigned char* header, unsigned int length)
 	wxASSERT(header != NULL);
 	wxASSERT(length >= (RADIO_HEADER_LENGTH_BYTES - 2U));
 
+#if !defined(WIN32)
+	// The PTT that follows needs a place as well
+	if (getWriteSpace() < 7U) {
+		wxLogWarning(wxT("No space to write the header to the GMSK modem"));
+		return;
+	}
+
+	submitWrite(SET_MyCALL2,  0, (header + 35U), SHORT_CALLSIGN_LENGTH, "SET_MyCALL2");
+	submitWrite(SET_MyCALL,   0, (header + 27U), LONG_CALLSIGN_LENGTH,  "SET_MyCALL");
+	submitWrite(SET_YourCALL, 0, (header + 19U), LONG_CALLSIGN_LENGTH,  "SET_YourCALL");
+	submitWrite(SET_RPT1CALL, 0, (header + 11U), LONG_CALLSIGN_LENGTH,  "SET_RPT1CALL");
+	submitWrite(SET_RPT2CALL, 0, (header + 3U),  LONG_CALLSIGN_LENGTH,  "SET_RPT2CALL");
+	submitWrite(SET_FLAGS,    0, (header + 0U),  3U, "SET_FLAGS");
+#else
 	io(0x40, SET_MyCALL2,  0, 0, (header + 35U), SHORT_CALLSIGN_LENGTH, USB_TIMEOUT);
 	io(0x40, SET_MyCALL,   0, 0, (header + 27U), LONG_CALLSIGN_LENGTH,  USB_TIMEOUT);
 	io(0x40, SET_YourCALL, 0, 0, (header + 19U), LONG_CALLSIGN_LENGTH,  USB_TIMEOUT);
 	io(0x40, SET_RPT1CALL, 0, 0, (header + 11U), LONG_CALLSIGN_LENGTH,  USB_TIMEOUT);
 	io(0x40, SET_RPT2CALL, 0, 0, (header + 3U),  LONG_CALLSIGN_LENGTH,  USB_TIMEOUT);
 	io(0x40, SET_FLAGS,    0, 0, (header + 0U),  3U, USB_TIMEOUT);
+#endif
 }
 
 TRISTATE CGMSKModemLibUsb::hasSpace()
@@ -317,6 +376,13 @@ TRISTATE CGMSKModemLibUsb::getPTT()
 void CGMSKModemLibUsb::setPTT(bool on)
 {
 	unsigned char c;
+#if !defined(WIN32)
+	// With no room left it is sent at once, and still goes over the pipe behind the writes before it
+	if (getWriteSpace() > 0U) {
+		submitWrite(SET_PTT, on ? PTT_ON : PTT_OFF, &c, 0, "SET_PTT");
+		return;
+	}
+#endif
 	io(0x40, SET_PTT, on ? PTT_ON : PTT_OFF, 0, &c, 0, USB_TIMEOUT);
 }
 
@@ -325,6 +391,28 @@ int CGMSKModemLibUsb::writeData(unsigned char* data, unsigned int length)
 	wxASSERT(data != NULL);
 	wxASSERT(length > 0U && length <= DV_FRAME_LENGTH_BYTES);
 
+#if !defined(WIN32)
+	if (m_writeError < 0) {
+		::libUsbLogError(m_writeError, "PUT_DATA");
+		return m_writeError;
+	}
+
+	// Both halves go, or neither does and the frame is tried again later
+	if (length > GMSK_MODEM_DATA_LENGTH) {
+		if (getWriteSpace() < 2U)
+			return 0;
+
+		submitWrite(PUT_DATA, 0, data, GMSK_MODEM_DATA_LENGTH, "PUT_DATA 1");
+		submitWrite(PUT_DATA, 0, (data + GMSK_MODEM_DATA_LENGTH), length - GMSK_MODEM_DATA_LENGTH, "PUT_DATA 2");
+	} else {
+		if (getWriteSpace() < 1U)
+			return 0;
+
+		submitWrite(PUT_DATA, 0, data, length, "PUT_DATA");
+	}
+
+	return length;
+#else
 	if (length > GMSK_MODEM_DATA_LENGTH) {
 		int ret = io(0x40, PUT_DATA, 0, 0, data, GMSK_MODEM_DATA_LENGTH, USB_TIMEOUT);
 		if (ret < 0) {
@@ -363,6 +451,7 @@ int CGMSKModemLibUsb::writeData(unsigned char* data, unsigned int length)
 
 		return length;
 	}
+#endif
 }
 
 void CGMSKModemLibUsb::close()
@@ -372,6 +461,17 @@ void CGMSKModemLibUsb::close()
 #if defined(WIN32)
 	m_usbClose(m_dev);
 #else
+	if (m_headerBusy)
+		::libusb_cancel_transfer(m_header);
+
+	// The writes are left to finish, so that the PTT is turned off. Each has a timeout, so this doesn't
+	// wait for long.
+	while (m_headerBusy || isWriting())
+		handleEvents(USB_TIMEOUT);
+
+	m_headerDone = false;
+	m_writeError = 0;
+
 	libusb_close(m_dev);
 #endif
 	m_dev = NULL;
@@ -424,7 +524,7 @@ int CGMSKModemLibUsb::io(uint8_t requestType, uint8_t request, uint16_t value,
 	wxASSERT(data != NULL);
 
 	int ret = 0;
-	for (unsigned int i = 0U; i < 4U; i++) {
+	for (unsigned int i = 0U; i < USB_TRIES; i++) {
 #if defined(WIN32)
 		ret = m_usbControlMsg(m_dev, requestType, request, value, index, data, length, timeout);
 #else
@@ -441,3 +541,161 @@ int CGMSKModemLibUsb::io(uint8_t requestType, uint8_t request, uint16_t value,
 
 	return ret;
 }
+
+#if !defined(WIN32)
+// Returns the start of a header once a poll has found one, the modem is polled again otherwise
+int CGMSKModemLibUsb::pollHeader(unsigned char* data)
+{
+	wxASSERT(m_dev != NULL);
+	wxASSERT(data != NULL);
+
+	if (m_headerBusy)
+		handleEvents(0U);
+
+	if (m_headerBusy)
+		return 0;
+
+	int ret = 0;
+
+	if (m_headerDone) {
+		m_headerDone = false;
+
+		switch (m_header->status) {
+			case LIBUSB_TRANSFER_COMPLETED:
+				ret = m_header->actual_length;
+				::memcpy(data, ::libusb_control_transfer_get_data(m_header), ret);
+				break;
+			case LIBUSB_TRANSFER_NO_DEVICE:
+				return -19;		// -ENODEV
+			default:
+				break;
+		}
+	}
+
+	if (ret > 0)
+		return ret;
+
+	::libusb_fill_control_setup(m_header->buffer, 0xC0, GET_HEADER, 0, 0, GMSK_MODEM_DATA_LENGTH);
+	::libusb_fill_control_transfer(m_header, m_dev, m_header->buffer, headerCallback, this, USB_TIMEOUT);
+
+	int err = ::libusb_submit_transfer(m_header);
+	if (err < 0)
+		return err;
+
+	m_headerBusy = true;
+
+	return 0;
+}
+
+void CGMSKModemLibUsb::handleEvents(unsigned int timeout)
+{
+	timeval tv;
+	tv.tv_sec  = timeout / 1000U;
+	tv.tv_usec = (timeout % 1000U) * 1000U;
+
+	::libusb_handle_events_timeout_completed(m_context, &tv, NULL);
+}
+
+void LIBUSB_CALL CGMSKModemLibUsb::headerCallback(libusb_transfer* transfer)
+{
+	CGMSKModemLibUsb* modem = (CGMSKModemLibUsb*)transfer->user_data;
+
+	modem->m_headerBusy = false;
+	modem->m_headerDone = true;
+}
+
+// Picks up the writes that have finished, and returns how many more can be made
+unsigned int CGMSKModemLibUsb::getWriteSpace()
+{
+	if (isWriting())
+		handleEvents(0U);
+
+	unsigned int space = 0U;
+	for (unsigned int i = 0U; i < GMSK_MODEM_WRITES; i++) {
+		if (!m_writes[i].m_busy)
+			space++;
+	}
+
+	return space;
+}
+
+// There must be space for the write, it is copied so the data can be reused at once
+void CGMSKModemLibUsb::submitWrite(uint8_t request, uint16_t value, unsigned char* data, uint16_t length, const char* name)
+{
+	wxASSERT(m_dev != NULL);
+	wxASSERT(data != NULL);
+	wxASSERT(length <= GMSK_MODEM_DATA_LENGTH);
+
+	CGMSKWrite* write = NULL;
+	for (unsigned int i = 0U; i < GMSK_MODEM_WRITES && write == NULL; i++) {
+		if (!m_writes[i].m_busy)
+			write = m_writes + i;
+	}
+
+	wxASSERT(write != NULL);
+
+	libusb_transfer* transfer = write->m_transfer;
+
+	::libusb_fill_control_setup(transfer->buffer, 0x40, request, value, 0, length);
+	::memcpy(transfer->buffer + LIBUSB_CONTROL_SETUP_SIZE, data, length);
+	::libusb_fill_control_transfer(transfer, m_dev, transfer->buffer, writeCallback, write, USB_TIMEOUT);
+
+	write->m_name  = name;
+	write->m_tries = 1U;
+
+	int err = ::libusb_submit_transfer(transfer);
+	if (err < 0) {
+		::libUsbLogError(err, name);
+
+		if (err == -19)			// -ENODEV
+			m_writeError = err;
+
+		return;
+	}
+
+	write->m_busy = true;
+}
+
+bool CGMSKModemLibUsb::isWriting() const
+{
+	for (unsigned int i = 0U; i < GMSK_MODEM_WRITES; i++) {
+		if (m_writes[i].m_busy)
+			return true;
+	}
+
+	return false;
+}
+
+void LIBUSB_CALL CGMSKModemLibUsb::writeCallback(libusb_transfer* transfer)
+{
+	CGMSKWrite* write = (CGMSKWrite*)transfer->user_data;
+
+	switch (transfer->status) {
+		case LIBUSB_TRANSFER_COMPLETED:
+		case LIBUSB_TRANSFER_CANCELLED:
+			break;
+
+		case LIBUSB_TRANSFER_NO_DEVICE:
+			write->m_modem->m_writeError = -19;		// -ENODEV
+			break;
+
+		default:
+			// Tried as often as io() would, it goes behind anything written since
+			if (write->m_tries < USB_TRIES) {
+				write->m_tries++;
+
+				int err = ::libusb_submit_transfer(transfer);
+				if (err == 0)
+					return;
+
+				::libUsbLogError(err, write->m_name);
+				break;
+			}
+
+			::libUsbLogError(transfer->status == LIBUSB_TRANSFER_TIMED_OUT ? LIBUSB_ERROR_TIMEOUT : LIBUSB_ERROR_IO, write->m_name);
+			break;
+	}
+
+	write->m_busy = false;
+}
+#endif
@@ -35,6 +35,21 @@
 #include <libusb-1.0/libusb.h>
 #endif
 
+#if !defined(WIN32)
+// The most writes that can be in flight at once, a header and its PTT take seven
+const unsigned int GMSK_MODEM_WRITES = 16U;
+
+class CGMSKModemLibUsb;
+
+struct CGMSKWrite {
+	CGMSKModemLibUsb* m_modem;
+	libusb_transfer*  m_transfer;
+	const char*       m_name;
+	unsigned int      m_tries;
+	bool              m_busy;
+};
+#endif
+
 class CGMSKModemLibUsb : public IGMSKModem {
 public:
 	CGMSKModemLibUsb(unsigned int address);
@@ -79,6 +94,25 @@ private:
 	libusb_context*          m_context;
 	libusb_device_handle*    m_dev;
 
+	// A poll for a header is kept in flight, it is completed by libusb_handle_events
+	libusb_transfer*         m_header;
+	bool                     m_headerBusy;
+	bool                     m_headerDone;
+
+	// The writes are submitted as they are made and go over the control pipe in order. One that fails is
+	// submitted again from its callback, and a missing device is returned by the next writeData().
+	CGMSKWrite               m_writes[GMSK_MODEM_WRITES];
+	int                      m_writeError;
+
+	static void LIBUSB_CALL  headerCallback(libusb_transfer* transfer);
+	static void LIBUSB_CALL  writeCallback(libusb_transfer* transfer);
+
+	int  pollHeader(unsigned char* data);
+	void handleEvents(unsigned int timeout);
+
+	unsigned int getWriteSpace();
+	void         submitWrite(uint8_t request, uint16_t value, unsigned char* data, uint16_t length, const char* name);
+	bool         isWriting() const;
 #endif
 	int io(uint8_t requestType, uint8_t request, uint16_t value, uint16_t index, unsigned char* data, uint16_t length, unsigned int timeout);
 
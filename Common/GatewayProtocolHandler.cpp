@@ -47,7 +47,7 @@ bool CGatewayProtocolHandler::open()
 	return m_socket.open();
 }
 
-bool CGatewayProtocolHandler::writeHeader(const unsigned char* header, wxUint16 id, const in_addr& address, unsigned int port)
+bool CGatewayProtocolHandler::writeHeader(const unsigned char* header, wxUint16 id, const in_addr* addresses, const unsigned int* ports, unsigned int count)
 {
 	unsigned char buffer[50U];
 
@@ -75,7 +75,7 @@ bool CGatewayProtocolHandler::writeHeader(const unsigned char* header, wxUint16
 #endif
 
 	for (unsigned int i = 0U; i < 4U; i++) {
-		bool ret = m_socket.write(buffer, 49U, address, port);
+		bool ret = m_socket.write(buffer, 49U, addresses, ports, count);
 		if (!ret)
 			return false;
 	}
@@ -83,7 +83,7 @@ bool CGatewayProtocolHandler::writeHeader(const unsigned char* header, wxUint16
 	return true;
 }
 
-bool CGatewayProtocolHandler::writeData(const unsigned char* data, unsigned int length, wxUint16 id, wxUint8 seqNo, const in_addr& address, unsigned int port)
+bool CGatewayProtocolHandler::writeData(const unsigned char* data, unsigned int length, wxUint16 id, wxUint8 seqNo, const in_addr* addresses, const unsigned int* ports, unsigned int count)
 {
 	wxASSERT(data != NULL);
 	wxASSERT(length == DV_FRAME_LENGTH_BYTES || length == DV_FRAME_MAX_LENGTH_BYTES);
@@ -110,7 +110,7 @@ bool CGatewayProtocolHandler::writeData(const unsigned char* data, unsigned int
 	CUtils::dump(wxT("Sending Data"), buffer, length + 9U);
 #endif
 
-	return m_socket.write(buffer, length + 9U, address, port);
+	return m_socket.write(buffer, length + 9U, addresses, ports, count);
 }
 
 NETWORK_TYPE CGatewayProtocolHandler::read(wxUint16& id, in_addr& address, unsigned int& port)
@@ -32,8 +32,9 @@ public:
 
 	bool open();
 
-	bool writeHeader(const unsigned char* header, wxUint16 id, const in_addr& address, unsigned int port);
-	bool writeData(const unsigned char* data, unsigned int length, wxUint16 id, wxUint8 seqNo, const in_addr& address, unsigned int port);
+	// Each frame is sent to all count destinations at once
+	bool writeHeader(const unsigned char* header, wxUint16 id, const in_addr* addresses, const unsigned int* ports, unsigned int count);
+	bool writeData(const unsigned char* data, unsigned int length, wxUint16 id, wxUint8 seqNo, const in_addr* addresses, const unsigned int* ports, unsigned int count);
 
 	NETWORK_TYPE read(wxUint16& id, in_addr& address, unsigned int& port);
 	unsigned int readHeader(unsigned char* data, unsigned int length);
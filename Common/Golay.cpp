@@ -1036,34 +1036,424 @@ static const unsigned int DECODING_TABLE_23127[] = {
 	0x403000U, 0x080840U, 0x100044U, 0x011008U, 0x022800U, 0x004110U, 0x100040U, 0x100041U, 0x100042U, 0x440020U, 
 	0x011001U, 0x011000U, 0x080420U, 0x011002U, 0x100048U, 0x011004U, 0x204200U, 0x028080U};
 
-#define X22             0x00400000   /* vector representation of X^{22} */
-#define X11             0x00000800   /* vector representation of X^{11} */
-#define MASK12          0xfffff800   /* auxiliary vector for testing */
-#define GENPOL          0x00000c75   /* generator polinomial, g(x) */
+// The syndromes of the top twelve bits of a codeword, from the generator polynomial 0xC75
+static const unsigned int SYNDROME_TABLE_23127[] = {
+	0x000U, 0x475U, 0x49FU, 0x0EAU, 0x54BU, 0x13EU, 0x1D4U, 0x5A1U, 0x6E3U, 0x296U,
+	0x27CU, 0x609U, 0x3A8U, 0x7DDU, 0x737U, 0x342U, 0x1B3U, 0x5C6U, 0x52CU, 0x159U,
+	0x4F8U, 0x08DU, 0x067U, 0x412U, 0x750U, 0x325U, 0x3CFU, 0x7BAU, 0x21BU, 0x66EU,
+	0x684U, 0x2F1U, 0x366U, 0x713U, 0x7F9U, 0x38CU, 0x62DU, 0x258U, 0x2B2U, 0x6C7U,
+	0x585U, 0x1F0U, 0x11AU, 0x56FU, 0x0CEU, 0x4BBU, 0x451U, 0x024U, 0x2D5U, 0x6A0U,
+	0x64AU, 0x23FU, 0x79EU, 0x3EBU, 0x301U, 0x774U, 0x436U, 0x043U, 0x0A9U, 0x4DCU,
+	0x17DU, 0x508U, 0x5E2U, 0x197U, 0x6CCU, 0x2B9U, 0x253U, 0x626U, 0x387U, 0x7F2U,
+	0x718U, 0x36DU, 0x02FU, 0x45AU, 0x4B0U, 0x0C5U, 0x564U, 0x111U, 0x1FBU, 0x58EU,
+	0x77FU, 0x30AU, 0x3E0U, 0x795U, 0x234U, 0x641U, 0x6ABU, 0x2DEU, 0x19CU, 0x5E9U,
+	0x503U, 0x176U, 0x4D7U, 0x0A2U, 0x048U, 0x43DU, 0x5AAU, 0x1DFU, 0x135U, 0x540U,
+	0x0E1U, 0x494U, 0x47EU, 0x00BU, 0x349U, 0x73CU, 0x7D6U, 0x3A3U, 0x602U, 0x277U,
+	0x29DU, 0x6E8U, 0x419U, 0x06CU, 0x086U, 0x4F3U, 0x152U, 0x527U, 0x5CDU, 0x1B8U,
+	0x2FAU, 0x68FU, 0x665U, 0x210U, 0x7B1U, 0x3C4U, 0x32EU, 0x75BU, 0x1EDU, 0x598U,
+	0x572U, 0x107U, 0x4A6U, 0x0D3U, 0x039U, 0x44CU, 0x70EU, 0x37BU, 0x391U, 0x7E4U,
+	0x245U, 0x630U, 0x6DAU, 0x2AFU, 0x05EU, 0x42BU, 0x4C1U, 0x0B4U, 0x515U, 0x160U,
+	0x18AU, 0x5FFU, 0x6BDU, 0x2C8U, 0x222U, 0x657U, 0x3F6U, 0x783U, 0x769U, 0x31CU,
+	0x28BU, 0x6FEU, 0x614U, 0x261U, 0x7C0U, 0x3B5U, 0x35FU, 0x72AU, 0x468U, 0x01DU,
+	0x0F7U, 0x482U, 0x123U, 0x556U, 0x5BCU, 0x1C9U, 0x338U, 0x74DU, 0x7A7U, 0x3D2U,
+	0x673U, 0x206U, 0x2ECU, 0x699U, 0x5DBU, 0x1AEU, 0x144U, 0x531U, 0x090U, 0x4E5U,
+	0x40FU, 0x07AU, 0x721U, 0x354U, 0x3BEU, 0x7CBU, 0x26AU, 0x61FU, 0x6F5U, 0x280U,
+	0x1C2U, 0x5B7U, 0x55DU, 0x128U, 0x489U, 0x0FCU, 0x016U, 0x463U, 0x692U, 0x2E7U,
+	0x20DU, 0x678U, 0x3D9U, 0x7ACU, 0x746U, 0x333U, 0x071U, 0x404U, 0x4EEU, 0x09BU,
+	0x53AU, 0x14FU, 0x1A5U, 0x5D0U, 0x447U, 0x032U, 0x0D8U, 0x4ADU, 0x10CU, 0x579U,
+	0x593U, 0x1E6U, 0x2A4U, 0x6D1U, 0x63BU, 0x24EU, 0x7EFU, 0x39AU, 0x370U, 0x705U,
+	0x5F4U, 0x181U, 0x16BU, 0x51EU, 0x0BFU, 0x4CAU, 0x420U, 0x055U, 0x317U, 0x762U,
+	0x788U, 0x3FDU, 0x65CU, 0x229U, 0x2C3U, 0x6B6U, 0x3DAU, 0x7AFU, 0x745U, 0x330U,
+	0x691U, 0x2E4U, 0x20EU, 0x67BU, 0x539U, 0x14CU, 0x1A6U, 0x5D3U, 0x072U, 0x407U,
+	0x4EDU, 0x098U, 0x269U, 0x61CU, 0x6F6U, 0x283U, 0x722U, 0x357U, 0x3BDU, 0x7C8U,
+	0x48AU, 0x0FFU, 0x015U, 0x460U, 0x1C1U, 0x5B4U, 0x55EU, 0x12BU, 0x0BCU, 0x4C9U,
+	0x423U, 0x056U, 0x5F7U, 0x182U, 0x168U, 0x51DU, 0x65FU, 0x22AU, 0x2C0U, 0x6B5U,
+	0x314U, 0x761U, 0x78BU, 0x3FEU, 0x10FU, 0x57AU, 0x590U, 0x1E5U, 0x444U, 0x031U,
+	0x0DBU, 0x4AEU, 0x7ECU, 0x399U, 0x373U, 0x706U, 0x2A7U, 0x6D2U, 0x638U, 0x24DU,
+	0x516U, 0x163U, 0x189U, 0x5FCU, 0x05DU, 0x428U, 0x4C2U, 0x0B7U, 0x3F5U, 0x780U,
+	0x76AU, 0x31FU, 0x6BEU, 0x2CBU, 0x221U, 0x654U, 0x4A5U, 0x0D0U, 0x03AU, 0x44FU,
+	0x1EEU, 0x59BU, 0x571U, 0x104U, 0x246U, 0x633U, 0x6D9U, 0x2ACU, 0x70DU, 0x378U,
+	0x392U, 0x7E7U, 0x670U, 0x205U, 0x2EFU, 0x69AU, 0x33BU, 0x74EU, 0x7A4U, 0x3D1U,
+	0x093U, 0x4E6U, 0x40CU, 0x079U, 0x5D8U, 0x1ADU, 0x147U, 0x532U, 0x7C3U, 0x3B6U,
+	0x35CU, 0x729U, 0x288U, 0x6FDU, 0x617U, 0x262U, 0x120U, 0x555U, 0x5BFU, 0x1CAU,
+	0x46BU, 0x01EU, 0x0F4U, 0x481U, 0x237U, 0x642U, 0x6A8U, 0x2DDU, 0x77CU, 0x309U,
+	0x3E3U, 0x796U, 0x4D4U, 0x0A1U, 0x04BU, 0x43EU, 0x19FU, 0x5EAU, 0x500U, 0x175U,
+	0x384U, 0x7F1U, 0x71BU, 0x36EU, 0x6CFU, 0x2BAU, 0x250U, 0x625U, 0x567U, 0x112U,
+	0x1F8U, 0x58DU, 0x02CU, 0x459U, 0x4B3U, 0x0C6U, 0x151U, 0x524U, 0x5CEU, 0x1BBU,
+	0x41AU, 0x06FU, 0x085U, 0x4F0U, 0x7B2U, 0x3C7U, 0x32DU, 0x758U, 0x2F9U, 0x68CU,
+	0x666U, 0x213U, 0x0E2U, 0x497U, 0x47DU, 0x008U, 0x5A9U, 0x1DCU, 0x136U, 0x543U,
+	0x601U, 0x274U, 0x29EU, 0x6EBU, 0x34AU, 0x73FU, 0x7D5U, 0x3A0U, 0x4FBU, 0x08EU,
+	0x064U, 0x411U, 0x1B0U, 0x5C5U, 0x52FU, 0x15AU, 0x218U, 0x66DU, 0x687U, 0x2F2U,
+	0x753U, 0x326U, 0x3CCU, 0x7B9U, 0x548U, 0x13DU, 0x1D7U, 0x5A2U, 0x003U, 0x476U,
+	0x49CU, 0x0E9U, 0x3ABU, 0x7DEU, 0x734U, 0x341U, 0x6E0U, 0x295U, 0x27FU, 0x60AU,
+	0x79DU, 0x3E8U, 0x302U, 0x777U, 0x2D6U, 0x6A3U, 0x649U, 0x23CU, 0x17EU, 0x50BU,
+	0x5E1U, 0x194U, 0x435U, 0x040U, 0x0AAU, 0x4DFU, 0x62EU, 0x25BU, 0x2B1U, 0x6C4U,
+	0x365U, 0x710U, 0x7FAU, 0x38FU, 0x0CDU, 0x4B8U, 0x452U, 0x027U, 0x586U, 0x1F3U,
+	0x119U, 0x56CU, 0x7B4U, 0x3C1U, 0x32BU, 0x75EU, 0x2FFU, 0x68AU, 0x660U, 0x215U,
+	0x157U, 0x522U, 0x5C8U, 0x1BDU, 0x41CU, 0x069U, 0x083U, 0x4F6U, 0x607U, 0x272U,
+	0x298U, 0x6EDU, 0x34CU, 0x739U, 0x7D3U, 0x3A6U, 0x0E4U, 0x491U, 0x47BU, 0x00EU,
+	0x5AFU, 0x1DAU, 0x130U, 0x545U, 0x4D2U, 0x0A7U, 0x04DU, 0x438U, 0x199U, 0x5ECU,
+	0x506U, 0x173U, 0x231U, 0x644U, 0x6AEU, 0x2DBU, 0x77AU, 0x30FU, 0x3E5U, 0x790U,
+	0x561U, 0x114U, 0x1FEU, 0x58BU, 0x02AU, 0x45FU, 0x4B5U, 0x0C0U, 0x382U, 0x7F7U,
+	0x71DU, 0x368U, 0x6C9U, 0x2BCU, 0x256U, 0x623U, 0x178U, 0x50DU, 0x5E7U, 0x192U,
+	0x433U, 0x046U, 0x0ACU, 0x4D9U, 0x79BU, 0x3EEU, 0x304U, 0x771U, 0x2D0U, 0x6A5U,
+	0x64FU, 0x23AU, 0x0CBU, 0x4BEU, 0x454U, 0x021U, 0x580U, 0x1F5U, 0x11FU, 0x56AU,
+	0x628U, 0x25DU, 0x2B7U, 0x6C2U, 0x363U, 0x716U, 0x7FCU, 0x389U, 0x21EU, 0x66BU,
+	0x681U, 0x2F4U, 0x755U, 0x320U, 0x3CAU, 0x7BFU, 0x4FDU, 0x088U, 0x062U, 0x417U,
+	0x1B6U, 0x5C3U, 0x529U, 0x15CU, 0x3ADU, 0x7D8U, 0x732U, 0x347U, 0x6E6U, 0x293U,
+	0x279U, 0x60CU, 0x54EU, 0x13BU, 0x1D1U, 0x5A4U, 0x005U, 0x470U, 0x49AU, 0x0EFU,
+	0x659U, 0x22CU, 0x2C6U, 0x6B3U, 0x312U, 0x767U, 0x78DU, 0x3F8U, 0x0BAU, 0x4CFU,
+	0x425U, 0x050U, 0x5F1U, 0x184U, 0x16EU, 0x51BU, 0x7EAU, 0x39FU, 0x375U, 0x700U,
+	0x2A1U, 0x6D4U, 0x63EU, 0x24BU, 0x109U, 0x57CU, 0x596U, 0x1E3U, 0x442U, 0x037U,
+	0x0DDU, 0x4A8U, 0x53FU, 0x14AU, 0x1A0U, 0x5D5U, 0x074U, 0x401U, 0x4EBU, 0x09EU,
+	0x3DCU, 0x7A9U, 0x743U, 0x336U, 0x697U, 0x2E2U, 0x208U, 0x67DU, 0x48CU, 0x0F9U,
+	0x013U, 0x466U, 0x1C7U, 0x5B2U, 0x558U, 0x12DU, 0x26FU, 0x61AU, 0x6F0U, 0x285U,
+	0x724U, 0x351U, 0x3BBU, 0x7CEU, 0x095U, 0x4E0U, 0x40AU, 0x07FU, 0x5DEU, 0x1ABU,
+	0x141U, 0x534U, 0x676U, 0x203U, 0x2E9U, 0x69CU, 0x33DU, 0x748U, 0x7A2U, 0x3D7U,
+	0x126U, 0x553U, 0x5B9U, 0x1CCU, 0x46DU, 0x018U, 0x0F2U, 0x487U, 0x7C5U, 0x3B0U,
+	0x35AU, 0x72FU, 0x28EU, 0x6FBU, 0x611U, 0x264U, 0x3F3U, 0x786U, 0x76CU, 0x319U,
+	0x6B8U, 0x2CDU, 0x227U, 0x652U, 0x510U, 0x165U, 0x18FU, 0x5FAU, 0x05BU, 0x42EU,
+	0x4C4U, 0x0B1U, 0x240U, 0x635U, 0x6DFU, 0x2AAU, 0x70BU, 0x37EU, 0x394U, 0x7E1U,
+	0x4A3U, 0x0D6U, 0x03CU, 0x449U, 0x1E8U, 0x59DU, 0x577U, 0x102U, 0x46EU, 0x01BU,
+	0x0F1U, 0x484U, 0x125U, 0x550U, 0x5BAU, 0x1CFU, 0x28DU, 0x6F8U, 0x612U, 0x267U,
+	0x7C6U, 0x3B3U, 0x359U, 0x72CU, 0x5DDU, 0x1A8U, 0x142U, 0x537U, 0x096U, 0x4E3U,
+	0x409U, 0x07CU, 0x33EU, 0x74BU, 0x7A1U, 0x3D4U, 0x675U, 0x200U, 0x2EAU, 0x69FU,
+	0x708U, 0x37DU, 0x397U, 0x7E2U, 0x243U, 0x636U, 0x6DCU, 0x2A9U, 0x1EBU, 0x59EU,
+	0x574U, 0x101U, 0x4A0U, 0x0D5U, 0x03FU, 0x44AU, 0x6BBU, 0x2CEU, 0x224U, 0x651U,
+	0x3F0U, 0x785U, 0x76FU, 0x31AU, 0x058U, 0x42DU, 0x4C7U, 0x0B2U, 0x513U, 0x166U,
+	0x18CU, 0x5F9U, 0x2A2U, 0x6D7U, 0x63DU, 0x248U, 0x7E9U, 0x39CU, 0x376U, 0x703U,
+	0x441U, 0x034U, 0x0DEU, 0x4ABU, 0x10AU, 0x57FU, 0x595U, 0x1E0U, 0x311U, 0x764U,
+	0x78EU, 0x3FBU, 0x65AU, 0x22FU, 0x2C5U, 0x6B0U, 0x5F2U, 0x187U, 0x16DU, 0x518U,
+	0x0B9U, 0x4CCU, 0x426U, 0x053U, 0x1C4U, 0x5B1U, 0x55BU, 0x12EU, 0x48FU, 0x0FAU,
+	0x010U, 0x465U, 0x727U, 0x352U, 0x3B8U, 0x7CDU, 0x26CU, 0x619U, 0x6F3U, 0x286U,
+	0x077U, 0x402U, 0x4E8U, 0x09DU, 0x53CU, 0x149U, 0x1A3U, 0x5D6U, 0x694U, 0x2E1U,
+	0x20BU, 0x67EU, 0x3DFU, 0x7AAU, 0x740U, 0x335U, 0x583U, 0x1F6U, 0x11CU, 0x569U,
+	0x0C8U, 0x4BDU, 0x457U, 0x022U, 0x360U, 0x715U, 0x7FFU, 0x38AU, 0x62BU, 0x25EU,
+	0x2B4U, 0x6C1U, 0x430U, 0x045U, 0x0AFU, 0x4DAU, 0x17BU, 0x50EU, 0x5E4U, 0x191U,
+	0x2D3U, 0x6A6U, 0x64CU, 0x239U, 0x798U, 0x3EDU, 0x307U, 0x772U, 0x6E5U, 0x290U,
+	0x27AU, 0x60FU, 0x3AEU, 0x7DBU, 0x731U, 0x344U, 0x006U, 0x473U, 0x499U, 0x0ECU,
+	0x54DU, 0x138U, 0x1D2U, 0x5A7U, 0x756U, 0x323U, 0x3C9U, 0x7BCU, 0x21DU, 0x668U,
+	0x682U, 0x2F7U, 0x1B5U, 0x5C0U, 0x52AU, 0x15FU, 0x4FEU, 0x08BU, 0x061U, 0x414U,
+	0x34FU, 0x73AU, 0x7D0U, 0x3A5U, 0x604U, 0x271U, 0x29BU, 0x6EEU, 0x5ACU, 0x1D9U,
+	0x133U, 0x546U, 0x0E7U, 0x492U, 0x478U, 0x00DU, 0x2FCU, 0x689U, 0x663U, 0x216U,
+	0x7B7U, 0x3C2U, 0x328U, 0x75DU, 0x41FU, 0x06AU, 0x080U, 0x4F5U, 0x154U, 0x521U,
+	0x5CBU, 0x1BEU, 0x029U, 0x45CU, 0x4B6U, 0x0C3U, 0x562U, 0x117U, 0x1FDU, 0x588U,
+	0x6CAU, 0x2BFU, 0x255U, 0x620U, 0x381U, 0x7F4U, 0x71EU, 0x36BU, 0x19AU, 0x5EFU,
+	0x505U, 0x170U, 0x4D1U, 0x0A4U, 0x04EU, 0x43BU, 0x779U, 0x30CU, 0x3E6U, 0x793U,
+	0x232U, 0x647U, 0x6ADU, 0x2D8U, 0x31DU, 0x768U, 0x782U, 0x3F7U, 0x656U, 0x223U,
+	0x2C9U, 0x6BCU, 0x5FEU, 0x18BU, 0x161U, 0x514U, 0x0B5U, 0x4C0U, 0x42AU, 0x05FU,
+	0x2AEU, 0x6DBU, 0x631U, 0x244U, 0x7E5U, 0x390U, 0x37AU, 0x70FU, 0x44DU, 0x038U,
+	0x0D2U, 0x4A7U, 0x106U, 0x573U, 0x599U, 0x1ECU, 0x07BU, 0x40EU, 0x4E4U, 0x091U,
+	0x530U, 0x145U, 0x1AFU, 0x5DAU, 0x698U, 0x2EDU, 0x207U, 0x672U, 0x3D3U, 0x7A6U,
+	0x74CU, 0x339U, 0x1C8U, 0x5BDU, 0x557U, 0x122U, 0x483U, 0x0F6U, 0x01CU, 0x469U,
+	0x72BU, 0x35EU, 0x3B4U, 0x7C1U, 0x260U, 0x615U, 0x6FFU, 0x28AU, 0x5D1U, 0x1A4U,
+	0x14EU, 0x53BU, 0x09AU, 0x4EFU, 0x405U, 0x070U, 0x332U, 0x747U, 0x7ADU, 0x3D8U,
+	0x679U, 0x20CU, 0x2E6U, 0x693U, 0x462U, 0x017U, 0x0FDU, 0x488U, 0x129U, 0x55CU,
+	0x5B6U, 0x1C3U, 0x281U, 0x6F4U, 0x61EU, 0x26BU, 0x7CAU, 0x3BFU, 0x355U, 0x720U,
+	0x6B7U, 0x2C2U, 0x228U, 0x65DU, 0x3FCU, 0x789U, 0x763U, 0x316U, 0x054U, 0x421U,
+	0x4CBU, 0x0BEU, 0x51FU, 0x16AU, 0x180U, 0x5F5U, 0x704U, 0x371U, 0x39BU, 0x7EEU,
+	0x24FU, 0x63AU, 0x6D0U, 0x2A5U, 0x1E7U, 0x592U, 0x578U, 0x10DU, 0x4ACU, 0x0D9U,
+	0x033U, 0x446U, 0x2F0U, 0x685U, 0x66FU, 0x21AU, 0x7BBU, 0x3CEU, 0x324U, 0x751U,
+	0x413U, 0x066U, 0x08CU, 0x4F9U, 0x158U, 0x52DU, 0x5C7U, 0x1B2U, 0x343U, 0x736U,
+	0x7DCU, 0x3A9U, 0x608U, 0x27DU, 0x297U, 0x6E2U, 0x5A0U, 0x1D5U, 0x13FU, 0x54AU,
+	0x0EBU, 0x49EU, 0x474U, 0x001U, 0x196U, 0x5E3U, 0x509U, 0x17CU, 0x4DDU, 0x0A8U,
+	0x042U, 0x437U, 0x775U, 0x300U, 0x3EAU, 0x79FU, 0x23EU, 0x64BU, 0x6A1U, 0x2D4U,
+	0x025U, 0x450U, 0x4BAU, 0x0CFU, 0x56EU, 0x11BU, 0x1F1U, 0x584U, 0x6C6U, 0x2B3U,
+	0x259U, 0x62CU, 0x38DU, 0x7F8U, 0x712U, 0x367U, 0x43CU, 0x049U, 0x0A3U, 0x4D6U,
+	0x177U, 0x502U, 0x5E8U, 0x19DU, 0x2DFU, 0x6AAU, 0x640U, 0x235U, 0x794U, 0x3E1U,
+	0x30BU, 0x77EU, 0x58FU, 0x1FAU, 0x110U, 0x565U, 0x0C4U, 0x4B1U, 0x45BU, 0x02EU,
+	0x36CU, 0x719U, 0x7F3U, 0x386U, 0x627U, 0x252U, 0x2B8U, 0x6CDU, 0x75AU, 0x32FU,
+	0x3C5U, 0x7B0U, 0x211U, 0x664U, 0x68EU, 0x2FBU, 0x1B9U, 0x5CCU, 0x526U, 0x153U,
+	0x4F2U, 0x087U, 0x06DU, 0x418U, 0x6E9U, 0x29CU, 0x276U, 0x603U, 0x3A2U, 0x7D7U,
+	0x73DU, 0x348U, 0x00AU, 0x47FU, 0x495U, 0x0E0U, 0x541U, 0x134U, 0x1DEU, 0x5ABU,
+	0x0C7U, 0x4B2U, 0x458U, 0x02DU, 0x58CU, 0x1F9U, 0x113U, 0x566U, 0x624U, 0x251U,
+	0x2BBU, 0x6CEU, 0x36FU, 0x71AU, 0x7F0U, 0x385U, 0x174U, 0x501U, 0x5EBU, 0x19EU,
+	0x43FU, 0x04AU, 0x0A0U, 0x4D5U, 0x797U, 0x3E2U, 0x308U, 0x77DU, 0x2DCU, 0x6A9U,
+	0x643U, 0x236U, 0x3A1U, 0x7D4U, 0x73EU, 0x34BU, 0x6EAU, 0x29FU, 0x275U, 0x600U,
+	0x542U, 0x137U, 0x1DDU, 0x5A8U, 0x009U, 0x47CU, 0x496U, 0x0E3U, 0x212U, 0x667U,
+	0x68DU, 0x2F8U, 0x759U, 0x32CU, 0x3C6U, 0x7B3U, 0x4F1U, 0x084U, 0x06EU, 0x41BU,
+	0x1BAU, 0x5CFU, 0x525U, 0x150U, 0x60BU, 0x27EU, 0x294U, 0x6E1U, 0x340U, 0x735U,
+	0x7DFU, 0x3AAU, 0x0E8U, 0x49DU, 0x477U, 0x002U, 0x5A3U, 0x1D6U, 0x13CU, 0x549U,
+	0x7B8U, 0x3CDU, 0x327U, 0x752U, 0x2F3U, 0x686U, 0x66CU, 0x219U, 0x15BU, 0x52EU,
+	0x5C4U, 0x1B1U, 0x410U, 0x065U, 0x08FU, 0x4FAU, 0x56DU, 0x118U, 0x1F2U, 0x587U,
+	0x026U, 0x453U, 0x4B9U, 0x0CCU, 0x38EU, 0x7FBU, 0x711U, 0x364U, 0x6C5U, 0x2B0U,
+	0x25AU, 0x62FU, 0x4DEU, 0x0ABU, 0x041U, 0x434U, 0x195U, 0x5E0U, 0x50AU, 0x17FU,
+	0x23DU, 0x648U, 0x6A2U, 0x2D7U, 0x776U, 0x303U, 0x3E9U, 0x79CU, 0x12AU, 0x55FU,
+	0x5B5U, 0x1C0U, 0x461U, 0x014U, 0x0FEU, 0x48BU, 0x7C9U, 0x3BCU, 0x356U, 0x723U,
+	0x282U, 0x6F7U, 0x61DU, 0x268U, 0x099U, 0x4ECU, 0x406U, 0x073U, 0x5D2U, 0x1A7U,
+	0x14DU, 0x538U, 0x67AU, 0x20FU, 0x2E5U, 0x690U, 0x331U, 0x744U, 0x7AEU, 0x3DBU,
+	0x24CU, 0x639U, 0x6D3U, 0x2A6U, 0x707U, 0x372U, 0x398U, 0x7EDU, 0x4AFU, 0x0DAU,
+	0x030U, 0x445U, 0x1E4U, 0x591U, 0x57BU, 0x10EU, 0x3FFU, 0x78AU, 0x760U, 0x315U,
+	0x6B4U, 0x2C1U, 0x22BU, 0x65EU, 0x51CU, 0x169U, 0x183U, 0x5F6U, 0x057U, 0x422U,
+	0x4C8U, 0x0BDU, 0x7E6U, 0x393U, 0x379U, 0x70CU, 0x2ADU, 0x6D8U, 0x632U, 0x247U,
+	0x105U, 0x570U, 0x59AU, 0x1EFU, 0x44EU, 0x03BU, 0x0D1U, 0x4A4U, 0x655U, 0x220U,
+	0x2CAU, 0x6BFU, 0x31EU, 0x76BU, 0x781U, 0x3F4U, 0x0B6U, 0x4C3U, 0x429U, 0x05CU,
+	0x5FDU, 0x188U, 0x162U, 0x517U, 0x480U, 0x0F5U, 0x01FU, 0x46AU, 0x1CBU, 0x5BEU,
+	0x554U, 0x121U, 0x263U, 0x616U, 0x6FCU, 0x289U, 0x728U, 0x35DU, 0x3B7U, 0x7C2U,
+	0x533U, 0x146U, 0x1ACU, 0x5D9U, 0x078U, 0x40DU, 0x4E7U, 0x092U, 0x3D0U, 0x7A5U,
+	0x74FU, 0x33AU, 0x69BU, 0x2EEU, 0x204U, 0x671U, 0x4A9U, 0x0DCU, 0x036U, 0x443U,
+	0x1E2U, 0x597U, 0x57DU, 0x108U, 0x24AU, 0x63FU, 0x6D5U, 0x2A0U, 0x701U, 0x374U,
+	0x39EU, 0x7EBU, 0x51AU, 0x16FU, 0x185U, 0x5F0U, 0x051U, 0x424U, 0x4CEU, 0x0BBU,
+	0x3F9U, 0x78CU, 0x766U, 0x313U, 0x6B2U, 0x2C7U, 0x22DU, 0x658U, 0x7CFU, 0x3BAU,
+	0x350U, 0x725U, 0x284U, 0x6F1U, 0x61BU, 0x26EU, 0x12CU, 0x559U, 0x5B3U, 0x1C6U,
+	0x467U, 0x012U, 0x0F8U, 0x48DU, 0x67CU, 0x209U, 0x2E3U, 0x696U, 0x337U, 0x742U,
+	0x7A8U, 0x3DDU, 0x09FU, 0x4EAU, 0x400U, 0x075U, 0x5D4U, 0x1A1U, 0x14BU, 0x53EU,
+	0x265U, 0x610U, 0x6FAU, 0x28FU, 0x72EU, 0x35BU, 0x3B1U, 0x7C4U, 0x486U, 0x0F3U,
+	0x019U, 0x46CU, 0x1CDU, 0x5B8U, 0x552U, 0x127U, 0x3D6U, 0x7A3U, 0x749U, 0x33CU,
+	0x69DU, 0x2E8U, 0x202U, 0x677U, 0x535U, 0x140U, 0x1AAU, 0x5DFU, 0x07EU, 0x40BU,
+	0x4E1U, 0x094U, 0x103U, 0x576U, 0x59CU, 0x1E9U, 0x448U, 0x03DU, 0x0D7U, 0x4A2U,
+	0x7E0U, 0x395U, 0x37FU, 0x70AU, 0x2ABU, 0x6DEU, 0x634U, 0x241U, 0x0B0U, 0x4C5U,
+	0x42FU, 0x05AU, 0x5FBU, 0x18EU, 0x164U, 0x511U, 0x653U, 0x226U, 0x2CCU, 0x6B9U,
+	0x318U, 0x76DU, 0x787U, 0x3F2U, 0x544U, 0x131U, 0x1DBU, 0x5AEU, 0x00FU, 0x47AU,
+	0x490U, 0x0E5U, 0x3A7U, 0x7D2U, 0x738U, 0x34DU, 0x6ECU, 0x299U, 0x273U, 0x606U,
+	0x4F7U, 0x082U, 0x068U, 0x41DU, 0x1BCU, 0x5C9U, 0x523U, 0x156U, 0x214U, 0x661U,
+	0x68BU, 0x2FEU, 0x75FU, 0x32AU, 0x3C0U, 0x7B5U, 0x622U, 0x257U, 0x2BDU, 0x6C8U,
+	0x369U, 0x71CU, 0x7F6U, 0x383U, 0x0C1U, 0x4B4U, 0x45EU, 0x02BU, 0x58AU, 0x1FFU,
+	0x115U, 0x560U, 0x791U, 0x3E4U, 0x30EU, 0x77BU, 0x2DAU, 0x6AFU, 0x645U, 0x230U,
+	0x172U, 0x507U, 0x5EDU, 0x198U, 0x439U, 0x04CU, 0x0A6U, 0x4D3U, 0x388U, 0x7FDU,
+	0x717U, 0x362U, 0x6C3U, 0x2B6U, 0x25CU, 0x629U, 0x56BU, 0x11EU, 0x1F4U, 0x581U,
+	0x020U, 0x455U, 0x4BFU, 0x0CAU, 0x23BU, 0x64EU, 0x6A4U, 0x2D1U, 0x770U, 0x305U,
+	0x3EFU, 0x79AU, 0x4D8U, 0x0ADU, 0x047U, 0x432U, 0x193U, 0x5E6U, 0x50CU, 0x179U,
+	0x0EEU, 0x49BU, 0x471U, 0x004U, 0x5A5U, 0x1D0U, 0x13AU, 0x54FU, 0x60DU, 0x278U,
+	0x292U, 0x6E7U, 0x346U, 0x733U, 0x7D9U, 0x3ACU, 0x15DU, 0x528U, 0x5C2U, 0x1B7U,
+	0x416U, 0x063U, 0x089U, 0x4FCU, 0x7BEU, 0x3CBU, 0x321U, 0x754U, 0x2F5U, 0x680U,
+	0x66AU, 0x21FU, 0x773U, 0x306U, 0x3ECU, 0x799U, 0x238U, 0x64DU, 0x6A7U, 0x2D2U,
+	0x190U, 0x5E5U, 0x50FU, 0x17AU, 0x4DBU, 0x0AEU, 0x044U, 0x431U, 0x6C0U, 0x2B5U,
+	0x25FU, 0x62AU, 0x38BU, 0x7FEU, 0x714U, 0x361U, 0x023U, 0x456U, 0x4BCU, 0x0C9U,
+	0x568U, 0x11DU, 0x1F7U, 0x582U, 0x415U, 0x060U, 0x08AU, 0x4FFU, 0x15EU, 0x52BU,
+	0x5C1U, 0x1B4U, 0x2F6U, 0x683U, 0x669U, 0x21CU, 0x7BDU, 0x3C8U, 0x322U, 0x757U,
+	0x5A6U, 0x1D3U, 0x139U, 0x54CU, 0x0EDU, 0x498U, 0x472U, 0x007U, 0x345U, 0x730U,
+	0x7DAU, 0x3AFU, 0x60EU, 0x27BU, 0x291U, 0x6E4U, 0x1BFU, 0x5CAU, 0x520U, 0x155U,
+	0x4F4U, 0x081U, 0x06BU, 0x41EU, 0x75CU, 0x329U, 0x3C3U, 0x7B6U, 0x217U, 0x662U,
+	0x688U, 0x2FDU, 0x00CU, 0x479U, 0x493U, 0x0E6U, 0x547U, 0x132U, 0x1D8U, 0x5ADU,
+	0x6EFU, 0x29AU, 0x270U, 0x605U, 0x3A4U, 0x7D1U, 0x73BU, 0x34EU, 0x2D9U, 0x6ACU,
+	0x646U, 0x233U, 0x792U, 0x3E7U, 0x30DU, 0x778U, 0x43AU, 0x04FU, 0x0A5U, 0x4D0U,
+	0x171U, 0x504U, 0x5EEU, 0x19BU, 0x36AU, 0x71FU, 0x7F5U, 0x380U, 0x621U, 0x254U,
+	0x2BEU, 0x6CBU, 0x589U, 0x1FCU, 0x116U, 0x563U, 0x0C2U, 0x4B7U, 0x45DU, 0x028U,
+	0x69EU, 0x2EBU, 0x201U, 0x674U, 0x3D5U, 0x7A0U, 0x74AU, 0x33FU, 0x07DU, 0x408U,
+	0x4E2U, 0x097U, 0x536U, 0x143U, 0x1A9U, 0x5DCU, 0x72DU, 0x358U, 0x3B2U, 0x7C7U,
+	0x266U, 0x613U, 0x6F9U, 0x28CU, 0x1CEU, 0x5BBU, 0x551U, 0x124U, 0x485U, 0x0F0U,
+	0x01AU, 0x46FU, 0x5F8U, 0x18DU, 0x167U, 0x512U, 0x0B3U, 0x4C6U, 0x42CU, 0x059U,
+	0x31BU, 0x76EU, 0x784U, 0x3F1U, 0x650U, 0x225U, 0x2CFU, 0x6BAU, 0x44BU, 0x03EU,
+	0x0D4U, 0x4A1U, 0x100U, 0x575U, 0x59FU, 0x1EAU, 0x2A8U, 0x6DDU, 0x637U, 0x242U,
+	0x7E3U, 0x396U, 0x37CU, 0x709U, 0x052U, 0x427U, 0x4CDU, 0x0B8U, 0x519U, 0x16CU,
+	0x186U, 0x5F3U, 0x6B1U, 0x2C4U, 0x22EU, 0x65BU, 0x3FAU, 0x78FU, 0x765U, 0x310U,
+	0x1E1U, 0x594U, 0x57EU, 0x10BU, 0x4AAU, 0x0DFU, 0x035U, 0x440U, 0x702U, 0x377U,
+	0x39DU, 0x7E8U, 0x249U, 0x63CU, 0x6D6U, 0x2A3U, 0x334U, 0x741U, 0x7ABU, 0x3DEU,
+	0x67FU, 0x20AU, 0x2E0U, 0x695U, 0x5D7U, 0x1A2U, 0x148U, 0x53DU, 0x09CU, 0x4E9U,
+	0x403U, 0x076U, 0x287U, 0x6F2U, 0x618U, 0x26DU, 0x7CCU, 0x3B9U, 0x353U, 0x726U,
+	0x464U, 0x011U, 0x0FBU, 0x48EU, 0x12FU, 0x55AU, 0x5B0U, 0x1C5U, 0x63AU, 0x24FU,
+	0x2A5U, 0x6D0U, 0x371U, 0x704U, 0x7EEU, 0x39BU, 0x0D9U, 0x4ACU, 0x446U, 0x033U,
+	0x592U, 0x1E7U, 0x10DU, 0x578U, 0x789U, 0x3FCU, 0x316U, 0x763U, 0x2C2U, 0x6B7U,
+	0x65DU, 0x228U, 0x16AU, 0x51FU, 0x5F5U, 0x180U, 0x421U, 0x054U, 0x0BEU, 0x4CBU,
+	0x55CU, 0x129U, 0x1C3U, 0x5B6U, 0x017U, 0x462U, 0x488U, 0x0FDU, 0x3BFU, 0x7CAU,
+	0x720U, 0x355U, 0x6F4U, 0x281U, 0x26BU, 0x61EU, 0x4EFU, 0x09AU, 0x070U, 0x405U,
+	0x1A4U, 0x5D1U, 0x53BU, 0x14EU, 0x20CU, 0x679U, 0x693U, 0x2E6U, 0x747U, 0x332U,
+	0x3D8U, 0x7ADU, 0x0F6U, 0x483U, 0x469U, 0x01CU, 0x5BDU, 0x1C8U, 0x122U, 0x557U,
+	0x615U, 0x260U, 0x28AU, 0x6FFU, 0x35EU, 0x72BU, 0x7C1U, 0x3B4U, 0x145U, 0x530U,
+	0x5DAU, 0x1AFU, 0x40EU, 0x07BU, 0x091U, 0x4E4U, 0x7A6U, 0x3D3U, 0x339U, 0x74CU,
+	0x2EDU, 0x698U, 0x672U, 0x207U, 0x390U, 0x7E5U, 0x70FU, 0x37AU, 0x6DBU, 0x2AEU,
+	0x244U, 0x631U, 0x573U, 0x106U, 0x1ECU, 0x599U, 0x038U, 0x44DU, 0x4A7U, 0x0D2U,
+	0x223U, 0x656U, 0x6BCU, 0x2C9U, 0x768U, 0x31DU, 0x3F7U, 0x782U, 0x4C0U, 0x0B5U,
+	0x05FU, 0x42AU, 0x18BU, 0x5FEU, 0x514U, 0x161U, 0x7D7U, 0x3A2U, 0x348U, 0x73DU,
+	0x29CU, 0x6E9U, 0x603U, 0x276U, 0x134U, 0x541U, 0x5ABU, 0x1DEU, 0x47FU, 0x00AU,
+	0x0E0U, 0x495U, 0x664U, 0x211U, 0x2FBU, 0x68EU, 0x32FU, 0x75AU, 0x7B0U, 0x3C5U,
+	0x087U, 0x4F2U, 0x418U, 0x06DU, 0x5CCU, 0x1B9U, 0x153U, 0x526U, 0x4B1U, 0x0C4U,
+	0x02EU, 0x45BU, 0x1FAU, 0x58FU, 0x565U, 0x110U, 0x252U, 0x627U, 0x6CDU, 0x2B8U,
+	0x719U, 0x36CU, 0x386U, 0x7F3U, 0x502U, 0x177U, 0x19DU, 0x5E8U, 0x049U, 0x43CU,
+	0x4D6U, 0x0A3U, 0x3E1U, 0x794U, 0x77EU, 0x30BU, 0x6AAU, 0x2DFU, 0x235U, 0x640U,
+	0x11BU, 0x56EU, 0x584U, 0x1F1U, 0x450U, 0x025U, 0x0CFU, 0x4BAU, 0x7F8U, 0x38DU,
+	0x367U, 0x712U, 0x2B3U, 0x6C6U, 0x62CU, 0x259U, 0x0A8U, 0x4DDU, 0x437U, 0x042U,
+	0x5E3U, 0x196U, 0x17CU, 0x509U, 0x64BU, 0x23EU, 0x2D4U, 0x6A1U, 0x300U, 0x775U,
+	0x79FU, 0x3EAU, 0x27DU, 0x608U, 0x6E2U, 0x297U, 0x736U, 0x343U, 0x3A9U, 0x7DCU,
+	0x49EU, 0x0EBU, 0x001U, 0x474U, 0x1D5U, 0x5A0U, 0x54AU, 0x13FU, 0x3CEU, 0x7BBU,
+	0x751U, 0x324U, 0x685U, 0x2F0U, 0x21AU, 0x66FU, 0x52DU, 0x158U, 0x1B2U, 0x5C7U,
+	0x066U, 0x413U, 0x4F9U, 0x08CU, 0x5E0U, 0x195U, 0x17FU, 0x50AU, 0x0ABU, 0x4DEU,
+	0x434U, 0x041U, 0x303U, 0x776U, 0x79CU, 0x3E9U, 0x648U, 0x23DU, 0x2D7U, 0x6A2U,
+	0x453U, 0x026U, 0x0CCU, 0x4B9U, 0x118U, 0x56DU, 0x587U, 0x1F2U, 0x2B0U, 0x6C5U,
+	0x62FU, 0x25AU, 0x7FBU, 0x38EU, 0x364U, 0x711U, 0x686U, 0x2F3U, 0x219U, 0x66CU,
+	0x3CDU, 0x7B8U, 0x752U, 0x327U, 0x065U, 0x410U, 0x4FAU, 0x08FU, 0x52EU, 0x15BU,
+	0x1B1U, 0x5C4U, 0x735U, 0x340U, 0x3AAU, 0x7DFU, 0x27EU, 0x60BU, 0x6E1U, 0x294U,
+	0x1D6U, 0x5A3U, 0x549U, 0x13CU, 0x49DU, 0x0E8U, 0x002U, 0x477U, 0x32CU, 0x759U,
+	0x7B3U, 0x3C6U, 0x667U, 0x212U, 0x2F8U, 0x68DU, 0x5CFU, 0x1BAU, 0x150U, 0x525U,
+	0x084U, 0x4F1U, 0x41BU, 0x06EU, 0x29FU, 0x6EAU, 0x600U, 0x275U, 0x7D4U, 0x3A1U,
+	0x34BU, 0x73EU, 0x47CU, 0x009U, 0x0E3U, 0x496U, 0x137U, 0x542U, 0x5A8U, 0x1DDU,
+	0x04AU, 0x43FU, 0x4D5U, 0x0A0U, 0x501U, 0x174U, 0x19EU, 0x5EBU, 0x6A9U, 0x2DCU,
+	0x236U, 0x643U, 0x3E2U, 0x797U, 0x77DU, 0x308U, 0x1F9U, 0x58CU, 0x566U, 0x113U,
+	0x4B2U, 0x0C7U, 0x02DU, 0x458U, 0x71AU, 0x36FU, 0x385U, 0x7F0U, 0x251U, 0x624U,
+	0x6CEU, 0x2BBU, 0x40DU, 0x078U, 0x092U, 0x4E7U, 0x146U, 0x533U, 0x5D9U, 0x1ACU,
+	0x2EEU, 0x69BU, 0x671U, 0x204U, 0x7A5U, 0x3D0U, 0x33AU, 0x74FU, 0x5BEU, 0x1CBU,
+	0x121U, 0x554U, 0x0F5U, 0x480U, 0x46AU, 0x01FU, 0x35DU, 0x728U, 0x7C2U, 0x3B7U,
+	0x616U, 0x263U, 0x289U, 0x6FCU, 0x76BU, 0x31EU, 0x3F4U, 0x781U, 0x220U, 0x655U,
+	0x6BFU, 0x2CAU, 0x188U, 0x5FDU, 0x517U, 0x162U, 0x4C3U, 0x0B6U, 0x05CU, 0x429U,
+	0x6D8U, 0x2ADU, 0x247U, 0x632U, 0x393U, 0x7E6U, 0x70CU, 0x379U, 0x03BU, 0x44EU,
+	0x4A4U, 0x0D1U, 0x570U, 0x105U, 0x1EFU, 0x59AU, 0x2C1U, 0x6B4U, 0x65EU, 0x22BU,
+	0x78AU, 0x3FFU, 0x315U, 0x760U, 0x422U, 0x057U, 0x0BDU, 0x4C8U, 0x169U, 0x51CU,
+	0x5F6U, 0x183U, 0x372U, 0x707U, 0x7EDU, 0x398U, 0x639U, 0x24CU, 0x2A6U, 0x6D3U,
+	0x591U, 0x1E4U, 0x10EU, 0x57BU, 0x0DAU, 0x4AFU, 0x445U, 0x030U, 0x1A7U, 0x5D2U,
+	0x538U, 0x14DU, 0x4ECU, 0x099U, 0x073U, 0x406U, 0x744U, 0x331U, 0x3DBU, 0x7AEU,
+	0x20FU, 0x67AU, 0x690U, 0x2E5U, 0x014U, 0x461U, 0x48BU, 0x0FEU, 0x55FU, 0x12AU,
+	0x1C0U, 0x5B5U, 0x6F7U, 0x282U, 0x268U, 0x61DU, 0x3BCU, 0x7C9U, 0x723U, 0x356U,
+	0x18EU, 0x5FBU, 0x511U, 0x164U, 0x4C5U, 0x0B0U, 0x05AU, 0x42FU, 0x76DU, 0x318U,
+	0x3F2U, 0x787U, 0x226U, 0x653U, 0x6B9U, 0x2CCU, 0x03DU, 0x448U, 0x4A2U, 0x0D7U,
+	0x576U, 0x103U, 0x1E9U, 0x59CU, 0x6DEU, 0x2ABU, 0x241U, 0x634U, 0x395U, 0x7E0U,
+	0x70AU, 0x37FU, 0x2E8U, 0x69DU, 0x677U, 0x202U, 0x7A3U, 0x3D6U, 0x33CU, 0x749U,
+	0x40BU, 0x07EU, 0x094U, 0x4E1U, 0x140U, 0x535U, 0x5DFU, 0x1AAU, 0x35BU, 0x72EU,
+	0x7C4U, 0x3B1U, 0x610U, 0x265U, 0x28FU, 0x6FAU, 0x5B8U, 0x1CDU, 0x127U, 0x552U,
+	0x0F3U, 0x486U, 0x46CU, 0x019U, 0x742U, 0x337U, 0x3DDU, 0x7A8U, 0x209U, 0x67CU,
+	0x696U, 0x2E3U, 0x1A1U, 0x5D4U, 0x53EU, 0x14BU, 0x4EAU, 0x09FU, 0x075U, 0x400U,
+	0x6F1U, 0x284U, 0x26EU, 0x61BU, 0x3BAU, 0x7CFU, 0x725U, 0x350U, 0x012U, 0x467U,
+	0x48DU, 0x0F8U, 0x559U, 0x12CU, 0x1C6U, 0x5B3U, 0x424U, 0x051U, 0x0BBU, 0x4CEU,
+	0x16FU, 0x51AU, 0x5F0U, 0x185U, 0x2C7U, 0x6B2U, 0x658U, 0x22DU, 0x78CU, 0x3F9U,
+	0x313U, 0x766U, 0x597U, 0x1E2U, 0x108U, 0x57DU, 0x0DCU, 0x4A9U, 0x443U, 0x036U,
+	0x374U, 0x701U, 0x7EBU, 0x39EU, 0x63FU, 0x24AU, 0x2A0U, 0x6D5U, 0x063U, 0x416U,
+	0x4FCU, 0x089U, 0x528U, 0x15DU, 0x1B7U, 0x5C2U, 0x680U, 0x2F5U, 0x21FU, 0x66AU,
+	0x3CBU, 0x7BEU, 0x754U, 0x321U, 0x1D0U, 0x5A5U, 0x54FU, 0x13AU, 0x49BU, 0x0EEU,
+	0x004U, 0x471U, 0x733U, 0x346U, 0x3ACU, 0x7D9U, 0x278U, 0x60DU, 0x6E7U, 0x292U,
+	0x305U, 0x770U, 0x79AU, 0x3EFU, 0x64EU, 0x23BU, 0x2D1U, 0x6A4U, 0x5E6U, 0x193U,
+	0x179U, 0x50CU, 0x0ADU, 0x4D8U, 0x432U, 0x047U, 0x2B6U, 0x6C3U, 0x629U, 0x25CU,
+	0x7FDU, 0x388U, 0x362U, 0x717U, 0x455U, 0x020U, 0x0CAU, 0x4BFU, 0x11EU, 0x56BU,
+	0x581U, 0x1F4U, 0x6AFU, 0x2DAU, 0x230U, 0x645U, 0x3E4U, 0x791U, 0x77BU, 0x30EU,
+	0x04CU, 0x439U, 0x4D3U, 0x0A6U, 0x507U, 0x172U, 0x198U, 0x5EDU, 0x71CU, 0x369U,
+	0x383U, 0x7F6U, 0x257U, 0x622U, 0x6C8U, 0x2BDU, 0x1FFU, 0x58AU, 0x560U, 0x115U,
+	0x4B4U, 0x0C1U, 0x02BU, 0x45EU, 0x5C9U, 0x1BCU, 0x156U, 0x523U, 0x082U, 0x4F7U,
+	0x41DU, 0x068U, 0x32AU, 0x75FU, 0x7B5U, 0x3C0U, 0x661U, 0x214U, 0x2FEU, 0x68BU,
+	0x47AU, 0x00FU, 0x0E5U, 0x490U, 0x131U, 0x544U, 0x5AEU, 0x1DBU, 0x299U, 0x6ECU,
+	0x606U, 0x273U, 0x7D2U, 0x3A7U, 0x34DU, 0x738U, 0x254U, 0x621U, 0x6CBU, 0x2BEU,
+	0x71FU, 0x36AU, 0x380U, 0x7F5U, 0x4B7U, 0x0C2U, 0x028U, 0x45DU, 0x1FCU, 0x589U,
+	0x563U, 0x116U, 0x3E7U, 0x792U, 0x778U, 0x30DU, 0x6ACU, 0x2D9U, 0x233U, 0x646U,
+	0x504U, 0x171U, 0x19BU, 0x5EEU, 0x04FU, 0x43AU, 0x4D0U, 0x0A5U, 0x132U, 0x547U,
+	0x5ADU, 0x1D8U, 0x479U, 0x00CU, 0x0E6U, 0x493U, 0x7D1U, 0x3A4U, 0x34EU, 0x73BU,
+	0x29AU, 0x6EFU, 0x605U, 0x270U, 0x081U, 0x4F4U, 0x41EU, 0x06BU, 0x5CAU, 0x1BFU,
+	0x155U, 0x520U, 0x662U, 0x217U, 0x2FDU, 0x688U, 0x329U, 0x75CU, 0x7B6U, 0x3C3U,
+	0x498U, 0x0EDU, 0x007U, 0x472U, 0x1D3U, 0x5A6U, 0x54CU, 0x139U, 0x27BU, 0x60EU,
+	0x6E4U, 0x291U, 0x730U, 0x345U, 0x3AFU, 0x7DAU, 0x52BU, 0x15EU, 0x1B4U, 0x5C1U,
+	0x060U, 0x415U, 0x4FFU, 0x08AU, 0x3C8U, 0x7BDU, 0x757U, 0x322U, 0x683U, 0x2F6U,
+	0x21CU, 0x669U, 0x7FEU, 0x38BU, 0x361U, 0x714U, 0x2B5U, 0x6C0U, 0x62AU, 0x25FU,
+	0x11DU, 0x568U, 0x582U, 0x1F7U, 0x456U, 0x023U, 0x0C9U, 0x4BCU, 0x64DU, 0x238U,
+	0x2D2U, 0x6A7U, 0x306U, 0x773U, 0x799U, 0x3ECU, 0x0AEU, 0x4DBU, 0x431U, 0x044U,
+	0x5E5U, 0x190U, 0x17AU, 0x50FU, 0x3B9U, 0x7CCU, 0x726U, 0x353U, 0x6F2U, 0x287U,
+	0x26DU, 0x618U, 0x55AU, 0x12FU, 0x1C5U, 0x5B0U, 0x011U, 0x464U, 0x48EU, 0x0FBU,
+	0x20AU, 0x67FU, 0x695U, 0x2E0U, 0x741U, 0x334U, 0x3DEU, 0x7ABU, 0x4E9U, 0x09CU,
+	0x076U, 0x403U, 0x1A2U, 0x5D7U, 0x53DU, 0x148U, 0x0DFU, 0x4AAU, 0x440U, 0x035U,
+	0x594U, 0x1E1U, 0x10BU, 0x57EU, 0x63CU, 0x249U, 0x2A3U, 0x6D6U, 0x377U, 0x702U,
+	0x7E8U, 0x39DU, 0x16CU, 0x519U, 0x5F3U, 0x186U, 0x427U, 0x052U, 0x0B8U, 0x4CDU,
+	0x78FU, 0x3FAU, 0x310U, 0x765U, 0x2C4U, 0x6B1U, 0x65BU, 0x22EU, 0x575U, 0x100U,
+	0x1EAU, 0x59FU, 0x03EU, 0x44BU, 0x4A1U, 0x0D4U, 0x396U, 0x7E3U, 0x709U, 0x37CU,
+	0x6DDU, 0x2A8U, 0x242U, 0x637U, 0x4C6U, 0x0B3U, 0x059U, 0x42CU, 0x18DU, 0x5F8U,
+	0x512U, 0x167U, 0x225U, 0x650U, 0x6BAU, 0x2CFU, 0x76EU, 0x31BU, 0x3F1U, 0x784U,
+	0x613U, 0x266U, 0x28CU, 0x6F9U, 0x358U, 0x72DU, 0x7C7U, 0x3B2U, 0x0F0U, 0x485U,
+	0x46FU, 0x01AU, 0x5BBU, 0x1CEU, 0x124U, 0x551U, 0x7A0U, 0x3D5U, 0x33FU, 0x74AU,
+	0x2EBU, 0x69EU, 0x674U, 0x201U, 0x143U, 0x536U, 0x5DCU, 0x1A9U, 0x408U, 0x07DU,
+	0x097U, 0x4E2U, 0x527U, 0x152U, 0x1B8U, 0x5CDU, 0x06CU, 0x419U, 0x4F3U, 0x086U,
+	0x3C4U, 0x7B1U, 0x75BU, 0x32EU, 0x68FU, 0x2FAU, 0x210U, 0x665U, 0x494U, 0x0E1U,
+	0x00BU, 0x47EU, 0x1DFU, 0x5AAU, 0x540U, 0x135U, 0x277U, 0x602U, 0x6E8U, 0x29DU,
+	0x73CU, 0x349U, 0x3A3U, 0x7D6U, 0x641U, 0x234U, 0x2DEU, 0x6ABU, 0x30AU, 0x77FU,
+	0x795U, 0x3E0U, 0x0A2U, 0x4D7U, 0x43DU, 0x048U, 0x5E9U, 0x19CU, 0x176U, 0x503U,
+	0x7F2U, 0x387U, 0x36DU, 0x718U, 0x2B9U, 0x6CCU, 0x626U, 0x253U, 0x111U, 0x564U,
+	0x58EU, 0x1FBU, 0x45AU, 0x02FU, 0x0C5U, 0x4B0U, 0x3EBU, 0x79EU, 0x774U, 0x301U,
+	0x6A0U, 0x2D5U, 0x23FU, 0x64AU, 0x508U, 0x17DU, 0x197U, 0x5E2U, 0x043U, 0x436U,
+	0x4DCU, 0x0A9U, 0x258U, 0x62DU, 0x6C7U, 0x2B2U, 0x713U, 0x366U, 0x38CU, 0x7F9U,
+	0x4BBU, 0x0CEU, 0x024U, 0x451U, 0x1F0U, 0x585U, 0x56FU, 0x11AU, 0x08DU, 0x4F8U,
+	0x412U, 0x067U, 0x5C6U, 0x1B3U, 0x159U, 0x52CU, 0x66EU, 0x21BU, 0x2F1U, 0x684U,
+	0x325U, 0x750U, 0x7BAU, 0x3CFU, 0x13EU, 0x54BU, 0x5A1U, 0x1D4U, 0x475U, 0x000U,
+	0x0EAU, 0x49FU, 0x7DDU, 0x3A8U, 0x342U, 0x737U, 0x296U, 0x6E3U, 0x609U, 0x27CU,
+	0x4CAU, 0x0BFU, 0x055U, 0x420U, 0x181U, 0x5F4U, 0x51EU, 0x16BU, 0x229U, 0x65CU,
+	0x6B6U, 0x2C3U, 0x762U, 0x317U, 0x3FDU, 0x788U, 0x579U, 0x10CU, 0x1E6U, 0x593U,
+	0x032U, 0x447U, 0x4ADU, 0x0D8U, 0x39AU, 0x7EFU, 0x705U, 0x370U, 0x6D1U, 0x2A4U,
+	0x24EU, 0x63BU, 0x7ACU, 0x3D9U, 0x333U, 0x746U, 0x2E7U, 0x692U, 0x678U, 0x20DU,
+	0x14FU, 0x53AU, 0x5D0U, 0x1A5U, 0x404U, 0x071U, 0x09BU, 0x4EEU, 0x61FU, 0x26AU,
+	0x280U, 0x6F5U, 0x354U, 0x721U, 0x7CBU, 0x3BEU, 0x0FCU, 0x489U, 0x463U, 0x016U,
+	0x5B7U, 0x1C2U, 0x128U, 0x55DU, 0x206U, 0x673U, 0x699U, 0x2ECU, 0x74DU, 0x338U,
+	0x3D2U, 0x7A7U, 0x4E5U, 0x090U, 0x07AU, 0x40FU, 0x1AEU, 0x5DBU, 0x531U, 0x144U,
+	0x3B5U, 0x7C0U, 0x72AU, 0x35FU, 0x6FEU, 0x28BU, 0x261U, 0x614U, 0x556U, 0x123U,
+	0x1C9U, 0x5BCU, 0x01DU, 0x468U, 0x482U, 0x0F7U, 0x160U, 0x515U, 0x5FFU, 0x18AU,
+	0x42BU, 0x05EU, 0x0B4U, 0x4C1U, 0x783U, 0x3F6U, 0x31CU, 0x769U, 0x2C8U, 0x6BDU,
+	0x657U, 0x222U, 0x0D3U, 0x4A6U, 0x44CU, 0x039U, 0x598U, 0x1EDU, 0x107U, 0x572U,
+	0x630U, 0x245U, 0x2AFU, 0x6DAU, 0x37BU, 0x70EU, 0x7E4U, 0x391U, 0x6FDU, 0x288U,
+	0x262U, 0x617U, 0x3B6U, 0x7C3U, 0x729U, 0x35CU, 0x01EU, 0x46BU, 0x481U, 0x0F4U,
+	0x555U, 0x120U, 0x1CAU, 0x5BFU, 0x74EU, 0x33BU, 0x3D1U, 0x7A4U, 0x205U, 0x670U,
+	0x69AU, 0x2EFU, 0x1ADU, 0x5D8U, 0x532U, 0x147U, 0x4E6U, 0x093U, 0x079U, 0x40CU,
+	0x59BU, 0x1EEU, 0x104U, 0x571U, 0x0D0U, 0x4A5U, 0x44FU, 0x03AU, 0x378U, 0x70DU,
+	0x7E7U, 0x392U, 0x633U, 0x246U, 0x2ACU, 0x6D9U, 0x428U, 0x05DU, 0x0B7U, 0x4C2U,
+	0x163U, 0x516U, 0x5FCU, 0x189U, 0x2CBU, 0x6BEU, 0x654U, 0x221U, 0x780U, 0x3F5U,
+	0x31FU, 0x76AU, 0x031U, 0x444U, 0x4AEU, 0x0DBU, 0x57AU, 0x10FU, 0x1E5U, 0x590U,
+	0x6D2U, 0x2A7U, 0x24DU, 0x638U, 0x399U, 0x7ECU, 0x706U, 0x373U, 0x182U, 0x5F7U,
+	0x51DU, 0x168U, 0x4C9U, 0x0BCU, 0x056U, 0x423U, 0x761U, 0x314U, 0x3FEU, 0x78BU,
+	0x22AU, 0x65FU, 0x6B5U, 0x2C0U, 0x357U, 0x722U, 0x7C8U, 0x3BDU, 0x61CU, 0x269U,
+	0x283U, 0x6F6U, 0x5B4U, 0x1C1U, 0x12BU, 0x55EU, 0x0FFU, 0x48AU, 0x460U, 0x015U,
+	0x2E4U, 0x691U, 0x67BU, 0x20EU, 0x7AFU, 0x3DAU, 0x330U, 0x745U, 0x407U, 0x072U,
+	0x098U, 0x4EDU, 0x14CU, 0x539U, 0x5D3U, 0x1A6U, 0x710U, 0x365U, 0x38FU, 0x7FAU,
+	0x25BU, 0x62EU, 0x6C4U, 0x2B1U, 0x1F3U, 0x586U, 0x56CU, 0x119U, 0x4B8U, 0x0CDU,
+	0x027U, 0x452U, 0x6A3U, 0x2D6U, 0x23CU, 0x649U, 0x3E8U, 0x79DU, 0x777U, 0x302U,
+	0x040U, 0x435U, 0x4DFU, 0x0AAU, 0x50BU, 0x17EU, 0x194U, 0x5E1U, 0x476U, 0x003U,
+	0x0E9U, 0x49CU, 0x13DU, 0x548U, 0x5A2U, 0x1D7U, 0x295U, 0x6E0U, 0x60AU, 0x27FU,
+	0x7DEU, 0x3ABU, 0x341U, 0x734U, 0x5C5U, 0x1B0U, 0x15AU, 0x52FU, 0x08EU, 0x4FBU,
+	0x411U, 0x064U, 0x326U, 0x753U, 0x7B9U, 0x3CCU, 0x66DU, 0x218U, 0x2F2U, 0x687U,
+	0x1DCU, 0x5A9U, 0x543U, 0x136U, 0x497U, 0x0E2U, 0x008U, 0x47DU, 0x73FU, 0x34AU,
+	0x3A0U, 0x7D5U, 0x274U, 0x601U, 0x6EBU, 0x29EU, 0x06FU, 0x41AU, 0x4F0U, 0x085U,
+	0x524U, 0x151U, 0x1BBU, 0x5CEU, 0x68CU, 0x2F9U, 0x213U, 0x666U, 0x3C7U, 0x7B2U,
+	0x758U, 0x32DU, 0x2BAU, 0x6CFU, 0x625U, 0x250U, 0x7F1U, 0x384U, 0x36EU, 0x71BU,
+	0x459U, 0x02CU, 0x0C6U, 0x4B3U, 0x112U, 0x567U, 0x58DU, 0x1F8U, 0x309U, 0x77CU,
+	0x796U, 0x3E3U, 0x642U, 0x237U, 0x2DDU, 0x6A8U, 0x5EAU, 0x19FU, 0x175U, 0x500U,
+	0x0A1U, 0x4D4U, 0x43EU, 0x04BU, 0x293U, 0x6E6U, 0x60CU, 0x279U, 0x7D8U, 0x3ADU,
+	0x347U, 0x732U, 0x470U, 0x005U, 0x0EFU, 0x49AU, 0x13BU, 0x54EU, 0x5A4U, 0x1D1U,
+	0x320U, 0x755U, 0x7BFU, 0x3CAU, 0x66BU, 0x21EU, 0x2F4U, 0x681U, 0x5C3U, 0x1B6U,
+	0x15CU, 0x529U, 0x088U, 0x4FDU, 0x417U, 0x062U, 0x1F5U, 0x580U, 0x56AU, 0x11FU,
+	0x4BEU, 0x0CBU, 0x021U, 0x454U, 0x716U, 0x363U, 0x389U, 0x7FCU, 0x25DU, 0x628U,
+	0x6C2U, 0x2B7U, 0x046U, 0x433U, 0x4D9U, 0x0ACU, 0x50DU, 0x178U, 0x192U, 0x5E7U,
+	0x6A5U, 0x2D0U, 0x23AU, 0x64FU, 0x3EEU, 0x79BU, 0x771U, 0x304U, 0x45FU, 0x02AU,
+	0x0C0U, 0x4B5U, 0x114U, 0x561U, 0x58BU, 0x1FEU, 0x2BCU, 0x6C9U, 0x623U, 0x256U,
+	0x7F7U, 0x382U, 0x368U, 0x71DU, 0x5ECU, 0x199U, 0x173U, 0x506U, 0x0A7U, 0x4D2U,
+	0x438U, 0x04DU, 0x30FU, 0x77AU, 0x790U, 0x3E5U, 0x644U, 0x231U, 0x2DBU, 0x6AEU,
+	0x739U, 0x34CU, 0x3A6U, 0x7D3U, 0x272U, 0x607U, 0x6EDU, 0x298U, 0x1DAU, 0x5AFU,
+	0x545U, 0x130U, 0x491U, 0x0E4U, 0x00EU, 0x47BU, 0x68AU, 0x2FFU, 0x215U, 0x660U,
+	0x3C1U, 0x7B4U, 0x75EU, 0x32BU, 0x069U, 0x41CU, 0x4F6U, 0x083U, 0x522U, 0x157U,
+	0x1BDU, 0x5C8U, 0x37EU, 0x70BU, 0x7E1U, 0x394U, 0x635U, 0x240U, 0x2AAU, 0x6DFU,
+	0x59DU, 0x1E8U, 0x102U, 0x577U, 0x0D6U, 0x4A3U, 0x449U, 0x03CU, 0x2CDU, 0x6B8U,
+	0x652U, 0x227U, 0x786U, 0x3F3U, 0x319U, 0x76CU, 0x42EU, 0x05BU, 0x0B1U, 0x4C4U,
+	0x165U, 0x510U, 0x5FAU, 0x18FU, 0x018U, 0x46DU, 0x487U, 0x0F2U, 0x553U, 0x126U,
+	0x1CCU, 0x5B9U, 0x6FBU, 0x28EU, 0x264U, 0x611U, 0x3B0U, 0x7C5U, 0x72FU, 0x35AU,
+	0x1ABU, 0x5DEU, 0x534U, 0x141U, 0x4E0U, 0x095U, 0x07FU, 0x40AU, 0x748U, 0x33DU,
+	0x3D7U, 0x7A2U, 0x203U, 0x676U, 0x69CU, 0x2E9U, 0x5B2U, 0x1C7U, 0x12DU, 0x558U,
+	0x0F9U, 0x48CU, 0x466U, 0x013U, 0x351U, 0x724U, 0x7CEU, 0x3BBU, 0x61AU, 0x26FU,
+	0x285U, 0x6F0U, 0x401U, 0x074U, 0x09EU, 0x4EBU, 0x14AU, 0x53FU, 0x5D5U, 0x1A0U,
+	0x2E2U, 0x697U, 0x67DU, 0x208U, 0x7A9U, 0x3DCU, 0x336U, 0x743U, 0x6D4U, 0x2A1U,
+	0x24BU, 0x63EU, 0x39FU, 0x7EAU, 0x700U, 0x375U, 0x037U, 0x442U, 0x4A8U, 0x0DDU,
+	0x57CU, 0x109U, 0x1E3U, 0x596U, 0x767U, 0x312U, 0x3F8U, 0x78DU, 0x22CU, 0x659U,
+	0x6B3U, 0x2C6U, 0x184U, 0x5F1U, 0x51BU, 0x16EU, 0x4CFU, 0x0BAU, 0x050U, 0x425U,
+	0x149U, 0x53CU, 0x5D6U, 0x1A3U, 0x402U, 0x077U, 0x09DU, 0x4E8U, 0x7AAU, 0x3DFU,
+	0x335U, 0x740U, 0x2E1U, 0x694U, 0x67EU, 0x20BU, 0x0FAU, 0x48FU, 0x465U, 0x010U,
+	0x5B1U, 0x1C4U, 0x12EU, 0x55BU, 0x619U, 0x26CU, 0x286U, 0x6F3U, 0x352U, 0x727U,
+	0x7CDU, 0x3B8U, 0x22FU, 0x65AU, 0x6B0U, 0x2C5U, 0x764U, 0x311U, 0x3FBU, 0x78EU,
+	0x4CCU, 0x0B9U, 0x053U, 0x426U, 0x187U, 0x5F2U, 0x518U, 0x16DU, 0x39CU, 0x7E9U,
+	0x703U, 0x376U, 0x6D7U, 0x2A2U, 0x248U, 0x63DU, 0x57FU, 0x10AU, 0x1E0U, 0x595U,
+	0x034U, 0x441U, 0x4ABU, 0x0DEU, 0x785U, 0x3F0U, 0x31AU, 0x76FU, 0x2CEU, 0x6BBU,
+	0x651U, 0x224U, 0x166U, 0x513U, 0x5F9U, 0x18CU, 0x42DU, 0x058U, 0x0B2U, 0x4C7U,
+	0x636U, 0x243U, 0x2A9U, 0x6DCU, 0x37DU, 0x708U, 0x7E2U, 0x397U, 0x0D5U, 0x4A0U,
+	0x44AU, 0x03FU, 0x59EU, 0x1EBU, 0x101U, 0x574U, 0x4E3U, 0x096U, 0x07CU, 0x409U,
+	0x1A8U, 0x5DDU, 0x537U, 0x142U, 0x200U, 0x675U, 0x69FU, 0x2EAU, 0x74BU, 0x33EU,
+	0x3D4U, 0x7A1U, 0x550U, 0x125U, 0x1CFU, 0x5BAU, 0x01BU, 0x46EU, 0x484U, 0x0F1U,
+	0x3B3U, 0x7C6U, 0x72CU, 0x359U, 0x6F8U, 0x28DU, 0x267U, 0x612U, 0x0A4U, 0x4D1U,
+	0x43BU, 0x04EU, 0x5EFU, 0x19AU, 0x170U, 0x505U, 0x647U, 0x232U, 0x2D8U, 0x6ADU,
+	0x30CU, 0x779U, 0x793U, 0x3E6U, 0x117U, 0x562U, 0x588U, 0x1FDU, 0x45CU, 0x029U,
+	0x0C3U, 0x4B6U, 0x7F4U, 0x381U, 0x36BU, 0x71EU, 0x2BFU, 0x6CAU, 0x620U, 0x255U,
+	0x3C2U, 0x7B7U, 0x75DU, 0x328U, 0x689U, 0x2FCU, 0x216U, 0x663U, 0x521U, 0x154U,
+	0x1BEU, 0x5CBU, 0x06AU, 0x41FU, 0x4F5U, 0x080U, 0x271U, 0x604U, 0x6EEU, 0x29BU,
+	0x73AU, 0x34FU, 0x3A5U, 0x7D0U, 0x492U, 0x0E7U, 0x00DU, 0x478U, 0x1D9U, 0x5ACU,
+	0x546U, 0x133U, 0x668U, 0x21DU, 0x2F7U, 0x682U, 0x323U, 0x756U, 0x7BCU, 0x3C9U,
+	0x08BU, 0x4FEU, 0x414U, 0x061U, 0x5C0U, 0x1B5U, 0x15FU, 0x52AU, 0x7DBU, 0x3AEU,
+	0x344U, 0x731U, 0x290U, 0x6E5U, 0x60FU, 0x27AU, 0x138U, 0x54DU, 0x5A7U, 0x1D2U,
+	0x473U, 0x006U, 0x0ECU, 0x499U, 0x50EU, 0x17BU, 0x191U, 0x5E4U, 0x045U, 0x430U,
+	0x4DAU, 0x0AFU, 0x3EDU, 0x798U, 0x772U, 0x307U, 0x6A6U, 0x2D3U, 0x239U, 0x64CU,
+	0x4BDU, 0x0C8U, 0x022U, 0x457U, 0x1F6U, 0x583U, 0x569U, 0x11CU, 0x25EU, 0x62BU,
+	0x6C1U, 0x2B4U, 0x715U, 0x360U, 0x38AU, 0x7FFU};
 
+// The syndrome is linear, so it is the syndrome of the top twelve bits from the table, plus the bottom
+// eleven bits which are their own remainder
 static unsigned int get_syndrome_23127(unsigned int pattern)
-/*
- * Compute the syndrome corresponding to the given pattern, i.e., the
- * remainder after dividing the pattern (when considering it as the vector
- * representation of a polynomial) by the generator polynomial, GENPOL.
- * In the program this pattern has several meanings: (1) pattern = infomation
- * bits, when constructing the encoding table; (2) pattern = error pattern,
- * when constructing the decoding table; and (3) pattern = received vector, to
- * obtain its syndrome in decoding.
- */
 {
-	unsigned int aux = X22;
- 
-	if (pattern >= X11) {
-		while (pattern & MASK12) {
-			while (!(aux & pattern))
-				aux = aux >> 1;
-
-			pattern ^= (aux / X11) * GENPOL;
-		}
-	}
-
-	return pattern;
+	return SYNDROME_TABLE_23127[(pattern >> 11) & 0xFFFU] ^ (pattern & 0x7FFU);
 }
 
 unsigned int CGolay::encode23127(unsigned int data)
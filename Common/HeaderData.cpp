@@ -20,67 +20,40 @@
 #include "HeaderData.h"
 #include "DStarDefines.h"
 
+// Where each field is in the header, this is the order that they are sent in
+const unsigned int FLAG1_OFFSET    = 0U;
+const unsigned int FLAG2_OFFSET    = 1U;
+const unsigned int FLAG3_OFFSET    = 2U;
+const unsigned int RPTCALL2_OFFSET = 3U;
+const unsigned int RPTCALL1_OFFSET = RPTCALL2_OFFSET + LONG_CALLSIGN_LENGTH;
+const unsigned int YOURCALL_OFFSET = RPTCALL1_OFFSET + LONG_CALLSIGN_LENGTH;
+const unsigned int MYCALL1_OFFSET  = YOURCALL_OFFSET + LONG_CALLSIGN_LENGTH;
+const unsigned int MYCALL2_OFFSET  = MYCALL1_OFFSET  + LONG_CALLSIGN_LENGTH;
+
+const unsigned int HEADER_LENGTH = RADIO_HEADER_LENGTH_BYTES - 2U;
+
 CHeaderData::CHeaderData() :
 m_time(),
-m_myCall1(),
-m_myCall2(),
-m_yourCall(),
-m_rptCall1(),
-m_rptCall2(),
-m_flag1(0x00),
-m_flag2(0x00),
-m_flag3(0x00),
 m_valid(false)
 {
+	::memset(m_header, 0x00, HEADER_LENGTH);
 }
 
 CHeaderData::CHeaderData(const CHeaderData& header) :
 m_time(header.m_time),
-m_myCall1(header.m_myCall1),
-m_myCall2(header.m_myCall2),
-m_yourCall(header.m_yourCall),
-m_rptCall1(header.m_rptCall1),
-m_rptCall2(header.m_rptCall2),
-m_flag1(header.m_flag1),
-m_flag2(header.m_flag2),
-m_flag3(header.m_flag3),
 m_valid(header.m_valid)
 {
+	::memcpy(m_header, header.m_header, HEADER_LENGTH);
 }
 
 CHeaderData::CHeaderData(const unsigned char* data, unsigned int length, bool check) :
 m_time(),
-m_myCall1(),
-m_myCall2(),
-m_yourCall(),
-m_rptCall1(),
-m_rptCall2(),
-m_flag1(0x00),
-m_flag2(0x00),
-m_flag3(0x00),
 m_valid(true)
 {
 	wxASSERT(data != NULL);
 	wxASSERT(length >= (RADIO_HEADER_LENGTH_BYTES - 2U));
 
-	const unsigned char* p = data;
-	m_flag1 = *p++;
-	m_flag2 = *p++;
-	m_flag3 = *p++;
-
-	m_rptCall2 = wxString((const char*)p, wxConvLocal, LONG_CALLSIGN_LENGTH);
-	p += LONG_CALLSIGN_LENGTH;
-
-	m_rptCall1 = wxString((const char*)p, wxConvLocal, LONG_CALLSIGN_LENGTH);
-	p += LONG_CALLSIGN_LENGTH;
-
-	m_yourCall = wxString((const char*)p, wxConvLocal, LONG_CALLSIGN_LENGTH);
-	p += LONG_CALLSIGN_LENGTH;
-
-	m_myCall1  = wxString((const char*)p,  wxConvLocal, LONG_CALLSIGN_LENGTH);
-	p += LONG_CALLSIGN_LENGTH;
-
-	m_myCall2  = wxString((const char*)p,  wxConvLocal, SHORT_CALLSIGN_LENGTH);
+	::memcpy(m_header, data, HEADER_LENGTH);
 
 	m_time.SetToCurrent();
 
@@ -98,29 +71,19 @@ CHeaderData::CHeaderData(const wxString& myCall1,  const wxString& myCall2, cons
 						 const wxString& rptCall1, const wxString& rptCall2, unsigned char flag1,
 						 unsigned char flag2, unsigned char flag3) :
 m_time(),
-m_myCall1(myCall1),
-m_myCall2(myCall2),
-m_yourCall(yourCall),
-m_rptCall1(rptCall1),
-m_rptCall2(rptCall2),
-m_flag1(flag1),
-m_flag2(flag2),
-m_flag3(flag3),
 m_valid(true)
 {
 	m_time.SetToCurrent();
 
-	m_myCall1.Append(wxT(' '),  LONG_CALLSIGN_LENGTH);
-	m_myCall2.Append(wxT(' '),  SHORT_CALLSIGN_LENGTH);
-	m_yourCall.Append(wxT(' '), LONG_CALLSIGN_LENGTH);
-	m_rptCall1.Append(wxT(' '), LONG_CALLSIGN_LENGTH);
-	m_rptCall2.Append(wxT(' '), LONG_CALLSIGN_LENGTH);
+	m_header[FLAG1_OFFSET] = flag1;
+	m_header[FLAG2_OFFSET] = flag2;
+	m_header[FLAG3_OFFSET] = flag3;
 
-	m_myCall1.Truncate(LONG_CALLSIGN_LENGTH);
-	m_myCall2.Truncate(SHORT_CALLSIGN_LENGTH);
-	m_yourCall.Truncate(LONG_CALLSIGN_LENGTH);
-	m_rptCall1.Truncate(LONG_CALLSIGN_LENGTH);
-	m_rptCall2.Truncate(LONG_CALLSIGN_LENGTH);
+	setCallsign(MYCALL1_OFFSET,  LONG_CALLSIGN_LENGTH,  myCall1);
+	setCallsign(MYCALL2_OFFSET,  SHORT_CALLSIGN_LENGTH, myCall2);
+	setCallsign(YOURCALL_OFFSET, LONG_CALLSIGN_LENGTH,  yourCall);
+	setCallsign(RPTCALL1_OFFSET, LONG_CALLSIGN_LENGTH,  rptCall1);
+	setCallsign(RPTCALL2_OFFSET, LONG_CALLSIGN_LENGTH,  rptCall2);
 }
 
 CHeaderData::~CHeaderData()
@@ -134,183 +97,285 @@ wxDateTime CHeaderData::getTime() const
 
 wxString CHeaderData::getMyCall1() const
 {
-	return m_myCall1;
+	return getCallsign(MYCALL1_OFFSET, LONG_CALLSIGN_LENGTH);
 }
 
 wxString CHeaderData::getMyCall2() const
 {
-	return m_myCall2;
+	return getCallsign(MYCALL2_OFFSET, SHORT_CALLSIGN_LENGTH);
 }
 
 wxString CHeaderData::getYourCall() const
 {
-	return m_yourCall;
+	return getCallsign(YOURCALL_OFFSET, LONG_CALLSIGN_LENGTH);
 }
 
 wxString CHeaderData::getRptCall1() const
 {
-	return m_rptCall1;
+	return getCallsign(RPTCALL1_OFFSET, LONG_CALLSIGN_LENGTH);
 }
 
 wxString CHeaderData::getRptCall2() const
 {
-	return m_rptCall2;
+	return getCallsign(RPTCALL2_OFFSET, LONG_CALLSIGN_LENGTH);
+}
+
+void CHeaderData::getMyCall1(unsigned char* callsign) const
+{
+	wxASSERT(callsign != NULL);
+
+	::memcpy(callsign, m_header + MYCALL1_OFFSET, LONG_CALLSIGN_LENGTH);
+}
+
+void CHeaderData::getMyCall2(unsigned char* callsign) const
+{
+	wxASSERT(callsign != NULL);
+
+	::memcpy(callsign, m_header + MYCALL2_OFFSET, SHORT_CALLSIGN_LENGTH);
+}
+
+void CHeaderData::getYourCall(unsigned char* callsign) const
+{
+	wxASSERT(callsign != NULL);
+
+	::memcpy(callsign, m_header + YOURCALL_OFFSET, LONG_CALLSIGN_LENGTH);
+}
+
+void CHeaderData::getRptCall1(unsigned char* callsign) const
+{
+	wxASSERT(callsign != NULL);
+
+	::memcpy(callsign, m_header + RPTCALL1_OFFSET, LONG_CALLSIGN_LENGTH);
+}
+
+void CHeaderData::getRptCall2(unsigned char* callsign) const
+{
+	wxASSERT(callsign != NULL);
+
+	::memcpy(callsign, m_header + RPTCALL2_OFFSET, LONG_CALLSIGN_LENGTH);
+}
+
+bool CHeaderData::isMyCall1(const wxString& callsign) const
+{
+	return callsign.Len() == LONG_CALLSIGN_LENGTH && isCallsign(MYCALL1_OFFSET, callsign.wx_str(), LONG_CALLSIGN_LENGTH);
+}
+
+bool CHeaderData::isMyCall1(const wxChar* callsign, unsigned int length) const
+{
+	wxASSERT(callsign != NULL);
+	wxASSERT(length <= LONG_CALLSIGN_LENGTH);
+
+	return isCallsign(MYCALL1_OFFSET, callsign, length);
+}
+
+bool CHeaderData::isYourCall(const wxString& callsign) const
+{
+	return callsign.Len() == LONG_CALLSIGN_LENGTH && isCallsign(YOURCALL_OFFSET, callsign.wx_str(), LONG_CALLSIGN_LENGTH);
+}
+
+bool CHeaderData::isRptCall1(const wxString& callsign) const
+{
+	return callsign.Len() == LONG_CALLSIGN_LENGTH && isCallsign(RPTCALL1_OFFSET, callsign.wx_str(), LONG_CALLSIGN_LENGTH);
+}
+
+bool CHeaderData::isRptCall2(const wxString& callsign) const
+{
+	return callsign.Len() == LONG_CALLSIGN_LENGTH && isCallsign(RPTCALL2_OFFSET, callsign.wx_str(), LONG_CALLSIGN_LENGTH);
+}
+
+void CHeaderData::getData(unsigned char* data, unsigned int length, bool check) const
+{
+	wxASSERT(data != NULL);
+	wxASSERT(length >= HEADER_LENGTH);
+
+	::memcpy(data, m_header, HEADER_LENGTH);
+
+	if (length >= RADIO_HEADER_LENGTH_BYTES && check) {
+		CCCITTChecksumReverse cksum;
+		cksum.update(m_header, HEADER_LENGTH);
+		cksum.result(data + HEADER_LENGTH);
+	}
 }
 
 unsigned char CHeaderData::getFlag1() const
 {
-	return m_flag1;
+	return m_header[FLAG1_OFFSET];
 }
 
 unsigned char CHeaderData::getFlag2() const
 {
-	return m_flag2;
+	return m_header[FLAG2_OFFSET];
 }
 
 unsigned char CHeaderData::getFlag3() const
 {
-	return m_flag3;
+	return m_header[FLAG3_OFFSET];
 }
 
 void CHeaderData::setMyCall1(const wxString& callsign)
 {
-	m_myCall1 = callsign;
-	m_myCall1.Append(wxT(' '), LONG_CALLSIGN_LENGTH);
-	m_myCall1.Truncate(LONG_CALLSIGN_LENGTH);
+	setCallsign(MYCALL1_OFFSET, LONG_CALLSIGN_LENGTH, callsign);
 }
 
 void CHeaderData::setMyCall2(const wxString& callsign)
 {
-	m_myCall2 = callsign;
-	m_myCall2.Append(wxT(' '), SHORT_CALLSIGN_LENGTH);
-	m_myCall2.Truncate(SHORT_CALLSIGN_LENGTH);
+	setCallsign(MYCALL2_OFFSET, SHORT_CALLSIGN_LENGTH, callsign);
 }
 
 void CHeaderData::setYourCall(const wxString& callsign)
 {
-	m_yourCall = callsign;
-	m_yourCall.Append(wxT(' '), LONG_CALLSIGN_LENGTH);
-	m_yourCall.Truncate(LONG_CALLSIGN_LENGTH);
+	setCallsign(YOURCALL_OFFSET, LONG_CALLSIGN_LENGTH, callsign);
 }
 
 void CHeaderData::setRptCall1(const wxString& callsign)
 {
-	m_rptCall1 = callsign;
-	m_rptCall1.Append(wxT(' '), LONG_CALLSIGN_LENGTH);
-	m_rptCall1.Truncate(LONG_CALLSIGN_LENGTH);
+	setCallsign(RPTCALL1_OFFSET, LONG_CALLSIGN_LENGTH, callsign);
 }
 
 void CHeaderData::setRptCall2(const wxString& callsign)
 {
-	m_rptCall2 = callsign;
-	m_rptCall2.Append(wxT(' '), LONG_CALLSIGN_LENGTH);
-	m_rptCall2.Truncate(LONG_CALLSIGN_LENGTH);
+	setCallsign(RPTCALL2_OFFSET, LONG_CALLSIGN_LENGTH, callsign);
+}
+
+void CHeaderData::setMyCall1(const unsigned char* callsign)
+{
+	wxASSERT(callsign != NULL);
+
+	::memcpy(m_header + MYCALL1_OFFSET, callsign, LONG_CALLSIGN_LENGTH);
+}
+
+void CHeaderData::setMyCall2(const unsigned char* callsign)
+{
+	wxASSERT(callsign != NULL);
+
+	::memcpy(m_header + MYCALL2_OFFSET, callsign, SHORT_CALLSIGN_LENGTH);
+}
+
+void CHeaderData::setYourCall(const unsigned char* callsign)
+{
+	wxASSERT(callsign != NULL);
+
+	::memcpy(m_header + YOURCALL_OFFSET, callsign, LONG_CALLSIGN_LENGTH);
+}
+
+void CHeaderData::setRptCall1(const unsigned char* callsign)
+{
+	wxASSERT(callsign != NULL);
+
+	::memcpy(m_header + RPTCALL1_OFFSET, callsign, LONG_CALLSIGN_LENGTH);
+}
+
+void CHeaderData::setRptCall2(const unsigned char* callsign)
+{
+	wxASSERT(callsign != NULL);
+
+	::memcpy(m_header + RPTCALL2_OFFSET, callsign, LONG_CALLSIGN_LENGTH);
 }
 
 bool CHeaderData::isAck() const
 {
-	return (m_flag1 & ACK_FLAG) == ACK_FLAG;
+	return (m_header[FLAG1_OFFSET] & ACK_FLAG) == ACK_FLAG;
 }
 
 bool CHeaderData::isNoResponse() const
 {
-	return (m_flag1 & NO_RESPONSE) == NO_RESPONSE;
+	return (m_header[FLAG1_OFFSET] & NO_RESPONSE) == NO_RESPONSE;
 }
 
 bool CHeaderData::isRelayUnavailable() const
 {
-	return (m_flag1 & RELAY_UNAVAILABLE) == RELAY_UNAVAILABLE;
+	return (m_header[FLAG1_OFFSET] & RELAY_UNAVAILABLE) == RELAY_UNAVAILABLE;
 }
 
 void CHeaderData::setRepeaterMode(bool set)
 {
 	if (set)
-		m_flag1 |= REPEATER_MASK;
+		m_header[FLAG1_OFFSET] |= REPEATER_MASK;
 	else
-		m_flag1 &= ~REPEATER_MASK;
+		m_header[FLAG1_OFFSET] &= ~REPEATER_MASK;
 }
 
 bool CHeaderData::isRepeaterMode() const
 {
-	return (m_flag1 & REPEATER_MASK) == REPEATER_MASK;
+	return (m_header[FLAG1_OFFSET] & REPEATER_MASK) == REPEATER_MASK;
 }
 
 void CHeaderData::setDataPacket(bool set)
 {
 	if (set)
-		m_flag1 |= DATA_MASK;
+		m_header[FLAG1_OFFSET] |= DATA_MASK;
 	else
-		m_flag1 &= ~DATA_MASK;
+		m_header[FLAG1_OFFSET] &= ~DATA_MASK;
 }
 
 bool CHeaderData::isDataPacket() const
 {
-	return (m_flag1 & DATA_MASK) == DATA_MASK;
+	return (m_header[FLAG1_OFFSET] & DATA_MASK) == DATA_MASK;
 }
 
 void CHeaderData::setInterrupted(bool set)
 {
 	if (set)
-		m_flag1 |= INTERRUPTED_MASK;
+		m_header[FLAG1_OFFSET] |= INTERRUPTED_MASK;
 	else
-		m_flag1 &= ~INTERRUPTED_MASK;
+		m_header[FLAG1_OFFSET] &= ~INTERRUPTED_MASK;
 }
 
 bool CHeaderData::isInterrupted() const
 {
-	return (m_flag1 & INTERRUPTED_MASK) == INTERRUPTED_MASK;
+	return (m_header[FLAG1_OFFSET] & INTERRUPTED_MASK) == INTERRUPTED_MASK;
 }
 
 void CHeaderData::setControlSignal(bool set)
 {
 	if (set)
-		m_flag1 |= CONTROL_SIGNAL_MASK;
+		m_header[FLAG1_OFFSET] |= CONTROL_SIGNAL_MASK;
 	else
-		m_flag1 &= ~CONTROL_SIGNAL_MASK;
+		m_header[FLAG1_OFFSET] &= ~CONTROL_SIGNAL_MASK;
 }
 
 bool CHeaderData::isControlSignal() const
 {
-	return (m_flag1 & CONTROL_SIGNAL_MASK) == CONTROL_SIGNAL_MASK;
+	return (m_header[FLAG1_OFFSET] & CONTROL_SIGNAL_MASK) == CONTROL_SIGNAL_MASK;
 }
 
 void CHeaderData::setUrgent(bool set)
 {
 	if (set)
-		m_flag1 |= URGENT_MASK;
+		m_header[FLAG1_OFFSET] |= URGENT_MASK;
 	else
-		m_flag1 &= ~URGENT_MASK;
+		m_header[FLAG1_OFFSET] &= ~URGENT_MASK;
 }
 
 bool CHeaderData::isUrgent() const
 {
-	return (m_flag1 & URGENT_MASK) == URGENT_MASK;
+	return (m_header[FLAG1_OFFSET] & URGENT_MASK) == URGENT_MASK;
 }
 
 void CHeaderData::setFlag1(unsigned char flag)
 {
-	m_flag1 = flag;
+	m_header[FLAG1_OFFSET] = flag;
 }
 
 void CHeaderData::setFlag2(unsigned char flag)
 {
-	m_flag2 = flag;
+	m_header[FLAG2_OFFSET] = flag;
 }
 
 void CHeaderData::setFlag3(unsigned char flag)
 {
-	m_flag3 = flag;
+	m_header[FLAG3_OFFSET] = flag;
 }
 
 void CHeaderData::setRepeaterFlags(unsigned char set)
 {
-	m_flag1 &= ~REPEATER_CONTROL_MASK;
-	m_flag1 |= set & REPEATER_CONTROL_MASK;
+	m_header[FLAG1_OFFSET] &= ~REPEATER_CONTROL_MASK;
+	m_header[FLAG1_OFFSET] |= set & REPEATER_CONTROL_MASK;
 }
 
 unsigned char CHeaderData::getRepeaterFlags() const
 {
-	return m_flag1 & REPEATER_CONTROL_MASK;
+	return m_header[FLAG1_OFFSET] & REPEATER_CONTROL_MASK;
 }
 
 bool CHeaderData::isValid() const
@@ -320,31 +385,55 @@ bool CHeaderData::isValid() const
 
 void CHeaderData::reset()
 {
-	m_myCall1  = wxT("        ");
-	m_myCall2  = wxT("    ");
-	m_yourCall = wxT("CQCQCQ  ");
-	m_rptCall1 = wxT("DIRECT  ");
-	m_rptCall2 = wxT("DIRECT  ");
+	setCallsign(MYCALL1_OFFSET,  LONG_CALLSIGN_LENGTH,  wxT("        "));
+	setCallsign(MYCALL2_OFFSET,  SHORT_CALLSIGN_LENGTH, wxT("    "));
+	setCallsign(YOURCALL_OFFSET, LONG_CALLSIGN_LENGTH,  wxT("CQCQCQ  "));
+	setCallsign(RPTCALL1_OFFSET, LONG_CALLSIGN_LENGTH,  wxT("DIRECT  "));
+	setCallsign(RPTCALL2_OFFSET, LONG_CALLSIGN_LENGTH,  wxT("DIRECT  "));
 
-	m_flag1 = 0x00;
-	m_flag2 = 0x00;
-	m_flag3 = 0x00;
+	m_header[FLAG1_OFFSET] = 0x00;
+	m_header[FLAG2_OFFSET] = 0x00;
+	m_header[FLAG3_OFFSET] = 0x00;
 }
 
 CHeaderData& CHeaderData::operator=(const CHeaderData& header)
 {
 	if (&header != this) {
-		m_time     = header.m_time;
-		m_myCall1  = header.m_myCall1;
-		m_myCall2  = header.m_myCall2;
-		m_yourCall = header.m_yourCall;
-		m_rptCall1 = header.m_rptCall1;
-		m_rptCall2 = header.m_rptCall2;
-		m_flag1    = header.m_flag1;
-		m_flag2    = header.m_flag2;
-		m_flag3    = header.m_flag3;
-		m_valid    = header.m_valid;
+		m_time  = header.m_time;
+		m_valid = header.m_valid;
+
+		::memcpy(m_header, header.m_header, HEADER_LENGTH);
 	}
 
 	return *this;
 }
+
+wxString CHeaderData::getCallsign(unsigned int offset, unsigned int length) const
+{
+	// An unset header has nulls in it
+	unsigned int len = 0U;
+	while (len < length && m_header[offset + len] != 0x00U)
+		len++;
+
+	return wxString((const char*)(m_header + offset), wxConvLocal, len);
+}
+
+// Padded with spaces, or truncated, to the length of the field
+void CHeaderData::setCallsign(unsigned int offset, unsigned int length, const wxString& callsign)
+{
+	unsigned int len = callsign.Len();
+
+	for (unsigned int i = 0U; i < length; i++)
+		m_header[offset + i] = (i < len) ? (unsigned char)(wxChar)callsign.GetChar(i) : ' ';
+}
+
+// A callsign that ends early, with a null, is not the same
+bool CHeaderData::isCallsign(unsigned int offset, const wxChar* callsign, unsigned int length) const
+{
+	for (unsigned int i = 0U; i < length; i++) {
+		if (callsign[i] == 0 || wxChar(m_header[offset + i]) != callsign[i])
+			return false;
+	}
+
+	return true;
+}
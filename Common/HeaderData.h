@@ -19,9 +19,13 @@
 #ifndef	HeaderData_H
 #define	HeaderData_H
 
+#include "DStarDefines.h"
+
 #include <wx/wx.h>
 #include <wx/datetime.h>
 
+// The header is held as the bytes sent over the air, without the checksum. The callsigns are only
+// turned into strings when asked for, the byte based calls below are used on the hot path instead.
 class CHeaderData {
 public:
 	CHeaderData();
@@ -39,6 +43,23 @@ public:
 	wxString   getRptCall1() const;
 	wxString   getRptCall2() const;
 
+	void getMyCall1(unsigned char* callsign) const;
+	void getMyCall2(unsigned char* callsign) const;
+	void getYourCall(unsigned char* callsign) const;
+	void getRptCall1(unsigned char* callsign) const;
+	void getRptCall2(unsigned char* callsign) const;
+
+	// Compare a callsign with no conversion, if length is given then only the first length characters
+	// of each are compared, as with Left(length).IsSameAs()
+	bool isMyCall1(const wxString& callsign) const;
+	bool isMyCall1(const wxChar* callsign, unsigned int length) const;
+	bool isYourCall(const wxString& callsign) const;
+	bool isRptCall1(const wxString& callsign) const;
+	bool isRptCall2(const wxString& callsign) const;
+
+	// Copies out the flags and callsigns, followed by the checksum if there is room and it is asked for
+	void getData(unsigned char* data, unsigned int length, bool check) const;
+
 	unsigned char getFlag1() const;
 	unsigned char getFlag2() const;
 	unsigned char getFlag3() const;
@@ -63,6 +84,12 @@ public:
 	void setRptCall1(const wxString& callsign);
 	void setRptCall2(const wxString& callsign);
 
+	void setMyCall1(const unsigned char* callsign);
+	void setMyCall2(const unsigned char* callsign);
+	void setYourCall(const unsigned char* callsign);
+	void setRptCall1(const unsigned char* callsign);
+	void setRptCall2(const unsigned char* callsign);
+
 	void setRepeaterMode(bool set);
 	void setDataPacket(bool set);
 	void setInterrupted(bool set);
@@ -78,15 +105,12 @@ public:
 
 private:
 	wxDateTime    m_time;
-	wxString      m_myCall1;
-	wxString      m_myCall2;
-	wxString      m_yourCall;
-	wxString      m_rptCall1;
-	wxString      m_rptCall2;
-	unsigned char m_flag1;
-	unsigned char m_flag2;
-	unsigned char m_flag3;
+	unsigned char m_header[RADIO_HEADER_LENGTH_BYTES - 2U];
 	bool          m_valid;
+
+	wxString getCallsign(unsigned int offset, unsigned int length) const;
+	void     setCallsign(unsigned int offset, unsigned int length, const wxString& callsign);
+	bool     isCallsign(unsigned int offset, const wxChar* callsign, unsigned int length) const;
 };
 
 #endif
@@ -18,6 +18,7 @@
 
 #include "IcomController.h"
 #include "DStarDefines.h"
+#include "Logger.h"
 #include "Timer.h"
 #include "Utils.h"
 
@@ -27,23 +28,27 @@
 #include <wx/dir.h>
 #endif
 
-enum STATE_ICOM {
-	SI_NONE,
-	SI_HEADER,
-	SI_DATA
-};
-
 const unsigned int MAX_RESPONSES = 30U;
 
 const unsigned int BUFFER_LENGTH = 200U;
 
-CIcomController::CIcomController(const wxString& port) :
+// The type of a header sent to the radio, the data frames are 0x22
+const unsigned char ICOM_HEADER_TYPE = 0x20U;
+
+// How long to wait for an ACK before sending a frame again, in microseconds
+const wxUint64 RETRY_TIME = 50000U;
+
+CIcomController::CIcomController(const wxString& port, bool assertRTS) :
 CModem(),
 m_port(port),
-m_serial(port, SERIAL_38400, true),
+m_serial(port, SERIAL_38400, assertRTS),
+m_framer(this, BUFFER_LENGTH),
 m_txData(2000U),
 m_txCounter(0U),
-m_pktCounter(0U)
+m_pktCounter(0U),
+m_frames(),
+m_frameHead(0U),
+m_frameCount(0U)
 {
 	wxASSERT(!port.IsEmpty());
 }
@@ -58,6 +63,8 @@ bool CIcomController::start()
 	if (!ret)
 		return false;
 
+	addPort(m_serial.getFD());
+
 	Create();
 	SetPriority(100U);
 	Run();
@@ -67,27 +74,19 @@ bool CIcomController::start()
 
 void* CIcomController::Entry()
 {
+	CLogger::startThread();
+
 	wxLogMessage(wxT("Starting Icom Controller thread"));
 
-	// Clock every 5ms-ish
-	CTimer pollTimer(200U, 0U, 100U);
+	CTimer pollTimer(1000U, 0U, 100U);
 	pollTimer.start();
 
-	CTimer retryTimer(200U, 0U, 50U);
-
-	CTimer lostTimer(200U, 5U);
+	CTimer lostTimer(1000U, 5U);
 	lostTimer.start();
-	
-	unsigned char storeData[BUFFER_LENGTH];
-	unsigned int storeLength = 0U;
-	
+
 	unsigned int pollCount = 0U;
-	
+
 	bool connected = false;
-	
-	STATE_ICOM    state   = SI_NONE;
-	unsigned char seqNo   = 0U;
-	bool          txSpace = true;
 
 	while (!m_stopped) {
 		if (pollTimer.hasExpired()) {
@@ -104,7 +103,7 @@ void* CIcomController::Entry()
 			pollCount++;
 		}
 
-		unsigned char buffer[BUFFER_LENGTH];
+		unsigned char* buffer = NULL;
 		unsigned int length = 0U;
 		RESP_TYPE_ICOM type = getResponse(buffer, length);
 
@@ -119,49 +118,30 @@ void* CIcomController::Entry()
 		case RTI_HEADER: {
 				// CUtils::dump(wxT("RTI_HEADER"), buffer, length);
 
-				wxMutexLocker locker(m_mutex);
-
-				unsigned char data[2U];
-				data[0U] = DSMTT_HEADER;
-				data[1U] = RADIO_HEADER_LENGTH_BYTES;
-				m_rxData.addData(data, 2U);
-
-				m_rxData.addData(buffer + 2U, RADIO_HEADER_LENGTH_BYTES);
+				writeRX(DSMTT_HEADER, buffer + 2U, RADIO_HEADER_LENGTH_BYTES);
 
 				lostTimer.start();
-				txSpace = true;
+				clearFrames();
 			}
 			break;
 
 		case RTI_DATA: {
 				// CUtils::dump(wxT("RTI_DATA"), buffer, length);
 
-				wxMutexLocker locker(m_mutex);
-
-				unsigned char data[2U];
-				data[0U] = DSMTT_DATA;
-				data[1U] = DV_FRAME_LENGTH_BYTES;
-				m_rxData.addData(data, 2U);
-
-				m_rxData.addData(buffer + 4U, DV_FRAME_LENGTH_BYTES);
+				writeRX(DSMTT_DATA, buffer + 4U, DV_FRAME_LENGTH_BYTES);
 
 				lostTimer.start();
-				txSpace = true;
+				clearFrames();
 			}
 			break;
 
 		case RTI_EOT: {
 				// wxLogMessage(wxT("RTI_EOT"));
 
-				wxMutexLocker locker(m_mutex);
-
-				unsigned char data[2U];
-				data[0U] = DSMTT_EOT;
-				data[1U] = 0U;
-				m_rxData.addData(data, 2U);
+				writeRX(DSMTT_EOT);
 
 				lostTimer.start();
-				txSpace = true;
+				clearFrames();
 			}
 			break;
 
@@ -176,11 +156,7 @@ void* CIcomController::Entry()
 		case RTI_HEADER_ACK:
 			if (buffer[2U] == 0x00U) {
 				// wxLogMessage(wxT("RTI_HEADER_ACK"));
-				if (state == SI_HEADER) {
-					storeLength = 0U;
-					retryTimer.stop();
-					txSpace = true;
-				}
+				ackFrame(true, 0U);
 			} else {
 				wxLogMessage(wxT("RTI_HEADER_NAK"));
 			}
@@ -191,11 +167,7 @@ void* CIcomController::Entry()
 		case RTI_DATA_ACK:
 			if (buffer[3U] == 0x00U) {
 				// wxLogMessage(wxT("RTI_DATA_ACK - %02X"), buffer[2U]);
-				if (state == SI_DATA && seqNo == buffer[2U]) {
-					storeLength = 0U;
-					retryTimer.stop();
-					txSpace = true;
-				}
+				ackFrame(false, buffer[2U]);
 			} else {
 				wxLogMessage(wxT("RTI_DATA_NAK - %02X"), buffer[2U]);
 			}
@@ -208,52 +180,30 @@ void* CIcomController::Entry()
 			CUtils::dump(wxT("Buffer dump"), buffer, length);
 			break;
 		}
-		
-		if (retryTimer.isRunning() && retryTimer.hasExpired()) {
-			assert(storeLength > 0U);
 
-			// CUtils::dump(wxT("Re-Sending"), storeData, storeLength + 1U);
+		bool sent = resendFrames();
 
-			int ret = m_serial.write(storeData, storeLength + 1U);
-			if (ret != int(storeLength + 1U))
-				wxLogWarning(wxT("Error when writing to the Icom radio"));
+		if (sendFrames())
+			sent = true;
 
-			retryTimer.start();
+		// Anything sent keeps the link up without a poll
+		if (sent)
 			pollTimer.start();
-		}
-
-		if (txSpace && !m_txData.isEmpty()) {
-			m_txData.getData(storeData, 1U);
 
-			storeLength = storeData[0U];
-			m_txData.getData(storeData + 1U, storeLength);
+		if (type == RTI_TIMEOUT && !sent) {
+			unsigned int timeout = pollTimer.getRemainingTicks();
 
-			// CUtils::dump(wxT("Sending"), storeData, storeLength + 1U);
+			unsigned int lost = lostTimer.getRemainingTicks();
+			if (lost < timeout)
+				timeout = lost;
 
-			if (storeData[1U] == 0x20U) {
-				state = SI_HEADER;
-				seqNo = 0U;
-			} else {
-				state = SI_DATA;
-				seqNo = storeData[2U];
-			}
-
-			int ret = m_serial.write(storeData, storeLength + 1U);
-			if (ret != int(storeLength + 1U))
-				wxLogWarning(wxT("Error when writing to the Icom radio"));
-
-			retryTimer.start();
-			pollTimer.start();
-
-			txSpace = false;
+			waitForEvent(getNextRetry(timeout));
 		}
 
-		Sleep(5UL);
+		unsigned int ms = getElapsed();
+		pollTimer.clock(ms);
+		lostTimer.clock(ms);
 
-		pollTimer.clock();
-		lostTimer.clock();
-		retryTimer.clock();
-		
 		if (lostTimer.hasExpired()) {
 			if (connected)
 				wxLogWarning(wxT("Lost connection to the Icom radio"));
@@ -262,12 +212,7 @@ void* CIcomController::Entry()
 			pollTimer.start();
 			pollCount = 0U;
 
-			retryTimer.stop();
-			storeLength = 0U;
-
-			state = SI_NONE;
-			seqNo = 0U;
-			txSpace = true;
+			clearFrames();
 
 			lostTimer.start();
 			connected = false;
@@ -293,42 +238,19 @@ bool CIcomController::writeHeader(const CHeaderData& header)
 
 	buffer[0U] = 0x29U;
 
-	buffer[1U] = 0x20U;
+	buffer[1U] = ICOM_HEADER_TYPE;
 
 	::memset(buffer + 2U, ' ', RADIO_HEADER_LENGTH_BYTES);
 
-	buffer[2U] = header.getFlag1();
-	buffer[3U] = header.getFlag2();
-	buffer[4U] = header.getFlag3();
-
-	wxString rpt2 = header.getRptCall2();
-	for (unsigned int i = 0U; i < rpt2.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 5U]  = rpt2.GetChar(i);
-
-	wxString rpt1 = header.getRptCall1();
-	for (unsigned int i = 0U; i < rpt1.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 13U] = rpt1.GetChar(i);
-
-	wxString your = header.getYourCall();
-	for (unsigned int i = 0U; i < your.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 21U] = your.GetChar(i);
-
-	wxString my1 = header.getMyCall1();
-	for (unsigned int i = 0U; i < my1.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 29U] = my1.GetChar(i);
-
-	wxString my2 = header.getMyCall2();
-	for (unsigned int i = 0U; i < my2.Len() && i < SHORT_CALLSIGN_LENGTH; i++)
-		buffer[i + 37U] = my2.GetChar(i);
+	header.getData(buffer + 2U, RADIO_HEADER_LENGTH_BYTES - 2U, false);
 
 	buffer[41U] = 0xFFU;
 
 	m_txCounter  = 0U;
 	m_pktCounter = 0U;
 
-	wxMutexLocker locker(m_mutex);
-
 	m_txData.addData(buffer, 42U);
+	m_events.signal();
 
 	return true;
 }
@@ -355,9 +277,8 @@ bool CIcomController::writeData(const unsigned char* data, unsigned int, bool en
 
 		buffer[16U] = 0xFFU;
 
-		wxMutexLocker locker(m_mutex);
-
 		m_txData.addData(buffer, 17U);
+		m_events.signal();
 
 		return true;
 	}
@@ -378,9 +299,8 @@ bool CIcomController::writeData(const unsigned char* data, unsigned int, bool en
 
 	buffer[16U] = 0xFFU;
 
-	wxMutexLocker locker(m_mutex);
-
 	m_txData.addData(buffer, 17U);
+	m_events.signal();
 
 	return true;
 }
@@ -400,60 +320,25 @@ wxString CIcomController::getPath() const
 	return wxEmptyString;
 }
 
-RESP_TYPE_ICOM CIcomController::getResponse(unsigned char *buffer, unsigned int& length)
+RESP_TYPE_ICOM CIcomController::getResponse(unsigned char*& buffer, unsigned int& length)
 {
-	// Get the start of the frame or nothing at all
-	int ret = m_serial.read(buffer, 1U);
-	if (ret < 0) {
-		wxLogError(wxT("Error when reading the length from the Icom radio"));
-		return RTI_ERROR;
-	}
-
-	if (ret == 0)
-		return RTI_TIMEOUT;
-
-	if (buffer[0U] == 0xFFU)
-		return RTI_TIMEOUT;
-
-	length = buffer[0U];
-
-	// Validate the message lengths
-	if (buffer[0U] != 0x03U && buffer[0U] != 0x04U && buffer[0U] != 0x10U && buffer[0U] != 0x2CU) {
-		wxLogError(wxT("Invalid data length received from the Icom radio - 0x%02X"), length);
-		return RTI_TIMEOUT;
-	}
-
-	ret = m_serial.read(buffer + 1U, 1U, 40U);
-	if (ret < 0) {
-		wxLogError(wxT("Error when reading the type from the Icom radio"));
-		return RTI_ERROR;
-	}
+	// Only go to the port when there is no whole frame left from the last read
+	buffer = m_framer.getFrame(length);
+	if (buffer == NULL) {
+		unsigned int space;
+		unsigned char* data = m_framer.getSpace(space);
 
-	if (ret == 0)
-		return RTI_TIMEOUT;
-
-	// Validate the message types
-	if (buffer[1U] != 0x03U && buffer[1U] != 0x10U && buffer[1U] != 0x12U && buffer[1U] != 0x21U && buffer[1U] != 0x23U) {
-		wxLogError(wxT("Invalid data type received from the Icom radio - 0x%02X"), buffer[1U]);
-		return RTI_TIMEOUT;
-	}
-
-	unsigned int offset = 2U;
-
-	while (offset < length) {
-		ret = m_serial.read(buffer + offset, length - offset, 40U);
+		int ret = m_serial.readNonblock(data, space);
 		if (ret < 0) {
-			wxLogError(wxT("Error when reading data from the Icom radio"));
+			wxLogError(wxT("Error when reading from the Icom radio"));
 			return RTI_ERROR;
 		}
 
-		if (ret > 0)
-			offset += ret;
+		m_framer.addData(ret);
 
-		if (ret == 0) {
-			// CUtils::dump(wxT("Receive timed out"), buffer, offset);
+		buffer = m_framer.getFrame(length);
+		if (buffer == NULL)
 			return RTI_TIMEOUT;
-		}
 	}
 
 	// CUtils::dump(wxT("Received"), buffer, length);
@@ -477,6 +362,30 @@ RESP_TYPE_ICOM CIcomController::getResponse(unsigned char *buffer, unsigned int&
 	}
 }
 
+int CIcomController::getFrameLength(const unsigned char* data, unsigned int length)
+{
+	// Each frame is followed by an 0xFF, as are the polls echoed back
+	if (data[0U] == 0xFFU)
+		return -1;
+
+	// Validate the message lengths
+	if (data[0U] != 0x03U && data[0U] != 0x04U && data[0U] != 0x10U && data[0U] != 0x2CU) {
+		wxLogError(wxT("Invalid data length received from the Icom radio - 0x%02X"), data[0U]);
+		return -1;
+	}
+
+	if (length < 2U)
+		return 0;
+
+	// Validate the message types
+	if (data[1U] != 0x03U && data[1U] != 0x10U && data[1U] != 0x12U && data[1U] != 0x21U && data[1U] != 0x23U) {
+		wxLogError(wxT("Invalid data type received from the Icom radio - 0x%02X"), data[1U]);
+		return -2;
+	}
+
+	return data[0U];
+}
+
 bool CIcomController::writePoll()
 {
 	return m_serial.write((unsigned char*)"\xFF\xFF\xFF", 3U) == 3;
@@ -486,3 +395,120 @@ bool CIcomController::writePing()
 {
 	return m_serial.write((unsigned char*)"\x02\x02\xFF", 3U) == 3;
 }
+
+// Fill the window from the queue
+bool CIcomController::sendFrames()
+{
+	bool sent = false;
+
+	while (m_frameCount < ICOM_TX_WINDOW && !m_txData.isEmpty()) {
+		// A header goes on its own, with nothing before or after it waiting for an ACK
+		if (m_frameCount > 0U) {
+			const CIcomFrame& last = m_frames[(m_frameHead + m_frameCount - 1U) % ICOM_TX_WINDOW];
+			if (last.m_header)
+				break;
+
+			// The frames are queued whole, so the length and type of the next one are always there
+			unsigned char next[2U];
+			m_txData.peek(next, 2U);
+			if (next[1U] == ICOM_HEADER_TYPE)
+				break;
+		}
+
+		CIcomFrame& frame = m_frames[(m_frameHead + m_frameCount) % ICOM_TX_WINDOW];
+
+		m_txData.getData(frame.m_data, 1U);
+		frame.m_length = frame.m_data[0U] + 1U;
+		m_txData.getData(frame.m_data + 1U, frame.m_length - 1U);
+
+		frame.m_header = frame.m_data[1U] == ICOM_HEADER_TYPE;
+		frame.m_seqNo  = frame.m_header ? 0U : frame.m_data[2U];
+		frame.m_acked  = false;
+
+		writeFrame(frame);
+
+		m_frameCount++;
+		sent = true;
+	}
+
+	return sent;
+}
+
+// Each frame that hasn't been ACKed in time is sent again on its own
+bool CIcomController::resendFrames()
+{
+	wxUint64 now = CUtils::getTimestamp();
+
+	bool sent = false;
+
+	for (unsigned int i = 0U; i < m_frameCount; i++) {
+		CIcomFrame& frame = m_frames[(m_frameHead + i) % ICOM_TX_WINDOW];
+
+		if (!frame.m_acked && (now - frame.m_sent) >= RETRY_TIME) {
+			// CUtils::dump(wxT("Re-Sending"), frame.m_data, frame.m_length);
+			writeFrame(frame);
+			sent = true;
+		}
+	}
+
+	return sent;
+}
+
+// Milliseconds until the first frame waiting for an ACK is due to be sent again, or limit if none is
+unsigned int CIcomController::getNextRetry(unsigned int limit) const
+{
+	wxUint64 now = CUtils::getTimestamp();
+
+	for (unsigned int i = 0U; i < m_frameCount; i++) {
+		const CIcomFrame& frame = m_frames[(m_frameHead + i) % ICOM_TX_WINDOW];
+
+		if (!frame.m_acked) {
+			wxUint64 elapsed = now - frame.m_sent;
+			if (elapsed >= RETRY_TIME)
+				return 0U;
+
+			// Rounded up, so that the frame is due when the thread wakes
+			unsigned int next = (unsigned int)((RETRY_TIME - elapsed + 999U) / 1000U);
+			if (next < limit)
+				limit = next;
+		}
+	}
+
+	return limit;
+}
+
+void CIcomController::ackFrame(bool header, unsigned char seqNo)
+{
+	for (unsigned int i = 0U; i < m_frameCount; i++) {
+		CIcomFrame& frame = m_frames[(m_frameHead + i) % ICOM_TX_WINDOW];
+
+		if (frame.m_header == header && frame.m_seqNo == seqNo) {
+			frame.m_acked = true;
+			break;
+		}
+	}
+
+	// The window only moves on past frames that have all been ACKed
+	while (m_frameCount > 0U && m_frames[m_frameHead].m_acked) {
+		m_frameHead = (m_frameHead + 1U) % ICOM_TX_WINDOW;
+		m_frameCount--;
+	}
+}
+
+// Nothing more will be ACKed, the frames are given up on
+void CIcomController::clearFrames()
+{
+	m_frameHead  = 0U;
+	m_frameCount = 0U;
+}
+
+void CIcomController::writeFrame(CIcomFrame& frame)
+{
+	// CUtils::dump(wxT("Sending"), frame.m_data, frame.m_length);
+
+	int ret = m_serial.write(frame.m_data, frame.m_length);
+	if (ret != int(frame.m_length))
+		wxLogWarning(wxT("Error when writing to the Icom radio"));
+
+	frame.m_sent = CUtils::getTimestamp();
+}
@@ -20,6 +20,7 @@
 #define	IcomController_H
 
 #include "SerialDataController.h"
+#include "SerialFramer.h"
 #include "RingBuffer.h"
 #include "Modem.h"
 #include "Utils.h"
@@ -38,9 +39,24 @@ enum RESP_TYPE_ICOM {
 	RTI_PONG
 };
 
-class CIcomController : public CModem {
+// The longest frame sent to the radio, a header
+const unsigned int ICOM_FRAME_LENGTH = 42U;
+
+// The ACKs carry the sequence number of the frame, so more than one can be waiting for its ACK
+const unsigned int ICOM_TX_WINDOW = 4U;
+
+struct CIcomFrame {
+	unsigned char m_data[ICOM_FRAME_LENGTH];
+	unsigned int  m_length;
+	bool          m_header;
+	unsigned char m_seqNo;
+	bool          m_acked;
+	wxUint64      m_sent;
+};
+
+class CIcomController : public CModem, public ISerialProtocol {
 public:
-	CIcomController(const wxString& port);
+	CIcomController(const wxString& port, bool assertRTS = true);
 	virtual ~CIcomController();
 
 	virtual void* Entry();
@@ -55,16 +71,29 @@ public:
 
 	virtual wxString getPath() const;
 
+	virtual int getFrameLength(const unsigned char* data, unsigned int length);
+
 private:
 	wxString                   m_port;
 	CSerialDataController      m_serial;
+	CSerialFramer              m_framer;
 	CRingBuffer<unsigned char> m_txData;
 	unsigned char              m_txCounter;
 	unsigned char              m_pktCounter;
+	CIcomFrame                 m_frames[ICOM_TX_WINDOW];
+	unsigned int               m_frameHead;
+	unsigned int               m_frameCount;
 
-	RESP_TYPE_ICOM getResponse(unsigned char* buffer, unsigned int& length);
+	RESP_TYPE_ICOM getResponse(unsigned char*& buffer, unsigned int& length);
 	bool writePoll();
 	bool writePing();
+
+	bool sendFrames();
+	bool resendFrames();
+	unsigned int getNextRetry(unsigned int limit) const;
+	void ackFrame(bool header, unsigned char seqNo);
+	void clearFrames();
+	void writeFrame(CIcomFrame& frame);
 };
 
 #endif
@@ -0,0 +1,250 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "JitterBuffer.h"
+
+// How far ahead of the playout point a frame may be
+const unsigned int WINDOW_FRAMES = JITTER_SLOTS - 3U;
+
+// The latency is held as eight times the value, and the jitter as four times, as in the TCP RTT estimator
+const unsigned int LATENCY_SHIFT = 3U;
+const unsigned int JITTER_SHIFT  = 2U;
+
+// Half a second of frames before the jitter is trusted
+const unsigned int MIN_SAMPLES = 25U;
+
+CJitterBuffer::CJitterBuffer(unsigned int minDelay, unsigned int maxDelay) :
+m_minDelay(minDelay),
+m_maxDelay(maxDelay),
+m_frames(),
+m_samples(0U),
+m_latency(0),
+m_jitter(0),
+m_time(0U),
+m_delay(maxDelay),
+m_lastDelay(maxDelay),
+m_started(false),
+m_outSeqNo(0U),
+m_outFrame(0U),
+m_lastFrame(-1),
+m_missing(0U),
+m_late(0U),
+m_reordered(0U)
+{
+	wxASSERT(minDelay <= maxDelay);
+	wxASSERT(maxDelay < (WINDOW_FRAMES * DSTAR_FRAME_TIME_MS));
+
+	reset();
+}
+
+CJitterBuffer::~CJitterBuffer()
+{
+}
+
+void CJitterBuffer::reset()
+{
+	for (unsigned int i = 0U; i < JITTER_SLOTS; i++) {
+		m_frames[i].m_valid = false;
+		m_frames[i].m_end   = false;
+	}
+
+	m_lastDelay = m_delay;
+
+	m_time      = 0U;
+	m_started   = false;
+	m_outSeqNo  = 0U;
+	m_outFrame  = 0U;
+	m_lastFrame = -1;
+	m_missing   = 0U;
+	m_late      = 0U;
+	m_reordered = 0U;
+
+	calculateDelay();
+}
+
+bool CJitterBuffer::write(unsigned int seqNo, bool end, const unsigned char* data, unsigned int length)
+{
+	wxASSERT(data != NULL);
+
+	if (seqNo >= JITTER_SLOTS)
+		return false;
+
+	// The sequence number only covers 420ms, so a frame that would be far ahead of the playout point
+	// must really be an old one that has missed it
+	int offset = int((seqNo + JITTER_SLOTS - m_outSeqNo) % JITTER_SLOTS);
+	if (offset >= int(WINDOW_FRAMES) || getLateness(m_outFrame + offset) < -int(m_maxDelay))
+		offset -= int(JITTER_SLOTS);
+
+	int frameNo = int(m_outFrame) + offset;
+	if (frameNo < 0) {
+		m_late++;
+		return false;
+	}
+
+	// Late frames are measured too, they show that the delay is too short
+	int late = getLateness(frameNo);
+
+	if (m_samples > 0U) {
+		int err = late - (m_latency >> LATENCY_SHIFT);
+		m_latency += err;
+
+		if (err < 0)
+			err = -err;
+		m_jitter += err - (m_jitter >> JITTER_SHIFT);
+	} else {
+		m_latency = late * int(1U << LATENCY_SHIFT);
+		m_jitter  = 0;
+	}
+
+	if (m_samples < MIN_SAMPLES)
+		m_samples++;
+
+	if (offset < 0) {
+		m_late++;
+		return false;
+	}
+
+	CJitterFrame& frame = m_frames[seqNo];
+	if (frame.m_valid)
+		return false;
+
+	if (frameNo < m_lastFrame)
+		m_reordered++;
+	else
+		m_lastFrame = frameNo;
+
+	frame.m_valid = true;
+	frame.m_end   = end;
+
+	if (!end) {
+		if (length > DV_FRAME_LENGTH_BYTES)
+			length = DV_FRAME_LENGTH_BYTES;
+
+		::memset(frame.m_data, 0x00U, DV_FRAME_LENGTH_BYTES);
+		::memcpy(frame.m_data, data, length);
+	}
+
+	return true;
+}
+
+JITTER_FRAME CJitterBuffer::read(unsigned char* data)
+{
+	wxASSERT(data != NULL);
+
+	// The delay may still follow the jitter until the first frame has been played
+	if (!m_started)
+		calculateDelay();
+
+	if (m_time < ((m_outFrame + 1U) * DSTAR_FRAME_TIME_MS + m_delay))
+		return JF_NONE;
+
+	m_started = true;
+
+	CJitterFrame& frame = m_frames[m_outSeqNo];
+
+	JITTER_FRAME type = JF_DATA;
+	if (!frame.m_valid) {
+		type = JF_MISSING;
+		m_missing++;
+	} else if (frame.m_end) {
+		type = JF_END;
+	} else {
+		::memcpy(data, frame.m_data, DV_FRAME_LENGTH_BYTES);
+	}
+
+	frame.m_valid = false;
+	frame.m_end   = false;
+
+	m_outSeqNo++;
+	if (m_outSeqNo >= JITTER_SLOTS)
+		m_outSeqNo = 0U;
+
+	m_outFrame++;
+
+	return type;
+}
+
+void CJitterBuffer::clock(unsigned int ms)
+{
+	m_time += ms;
+}
+
+unsigned int CJitterBuffer::getNext() const
+{
+	unsigned int due = (m_outFrame + 1U) * DSTAR_FRAME_TIME_MS + m_delay;
+	if (m_time >= due)
+		return 1U;
+
+	return due - m_time;
+}
+
+unsigned int CJitterBuffer::getDelay() const
+{
+	return m_delay;
+}
+
+unsigned int CJitterBuffer::getJitter() const
+{
+	return (unsigned int)(m_jitter >> JITTER_SHIFT);
+}
+
+unsigned int CJitterBuffer::getMissing() const
+{
+	return m_missing;
+}
+
+unsigned int CJitterBuffer::getLate() const
+{
+	return m_late;
+}
+
+unsigned int CJitterBuffer::getReordered() const
+{
+	return m_reordered;
+}
+
+// How late a frame is compared to when it was sent, assuming the header was sent just before the first frame
+int CJitterBuffer::getLateness(int frameNo) const
+{
+	return int(m_time) - (frameNo + 1) * int(DSTAR_FRAME_TIME_MS);
+}
+
+// The delay covers the average latency plus four times the jitter, as in the TCP retransmission timer. It
+// rises at once but only falls by one frame per transmission, a quiet spell on the link is often followed
+// by the jitter coming back.
+void CJitterBuffer::calculateDelay()
+{
+	// Until enough frames have been seen, wait for as long as allowed
+	if (m_samples < MIN_SAMPLES) {
+		m_delay = m_maxDelay;
+		return;
+	}
+
+	int delay = (m_latency >> LATENCY_SHIFT) + m_jitter;
+
+	int lowest = int(m_lastDelay) - int(DSTAR_FRAME_TIME_MS);
+	if (delay < lowest)
+		delay = lowest;
+
+	if (delay < int(m_minDelay))
+		m_delay = m_minDelay;
+	else if (delay > int(m_maxDelay))
+		m_delay = m_maxDelay;
+	else
+		m_delay = (unsigned int)delay;
+}
@@ -0,0 +1,92 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	JitterBuffer_H
+#define	JitterBuffer_H
+
+#include "DStarDefines.h"
+
+#include <wx/wx.h>
+
+const unsigned int JITTER_SLOTS = 21U;
+
+enum JITTER_FRAME {
+	JF_NONE,
+	JF_DATA,
+	JF_MISSING,
+	JF_END
+};
+
+struct CJitterFrame {
+	bool          m_valid;
+	bool          m_end;
+	unsigned char m_data[DV_FRAME_LENGTH_BYTES];
+};
+
+// Puts the frames of a network transmission back into order and plays them out on a clock. The
+// playout delay is set from the arrival jitter of the frames that came before, it is fixed once a
+// transmission starts to play as any change would break the slow data.
+class CJitterBuffer {
+public:
+	CJitterBuffer(unsigned int minDelay, unsigned int maxDelay);
+	~CJitterBuffer();
+
+	// Start a new transmission, the measured jitter is carried over
+	void         reset();
+
+	// Returns false if the frame is too late, out of the window, or a duplicate
+	bool         write(unsigned int seqNo, bool end, const unsigned char* data, unsigned int length);
+
+	JITTER_FRAME read(unsigned char* data);
+
+	void         clock(unsigned int ms);
+
+	// Milliseconds until read() will next give a frame, or report one missing, never less than one
+	unsigned int getNext() const;
+
+	unsigned int getDelay() const;
+	unsigned int getJitter() const;
+
+	// The statistics of the current transmission
+	unsigned int getMissing() const;
+	unsigned int getLate() const;
+	unsigned int getReordered() const;
+
+private:
+	unsigned int m_minDelay;
+	unsigned int m_maxDelay;
+	CJitterFrame m_frames[JITTER_SLOTS];
+	unsigned int m_samples;
+	int          m_latency;
+	int          m_jitter;
+	unsigned int m_time;
+	unsigned int m_delay;
+	unsigned int m_lastDelay;
+	bool         m_started;
+	unsigned int m_outSeqNo;
+	unsigned int m_outFrame;
+	int          m_lastFrame;
+	unsigned int m_missing;
+	unsigned int m_late;
+	unsigned int m_reordered;
+
+	int          getLateness(int frameNo) const;
+	void         calculateDelay();
+};
+
+#endif
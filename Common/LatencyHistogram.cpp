@@ -0,0 +1,113 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "LatencyHistogram.h"
+
+CLatencyHistogram::CLatencyHistogram(unsigned int bucketWidth, unsigned int buckets) :
+m_bucketWidth(bucketWidth),
+m_buckets(buckets),
+m_counts(NULL),
+m_count(0U),
+m_total(0U),
+m_max(0U)
+{
+	wxASSERT(bucketWidth > 0U);
+	wxASSERT(buckets > 0U);
+
+	m_counts = new unsigned int[buckets + 1U];
+
+	reset();
+}
+
+CLatencyHistogram::~CLatencyHistogram()
+{
+	delete[] m_counts;
+}
+
+void CLatencyHistogram::add(wxUint64 latency)
+{
+	wxUint64 bucket = latency / m_bucketWidth;
+	if (bucket > m_buckets)
+		bucket = m_buckets;
+
+	m_counts[bucket]++;
+	m_count++;
+
+	m_total += latency;
+	if (latency > m_max)
+		m_max = latency;
+}
+
+unsigned int CLatencyHistogram::getCount() const
+{
+	return m_count;
+}
+
+wxUint64 CLatencyHistogram::getPercentile(unsigned int percent) const
+{
+	wxASSERT(percent <= 100U);
+
+	if (m_count == 0U)
+		return 0U;
+
+	wxUint64 target = (wxUint64(m_count) * percent + 99U) / 100U;
+
+	wxUint64 sum = 0U;
+	for (unsigned int i = 0U; i < m_buckets; i++) {
+		sum += m_counts[i];
+		if (sum >= target)
+			return wxUint64(i + 1U) * m_bucketWidth;
+	}
+
+	return m_max;
+}
+
+void CLatencyHistogram::log(const wxString& title) const
+{
+	if (m_count == 0U)
+		return;
+
+	wxLogMessage(wxT("%s: %u frames, mean: %.1fms, 50%%: %.1fms, 90%%: %.1fms, 99%%: %.1fms, max: %.1fms"), title.c_str(), m_count,
+		double(m_total) / double(m_count) / 1000.0, double(getPercentile(50U)) / 1000.0, double(getPercentile(90U)) / 1000.0,
+		double(getPercentile(99U)) / 1000.0, double(m_max) / 1000.0);
+
+	wxString text;
+	for (unsigned int i = 0U; i <= m_buckets; i++) {
+		if (m_counts[i] == 0U)
+			continue;
+
+		wxString bucket;
+		if (i < m_buckets)
+			bucket.Printf(wxT(" <%.1fms:%u"), double((i + 1U) * m_bucketWidth) / 1000.0, m_counts[i]);
+		else
+			bucket.Printf(wxT(" >=%.1fms:%u"), double(m_buckets * m_bucketWidth) / 1000.0, m_counts[i]);
+
+		text.Append(bucket);
+	}
+
+	wxLogMessage(wxT("%s:%s"), title.c_str(), text.c_str());
+}
+
+void CLatencyHistogram::reset()
+{
+	::memset(m_counts, 0x00, (m_buckets + 1U) * sizeof(unsigned int));
+
+	m_count = 0U;
+	m_total = 0U;
+	m_max   = 0U;
+}
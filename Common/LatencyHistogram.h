@@ -0,0 +1,50 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	LatencyHistogram_H
+#define	LatencyHistogram_H
+
+#include <wx/wx.h>
+
+// Latencies in microseconds, counted into fixed width buckets with a final bucket for anything longer
+class CLatencyHistogram {
+public:
+	CLatencyHistogram(unsigned int bucketWidth, unsigned int buckets);
+	~CLatencyHistogram();
+
+	void         add(wxUint64 latency);
+
+	unsigned int getCount() const;
+
+	// The upper edge of the bucket holding the given percentile
+	wxUint64     getPercentile(unsigned int percent) const;
+
+	void         log(const wxString& title) const;
+
+	void         reset();
+
+private:
+	unsigned int  m_bucketWidth;
+	unsigned int  m_buckets;
+	unsigned int* m_counts;
+	unsigned int  m_count;
+	wxUint64      m_total;
+	wxUint64      m_max;
+};
+
+#endif
@@ -17,15 +17,20 @@
  */
 
 #include "LogEvent.h"
+#include "Utils.h"
 
-CLogEvent::CLogEvent(const wxString& text, wxEventType type, int id) :
+CLogEvent::CLogEvent(wxChar letter, time_t timestamp, const wxString& text, wxEventType type, int id) :
 wxEvent(id, type),
+m_letter(letter),
+m_timestamp(timestamp),
 m_text(text)
 {
 }
 
 CLogEvent::CLogEvent(const CLogEvent& event) :
 wxEvent(event),
+m_letter(event.m_letter),
+m_timestamp(event.m_timestamp),
 m_text(event.m_text)
 {
 }
@@ -36,7 +41,13 @@ CLogEvent::~CLogEvent()
 
 wxString CLogEvent::getText() const
 {
-	return m_text;
+	struct tm tm;
+	CUtils::getUTC(m_timestamp, tm);
+
+	wxString text;
+	text.Printf(wxT("%c: %04d-%02d-%02d %02d:%02d:%02d: %s\n"), m_letter, tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec, m_text.c_str());
+
+	return text;
 }
 
 wxEvent* CLogEvent::Clone() const
@@ -21,9 +21,12 @@
 
 #include <wx/wx.h>
 
+#include <ctime>
+
+// Carries the record as it was logged, it is only formatted when the event is handled
 class CLogEvent : public wxEvent {
 public:
-	CLogEvent(const wxString& text, wxEventType type, int id = 0);
+	CLogEvent(wxChar letter, time_t timestamp, const wxString& text, wxEventType type, int id = 0);
 	virtual ~CLogEvent();
 
 	virtual wxString getText() const;
@@ -34,6 +37,8 @@ protected:
 	CLogEvent(const CLogEvent& event);
 
 private:
+	wxChar   m_letter;
+	time_t   m_timestamp;
 	wxString m_text;
 };
 
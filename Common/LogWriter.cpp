@@ -0,0 +1,226 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "LogWriter.h"
+#include "Utils.h"
+
+const unsigned long LOG_POLL_TIME    = 20UL;
+const long          LOG_FLUSH_TIME   = 500L;
+const size_t        LOG_BATCH_LENGTH = 4096U;
+
+CLogWriter::CLogWriter(const wxString& directory, const wxString& name) :
+wxThread(wxTHREAD_JOINABLE),
+m_name(name),
+m_file(),
+m_fileName(),
+m_day(0),
+m_records(NULL),
+m_inPos(0U),
+m_outPos(0U),
+m_dropped(0U),
+m_reported(0U),
+m_buffer(),
+m_bufferTime(),
+m_killed(false)
+{
+	m_records = new CLogRecord[LOG_QUEUE_LENGTH];
+
+	// A slot is free to be written when its sequence matches the position being written
+	for (unsigned int i = 0U; i < LOG_QUEUE_LENGTH; i++)
+		m_records[i].m_sequence.store(i, std::memory_order_relaxed);
+
+	m_fileName.SetPath(directory);
+	m_fileName.SetExt(wxT("log"));
+
+	time_t timestamp;
+	::time(&timestamp);
+
+	struct tm tm;
+	CUtils::getUTC(timestamp, tm);
+
+	open(tm);
+}
+
+CLogWriter::~CLogWriter()
+{
+	if (m_file.IsOpened())
+		m_file.Close();
+
+	delete[] m_records;
+}
+
+bool CLogWriter::write(wxChar letter, time_t timestamp, const wxString& text)
+{
+	CLogRecord* record = NULL;
+
+	unsigned int pos = m_inPos.load(std::memory_order_relaxed);
+	for (;;) {
+		record = m_records + (pos & (LOG_QUEUE_LENGTH - 1U));
+
+		unsigned int sequence = record->m_sequence.load(std::memory_order_acquire);
+		int diff = int(sequence - pos);
+
+		if (diff == 0) {
+			if (m_inPos.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			// The writer has fallen a whole queue behind
+			m_dropped.fetch_add(1U, std::memory_order_relaxed);
+			return false;
+		} else {
+			pos = m_inPos.load(std::memory_order_relaxed);
+		}
+	}
+
+	unsigned int length = text.Len();
+	if (length > LOG_TEXT_LENGTH)
+		length = LOG_TEXT_LENGTH;
+
+	record->m_timestamp = timestamp;
+	record->m_letter    = letter;
+	record->m_length    = length;
+	::memcpy(record->m_text, text.wx_str(), length * sizeof(wxChar));
+
+	record->m_sequence.store(pos + 1U, std::memory_order_release);
+
+	return true;
+}
+
+unsigned int CLogWriter::getDropped() const
+{
+	return m_dropped.load(std::memory_order_relaxed);
+}
+
+void CLogWriter::start()
+{
+	Create();
+	Run();
+}
+
+void* CLogWriter::Entry()
+{
+	while (!m_killed) {
+		Sleep(LOG_POLL_TIME);
+
+		drain();
+
+		if (!m_buffer.IsEmpty() && m_bufferTime.Time() >= LOG_FLUSH_TIME)
+			flush();
+	}
+
+	drain();
+	flush();
+
+	return NULL;
+}
+
+void CLogWriter::kill()
+{
+	m_killed = true;
+
+	Wait();
+}
+
+void CLogWriter::writeNow(wxChar letter, time_t timestamp, const wxString& text)
+{
+	format(letter, timestamp, text.wx_str(), text.Len());
+	flush();
+}
+
+void CLogWriter::drain()
+{
+	for (;;) {
+		CLogRecord& record = m_records[m_outPos & (LOG_QUEUE_LENGTH - 1U)];
+		if (record.m_sequence.load(std::memory_order_acquire) != (m_outPos + 1U))
+			break;
+
+		format(record.m_letter, record.m_timestamp, record.m_text, record.m_length);
+
+		// Hand the slot back for the next time round the queue
+		record.m_sequence.store(m_outPos + LOG_QUEUE_LENGTH, std::memory_order_release);
+		m_outPos++;
+	}
+
+	unsigned int dropped = m_dropped.load(std::memory_order_relaxed);
+	if (dropped != m_reported) {
+		wxString text;
+		text.Printf(wxT("%u log messages have been dropped"), dropped - m_reported);
+		m_reported = dropped;
+
+		time_t timestamp;
+		::time(&timestamp);
+
+		format(wxT('W'), timestamp, text.wx_str(), text.Len());
+	}
+}
+
+void CLogWriter::format(wxChar letter, time_t timestamp, const wxChar* text, unsigned int length)
+{
+	wxASSERT(text != NULL);
+
+	struct tm tm;
+	CUtils::getUTC(timestamp, tm);
+
+	// Anything from the day before goes into its own file
+	if (tm.tm_yday != m_day) {
+		flush();
+		open(tm);
+	}
+
+	if (m_buffer.IsEmpty())
+		m_bufferTime.Start();
+
+	wxString header;
+	header.Printf(wxT("%c: %04d-%02d-%02d %02d:%02d:%02d: "), letter, tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+
+	m_buffer.Append(header);
+	m_buffer.Append(text, length);
+	m_buffer.Append(wxT('\n'));
+
+	if (m_buffer.Len() >= LOG_BATCH_LENGTH)
+		flush();
+}
+
+void CLogWriter::open(const struct tm& tm)
+{
+	wxString text;
+	text.Printf(wxT("%s-%04d-%02d-%02d"), m_name.c_str(), tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday);
+
+	m_day = tm.tm_yday;
+	m_fileName.SetName(text);
+
+	if (m_file.IsOpened())
+		m_file.Close();
+
+	bool ret = m_file.Open(m_fileName.GetFullPath(), wxT("a+t"));
+	if (!ret)
+		wxLogError(wxT("Cannot open %s file for appending"), m_fileName.GetFullPath().c_str());
+}
+
+void CLogWriter::flush()
+{
+	if (m_buffer.IsEmpty())
+		return;
+
+	if (m_file.IsOpened()) {
+		m_file.Write(m_buffer);
+		m_file.Flush();
+	}
+
+	m_buffer.Clear();
+}
@@ -0,0 +1,84 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	LogWriter_H
+#define	LogWriter_H
+
+#include <wx/wx.h>
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+#include <atomic>
+
+#include <ctime>
+
+const unsigned int LOG_QUEUE_LENGTH = 1024U;		// Must be a power of two
+const unsigned int LOG_TEXT_LENGTH  = 300U;
+
+struct CLogRecord {
+	std::atomic<unsigned int> m_sequence;
+	time_t                    m_timestamp;
+	wxChar                    m_letter;
+	unsigned int              m_length;
+	wxChar                    m_text[LOG_TEXT_LENGTH];
+};
+
+// Writes the log file on its own thread. Any thread may queue a record without blocking, the records
+// are formatted and written out in batches, and the file is flushed once enough text has built up or
+// it has waited long enough. A record that does not fit in the queue is counted and dropped.
+class CLogWriter : public wxThread {
+public:
+	CLogWriter(const wxString& directory, const wxString& name);
+	virtual ~CLogWriter();
+
+	// Never blocks, returns false if the record had to be dropped
+	bool write(wxChar letter, time_t timestamp, const wxString& text);
+
+	unsigned int getDropped() const;
+
+	void start();
+
+	virtual void* Entry();
+
+	// Writes out anything still queued before returning
+	void kill();
+
+	// Only to be used once the thread has been killed
+	void writeNow(wxChar letter, time_t timestamp, const wxString& text);
+
+private:
+	wxString                  m_name;
+	wxFFile                   m_file;
+	wxFileName                m_fileName;
+	int                       m_day;
+	CLogRecord*               m_records;
+	std::atomic<unsigned int> m_inPos;
+	unsigned int              m_outPos;
+	std::atomic<unsigned int> m_dropped;
+	unsigned int              m_reported;
+	wxString                  m_buffer;
+	wxStopWatch               m_bufferTime;
+	bool                      m_killed;
+
+	void drain();
+	void format(wxChar letter, time_t timestamp, const wxChar* text, unsigned int length);
+	void open(const struct tm& tm);
+	void flush();
+};
+
+#endif
@@ -18,99 +18,68 @@
 
 #include "Logger.h"
 
+wxLog* CLogger::m_threadTarget = NULL;
+
 CLogger::CLogger(const wxString& directory, const wxString& name) :
 wxLog(),
-m_name(name),
-m_file(NULL),
-m_fileName(),
-m_day(0)
+m_writer(NULL)
 {
-	m_file = new wxFFile;
-
-	m_fileName.SetPath(directory);
-	m_fileName.SetExt(wxT("log"));
-
-	time_t timestamp;
-	::time(&timestamp);
-	struct tm* tm = ::gmtime(&timestamp);
-
-	wxString text;
-	text.Printf(wxT("%s-%04d-%02d-%02d"), m_name.c_str(), tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday);
-
-	m_day = tm->tm_yday;
-	m_fileName.SetName(text);
-
-	bool ret = m_file->Open(m_fileName.GetFullPath(), wxT("a+t"));
-	if (!ret) {
-		wxLogError(wxT("Cannot open %s file for appending"), m_fileName.GetFullPath().c_str());
-		return;
-	}
+	m_writer = new CLogWriter(directory, name);
+	m_writer->start();
 }
 
 CLogger::~CLogger()
 {
-	wxASSERT(m_file != NULL);
+	wxASSERT(m_writer != NULL);
 
-	m_file->Close();
-	delete m_file;
+	m_writer->kill();
+	delete m_writer;
 }
 
 void CLogger::DoLogRecord(wxLogLevel level, const wxString& msg, const wxLogRecordInfo& info)
 {
-	wxASSERT(m_file != NULL);
-	wxASSERT(m_file->IsOpened());
+	wxASSERT(m_writer != NULL);
 
-	wxString letter;
+	wxChar letter;
 
 	switch (level) {
-		case wxLOG_FatalError: letter = wxT("F"); break;
-		case wxLOG_Error:      letter = wxT("E"); break;
-		case wxLOG_Warning:    letter = wxT("W"); break;
-		case wxLOG_Info:       letter = wxT("I"); break;
-		case wxLOG_Message:    letter = wxT("M"); break;
-		case wxLOG_Status:     letter = wxT("M"); break;
-		case wxLOG_Trace:      letter = wxT("T"); break;
-		case wxLOG_Debug:      letter = wxT("D"); break;
-		default:               letter = wxT("U"); break;
+		case wxLOG_FatalError: letter = wxT('F'); break;
+		case wxLOG_Error:      letter = wxT('E'); break;
+		case wxLOG_Warning:    letter = wxT('W'); break;
+		case wxLOG_Info:       letter = wxT('I'); break;
+		case wxLOG_Message:    letter = wxT('M'); break;
+		case wxLOG_Status:     letter = wxT('M'); break;
+		case wxLOG_Trace:      letter = wxT('T'); break;
+		case wxLOG_Debug:      letter = wxT('D'); break;
+		default:               letter = wxT('U'); break;
 	}
 
-	struct tm* tm = ::gmtime(&info.timestamp);
+	bool ret = m_writer->write(letter, info.timestamp, msg);
 
-	wxString message;
-	message.Printf(wxT("%s: %04d-%02d-%02d %02d:%02d:%02d: %s\n"), letter.c_str(), tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, msg.c_str());
+	if (level == wxLOG_FatalError) {
+		// Get everything onto the disk before stopping
+		m_writer->kill();
+		if (!ret)
+			m_writer->writeNow(letter, info.timestamp, msg);
 
-	writeLog(message.c_str(), info.timestamp);
-
-	if (level == wxLOG_FatalError)
 		::abort();
+	}
 }
 
-void CLogger::writeLog(const wxChar* msg, time_t timestamp)
+unsigned int CLogger::getDropped() const
 {
-	wxASSERT(m_file != NULL);
-	wxASSERT(m_file->IsOpened());
-	wxASSERT(msg != NULL);
+	wxASSERT(m_writer != NULL);
 
-	struct tm* tm = ::gmtime(&timestamp);
-
-	int day = tm->tm_yday;
-	if (day != m_day) {
-		wxString text;
-		text.Printf(wxT("%s-%04d-%02d-%02d"), m_name.c_str(), tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday);
-
-		m_day = day;
-		m_fileName.SetName(text);
-
-		m_file->Close();
-
-		bool ret = m_file->Open(m_fileName.GetFullPath(), wxT("a+t"));
-		if (!ret) {
-			wxLogError(wxT("Cannot open %s file for appending"), m_fileName.GetFullPath().c_str());
-			return;
-		}
-	}
+	return m_writer->getDropped();
+}
 
-	m_file->Write(wxString(msg));
-	m_file->Flush();
+void CLogger::setThreadTarget(wxLog* log)
+{
+	m_threadTarget = log;
 }
 
+void CLogger::startThread()
+{
+	if (m_threadTarget != NULL)
+		wxLog::SetThreadActiveTarget(m_threadTarget);
+}
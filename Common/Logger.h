@@ -19,10 +19,11 @@
 #ifndef	Logger_H
 #define	Logger_H
 
+#include "LogWriter.h"
+
 #include <wx/wx.h>
-#include <wx/ffile.h>
-#include <wx/filename.h>
 
+// The records are handed to a CLogWriter, so logging never waits for the disk
 class CLogger : public wxLog {
 public:
 	CLogger(const wxString& directory, const wxString& name);
@@ -30,13 +31,19 @@ public:
 
 	virtual void DoLogRecord(wxLogLevel level, const wxString& msg, const wxLogRecordInfo& info);
 
+	unsigned int getDropped() const;
+
+	// The log that the worker threads write to, normally the active log of the main thread
+	static void setThreadTarget(wxLog* log);
+
+	// Called at the start of a worker thread, so that its records go to the log writer directly
+	// rather than being held by wxWidgets until the main thread is idle
+	static void startThread();
+
 private:
-	wxString   m_name;
-	wxFFile*   m_file;
-	wxFileName m_fileName;
-	int        m_day;
+	CLogWriter* m_writer;
 
-	void writeLog(const wxChar* msg, time_t timestamp);
+	static wxLog* m_threadTarget;
 };
 
 #endif
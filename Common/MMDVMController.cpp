@@ -19,6 +19,7 @@
 #include "CCITTChecksumReverse.h"
 #include "MMDVMController.h"
 #include "DStarDefines.h"
+#include "Logger.h"
 #include "Timer.h"
 
 #if defined(__WINDOWS__)
@@ -52,7 +53,10 @@ const unsigned int MAX_RESPONSES = 30U;
 
 const unsigned int BUFFER_LENGTH = 200U;
 
-CMMDVMController::CMMDVMController(const wxString& port, const wxString& path, bool rxInvert, bool txInvert, bool pttInvert, unsigned int txDelay, unsigned int rxLevel, unsigned int txLevel) :
+// Slots kept in the modem, enough to cover a status poll arriving late
+const unsigned int TX_FILL = 8U;
+
+CMMDVMController::CMMDVMController(const wxString& port, const wxString& path, bool rxInvert, bool txInvert, bool pttInvert, unsigned int txDelay, unsigned int rxLevel, unsigned int txLevel, bool assertRTS) :
 CModem(),
 m_port(port),
 m_path(path),
@@ -62,19 +66,18 @@ m_pttInvert(pttInvert),
 m_txDelay(txDelay),
 m_rxLevel(rxLevel),
 m_txLevel(txLevel),
-m_serial(port, SERIAL_115200, true),
+m_serial(port, SERIAL_115200, assertRTS),
 m_buffer(NULL),
+m_framer(this, BUFFER_LENGTH),
 m_txData(1000U),
+m_credit(TX_FILL),
 m_rx(false)
 {
 	wxASSERT(!port.IsEmpty());
-
-	m_buffer = new unsigned char[BUFFER_LENGTH];
 }
 
 CMMDVMController::~CMMDVMController()
 {
-	delete[] m_buffer;
 }
 
 bool CMMDVMController::start()
@@ -96,18 +99,17 @@ bool CMMDVMController::start()
 
 void* CMMDVMController::Entry()
 {
+	CLogger::startThread();
+
 	wxLogMessage(wxT("Starting MMDVM Controller thread"));
 
-	// Clock every 5ms-ish
-	CTimer pollTimer(200U, 0U, 100U);
+	CTimer pollTimer(1000U, 0U, 100U);
 	pollTimer.start();
 
 	unsigned char  writeType   = DSMTT_NONE;
 	unsigned char  writeLength = 0U;
 	unsigned char* writeBuffer = new unsigned char[BUFFER_LENGTH];
 
-	unsigned int space = 0U;
-
 	while (!m_stopped) {
 		// Poll the modem status every 100ms
 		if (pollTimer.hasExpired()) {
@@ -141,14 +143,7 @@ void* CMMDVMController::Entry()
 
 			case RTDVM_DSTAR_HEADER: {
 					// CUtils::dump(wxT("RT_DSTAR_HEADER"), m_buffer, length);
-					wxMutexLocker locker(m_mutex);
-
-					unsigned char data[2U];
-					data[0U] = DSMTT_HEADER;
-					data[1U] = RADIO_HEADER_LENGTH_BYTES;
-					m_rxData.addData(data, 2U);
-
-					m_rxData.addData(m_buffer + 3U, RADIO_HEADER_LENGTH_BYTES);
+					writeRX(DSMTT_HEADER, m_buffer + 3U, RADIO_HEADER_LENGTH_BYTES);
 
 					m_rx = true;
 				}
@@ -156,14 +151,7 @@ void* CMMDVMController::Entry()
 
 			case RTDVM_DSTAR_DATA: {
 					// CUtils::dump(wxT("RT_DSTAR_DATA"), m_buffer, length);
-					wxMutexLocker locker(m_mutex);
-
-					unsigned char data[2U];
-					data[0U] = DSMTT_DATA;
-					data[1U] = DV_FRAME_LENGTH_BYTES;
-					m_rxData.addData(data, 2U);
-
-					m_rxData.addData(m_buffer + 3U, DV_FRAME_LENGTH_BYTES);
+					writeRX(DSMTT_DATA, m_buffer + 3U, DV_FRAME_LENGTH_BYTES);
 
 					m_rx = true;
 				}
@@ -171,12 +159,7 @@ void* CMMDVMController::Entry()
 
 			case RTDVM_DSTAR_EOT: {
 					// wxLogMessage(wxT("RT_DSTAR_EOT"));
-					wxMutexLocker locker(m_mutex);
-
-					unsigned char data[2U];
-					data[0U] = DSMTT_EOT;
-					data[1U] = 0U;
-					m_rxData.addData(data, 2U);
+					writeRX(DSMTT_EOT);
 
 					m_rx = false;
 				}
@@ -184,12 +167,7 @@ void* CMMDVMController::Entry()
 
 			case RTDVM_DSTAR_LOST: {
 					// wxLogMessage(wxT("RT_DSTAR_LOST"));
-					wxMutexLocker locker(m_mutex);
-
-					unsigned char data[2U];
-					data[0U] = DSMTT_LOST;
-					data[1U] = 0U;
-					m_rxData.addData(data, 2U);
+					writeRX(DSMTT_LOST);
 
 					m_rx = false;
 				}
@@ -209,9 +187,9 @@ void* CMMDVMController::Entry()
 					if (adcOverflow)
 						wxLogWarning(wxT("MMDVM ADC levels have overflowed"));
 
-					space = m_buffer[6U];
+					m_credit.setSpace(m_buffer[6U]);
 					// CUtils::dump(wxT("GET_STATUS"), m_buffer, length);
-					// wxLogMessage(wxT("PTT=%d space=%u"), int(m_tx), space);
+					// wxLogMessage(wxT("PTT=%d space=%u"), int(m_tx), m_buffer[6U]);
 				}
 				break;
 
@@ -256,39 +234,55 @@ void* CMMDVMController::Entry()
 				break;
 		}
 
-		if (writeType == DSMTT_NONE && m_txData.hasData()) {
-			wxMutexLocker locker(m_mutex);
+		// Keep going while there is more to read or write, otherwise sleep until there is
+		bool idle = type == RTDVM_TIMEOUT;
 
+		if (writeType == DSMTT_NONE && m_txData.hasData()) {
 			m_txData.getData(&writeType, 1U);
 			m_txData.getData(&writeLength, 1U);
 			m_txData.getData(writeBuffer, writeLength);
 		}
 
-		if (space > 4U && writeType == DSMTT_HEADER) {
+		if (m_credit.getSpace() > 4U && writeType == DSMTT_HEADER) {
 			// CUtils::dump(wxT("Write Header"), writeBuffer, writeLength);
 
 			int ret = m_serial.write(writeBuffer, writeLength);
 			if (ret != int(writeLength))
 				wxLogWarning(wxT("Error when writing the header to the MMDVM"));
 
+			m_credit.write(4U);
 			writeType = DSMTT_NONE;
-			space -= 4U;
+			idle = false;
 		}
 
-		if (space > 1U && (writeType == DSMTT_DATA || writeType == DSMTT_EOT)) {
+		if (m_credit.getSpace() > 1U && (writeType == DSMTT_DATA || writeType == DSMTT_EOT)) {
 			// CUtils::dump(wxT("Write Data"), writeBuffer, writeLength);
 
 			int ret = m_serial.write(writeBuffer, writeLength);
 			if (ret != int(writeLength))
 				wxLogWarning(wxT("Error when writing data to the MMDVM"));
 
+			m_credit.write(1U, writeType == DSMTT_EOT);
+			if (writeType == DSMTT_EOT)
+				m_credit.log(wxT("MMDVM TX buffer"));
+
 			writeType = DSMTT_NONE;
-			space--;
+			idle = false;
 		}
 
-		Sleep(5UL);
+		if (idle) {
+			unsigned int timeout = pollTimer.getRemainingTicks();
+
+			// A write held back for want of space can go once the modem has sent the next slot
+			if (writeType != DSMTT_NONE)
+				timeout = m_credit.getNext(timeout);
 
-		pollTimer.clock();
+			waitForEvent(timeout);
+		}
+
+		unsigned int ms = getElapsed();
+		pollTimer.clock(ms);
+		m_credit.clock(ms);
 	}
 
 	wxLogMessage(wxT("Stopping MMDVM Controller thread"));
@@ -316,43 +310,13 @@ bool CMMDVMController::writeHeader(const CHeaderData& header)
 
 	::memset(buffer + 3U, ' ', RADIO_HEADER_LENGTH_BYTES);
 
-	buffer[3U] = header.getFlag1();
-	buffer[4U] = header.getFlag2();
-	buffer[5U] = header.getFlag3();
-
-	wxString rpt2 = header.getRptCall2();
-	for (unsigned int i = 0U; i < rpt2.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 6U]  = rpt2.GetChar(i);
-
-	wxString rpt1 = header.getRptCall1();
-	for (unsigned int i = 0U; i < rpt1.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 14U] = rpt1.GetChar(i);
-
-	wxString your = header.getYourCall();
-	for (unsigned int i = 0U; i < your.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 22U] = your.GetChar(i);
-
-	wxString my1 = header.getMyCall1();
-	for (unsigned int i = 0U; i < my1.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 30U] = my1.GetChar(i);
-
-	wxString my2 = header.getMyCall2();
-	for (unsigned int i = 0U; i < my2.Len() && i < SHORT_CALLSIGN_LENGTH; i++)
-		buffer[i + 38U] = my2.GetChar(i);
+	header.getData(buffer + 3U, RADIO_HEADER_LENGTH_BYTES, true);
 
-	CCCITTChecksumReverse cksum1;
-	cksum1.update(buffer + 3U, RADIO_HEADER_LENGTH_BYTES - 2U);
-	cksum1.result(buffer + 42U);
-
-	wxMutexLocker locker(m_mutex);
-
-	unsigned char type = DSMTT_HEADER;
-	m_txData.addData(&type, 1U);
-
-	unsigned char len = RADIO_HEADER_LENGTH_BYTES + 3U;
-	m_txData.addData(&len, 1U);
-
-	m_txData.addData(buffer, RADIO_HEADER_LENGTH_BYTES + 3U);
+	unsigned char hdr[2U];
+	hdr[0U] = DSMTT_HEADER;
+	hdr[1U] = RADIO_HEADER_LENGTH_BYTES + 3U;
+	m_txData.addData(hdr, 2U, buffer, RADIO_HEADER_LENGTH_BYTES + 3U);
+	m_events.signal();
 
 	return true;
 }
@@ -372,15 +336,11 @@ bool CMMDVMController::writeData(const unsigned char* data, unsigned int length,
 		buffer[1U] = 3U;
 		buffer[2U] = MMDVM_DSTAR_EOT;
 
-		wxMutexLocker locker(m_mutex);
-
-		unsigned char type = DSMTT_EOT;
-		m_txData.addData(&type, 1U);
-
-		unsigned char len = 3U;
-		m_txData.addData(&len, 1U);
-
-		m_txData.addData(buffer, 3U);
+		unsigned char hdr[2U];
+		hdr[0U] = DSMTT_EOT;
+		hdr[1U] = 3U;
+		m_txData.addData(hdr, 2U, buffer, 3U);
+		m_events.signal();
 
 		return true;
 	}
@@ -390,15 +350,11 @@ bool CMMDVMController::writeData(const unsigned char* data, unsigned int length,
 	buffer[2U] = MMDVM_DSTAR_DATA;
 	::memcpy(buffer + 3U, data, DV_FRAME_LENGTH_BYTES);
 
-	wxMutexLocker locker(m_mutex);
-
-	unsigned char type = DSMTT_DATA;
-	m_txData.addData(&type, 1U);
-
-	unsigned char len = DV_FRAME_LENGTH_BYTES + 3U;
-	m_txData.addData(&len, 1U);
-
-	m_txData.addData(buffer, DV_FRAME_LENGTH_BYTES + 3U);
+	unsigned char hdr[2U];
+	hdr[0U] = DSMTT_DATA;
+	hdr[1U] = DV_FRAME_LENGTH_BYTES + 3U;
+	m_txData.addData(hdr, 2U, buffer, DV_FRAME_LENGTH_BYTES + 3U);
+	m_events.signal();
 
 	return true;
 }
@@ -544,52 +500,25 @@ bool CMMDVMController::setConfig()
 	return true;
 }
 
-RESP_TYPE_MMDVM CMMDVMController::getResponse(unsigned char *buffer, unsigned int& length)
+RESP_TYPE_MMDVM CMMDVMController::getResponse(unsigned char*& buffer, unsigned int& length)
 {
-	// Get the start of the frame or nothing at all
-	int ret = m_serial.read(buffer + 0U, 1U);
-	if (ret < 0) {
-		wxLogError(wxT("Error when reading from the MMDVM"));
-		return RTDVM_ERROR;
-	}
-
-	if (ret == 0)
-		return RTDVM_TIMEOUT;
-
-	if (buffer[0U] != MMDVM_FRAME_START)
-		return RTDVM_TIMEOUT;
+	// Only go to the port when there is no whole frame left from the last read
+	buffer = m_framer.getFrame(length);
+	if (buffer == NULL) {
+		unsigned int space;
+		unsigned char* data = m_framer.getSpace(space);
 
-	ret = m_serial.read(buffer + 1U, 1U);
-	if (ret < 0) {
-		wxLogError(wxT("Error when reading from the MMDVM"));
-		return RTDVM_ERROR;
-	}
-
-	if (ret == 0)
-		return RTDVM_TIMEOUT;
-
-	length = buffer[1U];
-
-	if (length >= BUFFER_LENGTH) {
-		wxLogError(wxT("Invalid data received from the MMDVM"));
-		CUtils::dump(wxT("Data"), buffer, 2U);
-		return RTDVM_TIMEOUT;
-	}
-
-	unsigned int offset = 2U;
-
-	while (offset < length) {
-		int ret = m_serial.read(buffer + offset, length - offset);
+		int ret = m_serial.readNonblock(data, space);
 		if (ret < 0) {
 			wxLogError(wxT("Error when reading from the MMDVM"));
 			return RTDVM_ERROR;
 		}
 
-		if (ret > 0)
-			offset += ret;
+		m_framer.addData(ret);
 
-		if (ret == 0)
-			Sleep(5UL);
+		buffer = m_framer.getFrame(length);
+		if (buffer == NULL)
+			return RTDVM_TIMEOUT;
 	}
 
 	// CUtils::dump(wxT("Received"), buffer, length);
@@ -628,6 +557,23 @@ RESP_TYPE_MMDVM CMMDVMController::getResponse(unsigned char *buffer, unsigned in
 	}
 }
 
+int CMMDVMController::getFrameLength(const unsigned char* data, unsigned int length)
+{
+	if (data[0U] != MMDVM_FRAME_START)
+		return -1;
+
+	if (length < 2U)
+		return 0;
+
+	if (data[1U] < 3U || data[1U] >= BUFFER_LENGTH) {
+		wxLogError(wxT("Invalid data received from the MMDVM"));
+		CUtils::dump(wxT("Data"), data, 2U);
+		return -2;
+	}
+
+	return data[1U];
+}
+
 wxString CMMDVMController::getPath() const
 {
 	return m_path;
@@ -781,12 +727,7 @@ bool CMMDVMController::findModem()
 
 	// Tell the repeater that the signal has gone away
 	if (m_rx) {
-		wxMutexLocker locker(m_mutex);
-
-		unsigned char data[2U];
-		data[0U] = DSMTT_EOT;
-		data[1U] = 0U;
-		m_rxData.addData(data, 2U);
+		writeRX(DSMTT_EOT);
 
 		m_rx = false;
 	}
@@ -821,6 +762,11 @@ bool CMMDVMController::openModem()
 	if (!ret)
 		return false;
 
+	m_framer.reset();
+	m_credit.reset();
+
+	addPort(m_serial.getFD());
+
 	ret = readVersion();
 	if (!ret) {
 		m_serial.close();
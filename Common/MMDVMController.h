@@ -20,7 +20,9 @@
 #define	MMDVMController_H
 
 #include "SerialDataController.h"
+#include "SerialFramer.h"
 #include "RingBuffer.h"
+#include "TXCredit.h"
 #include "Modem.h"
 #include "Utils.h"
 
@@ -46,9 +48,9 @@ enum RESP_TYPE_MMDVM {
 	RTDVM_DEBUG5
 };
 
-class CMMDVMController : public CModem {
+class CMMDVMController : public CModem, public ISerialProtocol {
 public:
-	CMMDVMController(const wxString& port, const wxString& path, bool rxInvert, bool txInvert, bool pttInvert, unsigned int txDelay, unsigned int rxLevel, unsigned int txLevel);
+	CMMDVMController(const wxString& port, const wxString& path, bool rxInvert, bool txInvert, bool pttInvert, unsigned int txDelay, unsigned int rxLevel, unsigned int txLevel, bool assertRTS = true);
 	virtual ~CMMDVMController();
 
 	virtual void* Entry();
@@ -63,6 +65,8 @@ public:
 
 	virtual wxString getPath() const;
 
+	virtual int getFrameLength(const unsigned char* data, unsigned int length);
+
 private:
 	wxString                   m_port;
 	wxString                   m_path;
@@ -74,14 +78,16 @@ private:
 	unsigned int               m_txLevel;
 	CSerialDataController      m_serial;
 	unsigned char*             m_buffer;
+	CSerialFramer              m_framer;
 	CRingBuffer<unsigned char> m_txData;
+	CTXCredit                  m_credit;
 	bool                       m_rx;
 
 	bool readVersion();
 	bool readStatus();
 	bool setConfig();
 
-	RESP_TYPE_MMDVM getResponse(unsigned char* buffer, unsigned int& length);
+	RESP_TYPE_MMDVM getResponse(unsigned char*& buffer, unsigned int& length);
 
 	bool findPort();
 	bool findPath();
@@ -18,20 +18,34 @@
 
 #include "DStarDefines.h"
 #include "Modem.h"
+#include "Utils.h"
 
 const unsigned int BUFFER_LENGTH = 200U;
 
+// Type, length and the timestamp
+const unsigned int RECORD_HEADER_LENGTH = 2U + sizeof(wxUint64);
+
+// When the port cannot wake the modem thread it is looked at this often
+const unsigned int CYCLE_TIME = 5U;
+
 CModem::CModem() :
 wxThread(wxTHREAD_JOINABLE),
 m_rxData(1000U),
-m_mutex(),
 m_tx(false),
 m_stopped(false),
+m_events(),
+m_poller(NULL),
+m_eventsOpen(false),
+m_elapsedTime(0U),
 m_readType(DSMTT_NONE),
 m_readLength(0U),
-m_readBuffer(NULL)
+m_readBuffer(NULL),
+m_readTime(0U)
 {
 	m_readBuffer = new unsigned char[BUFFER_LENGTH];
+
+	m_eventsOpen  = m_events.open();
+	m_elapsedTime = CUtils::getTimestamp();
 }
 
 CModem::~CModem()
@@ -51,24 +65,27 @@ DSMT_TYPE CModem::read()
 	if (m_rxData.isEmpty())
 		return DSMTT_NONE;
 
-	wxMutexLocker locker(m_mutex);
-
-	unsigned char hdr[2U];
-	m_rxData.getData(hdr, 2U);
+	// Each record is added to the ring buffer in one go, so a header is never seen without its payload
+	unsigned char hdr[RECORD_HEADER_LENGTH];
+	m_rxData.getData(hdr, RECORD_HEADER_LENGTH);
 
 	m_readType   = DSMT_TYPE(hdr[0U]);
 	m_readLength = hdr[1U];
+	::memcpy(&m_readTime, hdr + 2U, sizeof(wxUint64));
+
 	m_rxData.getData(m_readBuffer, m_readLength);
 
 	return m_readType;
 }
 
-CHeaderData* CModem::readHeader()
+bool CModem::readHeader(CHeaderData& header)
 {
 	if (m_readType != DSMTT_HEADER)
-		return NULL;
+		return false;
 
-	return new CHeaderData(m_readBuffer, RADIO_HEADER_LENGTH_BYTES, false);
+	header = CHeaderData(m_readBuffer, RADIO_HEADER_LENGTH_BYTES, false);
+
+	return true;
 }
 
 unsigned int CModem::readData(unsigned char* data, unsigned int length)
@@ -85,10 +102,76 @@ unsigned int CModem::readData(unsigned char* data, unsigned int length)
 	}
 }
 
+wxUint64 CModem::getReadTime() const
+{
+	return m_readTime;
+}
+
+void CModem::setPoller(CEventPoller* poller)
+{
+	m_poller.store(poller, std::memory_order_release);
+}
+
+void CModem::writeRX(DSMT_TYPE type, const unsigned char* data, unsigned int length)
+{
+	wxASSERT(length <= BUFFER_LENGTH);
+
+	wxUint64 timestamp = CUtils::getTimestamp();
+
+	unsigned char hdr[RECORD_HEADER_LENGTH];
+	hdr[0U] = type;
+	hdr[1U] = length;
+	::memcpy(hdr + 2U, &timestamp, sizeof(wxUint64));
+
+	m_rxData.addData(hdr, RECORD_HEADER_LENGTH, data, length);
+
+	CEventPoller* poller = m_poller.load(std::memory_order_acquire);
+	if (poller != NULL)
+		poller->signal();
+}
+
+void CModem::addPort(int fd)
+{
+	if (m_eventsOpen && fd >= 0)
+		m_events.addReader(fd);
+}
+
+void CModem::waitForEvent(unsigned int timeout)
+{
+#if defined(__linux__)
+	// The port wakes the thread, so it need not wake until the caller's next deadline
+	if (m_eventsOpen) {
+		m_events.wait(timeout);
+		return;
+	}
+#endif
+
+	if (timeout > CYCLE_TIME)
+		timeout = CYCLE_TIME;
+
+	if (m_eventsOpen)
+		m_events.wait(timeout);
+	else
+		Sleep(timeout);
+}
+
+unsigned int CModem::getElapsed()
+{
+	wxUint64 now = CUtils::getTimestamp();
+
+	// Keep the part of a millisecond left over for the next call
+	unsigned int ms = (unsigned int)((now - m_elapsedTime) / 1000U);
+	m_elapsedTime += ms * 1000U;
+
+	return ms;
+}
+
 void CModem::stop()
 {
 	m_stopped = true;
 
+	m_events.signal();
+
 	Wait();
 }
 
@@ -19,11 +19,14 @@
 #ifndef	Modem_H
 #define	Modem_H
 
+#include "EventPoller.h"
 #include "HeaderData.h"
 #include "RingBuffer.h"
 
 #include <wx/wx.h>
 
+#include <atomic>
+
 enum DSMT_TYPE {
 	DSMTT_NONE,
 	DSMTT_START,
@@ -48,21 +51,41 @@ public:
 	virtual bool isTX();
 
 	virtual DSMT_TYPE read();
-	virtual CHeaderData* readHeader();
+	virtual bool readHeader(CHeaderData& header);
 	virtual unsigned int readData(unsigned char* data, unsigned int length);
 
+	// When the modem thread queued the last record read, from CUtils::getTimestamp()
+	wxUint64 getReadTime() const;
+
+	// Signalled whenever a record is queued
+	void setPoller(CEventPoller* poller);
+
 	virtual void stop();
 
 protected:
 	CRingBuffer<unsigned char> m_rxData;
-	wxMutex                    m_mutex;
 	bool                       m_tx;
 	bool                       m_stopped;
+	CEventPoller               m_events;
+
+	void writeRX(DSMT_TYPE type, const unsigned char* data = NULL, unsigned int length = 0U);
+
+	// The modem thread sleeps until the port is readable, there is data to send, or the timeout, in
+	// milliseconds, has passed. Ports that cannot be waited on are polled every cycle instead.
+	void addPort(int fd);
+	void waitForEvent(unsigned int timeout);
+
+	// The milliseconds since the last call, for clocking the timers of the modem thread
+	unsigned int getElapsed();
 
 private:
+	std::atomic<CEventPoller*> m_poller;
+	bool                       m_eventsOpen;
+	wxUint64                   m_elapsedTime;
 	DSMT_TYPE                  m_readType;
 	unsigned int               m_readLength;
 	unsigned char*             m_readBuffer;
+	wxUint64                   m_readTime;
 };
 
 #endif
@@ -21,7 +21,8 @@
 COutputQueue::COutputQueue(unsigned int space, unsigned int threshold) :
 m_data(space),
 m_threshold(threshold),
-m_header(NULL),
+m_header(),
+m_hasHeader(false),
 m_count(0U)
 {
 	wxASSERT(space > 0U);
@@ -30,25 +31,24 @@ m_count(0U)
 
 COutputQueue::~COutputQueue()
 {
-	delete m_header;
 }
 
-void COutputQueue::setHeader(CHeaderData* header)
+void COutputQueue::setHeader(const CHeaderData& header)
 {
-	wxASSERT(header != NULL);
-
-	delete m_header;
-
-	m_header = header;
+	m_header    = header;
+	m_hasHeader = true;
 }
 
-CHeaderData* COutputQueue::getHeader()
+bool COutputQueue::getHeader(CHeaderData& header)
 {
-	CHeaderData* header = m_header;
+	if (!m_hasHeader)
+		return false;
+
+	header = m_header;
 
-	m_header = NULL;
+	m_hasHeader = false;
 
-	return header;
+	return true;
 }
 
 unsigned int COutputQueue::getData(unsigned char *data, unsigned int length, bool& end)
@@ -71,10 +71,7 @@ unsigned int COutputQueue::getData(unsigned char *data, unsigned int length, boo
 		unsigned int len = m_data.getData(data, length);
 
 		// Purge the excess data
-		unsigned int n = hdr[1U] - length;
-		unsigned char c;
-		for (unsigned int i = 0U; i < n; i++)
-			m_data.getData(&c, 1U);
+		m_data.commitRead(hdr[1U] - length);
 
 		return len;
 	} else {
@@ -95,37 +92,41 @@ unsigned int COutputQueue::addData(const unsigned char *data, unsigned int lengt
 	unsigned char hdr[2U];
 	hdr[0U] = end ? 1U : 0U;
 	hdr[1U] = length;
-	m_data.addData(hdr, 2U);
+	m_data.addData(hdr, 2U, data, length);
 
 	if (end)
 		m_count = m_threshold;
 	else
 		m_count++;
 
-	return m_data.addData(data, length);
+	return length;
 }
 
 bool COutputQueue::headerReady() const
 {
-	return m_header != NULL && m_count >= m_threshold;
+	return m_hasHeader && m_count >= m_threshold;
 }
 
 bool COutputQueue::dataReady() const
 {
-	return m_header == NULL && m_count >= m_threshold;
+	return !m_hasHeader && m_count >= m_threshold;
 }
 
 bool COutputQueue::isEmpty()
 {
-	return m_header == NULL && m_data.isEmpty();
+	return !m_hasHeader && m_data.isEmpty();
+}
+
+unsigned int COutputQueue::dataSize() const
+{
+	return m_data.dataSize();
 }
 
 void COutputQueue::reset()
 {
 	m_data.clear();
 
-	delete m_header;
-	m_header = NULL;
+	m_hasHeader = false;
 
 	m_count = 0U;
 }
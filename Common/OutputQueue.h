@@ -29,8 +29,8 @@ public:
 	COutputQueue(unsigned int space, unsigned int threshold);
 	~COutputQueue();
 
-	void setHeader(CHeaderData* header);
-	CHeaderData* getHeader();
+	void setHeader(const CHeaderData& header);
+	bool getHeader(CHeaderData& header);
 
 	unsigned int getData(unsigned char* data, unsigned int length, bool& end);
 	unsigned int addData(const unsigned char* data, unsigned int length, bool end);
@@ -40,6 +40,9 @@ public:
 
 	bool isEmpty();
 
+	// The bytes queued, including the framing
+	unsigned int dataSize() const;
+
 	void reset();
 
 	void setThreshold(unsigned int threshold);
@@ -47,7 +50,8 @@ public:
 private:
 	CRingBuffer<unsigned char> m_data;
 	unsigned int               m_threshold;
-	CHeaderData*               m_header;
+	CHeaderData                m_header;
+	bool                       m_hasHeader;
 	unsigned int               m_count;
 };
 
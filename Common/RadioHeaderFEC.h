@@ -0,0 +1,48 @@
+/*
+ *   Copyright (C) 2009-2015 by Jonathan Naylor G4KLX
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	RadioHeaderFEC_H
+#define	RadioHeaderFEC_H
+
+#include <wx/wx.h>
+
+// The convolutional code, interleaving and scrambling of the radio header as sent over the air
+class CRadioHeaderFEC {
+public:
+	CRadioHeaderFEC();
+	~CRadioHeaderFEC();
+
+	// The header and its checksum into the FEC_SECTION_LENGTH_BYTES that follow the frame sync
+	void encode(const unsigned char* in, unsigned char* out) const;
+
+	// The soft decisions for the 660 bits that follow the frame sync, positive for a one, decoded into
+	// the header and its checksum. Returns true if the checksum is correct.
+	bool decode(const wxFloat32* soft, unsigned char* out);
+
+private:
+	int*         m_pathMetric;
+	wxUint32*    m_survivors;
+	unsigned int m_mar;
+
+	void acs(const int* metric);
+	void viterbiDecode(const int* data);
+	void traceBack(unsigned char* out);
+};
+
+#endif
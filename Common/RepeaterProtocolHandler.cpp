@@ -81,20 +81,12 @@ bool CRepeaterProtocolHandler::writeHeader(const CHeaderData& header)
 	buffer[9]  = header.getFlag2();
 	buffer[10] = header.getFlag3();
 
-	for (unsigned int i = 0U; i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[11 + i] = header.getRptCall1().GetChar(i);
-
-	for (unsigned int i = 0U; i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[19 + i] = header.getRptCall2().GetChar(i);
-
-	for (unsigned int i = 0U; i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[27 + i] = header.getYourCall().GetChar(i);
-
-	for (unsigned int i = 0U; i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[35 + i] = header.getMyCall1().GetChar(i);
-
-	for (unsigned int i = 0U; i < SHORT_CALLSIGN_LENGTH; i++)
-		buffer[43 + i] = header.getMyCall2().GetChar(i);
+	// The repeaters are the other way round from a radio header
+	header.getRptCall1(buffer + 11U);
+	header.getRptCall2(buffer + 19U);
+	header.getYourCall(buffer + 27U);
+	header.getMyCall1(buffer + 35U);
+	header.getMyCall2(buffer + 43U);
 
 	// Get the checksum for the header
 	CCCITTChecksumReverse csum;
@@ -107,13 +99,11 @@ bool CRepeaterProtocolHandler::writeHeader(const CHeaderData& header)
 	CUtils::dump(wxT("Sending Header"), buffer, 49U);
 #endif
 
-	for (unsigned int i = 0U; i < 2U; i++) {
-		bool ret = m_socket.write(buffer, 49U, m_address, m_port);
-		if (!ret)
-			return false;
-	}
+	// Both copies go in one system call
+	in_addr      addresses[2U] = {m_address, m_address};
+	unsigned int ports[2U]     = {m_port, m_port};
 
-	return true;
+	return m_socket.write(buffer, 49U, addresses, ports, 2U);
 }
 
 bool CRepeaterProtocolHandler::writeData(const unsigned char* data, unsigned int length, unsigned int errors, bool end)
@@ -179,20 +169,12 @@ bool CRepeaterProtocolHandler::writeBusyHeader(const CHeaderData& header)
 	buffer[9]  = header.getFlag2();
 	buffer[10] = header.getFlag3();
 
-	for (unsigned int i = 0U; i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[11 + i] = header.getRptCall1().GetChar(i);
-
-	for (unsigned int i = 0U; i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[19 + i] = header.getRptCall2().GetChar(i);
-
-	for (unsigned int i = 0U; i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[27 + i] = header.getYourCall().GetChar(i);
-
-	for (unsigned int i = 0U; i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[35 + i] = header.getMyCall1().GetChar(i);
-
-	for (unsigned int i = 0U; i < SHORT_CALLSIGN_LENGTH; i++)
-		buffer[43 + i] = header.getMyCall2().GetChar(i);
+	// The repeaters are the other way round from a radio header
+	header.getRptCall1(buffer + 11U);
+	header.getRptCall2(buffer + 19U);
+	header.getYourCall(buffer + 27U);
+	header.getMyCall1(buffer + 35U);
+	header.getMyCall2(buffer + 43U);
 
 	// Get the checksum for the header
 	CCCITTChecksumReverse csum;
@@ -410,25 +392,28 @@ bool CRepeaterProtocolHandler::readPackets()
 	return true;
 }
 
-CHeaderData* CRepeaterProtocolHandler::readHeader()
+bool CRepeaterProtocolHandler::readHeader(CHeaderData& header)
 {
 	if (m_type != NETWORK_HEADER)
-		return NULL;
+		return false;
 
 	// If the checksum is 0xFFFF then we accept the header without testing the checksum
-	if (m_buffer[47U] == 0xFFU && m_buffer[48U] == 0xFFU)
-		return new CHeaderData(m_buffer + 8U, RADIO_HEADER_LENGTH_BYTES, false);
+	if (m_buffer[47U] == 0xFFU && m_buffer[48U] == 0xFFU) {
+		header = CHeaderData(m_buffer + 8U, RADIO_HEADER_LENGTH_BYTES, false);
+		return true;
+	}
 
 	// Header checksum testing is enabled
-	CHeaderData* header = new CHeaderData(m_buffer + 8U, RADIO_HEADER_LENGTH_BYTES, true);
+	CHeaderData temp(m_buffer + 8U, RADIO_HEADER_LENGTH_BYTES, true);
 
-	if (!header->isValid()) {
+	if (!temp.isValid()) {
 		CUtils::dump(wxT("Header checksum failure from the Gateway"), m_buffer + 8U, RADIO_HEADER_LENGTH_BYTES);
-		delete header;
-		return NULL;
+		return false;
 	}
 
-	return header;
+	header = temp;
+
+	return true;
 }
 
 unsigned int CRepeaterProtocolHandler::readData(unsigned char* buffer, unsigned int length, unsigned char& seqNo)
@@ -533,6 +518,11 @@ void CRepeaterProtocolHandler::reset()
 	m_inId = 0U;
 }
 
+int CRepeaterProtocolHandler::getFD() const
+{
+	return m_socket.getFD();
+}
+
 void CRepeaterProtocolHandler::close()
 {
 	m_socket.close();
@@ -47,11 +47,14 @@ public:
 	wxString     readStatus3();
 	wxString     readStatus4();
 	wxString     readStatus5();
-	CHeaderData* readHeader();
+	bool         readHeader(CHeaderData& header);
 	unsigned int readData(unsigned char* data, unsigned int length, unsigned char& seqNo);
 
 	void reset();
 
+	// The socket, to wait on for incoming packets
+	int  getFD() const;
+
 	void close();
 
 private:
@@ -21,6 +21,11 @@
 
 #include <wx/wx.h>
 
+#include <atomic>
+
+// A single producer, single consumer ring buffer, one thread may add data and another may take it
+// out without any locking. The writer owns m_iPtr and the reader owns m_oPtr, and clear() is done
+// by the reader. T must be safe to copy with memcpy.
 template<class T> class CRingBuffer {
 public:
 	CRingBuffer(unsigned int length) :
@@ -43,71 +48,115 @@ public:
 
 	unsigned int addData(const T* buffer, unsigned int nSamples)
 	{
-		if (nSamples > freeSpace())
+		return addData(buffer, nSamples, NULL, 0U);
+	}
+
+	// Both parts become visible to the reader at the same time, so a record header and its payload
+	// are never seen apart
+	unsigned int addData(const T* buffer1, unsigned int nSamples1, const T* buffer2, unsigned int nSamples2)
+	{
+		unsigned int iPtr = m_iPtr.load(std::memory_order_relaxed);
+		unsigned int oPtr = m_oPtr.load(std::memory_order_acquire);
+
+		if ((nSamples1 + nSamples2) > freeSpace(iPtr, oPtr))
 			return 0U;
 
-		for (unsigned int i = 0U; i < nSamples; i++) {
-			m_buffer[m_iPtr++] = buffer[i];
+		iPtr = copyIn(iPtr, buffer1, nSamples1);
+		iPtr = copyIn(iPtr, buffer2, nSamples2);
 
-			if (m_iPtr == m_length)
-				m_iPtr = 0U;
-		}
+		m_iPtr.store(iPtr, std::memory_order_release);
 
-		return nSamples;
+		return nSamples1 + nSamples2;
 	}
 
 	unsigned int getData(T* buffer, unsigned int nSamples)
 	{
-		unsigned int data = dataSize();
+		unsigned int oPtr = m_oPtr.load(std::memory_order_relaxed);
+		unsigned int iPtr = m_iPtr.load(std::memory_order_acquire);
 
+		unsigned int data = dataSize(iPtr, oPtr);
 		if (data < nSamples)
 			nSamples = data;
 
-		for (unsigned int i = 0U; i < nSamples; i++) {
-			buffer[i] = m_buffer[m_oPtr++];
+		copyOut(oPtr, buffer, nSamples);
 
-			if (m_oPtr == m_length)
-				m_oPtr = 0U;
-		}
+		m_oPtr.store(advance(oPtr, nSamples), std::memory_order_release);
 
 		return nSamples;
 	}
 
-	unsigned int peek(T* buffer, unsigned int nSamples)
+	unsigned int peek(T* buffer, unsigned int nSamples) const
 	{
-		unsigned int data = dataSize();
+		unsigned int oPtr = m_oPtr.load(std::memory_order_relaxed);
+		unsigned int iPtr = m_iPtr.load(std::memory_order_acquire);
 
+		unsigned int data = dataSize(iPtr, oPtr);
 		if (data < nSamples)
 			nSamples = data;
 
-		unsigned int ptr = m_oPtr;
-		for (unsigned int i = 0U; i < nSamples; i++) {
-			buffer[i] = m_buffer[ptr++];
-
-			if (ptr == m_length)
-				ptr = 0U;
-		}
+		copyOut(oPtr, buffer, nSamples);
 
 		return nSamples;
 	}
 
-	void clear()
+	// The free space that can be written in place without wrapping, follow with commitWrite()
+	T* getWriteSpan(unsigned int& nSamples)
 	{
-		m_iPtr  = 0U;
-		m_oPtr  = 0U;
+		unsigned int iPtr = m_iPtr.load(std::memory_order_relaxed);
+		unsigned int oPtr = m_oPtr.load(std::memory_order_acquire);
 
-		::memset(m_buffer, 0x00, m_length * sizeof(T));
+		nSamples = freeSpace(iPtr, oPtr);
+		if (nSamples > (m_length - iPtr))
+			nSamples = m_length - iPtr;
+
+		return m_buffer + iPtr;
 	}
 
-	unsigned int freeSpace() const
+	void commitWrite(unsigned int nSamples)
+	{
+		wxASSERT(nSamples <= freeSpace());
+
+		unsigned int iPtr = m_iPtr.load(std::memory_order_relaxed);
+
+		m_iPtr.store(advance(iPtr, nSamples), std::memory_order_release);
+	}
+
+	// The data that can be read in place without wrapping, follow with commitRead()
+	const T* getReadSpan(unsigned int& nSamples) const
+	{
+		unsigned int oPtr = m_oPtr.load(std::memory_order_relaxed);
+		unsigned int iPtr = m_iPtr.load(std::memory_order_acquire);
+
+		nSamples = dataSize(iPtr, oPtr);
+		if (nSamples > (m_length - oPtr))
+			nSamples = m_length - oPtr;
+
+		return m_buffer + oPtr;
+	}
+
+	void commitRead(unsigned int nSamples)
+	{
+		wxASSERT(nSamples <= dataSize());
+
+		unsigned int oPtr = m_oPtr.load(std::memory_order_relaxed);
+
+		m_oPtr.store(advance(oPtr, nSamples), std::memory_order_release);
+	}
+
+	// Discard everything written so far, only the reader may call this
+	void clear()
 	{
-		if (m_oPtr == m_iPtr)
-			return m_length - 1U;
+		m_oPtr.store(m_iPtr.load(std::memory_order_acquire), std::memory_order_release);
+	}
 
-		if (m_oPtr > m_iPtr)
-			return m_oPtr - m_iPtr - 1U;
+	unsigned int freeSpace() const
+	{
+		return freeSpace(m_iPtr.load(std::memory_order_acquire), m_oPtr.load(std::memory_order_acquire));
+	}
 
-		return m_length - (m_iPtr - m_oPtr) - 1U;
+	unsigned int dataSize() const
+	{
+		return dataSize(m_iPtr.load(std::memory_order_acquire), m_oPtr.load(std::memory_order_acquire));
 	}
 
 	bool hasSpace(unsigned int length) const
@@ -117,26 +166,71 @@ public:
 
 	bool hasData() const
 	{
-		return m_oPtr != m_iPtr;
+		return m_oPtr.load(std::memory_order_acquire) != m_iPtr.load(std::memory_order_acquire);
 	}
 
 	bool isEmpty() const
 	{
-		return m_oPtr == m_iPtr;
+		return m_oPtr.load(std::memory_order_acquire) == m_iPtr.load(std::memory_order_acquire);
 	}
 
 private:
-	unsigned int          m_length;
-	T*                    m_buffer;
-	volatile unsigned int m_iPtr;
-	volatile unsigned int m_oPtr;
+	unsigned int              m_length;
+	T*                        m_buffer;
+	std::atomic<unsigned int> m_iPtr;
+	std::atomic<unsigned int> m_oPtr;
 
-	unsigned int dataSize() const
+	unsigned int freeSpace(unsigned int iPtr, unsigned int oPtr) const
+	{
+		return m_length - dataSize(iPtr, oPtr) - 1U;
+	}
+
+	unsigned int dataSize(unsigned int iPtr, unsigned int oPtr) const
+	{
+		if (iPtr >= oPtr)
+			return iPtr - oPtr;
+
+		return m_length - (oPtr - iPtr);
+	}
+
+	unsigned int advance(unsigned int ptr, unsigned int nSamples) const
 	{
-		if (m_iPtr >= m_oPtr)
-			return m_iPtr - m_oPtr;
+		ptr += nSamples;
+		if (ptr >= m_length)
+			ptr -= m_length;
+
+		return ptr;
+	}
+
+	// At most two copies, split where the buffer wraps
+	unsigned int copyIn(unsigned int iPtr, const T* buffer, unsigned int nSamples)
+	{
+		if (nSamples == 0U)
+			return iPtr;
+
+		unsigned int first = m_length - iPtr;
+		if (first > nSamples)
+			first = nSamples;
+
+		::memcpy(m_buffer + iPtr, buffer, first * sizeof(T));
+		if (nSamples > first)
+			::memcpy(m_buffer, buffer + first, (nSamples - first) * sizeof(T));
+
+		return advance(iPtr, nSamples);
+	}
+
+	void copyOut(unsigned int oPtr, T* buffer, unsigned int nSamples) const
+	{
+		if (nSamples == 0U)
+			return;
+
+		unsigned int first = m_length - oPtr;
+		if (first > nSamples)
+			first = nSamples;
 
-		return m_length - (m_oPtr - m_iPtr);
+		::memcpy(buffer, m_buffer + oPtr, first * sizeof(T));
+		if (nSamples > first)
+			::memcpy(buffer + first, m_buffer, (nSamples - first) * sizeof(T));
 	}
 };
 
@@ -0,0 +1,72 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	SeqLock_H
+#define	SeqLock_H
+
+#include <wx/wx.h>
+
+#include <atomic>
+
+// A single writer publishes a value and any number of readers take a consistent copy of it without
+// locking or blocking the writer. The sequence is odd while a write is in progress, and a reader
+// which sees it change while copying simply tries again. T must be safe to copy with memcpy.
+template<class T> class CSeqLock {
+public:
+	CSeqLock() :
+	m_sequence(0U),
+	m_data()
+	{
+	}
+
+	void write(const T& data)
+	{
+		unsigned int sequence = m_sequence.load(std::memory_order_relaxed);
+
+		m_sequence.store(sequence + 1U, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		::memcpy(&m_data, &data, sizeof(T));
+
+		m_sequence.store(sequence + 2U, std::memory_order_release);
+	}
+
+	// Returns false if nothing has been written yet
+	bool read(T& data) const
+	{
+		for (;;) {
+			unsigned int sequence1 = m_sequence.load(std::memory_order_acquire);
+			if ((sequence1 & 1U) == 1U)
+				continue;
+
+			::memcpy(&data, &m_data, sizeof(T));
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			unsigned int sequence2 = m_sequence.load(std::memory_order_relaxed);
+
+			if (sequence1 == sequence2)
+				return sequence1 != 0U;
+		}
+	}
+
+private:
+	std::atomic<unsigned int> m_sequence;
+	T                         m_data;
+};
+
+#endif
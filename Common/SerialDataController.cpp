@@ -272,6 +272,11 @@ void CSerialDataController::close()
 	::CloseHandle(m_writeOverlapped.hEvent);
 }
 
+int CSerialDataController::getFD() const
+{
+	return -1;
+}
+
 #else
 
 CSerialDataController::CSerialDataController(const wxString& device, SERIAL_SPEED speed, bool assertRTS) :
@@ -433,6 +438,46 @@ int CSerialDataController::read(unsigned char* buffer, unsigned int length, unsi
 	return length;
 }
 
+int CSerialDataController::readNonblock(unsigned char* buffer, unsigned int length, unsigned int timeout)
+{
+	wxASSERT(buffer != NULL);
+	wxASSERT(m_fd != -1);
+
+	if (length == 0U)
+		return 0;
+
+	// The port is opened non-blocking, so without a timeout a single read is enough
+	if (timeout > 0U) {
+		fd_set fds;
+		FD_ZERO(&fds);
+		FD_SET(m_fd, &fds);
+
+		struct timeval tv;
+		tv.tv_sec  =  timeout / 1000U;
+		tv.tv_usec = (timeout % 1000U) * 1000U;
+
+		int n = ::select(m_fd + 1, &fds, NULL, NULL, &tv);
+		if (n < 0) {
+			wxLogError(wxT("Error from select(), errno=%d"), errno);
+			return -1;
+		}
+
+		if (n == 0)
+			return 0;
+	}
+
+	ssize_t len = ::read(m_fd, buffer, length);
+	if (len < 0) {
+		if (errno == EAGAIN)
+			return 0;
+
+		wxLogError(wxT("Error from read(), errno=%d"), errno);
+		return -1;
+	}
+
+	return int(len);
+}
+
 int CSerialDataController::write(const unsigned char* buffer, unsigned int length)
 {
 	wxASSERT(buffer != NULL);
@@ -467,4 +512,9 @@ void CSerialDataController::close()
 	m_fd = -1;
 }
 
+int CSerialDataController::getFD() const
+{
+	return m_fd;
+}
+
 #endif
@@ -46,10 +46,17 @@ public:
 	bool open();
 
 	int  read(unsigned char* buffer, unsigned int length, unsigned int timeout = 0U);
+
+	// Returns whatever has arrived, up to length bytes, waiting no longer than the timeout for it
+	int  readNonblock(unsigned char* buffer, unsigned int length, unsigned int timeout = 0U);
+
 	int  write(const unsigned char* buffer, unsigned int length);
 
 	void close();
 
+	// For waiting on received data, -1 where the port is not a descriptor
+	int  getFD() const;
+
 private:
 	wxString       m_device;
 	SERIAL_SPEED   m_speed;
@@ -64,10 +71,6 @@ private:
 #else
 	int            m_fd;
 #endif
-
-#if defined(__WINDOWS__)
-	int readNonblock(unsigned char* buffer, unsigned int length, unsigned int timeout);
-#endif
 };
 
 #endif
@@ -0,0 +1,104 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "SerialFramer.h"
+
+CSerialFramer::CSerialFramer(ISerialProtocol* protocol, unsigned int length) :
+m_protocol(protocol),
+m_length(length),
+m_buffer(NULL),
+m_start(0U),
+m_end(0U)
+{
+	wxASSERT(protocol != NULL);
+	wxASSERT(length > 0U);
+
+	// Room for a partial frame plus a full read
+	m_buffer = new unsigned char[length * 2U];
+}
+
+CSerialFramer::~CSerialFramer()
+{
+	delete[] m_buffer;
+}
+
+unsigned char* CSerialFramer::getSpace(unsigned int& length)
+{
+	// Only the start of a frame is left, so moving it down is cheap
+	if (m_start > 0U) {
+		::memmove(m_buffer, m_buffer + m_start, m_end - m_start);
+		m_end  -= m_start;
+		m_start = 0U;
+	}
+
+	// A frame can never be this long, so the data cannot be trusted
+	if (m_end >= m_length)
+		m_end = 0U;
+
+	length = m_length;
+
+	return m_buffer + m_end;
+}
+
+void CSerialFramer::addData(unsigned int length)
+{
+	wxASSERT(length <= m_length);
+
+	m_end += length;
+}
+
+unsigned char* CSerialFramer::getFrame(unsigned int& length)
+{
+	while (m_start < m_end) {
+		unsigned int held = m_end - m_start;
+
+		int n = m_protocol->getFrameLength(m_buffer + m_start, held);
+
+		if (n < 0) {
+			unsigned int skip = (unsigned int)-n;
+			m_start += skip < held ? skip : held;
+			continue;
+		}
+
+		if ((unsigned int)n > m_length) {
+			m_start++;
+			continue;
+		}
+
+		if (n == 0 || (unsigned int)n > held)
+			return NULL;
+
+		unsigned char* frame = m_buffer + m_start;
+
+		m_start += n;
+		length = n;
+
+		return frame;
+	}
+
+	m_start = 0U;
+	m_end   = 0U;
+
+	return NULL;
+}
+
+void CSerialFramer::reset()
+{
+	m_start = 0U;
+	m_end   = 0U;
+}
@@ -0,0 +1,50 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	SerialFramer_H
+#define	SerialFramer_H
+
+#include "SerialProtocol.h"
+
+#include <wx/wx.h>
+
+// Collects the bytes from a modem and splits them into frames using the rules of its protocol. Each read
+// takes as much as has arrived, and the frames are handed out from where they were read into.
+class CSerialFramer {
+public:
+	CSerialFramer(ISerialProtocol* protocol, unsigned int length);
+	~CSerialFramer();
+
+	// Where the next read should go, length is always the longest frame allowed
+	unsigned char* getSpace(unsigned int& length);
+	void           addData(unsigned int length);
+
+	// Returns NULL if there is no whole frame yet. The frame stays valid until getSpace() is next called.
+	unsigned char* getFrame(unsigned int& length);
+
+	void           reset();
+
+private:
+	ISerialProtocol* m_protocol;
+	unsigned int     m_length;
+	unsigned char*   m_buffer;
+	unsigned int     m_start;
+	unsigned int     m_end;
+};
+
+#endif
@@ -0,0 +1,31 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	SerialProtocol_H
+#define	SerialProtocol_H
+
+class ISerialProtocol {
+public:
+	// Returns the length of the frame at the start of the data, zero if more data is needed to tell, or
+	// minus the number of bytes to throw away if the data does not start with a frame
+	virtual int getFrameLength(const unsigned char* data, unsigned int length) = 0;
+
+private:
+};
+
+#endif
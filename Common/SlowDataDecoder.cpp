@@ -24,7 +24,8 @@ m_buffer(NULL),
 m_state(SDD_FIRST),
 m_headerData(NULL),
 m_headerPtr(0U),
-m_header(NULL)
+m_header(),
+m_hasHeader(false)
 {
 	m_buffer     = new unsigned char[SLOW_DATA_BLOCK_SIZE];
 	m_headerData = new unsigned char[SLOW_DATA_FULL_BLOCK_SIZE];
@@ -34,8 +35,6 @@ CSlowDataDecoder::~CSlowDataDecoder()
 {
 	delete[] m_buffer;
 	delete[] m_headerData;
-
-	delete m_header;
 }
 
 void CSlowDataDecoder::addData(const unsigned char* data)
@@ -60,16 +59,16 @@ void CSlowDataDecoder::addData(const unsigned char* data)
 	}			
 }
 
-CHeaderData* CSlowDataDecoder::getHeaderData()
+bool CSlowDataDecoder::getHeaderData(CHeaderData& header)
 {
-	if (m_header == NULL)
-		return NULL;
+	if (!m_hasHeader)
+		return false;
 
-	CHeaderData* temp = new CHeaderData(*m_header);
+	header = m_header;
 
 	reset();
 
-	return temp;
+	return true;
 }
 
 void CSlowDataDecoder::sync()
@@ -87,14 +86,13 @@ void CSlowDataDecoder::reset()
 
 	::memset(m_headerData, 0x00, SLOW_DATA_FULL_BLOCK_SIZE * sizeof(unsigned char));
 
-	delete m_header;
-	m_header = NULL;
+	m_hasHeader = false;
 }
 
 void CSlowDataDecoder::processHeader()
 {
 	// Do we have a complete and valid header already?
-	if (m_header != NULL)
+	if (m_hasHeader)
 		return;
 
 	for (unsigned int i = 1U; i <= (SLOW_DATA_BLOCK_SIZE - 1U); i++, m_headerPtr++) {
@@ -149,7 +147,8 @@ bool CSlowDataDecoder::processHeader(const unsigned char* bytes)
 		return false;
 
 	// The checksum has already been checked
-	m_header = new CHeaderData(buffer, RADIO_HEADER_LENGTH_BYTES, false);
+	m_header    = CHeaderData(buffer, RADIO_HEADER_LENGTH_BYTES, false);
+	m_hasHeader = true;
 
 	return true;
 }
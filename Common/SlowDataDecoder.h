@@ -30,7 +30,7 @@ public:
 
 	void addData(const unsigned char* data);
 
-	CHeaderData* getHeaderData();
+	bool getHeaderData(CHeaderData& header);
 
 	void sync();
 	void reset();
@@ -40,7 +40,8 @@ private:
 	SDD_STATE      m_state;
 	unsigned char* m_headerData;
 	unsigned int   m_headerPtr;
-	CHeaderData*   m_header;
+	CHeaderData    m_header;
+	bool           m_hasHeader;
 
 	void processHeader();
 	bool processHeader(const unsigned char* bytes);
@@ -11,7 +11,6 @@
  *	GNU General Public License for more details.
  */
 
-#include "CCITTChecksumReverse.h"
 #include "SlowDataEncoder.h"
 #include "DStarDefines.h"
 
@@ -81,78 +80,21 @@ void CSlowDataEncoder::setHeaderData(const CHeaderData& header)
 {
 	::memset(m_headerData, 'f', SLOW_DATA_FULL_BLOCK_SIZE);
 
-	m_headerData[0U]  = SLOW_DATA_TYPE_HEADER | 5U;
-	m_headerData[1U]  = header.getFlag1();
-	m_headerData[2U]  = header.getFlag2();
-	m_headerData[3U]  = header.getFlag3();
-	m_headerData[4U]  = header.getRptCall2().GetChar(0);
-	m_headerData[5U]  = header.getRptCall2().GetChar(1);
-
-	m_headerData[6U]  = SLOW_DATA_TYPE_HEADER | 5U;
-	m_headerData[7U]  = header.getRptCall2().GetChar(2);
-	m_headerData[8U]  = header.getRptCall2().GetChar(3);
-	m_headerData[9U]  = header.getRptCall2().GetChar(4);
-	m_headerData[10U] = header.getRptCall2().GetChar(5);
-	m_headerData[11U] = header.getRptCall2().GetChar(6);
-
-	m_headerData[12U] = SLOW_DATA_TYPE_HEADER | 5U;
-	m_headerData[13U] = header.getRptCall2().GetChar(7);
-	m_headerData[14U] = header.getRptCall1().GetChar(0);
-	m_headerData[15U] = header.getRptCall1().GetChar(1);
-	m_headerData[16U] = header.getRptCall1().GetChar(2);
-	m_headerData[17U] = header.getRptCall1().GetChar(3);
-
-	m_headerData[18U] = SLOW_DATA_TYPE_HEADER | 5U;
-	m_headerData[19U] = header.getRptCall1().GetChar(4);
-	m_headerData[20U] = header.getRptCall1().GetChar(5);
-	m_headerData[21U] = header.getRptCall1().GetChar(6);
-	m_headerData[22U] = header.getRptCall1().GetChar(7);
-	m_headerData[23U] = header.getYourCall().GetChar(0);
-
-	m_headerData[24U] = SLOW_DATA_TYPE_HEADER | 5U;
-	m_headerData[25U] = header.getYourCall().GetChar(1);
-	m_headerData[26U] = header.getYourCall().GetChar(2);
-	m_headerData[27U] = header.getYourCall().GetChar(3);
-	m_headerData[28U] = header.getYourCall().GetChar(4);
-	m_headerData[29U] = header.getYourCall().GetChar(5);
-
-	m_headerData[30U] = SLOW_DATA_TYPE_HEADER | 5U;
-	m_headerData[31U] = header.getYourCall().GetChar(6);
-	m_headerData[32U] = header.getYourCall().GetChar(7);
-	m_headerData[33U] = header.getMyCall1().GetChar(0);
-	m_headerData[34U] = header.getMyCall1().GetChar(1);
-	m_headerData[35U] = header.getMyCall1().GetChar(2);
-
-	m_headerData[36U] = SLOW_DATA_TYPE_HEADER | 5U;
-	m_headerData[37U] = header.getMyCall1().GetChar(3);
-	m_headerData[38U] = header.getMyCall1().GetChar(4);
-	m_headerData[39U] = header.getMyCall1().GetChar(5);
-	m_headerData[40U] = header.getMyCall1().GetChar(6);
-	m_headerData[41U] = header.getMyCall1().GetChar(7);
-
-	m_headerData[42U] = SLOW_DATA_TYPE_HEADER | 5U;
-	m_headerData[43U] = header.getMyCall2().GetChar(0);
-	m_headerData[44U] = header.getMyCall2().GetChar(1);
-	m_headerData[45U] = header.getMyCall2().GetChar(2);
-	m_headerData[46U] = header.getMyCall2().GetChar(3);
-
-	CCCITTChecksumReverse cksum;
-	cksum.update(m_headerData + 1U, 5U);
-	cksum.update(m_headerData + 7U, 5U);
-	cksum.update(m_headerData + 13U, 5U);
-	cksum.update(m_headerData + 19U, 5U);
-	cksum.update(m_headerData + 25U, 5U);
-	cksum.update(m_headerData + 31U, 5U);
-	cksum.update(m_headerData + 37U, 5U);
-	cksum.update(m_headerData + 43U, 4U);
-
-	unsigned char checkSum[2U];
-	cksum.result(checkSum);
-
-	m_headerData[47U] = checkSum[0];
-
-	m_headerData[48U] = SLOW_DATA_TYPE_HEADER | 1U;
-	m_headerData[49U] = checkSum[1];
+	unsigned char buffer[RADIO_HEADER_LENGTH_BYTES];
+	header.getData(buffer, RADIO_HEADER_LENGTH_BYTES, true);
+
+	// The header and its checksum are sent five bytes at a time, each block led by its type and length
+	unsigned int n = 0U;
+	for (unsigned int i = 0U; i < RADIO_HEADER_LENGTH_BYTES; i += 5U) {
+		unsigned int length = RADIO_HEADER_LENGTH_BYTES - i;
+		if (length > 5U)
+			length = 5U;
+
+		m_headerData[n++] = SLOW_DATA_TYPE_HEADER | length;
+
+		::memcpy(m_headerData + n, buffer + i, length);
+		n += length;
+	}
 
 	m_headerPtr = 0U;
 }
@@ -22,6 +22,7 @@
 #include "SoundCardReaderWriter.h"
 #include "DStarGMSKDemodulator.h"
 #include "DStarGMSKModulator.h"
+#include "RadioHeaderFEC.h"
 #include "AudioCallback.h"
 #include "RingBuffer.h"
 #include "Modem.h"
@@ -69,25 +70,15 @@ private:
 	unsigned char*             m_rxBuffer;
 	unsigned int               m_rxBufferBits;
 	unsigned int               m_dataBits;
-	unsigned int               m_mar;
-	int*                       m_pathMetric;
-	unsigned int*              m_pathMemory0;
-	unsigned int*              m_pathMemory1;
-	unsigned int*              m_pathMemory2;
-	unsigned int*              m_pathMemory3;
-	unsigned char*             m_fecOutput;
+	wxFloat32*                 m_rxSoft;
+	CRadioHeaderFEC            m_headerFEC;
+	wxFloat32*                 m_txBuffer;
 
 	void processNone(bool bit);
-	void processHeader(bool bit);
+	void processHeader(bool bit, wxFloat32 soft);
 	void processData(bool bit);
 
-	bool rxHeader(unsigned char* in, unsigned char* out);
-	void acs(int* metric);
-	void viterbiDecode(int* data);
-	void traceBack();
-
-	void txHeader(const unsigned char* in, unsigned char* out);
-	void writeBits(unsigned char c);
+	void writeBits(const unsigned char* data, unsigned int length);
 
 	unsigned int countBits(wxUint32 num);
 };
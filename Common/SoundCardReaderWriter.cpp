@@ -18,6 +18,7 @@
  */
 
 #include "SoundCardReaderWriter.h"
+#include "Logger.h"
 
 #if (defined(__APPLE__) && defined(__MACH__)) || defined(__WINDOWS__)
 
@@ -663,6 +664,8 @@ CSoundCardReader::~CSoundCardReader()
 
 void* CSoundCardReader::Entry()
 {
+	CLogger::startThread();
+
 	wxLogMessage(wxT("Starting ALSA reader thread"));
 
 	while (!m_killed) {
@@ -728,6 +731,8 @@ CSoundCardWriter::~CSoundCardWriter()
 
 void* CSoundCardWriter::Entry()
 {
+	CLogger::startThread();
+
 	wxLogMessage(wxT("Starting ALSA writer thread"));
 
 	while (!m_killed) {
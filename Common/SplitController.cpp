@@ -17,81 +17,38 @@
  */
 
 #include "SplitController.h"
+#include "Logger.h"
 
 const unsigned int REGISTRATION_TIMEOUT = 200U;
 
 const unsigned int BUFFER_LENGTH = 200U;
 
-CAMBESlot::CAMBESlot(unsigned int rxCount) :
-m_valid(NULL),
-m_errors(999U),
-m_best(99U),
-m_ambe(NULL),
-m_length(0U),
-m_end(NULL),
-m_timer(1000U),
-m_rxCount(rxCount)
-{
-	wxASSERT(rxCount > 0U);
-
-	m_ambe  = new unsigned char[DV_FRAME_MAX_LENGTH_BYTES];
-	m_valid = new bool[rxCount];
-	m_end   = new bool[rxCount];
-
-	reset();
-}
-
-CAMBESlot::~CAMBESlot() 
-{
-	delete[] m_end;
-	delete[] m_valid;
-	delete[] m_ambe;
-}
-
-void CAMBESlot::reset()
-{
-	m_errors = 999U;
-	m_best   = 99U;
-	m_length = 0U;
-
-	for (unsigned int i = 0U; i < m_rxCount; i++) {
-		m_valid[i] = false;
-		m_end[i]   = false;
-	}
-
-	m_timer.stop();
-}
-
-bool CAMBESlot::isFirst() const
-{
-	return m_length == 0U;
-}
-
-CSplitController::CSplitController(const wxString& localAddress, unsigned int localPort, const wxArrayString& transmitterNames, const wxArrayString& receiverNames, unsigned int timeout) :
+CSplitController::CSplitController(const wxString& localAddress, unsigned int localPort, const wxArrayString& transmitterNames, const wxArrayString& receiverNames, unsigned int timeout, unsigned int concealFrames) :
 CModem(),
 m_handler(localAddress, localPort),
 m_transmitterNames(transmitterNames),
 m_receiverNames(receiverNames),
-m_timeout(timeout),
 m_txCount(0U),
 m_rxCount(0U),
+m_wheel(),
 m_txAddresses(NULL),
 m_txPorts(NULL),
 m_txTimers(NULL),
+m_sendAddresses(NULL),
+m_sendPorts(NULL),
 m_rxAddresses(NULL),
 m_rxPorts(NULL),
 m_rxTimers(NULL),
 m_txData(1000U),
 m_outId(0x00U),
 m_outSeq(0U),
-m_endTimer(1000U, 1U),
+m_endTimer(m_wheel, 1U),
 m_listening(true),
-m_inSeqNo(0x00U),
-m_outSeqNo(0x00U),
 m_header(NULL),
 m_id(NULL),
 m_valid(NULL),
-m_slots(NULL),
+m_combiner(receiverNames.GetCount(), timeout),
+m_concealer(concealFrames),
 m_headerSent(false),
 m_packets(NULL),
 m_best(NULL),
@@ -108,6 +65,9 @@ m_silence(0U)
 	m_txPorts     = new unsigned int[m_txCount];
 	m_txTimers    = new CTimer*[m_txCount];
 
+	m_sendAddresses = new in_addr[m_txCount];
+	m_sendPorts     = new unsigned int[m_txCount];
+
 	m_rxAddresses = new in_addr[m_rxCount];
 	m_rxPorts     = new unsigned int[m_rxCount];
 	m_rxTimers    = new CTimer*[m_rxCount];
@@ -121,7 +81,7 @@ m_silence(0U)
 	m_missed  = new unsigned int[m_rxCount];
 
 	for (unsigned int i = 0U; i < m_rxCount; i++) {
-		m_rxTimers[i] = new CTimer(1000U, REGISTRATION_TIMEOUT);
+		m_rxTimers[i] = new CTimer(m_wheel, REGISTRATION_TIMEOUT, 0U, this);
 		m_rxPorts[i]  = 0U;
 		m_valid[i]    = false;
 		m_id[i]       = 0x00U;
@@ -131,19 +91,17 @@ m_silence(0U)
 	}
 
 	for (unsigned int i = 0U; i < m_txCount; i++) {
-		m_txTimers[i] = new CTimer(1000U, REGISTRATION_TIMEOUT);
+		m_txTimers[i] = new CTimer(m_wheel, REGISTRATION_TIMEOUT, 0U, this);
 		m_txPorts[i]  = 0U;
 	}
-
-	m_slots = new CAMBESlot*[21U];
-	for (unsigned int i = 0U; i < 21U; i++)
-		m_slots[i] = new CAMBESlot(m_rxCount);
 }
 
 CSplitController::~CSplitController()
 {
 	delete[] m_txAddresses;
 	delete[] m_txPorts;
+	delete[] m_sendAddresses;
+	delete[] m_sendPorts;
 	delete[] m_rxAddresses;
 	delete[] m_rxPorts;
 	delete[] m_missed;
@@ -153,10 +111,6 @@ CSplitController::~CSplitController()
 	delete[] m_id;
 	delete[] m_valid;
 
-	for (unsigned int i = 0U; i < 21U; i++)
-		delete m_slots[i];
-	delete[] m_slots;
-
 	for (unsigned int i = 0U; i < m_txCount; i++)
 		delete m_txTimers[i];
 	for (unsigned int i = 0U; i < m_rxCount; i++)
@@ -181,6 +135,8 @@ bool CSplitController::start()
 
 void* CSplitController::Entry()
 {
+	CLogger::startThread();
+
 	wxLogMessage(wxT("Starting Split Controller thread"));
 
 	wxStopWatch stopWatch;
@@ -215,40 +171,12 @@ bool CSplitController::writeHeader(const CHeaderData& header)
 
 	unsigned char buffer[100U];
 
-	::memset(buffer, ' ', RADIO_HEADER_LENGTH_BYTES - 2U);
-
-	buffer[0U] = header.getFlag1();
-	buffer[1U] = header.getFlag2();
-	buffer[2U] = header.getFlag3();
-
-	wxString rpt2 = header.getRptCall2();
-	for (unsigned int i = 0U; i < rpt2.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 3U]  = rpt2.GetChar(i);
-
-	wxString rpt1 = header.getRptCall1();
-	for (unsigned int i = 0U; i < rpt1.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 11U] = rpt1.GetChar(i);
-
-	wxString your = header.getYourCall();
-	for (unsigned int i = 0U; i < your.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 19U] = your.GetChar(i);
-
-	wxString my1 = header.getMyCall1();
-	for (unsigned int i = 0U; i < my1.Len() && i < LONG_CALLSIGN_LENGTH; i++)
-		buffer[i + 27U] = my1.GetChar(i);
-
-	wxString my2 = header.getMyCall2();
-	for (unsigned int i = 0U; i < my2.Len() && i < SHORT_CALLSIGN_LENGTH; i++)
-		buffer[i + 35U] = my2.GetChar(i);
-
-	wxMutexLocker locker(m_mutex);
+	header.getData(buffer, RADIO_HEADER_LENGTH_BYTES - 2U, false);
 
 	unsigned char data[2U];
 	data[0U] = DSMTT_HEADER;
 	data[1U] = RADIO_HEADER_LENGTH_BYTES - 2U;
-	m_txData.addData(data, 2U);
-
-	m_txData.addData(buffer, RADIO_HEADER_LENGTH_BYTES - 2U);
+	m_txData.addData(data, 2U, buffer, RADIO_HEADER_LENGTH_BYTES - 2U);
 
 	return true;
 }
@@ -261,14 +189,10 @@ bool CSplitController::writeData(const unsigned char* data, unsigned int length,
 		return false;
 	}
 
-	wxMutexLocker locker(m_mutex);
-
 	unsigned char buffer[2U];
 	buffer[0U] = end ? DSMTT_EOT : DSMTT_DATA;
 	buffer[1U] = DV_FRAME_LENGTH_BYTES;
-	m_txData.addData(buffer, 2U);
-
-	m_txData.addData(data, DV_FRAME_LENGTH_BYTES);
+	m_txData.addData(buffer, 2U, data, DV_FRAME_LENGTH_BYTES);
 
 	return true;
 }
@@ -291,23 +215,18 @@ void CSplitController::transmit()
 	unsigned char type = 0U;
 	unsigned char length = 0U;
 	unsigned char buffer[RADIO_HEADER_LENGTH_BYTES];
-	{
-		wxMutexLocker locker(m_mutex);
-
-		m_txData.getData(&type, 1U);
-		m_txData.getData(&length, 1U);
-		m_txData.getData(buffer, length);
-	}
+	m_txData.getData(&type, 1U);
+	m_txData.getData(&length, 1U);
+	m_txData.getData(buffer, length);
 
 	if (type == DSMTT_HEADER) {
 		m_outId  = (::rand() % 65535U) + 1U;
 		m_outSeq = 0U;
 		m_tx     = true;
 
-		for (unsigned int i = 0U; i < m_txCount; i++) {
-			if (m_txPorts[i] > 0U)
-				m_handler.writeHeader(buffer, m_outId, m_txAddresses[i], m_txPorts[i]);
-		}
+		unsigned int count = getTransmitters();
+		if (count > 0U)
+			m_handler.writeHeader(buffer, m_outId, m_sendAddresses, m_sendPorts, count);
 	} else {
 		// If this is a data sync, reset the sequence to zero
 		if (buffer[9] == 0x55U && buffer[10] == 0x2DU && buffer[11] == 0x16U)
@@ -318,10 +237,9 @@ void CSplitController::transmit()
 			m_tx = false;
 		}
 
-		for (unsigned int i = 0U; i < m_txCount; i++) {
-			if (m_txPorts[i] > 0U)
-				m_handler.writeData(buffer, length, m_outId, m_outSeq, m_txAddresses[i], m_txPorts[i]);
-		}
+		unsigned int count = getTransmitters();
+		if (count > 0U)
+			m_handler.writeData(buffer, length, m_outId, m_outSeq, m_sendAddresses, m_sendPorts, count);
 
 		m_outSeq++;
 		if (m_outSeq > 0x14U)
@@ -329,6 +247,22 @@ void CSplitController::transmit()
 	}
 }
 
+// Gather the registered transmitters so that each frame goes to all of them in one call
+unsigned int CSplitController::getTransmitters()
+{
+	unsigned int count = 0U;
+
+	for (unsigned int i = 0U; i < m_txCount; i++) {
+		if (m_txPorts[i] > 0U) {
+			m_sendAddresses[count] = m_txAddresses[i];
+			m_sendPorts[count]     = m_txPorts[i];
+			count++;
+		}
+	}
+
+	return count;
+}
+
 void CSplitController::receive()
 {
 	NETWORK_TYPE type = NETWORK_DATA;
@@ -371,7 +305,7 @@ void CSplitController::receive()
 
 			for (unsigned int i = 0U; i < m_rxCount; i++) {
 				if (address.s_addr == m_rxAddresses[i].s_addr && port == m_rxPorts[i]) {
-					processAMBE(i, id, ambe, length, seqNo, errors);
+					processAMBE(i, id, ambe, length, seqNo);
 					m_rxTimers[i]->start();
 					break;
 				}
@@ -433,15 +367,12 @@ void CSplitController::receive()
 
 void CSplitController::timers(unsigned int ms)
 {
-	m_endTimer.clock(ms);
+	m_wheel.clock(ms);
+
 	if (m_endTimer.isRunning() && m_endTimer.hasExpired()) {
 		printStats();
 
-		wxMutexLocker locker(m_mutex);
-		unsigned char data[2U];
-		data[0U] = DSMTT_EOT;
-		data[1U] = 0U;
-		m_rxData.addData(data, 2U);
+		writeRX(DSMTT_EOT);
 
 		m_listening = true;
 		m_endTimer.stop();
@@ -449,99 +380,80 @@ void CSplitController::timers(unsigned int ms)
 		return;
 	}
 
-	// Run the registration timers
-	for (unsigned int i = 0U; i < m_txCount; i++) {
-		m_txTimers[i]->clock(ms);
-		if (m_txTimers[i]->isRunning() && m_txTimers[i]->hasExpired()) {
-			wxLogWarning(wxT("TX %u registration has expired"), i + 1U);
-			m_txTimers[i]->stop();
-			m_txPorts[i] = 0U;
-		}
-	}
-
-	for (unsigned int i = 0U; i < m_rxCount; i++) {
-		m_rxTimers[i]->clock(ms);
-		if (m_rxTimers[i]->isRunning() && m_rxTimers[i]->hasExpired()) {
-			wxLogWarning(wxT("RX %u registration has expired"), i + 1U);
-			m_rxTimers[i]->stop();
-			m_rxPorts[i] = 0U;
-		}
-	}
-
-	// If we are listening then no need to run the slot timers
+	// If we are listening then there is nothing to play out
 	if (m_listening)
 		return;
 
-	// Run the slot timers
-	for (unsigned int i = 0U; i < 21U; i++)
-		m_slots[i]->m_timer.clock(ms);
-
-	// Check for expired timers
-	for (unsigned int i = 0U; i < 21U; i++) {
-		CAMBESlot* slot = m_slots[m_outSeqNo];
-
-		// Got to an unexpired timer
-		if (!slot->m_timer.hasExpired())
-			return;
+	m_combiner.clock(ms);
 
-		// The last frame?
-		if (isEnd(*slot)) {
-			printStats();
+	for (;;) {
+		unsigned char data[DV_FRAME_LENGTH_BYTES];
+		unsigned int best = 0U;
 
-			wxMutexLocker locker(m_mutex);
+		DIVERSITY_FRAME type = m_combiner.read(data, best);
 
-			if (!m_headerSent)
-				sendHeader();
+		switch (type) {
+			case DF_NONE:
+				return;
 
-			unsigned char data[2U];
-			data[0U] = DSMTT_EOT;
-			data[1U] = 0U;
-			m_rxData.addData(data, 2U);
+			case DF_END:
+				// The last frame
+				printStats();
 
-			m_listening = true;
-			m_endTimer.stop();
+				if (!m_headerSent)
+					sendHeader();
 
-			return;
-		}
+				writeRX(DSMTT_EOT);
 
-		// Is there any data?		
-		if (slot->m_length > 0U) {
-			m_best[slot->m_best]++;
+				m_listening = true;
+				m_endTimer.stop();
+				return;
 
-			wxMutexLocker locker(m_mutex);
+			case DF_DATA:
+				m_best[best]++;
 
-			if (!m_headerSent)
-				sendHeader();
+				if (!m_headerSent)
+					sendHeader();
 
-			unsigned char data[2U];
-			data[0U] = DSMTT_DATA;
-			data[1U] = DV_FRAME_LENGTH_BYTES;
-			m_rxData.addData(data, 2U);
+				m_concealer.good(data);
 
-			m_rxData.addData(slot->m_ambe, DV_FRAME_LENGTH_BYTES);
-		} else {
-			m_silence++;
+				writeRX(DSMTT_DATA, data, DV_FRAME_LENGTH_BYTES);
+				break;
 
-			// Send a silence frame to the repeater
-			wxMutexLocker locker(m_mutex);
+			default:
+				m_silence++;
 
-			if (!m_headerSent)
-				sendHeader();
+				// No receiver heard the frame, fade out the last one to the repeater
+				if (!m_headerSent)
+					sendHeader();
 
-			unsigned char data[2U];
-			data[0U] = DSMTT_DATA;
-			data[1U] = DV_FRAME_LENGTH_BYTES;
-			m_rxData.addData(data, 2U);
+				::memcpy(data, NULL_FRAME_DATA_BYTES, DV_FRAME_LENGTH_BYTES);
+				m_concealer.conceal(data);
 
-			m_rxData.addData(NULL_FRAME_DATA_BYTES, DV_FRAME_LENGTH_BYTES);
+				writeRX(DSMTT_DATA, data, DV_FRAME_LENGTH_BYTES);
+				break;
 		}
+	}
+}
 
-		slot->reset();
-		slot->m_timer.start(0U, 21U * DSTAR_FRAME_TIME_MS);
+void CSplitController::timerExpired(CTimer& timer)
+{
+	for (unsigned int i = 0U; i < m_txCount; i++) {
+		if (&timer == m_txTimers[i]) {
+			wxLogWarning(wxT("TX %u registration has expired"), i + 1U);
+			m_txTimers[i]->stop();
+			m_txPorts[i] = 0U;
+			return;
+		}
+	}
 
-		m_outSeqNo++;
-		if (m_outSeqNo >= 21U)
-			m_outSeqNo = 0U;
+	for (unsigned int i = 0U; i < m_rxCount; i++) {
+		if (&timer == m_rxTimers[i]) {
+			wxLogWarning(wxT("RX %u registration has expired"), i + 1U);
+			m_rxTimers[i]->stop();
+			m_rxPorts[i] = 0U;
+			return;
+		}
 	}
 }
 
@@ -550,11 +462,10 @@ void CSplitController::processHeader(unsigned int n, wxUint16 id, const unsigned
 	if (m_listening) {
 		::memcpy(m_header, header, RADIO_HEADER_LENGTH_BYTES - 2U);
 
-		// Reset the slots and start the timers
-		for (unsigned int i = 0U; i < 21U; i++) {
-			m_slots[i]->reset();
-			m_slots[i]->m_timer.start(0U, DSTAR_FRAME_TIME_MS + DSTAR_FRAME_TIME_MS * i + m_timeout);
-		}
+		m_combiner.reset();
+		m_combiner.setActive(n, true);
+
+		m_concealer.reset();
 
 		for (unsigned int i = 0U; i < m_rxCount; i++) {
 			m_valid[i]   = false;
@@ -568,18 +479,18 @@ void CSplitController::processHeader(unsigned int n, wxUint16 id, const unsigned
 		m_valid[n] = true;
 		m_id[n] = id;
 
-		m_inSeqNo    = 0U;
-		m_outSeqNo   = 0U;
 		m_listening  = false;
 		m_headerSent = false;
 		m_endTimer.start();
 	} else {
 		m_valid[n] = ::memcmp(m_header, header, RADIO_HEADER_LENGTH_BYTES - 2U) == 0;
 		m_id[n] = id;		// Makes no difference as the valid flag will ensure we ignore bad ids
+
+		m_combiner.setActive(n, m_valid[n]);
 	}
 }
 
-void CSplitController::processAMBE(unsigned int n, wxUint16 id, const unsigned char* ambe, unsigned int length, wxUint8 seqNo, unsigned char errors)
+void CSplitController::processAMBE(unsigned int n, wxUint16 id, const unsigned char* ambe, unsigned int length, wxUint8 seqNo)
 {
 	if (m_listening)
 		return;
@@ -587,79 +498,27 @@ void CSplitController::processAMBE(unsigned int n, wxUint16 id, const unsigned c
 	if (!m_valid[n] || id != m_id[n])
 		return;
 
-	// Mask out the control bits of the sequence number
-	unsigned char seqNo1 = seqNo & 0x1FU;
-
-	// Check for an out of order frame
-	unsigned char seqNo2 = m_inSeqNo;
-	unsigned char count = 0U;
-	while (seqNo1 != seqNo2) {
-		count++;
-
-		seqNo2++;
-		if (seqNo2 >= 21U)
-			seqNo2 = 0U;
-	}
+	bool end = (seqNo & 0x40U) == 0x40U;
 
-	if (count > 18U) {
+	// Mask out the control bits of the sequence number, too late or out of order frames are dropped
+	bool ret = m_combiner.write(n, seqNo & 0x1FU, end, ambe, length);
+	if (!ret) {
 		m_missed[n]++;
 		return;
 	}
 
-	m_inSeqNo = (seqNo & 0x3FU) + 1U;
-	if (m_inSeqNo >= 21U)
-		m_inSeqNo = 0U;
-
-	CAMBESlot* slot = m_slots[seqNo & 0x3FU];
-
 	m_endTimer.start();
 
-	bool end = (seqNo & 0x40U) == 0x40U;
-	slot->m_valid[n] = true;
 	m_packets[n]++;
 
 	// An EOF removes the receiver from all future data
-	if (end) {
-		slot->m_end[n] = true;
-		m_valid[n]    = false;
-	}
-
-	// If the existing data is of a better quality and not an end packet
-	if (slot->m_errors < errors || end)
-		return;
-
-	::memcpy(slot->m_ambe, ambe, length);
-	slot->m_length = length;
-
-	slot->m_errors = errors;
-	slot->m_best   = n;
-}
-
-bool CSplitController::isEnd(const CAMBESlot& slot) const
-{
-	bool hasNoEnd = false;
-	bool hasEnd   = false;
-
-	for (unsigned int i = 0U; i < m_rxCount; i++) {
-		if (slot.m_valid[i] && slot.m_end[i])
-			hasEnd = true;
-
-		if (slot.m_valid[i] && !slot.m_end[i])
-			hasNoEnd = true;
-	}
-
-	return hasEnd && !hasNoEnd;	
+	if (end)
+		m_valid[n] = false;
 }
 
 void CSplitController::sendHeader()
 {
-	// Assume that the caller has the mutex lock
-	unsigned char data[2U];
-	data[0U] = DSMTT_HEADER;
-	data[1U] = RADIO_HEADER_LENGTH_BYTES - 2U;
-	m_rxData.addData(data, 2U);
-
-	m_rxData.addData(m_header, RADIO_HEADER_LENGTH_BYTES - 2U);
+	writeRX(DSMTT_HEADER, m_header, RADIO_HEADER_LENGTH_BYTES - 2U);
 
 	m_headerSent = true;
 }
@@ -743,5 +602,8 @@ void CSplitController::printStats() const
 		}
 	}
 
+	temp.Printf(wxT(", Delay: %ums"), m_combiner.getDelay());
+	text.Append(temp);
+
 	wxLogMessage(text);
 }
@@ -20,38 +20,21 @@
 #define	SplitController_H
 
 #include "GatewayProtocolHandler.h"
+#include "DiversityCombiner.h"
+#include "AMBEConcealer.h"
 #include "DStarDefines.h"
+#include "TimerCallback.h"
 #include "RingBuffer.h"
+#include "TimerWheel.h"
 #include "Timer.h"
 #include "Modem.h"
 #include "Utils.h"
 
 #include <wx/wx.h>
 
-class CAMBESlot {
+class CSplitController : public CModem, public ITimerCallback {
 public:
-	CAMBESlot(unsigned int rxCount);
-	~CAMBESlot();
-
-	void reset();
-
-	bool isFirst() const;
-
-	bool*          m_valid;
-	unsigned int   m_errors;
-	unsigned int   m_best;
-	unsigned char* m_ambe;
-	unsigned int   m_length;
-	bool*          m_end;
-	CTimer         m_timer;
-
-private:
-	unsigned int   m_rxCount;
-};
-
-class CSplitController : public CModem {
-public:
-	CSplitController(const wxString& localAddress, unsigned int localPort, const wxArrayString& transmitterNames, const wxArrayString& receiverNames, unsigned int timeout);
+	CSplitController(const wxString& localAddress, unsigned int localPort, const wxArrayString& transmitterNames, const wxArrayString& receiverNames, unsigned int timeout, unsigned int concealFrames);
 	virtual ~CSplitController();
 
 	virtual void* Entry();
@@ -64,16 +47,20 @@ public:
 	virtual bool writeHeader(const CHeaderData& header);
 	virtual bool writeData(const unsigned char* data, unsigned int length, bool end);
 
+	virtual void timerExpired(CTimer& timer);
+
 private:
 	CGatewayProtocolHandler    m_handler;
 	wxArrayString              m_transmitterNames;
 	wxArrayString              m_receiverNames;
-	unsigned int               m_timeout;
 	unsigned int               m_txCount;
 	unsigned int               m_rxCount;
+	CTimerWheel                m_wheel;
 	in_addr*                   m_txAddresses;
 	unsigned int*              m_txPorts;
 	CTimer**                   m_txTimers;
+	in_addr*                   m_sendAddresses;
+	unsigned int*              m_sendPorts;
 	in_addr*                   m_rxAddresses;
 	unsigned int*              m_rxPorts;
 	CTimer**                   m_rxTimers;
@@ -82,12 +69,11 @@ private:
 	wxUint8                    m_outSeq;
 	CTimer                     m_endTimer;
 	bool                       m_listening;
-	wxUint8                    m_inSeqNo;
-	wxUint8                    m_outSeqNo;
 	unsigned char*             m_header;
 	wxUint16*                  m_id;
 	bool*                      m_valid;
-	CAMBESlot**                m_slots;
+	CDiversityCombiner         m_combiner;
+	CAMBEConcealer             m_concealer;
 	bool                       m_headerSent;
 	unsigned int*              m_packets;
 	unsigned int*              m_best;
@@ -95,11 +81,11 @@ private:
 	unsigned int               m_silence;
 
 	void transmit();
+	unsigned int getTransmitters();
 	void receive();
 	void timers(unsigned int ms);
 	void processHeader(unsigned int n, wxUint16 id, const unsigned char* header, unsigned int length);
-	void processAMBE(unsigned int n, wxUint16 id, const unsigned char* ambe, unsigned int length, wxUint8 seqNo, unsigned char errors);
-	bool isEnd(const CAMBESlot& slot) const;
+	void processAMBE(unsigned int n, wxUint16 id, const unsigned char* ambe, unsigned int length, wxUint8 seqNo);
 	void sendHeader();
 	void printStats() const;
 };
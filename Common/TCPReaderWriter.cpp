@@ -199,6 +199,12 @@ int CTCPReaderWriter::read(unsigned char* buffer, unsigned int length, unsigned
 		return -1;
 	}
 
+	// Readable with nothing to read means that the other end has gone
+	if (len == 0) {
+		wxLogError(wxT("The TCP connection has been closed"));
+		return -1;
+	}
+
 	return len;
 }
 
@@ -232,3 +238,8 @@ void CTCPReaderWriter::close()
 		m_fd = -1;
 	}
 }
+
+int CTCPReaderWriter::getFD() const
+{
+	return m_fd;
+}
@@ -47,6 +47,8 @@ public:
 
 	void close();
 
+	int  getFD() const;
+
 private:
 	wxString       m_address;
 	unsigned short m_port;
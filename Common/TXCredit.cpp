@@ -0,0 +1,130 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "DStarDefines.h"
+#include "TXCredit.h"
+
+CTXCredit::CTXCredit(unsigned int target) :
+m_target(target),
+m_capacity(0U),
+m_space(0U),
+m_time(0U),
+m_active(false),
+m_empty(true),
+m_full(false),
+m_underruns(0U),
+m_overruns(0U)
+{
+	wxASSERT(target > 0U);
+}
+
+void CTXCredit::setSpace(unsigned int space)
+{
+	if (space > m_capacity)
+		m_capacity = space;
+
+	m_space = space;
+
+	// Count a full buffer once however many polls it lasts for
+	bool full = space == 0U && m_capacity > 0U;
+	if (full && !m_full && m_active)
+		m_overruns++;
+
+	m_full = full;
+}
+
+unsigned int CTXCredit::getSpace() const
+{
+	unsigned int fill = m_capacity - m_space;
+	if (fill >= m_target)
+		return 0U;
+
+	unsigned int room = m_target - fill;
+
+	return room < m_space ? room : m_space;
+}
+
+void CTXCredit::write(unsigned int slots, bool end)
+{
+	m_space -= slots < m_space ? slots : m_space;
+
+	m_active = !end;
+	m_empty  = false;
+}
+
+unsigned int CTXCredit::getNext(unsigned int limit) const
+{
+	if (m_space >= m_capacity)
+		return limit;
+
+	unsigned int next = DSTAR_FRAME_TIME_MS - m_time;
+
+	return next < limit ? next : limit;
+}
+
+void CTXCredit::clock(unsigned int ms)
+{
+	if (m_space < m_capacity) {
+		m_time += ms;
+
+		while (m_time >= DSTAR_FRAME_TIME_MS && m_space < m_capacity) {
+			m_time -= DSTAR_FRAME_TIME_MS;
+			m_space++;
+		}
+	}
+
+	if (m_space < m_capacity)
+		return;
+
+	m_time = 0U;
+
+	if (m_active && !m_empty)
+		m_underruns++;
+
+	m_empty = true;
+}
+
+void CTXCredit::reset()
+{
+	m_space  = 0U;
+	m_time   = 0U;
+	m_active = false;
+	m_empty  = true;
+	m_full   = false;
+}
+
+unsigned int CTXCredit::getUnderruns() const
+{
+	return m_underruns;
+}
+
+unsigned int CTXCredit::getOverruns() const
+{
+	return m_overruns;
+}
+
+void CTXCredit::log(const wxString& title)
+{
+	if (m_underruns == 0U && m_overruns == 0U)
+		return;
+
+	wxLogMessage(wxT("%s: %u underruns, %u overruns"), title.c_str(), m_underruns, m_overruns);
+
+	m_underruns = 0U;
+	m_overruns  = 0U;
+}
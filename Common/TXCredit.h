@@ -0,0 +1,68 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	TXCredit_H
+#define	TXCredit_H
+
+#include <wx/wx.h>
+
+// Models the TX buffer of a modem between its status polls. The modem reports its free space, in
+// slots of one data frame, and sends one slot every 20ms while it has anything, so the space can
+// be worked out from what has been written since. Only enough is written to keep the buffer at the
+// target fill, any more would only add to the delay.
+class CTXCredit {
+public:
+	CTXCredit(unsigned int target);
+
+	// The free space reported by the modem, the most it has ever reported is taken as empty
+	void         setSpace(unsigned int space);
+
+	// The space that may be written now, within the target fill
+	unsigned int getSpace() const;
+
+	// The end of a transmission stops the counting of underruns until the next one starts
+	void         write(unsigned int slots, bool end = false);
+
+	void         clock(unsigned int ms);
+
+	// Milliseconds until the modem is next taken to have sent a slot, or limit if it has nothing to send
+	unsigned int getNext(unsigned int limit) const;
+
+	// After the modem has been opened again, wait for its status
+	void         reset();
+
+	// The buffer running empty during a transmission, and the modem reporting it full
+	unsigned int getUnderruns() const;
+	unsigned int getOverruns() const;
+
+	// Logs the counts for the transmission that has just ended and clears them
+	void         log(const wxString& title);
+
+private:
+	unsigned int m_target;
+	unsigned int m_capacity;
+	unsigned int m_space;
+	unsigned int m_time;
+	bool         m_active;
+	bool         m_empty;
+	bool         m_full;
+	unsigned int m_underruns;
+	unsigned int m_overruns;
+};
+
+#endif
@@ -23,7 +23,14 @@
 CTimer::CTimer(unsigned int ticksPerSec, unsigned int secs, unsigned int msecs) :
 m_ticksPerSec(ticksPerSec),
 m_timeout(0U),
-m_timer(0U)
+m_timer(0U),
+m_wheel(NULL),
+m_callback(NULL),
+m_start(0U),
+m_expiry(0U),
+m_expired(false),
+m_next(NULL),
+m_pprev(NULL)
 {
 	wxASSERT(ticksPerSec > 0U);
 
@@ -34,8 +41,35 @@ m_timer(0U)
 	}
 }
 
+CTimer::CTimer(CTimerWheel& wheel, unsigned int secs, unsigned int msecs, ITimerCallback* callback) :
+m_ticksPerSec(1000U),
+m_timeout(0U),
+m_timer(0U),
+m_wheel(&wheel),
+m_callback(callback),
+m_start(0U),
+m_expiry(0U),
+m_expired(false),
+m_next(NULL),
+m_pprev(NULL)
+{
+	setTimeout(secs, msecs);
+}
+
 CTimer::~CTimer()
 {
+	if (m_wheel != NULL)
+		cancel();
+}
+
+void CTimer::setWheel(CTimerWheel& wheel, ITimerCallback* callback)
+{
+	wxASSERT(m_ticksPerSec == 1000U);
+
+	stop();
+
+	m_wheel    = &wheel;
+	m_callback = callback;
 }
 
 void CTimer::setTimeout(unsigned int secs, unsigned int msecs)
@@ -44,9 +78,16 @@ void CTimer::setTimeout(unsigned int secs, unsigned int msecs)
 		// m_timeout = ((secs * 1000U + msecs) * m_ticksPerSec) / 1000U + 1U;
 		unsigned wxLongLong_t temp = (secs * wxULL(1000) + msecs) * m_ticksPerSec;
 		m_timeout = (unsigned int)(temp / wxULL(1000) + wxULL(1));
+
+		// A running timer keeps its start time
+		if (m_wheel != NULL && m_timer > 0U)
+			schedule(false);
 	} else {
 		m_timeout = 0U;
 		m_timer = 0U;
+
+		if (m_wheel != NULL)
+			cancel();
 	}
 }
 
@@ -63,5 +104,40 @@ unsigned int CTimer::getTimer() const
 	if (m_timer == 0U)
 		return 0U;
 
-	return (m_timer - 1U) / m_ticksPerSec;
+	return (getTicks() - 1U) / m_ticksPerSec;
+}
+
+unsigned int CTimer::getTicks() const
+{
+	if (m_wheel == NULL || m_timer == 0U)
+		return m_timer;
+
+	return (unsigned int)(m_wheel->getTime() - m_start) + 1U;
+}
+
+void CTimer::schedule(bool restart)
+{
+	wxASSERT(m_wheel != NULL);
+
+	wxUint64 now = m_wheel->getTime();
+
+	if (restart)
+		m_start = now;
+
+	m_wheel->remove(this);
+
+	m_expired = false;
+	m_expiry  = m_start + m_timeout - 1U;
+	if (m_expiry <= now)
+		m_expiry = now + 1U;
+
+	m_wheel->insert(this);
+}
+
+void CTimer::cancel()
+{
+	wxASSERT(m_wheel != NULL);
+
+	m_wheel->remove(this);
+	m_expired = false;
 }
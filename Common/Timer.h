@@ -19,11 +19,19 @@
 #ifndef	Timer_H
 #define	Timer_H
 
+#include "TimerCallback.h"
+#include "TimerWheel.h"
+
+// A timer is either clocked by its owner, or is a millisecond timer on a CTimerWheel which sets it
+// expired, and calls the callback if there is one, when its time comes
 class CTimer {
 public:
 	CTimer(unsigned int ticksPerSec = 1000, unsigned int secs = 0U, unsigned int msecs = 0U);
+	CTimer(CTimerWheel& wheel, unsigned int secs = 0U, unsigned int msecs = 0U, ITimerCallback* callback = NULL);
 	~CTimer();
 
+	void setWheel(CTimerWheel& wheel, ITimerCallback* callback = NULL);
+
 	void setTimeout(unsigned int secs, unsigned int msecs = 0U);
 
 	unsigned int getTimeout() const;
@@ -34,10 +42,24 @@ public:
 		if (m_timeout == 0U || m_timer == 0U)
 			return 0U;
 
-		if (m_timer >= m_timeout)
+		unsigned int timer = getTicks();
+		if (timer >= m_timeout)
+			return 0U;
+
+		return (m_timeout - timer) / m_ticksPerSec;
+	}
+
+	// In ticks, so milliseconds for a millisecond timer
+	unsigned int getRemainingTicks()
+	{
+		if (m_timeout == 0U || m_timer == 0U)
+			return 0U;
+
+		unsigned int timer = getTicks();
+		if (timer >= m_timeout)
 			return 0U;
 
-		return (m_timeout - m_timer) / m_ticksPerSec;
+		return m_timeout - timer;
 	}
 
 	bool isRunning()
@@ -54,13 +76,20 @@ public:
 
 	void start()
 	{
-		if (m_timeout > 0U)
+		if (m_timeout > 0U) {
 			m_timer = 1U;
+
+			if (m_wheel != NULL)
+				schedule(true);
+		}
 	}
 
 	void stop()
 	{
 		m_timer = 0U;
+
+		if (m_wheel != NULL)
+			cancel();
 	}
 
 	bool hasExpired()
@@ -68,22 +97,42 @@ public:
 		if (m_timeout == 0U || m_timer == 0U)
 			return false;
 
+		if (m_wheel != NULL)
+			return m_expired;
+
 		if (m_timer >= m_timeout)
 			return true;
 
 		return false;
 	}
 
+	// Does nothing for a timer on a wheel
 	void clock(unsigned int ticks = 1U)
 	{
-		if (m_timer > 0U && m_timeout > 0U)
+		if (m_wheel == NULL && m_timer > 0U && m_timeout > 0U)
 			m_timer += ticks;
 	}
 
 private:
-	unsigned int m_ticksPerSec;
-	unsigned int m_timeout;
-	unsigned int m_timer;
+	unsigned int    m_ticksPerSec;
+	unsigned int    m_timeout;
+	unsigned int    m_timer;
+	CTimerWheel*    m_wheel;
+	ITimerCallback* m_callback;
+	wxUint64        m_start;
+	wxUint64        m_expiry;
+	bool            m_expired;
+	CTimer*         m_next;
+	CTimer**        m_pprev;
+
+	friend class CTimerWheel;
+
+	CTimer(const CTimer&);
+	CTimer& operator=(const CTimer&);
+
+	unsigned int getTicks() const;
+	void         schedule(bool restart);
+	void         cancel();
 };
 
 #endif
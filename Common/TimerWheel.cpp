@@ -0,0 +1,193 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "TimerWheel.h"
+#include "Timer.h"
+
+const unsigned int LEVEL0_BITS = 8U;
+const unsigned int LEVELN_BITS = 6U;
+
+const unsigned int LEVEL0_MASK = (1U << LEVEL0_BITS) - 1U;
+const unsigned int LEVELN_MASK = (1U << LEVELN_BITS) - 1U;
+
+// Further out than this and the timer waits in the last slot to be cascaded again
+const wxUint64 MAX_DELTA = wxUint64(1U) << (LEVEL0_BITS + (TIMER_WHEEL_LEVELS - 1U) * LEVELN_BITS);
+
+static unsigned int getShift(unsigned int level)
+{
+	return (level == 0U) ? 0U : (LEVEL0_BITS + (level - 1U) * LEVELN_BITS);
+}
+
+CTimerWheel::CTimerWheel() :
+m_now(0U)
+{
+	for (unsigned int i = 0U; i < TIMER_WHEEL_LEVELS; i++) {
+		unsigned int slots = (i == 0U) ? TIMER_WHEEL_SLOTS : (LEVELN_MASK + 1U);
+
+		m_slots[i] = new CTimer*[slots];
+		for (unsigned int j = 0U; j < slots; j++)
+			m_slots[i][j] = NULL;
+	}
+}
+
+CTimerWheel::~CTimerWheel()
+{
+	// Leave any timers still running in a safe state
+	for (unsigned int i = 0U; i < TIMER_WHEEL_LEVELS; i++) {
+		unsigned int slots = (i == 0U) ? TIMER_WHEEL_SLOTS : (LEVELN_MASK + 1U);
+
+		for (unsigned int j = 0U; j < slots; j++) {
+			while (m_slots[i][j] != NULL)
+				remove(m_slots[i][j]);
+		}
+
+		delete[] m_slots[i];
+	}
+}
+
+void CTimerWheel::clock(unsigned int ms)
+{
+	while (ms > 0U) {
+		m_now++;
+		ms--;
+
+		// Bring the timers from the outer levels closer as each one comes round
+		unsigned int index = (unsigned int)(m_now & LEVEL0_MASK);
+		if (index == 0U)
+			cascade(1U);
+
+		// Take the whole slot first as the callbacks may start and stop timers
+		CTimer* timer = m_slots[0U][index];
+		m_slots[0U][index] = NULL;
+		if (timer != NULL)
+			timer->m_pprev = &timer;
+
+		while (timer != NULL) {
+			CTimer* expired = timer;
+			remove(expired);
+
+			expired->m_expired = true;
+			if (expired->m_callback != NULL)
+				expired->m_callback->timerExpired(*expired);
+		}
+	}
+}
+
+wxUint64 CTimerWheel::getTime() const
+{
+	return m_now;
+}
+
+unsigned int CTimerWheel::getNext(unsigned int limit) const
+{
+	wxASSERT(limit > 0U);
+
+	// The first level only holds timers due within one turn of it, so the first slot in use is the
+	// earliest of them
+	unsigned int slots = (limit < TIMER_WHEEL_SLOTS) ? limit : (TIMER_WHEEL_SLOTS - 1U);
+	for (unsigned int i = 1U; i <= slots; i++) {
+		if (m_slots[0U][(unsigned int)((m_now + i) & LEVEL0_MASK)] != NULL)
+			return i;
+	}
+
+	// The outer levels are not in time order, but they hold few timers
+	wxUint64 next = m_now + limit;
+	for (unsigned int i = 1U; i < TIMER_WHEEL_LEVELS; i++) {
+		for (unsigned int j = 0U; j <= LEVELN_MASK; j++) {
+			for (const CTimer* timer = m_slots[i][j]; timer != NULL; timer = timer->m_next) {
+				if (timer->m_expiry < next)
+					next = timer->m_expiry;
+			}
+		}
+	}
+
+	if (next <= m_now)
+		return 1U;
+
+	return (unsigned int)(next - m_now);
+}
+
+void CTimerWheel::insert(CTimer* timer)
+{
+	wxASSERT(timer != NULL);
+	wxASSERT(timer->m_pprev == NULL);
+
+	// Only a cascade adds a timer due now, its slot is run straight afterwards
+	wxUint64 expiry = timer->m_expiry;
+	if (expiry < m_now)
+		expiry = m_now;
+
+	wxUint64 delta = expiry - m_now;
+	if (delta >= MAX_DELTA)
+		expiry = m_now + MAX_DELTA - 1U;
+
+	unsigned int level = 0U;
+	while (level < (TIMER_WHEEL_LEVELS - 1U) && delta >= (wxUint64(1U) << getShift(level + 1U)))
+		level++;
+
+	unsigned int mask  = (level == 0U) ? LEVEL0_MASK : LEVELN_MASK;
+	unsigned int index = (unsigned int)(expiry >> getShift(level)) & mask;
+
+	CTimer** head = &m_slots[level][index];
+
+	timer->m_next = *head;
+	if (*head != NULL)
+		(*head)->m_pprev = &timer->m_next;
+	timer->m_pprev = head;
+	*head = timer;
+}
+
+void CTimerWheel::remove(CTimer* timer)
+{
+	wxASSERT(timer != NULL);
+
+	if (timer->m_pprev == NULL)
+		return;
+
+	*timer->m_pprev = timer->m_next;
+	if (timer->m_next != NULL)
+		timer->m_next->m_pprev = timer->m_pprev;
+
+	timer->m_next  = NULL;
+	timer->m_pprev = NULL;
+}
+
+void CTimerWheel::cascade(unsigned int level)
+{
+	if (level >= TIMER_WHEEL_LEVELS)
+		return;
+
+	unsigned int index = (unsigned int)(m_now >> getShift(level)) & LEVELN_MASK;
+
+	// Cascade the next level first when this one has wrapped too
+	if (index == 0U)
+		cascade(level + 1U);
+
+	CTimer* timer = m_slots[level][index];
+	m_slots[level][index] = NULL;
+
+	while (timer != NULL) {
+		CTimer* next = timer->m_next;
+
+		timer->m_next  = NULL;
+		timer->m_pprev = NULL;
+		insert(timer);
+
+		timer = next;
+	}
+}
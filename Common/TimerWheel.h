@@ -0,0 +1,55 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	TimerWheel_H
+#define	TimerWheel_H
+
+#include <wx/wx.h>
+
+class CTimer;
+
+const unsigned int TIMER_WHEEL_LEVELS = 4U;
+const unsigned int TIMER_WHEEL_SLOTS  = 256U;		// The first level, the others have 64
+
+// A hierarchical timer wheel with a one millisecond tick. Starting and stopping a timer is O(1), and
+// a tick only looks at the timers due in that millisecond, plus a cascade every 256ms.
+class CTimerWheel {
+public:
+	CTimerWheel();
+	~CTimerWheel();
+
+	void     clock(unsigned int ms);
+
+	// Milliseconds since the wheel was created
+	wxUint64 getTime() const;
+
+	// Milliseconds until the next timer is due, or limit if none is due before then
+	unsigned int getNext(unsigned int limit) const;
+
+private:
+	wxUint64 m_now;
+	CTimer** m_slots[TIMER_WHEEL_LEVELS];
+
+	friend class CTimer;
+
+	void insert(CTimer* timer);
+	void remove(CTimer* timer);
+	void cascade(unsigned int level);
+};
+
+#endif
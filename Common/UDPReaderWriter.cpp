@@ -35,6 +35,37 @@ m_fd(-1)
 	if (wsaRet != 0)
 		wxLogError(wxT("Error from WSAStartup"));
 #endif
+
+#if defined(__linux__)
+	m_rxMsgs   = new mmsghdr[UDP_BATCH_COUNT];
+	m_rxIOVs   = new iovec[UDP_BATCH_COUNT];
+	m_rxAddrs  = new sockaddr_in[UDP_BATCH_COUNT];
+	m_rxBuffer = new unsigned char[UDP_BATCH_COUNT * UDP_DATAGRAM_LENGTH];
+	m_txMsgs   = new mmsghdr[UDP_BATCH_COUNT];
+	m_txAddrs  = new sockaddr_in[UDP_BATCH_COUNT];
+	m_rxCount  = 0U;
+	m_rxNext   = 0U;
+
+	::memset(m_rxMsgs,  0x00, UDP_BATCH_COUNT * sizeof(mmsghdr));
+	::memset(m_txMsgs,  0x00, UDP_BATCH_COUNT * sizeof(mmsghdr));
+	::memset(m_txAddrs, 0x00, UDP_BATCH_COUNT * sizeof(sockaddr_in));
+
+	for (unsigned int i = 0U; i < UDP_BATCH_COUNT; i++) {
+		m_rxIOVs[i].iov_base = m_rxBuffer + i * UDP_DATAGRAM_LENGTH;
+		m_rxIOVs[i].iov_len  = UDP_DATAGRAM_LENGTH;
+
+		m_rxMsgs[i].msg_hdr.msg_name   = &m_rxAddrs[i];
+		m_rxMsgs[i].msg_hdr.msg_iov    = &m_rxIOVs[i];
+		m_rxMsgs[i].msg_hdr.msg_iovlen = 1U;
+
+		m_txAddrs[i].sin_family = AF_INET;
+
+		m_txMsgs[i].msg_hdr.msg_name    = &m_txAddrs[i];
+		m_txMsgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+		m_txMsgs[i].msg_hdr.msg_iov     = &m_txIOV;
+		m_txMsgs[i].msg_hdr.msg_iovlen  = 1U;
+	}
+#endif
 }
 
 CUDPReaderWriter::~CUDPReaderWriter()
@@ -42,6 +73,15 @@ CUDPReaderWriter::~CUDPReaderWriter()
 #if defined(__WINDOWS__)
 	::WSACleanup();
 #endif
+
+#if defined(__linux__)
+	delete[] m_rxMsgs;
+	delete[] m_rxIOVs;
+	delete[] m_rxAddrs;
+	delete[] m_rxBuffer;
+	delete[] m_txMsgs;
+	delete[] m_txAddrs;
+#endif
 }
 
 in_addr CUDPReaderWriter::lookup(const wxString& hostname)
@@ -140,6 +180,48 @@ bool CUDPReaderWriter::open()
 
 int CUDPReaderWriter::read(unsigned char* buffer, unsigned int length, in_addr& address, unsigned int& port)
 {
+#if defined(__linux__)
+	// Take everything waiting on the socket in one call, and hand it out one datagram at a time
+	if (m_rxNext >= m_rxCount) {
+		m_rxCount = 0U;
+		m_rxNext  = 0U;
+
+		for (unsigned int i = 0U; i < UDP_BATCH_COUNT; i++)
+			m_rxMsgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+
+		int ret = ::recvmmsg(m_fd, m_rxMsgs, UDP_BATCH_COUNT, MSG_DONTWAIT, NULL);
+		if (ret < 0) {
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+				return 0;
+
+			wxLogError(wxT("Error returned from recvmmsg (port: %u), err: %d"), m_port, errno);
+			return -1;
+		}
+
+		if (ret == 0)
+			return 0;
+
+		m_rxCount = ret;
+	}
+
+	unsigned int n = m_rxNext++;
+
+	unsigned int len = m_rxMsgs[n].msg_len;
+	if (len == 0U) {
+		wxLogError(wxT("Empty datagram returned from recvmmsg (port: %u)"), m_port);
+		return -1;
+	}
+
+	if (len > length)
+		len = length;
+
+	::memcpy(buffer, m_rxIOVs[n].iov_base, len);
+
+	address = m_rxAddrs[n].sin_addr;
+	port    = ntohs(m_rxAddrs[n].sin_port);
+
+	return len;
+#else
 	// Check that the readfrom() won't block
 	fd_set readFds;
 	FD_ZERO(&readFds);
@@ -188,6 +270,7 @@ int CUDPReaderWriter::read(unsigned char* buffer, unsigned int length, in_addr&
 	port    = ntohs(addr.sin_port);
 
 	return len;
+#endif
 }
 
 bool CUDPReaderWriter::write(const unsigned char* buffer, unsigned int length, const in_addr& address, unsigned int port)
@@ -215,6 +298,54 @@ bool CUDPReaderWriter::write(const unsigned char* buffer, unsigned int length, c
 	return true;
 }
 
+bool CUDPReaderWriter::write(const unsigned char* buffer, unsigned int length, const in_addr* addresses, const unsigned int* ports, unsigned int count)
+{
+	wxASSERT(buffer != NULL);
+	wxASSERT(addresses != NULL);
+	wxASSERT(ports != NULL);
+
+#if defined(__linux__)
+	m_txIOV.iov_base = (void*)buffer;
+	m_txIOV.iov_len  = length;
+
+	while (count > 0U) {
+		unsigned int n = count;
+		if (n > UDP_BATCH_COUNT)
+			n = UDP_BATCH_COUNT;
+
+		for (unsigned int i = 0U; i < n; i++) {
+			m_txAddrs[i].sin_addr = addresses[i];
+			m_txAddrs[i].sin_port = htons(ports[i]);
+		}
+
+		unsigned int sent = 0U;
+		while (sent < n) {
+			int ret = ::sendmmsg(m_fd, m_txMsgs + sent, n - sent, 0);
+			if (ret < 0) {
+				wxLogError(wxT("Error returned from sendmmsg (port: %u), err: %d"), m_port, errno);
+				return false;
+			}
+
+			sent += ret;
+		}
+
+		addresses += n;
+		ports     += n;
+		count     -= n;
+	}
+
+	return true;
+#else
+	for (unsigned int i = 0U; i < count; i++) {
+		bool ret = write(buffer, length, addresses[i], ports[i]);
+		if (!ret)
+			return false;
+	}
+
+	return true;
+#endif
+}
+
 void CUDPReaderWriter::close()
 {
 #if defined(__WINDOWS__)
@@ -222,9 +353,19 @@ void CUDPReaderWriter::close()
 #else
 	::close(m_fd);
 #endif
+
+#if defined(__linux__)
+	m_rxCount = 0U;
+	m_rxNext  = 0U;
+#endif
 }
 
 unsigned int CUDPReaderWriter::getPort() const
 {
 	return m_port;
 }
+
+int CUDPReaderWriter::getFD() const
+{
+	return m_fd;
+}
@@ -32,6 +32,9 @@
 #include <errno.h>
 #endif
 
+const unsigned int UDP_BATCH_COUNT     = 16U;		// Datagrams per recvmmsg or sendmmsg call
+const unsigned int UDP_DATAGRAM_LENGTH = 1500U;
+
 class CUDPReaderWriter {
 public:
 	CUDPReaderWriter(const wxString& address, unsigned int port);
@@ -44,15 +47,31 @@ public:
 	int  read(unsigned char* buffer, unsigned int length, in_addr& address, unsigned int& port);
 	bool write(const unsigned char* buffer, unsigned int length, const in_addr& address, unsigned int port);
 
+	// Send the same datagram to count destinations, which may repeat
+	bool write(const unsigned char* buffer, unsigned int length, const in_addr* addresses, const unsigned int* ports, unsigned int count);
+
 	void close();
 
 	unsigned int getPort() const;
 
+	int  getFD() const;
+
 private:
 	wxString       m_address;
 	unsigned short m_port;
 	in_addr        m_addr;
 	int            m_fd;
+#if defined(__linux__)
+	mmsghdr*       m_rxMsgs;
+	iovec*         m_rxIOVs;
+	sockaddr_in*   m_rxAddrs;
+	unsigned char* m_rxBuffer;
+	unsigned int   m_rxCount;
+	unsigned int   m_rxNext;
+	mmsghdr*       m_txMsgs;
+	sockaddr_in*   m_txAddrs;
+	iovec          m_txIOV;
+#endif
 };
 
 #endif
@@ -13,6 +13,8 @@
 
 #include "Utils.h"
 
+#include <chrono>
+
 void CUtils::dump(const wxChar* title, const unsigned char* data, unsigned int length)
 {
 	wxASSERT(title != NULL);
@@ -59,3 +61,17 @@ void CUtils::dump(const wxChar* title, const unsigned char* data, unsigned int l
 			length = 0U;
 	}
 }
+
+wxUint64 CUtils::getTimestamp()
+{
+	return wxUint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void CUtils::getUTC(time_t timestamp, struct tm& tm)
+{
+#if defined(__WINDOWS__)
+	::gmtime_s(&tm, &timestamp);
+#else
+	::gmtime_r(&timestamp, &tm);
+#endif
+}
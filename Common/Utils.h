@@ -16,6 +16,8 @@
 
 #include <wx/wx.h>
 
+#include <ctime>
+
 enum TRISTATE {
 	STATE_FALSE,
 	STATE_TRUE,
@@ -26,6 +28,12 @@ class CUtils {
 public:
 	static void dump(const wxChar* title, const unsigned char* data, unsigned int length);
 
+	// Microseconds from a monotonic clock, only useful for measuring intervals
+	static wxUint64 getTimestamp();
+
+	// The same as ::gmtime but safe to call from any thread
+	static void getUTC(time_t timestamp, struct tm& tm);
+
 private:
 };
 
@@ -19,37 +19,10 @@
 #include <stdexcept>
 
 #include <wx/cmdline.h>
-#include <wx/filename.h>
 #include <wx/event.h>
 
 #include "DStarRepeaterLogRedirect.h"
-#include "DStarRepeaterTXRXThread.h"
-#include "RepeaterProtocolHandler.h"
-#include "DStarRepeaterTRXThread.h"
-#include "DStarRepeaterTXThread.h"
-#include "DStarRepeaterRXThread.h"
-#include "SerialLineController.h"
-#include "DStarRepeaterThread.h"
-#include "SoundCardController.h"
-#include "DVRPTRV1Controller.h"
-#include "DVRPTRV2Controller.h"
-#include "DVRPTRV3Controller.h"
-#include "ArduinoController.h"
-#include "DVMegaController.h"
 #include "DStarRepeaterApp.h"
-#include "MMDVMController.h"
-#include "URIUSBController.h"
-#include "K8055Controller.h"
-#include "DummyController.h"
-#include "SplitController.h"
-#include "IcomController.h"
-#if defined(GPIO)
-#include "GPIOController.h"
-#include "UDRCController.h"
-#endif
-#include "DVAPController.h"
-#include "GMSKController.h"
-#include "DStarDefines.h"
 #include "Version.h"
 #include "Logger.h"
 
@@ -64,29 +37,28 @@ wxEND_EVENT_TABLE()
 const wxString NAME_PARAM = 		"Repeater Name";
 const wxString NOLOGGING_SWITCH =	"nolog";
 const wxString GUI_SWITCH = 		"gui";
+const wxString TRACE_SWITCH =		"trace";
 const wxString LOGDIR_OPTION =		"logdir";
 const wxString CONFDIR_OPTION =		"confdir";
 const wxString AUDIODIR_OPTION =	"audiodir";
-#if (wxUSE_GUI == 1)
-const wxString LOG_BASE_NAME   =	"dstarrepeater";
-#else
-const wxString LOG_BASE_NAME   =	"dstarrepeaterd";
-#endif
+
+const unsigned int LIST_RELOAD_INTERVAL = 60U;	// 1 minute
 
 CDStarRepeaterApp::CDStarRepeaterApp() :
 wxApp(),
 #if (wxUSE_GUI == 1)
 m_frame(NULL),
 #endif
-m_name(),
+m_names(),
 m_nolog(false),
 m_gui(false),
+m_trace(false),
 m_logDir(),
 m_confDir(),
 m_audioDir(),
-m_thread(NULL),
-m_config(NULL),
-m_checker(NULL),
+m_instances(NULL),
+m_count(0U),
+m_reloader(NULL),
 m_logChain(NULL)
 {
 }
@@ -102,11 +74,19 @@ bool CDStarRepeaterApp::OnInit()
 	if (!wxApp::OnInit())
 		return false;
 
+#if (wxUSE_GUI == 1)
+	// The window only shows one repeater
+	if (m_names.GetCount() > 1U) {
+		wxLogError("Only one repeater can be run with the GUI");
+		return false;
+	}
+#endif
+
 	if (!m_nolog) {
 		wxString logBaseName = LOG_BASE_NAME;
-		if (!m_name.IsEmpty()) {
+		for (unsigned int i = 0U; i < m_names.GetCount(); i++) {
 			logBaseName.Append("_");
-			logBaseName.Append(m_name);
+			logBaseName.Append(m_names.Item(i));
 		}
 
 #if defined(__WINDOWS__)
@@ -130,49 +110,50 @@ bool CDStarRepeaterApp::OnInit()
 
 	m_logChain = new wxLogChain(new CDStarRepeaterLogRedirect);
 
-	wxString appName;
-	if (!m_name.IsEmpty())
-		appName = APPLICATION_NAME + " " + m_name;
-	else
-		appName = APPLICATION_NAME;
-
-#if !defined(__WINDOWS__)
-	appName.Replace(" ", "_");
-	m_checker = new wxSingleInstanceChecker(appName, "/tmp");
-#else
-	m_checker = new wxSingleInstanceChecker(appName);
-#endif
-
-	bool ret = m_checker->IsAnotherRunning();
-	if (ret) {
-		wxLogError("Another copy of the D-Star Repeater is running, exiting");
-		return false;
-	}
+	// The worker threads write through the chain themselves
+	if (!m_nolog)
+		CLogger::setThreadTarget(m_logChain);
 
 #if defined(__WINDOWS__)
 	if (m_confDir.IsEmpty())
 		m_confDir = ::wxGetHomeDir();
-
-	m_config = new CDStarRepeaterConfig(new wxConfig(APPLICATION_NAME), m_confDir, CONFIG_FILE_NAME, m_name);
 #else
 	if (m_confDir.IsEmpty())
 		m_confDir = CONF_DIR;
+#endif
 
-	try {
-		m_config = new CDStarRepeaterConfig(m_confDir, CONFIG_FILE_NAME, m_name, true);
-	} catch( std::runtime_error& e ) {
-		wxLogError("Could not open configuration file");
-		return false;
+	// No name runs the one unnamed repeater
+	if (m_names.IsEmpty())
+		m_names.Add(wxEmptyString);
+
+	m_count     = m_names.GetCount();
+	m_instances = new CDStarRepeaterInstance*[m_count];
+
+	for (unsigned int i = 0U; i < m_count; i++) {
+		m_instances[i] = new CDStarRepeaterInstance(m_names.Item(i), m_confDir, m_logDir, m_audioDir, m_trace);
+
+		bool ret = m_instances[i]->open();
+		if (!ret) {
+			for (unsigned int j = 0U; j <= i; j++)
+				delete m_instances[j];
+
+			delete[] m_instances;
+			m_instances = NULL;
+			m_count     = 0U;
+
+			return false;
+		}
 	}
-#endif
+
+	CDStarRepeaterConfig* config = m_instances[0U]->getConfig();
 
 	wxString type;
-	m_config->getModem(type);
+	config->getModem(type);
 
 #if (wxUSE_GUI == 1)
 	wxString frameName = APPLICATION_NAME + " (" + type + ") - ";
-	if (!m_name.IsEmpty()) {
-		frameName.Append(m_name);
+	if (!m_names.Item(0U).IsEmpty()) {
+		frameName.Append(m_names.Item(0U));
 		frameName.Append(" - ");
 	}
 	frameName.Append(VERSION);
@@ -180,7 +161,7 @@ bool CDStarRepeaterApp::OnInit()
 	wxPoint position = wxDefaultPosition;
 
 	int x, y;
-	m_config->getPosition(x, y);
+	config->getPosition(x, y);
 	if (x >= 0 && y >= 0)
 		position = wxPoint(x, y);
 
@@ -195,7 +176,26 @@ bool CDStarRepeaterApp::OnInit()
 	// Log the version of wxWidgets and the Operating System
 	wxLogInfo("Using wxWidgets %d.%d.%d on %s", wxMAJOR_VERSION, wxMINOR_VERSION, wxRELEASE_NUMBER, ::wxGetOsDescription().c_str());
 
-	createThread();
+	m_reloader = new CCallsignListReloader(LIST_RELOAD_INTERVAL);
+
+	for (unsigned int i = 0U; i < m_count; i++) {
+		if (m_count > 1U)
+			wxLogInfo("Starting the repeater \"%s\"", m_names.Item(i).c_str());
+
+		m_instances[i]->start(m_reloader, m_count > 1U);
+	}
+
+#if (wxUSE_GUI == 1)
+	bool out1, out2, out3, out4;
+	config->getOutputs(out1, out2, out3, out4);
+	m_frame->setOutputs(out1, out2, out3, out4);
+
+	bool logging;
+	config->getLogging(logging);
+	m_frame->setLogging(logging);
+#endif
+
+	m_reloader->start();
 
 	return true;
 }
@@ -204,13 +204,31 @@ int CDStarRepeaterApp::OnExit()
 {
 	wxLogInfo(APPLICATION_NAME + " is exiting");
 
-	m_logChain->SetLog(NULL);
+#if (wxUSE_GUI == 1)
+	// The window has already gone, so nothing more is shown
+	m_frame = NULL;
+#endif
+
+	if (m_reloader != NULL) {
+		m_reloader->kill();
+		delete m_reloader;
+	}
+
+	for (unsigned int i = 0U; i < m_count; i++) {
+		m_instances[i]->kill();
+		delete m_instances[i];
+	}
 
-	m_thread->kill();
+	delete[] m_instances;
 
-	delete m_config;
+	// With every thread stopped nothing else can log, deleting the chain deletes the logger,
+	// which writes out whatever is still queued
+	CLogger::setThreadTarget(NULL);
 
-	delete m_checker;
+	m_logChain->SetLog(NULL);
+	wxLog::DontCreateOnDemand();
+	delete wxLog::SetActiveTarget(NULL);
+	m_logChain = NULL;
 
 	return 0;
 }
@@ -219,10 +237,11 @@ void CDStarRepeaterApp::OnInitCmdLine(wxCmdLineParser& parser)
 {
 	parser.AddSwitch(NOLOGGING_SWITCH, wxEmptyString, wxEmptyString, wxCMD_LINE_PARAM_OPTIONAL);
 	parser.AddSwitch(GUI_SWITCH,       wxEmptyString, wxEmptyString, wxCMD_LINE_PARAM_OPTIONAL);
+	parser.AddSwitch(TRACE_SWITCH,     wxEmptyString, wxEmptyString, wxCMD_LINE_PARAM_OPTIONAL);
 	parser.AddOption(LOGDIR_OPTION,    wxEmptyString, wxEmptyString, wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL);
 	parser.AddOption(CONFDIR_OPTION,   wxEmptyString, wxEmptyString, wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL);
 	parser.AddOption(AUDIODIR_OPTION,  wxEmptyString, wxEmptyString, wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL);
-	parser.AddParam(NAME_PARAM, wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL);
+	parser.AddParam(NAME_PARAM, wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL | wxCMD_LINE_PARAM_MULTIPLE);
 
 	wxApp::OnInitCmdLine(parser);
 }
@@ -234,6 +253,7 @@ bool CDStarRepeaterApp::OnCmdLineParsed(wxCmdLineParser& parser)
 
 	m_nolog = parser.Found(NOLOGGING_SWITCH);
 	m_gui   = parser.Found(GUI_SWITCH);
+	m_trace = parser.Found(TRACE_SWITCH);
 
 	wxString logDir;
 	bool found = parser.Found(LOGDIR_OPTION, &logDir);
@@ -258,8 +278,8 @@ bool CDStarRepeaterApp::OnCmdLineParsed(wxCmdLineParser& parser)
 		m_audioDir = logDir;
 #endif
 
-	if (parser.GetParamCount() > 0U)
-		m_name = parser.GetParam(0U);
+	for (unsigned int i = 0U; i < parser.GetParamCount(); i++)
+		m_names.Add(parser.GetParam(i));
 
 	return true;
 }
@@ -271,16 +291,16 @@ void CDStarRepeaterApp::OnAssertFailure(const wxChar* file, int line, const wxCh
 }
 #endif
 
-CDStarRepeaterStatusData* CDStarRepeaterApp::getStatus() const
+bool CDStarRepeaterApp::getStatus(CDStarRepeaterStatusData& status) const
 {
-	return m_thread->getStatus();
+	return m_instances[0U]->getThread()->getStatus(status);
 }
 
-void CDStarRepeaterApp::showLog(const wxString& text)
+void CDStarRepeaterApp::showLog(wxChar letter, time_t timestamp, const wxString& text)
 {
 #if (wxUSE_GUI == 1)
 	if(m_frame)
-		m_frame->showLog(text);
+		m_frame->showLog(letter, timestamp, text);
 #endif
 }
 
@@ -288,414 +308,44 @@ void CDStarRepeaterApp::setOutputs(bool out1, bool out2, bool out3, bool out4)
 {
 	wxLogInfo("Output 1 = %d, output 2 = %d, output 3 = %d, output 4 = %d", int(out1), int(out2), int(out3), int(out4));
 
-	m_thread->setOutputs(out1, out2, out3, out4);
+	m_instances[0U]->getThread()->setOutputs(out1, out2, out3, out4);
 }
 
 void CDStarRepeaterApp::setLogging(bool logging)
 {
-	wxLogInfo("Frame logging set to %d, in %s", int(logging), m_audioDir.c_str());
-
-	m_thread->setLogging(logging, m_audioDir);
+	m_instances[0U]->setLogging(logging);
 }
 
 void CDStarRepeaterApp::setPosition(int x, int y)
 {
-	m_config->setPosition(x, y);
-	m_config->write();
+	CDStarRepeaterConfig* config = m_instances[0U]->getConfig();
+
+	config->setPosition(x, y);
+	config->write();
 }
 
 void CDStarRepeaterApp::OnRemoteCmd(wxThreadEvent& event)
 {
-	wxLogMessage("Request to execute command %s (%d)", m_commandLine[event.GetInt()], event.GetInt());
+	// A command from the GUI has no name and is for the only repeater
+	CDStarRepeaterInstance* instance = m_instances[0U];
+	for (unsigned int i = 0U; i < m_count; i++) {
+		if (m_instances[i]->getName().IsSameAs(event.GetString()))
+			instance = m_instances[i];
+	}
+
+	wxString commandLine = instance->getCommandLine(event.GetInt());
+
+	wxLogMessage("Request to execute command %s (%d)", commandLine, event.GetInt());
 	// XXX sanity check the command line here.
-	wxShell(m_commandLine[event.GetInt()]);
+	wxShell(commandLine);
 }
 
 void CDStarRepeaterApp::startup()
 {
-	m_thread->startup();
+	m_instances[0U]->getThread()->startup();
 }
 
 void CDStarRepeaterApp::shutdown()
 {
-	m_thread->shutdown();
-}
-
-void CDStarRepeaterApp::createThread()
-{
-	wxASSERT(m_config != NULL);
-
-	wxString callsign, gateway;
-	DSTAR_MODE mode;
-	ACK_TYPE ack;
-	bool restriction, rpt1Validation, dtmfBlanking, errorReply;
-	m_config->getCallsign(callsign, gateway, mode, ack, restriction, rpt1Validation, dtmfBlanking, errorReply);
-
-	wxString modemType;
-	m_config->getModem(modemType);
-
-	// DVAP can only do simplex, force the mode accordingly
-	if (modemType.IsSameAs("DVAP") || modemType.IsSameAs(wxT("Icom Access Point/Terminal Mode"))) {
-		if (mode == MODE_DUPLEX) {
-			wxLogInfo("Changing mode from DUPLEX to SIMPLEX");
-			mode = MODE_SIMPLEX;
-		} else if (mode == MODE_TXANDRX) {
-			wxLogInfo("Changing mode from TX_AND_RX to RX_ONLY");
-			mode = MODE_RXONLY;
-		}
-	}
-
-	//  XXX This should be m_thread eventually.
-	switch (mode) {
-		case MODE_RXONLY:
-			m_thread = new CDStarRepeaterRXThread(modemType);
-			break;
-		case MODE_TXONLY:
-			m_thread = new CDStarRepeaterTXThread(modemType);
-			break;
-		case MODE_TXANDRX:
-			m_thread = new CDStarRepeaterTXRXThread(modemType);
-			break;
-		default:
-			m_thread = new CDStarRepeaterTRXThread(modemType);
-			break;
-	}
-
-	m_thread->setCallsign(callsign, gateway, mode, ack, restriction, rpt1Validation, dtmfBlanking, errorReply);
-	wxLogInfo("Callsign set to \"%s\", gateway set to \"%s\", mode: %d, ack: %d, restriction: %d, RPT1 validation: %d, DTMF blanking: %d, Error reply: %d", callsign.c_str(), gateway.c_str(), int(mode), int(ack), int(restriction), int(rpt1Validation), int(dtmfBlanking), int(errorReply));
-
-	wxString gatewayAddress, localAddress, name;
-	unsigned int gatewayPort, localPort;
-	m_config->getNetwork(gatewayAddress, gatewayPort, localAddress, localPort, name);
-	wxLogInfo("Gateway set to %s:%u, local set to %s:%u, name set to \"%s\"", gatewayAddress.c_str(), gatewayPort, localAddress.c_str(), localPort, name.c_str());
-
-	if (!gatewayAddress.IsEmpty()) {
-		bool local = gatewayAddress.IsSameAs("127.0.0.1");
-
-		CRepeaterProtocolHandler* handler = new CRepeaterProtocolHandler(gatewayAddress, gatewayPort, localAddress, localPort, name);
-
-		bool res = handler->open();
-		if (!res)
-			wxLogError("Cannot open the protocol handler");
-		else
-			m_thread->setProtocolHandler(handler, local);
-	}
-
-	unsigned int timeout, ackTime;
-	m_config->getTimes(timeout, ackTime);
-	m_thread->setTimes(timeout, ackTime);
-	wxLogInfo("Timeout set to %u secs, ack time set to %u ms", timeout, ackTime);
-
-	unsigned int beaconTime;
-	wxString beaconText;
-	bool beaconVoice;
-	TEXT_LANG language;
-	m_config->getBeacon(beaconTime, beaconText, beaconVoice, language);
-	if (mode == MODE_GATEWAY)
-		beaconTime = 0U;
-	m_thread->setBeacon(beaconTime, beaconText, beaconVoice, language);
-	wxLogInfo("Beacon set to %u mins, text set to \"%s\", voice set to %d, language set to %d", beaconTime / 60U, beaconText.c_str(), int(beaconVoice), int(language));
-
-	bool announcementEnabled;
-	unsigned int announcementTime;
-	wxString announcementRecordRPT1, announcementRecordRPT2;
-	wxString announcementDeleteRPT1, announcementDeleteRPT2;
-	m_config->getAnnouncement(announcementEnabled, announcementTime, announcementRecordRPT1, announcementRecordRPT2, announcementDeleteRPT1, announcementDeleteRPT2);
-	if (mode == MODE_GATEWAY)
-		announcementEnabled = false;
-	m_thread->setAnnouncement(announcementEnabled, announcementTime, announcementRecordRPT1, announcementRecordRPT2, announcementDeleteRPT1, announcementDeleteRPT2);
-	wxLogInfo("Announcement enabled: %d, time: %u mins, record RPT1: \"%s\", record RPT2: \"%s\", delete RPT1: \"%s\", delete RPT2: \"%s\"", int(announcementEnabled), announcementTime / 60U, announcementRecordRPT1.c_str(), announcementRecordRPT2.c_str(), announcementDeleteRPT1.c_str(), announcementDeleteRPT2.c_str());
-
-	wxLogInfo("Modem type set to \"%s\"", modemType.c_str());
-
-	CModem* modem = NULL;
-	if (modemType.IsSameAs("DVAP")) {
-		wxString port;
-		unsigned int frequency;
-		int power, squelch;
-		m_config->getDVAP(port, frequency, power, squelch);
-		wxLogInfo("DVAP: port: %s, frequency: %u Hz, power: %d dBm, squelch: %d dBm", port.c_str(), frequency, power, squelch);
-		modem = new CDVAPController(port, frequency, power, squelch);
-	} else if (modemType.IsSameAs("DV-RPTR V1")) {
-		wxString port;
-		bool rxInvert, txInvert, channel;
-		unsigned int modLevel, txDelay;
-		m_config->getDVRPTR1(port, rxInvert, txInvert, channel, modLevel, txDelay);
-		wxLogInfo("DV-RPTR V1, port: %s, RX invert: %d, TX invert: %d, channel: %s, mod level: %u%%, TX delay: %u ms", port.c_str(), int(rxInvert), int(txInvert), channel ? "B" : "A", modLevel, txDelay);
-		modem = new CDVRPTRV1Controller(port, wxEmptyString, rxInvert, txInvert, channel, modLevel, txDelay);
-	} else if (modemType.IsSameAs("DV-RPTR V2")) {
-		CONNECTION_TYPE connType;
-		wxString usbPort, address;
-		bool txInvert;
-		unsigned int port, modLevel, txDelay;
-		m_config->getDVRPTR2(connType, usbPort, address, port, txInvert, modLevel, txDelay);
-		wxLogInfo("DV-RPTR V2, type: %d, address: %s:%u, TX invert: %d, mod level: %u%%, TX delay: %u ms", int(connType), address.c_str(), port, int(txInvert), modLevel, txDelay);
-		switch (connType) {
-			case CT_USB:
-				modem = new CDVRPTRV2Controller(usbPort, wxEmptyString, txInvert, modLevel, mode == MODE_DUPLEX || mode == MODE_TXANDRX, callsign, txDelay);
-				break;
-			case CT_NETWORK:
-				modem = new CDVRPTRV2Controller(address, port, txInvert, modLevel, mode == MODE_DUPLEX || mode == MODE_TXANDRX, callsign, txDelay);
-				break;
-		}
-	} else if (modemType.IsSameAs("DV-RPTR V3")) {
-		CONNECTION_TYPE connType;
-		wxString usbPort, address;
-		bool txInvert;
-		unsigned int port, modLevel, txDelay;
-		m_config->getDVRPTR3(connType, usbPort, address, port, txInvert, modLevel, txDelay);
-		wxLogInfo("DV-RPTR V3, type: %d, address: %s:%u, TX invert: %d, mod level: %u%%, TX delay: %u ms", int(connType), address.c_str(), port, int(txInvert), modLevel, txDelay);
-		switch (connType) {
-			case CT_USB:
-				modem = new CDVRPTRV3Controller(usbPort, wxEmptyString, txInvert, modLevel, mode == MODE_DUPLEX || mode == MODE_TXANDRX, callsign, txDelay);
-				break;
-			case CT_NETWORK:
-				modem = new CDVRPTRV3Controller(address, port, txInvert, modLevel, mode == MODE_DUPLEX || mode == MODE_TXANDRX, callsign, txDelay);
-				break;
-		}
-	} else if (modemType.IsSameAs("DVMEGA")) {
-		wxString port;
-		DVMEGA_VARIANT variant;
-		bool rxInvert, txInvert;
-		unsigned int txDelay, rxFrequency, txFrequency, power;
-		m_config->getDVMEGA(port, variant, rxInvert, txInvert, txDelay, rxFrequency, txFrequency, power);
-		wxLogInfo("DVMEGA, port: %s, variant: %d, RX invert: %d, TX invert: %d, TX delay: %u ms, rx frequency: %u Hz, tx frequency: %u Hz, power: %u %%", port.c_str(), int(variant), int(rxInvert), int(txInvert), txDelay, rxFrequency, txFrequency, power);
-		switch (variant) {
-			case DVMV_MODEM:
-				modem = new CDVMegaController(port, wxEmptyString, rxInvert, txInvert, txDelay);
-				break;
-			case DVMV_RADIO_2M:
-			case DVMV_RADIO_70CM:
-			case DVMV_RADIO_2M_70CM:
-				modem = new CDVMegaController(port, wxEmptyString, txDelay, rxFrequency, txFrequency, power);
-				break;
-			default:
-				wxLogError("Unknown DVMEGA variant - %d", int(variant));
-				break;
-		}
-	} else if (modemType.IsSameAs("GMSK Modem")) {
-		USB_INTERFACE iface;
-		unsigned int address;
-		m_config->getGMSK(iface, address);
-		wxLogInfo("GMSK, interface: %d, address: %04X", int(iface), address);
-		modem = new CGMSKController(iface, address, mode == MODE_DUPLEX || mode == MODE_TXANDRX);
-	} else if (modemType.IsSameAs("Sound Card")) {
-		wxString rxDevice, txDevice;
-		bool rxInvert, txInvert;
-		wxFloat32 rxLevel, txLevel;
-		unsigned int txDelay, txTail;
-		m_config->getSoundCard(rxDevice, txDevice, rxInvert, txInvert, rxLevel, txLevel, txDelay, txTail);
-		wxLogInfo("Sound Card, devices: %s:%s, invert: %d:%d, levels: %.2f:%.2f, tx delay: %u ms, tx tail: %u ms", rxDevice.c_str(), txDevice.c_str(), int(rxInvert), int(txInvert), rxLevel, txLevel, txDelay, txTail);
-		modem = new CSoundCardController(rxDevice, txDevice, rxInvert, txInvert, rxLevel, txLevel, txDelay, txTail);
-	} else if (modemType.IsSameAs("MMDVM")) {
-		wxString port;
-		bool rxInvert, txInvert, pttInvert;
-		unsigned int txDelay, rxLevel, txLevel;
-		m_config->getMMDVM(port, rxInvert, txInvert, pttInvert, txDelay, rxLevel, txLevel);
-		wxLogInfo("MMDVM, port: %s, RX invert: %d, TX invert: %d, PTT invert: %d, TX delay: %u ms, RX level: %u%%, TX level: %u%%", port.c_str(), int(rxInvert), int(txInvert), int(pttInvert), txDelay, rxLevel, txLevel);
-		modem = new CMMDVMController(port, wxEmptyString, rxInvert, txInvert, pttInvert, txDelay, rxLevel, txLevel);
-	} else if (modemType.IsSameAs("Split")) {
-		wxString localAddress;
-		unsigned int localPort;
-		wxArrayString transmitterNames, receiverNames;
-		unsigned int timeout;
-		m_config->getSplit(localAddress, localPort, transmitterNames, receiverNames, timeout);
-		wxLogInfo("Split, local: %s:%u, timeout: %u ms", localAddress.c_str(), localPort, timeout);
-		for (unsigned int i = 0U; i < transmitterNames.GetCount(); i++) {
-			wxString name = transmitterNames.Item(i);
-			if (!name.IsEmpty()) {
-				wxLogInfo("\tTX %u name: %s", i + 1U, name.c_str());
-			}
-		}
-		for (unsigned int i = 0U; i < receiverNames.GetCount(); i++) {
-			wxString name = receiverNames.Item(i);
-			if (!name.IsEmpty()) {
-				wxLogInfo("\tRX %u name: %s", i + 1U, name.c_str());
-			}
-		}
-		modem = new CSplitController(localAddress, localPort, transmitterNames, receiverNames, timeout);
-	} else if (modemType.IsSameAs("Icom Access Point/Terminal Mode")) {
-		wxString port;
-		m_config->getIcom(port);
-		wxLogInfo("Icom, port: %s", port.c_str());
-		modem = new CIcomController(port);
-	} else {
-		wxLogError("Unknown modem type: %s", modemType.c_str());
-	}
-
-	if (modem != NULL) {
-		bool res = modem->start();
-		if (!res)
-			wxLogError("Cannot open the D-Star modem");
-		else
-			m_thread->setModem(modem);
-	}
-
-	wxString controllerType;
-	unsigned int portConfig, activeHangTime;
-	bool pttInvert;
-	m_config->getController(controllerType, portConfig, pttInvert, activeHangTime);
-	wxLogInfo("Controller set to %s, config: %u, PTT invert: %d, active hang time: %u ms", controllerType.c_str(), portConfig, int(pttInvert), activeHangTime);
-
-	CExternalController* controller = NULL;
-
-	wxString port;
-	if (controllerType.StartsWith("Velleman K8055 - ", &port)) {
-		unsigned long num;
-		port.ToULong(&num);
-		controller = new CExternalController(new CK8055Controller(num), pttInvert);
-	} else if (controllerType.StartsWith("URI USB - ", &port)) {
-                unsigned long num;
-                port.ToULong(&num);
-                controller = new CExternalController(new CURIUSBController(num, true), pttInvert);
-	} else if (controllerType.StartsWith("Serial - ", &port)) {
-		controller = new CExternalController(new CSerialLineController(port, portConfig), pttInvert);
-	} else if (controllerType.StartsWith("Arduino - ", &port)) {
-		controller = new CExternalController(new CArduinoController(port), pttInvert);
-#if defined(GPIO)
-	} else if (controllerType.IsSameAs("GPIO")) {
-		controller = new CExternalController(new CGPIOController(portConfig), pttInvert);
-	} else if (controllerType.IsSameAs(wxT("UDRC"))) {
-		switch(portConfig) {
-			case 1:
-				controller = new CUDRCController(AUTO_FM);
-				break;
-			case 3:
-				controller = new CUDRCController(DIGITAL_DIGITAL);
-				break;
-			case 4:
-				controller = new CUDRCController(FM_FM);
-				break;
-			case 5:
-				controller = new CUDRCController(HOTSPOT);
-				break;
-			default:
-			case 2:
-				controller = new CUDRCController(AUTO_AUTO);
-				break;
-
-			}
-#endif
-	} else {
-		wxLogError("Unrecognized controller %s, using dummy controller", controllerType);
-		controller = new CExternalController(new CDummyController, pttInvert);
-	}
-
-	bool res = controller->open();
-	if (!res)
-		wxLogError("Cannot open the hardware interface - %s", controllerType.c_str());
-	else
-		m_thread->setController(controller, activeHangTime);
-
-	bool out1, out2, out3, out4;
-	m_config->getOutputs(out1, out2, out3, out4);
-	m_thread->setOutputs(out1, out2, out3, out4);
-#if (wxUSE_GUI == 1)
-	m_frame->setOutputs(out1, out2, out3, out4);
-#endif
-	wxLogInfo("Output 1 = %d, output 2 = %d, output 3 = %d, output 4 = %d", int(out1), int(out2), int(out3), int(out4));
-
-	bool enabled;
-	wxString rpt1Callsign, rpt2Callsign;
-	wxString shutdown, startup;
-
-	//  XXX Initialization should be temporary until we get them coming
-	//  from m_config->getControl
-	wxArrayString status;
-	status.Add("", 5);
-	wxArrayString command;
-	command.Add("", 6);
-	wxArrayString output;
-	output.Add("", 4);
-
-	m_config->getControl(enabled, rpt1Callsign, rpt2Callsign, shutdown, startup, status[0], status[1], status[2], status[3], status[4], command[0], m_commandLine[0], command[1], m_commandLine[1], command[2], m_commandLine[2], command[3], m_commandLine[3], command[4], m_commandLine[4], command[5], m_commandLine[5], output[0], output[1], output[2], output[3]);
-
-	m_thread->setControl(enabled, rpt1Callsign, rpt2Callsign, shutdown,
-		startup, command, status, output);
-
-	wxLogInfo(wxT("Control: enabled: %d, RPT1: %s, RPT2: %s, shutdown: %s, startup: %s, status1: %s, status2: %s, status3: %s, status4: %s, status5: %s, command1: %s = %s, command2: %s = %s, command3: %s = %s, command4: %s = %s, command5: %s = %s, command6: %s = %s, output1: %s, output2: %s, output3: %s, output4: %s"), enabled, rpt1Callsign.c_str(), rpt2Callsign.c_str(), shutdown.c_str(), startup.c_str(), status[0].c_str(), status[1].c_str(), status[2].c_str(), status[3].c_str(), status[4].c_str(), command[0].c_str(), m_commandLine[0].c_str(), command[1].c_str(), m_commandLine[1].c_str(), command[2].c_str(), m_commandLine[2].c_str(), command[3].c_str(), m_commandLine[3].c_str(), command[4].c_str(), m_commandLine[4].c_str(), command[5].c_str(), m_commandLine[5].c_str(), output[0].c_str(), output[1].c_str(), output[2].c_str(), output[3].c_str());
-
-	bool logging;
-	m_config->getLogging(logging);
-	m_thread->setLogging(logging, m_audioDir);
-#if (wxUSE_GUI == 1)
-	m_frame->setLogging(logging);
-#endif
-	wxLogInfo("Frame logging set to %d, in %s", int(logging), m_audioDir.c_str());
-
-#if defined(__WINDOWS__)
-	wxFileName wlFilename(wxFileName::GetHomeDir(), PRIMARY_WHITELIST_FILE_NAME);
-#else
-	wxFileName wlFilename(CONF_DIR, PRIMARY_WHITELIST_FILE_NAME);
-#endif
-	bool exists = wlFilename.FileExists();
-
-	if (!exists) {
-#if defined(__WINDOWS__)
-		wlFilename.Assign(wxFileName::GetHomeDir(), SECONDARY_WHITELIST_FILE_NAME);
-#else
-		wlFilename.Assign(CONF_DIR, SECONDARY_WHITELIST_FILE_NAME);
-#endif
-		exists = wlFilename.FileExists();
-	}
-
-	if (exists) {
-		CCallsignList* list = new CCallsignList(wlFilename.GetFullPath());
-		bool res = list->load();
-		if (!res) {
-			wxLogError("Unable to open white list file - %s", wlFilename.GetFullPath().c_str());
-			delete list;
-		} else {
-			wxLogInfo("%u callsigns loaded into the white list", list->getCount());
-			m_thread->setWhiteList(list);
-		}
-	}
-#if defined(__WINDOWS__)
-	wxFileName blFilename(wxFileName::GetHomeDir(), PRIMARY_BLACKLIST_FILE_NAME);
-#else
-	wxFileName blFilename(CONF_DIR, PRIMARY_BLACKLIST_FILE_NAME);
-#endif
-	exists = blFilename.FileExists();
-
-	if (!exists) {
-#if defined(__WINDOWS__)
-		blFilename.Assign(wxFileName::GetHomeDir(), SECONDARY_BLACKLIST_FILE_NAME);
-#else
-		blFilename.Assign(CONF_DIR, SECONDARY_BLACKLIST_FILE_NAME);
-#endif
-		exists = blFilename.FileExists();
-	}
-
-	if (exists) {
-		CCallsignList* list = new CCallsignList(blFilename.GetFullPath());
-		bool res = list->load();
-		if (!res) {
-			wxLogError("Unable to open black list file - %s", blFilename.GetFullPath().c_str());
-			delete list;
-		} else {
-			wxLogInfo("%u callsigns loaded into the black list", list->getCount());
-			m_thread->setBlackList(list);
-		}
-	}
-#if defined(__WINDOWS__)
-	wxFileName glFilename(wxFileName::GetHomeDir(), GREYLIST_FILE_NAME);
-#else
-		wxFileName glFilename(CONF_DIR, GREYLIST_FILE_NAME);
-#endif
-	exists = glFilename.FileExists();
-	if (exists) {
-		CCallsignList* list = new CCallsignList(glFilename.GetFullPath());
-		bool res = list->load();
-		if (!res) {
-			wxLogError("Unable to open grey list file - %s", glFilename.GetFullPath().c_str());
-			delete list;
-		} else {
-			wxLogInfo("%u callsigns loaded into the grey list", list->getCount());
-			m_thread->setGreyList(list);
-		}
-	}
-
-	m_thread->Create();
-	m_thread->SetPriority(wxPRIORITY_MAX);
-	m_thread->Run();
+	m_instances[0U]->getThread()->shutdown();
 }
@@ -20,11 +20,10 @@
 #define	DStarRepeaterApp_H
 
 #include <wx/wx.h>
-#include <wx/snglinst.h>
 
-#include "DStarRepeaterThread.h"
+#include "CallsignListReloader.h"
 #include "DStarRepeaterStatusData.h"
-#include "DStarRepeaterConfig.h"
+#include "DStarRepeaterInstance.h"
 #if (wxUSE_GUI == 1)
 #include "DStarRepeaterFrame.h"
 #endif
@@ -48,9 +47,9 @@ public:
 	virtual void OnAssertFailure(const wxChar* file, int line, const wxChar* func, const wxChar* cond, const wxChar* msg);
 #endif
 
-	virtual CDStarRepeaterStatusData* getStatus() const;
+	virtual bool getStatus(CDStarRepeaterStatusData& status) const;
 
-	virtual void showLog(const wxString& text);
+	virtual void showLog(wxChar letter, time_t timestamp, const wxString& text);
 
 	virtual void setOutputs(bool out1, bool out2, bool out3, bool out4);
 
@@ -66,19 +65,17 @@ private:
 	CDStarRepeaterFrame*        m_frame;
 #endif
 
-	wxString                    m_name;
+	wxArrayString               m_names;
 	bool                        m_nolog;
 	bool                        m_gui;
+	bool                        m_trace;
 	wxString                    m_logDir;
 	wxString                    m_confDir;
 	wxString                    m_audioDir;
-	IDStarRepeaterThread*       m_thread;
-	CDStarRepeaterConfig*       m_config;
-	wxSingleInstanceChecker*    m_checker;
+	CDStarRepeaterInstance**    m_instances;
+	unsigned int                m_count;
+	CCallsignListReloader*      m_reloader;
 	wxLogChain*                 m_logChain;
-	wxString                    m_commandLine[6];
-
-	void createThread();
 
 	void OnRemoteCmd(wxThreadEvent& event);
 
@@ -24,6 +24,12 @@
 const wxString APPLICATION_NAME = wxT("D-Star Repeater");
 const wxString CONFIG_FILE_NAME = wxT("dstarrepeater");
 
+#if (wxUSE_GUI == 1)
+const wxString LOG_BASE_NAME    = wxT("dstarrepeater");
+#else
+const wxString LOG_BASE_NAME    = wxT("dstarrepeaterd");
+#endif
+
 const wxString PRIMARY_WHITELIST_FILE_NAME   = wxT("rptr_whitelist.dat");
 const wxString SECONDARY_WHITELIST_FILE_NAME = wxT("whitelist.dat");
 const wxString PRIMARY_BLACKLIST_FILE_NAME   = wxT("rptr_blacklist.dat");
@@ -456,11 +456,11 @@ void CDStarRepeaterFrame::onTimer(wxTimerEvent&)
 	if (!m_updates)
 		return;
 
-	CDStarRepeaterStatusData* status = ::wxGetApp().getStatus();
-	if (status == NULL)
+	CDStarRepeaterStatusData status;
+	if (!::wxGetApp().getStatus(status))
 		return;
 
-	switch (status->getRxState()) {
+	switch (status.getRxState()) {
 		case DSRXS_LISTENING:
 			m_rxState->SetLabel(_("Listening"));
 			break;
@@ -472,7 +472,7 @@ void CDStarRepeaterFrame::onTimer(wxTimerEvent&)
 			break;
 	}
 
-	switch (status->getRptState()) {
+	switch (status.getRptState()) {
 		case DSRS_SHUTDOWN:
 			m_rptState->SetLabel(_("Shutdown"));
 			break;
@@ -498,46 +498,46 @@ void CDStarRepeaterFrame::onTimer(wxTimerEvent&)
 			break;
 	}
 
-	m_your->SetLabel(status->getYourCall());
+	m_your->SetLabel(status.getYourCall());
 
-	wxString myCall  = status->getMyCall1();
-	wxString myCall2 = status->getMyCall2();
+	wxString myCall  = status.getMyCall1();
+	wxString myCall2 = status.getMyCall2();
 	if (!myCall2.IsEmpty() && !myCall2.IsSameAs(wxT("    "))) {
 		myCall.Append(wxT("/"));
 		myCall.Append(myCall2);
 	}
 	m_my->SetLabel(myCall);
 
-	m_rpt1->SetLabel(status->getRptCall1());
+	m_rpt1->SetLabel(status.getRptCall1());
 
-	m_rpt2->SetLabel(status->getRptCall2());
+	m_rpt2->SetLabel(status.getRptCall2());
 
 	wxString text;
 
-	text.Printf(wxT("%02X %02X %02X"), status->getFlag1(), status->getFlag2(), status->getFlag3());
+	text.Printf(wxT("%02X %02X %02X"), status.getFlag1(), status.getFlag2(), status.getFlag3());
 	m_flags->SetLabel(text);
 
-	text.Printf(wxT("%.1f%%"), status->getPercent());
+	text.Printf(wxT("%.1f%%"), status.getPercent());
 	m_percent->SetLabel(text);
 
-	bool tx = status->getTX();
+	bool tx = status.getTX();
 	m_tx->SetLabel(tx ? _("On") : _("Off"));
 
-	text.Printf(wxT("%u/%u"), status->getTimeoutTimer(), status->getTimeoutExpiry());
+	text.Printf(wxT("%u/%u"), status.getTimeoutTimer(), status.getTimeoutExpiry());
 	m_timeout->SetLabel(text);
 
-	text.Printf(wxT("%u/%u"), status->getBeaconTimer(), status->getBeaconExpiry());
+	text.Printf(wxT("%u/%u"), status.getBeaconTimer(), status.getBeaconExpiry());
 	m_beacon->SetLabel(text);
 
-	text.Printf(wxT("%u/%u"), status->getAnnounceTimer(), status->getAnnounceExpiry());
+	text.Printf(wxT("%u/%u"), status.getAnnounceTimer(), status.getAnnounceExpiry());
 	m_announce->SetLabel(text);
 
-	m_text->SetLabel(status->getText());
-	m_status1->SetLabel(status->getStatus1());
-	m_status2->SetLabel(status->getStatus2());
-	m_status3->SetLabel(status->getStatus3());
-	m_status4->SetLabel(status->getStatus4());
-	m_status5->SetLabel(status->getStatus5());
+	m_text->SetLabel(status.getText());
+	m_status1->SetLabel(status.getStatus1());
+	m_status2->SetLabel(status.getStatus2());
+	m_status3->SetLabel(status.getStatus3());
+	m_status4->SetLabel(status.getStatus4());
+	m_status5->SetLabel(status.getStatus5());
 
 	// DVAP
 	if (m_squelch != NULL) {
@@ -545,15 +545,13 @@ void CDStarRepeaterFrame::onTimer(wxTimerEvent&)
 			m_squelch->SetLabel(wxEmptyString);
 			m_signal->SetLabel(wxEmptyString);
 		} else {
-			bool squelch = status->getSquelch();
+			bool squelch = status.getSquelch();
 			m_squelch->SetLabel(squelch ? _("Open") : _("Closed"));
 
-			text.Printf(wxT("%d dBm"), status->getSignal());
+			text.Printf(wxT("%d dBm"), status.getSignal());
 			m_signal->SetLabel(text);
 		}
 	}
-
-	delete status;
 }
 
 void CDStarRepeaterFrame::onLog(wxEvent& event)
@@ -567,12 +565,12 @@ void CDStarRepeaterFrame::onLog(wxEvent& event)
 	m_logLine3->SetLabel(text);
 }
 
-void CDStarRepeaterFrame::showLog(const wxString& text)
+void CDStarRepeaterFrame::showLog(wxChar letter, time_t timestamp, const wxString& text)
 {
 	if (!m_updates)
 		return;
 
-	CLogEvent event(text, LOG_EVENT);
+	CLogEvent event(letter, timestamp, text, LOG_EVENT);
 
 	AddPendingEvent(event);
 }
@@ -42,7 +42,7 @@ public:
 
 	virtual void onTimer(wxTimerEvent& event);
 
-	virtual void showLog(const wxString& text);
+	virtual void showLog(wxChar letter, time_t timestamp, const wxString& text);
 
 	virtual void setOutputs(bool out1, bool out2, bool out3, bool out4);
 
@@ -0,0 +1,65 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	DStarRepeaterInstance_H
+#define	DStarRepeaterInstance_H
+
+#include "CallsignListReloader.h"
+#include "DStarRepeaterConfig.h"
+#include "DStarRepeaterThread.h"
+#include "DStarRepeaterDefs.h"
+
+#include <wx/wx.h>
+#include <wx/snglinst.h>
+
+// One repeater, with its own configuration section, thread, queues and statistics. Several of them
+// may share the process, along with its log, its list reloader and its beacon voices.
+class CDStarRepeaterInstance {
+public:
+	CDStarRepeaterInstance(const wxString& name, const wxString& confDir, const wxString& logDir, const wxString& audioDir, bool trace);
+	~CDStarRepeaterInstance();
+
+	// Returns false if the configuration cannot be read, or the repeater is already running
+	bool open();
+
+	// Hosted is true when the repeater shares the process with others
+	void start(CCallsignListReloader* reloader, bool hosted);
+
+	// Stops the repeater thread and waits for it to finish before deleting it
+	void kill();
+
+	wxString              getName() const;
+	CDStarRepeaterConfig* getConfig() const;
+	IDStarRepeaterThread* getThread() const;
+	wxString              getCommandLine(unsigned int n) const;
+
+	void setLogging(bool logging);
+
+private:
+	wxString                 m_name;
+	wxString                 m_confDir;
+	wxString                 m_logDir;
+	wxString                 m_audioDir;
+	bool                     m_trace;
+	CDStarRepeaterConfig*    m_config;
+	IDStarRepeaterThread*    m_thread;
+	wxSingleInstanceChecker* m_checker;
+	wxString                 m_commandLine[6];
+};
+
+#endif
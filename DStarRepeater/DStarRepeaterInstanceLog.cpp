@@ -0,0 +1,36 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "DStarRepeaterInstanceLog.h"
+
+CDStarRepeaterInstanceLog::CDStarRepeaterInstanceLog(const wxString& name, wxLog* target) :
+wxLog(),
+m_name(name),
+m_target(target)
+{
+	wxASSERT(target != NULL);
+}
+
+CDStarRepeaterInstanceLog::~CDStarRepeaterInstanceLog()
+{
+}
+
+void CDStarRepeaterInstanceLog::DoLogRecord(wxLogLevel level, const wxString& msg, const wxLogRecordInfo& info)
+{
+	m_target->LogRecord(level, m_name + wxT(": ") + msg, info);
+}
@@ -0,0 +1,39 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	DStarRepeaterInstanceLog_H
+#define	DStarRepeaterInstanceLog_H
+
+#include <wx/wx.h>
+#include <wx/log.h>
+
+// Puts the name of a repeater in front of the messages from its thread, when more than one repeater
+// shares the process, and passes them on to the log of the process
+class CDStarRepeaterInstanceLog : public wxLog {
+public:
+	CDStarRepeaterInstanceLog(const wxString& name, wxLog* target);
+	virtual ~CDStarRepeaterInstanceLog();
+
+	virtual void DoLogRecord(wxLogLevel level, const wxString& msg, const wxLogRecordInfo& info);
+
+private:
+	wxString m_name;
+	wxLog*   m_target;
+};
+
+#endif
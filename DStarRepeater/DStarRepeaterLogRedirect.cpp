@@ -30,26 +30,22 @@ CDStarRepeaterLogRedirect::~CDStarRepeaterLogRedirect()
 
 void CDStarRepeaterLogRedirect::DoLogRecord(wxLogLevel level, const wxString& msg, const wxLogRecordInfo& info)
 {
-	wxString letter;
+	wxChar letter;
 
 	switch (level) {
-		case wxLOG_FatalError: letter = wxT("F"); break;
-		case wxLOG_Error:      letter = wxT("E"); break;
-		case wxLOG_Warning:    letter = wxT("W"); break;
-		case wxLOG_Info:       letter = wxT("I"); break;
-		case wxLOG_Message:    letter = wxT("M"); break;
-		case wxLOG_Status:     letter = wxT("M"); break;
-		case wxLOG_Trace:      letter = wxT("T"); break;
-		case wxLOG_Debug:      letter = wxT("D"); break;
-		default:               letter = wxT("U"); break;
+		case wxLOG_FatalError: letter = wxT('F'); break;
+		case wxLOG_Error:      letter = wxT('E'); break;
+		case wxLOG_Warning:    letter = wxT('W'); break;
+		case wxLOG_Info:       letter = wxT('I'); break;
+		case wxLOG_Message:    letter = wxT('M'); break;
+		case wxLOG_Status:     letter = wxT('M'); break;
+		case wxLOG_Trace:      letter = wxT('T'); break;
+		case wxLOG_Debug:      letter = wxT('D'); break;
+		default:               letter = wxT('U'); break;
 	}
 
-	struct tm* tm = ::gmtime(&info.timestamp);
-
-	wxString message;
-	message.Printf(wxT("%s: %04d-%02d-%02d %02d:%02d:%02d: %s\n"), letter.c_str(), tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, msg.c_str());
-
-	::wxGetApp().showLog(message);
+	// Any thread may get here, the text is formatted by the window on the main thread
+	::wxGetApp().showLog(letter, info.timestamp, msg);
 
 	if (level == wxLOG_FatalError)
 		::abort();
@@ -31,15 +31,18 @@ const unsigned int MAX_DATA_SYNC_BIT_ERRS  = 2U;
 
 const unsigned int NETWORK_QUEUE_COUNT = 2U;
 
-const unsigned int CYCLE_TIME = 9U;
+// The longest sleep when no timer is due before then
+const unsigned int MAX_WAIT_TIME = 1000U;
 
 CDStarRepeaterRXThread::CDStarRepeaterRXThread(const wxString& type) :
 m_type(type),
 m_modem(NULL),
 m_protocolHandler(NULL),
-m_rxHeader(NULL),
+m_rxHeader(),
 m_radioSeqNo(0U),
-m_registerTimer(1000U),
+m_wheel(),
+m_registerTimer(m_wheel),
+m_berTimer(m_wheel, 1U),			// 1s
 m_rptState(DSRS_LISTENING),
 m_rxState(DSRXS_LISTENING),
 m_slowDataDecoder(),
@@ -50,18 +53,23 @@ m_ambeSilence(0U),
 m_ambeBits(1U),
 m_ambeErrors(0U),
 m_lastAMBEBits(0U),
-m_lastAMBEErrors(0U)
+m_lastAMBEErrors(0U),
+m_ber(0.0F),
+m_poller(),
+m_statusData(),
+m_statusLock()
 {
 	setRadioState(DSRXS_LISTENING);
 }
 
 CDStarRepeaterRXThread::~CDStarRepeaterRXThread()
 {
-	delete  m_rxHeader;
 }
 
 void *CDStarRepeaterRXThread::Entry()
 {
+	startLog();
+
 	// Wait here until we have the essentials to run
 	while (!m_killed && (m_modem == NULL  || m_protocolHandler == NULL))
 		::wxMilliSleep(500UL);		// 1/2 sec
@@ -70,20 +78,26 @@ void *CDStarRepeaterRXThread::Entry()
 		return NULL;
 
 	m_registerTimer.start(10U);
+	m_berTimer.start();
 
 	wxString hardware = m_type;
 	int n = hardware.Find(wxT(' '));
 	if (n != wxNOT_FOUND)
 		hardware = m_type.Left(n);
 
+	// Wake as soon as the modem has data or a packet arrives, or the next timer is due
+	bool ret = m_poller.open();
+	if (ret) {
+		m_modem->setPoller(&m_poller);
+		m_poller.addReader(m_protocolHandler->getFD());
+	}
+
 	wxLogMessage(wxT("Starting the D-Star receiver thread"));
 
-	wxStopWatch stopWatch;
+	wxUint64 lastTime = CUtils::getTimestamp();
 
 	try {
 		while (!m_killed) {
-			stopWatch.Start();
-
 			receiveModem();
 
 			receiveNetwork();
@@ -94,12 +108,19 @@ void *CDStarRepeaterRXThread::Entry()
 				m_registerTimer.start(30U);
 			}
 
-			unsigned long ms = stopWatch.Time();
-			if (ms < CYCLE_TIME) {
-				::wxMilliSleep(CYCLE_TIME - ms);
-				clock(CYCLE_TIME);
-			} else {
+			publishStatus();
+
+			unsigned int timeout = m_wheel.getNext(MAX_WAIT_TIME);
+			if (ret)
+				m_poller.wait(timeout);
+			else
+				::wxMilliSleep(timeout);
+
+			// Only whole milliseconds are clocked, the remainder is carried over to the next pass
+			unsigned int ms = (unsigned int)((CUtils::getTimestamp() - lastTime) / 1000U);
+			if (ms > 0U) {
 				clock(ms);
+				lastTime += ms * 1000U;
 			}
 		}
 	}
@@ -113,8 +134,11 @@ void *CDStarRepeaterRXThread::Entry()
 
 	wxLogMessage(wxT("Stopping the D-Star receiver thread"));
 
+	m_modem->setPoller(NULL);
 	m_modem->stop();
 
+	m_poller.close();
+
 	m_protocolHandler->close();
 	delete m_protocolHandler;
 
@@ -124,6 +148,8 @@ void *CDStarRepeaterRXThread::Entry()
 void CDStarRepeaterRXThread::kill()
 {
 	m_killed = true;
+
+	m_poller.signal();
 }
 
 void CDStarRepeaterRXThread::setCallsign(const wxString&, const wxString&, DSTAR_MODE, ACK_TYPE, bool, bool, bool, bool)
@@ -148,6 +174,10 @@ void CDStarRepeaterRXThread::setTimes(unsigned int, unsigned int)
 {
 }
 
+void CDStarRepeaterRXThread::setConcealment(unsigned int)
+{
+}
+
 void CDStarRepeaterRXThread::setBeacon(unsigned int, const wxString&, bool, TEXT_LANG)
 {
 }
@@ -180,6 +210,11 @@ void CDStarRepeaterRXThread::setGreyList(CCallsignList*)
 {
 }
 
+void CDStarRepeaterRXThread::setTrace(CEventTrace* trace)
+{
+	delete trace;
+}
+
 void CDStarRepeaterRXThread::receiveModem()
 {
 	for (;;) {
@@ -190,8 +225,9 @@ void CDStarRepeaterRXThread::receiveModem()
 		switch (m_rxState) {
 			case DSRXS_LISTENING:
 				if (type == DSMTT_HEADER) {
-					CHeaderData* header = m_modem->readHeader();
-					receiveHeader(header);
+					CHeaderData header;
+					if (m_modem->readHeader(header))
+						receiveHeader(header);
 				} else if (type == DSMTT_DATA) {
 					unsigned char data[20U];
 					unsigned int length = m_modem->readData(data, 20U);
@@ -227,11 +263,9 @@ void CDStarRepeaterRXThread::receiveModem()
 	}
 }
 
-void CDStarRepeaterRXThread::receiveHeader(CHeaderData* header)
+void CDStarRepeaterRXThread::receiveHeader(const CHeaderData& header)
 {
-	wxASSERT(header != NULL);
-
-	wxLogMessage(wxT("Radio header decoded - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str(), header->getFlag1(), header->getFlag2(), header->getFlag3());
+	wxLogMessage(wxT("Radio header decoded - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header.getMyCall1().c_str(), header.getMyCall2().c_str(), header.getYourCall().c_str(), header.getRptCall1().c_str(), header.getRptCall2().c_str(), header.getFlag1(), header.getFlag2(), header.getFlag3());
 
 	bool res = processRadioHeader(header);
 	if (res) {
@@ -264,21 +298,19 @@ void CDStarRepeaterRXThread::receiveSlowData(unsigned char* data, unsigned int)
 		m_radioSeqNo++;
 		m_slowDataDecoder.addData(data + VOICE_FRAME_LENGTH_BYTES);
 
-		CHeaderData* header = m_slowDataDecoder.getHeaderData();
-		if (header == NULL)
+		CHeaderData header;
+		if (!m_slowDataDecoder.getHeaderData(header))
 			return;
 
-		wxLogMessage(wxT("Radio header from slow data - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X  BER: 0%%"), header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str(), header->getFlag1(), header->getFlag2(), header->getFlag3());
+		wxLogMessage(wxT("Radio header from slow data - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X  BER: 0%%"), header.getMyCall1().c_str(), header.getMyCall2().c_str(), header.getYourCall().c_str(), header.getRptCall1().c_str(), header.getRptCall2().c_str(), header.getFlag1(), header.getFlag2(), header.getFlag3());
 
-		if (header != NULL) {
-			bool res = processRadioHeader(header);
-			if (res) {
-				// A valid header and is a DV packet, go to normal data relaying
-				setRadioState(DSRXS_PROCESS_DATA);
-			} else {
-				// This is a DD packet or some other problem
-				// wxLogMessage(wxT("Invalid header"));
-			}
+		bool res = processRadioHeader(header);
+		if (res) {
+			// A valid header and is a DV packet, go to normal data relaying
+			setRadioState(DSRXS_PROCESS_DATA);
+		} else {
+			// This is a DD packet or some other problem
+			// wxLogMessage(wxT("Invalid header"));
 		}
 	}
 }
@@ -329,6 +361,7 @@ void CDStarRepeaterRXThread::setRadioState(DSTAR_RX_STATE state)
 			m_ambeErrors     = 0U;
 			m_lastAMBEBits   = 0U;
 			m_lastAMBEErrors = 0U;
+			m_ber            = 0.0F;
 			m_rxState        = DSRXS_PROCESS_DATA;
 			break;
 
@@ -340,26 +373,26 @@ void CDStarRepeaterRXThread::setRadioState(DSTAR_RX_STATE state)
 	}
 }
 
-bool CDStarRepeaterRXThread::processRadioHeader(CHeaderData* header)
+bool CDStarRepeaterRXThread::processRadioHeader(const CHeaderData& header)
 {
-	wxASSERT(header != NULL);
-
 	// We don't handle DD data packets
-	if (header->isDataPacket()) {
+	if (header.isDataPacket()) {
 		wxLogMessage(wxT("Received a DD packet, ignoring"));
-		delete header;
 		return false;
 	}
 
 	m_rptState = DSRS_VALID;
 
 	// Send the valid header to the gateway if we are accepted
-	delete m_rxHeader;
 	m_rxHeader = header;
 
-	CHeaderData netHeader(*m_rxHeader);
-	netHeader.setRptCall1(m_rxHeader->getRptCall2());
-	netHeader.setRptCall2(m_rxHeader->getRptCall1());
+	unsigned char rptCall1[LONG_CALLSIGN_LENGTH], rptCall2[LONG_CALLSIGN_LENGTH];
+	m_rxHeader.getRptCall1(rptCall1);
+	m_rxHeader.getRptCall2(rptCall2);
+
+	CHeaderData netHeader(m_rxHeader);
+	netHeader.setRptCall1(rptCall2);
+	netHeader.setRptCall2(rptCall1);
 
 	m_protocolHandler->writeHeader(netHeader);
 
@@ -378,7 +411,7 @@ void CDStarRepeaterRXThread::processRadioFrame(unsigned char* data, FRAME_TYPE t
 	unsigned int errors = 0U;
 	if (type != FRAME_END) {
 		// Data packets have no AMBE FEC
-		if (!m_rxHeader->isDataPacket())
+		if (!m_rxHeader.isDataPacket())
 			errors = m_ambe.count(data);
 
 		m_ambeErrors += errors;
@@ -402,48 +435,57 @@ void CDStarRepeaterRXThread::processRadioFrame(unsigned char* data, FRAME_TYPE t
 
 void CDStarRepeaterRXThread::endOfRadioData()
 {
-	wxLogMessage(wxT("AMBE for %s  Frames: %.1fs, Silence: %.1f%%, BER: %.1f%%"), m_rxHeader->getMyCall1().c_str(), float(m_ambeFrames) / 50.0F, float(m_ambeSilence * 100U) / float(m_ambeFrames), float(m_ambeErrors * 100U) / float(m_ambeBits));
+	wxLogMessage(wxT("AMBE for %s  Frames: %.1fs, Silence: %.1f%%, BER: %.1f%%"), m_rxHeader.getMyCall1().c_str(), float(m_ambeFrames) / 50.0F, float(m_ambeSilence * 100U) / float(m_ambeFrames), float(m_ambeErrors * 100U) / float(m_ambeBits));
 
 	m_rptState = DSRS_LISTENING;
 
 	m_protocolHandler->reset();
 }
 
-CDStarRepeaterStatusData* CDStarRepeaterRXThread::getStatus()
+bool CDStarRepeaterRXThread::getStatus(CDStarRepeaterStatusData& status) const
 {
-	float   bits = float(m_ambeBits - m_lastAMBEBits);
-	float errors = float(m_ambeErrors - m_lastAMBEErrors);
-	if (bits == 0.0F)
-		bits = 1.0F;
+	return m_statusLock.read(status);
+}
 
-	m_lastAMBEBits   = m_ambeBits;
-	m_lastAMBEErrors = m_ambeErrors;
+void CDStarRepeaterRXThread::clock(unsigned int ms)
+{
+	m_wheel.clock(ms);
+}
 
-	CDStarRepeaterStatusData* status;
-	if (m_rptState == DSRS_SHUTDOWN || m_rptState == DSRS_LISTENING)
-		status = new CDStarRepeaterStatusData(wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString,
-					wxEmptyString, 0x00, 0x00, 0x00, false, m_rxState, m_rptState, 0U, 0U, 0U, 0U, 0U, 0U, 0.0F,
-					wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString);
-	else
-		status = new CDStarRepeaterStatusData(m_rxHeader->getMyCall1(), m_rxHeader->getMyCall2(),
-					m_rxHeader->getYourCall(), m_rxHeader->getRptCall1(), m_rxHeader->getRptCall2(),
-					m_rxHeader->getFlag1(), m_rxHeader->getFlag2(), m_rxHeader->getFlag3(), false, m_rxState,
-					m_rptState, 0U, 0U, 0U, 0U, 0U, 0U, (errors * 100.0F) / bits, wxEmptyString, wxEmptyString,
-					wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString);
+void CDStarRepeaterRXThread::publishStatus()
+{
+	if (m_berTimer.hasExpired()) {
+		float   bits = float(m_ambeBits - m_lastAMBEBits);
+		float errors = float(m_ambeErrors - m_lastAMBEErrors);
+		if (bits == 0.0F)
+			bits = 1.0F;
+
+		m_ber = (errors * 100.0F) / bits;
+
+		m_lastAMBEBits   = m_ambeBits;
+		m_lastAMBEErrors = m_ambeErrors;
+
+		m_berTimer.start();
+	}
+
+	if (m_rptState == DSRS_SHUTDOWN || m_rptState == DSRS_LISTENING) {
+		m_statusData.clearHeader();
+		m_statusData.setPercent(0.0F);
+	} else {
+		m_statusData.setHeader(m_rxHeader);
+		m_statusData.setPercent(m_ber);
+	}
+
+	m_statusData.setState(false, m_rxState, m_rptState);
 
 	if (m_type.IsSameAs(wxT("DVAP")) && m_modem != NULL) {
 		CDVAPController* dvap = static_cast<CDVAPController*>(m_modem);
 		bool squelch = dvap->getSquelch();
 		int signal   = dvap->getSignal();
-		status->setDVAP(squelch, signal);
+		m_statusData.setDVAP(squelch, signal);
 	}
 
-	return status;
-}
-
-void CDStarRepeaterRXThread::clock(unsigned int ms)
-{
-	m_registerTimer.clock(ms);
+	m_statusLock.write(m_statusData);
 }
 
 void CDStarRepeaterRXThread::shutdown()
@@ -19,10 +19,13 @@
 #ifndef	DStarRepeaterRXThread_H
 #define	DStarRepeaterRXThread_H
 
+#include "DStarRepeaterStatusData.h"
 #include "DStarRepeaterThread.h"
 #include "SlowDataDecoder.h"
 #include "HeaderData.h"
 #include "AMBEFEC.h"
+#include "EventPoller.h"
+#include "SeqLock.h"
 #include "Timer.h"
 
 #include <wx/wx.h>
@@ -37,6 +40,7 @@ public:
 	virtual void setModem(CModem* modem);
 	virtual void setController(CExternalController* controller, unsigned int activeHangTime);
 	virtual void setTimes(unsigned int timeout, unsigned int ackTime);
+	virtual void setConcealment(unsigned int frames);
 	virtual void setBeacon(unsigned int time, const wxString& text, bool voice, TEXT_LANG language);
 	virtual void setAnnouncement(bool enabled, unsigned int time, const wxString& recordRPT1, const wxString& recordRPT2, const wxString& deleteRPT1, const wxString& deleteRPT2);
 
@@ -45,6 +49,7 @@ public:
 	virtual void setWhiteList(CCallsignList* list);
 	virtual void setBlackList(CCallsignList* list);
 	virtual void setGreyList(CCallsignList* list);
+	virtual void setTrace(CEventTrace* trace);
 
 	virtual void shutdown();
 	virtual void startup();
@@ -56,7 +61,7 @@ public:
 	virtual void command5();
 	virtual void command6();
 
-	virtual CDStarRepeaterStatusData* getStatus();
+	virtual bool getStatus(CDStarRepeaterStatusData& status) const;
 
 	virtual void kill();
 
@@ -66,9 +71,11 @@ private:
 	wxString                   m_type;
 	CModem*                    m_modem;
 	CRepeaterProtocolHandler*  m_protocolHandler;
-	CHeaderData*               m_rxHeader;
+	CHeaderData                m_rxHeader;
 	unsigned char              m_radioSeqNo;
+	CTimerWheel                m_wheel;
 	CTimer                     m_registerTimer;
+	CTimer                     m_berTimer;
 	DSTAR_RPT_STATE            m_rptState;
 	DSTAR_RX_STATE             m_rxState;
 	CSlowDataDecoder           m_slowDataDecoder;
@@ -80,19 +87,24 @@ private:
 	unsigned int               m_ambeErrors;
 	unsigned int               m_lastAMBEBits;
 	unsigned int               m_lastAMBEErrors;
+	float                      m_ber;
 
-	void receiveHeader(CHeaderData* header);
+	CEventPoller               m_poller;
+	CDStarRepeaterStatusData   m_statusData;
+	CSeqLock<CDStarRepeaterStatusData> m_statusLock;
+	void receiveHeader(const CHeaderData& header);
 	void receiveRadioData(unsigned char* data, unsigned int length);
 	void receiveSlowData(unsigned char* data, unsigned int length);
 
 	void receiveModem();
 	void receiveNetwork();
-	bool processRadioHeader(CHeaderData* header);
+	bool processRadioHeader(const CHeaderData& header);
 	void processRadioFrame(unsigned char* data, FRAME_TYPE type);
 	void endOfRadioData();
 	void setRadioState(DSTAR_RX_STATE state);
 	unsigned int countBits(unsigned char byte);
 	void clock(unsigned int ms);
+	void publishStatus();
 };
 
 #endif
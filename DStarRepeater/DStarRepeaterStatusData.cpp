@@ -18,48 +18,96 @@
 
 #include "DStarRepeaterStatusData.h"
 
-CDStarRepeaterStatusData::CDStarRepeaterStatusData(const wxString& myCall1, const wxString& myCall2,
-													 const wxString& yourCall, const wxString& rptCall1,
-													 const wxString& rptCall2, unsigned char flag1,
-													 unsigned char flag2, unsigned char flag3, bool tx,
-													 DSTAR_RX_STATE rxState, DSTAR_RPT_STATE rptState,
-													 unsigned int timeoutTimer, unsigned int timeoutExpiry,
-													 unsigned int beaconTimer, unsigned int beaconExpiry,
-													 unsigned int announceTimer, unsigned int announceExpiry,
-													 float percent, const wxString& text, const wxString& status1,
-													 const wxString& status2, const wxString& status3,
-													 const wxString& status4, const wxString& status5) :
-m_myCall1(myCall1),
-m_myCall2(myCall2),
-m_yourCall(yourCall),
-m_rptCall1(rptCall1),
-m_rptCall2(rptCall2),
-m_flag1(flag1),
-m_flag2(flag2),
-m_flag3(flag3),
-m_tx(tx),
-m_rxState(rxState),
-m_rptState(rptState),
-m_timeoutTimer(timeoutTimer),
-m_timeoutExpiry(timeoutExpiry),
-m_beaconTimer(beaconTimer),
-m_beaconExpiry(beaconExpiry),
-m_announceTimer(announceTimer),
-m_announceExpiry(announceExpiry),
-m_percent(percent),
-m_text(text),
-m_status1(status1),
-m_status2(status2),
-m_status3(status3),
-m_status4(status4),
-m_status5(status5),
+CDStarRepeaterStatusData::CDStarRepeaterStatusData() :
+m_flag1(0x00),
+m_flag2(0x00),
+m_flag3(0x00),
+m_tx(false),
+m_rxState(DSRXS_LISTENING),
+m_rptState(DSRS_LISTENING),
+m_timeoutTimer(0U),
+m_timeoutExpiry(0U),
+m_beaconTimer(0U),
+m_beaconExpiry(0U),
+m_announceTimer(0U),
+m_announceExpiry(0U),
+m_percent(0.0F),
 m_squelch(false),
 m_signal(0)
 {
+	clearHeader();
+
+	m_text[0U] = wxT('\0');
+	for (unsigned int i = 0U; i < STATUS_TEXT_COUNT; i++)
+		m_status[i][0U] = wxT('\0');
+}
+
+void CDStarRepeaterStatusData::setHeader(const CHeaderData& header)
+{
+	header.getMyCall1(m_myCall1);
+	header.getMyCall2(m_myCall2);
+	header.getYourCall(m_yourCall);
+	header.getRptCall1(m_rptCall1);
+	header.getRptCall2(m_rptCall2);
+
+	m_flag1 = header.getFlag1();
+	m_flag2 = header.getFlag2();
+	m_flag3 = header.getFlag3();
 }
 
-CDStarRepeaterStatusData::~CDStarRepeaterStatusData()
+void CDStarRepeaterStatusData::clearHeader()
 {
+	::memset(m_myCall1,  0x00, LONG_CALLSIGN_LENGTH);
+	::memset(m_myCall2,  0x00, SHORT_CALLSIGN_LENGTH);
+	::memset(m_yourCall, 0x00, LONG_CALLSIGN_LENGTH);
+	::memset(m_rptCall1, 0x00, LONG_CALLSIGN_LENGTH);
+	::memset(m_rptCall2, 0x00, LONG_CALLSIGN_LENGTH);
+
+	m_flag1 = 0x00;
+	m_flag2 = 0x00;
+	m_flag3 = 0x00;
+}
+
+void CDStarRepeaterStatusData::setState(bool tx, DSTAR_RX_STATE rxState, DSTAR_RPT_STATE rptState)
+{
+	m_tx       = tx;
+	m_rxState  = rxState;
+	m_rptState = rptState;
+}
+
+void CDStarRepeaterStatusData::setTimeout(unsigned int timer, unsigned int expiry)
+{
+	m_timeoutTimer  = timer;
+	m_timeoutExpiry = expiry;
+}
+
+void CDStarRepeaterStatusData::setBeacon(unsigned int timer, unsigned int expiry)
+{
+	m_beaconTimer  = timer;
+	m_beaconExpiry = expiry;
+}
+
+void CDStarRepeaterStatusData::setAnnounce(unsigned int timer, unsigned int expiry)
+{
+	m_announceTimer  = timer;
+	m_announceExpiry = expiry;
+}
+
+void CDStarRepeaterStatusData::setPercent(float percent)
+{
+	m_percent = percent;
+}
+
+void CDStarRepeaterStatusData::setText(const wxString& text)
+{
+	setText(m_text, text);
+}
+
+void CDStarRepeaterStatusData::setStatus(unsigned int n, const wxString& text)
+{
+	wxASSERT(n < STATUS_TEXT_COUNT);
+
+	setText(m_status[n], text);
 }
 
 void CDStarRepeaterStatusData::setDVAP(bool squelch, int signal)
@@ -70,27 +118,27 @@ void CDStarRepeaterStatusData::setDVAP(bool squelch, int signal)
 
 wxString CDStarRepeaterStatusData::getMyCall1() const
 {
-	return m_myCall1;
+	return getCallsign(m_myCall1, LONG_CALLSIGN_LENGTH);
 }
 
 wxString CDStarRepeaterStatusData::getMyCall2() const
 {
-	return m_myCall2;
+	return getCallsign(m_myCall2, SHORT_CALLSIGN_LENGTH);
 }
 
 wxString CDStarRepeaterStatusData::getYourCall() const
 {
-	return m_yourCall;
+	return getCallsign(m_yourCall, LONG_CALLSIGN_LENGTH);
 }
 
 wxString CDStarRepeaterStatusData::getRptCall1() const
 {
-	return m_rptCall1;
+	return getCallsign(m_rptCall1, LONG_CALLSIGN_LENGTH);
 }
 
 wxString CDStarRepeaterStatusData::getRptCall2() const
 {
-	return m_rptCall2;
+	return getCallsign(m_rptCall2, LONG_CALLSIGN_LENGTH);
 }
 
 unsigned char CDStarRepeaterStatusData::getFlag1() const
@@ -170,30 +218,52 @@ float CDStarRepeaterStatusData::getPercent() const
 
 wxString CDStarRepeaterStatusData::getText() const
 {
-	return m_text;
+	return wxString(m_text);
 }
 
 wxString CDStarRepeaterStatusData::getStatus1() const
 {
-	return m_status1;
+	return wxString(m_status[0U]);
 }
 
 wxString CDStarRepeaterStatusData::getStatus2() const
 {
-	return m_status2;
+	return wxString(m_status[1U]);
 }
 
 wxString CDStarRepeaterStatusData::getStatus3() const
 {
-	return m_status3;
+	return wxString(m_status[2U]);
 }
 
 wxString CDStarRepeaterStatusData::getStatus4() const
 {
-	return m_status4;
+	return wxString(m_status[3U]);
 }
 
 wxString CDStarRepeaterStatusData::getStatus5() const
 {
-	return m_status5;
+	return wxString(m_status[4U]);
+}
+
+wxString CDStarRepeaterStatusData::getCallsign(const unsigned char* callsign, unsigned int length) const
+{
+	// An unset header has nulls in it
+	unsigned int len = 0U;
+	while (len < length && callsign[len] != 0x00U)
+		len++;
+
+	return wxString((const char*)callsign, wxConvLocal, len);
+}
+
+void CDStarRepeaterStatusData::setText(wxChar* out, const wxString& text)
+{
+	size_t len = text.Len();
+	if (len > SLOW_DATA_TEXT_LENGTH)
+		len = SLOW_DATA_TEXT_LENGTH;
+
+	for (size_t i = 0U; i < len; i++)
+		out[i] = text.GetChar(i);
+
+	out[len] = wxT('\0');
 }
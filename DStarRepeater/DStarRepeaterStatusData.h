@@ -21,20 +21,31 @@
 
 #include "DStarRepeaterDefs.h"
 #include "DStarDefines.h"
+#include "HeaderData.h"
 
 #include <wx/wx.h>
 
+const unsigned int STATUS_TEXT_COUNT = 5U;
+
+// A snapshot of the repeater for display. It holds no pointers so that it can be published with a
+// CSeqLock and copied by the readers without any allocation.
 class CDStarRepeaterStatusData {
 public:
-	CDStarRepeaterStatusData(const wxString& myCall1, const wxString& myCall2, const wxString& yourCall,
-							  const wxString& rptCall1, const wxString& rptCall2, unsigned char flag1,
-							  unsigned char flag2, unsigned char flag3, bool tx, DSTAR_RX_STATE rxState,
-							  DSTAR_RPT_STATE rptState, unsigned int timeoutTimer, unsigned int timeoutExpiry,
-							  unsigned int beaconTimer, unsigned int beaconExpiry, unsigned int announceTimer,
-							  unsigned int announceExpiry, float percent, const wxString& text,
-							  const wxString& status1, const wxString& status2, const wxString& status3,
-							  const wxString& status4, const wxString& status5);
-	~CDStarRepeaterStatusData();
+	CDStarRepeaterStatusData();
+
+	void setHeader(const CHeaderData& header);
+	void clearHeader();
+
+	void setState(bool tx, DSTAR_RX_STATE rxState, DSTAR_RPT_STATE rptState);
+
+	void setTimeout(unsigned int timer, unsigned int expiry);
+	void setBeacon(unsigned int timer, unsigned int expiry);
+	void setAnnounce(unsigned int timer, unsigned int expiry);
+
+	void setPercent(float percent);
+
+	void setText(const wxString& text);
+	void setStatus(unsigned int n, const wxString& text);
 
 	void setDVAP(bool squelch, int signal);
 
@@ -73,11 +84,11 @@ public:
 	wxString      getStatus5() const;
 
 private:
-	wxString        m_myCall1;
-	wxString        m_myCall2;
-	wxString        m_yourCall;
-	wxString        m_rptCall1;
-	wxString        m_rptCall2;
+	unsigned char   m_myCall1[LONG_CALLSIGN_LENGTH];
+	unsigned char   m_myCall2[SHORT_CALLSIGN_LENGTH];
+	unsigned char   m_yourCall[LONG_CALLSIGN_LENGTH];
+	unsigned char   m_rptCall1[LONG_CALLSIGN_LENGTH];
+	unsigned char   m_rptCall2[LONG_CALLSIGN_LENGTH];
 	unsigned char   m_flag1;
 	unsigned char   m_flag2;
 	unsigned char   m_flag3;
@@ -91,16 +102,15 @@ private:
 	unsigned int    m_announceTimer;
 	unsigned int    m_announceExpiry;
 	float           m_percent;
-	wxString        m_text;
-	wxString        m_status1;
-	wxString        m_status2;
-	wxString        m_status3;
-	wxString        m_status4;
-	wxString        m_status5;
+	wxChar          m_text[SLOW_DATA_TEXT_LENGTH + 1U];
+	wxChar          m_status[STATUS_TEXT_COUNT][SLOW_DATA_TEXT_LENGTH + 1U];
 
 	// DVAP
 	bool            m_squelch;
 	int             m_signal;
+
+	wxString getCallsign(const unsigned char* callsign, unsigned int length) const;
+	void     setText(wxChar* out, const wxString& text);
 };
 
 #endif
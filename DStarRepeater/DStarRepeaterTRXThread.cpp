@@ -31,10 +31,21 @@ const unsigned int MAX_DATA_SYNC_BIT_ERRS  = 2U;
 
 const unsigned int NETWORK_QUEUE_COUNT = 2U;
 
-const unsigned int SILENCE_THRESHOLD = 2U;
+// The limits of the network playout delay in ms
+const unsigned int NETWORK_MIN_DELAY = 40U;
+const unsigned int NETWORK_MAX_DELAY = 300U;
 
+const wxString BLANK_CALLSIGN = wxT("        ");
+
+// While anything is waiting for the modem the thread wakes at least this often
 const unsigned int CYCLE_TIME = 9U;
 
+// The longest sleep when no timer is due before then
+const unsigned int MAX_WAIT_TIME = 1000U;
+
+const unsigned int LATENCY_BUCKET_WIDTH = 500U;		// 0.5ms
+const unsigned int LATENCY_BUCKET_COUNT = 80U;		// Up to 40ms
+
 CDStarRepeaterTRXThread::CDStarRepeaterTRXThread(const wxString& type) :
 m_type(type),
 m_modem(NULL),
@@ -49,23 +60,27 @@ m_recordRPT1(),
 m_recordRPT2(),
 m_deleteRPT1(),
 m_deleteRPT2(),
-m_rxHeader(NULL),
+m_rxHeader(),
 m_localQueue((DV_FRAME_LENGTH_BYTES + 2U) * 50U, LOCAL_RUN_FRAME_COUNT),			// 1s worth of data
 m_radioQueue((DV_FRAME_LENGTH_BYTES + 2U) * 50U, RADIO_RUN_FRAME_COUNT),			// 1s worth of data
 m_networkQueue(NULL),
 m_writeNum(0U),
 m_readNum(0U),
+m_jitterBuffer(NETWORK_MIN_DELAY, NETWORK_MAX_DELAY),
+m_concealer(0U),
 m_radioSeqNo(0U),
 m_networkSeqNo(0U),
 m_lastSlowDataType(0x00U),
-m_timeoutTimer(1000U, 180U),		// 180s
-m_watchdogTimer(1000U, NETWORK_TIMEOUT),
-m_pollTimer(1000U, 60U),			// 60s
-m_ackTimer(1000U, 0U, 500U),		// 0.5s
-m_beaconTimer(1000U, 600U),			// 10 mins
-m_announcementTimer(1000U, 0U),		// not running
-m_statusTimer(1000U, 0U, 100U),		// 100ms
-m_heartbeatTimer(1000U, 1U),		// 1s
+m_wheel(),
+m_timeoutTimer(m_wheel, 180U),		// 180s
+m_watchdogTimer(m_wheel, NETWORK_TIMEOUT),
+m_pollTimer(m_wheel, 60U),			// 60s
+m_ackTimer(m_wheel, 0U, 500U),		// 0.5s
+m_beaconTimer(m_wheel, 600U),			// 10 mins
+m_announcementTimer(m_wheel, 0U),		// not running
+m_statusTimer(m_wheel, 0U, 100U),		// 100ms
+m_berTimer(m_wheel, 1U),			// 1s
+m_heartbeatTimer(m_wheel, 1U),		// 1s
 m_rptState(DSRS_LISTENING),
 m_rxState(DSRXS_LISTENING),
 m_slowDataDecoder(),
@@ -90,11 +105,10 @@ m_controlRPT1(),
 m_controlRPT2(),
 m_controlShutdown(),
 m_controlStartup(),
-m_activeHangTimer(1000U),
+m_activeHangTimer(m_wheel),
 m_shutdown(false),
 m_disable(false),
 m_logging(NULL),
-m_lastData(NULL),
 m_ambe(),
 m_ambeFrames(0U),
 m_ambeSilence(0U),
@@ -102,13 +116,12 @@ m_ambeBits(1U),
 m_ambeErrors(0U),
 m_lastAMBEBits(0U),
 m_lastAMBEErrors(0U),
+m_ber(0.0F),
 m_ackText(),
 m_tempAckText(),
 m_linkStatus(LS_NONE),
 m_reflector(),
 m_regEx(wxT("^[A-Z0-9]{1}[A-Z0-9]{0,1}[0-9]{1,2}[A-Z]{1,4} {0,4}[ A-Z]{1}$")),
-m_headerTime(),
-m_packetTime(),
 m_packetCount(0U),
 m_packetSilence(0U),
 m_whiteList(NULL),
@@ -118,10 +131,20 @@ m_blocked(false),
 m_busyData(false),
 m_blanking(true),
 m_recording(false),
-m_deleting(false)
+m_deleting(false),
+m_poller(),
+m_latency(LATENCY_BUCKET_WIDTH, LATENCY_BUCKET_COUNT),
+m_statusData(),
+m_statusLock(),
+m_trace(NULL)
 {
-	for(int i = 0; i < 5; ++i)
-		m_statusAnnounceTimer[i] = CTimer(1000U, 3U);
+	for (unsigned int i = 0U; i <= TQ_NETWORK; i++)
+		m_traceQueues[i] = 0U;
+
+	for(int i = 0; i < 5; ++i) {
+		m_statusAnnounceTimer[i].setWheel(m_wheel);
+		m_statusAnnounceTimer[i].setTimeout(3U);
+	}
 
 	m_statusText.Add("", 5);
 
@@ -129,8 +152,6 @@ m_deleting(false)
 	for (unsigned int i = 0U; i < NETWORK_QUEUE_COUNT; i++)
 		m_networkQueue[i] = new COutputQueue((DV_FRAME_LENGTH_BYTES + 2U) * 200U, NETWORK_RUN_FRAME_COUNT);		// 4s worth of data);
 
-	m_lastData = new unsigned char[DV_FRAME_MAX_LENGTH_BYTES];
-
 	setRepeaterState(DSRS_LISTENING);
 	setRadioState(DSRXS_LISTENING);
 }
@@ -140,12 +161,12 @@ CDStarRepeaterTRXThread::~CDStarRepeaterTRXThread()
 	for (unsigned int i = 0U; i < NETWORK_QUEUE_COUNT; i++)
 		delete m_networkQueue[i];
 	delete[] m_networkQueue;
-	delete[] m_lastData;
-	delete   m_rxHeader;
 }
 
 void *CDStarRepeaterTRXThread::Entry()
 {
+	startLog();
+
 	// Wait here until we have the essentials to run
 	while (!m_killed && (m_modem == NULL || m_controller == NULL || m_rptCallsign.IsEmpty() || m_rptCallsign.IsSameAs(wxT("        "))))
 		::wxMilliSleep(500UL);		// 1/2 sec
@@ -160,6 +181,7 @@ void *CDStarRepeaterTRXThread::Entry()
 	m_controller->setActive(false);
 	m_controller->setRadioTransmit(false);
 	m_statusTimer.start();
+	m_berTimer.start();
 	m_heartbeatTimer.start();
 
 	if (m_protocolHandler != NULL)
@@ -180,24 +202,38 @@ void *CDStarRepeaterTRXThread::Entry()
 	pollText.MakeLower();
 	wxLogMessage(wxT("Poll text set to \"%s\""), pollText.c_str());
 
+	// Wake as soon as the modem has data or a packet arrives, or the next timer is due
+	bool ret = m_poller.open();
+	if (ret) {
+		m_modem->setPoller(&m_poller);
+
+		if (m_protocolHandler != NULL)
+			m_poller.addReader(m_protocolHandler->getFD());
+	}
+
 	wxLogMessage(wxT("Starting the D-Star repeater thread"));
 
-	wxStopWatch stopWatch;
+	wxUint64 lastTime = CUtils::getTimestamp();
 
 	try {
 		while (!m_killed) {
-			stopWatch.Start();
-
 			if (m_statusTimer.hasExpired() || m_space == 0U) {
 				m_space = m_modem->getSpace();
 				m_tx    = m_modem->isTX();
 				m_statusTimer.start();
+
+				traceQueue(TQ_MODEM_SPACE, m_space);
+				traceQueue(TQ_RADIO,       m_radioQueue.dataSize());
+				traceQueue(TQ_LOCAL,       m_localQueue.dataSize());
+				traceQueue(TQ_NETWORK,     m_networkQueue[m_readNum]->dataSize());
 			}
 
 			receiveModem();
 
 			receiveNetwork();
 
+			playoutNetwork();
+
 			repeaterStateMachine();
 
 			// Send the network poll if needed and restart the timer
@@ -260,6 +296,7 @@ void *CDStarRepeaterTRXThread::Entry()
 						m_networkQueue[i]->reset();
 					m_controller->setActive(false);
 					m_controller->setRadioTransmit(false);
+					trace(TE_RPT_STATE, DSRS_SHUTDOWN, m_rptState);
 					m_rptState = DSRS_SHUTDOWN;
 				}
 			} else {
@@ -269,6 +306,7 @@ void *CDStarRepeaterTRXThread::Entry()
 					m_ackTimer.stop();
 					m_beaconTimer.start();
 					m_announcementTimer.start();
+					trace(TE_RPT_STATE, DSRS_LISTENING, m_rptState);
 					m_rptState = DSRS_LISTENING;
 					if (m_protocolHandler != NULL)	// Tell the protocol handler
 						m_protocolHandler->reset();
@@ -290,12 +328,19 @@ void *CDStarRepeaterTRXThread::Entry()
 
 			m_controller->setRadioTransmit(m_tx);
 
-			unsigned long ms = stopWatch.Time();
-			if (ms < CYCLE_TIME) {
-				::wxMilliSleep(CYCLE_TIME - ms);
-				clock(CYCLE_TIME);
-			} else {
+			publishStatus();
+
+			unsigned int timeout = getTimeout();
+			if (ret)
+				m_poller.wait(timeout);
+			else
+				::wxMilliSleep(timeout);
+
+			// Only whole milliseconds are clocked, the remainder is carried over to the next pass
+			unsigned int ms = (unsigned int)((CUtils::getTimestamp() - lastTime) / 1000U);
+			if (ms > 0U) {
 				clock(ms);
+				lastTime += ms * 1000U;
 			}
 		}
 	}
@@ -309,8 +354,11 @@ void *CDStarRepeaterTRXThread::Entry()
 
 	wxLogMessage(wxT("Stopping the D-Star repeater thread"));
 
+	m_modem->setPoller(NULL);
 	m_modem->stop();
 
+	m_poller.close();
+
 	if (m_logging != NULL) {
 		m_logging->close();
 		delete m_logging;
@@ -333,12 +381,16 @@ void *CDStarRepeaterTRXThread::Entry()
 		delete m_protocolHandler;
 	}
 
+	delete m_trace;
+
 	return NULL;
 }
 
 void CDStarRepeaterTRXThread::kill()
 {
 	m_killed = true;
+
+	m_poller.signal();
 }
 
 void CDStarRepeaterTRXThread::setCallsign(const wxString& callsign, const wxString& gateway, DSTAR_MODE mode, ACK_TYPE ack, bool restriction, bool rpt1Validation, bool dtmfBlanking, bool errorReply)
@@ -384,6 +436,11 @@ void CDStarRepeaterTRXThread::setTimes(unsigned int timeout, unsigned int ackTim
 	m_ackTimer.setTimeout(0U, ackTime);
 }
 
+void CDStarRepeaterTRXThread::setConcealment(unsigned int frames)
+{
+	m_concealer.setFadeFrames(frames);
+}
+
 void CDStarRepeaterTRXThread::setBeacon(unsigned int time, const wxString& text, bool voice, TEXT_LANG language)
 {
 	m_beaconTimer.setTimeout(time);
@@ -499,6 +556,11 @@ void CDStarRepeaterTRXThread::setLogging(bool logging, const wxString& dir)
 	}
 }
 
+CAnnouncementUnit* CDStarRepeaterTRXThread::getAnnouncement() const
+{
+	return m_announcement;
+}
+
 void CDStarRepeaterTRXThread::setWhiteList(CCallsignList* list)
 {
 	wxASSERT(list != NULL);
@@ -520,6 +582,13 @@ void CDStarRepeaterTRXThread::setGreyList(CCallsignList* list)
 	m_greyList = list;
 }
 
+void CDStarRepeaterTRXThread::setTrace(CEventTrace* trace)
+{
+	wxASSERT(trace != NULL);
+
+	m_trace = trace;
+}
+
 void CDStarRepeaterTRXThread::receiveModem()
 {
 	for (;;) {
@@ -527,11 +596,14 @@ void CDStarRepeaterTRXThread::receiveModem()
 		if (type == DSMTT_NONE)
 			return;
 
+		trace(TE_MODEM_READ, type);
+
 		switch (m_rxState) {
 			case DSRXS_LISTENING:
 				if (type == DSMTT_HEADER) {
-					CHeaderData* header = m_modem->readHeader();
-					receiveHeader(header);
+					CHeaderData header;
+					if (m_modem->readHeader(header))
+						receiveHeader(header);
 				} else if (type == DSMTT_DATA) {
 					unsigned char data[20U];
 					unsigned int length = m_modem->readData(data, 20U);
@@ -567,11 +639,9 @@ void CDStarRepeaterTRXThread::receiveModem()
 	}
 }
 
-void CDStarRepeaterTRXThread::receiveHeader(CHeaderData* header)
+void CDStarRepeaterTRXThread::receiveHeader(CHeaderData& header)
 {
-	wxASSERT(header != NULL);
-
-	wxLogMessage(wxT("Radio header decoded - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str(), header->getFlag1(), header->getFlag2(), header->getFlag3());
+	wxLogMessage(wxT("Radio header decoded - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header.getMyCall1().c_str(), header.getMyCall2().c_str(), header.getYourCall().c_str(), header.getRptCall1().c_str(), header.getRptCall2().c_str(), header.getFlag1(), header.getFlag2(), header.getFlag3());
 
 	bool res = processRadioHeader(header);
 	if (res) {
@@ -604,21 +674,19 @@ void CDStarRepeaterTRXThread::receiveSlowData(unsigned char* data, unsigned int)
 		m_radioSeqNo++;
 		m_slowDataDecoder.addData(data + VOICE_FRAME_LENGTH_BYTES);
 
-		CHeaderData* header = m_slowDataDecoder.getHeaderData();
-		if (header == NULL)
+		CHeaderData header;
+		if (!m_slowDataDecoder.getHeaderData(header))
 			return;
 
-		wxLogMessage(wxT("Radio header from slow data - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X  BER: 0%%"), header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str(), header->getFlag1(), header->getFlag2(), header->getFlag3());
+		wxLogMessage(wxT("Radio header from slow data - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X  BER: 0%%"), header.getMyCall1().c_str(), header.getMyCall2().c_str(), header.getYourCall().c_str(), header.getRptCall1().c_str(), header.getRptCall2().c_str(), header.getFlag1(), header.getFlag2(), header.getFlag3());
 
-		if (header != NULL) {
-			bool res = processRadioHeader(header);
-			if (res) {
-				// A valid header and is a DV packet, go to normal data relaying
-				setRadioState(DSRXS_PROCESS_DATA);
-			} else {
-				// This is a DD packet or some other problem
-				// wxLogMessage(wxT("Invalid header"));
-			}
+		bool res = processRadioHeader(header);
+		if (res) {
+			// A valid header and is a DV packet, go to normal data relaying
+			setRadioState(DSRXS_PROCESS_DATA);
+		} else {
+			// This is a DD packet or some other problem
+			// wxLogMessage(wxT("Invalid header"));
 		}
 	}
 }
@@ -659,14 +727,14 @@ void CDStarRepeaterTRXThread::receiveNetwork()
 		if (type == NETWORK_NONE) {					// Nothing received
 			break;
 		} else if (type == NETWORK_HEADER) {		// A header
-			CHeaderData* header = m_protocolHandler->readHeader();
-			if (header != NULL) {
-				::memcpy(m_lastData, NULL_FRAME_DATA_BYTES, DV_FRAME_LENGTH_BYTES);
+			CHeaderData header;
+			if (m_protocolHandler->readHeader(header)) {
+				trace(TE_NETWORK_READ, type);
+
+				m_concealer.reset();
 
 				processNetworkHeader(header);
 
-				m_headerTime.Start();
-				m_packetTime.Start();
 				m_packetCount   = 0U;
 				m_packetSilence = 0U;
 			}
@@ -676,14 +744,19 @@ void CDStarRepeaterTRXThread::receiveNetwork()
 
 			unsigned char seqNo;
 			unsigned int length = m_protocolHandler->readData(data, DV_FRAME_MAX_LENGTH_BYTES, seqNo);
-			if (length != 0U) {
-				::memcpy(m_lastData, data, length);
+			trace(TE_NETWORK_READ, type, seqNo, length);
+			if (length != 0U && m_rptState == DSRS_NETWORK) {
 				m_watchdogTimer.start();
-				m_packetCount += processNetworkFrame(data, length, seqNo);
+
+				// Mask out the control bits of the sequence number
+				bool ret = m_jitterBuffer.write(seqNo & 0x1FU, (seqNo & 0x40U) == 0x40U, data, length);
+				if (!ret)
+					trace(TE_SILENCE, TS_LATE, seqNo & 0x1FU, 1U);
 			}
 		} else if (type == NETWORK_TEXT) {			// Slow data text for the Ack
 			m_protocolHandler->readText(m_ackText, m_linkStatus, m_reflector);
 			m_linkEncoder.setTextData(m_ackText);
+			m_statusData.setText(m_ackText);
 			wxLogMessage(wxT("Slow data set to \"%s\""), m_ackText.c_str());
 		} else if (type == NETWORK_TEMPTEXT) {			// Temporary slow data text for the Ack
 			m_protocolHandler->readTempText(m_tempAckText);
@@ -691,59 +764,81 @@ void CDStarRepeaterTRXThread::receiveNetwork()
 		} else if (type == NETWORK_STATUS1) {		// Status 1 data text
 			m_statusText[0] = m_protocolHandler->readStatus1();
 			m_status1Encoder.setTextData(m_statusText[0]);
+			m_statusData.setStatus(0U, m_statusText[0]);
 			wxLogMessage(wxT("Status 1 data set to \"%s\""), m_statusText[0].c_str());
 		} else if (type == NETWORK_STATUS2) {		// Status 2 data text
 			m_statusText[1] = m_protocolHandler->readStatus2();
 			m_status2Encoder.setTextData(m_statusText[1]);
+			m_statusData.setStatus(1U, m_statusText[1]);
 			wxLogMessage(wxT("Status 2 data set to \"%s\""), m_statusText[1].c_str());
 		} else if (type == NETWORK_STATUS3) {		// Status 3 data text
 			m_statusText[2] = m_protocolHandler->readStatus3();
 			m_status3Encoder.setTextData(m_statusText[2]);
+			m_statusData.setStatus(2U, m_statusText[2]);
 			wxLogMessage(wxT("Status 3 data set to \"%s\""), m_statusText[2].c_str());
 		} else if (type == NETWORK_STATUS4) {		// Status 4 data text
 			m_statusText[3] = m_protocolHandler->readStatus4();
 			m_status4Encoder.setTextData(m_statusText[3]);
+			m_statusData.setStatus(3U, m_statusText[3]);
 			wxLogMessage(wxT("Status 4 data set to \"%s\""), m_statusText[3].c_str());
 		} else if (type == NETWORK_STATUS5) {		// Status 5 data text
 			m_statusText[4] = m_protocolHandler->readStatus5();
 			m_status5Encoder.setTextData(m_statusText[4]);
+			m_statusData.setStatus(4U, m_statusText[4]);
 			wxLogMessage(wxT("Status 5 data set to \"%s\""), m_statusText[4].c_str());
 		}
 	}
+}
 
-	// Have we missed any data frames?
-	if (m_rptState == DSRS_NETWORK && m_packetTime.Time() > 200L) {
-		unsigned int packetsNeeded = m_headerTime.Time() / DSTAR_FRAME_TIME_MS;
+void CDStarRepeaterTRXThread::playoutNetwork()
+{
+	if (m_rptState != DSRS_NETWORK)
+		return;
 
-		// wxLogMessage(wxT("Time: %u ms, need %u packets and received %u packets"), ms - m_headerMS, packetsNeeded, m_packetCount);
+	// The frames that have come due since the last pass have their FEC regenerated together
+	unsigned char frames[JITTER_SLOTS * DV_FRAME_LENGTH_BYTES];
+	unsigned int n = 0U;
 
-		if (packetsNeeded > m_packetCount) {
-			unsigned int count = packetsNeeded - m_packetCount;
+	for (;;) {
+		unsigned char* data = frames + n * DV_FRAME_LENGTH_BYTES;
+		JITTER_FRAME type = m_jitterBuffer.read(data);
 
-			if (count > 5U) {
-				count -= 2U;
+		if (type == JF_NONE) {
+			writeNetworkFrames(frames, n);
+			return;
+		} else if (type == JF_END) {
+			writeNetworkFrames(frames, n);
+			m_networkQueue[m_writeNum]->addData(END_PATTERN_BYTES, DV_FRAME_LENGTH_BYTES, true);
+			endOfNetworkData();
+			return;
+		} else if (type == JF_MISSING) {
+			trace(TE_SILENCE, TS_MISSING, m_networkSeqNo, 1U);
 
-				// wxLogMessage(wxT("Inserting %u silence frames into the network data stream"), count);
+			// The voice fades out from the last good frame, the slow data is the null filler
+			::memcpy(data, NULL_FRAME_DATA_BYTES, DV_FRAME_LENGTH_BYTES);
+			m_concealer.conceal(data);
 
-				// Create silence frames
-				for (unsigned int i = 0U; i < count; i++) {
-					unsigned char data[DV_FRAME_LENGTH_BYTES];
-					::memcpy(data, NULL_FRAME_DATA_BYTES, DV_FRAME_LENGTH_BYTES);
-					m_packetCount += processNetworkFrame(data, DV_FRAME_LENGTH_BYTES, m_networkSeqNo);
-					m_packetSilence++;
-				}
-			}
+			m_packetSilence++;
+		} else {
+			m_concealer.good(data);
 		}
 
-		m_packetTime.Start();
+		processNetworkFrame(data);
+		m_packetCount++;
+
+		n++;
+		if (n == JITTER_SLOTS) {
+			writeNetworkFrames(frames, n);
+			n = 0U;
+		}
 	}
 }
 
-void CDStarRepeaterTRXThread::transmitLocalHeader(CHeaderData* header)
+void CDStarRepeaterTRXThread::transmitLocalHeader(const CHeaderData& header)
 {
-	wxLogMessage(wxT("Transmitting to - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str(), header->getFlag1(), header->getFlag2(), header->getFlag3());
+	wxLogMessage(wxT("Transmitting to - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header.getMyCall1().c_str(), header.getMyCall2().c_str(), header.getYourCall().c_str(), header.getRptCall1().c_str(), header.getRptCall2().c_str(), header.getFlag1(), header.getFlag2(), header.getFlag3());
 
-	m_headerEncoder.setHeaderData(*header);
+	m_headerEncoder.setHeaderData(header);
 
 	m_localQueue.reset();
 	m_localQueue.setHeader(header);
@@ -751,7 +846,7 @@ void CDStarRepeaterTRXThread::transmitLocalHeader(CHeaderData* header)
 
 void CDStarRepeaterTRXThread::transmitBeaconHeader()
 {
-	CHeaderData* header = new CHeaderData(m_rptCallsign, wxT("RPTR"), wxT("CQCQCQ  "), m_gwyCallsign, m_rptCallsign);
+	CHeaderData header(m_rptCallsign, wxT("RPTR"), wxT("CQCQCQ  "), m_gwyCallsign, m_rptCallsign);
 	transmitLocalHeader(header);
 }
 
@@ -760,12 +855,13 @@ void CDStarRepeaterTRXThread::transmitBeaconData(const unsigned char* data, unsi
 	m_localQueue.addData(data, length, end);
 }
 
-void CDStarRepeaterTRXThread::transmitAnnouncementHeader(CHeaderData* header)
+void CDStarRepeaterTRXThread::transmitAnnouncementHeader(const CHeaderData& header)
 {
-	header->setRptCall1(m_gwyCallsign);
-	header->setRptCall2(m_rptCallsign);
+	CHeaderData txHeader(header);
+	txHeader.setRptCall1(m_gwyCallsign);
+	txHeader.setRptCall2(m_rptCallsign);
 
-	transmitLocalHeader(header);
+	transmitLocalHeader(txHeader);
 }
 
 void CDStarRepeaterTRXThread::transmitAnnouncementData(const unsigned char* data, unsigned int length, bool end)
@@ -773,21 +869,21 @@ void CDStarRepeaterTRXThread::transmitAnnouncementData(const unsigned char* data
 	m_localQueue.addData(data, length, end);
 }
 
-void CDStarRepeaterTRXThread::transmitRadioHeader(CHeaderData* header)
+void CDStarRepeaterTRXThread::transmitRadioHeader(const CHeaderData& header)
 {
-	wxLogMessage(wxT("Transmitting to - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str(), header->getFlag1(), header->getFlag2(), header->getFlag3());
+	wxLogMessage(wxT("Transmitting to - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header.getMyCall1().c_str(), header.getMyCall2().c_str(), header.getYourCall().c_str(), header.getRptCall1().c_str(), header.getRptCall2().c_str(), header.getFlag1(), header.getFlag2(), header.getFlag3());
 
-	m_headerEncoder.setHeaderData(*header);
+	m_headerEncoder.setHeaderData(header);
 
 	m_radioQueue.reset();
 	m_radioQueue.setHeader(header);
 }
 
-void CDStarRepeaterTRXThread::transmitNetworkHeader(CHeaderData* header)
+void CDStarRepeaterTRXThread::transmitNetworkHeader(const CHeaderData& header)
 {
-	wxLogMessage(wxT("Transmitting to - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str(), header->getFlag1(), header->getFlag2(), header->getFlag3());
+	wxLogMessage(wxT("Transmitting to - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header.getMyCall1().c_str(), header.getMyCall2().c_str(), header.getYourCall().c_str(), header.getRptCall1().c_str(), header.getRptCall2().c_str(), header.getFlag1(), header.getFlag2(), header.getFlag3());
 
-	m_headerEncoder.setHeaderData(*header);
+	m_headerEncoder.setHeaderData(header);
 
 	bool empty = m_networkQueue[m_readNum]->isEmpty();
 	if (!empty) {
@@ -812,7 +908,7 @@ void CDStarRepeaterTRXThread::transmitNetworkHeader(CHeaderData* header)
 
 void CDStarRepeaterTRXThread::transmitStatus()
 {
-	CHeaderData* header = new CHeaderData(m_rptCallsign, wxT("    "), m_rxHeader->getMyCall1(), m_gwyCallsign, m_rptCallsign, RELAY_UNAVAILABLE);
+	CHeaderData header(m_rptCallsign, wxT("    "), m_rxHeader.getMyCall1(), m_gwyCallsign, m_rptCallsign, RELAY_UNAVAILABLE);
 	transmitLocalHeader(header);
 
 	// Filler data
@@ -840,7 +936,7 @@ void CDStarRepeaterTRXThread::transmitStatus()
 
 void CDStarRepeaterTRXThread::transmitErrorStatus()
 {
-	CHeaderData* header = new CHeaderData(m_rptCallsign, wxT("    "), m_rxHeader->getMyCall1(), m_rptCallsign, m_rptCallsign, RELAY_UNAVAILABLE);
+	CHeaderData header(m_rptCallsign, wxT("    "), m_rxHeader.getMyCall1(), m_rptCallsign, m_rptCallsign, RELAY_UNAVAILABLE);
 	transmitLocalHeader(header);
 
 	// Filler data
@@ -869,26 +965,26 @@ void CDStarRepeaterTRXThread::transmitErrorStatus()
 void CDStarRepeaterTRXThread::transmitUserStatus(unsigned int n)
 {
 	CSlowDataEncoder* encoder = NULL;
-	CHeaderData* header = NULL;
+	wxString yourCall;
 	switch (n) {
 		case 0U:
-			header = new CHeaderData(m_rptCallsign, wxT("    "), wxT("STATUS 1"), m_gwyCallsign, m_rptCallsign);
+			yourCall = wxT("STATUS 1");
 			encoder = &m_status1Encoder;
 			break;
 		case 1U:
-			header = new CHeaderData(m_rptCallsign, wxT("    "), wxT("STATUS 2"), m_gwyCallsign, m_rptCallsign);
+			yourCall = wxT("STATUS 2");
 			encoder = &m_status2Encoder;
 			break;
 		case 2U:
-			header = new CHeaderData(m_rptCallsign, wxT("    "), wxT("STATUS 3"), m_gwyCallsign, m_rptCallsign);
+			yourCall = wxT("STATUS 3");
 			encoder = &m_status3Encoder;
 			break;
 		case 3U:
-			header = new CHeaderData(m_rptCallsign, wxT("    "), wxT("STATUS 4"), m_gwyCallsign, m_rptCallsign);
+			yourCall = wxT("STATUS 4");
 			encoder = &m_status4Encoder;
 			break;
 		case 4U:
-			header = new CHeaderData(m_rptCallsign, wxT("    "), wxT("STATUS 5"), m_gwyCallsign, m_rptCallsign);
+			yourCall = wxT("STATUS 5");
 			encoder = &m_status5Encoder;
 			break;
 		default:
@@ -896,6 +992,7 @@ void CDStarRepeaterTRXThread::transmitUserStatus(unsigned int n)
 			return;
 	}
 
+	CHeaderData header(m_rptCallsign, wxT("    "), yourCall, m_gwyCallsign, m_rptCallsign);
 	transmitLocalHeader(header);
 
 	// Filler data
@@ -928,12 +1025,11 @@ void CDStarRepeaterTRXThread::transmitLocalHeader()
 	if (!ready)
 		return;
 
-	CHeaderData* header = m_localQueue.getHeader();
-	if (header == NULL)
+	CHeaderData header;
+	if (!m_localQueue.getHeader(header))
 		return;
 
-	m_modem->writeHeader(*header);
-	delete header;
+	m_modem->writeHeader(header);
 }
 
 void CDStarRepeaterTRXThread::transmitLocalData()
@@ -962,12 +1058,11 @@ void CDStarRepeaterTRXThread::transmitRadioHeader()
 	if (!ready)
 		return;
 
-	CHeaderData* header = m_radioQueue.getHeader();
-	if (header == NULL)
+	CHeaderData header;
+	if (!m_radioQueue.getHeader(header))
 		return;
 
-	m_modem->writeHeader(*header);
-	delete header;
+	m_modem->writeHeader(header);
 }
 
 void CDStarRepeaterTRXThread::transmitRadioData()
@@ -996,12 +1091,11 @@ void CDStarRepeaterTRXThread::transmitNetworkHeader()
 	if (!ready)
 		return;
 
-	CHeaderData* header = m_networkQueue[m_readNum]->getHeader();
-	if (header == NULL)
+	CHeaderData header;
+	if (!m_networkQueue[m_readNum]->getHeader(header))
 		return;
 
-	m_modem->writeHeader(*header);
-	delete header;
+	m_modem->writeHeader(header);
 }
 
 void CDStarRepeaterTRXThread::transmitNetworkData()
@@ -1081,6 +1175,8 @@ void CDStarRepeaterTRXThread::repeaterStateMachine()
 
 void CDStarRepeaterTRXThread::setRadioState(DSTAR_RX_STATE state)
 {
+	trace(TE_RX_STATE, state, m_rxState);
+
 	// This is the too state
 	switch (state) {
 		case DSRXS_LISTENING:
@@ -1094,6 +1190,7 @@ void CDStarRepeaterTRXThread::setRadioState(DSTAR_RX_STATE state)
 			m_ambeErrors     = 0U;
 			m_lastAMBEBits   = 0U;
 			m_lastAMBEErrors = 0U;
+			m_ber            = 0.0F;
 			m_rxState        = DSRXS_PROCESS_DATA;
 			break;
 
@@ -1111,6 +1208,8 @@ bool CDStarRepeaterTRXThread::setRepeaterState(DSTAR_RPT_STATE state)
 	if (m_disable || m_shutdown)
 		return false;
 
+	DSTAR_RPT_STATE oldState = m_rptState;
+
 	// The "from" state
 	switch (m_rptState) {
 		case DSRS_SHUTDOWN:
@@ -1211,6 +1310,7 @@ bool CDStarRepeaterTRXThread::setRepeaterState(DSTAR_RPT_STATE state)
 
 			m_rptState = DSRS_NETWORK;
 			m_networkSeqNo = 0U;
+			m_jitterBuffer.reset();
 			m_timeoutTimer.stop();
 			m_watchdogTimer.start();
 			m_activeHangTimer.stop();
@@ -1218,99 +1318,85 @@ bool CDStarRepeaterTRXThread::setRepeaterState(DSTAR_RPT_STATE state)
 			break;
 	}
 
+	trace(TE_RPT_STATE, m_rptState, oldState);
+
 	return true;
 }
 
-bool CDStarRepeaterTRXThread::processRadioHeader(CHeaderData* header)
+bool CDStarRepeaterTRXThread::processRadioHeader(CHeaderData& header)
 {
-	wxASSERT(header != NULL);
-
 	// Check control messages
-	bool res = checkControl(*header);
-	if (res) {
-		delete header;
+	bool res = checkControl(header);
+	if (res)
 		return true;
-	}
 
 	// Check announcement messages
-	res = checkAnnouncements(*header);
+	res = checkAnnouncements(header);
 	if (res) {
 		bool res = setRepeaterState(DSRS_INVALID);
-		if (res) {
-			delete m_rxHeader;
+		if (res)
 			m_rxHeader = header;
-		} else {
-			delete header;
-		}
 		return true;
 	}
 
 	// If shutdown we ignore incoming headers
-	if (m_rptState == DSRS_SHUTDOWN) {
-		delete header;
+	if (m_rptState == DSRS_SHUTDOWN)
 		return true;
-	}
+
+	unsigned char myCall1[LONG_CALLSIGN_LENGTH];
+	header.getMyCall1(myCall1);
 
 	if (m_whiteList != NULL) {
-		bool res = m_whiteList->isInList(header->getMyCall1());
+		bool res = m_whiteList->isInList(myCall1);
 		if (!res) {
-			wxLogMessage(wxT("%s rejected due to not being in the white list"), header->getMyCall1().c_str());
-			delete header;
+			wxLogMessage(wxT("%s rejected due to not being in the white list"), header.getMyCall1().c_str());
 			return true;
 		}
 	}
 
 	if (m_blackList != NULL) {
-		bool res = m_blackList->isInList(header->getMyCall1());
+		bool res = m_blackList->isInList(myCall1);
 		if (res) {
-			wxLogMessage(wxT("%s rejected due to being in the black list"), header->getMyCall1().c_str());
-			delete header;
+			wxLogMessage(wxT("%s rejected due to being in the black list"), header.getMyCall1().c_str());
 			return true;
 		}
 	}
 
 	m_blocked = false;
 	if (m_greyList != NULL) {
-		bool res = m_greyList->isInList(header->getMyCall1());
+		bool res = m_greyList->isInList(myCall1);
 		if (res) {
-			wxLogMessage(wxT("%s blocked from the network due to being in the grey list"), header->getMyCall1().c_str());
+			wxLogMessage(wxT("%s blocked from the network due to being in the grey list"), header.getMyCall1().c_str());
 			m_blocked = true;
 		}
 	}
 
 	// Check for receiving our own gateway data, and ignore it
 	if (m_mode == MODE_GATEWAY) {
-		if (header->getFlag2() == 0x01U) {
+		if (header.getFlag2() == 0x01U) {
 			wxLogMessage(wxT("Receiving a gateway header, ignoring"));
-			delete header;
 			return true;
 		}
 
-		header->setFlag2(0x00U);
+		header.setFlag2(0x00U);
 	}
 
 	// We don't handle DD data packets
-	if (header->isDataPacket()) {
+	if (header.isDataPacket()) {
 		wxLogMessage(wxT("Received a DD packet, ignoring"));
-		delete header;
 		return false;
 	}
 
-	TRISTATE valid = checkHeader(*header);
+	TRISTATE valid = checkHeader(header);
 	switch (valid) {
 		case STATE_FALSE: {
 				bool res = setRepeaterState(DSRS_INVALID);
-				if (res) {
-					delete m_rxHeader;
+				if (res)
 					m_rxHeader = header;
-				} else {
-					delete header;
-				}
 			}
 			return true;
 
 		case STATE_UNKNOWN:
-			delete header;
 			return true;
 
 		case STATE_TRUE:
@@ -1321,47 +1407,52 @@ bool CDStarRepeaterTRXThread::processRadioHeader(CHeaderData* header)
 	// command
 	if (m_rptState == DSRS_NETWORK) {
 		// Only send on the network if the user isn't blocked we have one and RPT2 is not blank or the repeater callsign
-		if (!header->getRptCall2().IsSameAs(wxT("        ")) && !header->getRptCall2().IsSameAs(m_rptCallsign)) {
+		if (!header.isRptCall2(BLANK_CALLSIGN) && !header.isRptCall2(m_rptCallsign)) {
 			if (!m_blocked && m_protocolHandler != NULL) {
-				CHeaderData netHeader(*header);
-				netHeader.setRptCall1(header->getRptCall2());
-				netHeader.setRptCall2(header->getRptCall1());
-				netHeader.setFlag1(header->getFlag1() & ~REPEATER_MASK);
+				unsigned char rptCall1[LONG_CALLSIGN_LENGTH], rptCall2[LONG_CALLSIGN_LENGTH];
+				header.getRptCall1(rptCall1);
+				header.getRptCall2(rptCall2);
+
+				CHeaderData netHeader(header);
+				netHeader.setRptCall1(rptCall2);
+				netHeader.setRptCall2(rptCall1);
+				netHeader.setFlag1(header.getFlag1() & ~REPEATER_MASK);
 				m_protocolHandler->writeBusyHeader(netHeader);
 			}
 
 			m_busyData = true;
 		}
 
-		delete header;
-
 		return true;
 	}
 
 	// Send the valid header to the gateway if we are accepted
 	res = setRepeaterState(DSRS_VALID);
 	if (res) {
-		delete m_rxHeader;
 		m_rxHeader = header;
 
 		if (m_logging != NULL)
-			m_logging->open(*m_rxHeader);
+			m_logging->open(m_rxHeader);
 
 		// Only send on the network if the user isn't blocked and we have one and RPT2 is not blank or the repeater callsign
-		if (!m_blocked && m_protocolHandler != NULL && !m_rxHeader->getRptCall2().IsSameAs(wxT("        ")) && !m_rxHeader->getRptCall2().IsSameAs(m_rptCallsign)) {
-			CHeaderData netHeader(*m_rxHeader);
-			netHeader.setRptCall1(m_rxHeader->getRptCall2());
-			netHeader.setRptCall2(m_rxHeader->getRptCall1());
-			netHeader.setFlag1(m_rxHeader->getFlag1() & ~REPEATER_MASK);
+		if (!m_blocked && m_protocolHandler != NULL && !m_rxHeader.isRptCall2(BLANK_CALLSIGN) && !m_rxHeader.isRptCall2(m_rptCallsign)) {
+			unsigned char rptCall1[LONG_CALLSIGN_LENGTH], rptCall2[LONG_CALLSIGN_LENGTH];
+			m_rxHeader.getRptCall1(rptCall1);
+			m_rxHeader.getRptCall2(rptCall2);
+
+			CHeaderData netHeader(m_rxHeader);
+			netHeader.setRptCall1(rptCall2);
+			netHeader.setRptCall2(rptCall1);
+			netHeader.setFlag1(m_rxHeader.getFlag1() & ~REPEATER_MASK);
 			m_protocolHandler->writeHeader(netHeader);
 		}
 
 		// Create the new radio header but only in duplex mode
 		if (m_mode == MODE_DUPLEX) {
-			CHeaderData* rfHeader = new CHeaderData(*m_rxHeader);
-			rfHeader->setRptCall1(m_rptCallsign);
-			rfHeader->setRptCall2(m_rptCallsign);
-			rfHeader->setFlag1(m_rxHeader->getFlag1() & ~REPEATER_MASK);
+			CHeaderData rfHeader(m_rxHeader);
+			rfHeader.setRptCall1(m_rptCallsign);
+			rfHeader.setRptCall2(m_rptCallsign);
+			rfHeader.setFlag1(m_rxHeader.getFlag1() & ~REPEATER_MASK);
 			transmitRadioHeader(rfHeader);
 		}
 	}
@@ -1369,46 +1460,37 @@ bool CDStarRepeaterTRXThread::processRadioHeader(CHeaderData* header)
 	return true;
 }
 
-void CDStarRepeaterTRXThread::processNetworkHeader(CHeaderData* header)
+void CDStarRepeaterTRXThread::processNetworkHeader(const CHeaderData& header)
 {
-	wxASSERT(header != NULL);
-
 	// If shutdown we ignore incoming headers
-	if (m_rptState == DSRS_SHUTDOWN) {
-		delete header;
+	if (m_rptState == DSRS_SHUTDOWN)
 		return;
-	}
 
-	wxLogMessage(wxT("Network header received - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str(), header->getFlag1(), header->getFlag2(), header->getFlag3());
+	wxLogMessage(wxT("Network header received - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header.getMyCall1().c_str(), header.getMyCall2().c_str(), header.getYourCall().c_str(), header.getRptCall1().c_str(), header.getRptCall2().c_str(), header.getFlag1(), header.getFlag2(), header.getFlag3());
 
 	// Is it for us?
-	if (!header->getRptCall2().IsSameAs(m_rptCallsign)) {
+	if (!header.isRptCall2(m_rptCallsign)) {
 		wxLogMessage(wxT("Invalid network RPT2 value, ignoring"));
-		delete header;
 		return;
 	}
 
 	bool res = setRepeaterState(DSRS_NETWORK);
-	if (!res) {
-		delete header;
+	if (!res)
 		return;
-	}
 
-	delete m_rxHeader;
 	m_rxHeader = header;
 
 	if (m_mode == MODE_GATEWAY) {
 		// If in gateway mode, set the repeater bit, set flag 2 to 0x01,
 		// and change RPT1 & RPT2 just for transmission
-		CHeaderData* header = new CHeaderData(*m_rxHeader);
-		header->setRepeaterMode(true);
-		header->setFlag2(0x01U);
-		header->setRptCall1(m_rptCallsign);
-		header->setRptCall2(m_gwyCallsign);
-		transmitNetworkHeader(header);
+		CHeaderData txHeader(m_rxHeader);
+		txHeader.setRepeaterMode(true);
+		txHeader.setFlag2(0x01U);
+		txHeader.setRptCall1(m_rptCallsign);
+		txHeader.setRptCall2(m_gwyCallsign);
+		transmitNetworkHeader(txHeader);
 	} else {
-		CHeaderData* header = new CHeaderData(*m_rxHeader);
-		transmitNetworkHeader(header);
+		transmitNetworkHeader(m_rxHeader);
 	}
 }
 
@@ -1424,7 +1506,7 @@ void CDStarRepeaterTRXThread::processRadioFrame(unsigned char* data, FRAME_TYPE
 	unsigned int errors = 0U;
 	if (type != FRAME_END) {
 		// Data packets have no AMBE FEC
-		if (!m_rxHeader->isDataPacket())
+		if (!m_rxHeader.isDataPacket())
 			errors = m_ambe.regenerate(data);
 
 		m_ambeErrors += errors;
@@ -1496,9 +1578,12 @@ void CDStarRepeaterTRXThread::processRadioFrame(unsigned char* data, FRAME_TYPE
 			m_logging->write(data, DV_FRAME_LENGTH_BYTES);
 
 		// Send the data to the network
-		if (!m_blocked && m_protocolHandler != NULL)
+		if (!m_blocked && m_protocolHandler != NULL) {
 			m_protocolHandler->writeData(data, DV_FRAME_LENGTH_BYTES, errors, false);
 
+			m_latency.add(CUtils::getTimestamp() - m_modem->getReadTime());
+		}
+
 		// Send the data for transmission, but only in duplex mode
 		if (m_mode == MODE_DUPLEX) {
 			if (m_blanking)
@@ -1508,65 +1593,9 @@ void CDStarRepeaterTRXThread::processRadioFrame(unsigned char* data, FRAME_TYPE
 	}
 }
 
-unsigned int CDStarRepeaterTRXThread::processNetworkFrame(unsigned char* data, unsigned int length, unsigned char seqNo)
+void CDStarRepeaterTRXThread::processNetworkFrame(unsigned char* data)
 {
 	wxASSERT(data != NULL);
-	wxASSERT(length > 0U);
-
-	if (m_rptState != DSRS_NETWORK)
-		return 0U;
-
-	bool end = (seqNo & 0x40U) == 0x40U;
-	if (end) {
-		m_networkQueue[m_writeNum]->addData(END_PATTERN_BYTES, DV_FRAME_LENGTH_BYTES, true);
-		endOfNetworkData();
-		return 1U;
-	}
-
-	// Mask out the control bits of the sequence number
-	seqNo &= 0x1FU;
-
-	// Count the number of silence frames to insert
-	unsigned int tempSeqNo = m_networkSeqNo;
-	unsigned int count = 0U;
-	while (seqNo != tempSeqNo) {
-		count++;
-
-		tempSeqNo++;
-		if (tempSeqNo >= 21U)
-			tempSeqNo = 0U;
-	}
-
-	// If the number is too high, then it probably means an old out-of-order frame, ignore it
-	if (count > 18U)
-		return 0U;
-
-	unsigned int packetCount = 0U;
-
-	// Insert missing frames
-	while (seqNo != m_networkSeqNo) {
-		unsigned char buffer[DV_FRAME_LENGTH_BYTES];
-		if (count > SILENCE_THRESHOLD) {
-			::memcpy(buffer, NULL_FRAME_DATA_BYTES, DV_FRAME_LENGTH_BYTES);
-		} else {
-			::memcpy(buffer, m_lastData, DV_FRAME_LENGTH_BYTES);
-			// Data packets have no AMBE FEC
-			if (!m_rxHeader->isDataPacket())
-				m_ambe.regenerate(buffer);
-			blankDTMF(buffer);
-		}
-
-		if (m_networkSeqNo == 0U)
-			::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
-
-		m_networkQueue[m_writeNum]->addData(buffer, DV_FRAME_LENGTH_BYTES, false);
-
-		packetCount++;
-		m_networkSeqNo++;
-		m_packetSilence++;
-		if (m_networkSeqNo >= 21U)
-			m_networkSeqNo = 0U;
-	}
 
 	// Regenerate the sync bytes
 	if (m_networkSeqNo == 0U) {
@@ -1591,27 +1620,40 @@ unsigned int CDStarRepeaterTRXThread::processNetworkFrame(unsigned char* data, u
 		}
 	}
 
-	packetCount++;
 	m_networkSeqNo++;
 	if (m_networkSeqNo >= 21U)
 		m_networkSeqNo = 0U;
+}
+
+void CDStarRepeaterTRXThread::writeNetworkFrames(unsigned char* frames, unsigned int n)
+{
+	wxASSERT(frames != NULL);
+
+	if (n == 0U)
+		return;
 
 	// Data packets have no AMBE FEC
-	if (!m_rxHeader->isDataPacket())
-		m_ambe.regenerate(data);
+	if (!m_rxHeader.isDataPacket())
+		m_ambe.regenerate(frames, n, DV_FRAME_LENGTH_BYTES, NULL);
 
-	blankDTMF(data);
+	for (unsigned int i = 0U; i < n; i++) {
+		unsigned char* data = frames + i * DV_FRAME_LENGTH_BYTES;
 
-	m_networkQueue[m_writeNum]->addData(data, DV_FRAME_LENGTH_BYTES, false);
+		blankDTMF(data);
 
-	return packetCount;
+		m_networkQueue[m_writeNum]->addData(data, DV_FRAME_LENGTH_BYTES, false);
+	}
 }
 
 void CDStarRepeaterTRXThread::endOfRadioData()
 {
 	switch (m_rptState) {
 		case DSRS_VALID:
-			wxLogMessage(wxT("AMBE for %s  Frames: %.1fs, Silence: %.1f%%, BER: %.1f%%"), m_rxHeader->getMyCall1().c_str(), float(m_ambeFrames) / 50.0F, float(m_ambeSilence * 100U) / float(m_ambeFrames), float(m_ambeErrors * 100U) / float(m_ambeBits));
+			wxLogMessage(wxT("AMBE for %s  Frames: %.1fs, Silence: %.1f%%, BER: %.1f%%"), m_rxHeader.getMyCall1().c_str(), float(m_ambeFrames) / 50.0F, float(m_ambeSilence * 100U) / float(m_ambeFrames), float(m_ambeErrors * 100U) / float(m_ambeBits));
+
+			// For this transmission, from the modem receiving a frame to it being sent to the gateway
+			m_latency.log(wxT("Radio to network latency"));
+			m_latency.reset();
 
 			if (m_tempAckText.IsEmpty()) {
 				if (m_ack == AT_BER) {
@@ -1639,7 +1681,7 @@ void CDStarRepeaterTRXThread::endOfRadioData()
 			break;
 
 		case DSRS_INVALID:
-			wxLogMessage(wxT("AMBE for %s  Frames: %.1fs, Silence: %.1f%%, BER: %.1f%%"), m_rxHeader->getMyCall1().c_str(), float(m_ambeFrames) / 50.0F, float(m_ambeSilence * 100U) / float(m_ambeFrames), float(m_ambeErrors * 100U) / float(m_ambeBits));
+			wxLogMessage(wxT("AMBE for %s  Frames: %.1fs, Silence: %.1f%%, BER: %.1f%%"), m_rxHeader.getMyCall1().c_str(), float(m_ambeFrames) / 50.0F, float(m_ambeSilence * 100U) / float(m_ambeFrames), float(m_ambeErrors * 100U) / float(m_ambeBits));
 
 			if (m_ack != AT_NONE || m_mode == MODE_GATEWAY) {
 				setRepeaterState(DSRS_INVALID_WAIT);
@@ -1650,7 +1692,7 @@ void CDStarRepeaterTRXThread::endOfRadioData()
 			break;
 
 		case DSRS_TIMEOUT:
-			wxLogMessage(wxT("AMBE for %s  Frames: %.1fs, Silence: %.1f%%, BER: %.1f%%"), m_rxHeader->getMyCall1().c_str(), float(m_ambeFrames) / 50.0F, float(m_ambeSilence * 100U) / float(m_ambeFrames), float(m_ambeErrors * 100U) / float(m_ambeBits));
+			wxLogMessage(wxT("AMBE for %s  Frames: %.1fs, Silence: %.1f%%, BER: %.1f%%"), m_rxHeader.getMyCall1().c_str(), float(m_ambeFrames) / 50.0F, float(m_ambeSilence * 100U) / float(m_ambeFrames), float(m_ambeErrors * 100U) / float(m_ambeBits));
 
 			if (m_tempAckText.IsEmpty()) {
 				if (m_ack == AT_BER) {
@@ -1688,7 +1730,7 @@ void CDStarRepeaterTRXThread::endOfNetworkData()
 	if (m_packetCount != 0U)
 		loss = float(m_packetSilence) / float(m_packetCount);
 
-	wxLogMessage(wxT("Stats for %s  Frames: %.1fs, Loss: %.1f%%, Packets: %u/%u"), m_rxHeader->getMyCall1().c_str(), float(m_packetCount) / 50.0F, loss * 100.0F, m_packetSilence, m_packetCount);
+	wxLogMessage(wxT("Stats for %s  Frames: %.1fs, Loss: %.1f%%, Packets: %u/%u, Late: %u, Reordered: %u, Delay: %ums, Jitter: %ums"), m_rxHeader.getMyCall1().c_str(), float(m_packetCount) / 50.0F, loss * 100.0F, m_packetSilence, m_packetCount, m_jitterBuffer.getLate(), m_jitterBuffer.getReordered(), m_jitterBuffer.getDelay(), m_jitterBuffer.getJitter());
 
 	setRepeaterState(DSRS_LISTENING);
 	m_activeHangTimer.start();
@@ -1698,73 +1740,109 @@ void CDStarRepeaterTRXThread::endOfNetworkData()
 		m_writeNum = 0U;
 }
 
-CDStarRepeaterStatusData* CDStarRepeaterTRXThread::getStatus()
+bool CDStarRepeaterTRXThread::getStatus(CDStarRepeaterStatusData& status) const
 {
-	CDStarRepeaterStatusData* status;
-	if (m_rptState == DSRS_SHUTDOWN || m_rptState == DSRS_LISTENING) {
-		status = new CDStarRepeaterStatusData(wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString,
-					wxEmptyString, 0x00, 0x00, 0x00, m_tx, m_rxState, m_rptState, m_timeoutTimer.getTimer(),
-					m_timeoutTimer.getTimeout(), m_beaconTimer.getTimer(), m_beaconTimer.getTimeout(), 0.0F,
-					m_announcementTimer.getTimer(), m_announcementTimer.getTimeout(), m_ackText, m_statusText[0],
-					m_statusText[1], m_statusText[2], m_statusText[3], m_statusText[4]);
-	} else if (m_rptState == DSRS_NETWORK) {
-		float loss = 0.0F;
-		if (m_packetCount != 0U)
-			loss = float(m_packetSilence) / float(m_packetCount);
+	return m_statusLock.read(status);
+}
 
-		status = new CDStarRepeaterStatusData(m_rxHeader->getMyCall1(), m_rxHeader->getMyCall2(),
-					m_rxHeader->getYourCall(), m_rxHeader->getRptCall1(), m_rxHeader->getRptCall2(),
-					m_rxHeader->getFlag1(), m_rxHeader->getFlag2(), m_rxHeader->getFlag3(), m_tx, m_rxState,
-					m_rptState, m_timeoutTimer.getTimer(), m_timeoutTimer.getTimeout(), m_beaconTimer.getTimer(),
-					m_beaconTimer.getTimeout(), m_announcementTimer.getTimer(), m_announcementTimer.getTimeout(),
-					loss * 100.0F, m_ackText, m_statusText[0], m_statusText[1], m_statusText[2], m_statusText[3], m_statusText[4]);
-	} else {
+void CDStarRepeaterTRXThread::clock(unsigned int ms)
+{
+	m_wheel.clock(ms);
+	m_jitterBuffer.clock(ms);
+
+	if (m_beacon != NULL)
+		m_beacon->clock();
+	if (m_announcement != NULL)
+		m_announcement->clock();
+}
+
+// Sleep until the next timer or network frame is due. The modem only signals when it has received
+// something, so while there is anything to send to it, it is checked every cycle.
+unsigned int CDStarRepeaterTRXThread::getTimeout()
+{
+	unsigned int timeout = m_wheel.getNext(MAX_WAIT_TIME);
+
+	if (m_rptState == DSRS_NETWORK) {
+		unsigned int next = m_jitterBuffer.getNext();
+		if (next < timeout)
+			timeout = next;
+	}
+
+	bool busy = m_radioQueue.headerReady() || m_radioQueue.dataReady() ||
+				m_localQueue.headerReady() || m_localQueue.dataReady() ||
+				m_networkQueue[m_readNum]->headerReady() || m_networkQueue[m_readNum]->dataReady() ||
+				(m_beacon != NULL && m_beacon->isSending()) ||
+				(m_announcement != NULL && m_announcement->isSending());
+
+	if (busy && timeout > CYCLE_TIME)
+		timeout = CYCLE_TIME;
+
+	return timeout;
+}
+
+// Called once per pass of the main loop, the readers only ever see what is published here
+void CDStarRepeaterTRXThread::publishStatus()
+{
+	// The BER covers a fixed window so that it does not depend on how often the status is read
+	if (m_berTimer.hasExpired()) {
 		float   bits = float(m_ambeBits - m_lastAMBEBits);
 		float errors = float(m_ambeErrors - m_lastAMBEErrors);
 		if (bits == 0.0F)
 			bits = 1.0F;
 
+		m_ber = (errors * 100.0F) / bits;
+
 		m_lastAMBEBits   = m_ambeBits;
 		m_lastAMBEErrors = m_ambeErrors;
 
-		status = new CDStarRepeaterStatusData(m_rxHeader->getMyCall1(), m_rxHeader->getMyCall2(),
-					m_rxHeader->getYourCall(), m_rxHeader->getRptCall1(), m_rxHeader->getRptCall2(),
-					m_rxHeader->getFlag1(), m_rxHeader->getFlag2(), m_rxHeader->getFlag3(), m_tx, m_rxState,
-					m_rptState, m_timeoutTimer.getTimer(), m_timeoutTimer.getTimeout(), m_beaconTimer.getTimer(),
-					m_beaconTimer.getTimeout(), m_announcementTimer.getTimer(), m_announcementTimer.getTimeout(),
-					(errors * 100.0F) / bits, m_ackText, m_statusText[0], m_statusText[1], m_statusText[2], m_statusText[3],
-					m_statusText[4]);
+		m_berTimer.start();
+	}
+
+	if (m_rptState == DSRS_SHUTDOWN || m_rptState == DSRS_LISTENING) {
+		m_statusData.clearHeader();
+		m_statusData.setPercent(0.0F);
+	} else if (m_rptState == DSRS_NETWORK) {
+		float loss = 0.0F;
+		if (m_packetCount != 0U)
+			loss = float(m_packetSilence) / float(m_packetCount);
+
+		m_statusData.setHeader(m_rxHeader);
+		m_statusData.setPercent(loss * 100.0F);
+	} else {
+		m_statusData.setHeader(m_rxHeader);
+		m_statusData.setPercent(m_ber);
 	}
 
+	m_statusData.setState(m_tx, m_rxState, m_rptState);
+	m_statusData.setTimeout(m_timeoutTimer.getTimer(), m_timeoutTimer.getTimeout());
+	m_statusData.setBeacon(m_beaconTimer.getTimer(), m_beaconTimer.getTimeout());
+	m_statusData.setAnnounce(m_announcementTimer.getTimer(), m_announcementTimer.getTimeout());
+
 	if (m_type.IsSameAs(wxT("DVAP")) && m_modem != NULL) {
 		CDVAPController* dvap = static_cast<CDVAPController*>(m_modem);
 		bool squelch = dvap->getSquelch();
 		int signal   = dvap->getSignal();
-		status->setDVAP(squelch, signal);
+		m_statusData.setDVAP(squelch, signal);
 	}
 
-	return status;
+	m_statusLock.write(m_statusData);
 }
 
-void CDStarRepeaterTRXThread::clock(unsigned int ms)
+void CDStarRepeaterTRXThread::trace(TRACE_EVENT event, unsigned int arg1, unsigned int arg2, unsigned int arg3)
 {
-	m_pollTimer.clock(ms);
-	m_timeoutTimer.clock(ms);
-	m_watchdogTimer.clock(ms);
-	m_activeHangTimer.clock(ms);
-	m_ackTimer.clock(ms);
+	if (m_trace != NULL)
+		m_trace->write(event, arg1, arg2, arg3);
+}
 
-	for(int i = 0; i < 5; ++i)
-		m_statusAnnounceTimer[i].clock(ms);
+// Only changes are traced, otherwise an idle repeater would soon fill the ring
+void CDStarRepeaterTRXThread::traceQueue(TRACE_QUEUE queue, unsigned int bytes)
+{
+	if (m_trace == NULL || m_traceQueues[queue] == bytes)
+		return;
 
-	m_beaconTimer.clock(ms);
-	m_announcementTimer.clock(ms);
-	m_statusTimer.clock(ms);
-	m_heartbeatTimer.clock(ms);
-	if (m_beacon != NULL)
-		m_beacon->clock();
-	if (m_announcement != NULL)
-		m_announcement->clock();
+	m_traceQueues[queue] = bytes;
+
+	m_trace->write(TE_QUEUE, queue, 0U, bytes);
 }
 
 void CDStarRepeaterTRXThread::shutdown()
@@ -1782,13 +1860,14 @@ bool CDStarRepeaterTRXThread::checkControl(const CHeaderData& header)
 	if (!m_controlEnabled)
 		return false;
 
-	if (!m_controlRPT1.IsSameAs(header.getRptCall1()) || !m_controlRPT2.IsSameAs(header.getRptCall2()))
+	if (!header.isRptCall1(m_controlRPT1) || !header.isRptCall2(m_controlRPT2))
 		return false;
 
 	for (size_t i = 0; i < m_controlCommand.GetCount(); ++i) {
-		if (m_controlCommand[i].IsSameAs(header.getYourCall())) {
+		if (header.isYourCall(m_controlCommand[i])) {
 			wxThreadEvent evt(wxEVT_THREAD, wxEVT_THREAD_COMMAND);
 			evt.SetInt(i);
+			evt.SetString(m_name);
 			wxTheApp->QueueEvent(evt.Clone());
 			wxLogMessage("Command %d requested by %s/%s", i, header.getMyCall1().c_str(), header.getMyCall2().c_str());
 			return true;
@@ -1796,7 +1875,7 @@ bool CDStarRepeaterTRXThread::checkControl(const CHeaderData& header)
 	}
 
 	for (size_t i = 0; i < m_controlStatus.GetCount(); ++i) {
-		if (m_controlStatus[i].IsSameAs(header.getYourCall())) {
+		if (header.isYourCall(m_controlStatus[i])) {
 			wxLogMessage(wxT("Status %d requested by %s/%s"),
 				i, header.getMyCall1().c_str(),
 				header.getMyCall2().c_str());
@@ -1806,7 +1885,7 @@ bool CDStarRepeaterTRXThread::checkControl(const CHeaderData& header)
 	}
 
 	for (size_t i = 0; i < m_controlOutput.GetCount(); ++i) {
-		if (m_controlOutput[i].IsSameAs(header.getYourCall())) {
+		if (header.isYourCall(m_controlOutput[i])) {
 			wxLogMessage(wxT("Output %d requested by %s/%s"), i,
 				header.getMyCall1().c_str(),
 				header.getMyCall2().c_str());
@@ -1821,10 +1900,10 @@ bool CDStarRepeaterTRXThread::checkControl(const CHeaderData& header)
 		}
 	}
 
-	if (m_controlShutdown.IsSameAs(header.getYourCall())) {
+	if (header.isYourCall(m_controlShutdown)) {
 		wxLogMessage(wxT("Shutdown requested by %s/%s"), header.getMyCall1().c_str(), header.getMyCall2().c_str());
 		shutdown();
-	} else if (m_controlStartup.IsSameAs(header.getYourCall())) {
+	} else if (header.isYourCall(m_controlStartup)) {
 		wxLogMessage(wxT("Startup requested by %s/%s"), header.getMyCall1().c_str(), header.getMyCall2().c_str());
 		startup();
 	} else {
@@ -1839,14 +1918,14 @@ bool CDStarRepeaterTRXThread::checkAnnouncements(const CHeaderData& header)
 	if (m_announcement == NULL)
 		return false;
 
-	if (m_recordRPT1.IsSameAs(header.getRptCall1()) && m_recordRPT2.IsSameAs(header.getRptCall2())) {
+	if (header.isRptCall1(m_recordRPT1) && header.isRptCall2(m_recordRPT2)) {
 		wxLogMessage(wxT("Announcement creation requested by %s/%s"), header.getMyCall1().c_str(), header.getMyCall2().c_str());
 		m_announcement->writeHeader(header);
 		m_recording = true;
 		return true;
 	}
 
-	if (m_deleteRPT1.IsSameAs(header.getRptCall1()) && m_deleteRPT2.IsSameAs(header.getRptCall2())) {
+	if (header.isRptCall1(m_deleteRPT1) && header.isRptCall2(m_deleteRPT2)) {
 		wxLogMessage(wxT("Announcement deletion requested by %s/%s"), header.getMyCall1().c_str(), header.getMyCall2().c_str());
 		m_announcement->deleteAnnouncement();
 		m_deleting = true;
@@ -1880,60 +1959,61 @@ TRISTATE CDStarRepeaterTRXThread::checkHeader(CHeaderData& header)
 			return STATE_UNKNOWN;
 
 		// As a second check, reject on own UR call
-		wxString ur = header.getYourCall();
-		if (ur.IsSameAs(m_rptCallsign) || ur.IsSameAs(m_gwyCallsign))
+		if (header.isYourCall(m_rptCallsign) || header.isYourCall(m_gwyCallsign))
 			return STATE_UNKNOWN;
 
 		// Change RPT2 to be the gateway callsign in gateway mode
 		header.setRptCall2(m_gwyCallsign);
 	}
 
-	wxString my = header.getMyCall1();
+	unsigned char my[LONG_CALLSIGN_LENGTH];
+	header.getMyCall1(my);
 
 	// Make sure MyCall is not empty, a silly value, or the repeater or gateway callsigns, STN* is a special case
-	if (!my.Left(3U).IsSameAs(wxT("STN"))) {
-		if (my.IsSameAs(m_rptCallsign) ||
-			my.IsSameAs(m_gwyCallsign) ||
-			my.IsSameAs(wxT("        ")) ||
-			my.Left(6U).IsSameAs(wxT("NOCALL")) ||
-			my.Left(6U).IsSameAs(wxT("N0CALL")) ||
-			my.Left(6U).IsSameAs(wxT("MYCALL"))) {
-			wxLogMessage(wxT("Invalid MYCALL value of %s, ignoring"), my.c_str());
+	if (!header.isMyCall1(wxT("STN"), 3U)) {
+		if (header.isMyCall1(m_rptCallsign) ||
+			header.isMyCall1(m_gwyCallsign) ||
+			header.isMyCall1(BLANK_CALLSIGN) ||
+			header.isMyCall1(wxT("NOCALL"), 6U) ||
+			header.isMyCall1(wxT("N0CALL"), 6U) ||
+			header.isMyCall1(wxT("MYCALL"), 6U)) {
+			wxLogMessage(wxT("Invalid MYCALL value of %s, ignoring"), header.getMyCall1().c_str());
 			return STATE_UNKNOWN;
 		}
 	}
 
 	// Check for a French class 3 novice callsign, and reject
 	// Of the form F0xxx
-	if (my.Left(2U).IsSameAs(wxT("F0"))) {
-		wxLogMessage(wxT("French novice class licence callsign found, %s, ignoring"), my.c_str());
+	if (header.isMyCall1(wxT("F0"), 2U)) {
+		wxLogMessage(wxT("French novice class licence callsign found, %s, ignoring"), header.getMyCall1().c_str());
 		return STATE_UNKNOWN;
 	}
 
 	// Check for an Australian foundation class licence callsign, and reject
 	// Of the form VKnFxxx
-	if (my.Left(2U).IsSameAs(wxT("VK")) && my.GetChar(3U) == wxT('F') && my.GetChar(6U) != wxT(' ')) {
-		wxLogMessage(wxT("Australian foundation class licence callsign found, %s, ignoring"), my.c_str());
+	if (header.isMyCall1(wxT("VK"), 2U) && my[3U] == 'F' && my[6U] != ' ') {
+		wxLogMessage(wxT("Australian foundation class licence callsign found, %s, ignoring"), header.getMyCall1().c_str());
 		return STATE_UNKNOWN;
 	}
 
-	// Check the MyCall value against the regular expression
-	bool ok = m_regEx.Matches(my);
+	// Check the MyCall value against the regular expression, the only check that needs a string
+	wxString myCall1 = header.getMyCall1();
+	bool ok = m_regEx.Matches(myCall1);
 	if (!ok) {
-		wxLogMessage(wxT("Invalid MYCALL value of %s, ignoring"), my.c_str());
+		wxLogMessage(wxT("Invalid MYCALL value of %s, ignoring"), myCall1.c_str());
 		return STATE_UNKNOWN;
 	}
 
 	// Is it for us?
-	if (!header.getRptCall1().IsSameAs(m_rptCallsign)) {
+	if (!header.isRptCall1(m_rptCallsign)) {
 		wxLogMessage(wxT("Invalid RPT1 value %s, ignoring"), header.getRptCall1().c_str());
 		return STATE_FALSE;
 	}
 
 	// If using callsign restriction, validate the my callsign
 	if (m_restriction) {
-		if (!my.Left(LONG_CALLSIGN_LENGTH - 1U).IsSameAs(m_rptCallsign.Left(LONG_CALLSIGN_LENGTH - 1U))) {
-			wxLogMessage(wxT("Unauthorised user %s tried to access the repeater"), my.c_str());
+		if (!header.isMyCall1(m_rptCallsign.wx_str(), LONG_CALLSIGN_LENGTH - 1U)) {
+			wxLogMessage(wxT("Unauthorised user %s tried to access the repeater"), myCall1.c_str());
 			return STATE_UNKNOWN;
 		}
 	}
@@ -26,14 +26,20 @@
 #include "DStarRepeaterDefs.h"
 #include "DVTOOLFileWriter.h"
 #include "AnnouncementUnit.h"
+#include "LatencyHistogram.h"
 #include "SlowDataDecoder.h"
 #include "SlowDataEncoder.h"
 #include "BeaconCallback.h"
+#include "AMBEConcealer.h"
 #include "CallsignList.h"
+#include "JitterBuffer.h"
+#include "EventPoller.h"
+#include "EventTrace.h"
 #include "OutputQueue.h"
 #include "BeaconUnit.h"
 #include "HeaderData.h"
 #include "AMBEFEC.h"
+#include "SeqLock.h"
 #include "Timer.h"
 #include "Utils.h"
 
@@ -50,6 +56,7 @@ public:
 	virtual void setModem(CModem* modem);
 	virtual void setController(CExternalController* controller, unsigned int activeHangTime);
 	virtual void setTimes(unsigned int timeout, unsigned int ackTime);
+	virtual void setConcealment(unsigned int frames);
 	virtual void setBeacon(unsigned int time, const wxString& text, bool voice, TEXT_LANG language);
 	virtual void setAnnouncement(bool enabled, unsigned int time, const wxString& recordRPT1, const wxString& recordRPT2, const wxString& deleteRPT1, const wxString& deleteRPT2);
 
@@ -61,14 +68,17 @@ public:
 
 	virtual void setOutputs(bool out1, bool out2, bool out3, bool out4);
 	virtual void setLogging(bool logging, const wxString& dir);
+	virtual CAnnouncementUnit* getAnnouncement() const;
+
 	virtual void setWhiteList(CCallsignList* list);
 	virtual void setBlackList(CCallsignList* list);
 	virtual void setGreyList(CCallsignList* list);
+	virtual void setTrace(CEventTrace* trace);
 
 	virtual void shutdown();
 	virtual void startup();
 
-	virtual CDStarRepeaterStatusData* getStatus();
+	virtual bool getStatus(CDStarRepeaterStatusData& status) const;
 
 	virtual void *Entry();
 
@@ -77,7 +87,7 @@ public:
 	virtual void transmitBeaconHeader();
 	virtual void transmitBeaconData(const unsigned char* data, unsigned int length, bool end);
 
-	virtual void transmitAnnouncementHeader(CHeaderData* header);
+	virtual void transmitAnnouncementHeader(const CHeaderData& header);
 	virtual void transmitAnnouncementData(const unsigned char* data, unsigned int length, bool end);
 
 private:
@@ -94,15 +104,18 @@ private:
 	wxString                   m_recordRPT2;
 	wxString                   m_deleteRPT1;
 	wxString                   m_deleteRPT2;
-	CHeaderData*               m_rxHeader;
+	CHeaderData                m_rxHeader;
 	COutputQueue               m_localQueue;
 	COutputQueue               m_radioQueue;
 	COutputQueue**             m_networkQueue;
 	unsigned int               m_writeNum;
 	unsigned int               m_readNum;
+	CJitterBuffer              m_jitterBuffer;
+	CAMBEConcealer             m_concealer;
 	unsigned char              m_radioSeqNo;
 	unsigned char              m_networkSeqNo;
 	unsigned char              m_lastSlowDataType;
+	CTimerWheel                m_wheel;
 	CTimer                     m_timeoutTimer;
 	CTimer                     m_watchdogTimer;
 	CTimer                     m_pollTimer;
@@ -114,6 +127,7 @@ private:
 	CTimer                     m_announcementTimer;
 
 	CTimer                     m_statusTimer;
+	CTimer                     m_berTimer;
 
 	CTimer                     m_heartbeatTimer;
 	DSTAR_RPT_STATE            m_rptState;
@@ -158,7 +172,6 @@ private:
 	bool                       m_shutdown;
 	bool                       m_disable;
 	CDVTOOLFileWriter*         m_logging;
-	unsigned char*             m_lastData;
 	CAMBEFEC                   m_ambe;
 	unsigned int               m_ambeFrames;
 	unsigned int               m_ambeSilence;
@@ -166,14 +179,13 @@ private:
 	unsigned int               m_ambeErrors;
 	unsigned int               m_lastAMBEBits;
 	unsigned int               m_lastAMBEErrors;
+	float                      m_ber;
 	wxString                   m_ackText;
 	wxString                   m_tempAckText;
 	LINK_STATUS                m_linkStatus;
 	wxString                   m_reflector;
 
 	wxRegEx                    m_regEx;
-	wxStopWatch                m_headerTime;
-	wxStopWatch                m_packetTime;
 	unsigned int               m_packetCount;
 	unsigned int               m_packetSilence;
 	CCallsignList*             m_whiteList;
@@ -184,13 +196,19 @@ private:
 	bool                       m_blanking;
 	bool                       m_recording;
 	bool                       m_deleting;
-
-	void receiveHeader(CHeaderData* header);
+	CEventPoller               m_poller;
+	CLatencyHistogram          m_latency;
+	CDStarRepeaterStatusData   m_statusData;
+	CSeqLock<CDStarRepeaterStatusData> m_statusLock;
+	CEventTrace*               m_trace;
+	unsigned int               m_traceQueues[TQ_NETWORK + 1U];
+
+	void receiveHeader(CHeaderData& header);
 	void receiveRadioData(unsigned char* data, unsigned int length);
 	void receiveSlowData(unsigned char* data, unsigned int length);
-	void transmitRadioHeader(CHeaderData* header);
-	void transmitLocalHeader(CHeaderData* header);
-	void transmitNetworkHeader(CHeaderData* header);
+	void transmitRadioHeader(const CHeaderData& header);
+	void transmitLocalHeader(const CHeaderData& header);
+	void transmitNetworkHeader(const CHeaderData& header);
 	void transmitStatus();
 	void transmitErrorStatus();
 	void transmitUserStatus(unsigned int n);
@@ -204,10 +222,12 @@ private:
 	void repeaterStateMachine();
 	void receiveModem();
 	void receiveNetwork();
-	bool processRadioHeader(CHeaderData* header);
-	void processNetworkHeader(CHeaderData* header);
+	void playoutNetwork();
+	bool processRadioHeader(CHeaderData& header);
+	void processNetworkHeader(const CHeaderData& header);
 	void processRadioFrame(unsigned char* data, FRAME_TYPE type);
-	unsigned int processNetworkFrame(unsigned char* data, unsigned int length, unsigned char seqNo);
+	void processNetworkFrame(unsigned char* data);
+	void writeNetworkFrames(unsigned char* frames, unsigned int n);
 	void endOfRadioData();
 	void endOfNetworkData();
 	void setRadioState(DSTAR_RX_STATE state);
@@ -217,6 +237,10 @@ private:
 	TRISTATE checkHeader(CHeaderData& header);
 	unsigned int countBits(unsigned char byte);
 	void clock(unsigned int ms);
+	unsigned int getTimeout();
+	void publishStatus();
+	void trace(TRACE_EVENT event, unsigned int arg1 = 0U, unsigned int arg2 = 0U, unsigned int arg3 = 0U);
+	void traceQueue(TRACE_QUEUE queue, unsigned int bytes);
 	void blankDTMF(unsigned char* data);
 };
 
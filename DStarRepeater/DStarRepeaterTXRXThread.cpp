@@ -31,27 +31,37 @@ const unsigned int MAX_DATA_SYNC_BIT_ERRS  = 2U;
 
 const unsigned int NETWORK_QUEUE_COUNT = 2U;
 
-const unsigned int SILENCE_THRESHOLD = 2U;
+// The limits of the network playout delay in ms
+const unsigned int NETWORK_MIN_DELAY = 40U;
+const unsigned int NETWORK_MAX_DELAY = 300U;
 
+// While anything is waiting for the modem the thread wakes at least this often
 const unsigned int CYCLE_TIME = 9U;
 
+// The longest sleep when no timer is due before then
+const unsigned int MAX_WAIT_TIME = 1000U;
+
 CDStarRepeaterTXRXThread::CDStarRepeaterTXRXThread(const wxString& type) :
 m_type(type),
 m_modem(NULL),
 m_protocolHandler(NULL),
 m_controller(NULL),
 m_rptCallsign(),
-m_rxHeader(NULL),
-m_txHeader(NULL),
+m_rxHeader(),
+m_txHeader(),
 m_networkQueue(NULL),
 m_writeNum(0U),
 m_readNum(0U),
+m_jitterBuffer(NETWORK_MIN_DELAY, NETWORK_MAX_DELAY),
+m_concealer(0U),
 m_radioSeqNo(0U),
 m_networkSeqNo(0U),
-m_watchdogTimer(1000U, NETWORK_TIMEOUT),
-m_registerTimer(1000U),
-m_statusTimer(1000U, 0U, 100U),		// 100ms
-m_heartbeatTimer(1000U, 1U),		// 1s
+m_wheel(),
+m_watchdogTimer(m_wheel, NETWORK_TIMEOUT),
+m_registerTimer(m_wheel),
+m_statusTimer(m_wheel, 0U, 100U),		// 100ms
+m_berTimer(m_wheel, 1U),			// 1s
+m_heartbeatTimer(m_wheel, 1U),		// 1s
 m_rptState(DSRS_LISTENING),
 m_rxState(DSRXS_LISTENING),
 m_slowDataDecoder(),
@@ -59,9 +69,8 @@ m_tx(false),
 m_transmitting(false),
 m_space(0U),
 m_killed(false),
-m_activeHangTimer(1000U),
+m_activeHangTimer(m_wheel),
 m_disable(false),
-m_lastData(NULL),
 m_ambe(),
 m_ambeFrames(0U),
 m_ambeSilence(0U),
@@ -69,17 +78,17 @@ m_ambeBits(1U),
 m_ambeErrors(0U),
 m_lastAMBEBits(0U),
 m_lastAMBEErrors(0U),
-m_headerTime(),
-m_packetTime(),
+m_ber(0.0F),
 m_packetCount(0U),
-m_packetSilence(0U)
+m_packetSilence(0U),
+m_poller(),
+m_statusData(),
+m_statusLock()
 {
 	m_networkQueue = new COutputQueue*[NETWORK_QUEUE_COUNT];
 	for (unsigned int i = 0U; i < NETWORK_QUEUE_COUNT; i++)
 		m_networkQueue[i] = new COutputQueue((DV_FRAME_LENGTH_BYTES + 2U) * 200U, NETWORK_RUN_FRAME_COUNT);		// 4s worth of data);
 
-	m_lastData = new unsigned char[DV_FRAME_MAX_LENGTH_BYTES];
-
 	setRepeaterState(DSRS_LISTENING);
 	setRadioState(DSRXS_LISTENING);
 }
@@ -89,13 +98,12 @@ CDStarRepeaterTXRXThread::~CDStarRepeaterTXRXThread()
 	for (unsigned int i = 0U; i < NETWORK_QUEUE_COUNT; i++)
 		delete m_networkQueue[i];
 	delete[] m_networkQueue;
-	delete[] m_lastData;
-	delete   m_rxHeader;
-	delete   m_txHeader;
 }
 
 void *CDStarRepeaterTXRXThread::Entry()
 {
+	startLog();
+
 	// Wait here until we have the essentials to run
 	while (!m_killed && (m_modem == NULL  || m_controller == NULL || m_protocolHandler == NULL || m_rptCallsign.IsEmpty() || m_rptCallsign.IsSameAs(wxT("        "))))
 		::wxMilliSleep(500UL);		// 1/2 sec
@@ -108,6 +116,7 @@ void *CDStarRepeaterTXRXThread::Entry()
 
 	m_heartbeatTimer.start();
 	m_statusTimer.start();
+	m_berTimer.start();
 	m_registerTimer.start(10U);
 
 	wxString hardware = m_type;
@@ -115,14 +124,19 @@ void *CDStarRepeaterTXRXThread::Entry()
 	if (n != wxNOT_FOUND)
 		hardware = m_type.Left(n);
 
+	// Wake as soon as the modem has data or a packet arrives, or the next timer is due
+	bool ret = m_poller.open();
+	if (ret) {
+		m_modem->setPoller(&m_poller);
+		m_poller.addReader(m_protocolHandler->getFD());
+	}
+
 	wxLogMessage(wxT("Starting the D-Star transmitter and receiver thread"));
 
-	wxStopWatch stopWatch;
+	wxUint64 lastTime = CUtils::getTimestamp();
 
 	try {
 		while (!m_killed) {
-			stopWatch.Start();
-
 			if (m_statusTimer.hasExpired() || m_space == 0U) {
 				m_space = m_modem->getSpace();
 				m_tx    = m_modem->isTX();
@@ -133,6 +147,8 @@ void *CDStarRepeaterTXRXThread::Entry()
 
 			receiveNetwork();
 
+			playoutNetwork();
+
 			repeaterStateMachine();
 
 			// Send the register packet if needed and restart the timer
@@ -185,12 +201,19 @@ void *CDStarRepeaterTXRXThread::Entry()
 
 			m_controller->setRadioTransmit(m_tx);
 
-			unsigned long ms = stopWatch.Time();
-			if (ms < CYCLE_TIME) {
-				::wxMilliSleep(CYCLE_TIME - ms);
-				clock(CYCLE_TIME);
-			} else {
+			publishStatus();
+
+			unsigned int timeout = getTimeout();
+			if (ret)
+				m_poller.wait(timeout);
+			else
+				::wxMilliSleep(timeout);
+
+			// Only whole milliseconds are clocked, the remainder is carried over to the next pass
+			unsigned int ms = (unsigned int)((CUtils::getTimestamp() - lastTime) / 1000U);
+			if (ms > 0U) {
 				clock(ms);
+				lastTime += ms * 1000U;
 			}
 		}
 	}
@@ -204,8 +227,11 @@ void *CDStarRepeaterTXRXThread::Entry()
 
 	wxLogMessage(wxT("Stopping the D-Star transmitter and receiver thread"));
 
+	m_modem->setPoller(NULL);
 	m_modem->stop();
 
+	m_poller.close();
+
 	m_controller->setActive(false);
 	m_controller->setRadioTransmit(false);
 	m_controller->close();
@@ -220,6 +246,8 @@ void *CDStarRepeaterTXRXThread::Entry()
 void CDStarRepeaterTXRXThread::kill()
 {
 	m_killed = true;
+
+	m_poller.signal();
 }
 
 void CDStarRepeaterTXRXThread::setCallsign(const wxString& callsign, const wxString&, DSTAR_MODE, ACK_TYPE, bool, bool, bool, bool)
@@ -254,6 +282,11 @@ void CDStarRepeaterTXRXThread::setTimes(unsigned int, unsigned int)
 {
 }
 
+void CDStarRepeaterTXRXThread::setConcealment(unsigned int frames)
+{
+	m_concealer.setFadeFrames(frames);
+}
+
 void CDStarRepeaterTXRXThread::setBeacon(unsigned int, const wxString&, bool, TEXT_LANG)
 {
 }
@@ -290,6 +323,11 @@ void CDStarRepeaterTXRXThread::setGreyList(CCallsignList*)
 {
 }
 
+void CDStarRepeaterTXRXThread::setTrace(CEventTrace* trace)
+{
+	delete trace;
+}
+
 void CDStarRepeaterTXRXThread::receiveModem()
 {
 	for (;;) {
@@ -300,8 +338,9 @@ void CDStarRepeaterTXRXThread::receiveModem()
 		switch (m_rxState) {
 			case DSRXS_LISTENING:
 				if (type == DSMTT_HEADER) {
-					CHeaderData* header = m_modem->readHeader();
-					receiveHeader(header);
+					CHeaderData header;
+					if (m_modem->readHeader(header))
+						receiveHeader(header);
 				} else if (type == DSMTT_DATA) {
 					unsigned char data[20U];
 					unsigned int length = m_modem->readData(data, 20U);
@@ -337,11 +376,9 @@ void CDStarRepeaterTXRXThread::receiveModem()
 	}
 }
 
-void CDStarRepeaterTXRXThread::receiveHeader(CHeaderData* header)
+void CDStarRepeaterTXRXThread::receiveHeader(const CHeaderData& header)
 {
-	wxASSERT(header != NULL);
-
-	wxLogMessage(wxT("Radio header decoded - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str(), header->getFlag1(), header->getFlag2(), header->getFlag3());
+	wxLogMessage(wxT("Radio header decoded - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header.getMyCall1().c_str(), header.getMyCall2().c_str(), header.getYourCall().c_str(), header.getRptCall1().c_str(), header.getRptCall2().c_str(), header.getFlag1(), header.getFlag2(), header.getFlag3());
 
 	bool res = processRadioHeader(header);
 	if (res) {
@@ -374,21 +411,19 @@ void CDStarRepeaterTXRXThread::receiveSlowData(unsigned char* data, unsigned int
 		m_radioSeqNo++;
 		m_slowDataDecoder.addData(data + VOICE_FRAME_LENGTH_BYTES);
 
-		CHeaderData* header = m_slowDataDecoder.getHeaderData();
-		if (header == NULL)
+		CHeaderData header;
+		if (!m_slowDataDecoder.getHeaderData(header))
 			return;
 
-		wxLogMessage(wxT("Radio header from slow data - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X  BER: 0%%"), header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str(), header->getFlag1(), header->getFlag2(), header->getFlag3());
+		wxLogMessage(wxT("Radio header from slow data - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X  BER: 0%%"), header.getMyCall1().c_str(), header.getMyCall2().c_str(), header.getYourCall().c_str(), header.getRptCall1().c_str(), header.getRptCall2().c_str(), header.getFlag1(), header.getFlag2(), header.getFlag3());
 
-		if (header != NULL) {
-			bool res = processRadioHeader(header);
-			if (res) {
-				// A valid header and is a DV packet, go to normal data relaying
-				setRadioState(DSRXS_PROCESS_DATA);
-			} else {
-				// This is a DD packet or some other problem
-				// wxLogMessage(wxT("Invalid header"));
-			}
+		bool res = processRadioHeader(header);
+		if (res) {
+			// A valid header and is a DV packet, go to normal data relaying
+			setRadioState(DSRXS_PROCESS_DATA);
+		} else {
+			// This is a DD packet or some other problem
+			// wxLogMessage(wxT("Invalid header"));
 		}
 	}
 }
@@ -426,14 +461,12 @@ void CDStarRepeaterTXRXThread::receiveNetwork()
 		if (type == NETWORK_NONE) {					// Nothing received
 			break;
 		} else if (type == NETWORK_HEADER) {		// A header
-			CHeaderData* header = m_protocolHandler->readHeader();
-			if (header != NULL) {
-				::memcpy(m_lastData, NULL_FRAME_DATA_BYTES, DV_FRAME_LENGTH_BYTES);
+			CHeaderData header;
+			if (m_protocolHandler->readHeader(header)) {
+				m_concealer.reset();
 
 				processNetworkHeader(header);
 
-				m_headerTime.Start();
-				m_packetTime.Start();
 				m_packetCount   = 0U;
 				m_packetSilence = 0U;
 			}
@@ -444,38 +477,54 @@ void CDStarRepeaterTXRXThread::receiveNetwork()
 			unsigned char seqNo;
 			unsigned int length = m_protocolHandler->readData(data, DV_FRAME_MAX_LENGTH_BYTES, seqNo);
 			if (length != 0U && m_transmitting) {
-				::memcpy(m_lastData, data, length);
 				m_watchdogTimer.start();
-				m_packetCount += processNetworkFrame(data, length, seqNo);
+
+				// Mask out the control bits of the sequence number
+				m_jitterBuffer.write(seqNo & 0x1FU, (seqNo & 0x40U) == 0x40U, data, length);
 			}
 		}
 	}
+}
 
-	// Have we missed any data frames?
-	if (m_transmitting && m_packetTime.Time() > 200L) {
-		unsigned int packetsNeeded = m_headerTime.Time() / DSTAR_FRAME_TIME_MS;
-
-		// wxLogMessage(wxT("Time: %u ms, need %u packets and received %u packets"), ms - m_headerMS, packetsNeeded, m_packetCount);
+void CDStarRepeaterTXRXThread::playoutNetwork()
+{
+	if (!m_transmitting)
+		return;
 
-		if (packetsNeeded > m_packetCount) {
-			unsigned int count = packetsNeeded - m_packetCount;
+	// The frames that have come due since the last pass have their FEC regenerated together
+	unsigned char frames[JITTER_SLOTS * DV_FRAME_LENGTH_BYTES];
+	unsigned int n = 0U;
 
-			if (count > 5U) {
-				count -= 2U;
+	for (;;) {
+		unsigned char* data = frames + n * DV_FRAME_LENGTH_BYTES;
+		JITTER_FRAME type = m_jitterBuffer.read(data);
 
-				// wxLogMessage(wxT("Inserting %u silence frames into the network data stream"), count);
+		if (type == JF_NONE) {
+			writeNetworkFrames(frames, n);
+			return;
+		} else if (type == JF_END) {
+			writeNetworkFrames(frames, n);
+			m_networkQueue[m_writeNum]->addData(END_PATTERN_BYTES, DV_FRAME_LENGTH_BYTES, true);
+			endOfNetworkData();
+			return;
+		} else if (type == JF_MISSING) {
+			// The voice fades out from the last good frame, the slow data is the null filler
+			::memcpy(data, NULL_FRAME_DATA_BYTES, DV_FRAME_LENGTH_BYTES);
+			m_concealer.conceal(data);
 
-				// Create silence frames
-				for (unsigned int i = 0U; i < count; i++) {
-					unsigned char data[DV_FRAME_LENGTH_BYTES];
-					::memcpy(data, NULL_FRAME_DATA_BYTES, DV_FRAME_LENGTH_BYTES);
-					m_packetCount += processNetworkFrame(data, DV_FRAME_LENGTH_BYTES, m_networkSeqNo);
-					m_packetSilence++;
-				}
-			}
+			m_packetSilence++;
+		} else {
+			m_concealer.good(data);
 		}
 
-		m_packetTime.Start();
+		processNetworkFrame(data);
+		m_packetCount++;
+
+		n++;
+		if (n == JITTER_SLOTS) {
+			writeNetworkFrames(frames, n);
+			n = 0U;
+		}
 	}
 }
 
@@ -501,7 +550,7 @@ void CDStarRepeaterTXRXThread::transmitNetworkHeader(const CHeaderData& header)
 	}
 
 	m_networkQueue[m_writeNum]->reset();
-	m_networkQueue[m_writeNum]->setHeader(new CHeaderData(header));
+	m_networkQueue[m_writeNum]->setHeader(header);
 }
 
 void CDStarRepeaterTXRXThread::transmitNetworkHeader()
@@ -511,12 +560,11 @@ void CDStarRepeaterTXRXThread::transmitNetworkHeader()
 	if (!ready)
 		return;
 
-	CHeaderData* header = m_networkQueue[m_readNum]->getHeader();
-	if (header == NULL)
+	CHeaderData header;
+	if (!m_networkQueue[m_readNum]->getHeader(header))
 		return;
 
-	m_modem->writeHeader(*header);
-	delete header;
+	m_modem->writeHeader(header);
 }
 
 void CDStarRepeaterTXRXThread::transmitNetworkData()
@@ -568,6 +616,7 @@ void CDStarRepeaterTXRXThread::setRadioState(DSTAR_RX_STATE state)
 			m_ambeErrors     = 0U;
 			m_lastAMBEBits   = 0U;
 			m_lastAMBEErrors = 0U;
+			m_ber            = 0.0F;
 			m_rxState        = DSRXS_PROCESS_DATA;
 			break;
 
@@ -614,14 +663,11 @@ bool CDStarRepeaterTXRXThread::setRepeaterState(DSTAR_RPT_STATE state)
 	return true;
 }
 
-bool CDStarRepeaterTXRXThread::processRadioHeader(CHeaderData* header)
+bool CDStarRepeaterTXRXThread::processRadioHeader(const CHeaderData& header)
 {
-	wxASSERT(header != NULL);
-
 	// We don't handle DD data packets
-	if (header->isDataPacket()) {
+	if (header.isDataPacket()) {
 		wxLogMessage(wxT("Received a DD packet, ignoring"));
-		delete header;
 		return false;
 	}
 
@@ -629,49 +675,45 @@ bool CDStarRepeaterTXRXThread::processRadioHeader(CHeaderData* header)
 
 	if (m_rptState == DSRS_VALID) {
 		// Send the valid header to the gateway if we are accepted
-		delete m_rxHeader;
 		m_rxHeader = header;
 
-		CHeaderData netHeader(*m_rxHeader);
-		netHeader.setRptCall1(m_rxHeader->getRptCall2());
-		netHeader.setRptCall2(m_rxHeader->getRptCall1());
+		unsigned char rptCall1[LONG_CALLSIGN_LENGTH], rptCall2[LONG_CALLSIGN_LENGTH];
+		m_rxHeader.getRptCall1(rptCall1);
+		m_rxHeader.getRptCall2(rptCall2);
+
+		CHeaderData netHeader(m_rxHeader);
+		netHeader.setRptCall1(rptCall2);
+		netHeader.setRptCall2(rptCall1);
 
 		m_protocolHandler->writeHeader(netHeader);
-	} else {
-		delete header;
 	}
 
 	return true;
 }
 
-void CDStarRepeaterTXRXThread::processNetworkHeader(CHeaderData* header)
+void CDStarRepeaterTXRXThread::processNetworkHeader(const CHeaderData& header)
 {
-	wxASSERT(header != NULL);
-
 	// If shutdown we ignore incoming headers
-	if (m_rptState == DSRS_SHUTDOWN) {
-		delete header;
+	if (m_rptState == DSRS_SHUTDOWN)
 		return;
-	}
 
-	wxLogMessage(wxT("Network header received - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str(), header->getFlag1(), header->getFlag2(), header->getFlag3());
+	wxLogMessage(wxT("Network header received - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header.getMyCall1().c_str(), header.getMyCall2().c_str(), header.getYourCall().c_str(), header.getRptCall1().c_str(), header.getRptCall2().c_str(), header.getFlag1(), header.getFlag2(), header.getFlag3());
 
 	// Is it for us?
-	if (!header->getRptCall2().IsSameAs(m_rptCallsign)) {
+	if (!header.isRptCall2(m_rptCallsign)) {
 		wxLogMessage(wxT("Invalid network RPT2 value, ignoring"));
-		delete header;
 		return;
 	}
 
-	delete m_txHeader;
 	m_txHeader = header;
 
 	m_networkSeqNo = 0U;
+	m_jitterBuffer.reset();
 	m_transmitting = true;
 	m_watchdogTimer.start();
 	m_activeHangTimer.stop();
 
-	transmitNetworkHeader(*header);
+	transmitNetworkHeader(header);
 }
 
 void CDStarRepeaterTXRXThread::processRadioFrame(unsigned char* data, FRAME_TYPE type)
@@ -686,7 +728,7 @@ void CDStarRepeaterTXRXThread::processRadioFrame(unsigned char* data, FRAME_TYPE
 	unsigned int errors = 0U;
 	if (type != FRAME_END) {
 		// Data packets have no AMBE FEC
-		if (!m_rxHeader->isDataPacket())
+		if (!m_rxHeader.isDataPacket())
 			errors = m_ambe.count(data);
 
 		m_ambeErrors += errors;
@@ -712,87 +754,42 @@ void CDStarRepeaterTXRXThread::processRadioFrame(unsigned char* data, FRAME_TYPE
 	}
 }
 
-unsigned int CDStarRepeaterTXRXThread::processNetworkFrame(unsigned char* data, unsigned int length, unsigned char seqNo)
+void CDStarRepeaterTXRXThread::processNetworkFrame(unsigned char* data)
 {
 	wxASSERT(data != NULL);
-	wxASSERT(length > 0U);
 
 	// If shutdown we ignore incoming data
 	if (m_rptState == DSRS_SHUTDOWN)
-		return 1U;
-
-	bool end = (seqNo & 0x40U) == 0x40U;
-	if (end) {
-		m_networkQueue[m_writeNum]->addData(END_PATTERN_BYTES, DV_FRAME_LENGTH_BYTES, true);
-		endOfNetworkData();
-		return 1U;
-	}
-
-	// Mask out the control bits of the sequence number
-	seqNo &= 0x1FU;
-
-	// Count the number of silence frames to insert
-	unsigned int tempSeqNo = m_networkSeqNo;
-	unsigned int count = 0U;
-	while (seqNo != tempSeqNo) {
-		count++;
-
-		tempSeqNo++;
-		if (tempSeqNo >= 21U)
-			tempSeqNo = 0U;
-	}
-
-	// If the number is too high, then it probably means an old out-of-order frame, ignore it
-	if (count > 18U)
-		return 0U;
-
-	unsigned int packetCount = 0U;
-
-	// Insert missing frames
-	while (seqNo != m_networkSeqNo) {
-		unsigned char buffer[DV_FRAME_LENGTH_BYTES];
-		if (count > SILENCE_THRESHOLD) {
-			::memcpy(buffer, NULL_FRAME_DATA_BYTES, DV_FRAME_LENGTH_BYTES);
-		} else {
-			::memcpy(buffer, m_lastData, DV_FRAME_LENGTH_BYTES);
-			// Data packets have no AMBE FEC
-			if (!m_txHeader->isDataPacket())
-				m_ambe.regenerate(buffer);
-		}
-
-		if (m_networkSeqNo == 0U)
-			::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
-
-		m_networkQueue[m_writeNum]->addData(buffer, DV_FRAME_LENGTH_BYTES, false);
-
-		packetCount++;
-		m_networkSeqNo++;
-		m_packetSilence++;
-		if (m_networkSeqNo >= 21U)
-			m_networkSeqNo = 0U;
-	}
+		return;
 
 	// Regenerate the sync bytes
 	if (m_networkSeqNo == 0U)
 		::memcpy(data + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
 
-	packetCount++;
 	m_networkSeqNo++;
 	if (m_networkSeqNo >= 21U)
 		m_networkSeqNo = 0U;
+}
 
-	// Data packets have no AMBE FEC
-	if (!m_txHeader->isDataPacket())
-		m_ambe.regenerate(data);
+void CDStarRepeaterTXRXThread::writeNetworkFrames(unsigned char* frames, unsigned int n)
+{
+	wxASSERT(frames != NULL);
 
-	m_networkQueue[m_writeNum]->addData(data, DV_FRAME_LENGTH_BYTES, false);
+	// If shutdown we ignore incoming data
+	if (n == 0U || m_rptState == DSRS_SHUTDOWN)
+		return;
+
+	// Data packets have no AMBE FEC
+	if (!m_txHeader.isDataPacket())
+		m_ambe.regenerate(frames, n, DV_FRAME_LENGTH_BYTES, NULL);
 
-	return packetCount;
+	for (unsigned int i = 0U; i < n; i++)
+		m_networkQueue[m_writeNum]->addData(frames + i * DV_FRAME_LENGTH_BYTES, DV_FRAME_LENGTH_BYTES, false);
 }
 
 void CDStarRepeaterTXRXThread::endOfRadioData()
 {
-	wxLogMessage(wxT("AMBE for %s  Frames: %.1fs, Silence: %.1f%%, BER: %.1f%%"), m_rxHeader->getMyCall1().c_str(), float(m_ambeFrames) / 50.0F, float(m_ambeSilence * 100U) / float(m_ambeFrames), float(m_ambeErrors * 100U) / float(m_ambeBits));
+	wxLogMessage(wxT("AMBE for %s  Frames: %.1fs, Silence: %.1f%%, BER: %.1f%%"), m_rxHeader.getMyCall1().c_str(), float(m_ambeFrames) / 50.0F, float(m_ambeSilence * 100U) / float(m_ambeFrames), float(m_ambeErrors * 100U) / float(m_ambeBits));
 
 	setRepeaterState(DSRS_LISTENING);
 }
@@ -803,7 +800,7 @@ void CDStarRepeaterTXRXThread::endOfNetworkData()
 	if (m_packetCount != 0U)
 		loss = float(m_packetSilence) / float(m_packetCount);
 
-	wxLogMessage(wxT("Stats for %s  Frames: %.1fs, Loss: %.1f%%, Packets: %u/%u"), m_txHeader->getMyCall1().c_str(), float(m_packetCount) / 50.0F, loss * 100.0F, m_packetSilence, m_packetCount);
+	wxLogMessage(wxT("Stats for %s  Frames: %.1fs, Loss: %.1f%%, Packets: %u/%u, Late: %u, Reordered: %u, Delay: %ums, Jitter: %ums"), m_txHeader.getMyCall1().c_str(), float(m_packetCount) / 50.0F, loss * 100.0F, m_packetSilence, m_packetCount, m_jitterBuffer.getLate(), m_jitterBuffer.getReordered(), m_jitterBuffer.getDelay(), m_jitterBuffer.getJitter());
 
 	m_watchdogTimer.stop();
 	m_activeHangTimer.start();
@@ -815,45 +812,70 @@ void CDStarRepeaterTXRXThread::endOfNetworkData()
 		m_writeNum = 0U;
 }
 
-CDStarRepeaterStatusData* CDStarRepeaterTXRXThread::getStatus()
+bool CDStarRepeaterTXRXThread::getStatus(CDStarRepeaterStatusData& status) const
 {
-	float   bits = float(m_ambeBits - m_lastAMBEBits);
-	float errors = float(m_ambeErrors - m_lastAMBEErrors);
-	if (bits == 0.0F)
-		bits = 1.0F;
+	return m_statusLock.read(status);
+}
 
-	m_lastAMBEBits   = m_ambeBits;
-	m_lastAMBEErrors = m_ambeErrors;
+// Sleep until the next timer or network frame is due. The modem only signals when it has received
+// something, so while there is anything to send to it, it is checked every cycle.
+unsigned int CDStarRepeaterTXRXThread::getTimeout()
+{
+	unsigned int timeout = m_wheel.getNext(MAX_WAIT_TIME);
 
-	CDStarRepeaterStatusData* status;
-	if (m_rptState == DSRS_SHUTDOWN || m_rptState == DSRS_LISTENING)
-		status = new CDStarRepeaterStatusData(wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString,
-					wxEmptyString, 0x00, 0x00, 0x00, m_tx, m_rxState, m_rptState, 0U, 0U, 0U, 0U, 0U, 0U, 0.0F,
-					wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString);
-	else
-		status = new CDStarRepeaterStatusData(m_rxHeader->getMyCall1(), m_rxHeader->getMyCall2(),
-					m_rxHeader->getYourCall(), m_rxHeader->getRptCall1(), m_rxHeader->getRptCall2(),
-					m_rxHeader->getFlag1(), m_rxHeader->getFlag2(), m_rxHeader->getFlag3(), m_tx, m_rxState,
-					m_rptState, 0U, 0U, 0U, 0U, 0U, 0U, (errors * 100.0F) / bits, wxEmptyString, wxEmptyString,
-					wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString);
+	if (m_transmitting) {
+		unsigned int next = m_jitterBuffer.getNext();
+		if (next < timeout)
+			timeout = next;
+	}
+
+	bool busy = m_networkQueue[m_readNum]->headerReady() || m_networkQueue[m_readNum]->dataReady();
+	if (busy && timeout > CYCLE_TIME)
+		timeout = CYCLE_TIME;
+
+	return timeout;
+}
+
+void CDStarRepeaterTXRXThread::clock(unsigned int ms)
+{
+	m_wheel.clock(ms);
+	m_jitterBuffer.clock(ms);
+}
+
+void CDStarRepeaterTXRXThread::publishStatus()
+{
+	if (m_berTimer.hasExpired()) {
+		float   bits = float(m_ambeBits - m_lastAMBEBits);
+		float errors = float(m_ambeErrors - m_lastAMBEErrors);
+		if (bits == 0.0F)
+			bits = 1.0F;
+
+		m_ber = (errors * 100.0F) / bits;
+
+		m_lastAMBEBits   = m_ambeBits;
+		m_lastAMBEErrors = m_ambeErrors;
+
+		m_berTimer.start();
+	}
+
+	if (m_rptState == DSRS_SHUTDOWN || m_rptState == DSRS_LISTENING) {
+		m_statusData.clearHeader();
+		m_statusData.setPercent(0.0F);
+	} else {
+		m_statusData.setHeader(m_rxHeader);
+		m_statusData.setPercent(m_ber);
+	}
+
+	m_statusData.setState(m_tx, m_rxState, m_rptState);
 
 	if (m_type.IsSameAs(wxT("DVAP")) && m_modem != NULL) {
 		CDVAPController* dvap = static_cast<CDVAPController*>(m_modem);
 		bool squelch = dvap->getSquelch();
 		int signal   = dvap->getSignal();
-		status->setDVAP(squelch, signal);
+		m_statusData.setDVAP(squelch, signal);
 	}
 
-	return status;
-}
-
-void CDStarRepeaterTXRXThread::clock(unsigned int ms)
-{
-	m_registerTimer.clock(ms);
-	m_watchdogTimer.clock(ms);
-	m_activeHangTimer.clock(ms);
-	m_statusTimer.clock(ms);
-	m_heartbeatTimer.clock(ms);
+	m_statusLock.write(m_statusData);
 }
 
 void CDStarRepeaterTXRXThread::shutdown()
@@ -25,10 +25,14 @@
 #include "DStarRepeaterDefs.h"
 #include "DVTOOLFileWriter.h"
 #include "SlowDataDecoder.h"
+#include "AMBEConcealer.h"
 #include "CallsignList.h"
+#include "JitterBuffer.h"
 #include "OutputQueue.h"
 #include "HeaderData.h"
 #include "AMBEFEC.h"
+#include "EventPoller.h"
+#include "SeqLock.h"
 #include "Timer.h"
 
 #include <wx/wx.h>
@@ -43,6 +47,7 @@ public:
 	virtual void setModem(CModem* modem);
 	virtual void setController(CExternalController* controller, unsigned int activeHangTime);
 	virtual void setTimes(unsigned int timeout, unsigned int ackTime);
+	virtual void setConcealment(unsigned int frames);
 	virtual void setBeacon(unsigned int time, const wxString& text, bool voice, TEXT_LANG language);
 	virtual void setAnnouncement(bool enabled, unsigned int time, const wxString& recordRPT1, const wxString& recordRPT2, const wxString& deleteRPT1, const wxString& deleteRPT2);
 
@@ -51,6 +56,7 @@ public:
 	virtual void setWhiteList(CCallsignList* list);
 	virtual void setBlackList(CCallsignList* list);
 	virtual void setGreyList(CCallsignList* list);
+	virtual void setTrace(CEventTrace* trace);
 
 	virtual void shutdown();
 	virtual void startup();
@@ -62,7 +68,7 @@ public:
 	virtual void command5();
 	virtual void command6();
 
-	virtual CDStarRepeaterStatusData* getStatus();
+	virtual bool getStatus(CDStarRepeaterStatusData& status) const;
 
 	virtual void kill();
 
@@ -74,16 +80,20 @@ private:
 	CRepeaterProtocolHandler*  m_protocolHandler;
 	CExternalController*       m_controller;
 	wxString                   m_rptCallsign;
-	CHeaderData*               m_rxHeader;
-	CHeaderData*               m_txHeader;
+	CHeaderData                m_rxHeader;
+	CHeaderData                m_txHeader;
 	COutputQueue**             m_networkQueue;
 	unsigned int               m_writeNum;
 	unsigned int               m_readNum;
+	CJitterBuffer              m_jitterBuffer;
+	CAMBEConcealer             m_concealer;
 	unsigned char              m_radioSeqNo;
 	unsigned char              m_networkSeqNo;
+	CTimerWheel                m_wheel;
 	CTimer                     m_watchdogTimer;
 	CTimer                     m_registerTimer;
 	CTimer                     m_statusTimer;
+	CTimer                     m_berTimer;
 	CTimer                     m_heartbeatTimer;
 	DSTAR_RPT_STATE            m_rptState;
 	DSTAR_RX_STATE             m_rxState;
@@ -94,7 +104,6 @@ private:
 	bool                       m_killed;
 	CTimer                     m_activeHangTimer;
 	bool                       m_disable;
-	unsigned char*             m_lastData;
 	CAMBEFEC                   m_ambe;
 	unsigned int               m_ambeFrames;
 	unsigned int               m_ambeSilence;
@@ -102,12 +111,14 @@ private:
 	unsigned int               m_ambeErrors;
 	unsigned int               m_lastAMBEBits;
 	unsigned int               m_lastAMBEErrors;
-	wxStopWatch                m_headerTime;
-	wxStopWatch                m_packetTime;
+	float                      m_ber;
 	unsigned int               m_packetCount;
 	unsigned int               m_packetSilence;
 
-	void receiveHeader(CHeaderData* header);
+	CEventPoller               m_poller;
+	CDStarRepeaterStatusData   m_statusData;
+	CSeqLock<CDStarRepeaterStatusData> m_statusLock;
+	void receiveHeader(const CHeaderData& header);
 	void receiveRadioData(unsigned char* data, unsigned int length);
 	void receiveSlowData(unsigned char* data, unsigned int length);
 	void transmitNetworkHeader(const CHeaderData& header);
@@ -117,16 +128,20 @@ private:
 	void repeaterStateMachine();
 	void receiveModem();
 	void receiveNetwork();
-	bool processRadioHeader(CHeaderData* header);
-	void processNetworkHeader(CHeaderData* header);
+	void playoutNetwork();
+	bool processRadioHeader(const CHeaderData& header);
+	void processNetworkHeader(const CHeaderData& header);
 	void processRadioFrame(unsigned char* data, FRAME_TYPE type);
-	unsigned int processNetworkFrame(unsigned char* data, unsigned int length, unsigned char seqNo);
+	void processNetworkFrame(unsigned char* data);
+	void writeNetworkFrames(unsigned char* frames, unsigned int n);
 	void endOfRadioData();
 	void endOfNetworkData();
 	void setRadioState(DSTAR_RX_STATE state);
 	bool setRepeaterState(DSTAR_RPT_STATE state);
 	unsigned int countBits(unsigned char byte);
 	void clock(unsigned int ms);
+	unsigned int getTimeout();
+	void publishStatus();
 };
 
 #endif
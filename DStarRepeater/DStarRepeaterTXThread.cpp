@@ -21,6 +21,7 @@
 #include "DStarDefines.h"
 #include "HeaderData.h"
 #include "Version.h"
+#include "Utils.h"
 
 const unsigned char DTMF_MASK[] = {0x82U, 0x08U, 0x20U, 0x82U, 0x00U, 0x00U, 0x82U, 0x00U, 0x00U};
 const unsigned char DTMF_SIG[]  = {0x82U, 0x08U, 0x20U, 0x82U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U};
@@ -29,40 +30,47 @@ const unsigned int MAX_DATA_SYNC_BIT_ERRS  = 2U;
 
 const unsigned int NETWORK_QUEUE_COUNT = 2U;
 
-const unsigned int SILENCE_THRESHOLD = 2U;
+// The limits of the network playout delay in ms
+const unsigned int NETWORK_MIN_DELAY = 40U;
+const unsigned int NETWORK_MAX_DELAY = 300U;
 
+// While anything is waiting for the modem the thread wakes at least this often
 const unsigned int CYCLE_TIME  = 9U;
 
+// The longest sleep when no timer is due before then
+const unsigned int MAX_WAIT_TIME = 1000U;
+
 CDStarRepeaterTXThread::CDStarRepeaterTXThread(const wxString& type) :
 m_type(type),
 m_modem(NULL),
 m_protocolHandler(NULL),
 m_stopped(true),
 m_rptCallsign(),
-m_txHeader(NULL),
+m_txHeader(),
 m_networkQueue(NULL),
 m_writeNum(0U),
 m_readNum(0U),
+m_jitterBuffer(NETWORK_MIN_DELAY, NETWORK_MAX_DELAY),
+m_concealer(0U),
 m_networkSeqNo(0U),
-m_watchdogTimer(1000U, NETWORK_TIMEOUT),
-m_registerTimer(1000U),
-m_statusTimer(1000U, 0U, 100U),		// 100ms
+m_wheel(),
+m_watchdogTimer(m_wheel, NETWORK_TIMEOUT),
+m_registerTimer(m_wheel),
+m_statusTimer(m_wheel, 0U, 100U),		// 100ms
 m_state(DSRS_LISTENING),
 m_tx(false),
 m_space(0U),
 m_killed(false),
-m_lastData(NULL),
 m_ambe(),
-m_headerTime(),
-m_packetTime(),
 m_packetCount(0U),
-m_packetSilence(0U)
+m_packetSilence(0U),
+m_poller(),
+m_statusData(),
+m_statusLock()
 {
 	m_networkQueue = new COutputQueue*[NETWORK_QUEUE_COUNT];
 	for (unsigned int i = 0U; i < NETWORK_QUEUE_COUNT; i++)
 		m_networkQueue[i] = new COutputQueue((DV_FRAME_LENGTH_BYTES + 2U) * 200U, NETWORK_RUN_FRAME_COUNT);		// 4s worth of data);
-
-	m_lastData = new unsigned char[DV_FRAME_MAX_LENGTH_BYTES];
 }
 
 CDStarRepeaterTXThread::~CDStarRepeaterTXThread()
@@ -70,12 +78,12 @@ CDStarRepeaterTXThread::~CDStarRepeaterTXThread()
 	for (unsigned int i = 0U; i < NETWORK_QUEUE_COUNT; i++)
 		delete m_networkQueue[i];
 	delete[] m_networkQueue;
-	delete[] m_lastData;
-	delete   m_txHeader;
 }
 
 void *CDStarRepeaterTXThread::Entry()
 {
+	startLog();
+
 	// Wait here until we have the essentials to run
 	while (!m_killed && (m_modem == NULL  || m_protocolHandler == NULL || m_rptCallsign.IsEmpty() || m_rptCallsign.IsSameAs(wxT("        "))))
 		::wxMilliSleep(500UL);		// 1/2 sec
@@ -93,14 +101,19 @@ void *CDStarRepeaterTXThread::Entry()
 	if (n != wxNOT_FOUND)
 		hardware = m_type.Left(n);
 
+	// Wake as soon as the modem has data or a packet arrives, or the next timer is due
+	bool ret = m_poller.open();
+	if (ret) {
+		m_modem->setPoller(&m_poller);
+		m_poller.addReader(m_protocolHandler->getFD());
+	}
+
 	wxLogMessage(wxT("Starting the D-Star transmitter thread"));
 
-	wxStopWatch stopWatch;
+	wxUint64 lastTime = CUtils::getTimestamp();
 
 	try {
 		while (!m_killed) {
-			stopWatch.Start();
-
 			if (m_statusTimer.hasExpired() || m_space == 0U) {
 				m_space = m_modem->getSpace();
 				m_tx    = m_modem->isTX();
@@ -109,6 +122,8 @@ void *CDStarRepeaterTXThread::Entry()
 
 			receiveNetwork();
 
+			playoutNetwork();
+
 			receiveModem();
 
 			if (m_state == DSRS_NETWORK) {
@@ -131,12 +146,19 @@ void *CDStarRepeaterTXThread::Entry()
 			else if (m_networkQueue[m_readNum]->headerReady())
 				transmitNetworkHeader();
 
-			unsigned long ms = stopWatch.Time();
-			if (ms < CYCLE_TIME) {
-				::wxMilliSleep(CYCLE_TIME - ms);
-				clock(CYCLE_TIME);
-			} else {
+			publishStatus();
+
+			unsigned int timeout = getTimeout();
+			if (ret)
+				m_poller.wait(timeout);
+			else
+				::wxMilliSleep(timeout);
+
+			// Only whole milliseconds are clocked, the remainder is carried over to the next pass
+			unsigned int ms = (unsigned int)((CUtils::getTimestamp() - lastTime) / 1000U);
+			if (ms > 0U) {
 				clock(ms);
+				lastTime += ms * 1000U;
 			}
 		}
 	}
@@ -150,8 +172,11 @@ void *CDStarRepeaterTXThread::Entry()
 
 	wxLogMessage(wxT("Stopping the D-Star transmitter thread"));
 
+	m_modem->setPoller(NULL);
 	m_modem->stop();
 
+	m_poller.close();
+
 	m_protocolHandler->close();
 	delete m_protocolHandler;
 
@@ -161,6 +186,8 @@ void *CDStarRepeaterTXThread::Entry()
 void CDStarRepeaterTXThread::kill()
 {
 	m_killed = true;
+
+	m_poller.signal();
 }
 
 void CDStarRepeaterTXThread::setCallsign(const wxString& callsign, const wxString&, DSTAR_MODE, ACK_TYPE, bool, bool, bool, bool)
@@ -195,6 +222,11 @@ void CDStarRepeaterTXThread::setTimes(unsigned int, unsigned int)
 {
 }
 
+void CDStarRepeaterTXThread::setConcealment(unsigned int frames)
+{
+	m_concealer.setFadeFrames(frames);
+}
+
 void CDStarRepeaterTXThread::setBeacon(unsigned int, const wxString&, bool, TEXT_LANG)
 {
 }
@@ -227,6 +259,11 @@ void CDStarRepeaterTXThread::setGreyList(CCallsignList*)
 {
 }
 
+void CDStarRepeaterTXThread::setTrace(CEventTrace* trace)
+{
+	delete trace;
+}
+
 void CDStarRepeaterTXThread::receiveModem()
 {
 	for (;;) {
@@ -247,14 +284,12 @@ void CDStarRepeaterTXThread::receiveNetwork()
 		if (type == NETWORK_NONE) {					// Nothing received
 			break;
 		} else if (type == NETWORK_HEADER) {		// A header
-			CHeaderData* header = m_protocolHandler->readHeader();
-			if (header != NULL) {
-				::memcpy(m_lastData, NULL_FRAME_DATA_BYTES, DV_FRAME_LENGTH_BYTES);
+			CHeaderData header;
+			if (m_protocolHandler->readHeader(header)) {
+				m_concealer.reset();
 
 				processNetworkHeader(header);
 
-				m_headerTime.Start();
-				m_packetTime.Start();
 				m_packetCount   = 0U;
 				m_packetSilence = 0U;
 			}
@@ -264,45 +299,61 @@ void CDStarRepeaterTXThread::receiveNetwork()
 
 			unsigned char seqNo;
 			unsigned int length = m_protocolHandler->readData(data, DV_FRAME_MAX_LENGTH_BYTES, seqNo);
-			if (length != 0U) {
-				::memcpy(m_lastData, data, length);
+			if (length != 0U && m_state == DSRS_NETWORK) {
 				m_watchdogTimer.start();
-				m_packetCount += processNetworkFrame(data, length, seqNo);
+
+				// Mask out the control bits of the sequence number
+				m_jitterBuffer.write(seqNo & 0x1FU, (seqNo & 0x40U) == 0x40U, data, length);
 			}
 		}
 	}
+}
 
-	// Have we missed any data frames?
-	if (m_state == DSRS_NETWORK && m_packetTime.Time() > 200L) {
-		unsigned int packetsNeeded = m_headerTime.Time() / DSTAR_FRAME_TIME_MS;
-
-		// wxLogMessage(wxT("Time: %u ms, need %u packets and received %u packets"), ms - m_headerMS, packetsNeeded, m_packetCount);
+void CDStarRepeaterTXThread::playoutNetwork()
+{
+	if (m_state != DSRS_NETWORK)
+		return;
 
-		if (packetsNeeded > m_packetCount) {
-			unsigned int count = packetsNeeded - m_packetCount;
+	// The frames that have come due since the last pass have their FEC regenerated together
+	unsigned char frames[JITTER_SLOTS * DV_FRAME_LENGTH_BYTES];
+	unsigned int n = 0U;
 
-			if (count > 5U) {
-				count -= 2U;
+	for (;;) {
+		unsigned char* data = frames + n * DV_FRAME_LENGTH_BYTES;
+		JITTER_FRAME type = m_jitterBuffer.read(data);
 
-				// wxLogMessage(wxT("Inserting %u silence frames into the network data stream"), count);
+		if (type == JF_NONE) {
+			writeNetworkFrames(frames, n);
+			return;
+		} else if (type == JF_END) {
+			writeNetworkFrames(frames, n);
+			m_networkQueue[m_writeNum]->addData(END_PATTERN_BYTES, DV_FRAME_LENGTH_BYTES, true);
+			endOfNetworkData();
+			return;
+		} else if (type == JF_MISSING) {
+			// The voice fades out from the last good frame, the slow data is the null filler
+			::memcpy(data, NULL_FRAME_DATA_BYTES, DV_FRAME_LENGTH_BYTES);
+			m_concealer.conceal(data);
 
-				// Create silence frames
-				for (unsigned int i = 0U; i < count; i++) {
-					unsigned char data[DV_FRAME_LENGTH_BYTES];
-					::memcpy(data, NULL_FRAME_DATA_BYTES, DV_FRAME_LENGTH_BYTES);
-					m_packetCount += processNetworkFrame(data, DV_FRAME_LENGTH_BYTES, m_networkSeqNo);
-					m_packetSilence++;
-				}
-			}
+			m_packetSilence++;
+		} else {
+			m_concealer.good(data);
 		}
 
-		m_packetTime.Start();
+		processNetworkFrame(data);
+		m_packetCount++;
+
+		n++;
+		if (n == JITTER_SLOTS) {
+			writeNetworkFrames(frames, n);
+			n = 0U;
+		}
 	}
 }
 
-void CDStarRepeaterTXThread::transmitNetworkHeader(CHeaderData* header)
+void CDStarRepeaterTXThread::transmitNetworkHeader(const CHeaderData& header)
 {
-	wxLogMessage(wxT("Transmitting to - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str(), header->getFlag1(), header->getFlag2(), header->getFlag3());
+	wxLogMessage(wxT("Transmitting to - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header.getMyCall1().c_str(), header.getMyCall2().c_str(), header.getYourCall().c_str(), header.getRptCall1().c_str(), header.getRptCall2().c_str(), header.getFlag1(), header.getFlag2(), header.getFlag3());
 
 	bool empty = m_networkQueue[m_readNum]->isEmpty();
 	if (!empty) {
@@ -332,12 +383,11 @@ void CDStarRepeaterTXThread::transmitNetworkHeader()
 	if (!ready)
 		return;
 
-	CHeaderData* header = m_networkQueue[m_readNum]->getHeader();
-	if (header == NULL)
+	CHeaderData header;
+	if (!m_networkQueue[m_readNum]->getHeader(header))
 		return;
 
-	m_modem->writeHeader(*header);
-	delete header;
+	m_modem->writeHeader(header);
 }
 
 void CDStarRepeaterTXThread::transmitNetworkData()
@@ -364,101 +414,52 @@ void CDStarRepeaterTXThread::transmitNetworkData()
 	}
 }
 
-void CDStarRepeaterTXThread::processNetworkHeader(CHeaderData* header)
+void CDStarRepeaterTXThread::processNetworkHeader(const CHeaderData& header)
 {
-	wxASSERT(header != NULL);
-
-	wxLogMessage(wxT("Network header received - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str(), header->getFlag1(), header->getFlag2(), header->getFlag3());
+	wxLogMessage(wxT("Network header received - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X"), header.getMyCall1().c_str(), header.getMyCall2().c_str(), header.getYourCall().c_str(), header.getRptCall1().c_str(), header.getRptCall2().c_str(), header.getFlag1(), header.getFlag2(), header.getFlag3());
 
 	// Is it for us?
-	if (!header->getRptCall2().IsSameAs(m_rptCallsign)) {
+	if (!header.isRptCall2(m_rptCallsign)) {
 		wxLogMessage(wxT("Invalid network RPT2 value, ignoring"));
-		delete header;
 		return;
 	}
 
 	m_state = DSRS_NETWORK;
 	m_networkSeqNo = 0U;
+	m_jitterBuffer.reset();
 	m_watchdogTimer.start();
 
-	delete m_txHeader;
 	m_txHeader = header;
 
-	transmitNetworkHeader(new CHeaderData(*header));
+	transmitNetworkHeader(header);
 }
 
-unsigned int CDStarRepeaterTXThread::processNetworkFrame(unsigned char* data, unsigned int length, unsigned char seqNo)
+void CDStarRepeaterTXThread::processNetworkFrame(unsigned char* data)
 {
 	wxASSERT(data != NULL);
-	wxASSERT(length > 0U);
-
-	bool end = (seqNo & 0x40U) == 0x40U;
-	if (end) {
-		m_networkQueue[m_writeNum]->addData(END_PATTERN_BYTES, DV_FRAME_LENGTH_BYTES, true);
-		endOfNetworkData();
-		return 1U;
-	}
-
-	// Mask out the control bits of the sequence number
-	seqNo &= 0x1FU;
-
-	// Count the number of silence frames to insert
-	unsigned int tempSeqNo = m_networkSeqNo;
-	unsigned int count = 0U;
-	while (seqNo != tempSeqNo) {
-		count++;
-
-		tempSeqNo++;
-		if (tempSeqNo >= 21U)
-			tempSeqNo = 0U;
-	}
-
-	// If the number is too high, then it probably means an old out-of-order frame, ignore it
-	if (count > 18U)
-		return 0U;
-
-	unsigned int packetCount = 0U;
-
-	// Insert missing frames
-	while (seqNo != m_networkSeqNo) {
-		unsigned char buffer[DV_FRAME_LENGTH_BYTES];
-		if (count > SILENCE_THRESHOLD) {
-			::memcpy(buffer, NULL_FRAME_DATA_BYTES, DV_FRAME_LENGTH_BYTES);
-		} else {
-			::memcpy(buffer, m_lastData, DV_FRAME_LENGTH_BYTES);
-			// Data packets have no AMBE FEC
-			if (!m_txHeader->isDataPacket())
-				m_ambe.regenerate(buffer);
-		}
-
-		if (m_networkSeqNo == 0U)
-			::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
-
-		m_networkQueue[m_writeNum]->addData(buffer, DV_FRAME_LENGTH_BYTES, false);
-
-		packetCount++;
-		m_networkSeqNo++;
-		m_packetSilence++;
-		if (m_networkSeqNo >= 21U)
-			m_networkSeqNo = 0U;
-	}
 
 	// Regenerate the sync bytes
 	if (m_networkSeqNo == 0U)
 		::memcpy(data + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
 
-	packetCount++;
 	m_networkSeqNo++;
 	if (m_networkSeqNo >= 21U)
 		m_networkSeqNo = 0U;
+}
 
-	// Data packets have no AMBE FEC
-	if (!m_txHeader->isDataPacket())
-		m_ambe.regenerate(data);
+void CDStarRepeaterTXThread::writeNetworkFrames(unsigned char* frames, unsigned int n)
+{
+	wxASSERT(frames != NULL);
+
+	if (n == 0U)
+		return;
 
-	m_networkQueue[m_writeNum]->addData(data, DV_FRAME_LENGTH_BYTES, false);
+	// Data packets have no AMBE FEC
+	if (!m_txHeader.isDataPacket())
+		m_ambe.regenerate(frames, n, DV_FRAME_LENGTH_BYTES, NULL);
 
-	return packetCount;
+	for (unsigned int i = 0U; i < n; i++)
+		m_networkQueue[m_writeNum]->addData(frames + i * DV_FRAME_LENGTH_BYTES, DV_FRAME_LENGTH_BYTES, false);
 }
 
 void CDStarRepeaterTXThread::endOfNetworkData()
@@ -467,7 +468,7 @@ void CDStarRepeaterTXThread::endOfNetworkData()
 	if (m_packetCount != 0U)
 		loss = float(m_packetSilence) / float(m_packetCount);
 
-	wxLogMessage(wxT("Stats for %s  Frames: %.1fs, Loss: %.1f%%, Packets: %u/%u"), m_txHeader->getMyCall1().c_str(), float(m_packetCount) / 50.0F, loss * 100.0F, m_packetSilence, m_packetCount);
+	wxLogMessage(wxT("Stats for %s  Frames: %.1fs, Loss: %.1f%%, Packets: %u/%u, Late: %u, Reordered: %u, Delay: %ums, Jitter: %ums"), m_txHeader.getMyCall1().c_str(), float(m_packetCount) / 50.0F, loss * 100.0F, m_packetSilence, m_packetCount, m_jitterBuffer.getLate(), m_jitterBuffer.getReordered(), m_jitterBuffer.getDelay(), m_jitterBuffer.getJitter());
 
 	m_state = DSRS_LISTENING;
 	m_watchdogTimer.stop();
@@ -478,29 +479,53 @@ void CDStarRepeaterTXThread::endOfNetworkData()
 		m_writeNum = 0U;
 }
 
-CDStarRepeaterStatusData* CDStarRepeaterTXThread::getStatus()
+bool CDStarRepeaterTXThread::getStatus(CDStarRepeaterStatusData& status) const
 {
-	float loss = 0.0F;
-	if (m_packetCount != 0U)
-		loss = float(m_packetSilence) / float(m_packetCount);
+	return m_statusLock.read(status);
+}
+
+void CDStarRepeaterTXThread::publishStatus()
+{
+	if (m_state == DSRS_LISTENING) {
+		m_statusData.clearHeader();
+		m_statusData.setPercent(0.0F);
+	} else {
+		float loss = 0.0F;
+		if (m_packetCount != 0U)
+			loss = float(m_packetSilence) / float(m_packetCount);
+
+		m_statusData.setHeader(m_txHeader);
+		m_statusData.setPercent(loss * 100.0F);
+	}
+
+	m_statusData.setState(m_tx, DSRXS_LISTENING, m_state);
+
+	m_statusLock.write(m_statusData);
+}
+
+// Sleep until the next timer or network frame is due. The modem only signals when it has received
+// something, so while there is anything to send to it, it is checked every cycle.
+unsigned int CDStarRepeaterTXThread::getTimeout()
+{
+	unsigned int timeout = m_wheel.getNext(MAX_WAIT_TIME);
+
+	if (m_state == DSRS_NETWORK) {
+		unsigned int next = m_jitterBuffer.getNext();
+		if (next < timeout)
+			timeout = next;
+	}
+
+	bool busy = m_networkQueue[m_readNum]->headerReady() || m_networkQueue[m_readNum]->dataReady();
+	if (busy && timeout > CYCLE_TIME)
+		timeout = CYCLE_TIME;
 
-	if (m_state == DSRS_LISTENING)
-		return new CDStarRepeaterStatusData(wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString,
-				wxEmptyString, 0x00, 0x00, 0x00, m_tx, DSRXS_LISTENING, m_state, 0U, 0U, 0U, 0U, 0U, 0U, 0.0F,
-				wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString);
-	else
-		return new CDStarRepeaterStatusData(m_txHeader->getMyCall1(), m_txHeader->getMyCall2(),
-				m_txHeader->getYourCall(), m_txHeader->getRptCall1(), m_txHeader->getRptCall2(),
-				m_txHeader->getFlag1(), m_txHeader->getFlag2(), m_txHeader->getFlag3(), m_tx, DSRXS_LISTENING,
-				m_state, 0U, 0U, 0U, 0U, 0U, 0U, loss * 100.0F, wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString,
-				wxEmptyString, wxEmptyString);
+	return timeout;
 }
 
 void CDStarRepeaterTXThread::clock(unsigned int ms)
 {
-	m_registerTimer.clock(ms);
-	m_watchdogTimer.clock(ms);
-	m_statusTimer.clock(ms);
+	m_wheel.clock(ms);
+	m_jitterBuffer.clock(ms);
 }
 
 void CDStarRepeaterTXThread::shutdown()
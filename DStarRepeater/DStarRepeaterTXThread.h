@@ -19,10 +19,15 @@
 #ifndef	DStarRepeaterTXThread_H
 #define	DStarRepeaterTXThread_H
 
+#include "DStarRepeaterStatusData.h"
 #include "DStarRepeaterThread.h"
+#include "AMBEConcealer.h"
+#include "JitterBuffer.h"
 #include "OutputQueue.h"
 #include "HeaderData.h"
 #include "AMBEFEC.h"
+#include "EventPoller.h"
+#include "SeqLock.h"
 #include "Timer.h"
 
 #include <wx/wx.h>
@@ -37,6 +42,7 @@ public:
 	virtual void setModem(CModem* modem);
 	virtual void setController(CExternalController* controller, unsigned int activeHangTime);
 	virtual void setTimes(unsigned int timeout, unsigned int ackTime);
+	virtual void setConcealment(unsigned int frames);
 	virtual void setBeacon(unsigned int time, const wxString& text, bool voice, TEXT_LANG language);
 	virtual void setAnnouncement(bool enabled, unsigned int time, const wxString& recordRPT1, const wxString& recordRPT2, const wxString& deleteRPT1, const wxString& deleteRPT2);
 	virtual void setOutputs(bool out1, bool out2, bool out3, bool out4);
@@ -44,6 +50,7 @@ public:
 	virtual void setWhiteList(CCallsignList* list);
 	virtual void setBlackList(CCallsignList* list);
 	virtual void setGreyList(CCallsignList* list);
+	virtual void setTrace(CEventTrace* trace);
 
 	virtual void shutdown();
 	virtual void startup();
@@ -55,7 +62,7 @@ public:
 	virtual void command5();
 	virtual void command6();
 
-	virtual CDStarRepeaterStatusData* getStatus();
+	virtual bool getStatus(CDStarRepeaterStatusData& status) const;
 
 	virtual void kill();
 
@@ -67,11 +74,14 @@ private:
 	CRepeaterProtocolHandler*  m_protocolHandler;
 	bool                       m_stopped;
 	wxString                   m_rptCallsign;
-	CHeaderData*               m_txHeader;
+	CHeaderData                m_txHeader;
 	COutputQueue**             m_networkQueue;
 	unsigned int               m_writeNum;
 	unsigned int               m_readNum;
+	CJitterBuffer              m_jitterBuffer;
+	CAMBEConcealer             m_concealer;
 	unsigned char              m_networkSeqNo;
+	CTimerWheel                m_wheel;
 	CTimer                     m_watchdogTimer;
 	CTimer                     m_registerTimer;
 	CTimer                     m_statusTimer;
@@ -79,23 +89,27 @@ private:
 	bool                       m_tx;
 	unsigned int               m_space;
 	bool                       m_killed;
-	unsigned char*             m_lastData;
 	CAMBEFEC                   m_ambe;
-	wxStopWatch                m_headerTime;
-	wxStopWatch                m_packetTime;
 	unsigned int               m_packetCount;
 	unsigned int               m_packetSilence;
+	CEventPoller               m_poller;
+	CDStarRepeaterStatusData   m_statusData;
+	CSeqLock<CDStarRepeaterStatusData> m_statusLock;
 
-	void transmitNetworkHeader(CHeaderData* header);
+	void transmitNetworkHeader(const CHeaderData& header);
 	void transmitNetworkData();
 	void transmitNetworkHeader();
 
 	void receiveModem();
 	void receiveNetwork();
-	void processNetworkHeader(CHeaderData* header);
-	unsigned int processNetworkFrame(unsigned char* data, unsigned int length, unsigned char seqNo);
+	void playoutNetwork();
+	void processNetworkHeader(const CHeaderData& header);
+	void processNetworkFrame(unsigned char* data);
+	void writeNetworkFrames(unsigned char* frames, unsigned int n);
 	void endOfNetworkData();
 	void clock(unsigned int ms);
+	unsigned int getTimeout();
+	void publishStatus();
 };
 
 #endif
@@ -11,13 +11,34 @@
  *	GNU General Public License for more details.
  */
 
+#include "DStarRepeaterInstanceLog.h"
 #include "DStarRepeaterThread.h"
+#include "Logger.h"
 
 IDStarRepeaterThread::IDStarRepeaterThread():
-wxThread(wxTHREAD_JOINABLE)
+wxThread(wxTHREAD_JOINABLE),
+m_name(),
+m_log(NULL)
 {
 }
 
 IDStarRepeaterThread::~IDStarRepeaterThread()
 {
+	delete m_log;
+}
+
+void IDStarRepeaterThread::setName(const wxString& name)
+{
+	m_name = name;
+
+	// The log of the process is the active one while the repeaters are being created
+	m_log = new CDStarRepeaterInstanceLog(name, wxLog::GetActiveTarget());
+}
+
+void IDStarRepeaterThread::startLog()
+{
+	if (m_log != NULL)
+		wxLog::SetThreadActiveTarget(m_log);
+	else
+		CLogger::startThread();
 }
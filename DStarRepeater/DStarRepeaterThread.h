@@ -23,7 +23,9 @@
 #include "RepeaterProtocolHandler.h"
 #include "ExternalController.h"
 #include "DStarRepeaterDefs.h"
+#include "AnnouncementUnit.h"
 #include "CallsignList.h"
+#include "EventTrace.h"
 #include "Modem.h"
 
 #include <wx/wx.h>
@@ -48,6 +50,9 @@ public:
 
 	virtual void setTimes(unsigned int timeout, unsigned int ackTime) = 0;
 
+	// The number of frames over which a gap in the network audio fades to silence
+	virtual void setConcealment(unsigned int frames) = 0;
+
 	virtual void setBeacon(unsigned int time, const wxString& text, bool voice, TEXT_LANG language) = 0;
 	virtual void setAnnouncement(bool enabled, unsigned int time, const wxString& recordRPT1, const wxString& recordRPT2, const wxString& deleteRPT1, const wxString& deleteRPT2) = 0;
 	virtual void setControl(bool enabled, const wxString& rpt1Callsign,
@@ -58,18 +63,36 @@ public:
 	virtual void setOutputs(bool out1, bool out2, bool out3, bool out4) = 0;
 	virtual void setLogging(bool logging, const wxString& dir) = 0;
 
+	// The announcement unit made by setAnnouncement, if there is one, for its file to be reloaded
+	virtual CAnnouncementUnit* getAnnouncement() const { return NULL; }
+
 	virtual void setWhiteList(CCallsignList* list) = 0;
 	virtual void setBlackList(CCallsignList* list) = 0;
 	virtual void setGreyList(CCallsignList* list) = 0;
 
+	// The thread takes ownership of the trace
+	virtual void setTrace(CEventTrace* trace) = 0;
+
 	virtual void shutdown() = 0;
 	virtual void startup() = 0;
 
-	virtual CDStarRepeaterStatusData* getStatus() = 0;
+	// Copies out the last status published by the thread, returns false if there is none yet
+	virtual bool getStatus(CDStarRepeaterStatusData& status) const = 0;
 
 	virtual void kill() = 0;
 
+	// Only used when several repeaters share the process, the messages and commands from the thread
+	// then carry the name of its repeater
+	void setName(const wxString& name);
+
+protected:
+	wxString m_name;
+
+	// Called at the start of Entry()
+	void startLog();
+
 private:
+	wxLog*   m_log;
 };
 
 #endif
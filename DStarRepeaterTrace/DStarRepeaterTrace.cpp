@@ -0,0 +1,281 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "EventTrace.h"
+
+#include <wx/wx.h>
+#include <wx/init.h>
+#include <wx/ffile.h>
+#include <wx/cmdline.h>
+
+const wxString FILE_PARAM    = wxT("Trace File");
+const wxString GAPS_OPTION   = wxT("gaps");
+const wxString REPLAY_SWITCH = wxT("replay");
+const wxString SPEED_OPTION  = wxT("speed");
+
+// Long idle periods are shortened when replaying
+const wxUint64 MAX_REPLAY_WAIT = 2000000U;
+
+// These follow the order of the enums that they name
+const wxChar* EVENT_NAMES[]   = {wxT("NONE"), wxT("RPT_STATE"), wxT("RX_STATE"), wxT("MODEM"), wxT("NETWORK"), wxT("SILENCE"), wxT("QUEUE")};
+const wxChar* RPT_STATES[]    = {wxT("SHUTDOWN"), wxT("LISTENING"), wxT("VALID"), wxT("VALID_WAIT"), wxT("INVALID"), wxT("INVALID_WAIT"), wxT("TIMEOUT"), wxT("TIMEOUT_WAIT"), wxT("NETWORK")};
+const wxChar* RX_STATES[]     = {wxT("LISTENING"), wxT("PROCESS_DATA"), wxT("PROCESS_SLOW_DATA")};
+const wxChar* MODEM_TYPES[]   = {wxT("NONE"), wxT("START"), wxT("HEADER"), wxT("DATA"), wxT("EOT"), wxT("LOST")};
+const wxChar* NETWORK_TYPES[] = {wxT("NONE"), wxT("HEADER"), wxT("DATA"), wxT("TEXT"), wxT("TEMPTEXT"), wxT("STATUS1"), wxT("STATUS2"), wxT("STATUS3"), wxT("STATUS4"), wxT("STATUS5"), wxT("REGISTER")};
+const wxChar* SILENCE_TYPES[] = {wxT("MISSING"), wxT("LATE")};
+const wxChar* QUEUE_NAMES[]   = {wxT("MODEM_SPACE"), wxT("RADIO"), wxT("LOCAL"), wxT("NETWORK")};
+
+const unsigned int MODEM_DATA   = 3U;
+const unsigned int MODEM_HEADER = 2U;
+const unsigned int NET_HEADER   = 1U;
+const unsigned int NET_DATA     = 2U;
+
+#define	NAME(names, n)	((n) < (sizeof(names) / sizeof(names[0])) ? names[n] : wxT("?"))
+
+static wxString getTime(const CTraceHeader& header, wxUint64 timestamp)
+{
+	wxUint64 time = header.m_time + timestamp - header.m_clock;
+
+	time_t secs = time_t(time / 1000000U);
+	struct tm* tm = ::gmtime(&secs);
+
+	wxString text;
+	text.Printf(wxT("%04d-%02d-%02d %02d:%02d:%02d.%06u"), tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, (unsigned int)(time % 1000000U));
+
+	return text;
+}
+
+static wxString getDescription(const CTraceRecord& record)
+{
+	wxString text;
+
+	switch (record.m_event) {
+		case TE_RPT_STATE:
+			text.Printf(wxT("%s -> %s"), NAME(RPT_STATES, record.m_arg2), NAME(RPT_STATES, record.m_arg1));
+			break;
+		case TE_RX_STATE:
+			text.Printf(wxT("%s -> %s"), NAME(RX_STATES, record.m_arg2), NAME(RX_STATES, record.m_arg1));
+			break;
+		case TE_MODEM_READ:
+			text = NAME(MODEM_TYPES, record.m_arg1);
+			break;
+		case TE_NETWORK_READ:
+			if (record.m_arg1 == NET_DATA)
+				text.Printf(wxT("DATA seq: %u length: %u"), record.m_arg2, record.m_arg3);
+			else
+				text = NAME(NETWORK_TYPES, record.m_arg1);
+			break;
+		case TE_SILENCE:
+			text.Printf(wxT("%s seq: %u frames: %u"), NAME(SILENCE_TYPES, record.m_arg1), record.m_arg2, record.m_arg3);
+			break;
+		case TE_QUEUE:
+			text.Printf(wxT("%s %u bytes"), NAME(QUEUE_NAMES, record.m_arg1), record.m_arg3);
+			break;
+		default:
+			text.Printf(wxT("%u %u %u"), record.m_arg1, record.m_arg2, record.m_arg3);
+			break;
+	}
+
+	return text;
+}
+
+static void printRecord(const CTraceHeader& header, const CTraceRecord& record, wxUint64 last)
+{
+	wxUint64 delta = last == 0U ? 0U : record.m_timestamp - last;
+
+	wxPrintf(wxT("%s %9llu us  %-9s %s\n"), getTime(header, record.m_timestamp).c_str(), (unsigned long long)delta, NAME(EVENT_NAMES, record.m_event), getDescription(record).c_str());
+}
+
+// Reports the gaps in the voice from the radio and the network that are longer than the limit
+class CGapFinder {
+public:
+	CGapFinder(const CTraceHeader& header, unsigned int limit) :
+	m_header(header),
+	m_limit(wxUint64(limit) * 1000U),
+	m_lastModem(0U),
+	m_lastNetwork(0U),
+	m_maxModem(0U),
+	m_maxNetwork(0U),
+	m_silence()
+	{
+		for (unsigned int i = 0U; i < 256U; i++)
+			m_counts[i] = 0U;
+
+		m_silence[TS_MISSING] = 0U;
+		m_silence[TS_LATE]    = 0U;
+	}
+
+	void add(const CTraceRecord& record)
+	{
+		m_counts[record.m_event]++;
+
+		switch (record.m_event) {
+			case TE_MODEM_READ:
+				if (record.m_arg1 == MODEM_HEADER)
+					m_lastModem = record.m_timestamp;
+				else if (record.m_arg1 == MODEM_DATA && m_lastModem != 0U)
+					check(wxT("Radio"), record, m_lastModem, m_maxModem);
+				else
+					m_lastModem = 0U;
+				break;
+
+			case TE_NETWORK_READ:
+				if (record.m_arg1 == NET_HEADER)
+					m_lastNetwork = record.m_timestamp;
+				else if (record.m_arg1 == NET_DATA && m_lastNetwork != 0U)
+					check(wxT("Network"), record, m_lastNetwork, m_maxNetwork);
+				// The end of a network transmission is only shown by the sequence number
+				if (record.m_arg1 == NET_DATA && (record.m_arg2 & 0x40U) == 0x40U)
+					m_lastNetwork = 0U;
+				break;
+
+			case TE_SILENCE:
+				wxPrintf(wxT("%s  %s\n"), getTime(m_header, record.m_timestamp).c_str(), getDescription(record).c_str());
+				if (record.m_arg1 <= TS_LATE)
+					m_silence[record.m_arg1] += record.m_arg3;
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	void summary() const
+	{
+		wxPrintf(wxT("\n"));
+		for (unsigned int i = 0U; i < (sizeof(EVENT_NAMES) / sizeof(EVENT_NAMES[0])); i++) {
+			if (m_counts[i] > 0U)
+				wxPrintf(wxT("%-9s %u\n"), EVENT_NAMES[i], m_counts[i]);
+		}
+
+		wxPrintf(wxT("Longest radio gap: %.1f ms, longest network gap: %.1f ms\n"), float(m_maxModem) / 1000.0F, float(m_maxNetwork) / 1000.0F);
+		wxPrintf(wxT("Network frames missing when due: %u, dropped as late: %u\n"), m_silence[TS_MISSING], m_silence[TS_LATE]);
+	}
+
+private:
+	const CTraceHeader& m_header;
+	wxUint64            m_limit;
+	wxUint64            m_lastModem;
+	wxUint64            m_lastNetwork;
+	wxUint64            m_maxModem;
+	wxUint64            m_maxNetwork;
+	unsigned int        m_silence[TS_LATE + 1U];
+	unsigned int        m_counts[256U];
+
+	void check(const wxChar* source, const CTraceRecord& record, wxUint64& last, wxUint64& max)
+	{
+		wxUint64 gap = record.m_timestamp - last;
+		last = record.m_timestamp;
+
+		if (gap > max)
+			max = gap;
+
+		if (gap > m_limit)
+			wxPrintf(wxT("%s  %s gap of %.1f ms\n"), getTime(m_header, record.m_timestamp).c_str(), source, float(gap) / 1000.0F);
+	}
+};
+
+int main(int argc, char** argv)
+{
+	wxInitializer initializer(argc, argv);
+	if (!initializer.IsOk()) {
+		::fprintf(stderr, "dstarrepeatertrace: failed to initialise wxWidgets\n");
+		return 1;
+	}
+
+	wxCmdLineParser parser(argc, argv);
+	parser.AddOption(GAPS_OPTION,  wxEmptyString, wxT("report voice gaps longer than this many ms"), wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_PARAM_OPTIONAL);
+	parser.AddSwitch(REPLAY_SWITCH, wxEmptyString, wxT("print the events at the speed they happened"), wxCMD_LINE_PARAM_OPTIONAL);
+	parser.AddOption(SPEED_OPTION, wxEmptyString, wxT("replay this many times faster"), wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_PARAM_OPTIONAL);
+	parser.AddParam(FILE_PARAM, wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL);
+
+	if (parser.Parse() != 0)
+		return 1;
+
+	if (parser.GetParamCount() != 1U) {
+		parser.Usage();
+		return 1;
+	}
+
+	wxString fileName = parser.GetParam(0U);
+
+	wxFFile file;
+	if (!file.Open(fileName, wxT("rb"))) {
+		::fprintf(stderr, "dstarrepeatertrace: cannot open %s\n", (const char*)fileName.mb_str());
+		return 1;
+	}
+
+	CTraceHeader header;
+	if (file.Read(&header, sizeof(CTraceHeader)) != sizeof(CTraceHeader) || ::memcmp(header.m_magic, TRACE_MAGIC, 8U) != 0 || header.m_version != TRACE_VERSION || header.m_length == 0U) {
+		::fprintf(stderr, "dstarrepeatertrace: %s is not a trace file\n", (const char*)fileName.mb_str());
+		return 1;
+	}
+
+	CTraceRecord* records = new CTraceRecord[header.m_length];
+	size_t n = file.Read(records, header.m_length * sizeof(CTraceRecord));
+	file.Close();
+
+	if (n != header.m_length * sizeof(CTraceRecord)) {
+		::fprintf(stderr, "dstarrepeatertrace: %s is too short\n", (const char*)fileName.mb_str());
+		delete[] records;
+		return 1;
+	}
+
+	// Once the ring has wrapped, the oldest record is the one after the newest
+	wxUint64 first = header.m_count > header.m_length ? header.m_count - header.m_length : 0U;
+
+	long gaps = 0L;
+	bool findGaps = parser.Found(GAPS_OPTION, &gaps);
+
+	bool replay = parser.Found(REPLAY_SWITCH);
+
+	long speed = 1L;
+	parser.Found(SPEED_OPTION, &speed);
+	if (speed < 1L)
+		speed = 1L;
+
+	CGapFinder finder(header, findGaps ? (unsigned int)gaps : 0U);
+
+	wxUint64 last = 0U;
+	for (wxUint64 i = first; i < header.m_count; i++) {
+		const CTraceRecord& record = records[i % header.m_length];
+
+		if (findGaps) {
+			finder.add(record);
+		} else {
+			if (replay && last != 0U) {
+				wxUint64 wait = record.m_timestamp - last;
+				if (wait > MAX_REPLAY_WAIT)
+					wait = MAX_REPLAY_WAIT;
+
+				::wxMicroSleep((unsigned long)(wait / wxUint64(speed)));
+			}
+
+			printRecord(header, record, last);
+		}
+
+		last = record.m_timestamp;
+	}
+
+	if (findGaps)
+		finder.summary();
+
+	delete[] records;
+
+	return 0;
+}
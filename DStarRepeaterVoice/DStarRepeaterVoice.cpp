@@ -0,0 +1,93 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "BeaconVoice.h"
+
+#include <wx/wx.h>
+#include <wx/init.h>
+#include <wx/ffile.h>
+#include <wx/cmdline.h>
+
+const wxString AMBE_PARAM   = wxT("AMBE File");
+const wxString INDEX_PARAM  = wxT("Index File");
+const wxString OUTPUT_PARAM = wxT("Voice File");
+
+int main(int argc, char** argv)
+{
+	wxInitializer initializer(argc, argv);
+	if (!initializer.IsOk()) {
+		::fprintf(stderr, "dstarrepeatervoice: failed to initialise wxWidgets\n");
+		return 1;
+	}
+
+	wxCmdLineParser parser(argc, argv);
+	parser.AddParam(AMBE_PARAM,   wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL);
+	parser.AddParam(INDEX_PARAM,  wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL);
+	parser.AddParam(OUTPUT_PARAM, wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL);
+
+	if (parser.Parse() != 0)
+		return 1;
+
+	if (parser.GetParamCount() != 3U) {
+		parser.Usage();
+		return 1;
+	}
+
+	wxString ambeFileName = parser.GetParam(0U);
+	wxString indxFileName = parser.GetParam(1U);
+	wxString fileName     = parser.GetParam(2U);
+
+	size_t size;
+	unsigned char* image = CBeaconVoice::compile(ambeFileName, indxFileName, size);
+	if (image == NULL) {
+		::fprintf(stderr, "dstarrepeatervoice: cannot read %s or %s\n", (const char*)ambeFileName.mb_str(), (const char*)indxFileName.mb_str());
+		return 1;
+	}
+
+	wxFFile file;
+	if (!file.Open(fileName, wxT("wb"))) {
+		::fprintf(stderr, "dstarrepeatervoice: cannot open %s\n", (const char*)fileName.mb_str());
+		delete[] image;
+		return 1;
+	}
+
+	size_t n = file.Write(image, size);
+	file.Close();
+
+	if (n != size) {
+		::fprintf(stderr, "dstarrepeatervoice: cannot write %s\n", (const char*)fileName.mb_str());
+		::wxRemoveFile(fileName);
+		delete[] image;
+		return 1;
+	}
+
+	const CVoiceHeader* header = (const CVoiceHeader*)image;
+	const CVoiceSlot*   slots  = (const CVoiceSlot*)(image + sizeof(CVoiceHeader));
+
+	unsigned int words = 0U;
+	for (wxUint32 i = 0U; i < header->m_slots; i++) {
+		if (slots[i].m_nameLength > 0U)
+			words++;
+	}
+
+	::fprintf(stdout, "%s: %u words, %u frames, %u slots, seed %u\n", (const char*)fileName.mb_str(), words, header->m_frames, header->m_slots, header->m_seed);
+
+	delete[] image;
+
+	return 0;
+}
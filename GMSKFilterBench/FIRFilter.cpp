@@ -14,6 +14,17 @@
 
 #include "FIRFilter.h"
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define	FIR_USE_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define	FIR_USE_NEON
+#endif
+
 CFIRFilter::CFIRFilter(const wxFloat32* taps, unsigned int length) :
 m_taps(NULL),
 m_length(length),
@@ -90,8 +101,7 @@ void CFIRFilter::process(wxFloat32* inOut, unsigned int length)
 {
 	wxASSERT(inOut != NULL);
 
-	for (unsigned int i = 0U; i < length; i++)
-		inOut[i] = process(inOut[i]);
+	process(inOut, inOut, length);
 }
 
 void CFIRFilter::process(const wxFloat32* in, wxFloat32* out, unsigned int length)
@@ -99,8 +109,75 @@ void CFIRFilter::process(const wxFloat32* in, wxFloat32* out, unsigned int lengt
 	wxASSERT(in != NULL);
 	wxASSERT(out != NULL);
 
-	for (unsigned int i = 0U; i < length; i++)
-		out[i] = process(in[i]);
+	while (length > 0U) {
+		unsigned int n = m_bufLen - m_pointer;
+		if (n > length)
+			n = length;
+
+		// The input is copied into the history first, so in and out may be the same buffer
+		::memcpy(m_buffer + m_pointer, in, n * sizeof(wxFloat32));
+
+		filter(m_buffer + m_pointer - m_length, out, n);
+
+		m_pointer += n;
+		in        += n;
+		out       += n;
+		length    -= n;
+
+		if (m_pointer == m_bufLen) {
+			::memcpy(m_buffer, m_buffer + m_bufLen - m_length, m_length * sizeof(wxFloat32));
+			m_pointer = m_length;
+		}
+	}
+}
+
+// Each output is accumulated over the taps in the same order as the per-sample process(), with
+// separate multiplies and adds, so that the vector and scalar results are identical
+void CFIRFilter::filter(const wxFloat32* in, wxFloat32* out, unsigned int length) const
+{
+	unsigned int i = 0U;
+
+#if defined(__AVX__)
+	for (; (i + 8U) <= length; i += 8U) {
+		__m256 acc = _mm256_setzero_ps();
+
+		for (unsigned int j = 0U; j < m_length; j++)
+			acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(in + i + j), _mm256_set1_ps(m_taps[j])));
+
+		_mm256_storeu_ps(out + i, acc);
+	}
+#endif
+
+#if defined(FIR_USE_SSE)
+	for (; (i + 4U) <= length; i += 4U) {
+		__m128 acc = _mm_setzero_ps();
+
+		for (unsigned int j = 0U; j < m_length; j++)
+			acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(in + i + j), _mm_set1_ps(m_taps[j])));
+
+		_mm_storeu_ps(out + i, acc);
+	}
+#elif defined(FIR_USE_NEON)
+	for (; (i + 4U) <= length; i += 4U) {
+		float32x4_t acc = vdupq_n_f32(0.0F);
+
+		for (unsigned int j = 0U; j < m_length; j++)
+			acc = vaddq_f32(acc, vmulq_f32(vld1q_f32(in + i + j), vdupq_n_f32(m_taps[j])));
+
+		vst1q_f32(out + i, acc);
+	}
+#endif
+
+	for (; i < length; i++) {
+		const wxFloat32* a = in + i;
+		const wxFloat32* b = m_taps;
+
+		wxFloat32 val = 0.0F;
+		for (unsigned int j = 0U; j < m_length; j++)
+			val += (*a++) * (*b++);
+
+		out[i] = val;
+	}
 }
 
 void CFIRFilter::reset()
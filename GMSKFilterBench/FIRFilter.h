@@ -16,6 +16,7 @@
 
 #include <wx/wx.h>
 
+// The general filter that CDStarGMSKFilter replaced, kept here to measure the new filter against
 class CFIRFilter {
 public:
 	CFIRFilter(const wxFloat32* taps, unsigned int length);
@@ -36,6 +37,8 @@ private:
 	wxFloat32*   m_buffer;
 	unsigned int m_bufLen;
 	unsigned int m_pointer;
+
+	void      filter(const wxFloat32* in, wxFloat32* out, unsigned int length) const;
 };
 
 #endif
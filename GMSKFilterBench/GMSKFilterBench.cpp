@@ -0,0 +1,183 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+#include "DStarGMSKFilter.h"
+#include "DStarDefines.h"
+#include "FIRFilter.h"
+#include "Bench.h"
+#include "Utils.h"
+
+#include <wx/wx.h>
+
+#include <cstdlib>
+#include <cmath>
+
+const char BENCH_NAME[] = "gmskfilterbench";
+
+const CBenchOption BENCH_OPTIONS[] = {
+	{wxT("seconds"), wxT("seconds of audio to filter"),                 60L,  1L, 3600L},
+	{wxT("block"),   wxT("samples in each block from the sound card"), 960L, 1L, 48000L}};
+
+const unsigned int BENCH_OPTION_COUNT = 2U;
+
+// The taps used by the modulator and demodulator before CDStarGMSKFilter, from gaussfir(0.5, 4, 10)
+const wxFloat32 COEFFS_TABLE[] = {
+	0.000000000000003F, 0.000000000000065F, 0.000000000001037F, 0.000000000014448F, 0.000000000174579F,
+	0.000000001829471F, 0.000000016627294F, 0.000000131062698F, 0.000000895979719F, 0.000005312253663F, 0.000027316243802F,
+	0.000121821714020F, 0.000471183399421F, 0.001580581180127F, 0.004598383433830F, 0.011602594308899F, 0.025390226926262F,
+	0.048188078330624F, 0.079318443411643F, 0.113232294527059F, 0.140193533802410F, 0.150538369557851F, 0.140193533802410F,
+	0.113232294527059F, 0.079318443411643F, 0.048188078330623F, 0.025390226926262F, 0.011602594308899F, 0.004598383433830F,
+	0.001580581180127F, 0.000471183399421F, 0.000121821714020F, 0.000027316243802F, 0.000005312253663F, 0.000000895979719F,
+	0.000000131062698F, 0.000000016627294F, 0.000000001829471F, 0.000000000174579F, 0.000000000014448F, 0.000000000001037F,
+	0.000000000000065F, 0.000000000000003F};
+
+const unsigned int COEFFS_LENGTH = 43U;
+
+const unsigned int SAMPLE_RATE = 48000U;
+
+static wxFloat32 maxDifference(const wxFloat32* a, const wxFloat32* b, unsigned int length)
+{
+	wxFloat32 max = 0.0F;
+
+	for (unsigned int i = 0U; i < length; i++) {
+		wxFloat32 diff = ::fabs(a[i] - b[i]);
+		if (diff > max)
+			max = diff;
+	}
+
+	return max;
+}
+
+static void report(const wxChar* name, wxUint64 oldTime, wxUint64 newTime, unsigned int count, const wxChar* unit, wxFloat32 diff)
+{
+	wxPrintf(wxT("%-16s CFIRFilter %6.1f ns, CDStarGMSKFilter %6.1f ns a %s, %.2fx faster, max difference %.1e\n"), name,
+		CBench::perItem(oldTime, count), CBench::perItem(newTime, count), unit,
+		double(oldTime) / double(newTime), diff);
+}
+
+// The demodulator filters each block of samples from the sound card in place
+static void demodulateBlocks(const wxFloat32* audio, unsigned int length, unsigned int block)
+{
+	wxFloat32* oldOut = new wxFloat32[length];
+	wxFloat32* newOut = new wxFloat32[length];
+
+	::memcpy(oldOut, audio, length * sizeof(wxFloat32));
+	::memcpy(newOut, audio, length * sizeof(wxFloat32));
+
+	CFIRFilter oldFilter(COEFFS_TABLE, COEFFS_LENGTH);
+	CDStarGMSKFilter newFilter;
+
+	wxUint64 start = CUtils::getTimestamp();
+	for (unsigned int i = 0U; i < length; i += block)
+		oldFilter.process(oldOut + i, (length - i) < block ? length - i : block);
+	wxUint64 oldTime = CUtils::getTimestamp() - start;
+
+	start = CUtils::getTimestamp();
+	for (unsigned int i = 0U; i < length; i += block)
+		newFilter.process(newOut + i, (length - i) < block ? length - i : block);
+	wxUint64 newTime = CUtils::getTimestamp() - start;
+
+	report(wxT("RX block"), oldTime, newTime, length, wxT("sample"), maxDifference(oldOut, newOut, length));
+
+	delete[] oldOut;
+	delete[] newOut;
+}
+
+// The demodulator filters one sample at a time when it is not given blocks
+static void demodulateSamples(const wxFloat32* audio, unsigned int length)
+{
+	wxFloat32* oldOut = new wxFloat32[length];
+	wxFloat32* newOut = new wxFloat32[length];
+
+	CFIRFilter oldFilter(COEFFS_TABLE, COEFFS_LENGTH);
+	CDStarGMSKFilter newFilter;
+
+	wxUint64 start = CUtils::getTimestamp();
+	for (unsigned int i = 0U; i < length; i++)
+		oldOut[i] = oldFilter.process(audio[i]);
+	wxUint64 oldTime = CUtils::getTimestamp() - start;
+
+	start = CUtils::getTimestamp();
+	for (unsigned int i = 0U; i < length; i++)
+		newOut[i] = newFilter.process(audio[i]);
+	wxUint64 newTime = CUtils::getTimestamp() - start;
+
+	report(wxT("RX sample"), oldTime, newTime, length, wxT("sample"), maxDifference(oldOut, newOut, length));
+
+	delete[] oldOut;
+	delete[] newOut;
+}
+
+// The modulator used to run the filter over each bit held for the bit length, the new filter
+// interpolates the bit instead
+static void modulate(unsigned int bits)
+{
+	unsigned int length = bits * DSTAR_RADIO_BIT_LENGTH;
+
+	bool* data = new bool[bits];
+	for (unsigned int i = 0U; i < bits; i++)
+		data[i] = (::rand() & 0x01) == 0x01;
+
+	wxFloat32* oldOut = new wxFloat32[length];
+	wxFloat32* newOut = new wxFloat32[length];
+
+	CFIRFilter oldFilter(COEFFS_TABLE, COEFFS_LENGTH);
+	CDStarGMSKFilter newFilter;
+
+	wxUint64 start = CUtils::getTimestamp();
+	for (unsigned int i = 0U; i < bits; i++) {
+		for (unsigned int j = 0U; j < DSTAR_RADIO_BIT_LENGTH; j++)
+			oldOut[i * DSTAR_RADIO_BIT_LENGTH + j] = oldFilter.process(data[i] ? -0.5F : 0.5F);
+	}
+	wxUint64 oldTime = CUtils::getTimestamp() - start;
+
+	start = CUtils::getTimestamp();
+	for (unsigned int i = 0U; i < bits; i++)
+		newFilter.interpolate(data[i] ? -0.5F : 0.5F, newOut + i * DSTAR_RADIO_BIT_LENGTH, DSTAR_RADIO_BIT_LENGTH);
+	wxUint64 newTime = CUtils::getTimestamp() - start;
+
+	report(wxT("TX bit"), oldTime, newTime, bits, wxT("bit"), maxDifference(oldOut, newOut, length));
+
+	CBench::sink(oldOut[length - 1U] + newOut[length - 1U]);
+
+	delete[] data;
+	delete[] oldOut;
+	delete[] newOut;
+}
+
+int run()
+{
+	long seconds = CBench::getOption(wxT("seconds"));
+	long block   = CBench::getOption(wxT("block"));
+
+	unsigned int length = (unsigned int)seconds * SAMPLE_RATE;
+
+	// Noise in place of the audio from the radio, the filter does the same work whatever it is given
+	wxFloat32* audio = new wxFloat32[length];
+	for (unsigned int i = 0U; i < length; i++)
+		audio[i] = wxFloat32(::rand()) / wxFloat32(RAND_MAX) - 0.5F;
+
+	wxPrintf(wxT("%ld seconds at %u samples/s, blocks of %ld samples\n"), seconds, SAMPLE_RATE, block);
+
+	demodulateBlocks(audio, length, (unsigned int)block);
+	demodulateSamples(audio, length);
+	modulate(length / DSTAR_RADIO_BIT_LENGTH);
+
+	delete[] audio;
+
+	return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "GMSKModemLibUsb.h"
+#include "DStarDefines.h"
+#include "MockLibUsb.h"
+#include "Bench.h"
+#include "Utils.h"
+
+#include <wx/wx.h>
+
+const char BENCH_NAME[] = "gmskmodembench";
+
+const CBenchOption BENCH_OPTIONS[] = {
+	{wxT("latency"),  wxT("time taken by each USB transfer in us"),       1000L, 0L, 1000000L},
+	{wxT("failures"), wxT("USB transfers that time out, per thousand"),      0L, 0L, 1000L},
+	{wxT("trials"),   wxT("headers to detect at each poll interval"),       50L, 1L, 100000L},
+	{wxT("frames"),   wxT("data frames to write"),                        1000L, 1L, 1000000L}};
+
+const unsigned int BENCH_OPTION_COUNT = 4U;
+
+// The header poll intervals of the controller, every cycle under Linux and every 100ms under Windows
+const unsigned int POLL_INTERVALS[] = {15U, 100U};
+
+const unsigned int IDLE_TIME = 2000U;
+
+static void headerLatency(CGMSKModemLibUsb& modem, unsigned int interval, unsigned int trials)
+{
+	wxUint64 total = 0U;
+	wxUint64 max   = 0U;
+
+	for (unsigned int i = 0U; i < trials; i++) {
+		// The header arrives at any point in a poll cycle
+		wxUint64 start = CUtils::getTimestamp() + wxUint64(::rand() % 200) * 1000U;
+		CMockGMSK::setHeader(start);
+
+		unsigned char buffer[90U];
+		while (!modem.readHeader(buffer, 90U))
+			::wxMilliSleep(interval);
+
+		wxUint64 latency = CUtils::getTimestamp() - start;
+		total += latency;
+		if (latency > max)
+			max = latency;
+	}
+
+	// With no header the poll is all that is left on the bus
+	CMockGMSK::clearCounts();
+
+	wxUint64 end = CUtils::getTimestamp() + wxUint64(IDLE_TIME) * 1000U;
+	while (CUtils::getTimestamp() < end) {
+		unsigned char buffer[90U];
+		modem.readHeader(buffer, 90U);
+		::wxMilliSleep(interval);
+	}
+
+	float rate = float(CMockGMSK::getTransfers()) * 1000.0F / float(IDLE_TIME);
+
+	wxPrintf(wxT("Header poll every %3u ms: mean detect %.1f ms, max %.1f ms, idle USB load %.1f transfers/s\n"), interval, float(total) / float(trials) / 1000.0F, float(max) / 1000.0F, rate);
+}
+
+static void throughput(CGMSKModemLibUsb& modem, unsigned int frames)
+{
+	unsigned char frame[DV_FRAME_LENGTH_BYTES];
+	::memset(frame, 0x55U, DV_FRAME_LENGTH_BYTES);
+
+	CMockGMSK::clearCounts();
+
+	unsigned int shortWrites = 0U;
+
+	wxUint64 start = CUtils::getTimestamp();
+
+	// As the controller does it, the space is asked for before each frame
+	for (unsigned int i = 0U; i < frames; i++) {
+		modem.hasSpace();
+
+		int ret = modem.writeData(frame, DV_FRAME_LENGTH_BYTES);
+		if (ret < int(DV_FRAME_LENGTH_BYTES))
+			shortWrites++;
+	}
+
+	wxUint64 elapsed = CUtils::getTimestamp() - start;
+
+	// This goes over the pipe after the last of the writes
+	modem.hasSpace();
+
+	float perFrame = float(elapsed) / float(frames) / 1000.0F;
+
+	wxPrintf(wxT("Data: %u frames in %.1f ms, %.2f ms a frame (%.0f%% of a %u ms frame), %u transfers failed, %u frames cut short, %u of %u bytes written\n"), frames, float(elapsed) / 1000.0F, perFrame, perFrame * 100.0F / float(DSTAR_FRAME_TIME_MS), DSTAR_FRAME_TIME_MS, CMockGMSK::getFailures(), shortWrites, CMockGMSK::getData(), frames * DV_FRAME_LENGTH_BYTES);
+}
+
+int run()
+{
+	long latency  = CBench::getOption(wxT("latency"));
+	long failures = CBench::getOption(wxT("failures"));
+	long trials   = CBench::getOption(wxT("trials"));
+	long frames   = CBench::getOption(wxT("frames"));
+
+	CMockGMSK::setLatency((unsigned int)latency);
+
+	CGMSKModemLibUsb modem(0x0300U);
+	if (!modem.open()) {
+		CBench::error("cannot open the mock modem");
+		return 1;
+	}
+
+	// Failures only start once the modem is open, as a failed GET_VERSION closes it
+	CMockGMSK::setFailures((unsigned int)failures);
+
+	wxPrintf(wxT("USB transfer time %ld us, %ld per thousand time out\n"), latency, failures);
+
+	for (unsigned int i = 0U; i < (sizeof(POLL_INTERVALS) / sizeof(POLL_INTERVALS[0])); i++)
+		headerLatency(modem, POLL_INTERVALS[i], (unsigned int)trials);
+
+	throughput(modem, (unsigned int)frames);
+
+	modem.close();
+
+	return 0;
+}
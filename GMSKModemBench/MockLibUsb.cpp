@@ -0,0 +1,364 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Just enough of libusb for CGMSKModemLibUsb, the bench links this in place of the library
+
+#include "DStarDefines.h"
+#include "MockLibUsb.h"
+#include "Utils.h"
+
+#include <libusb-1.0/libusb.h>
+
+const uint8_t SET_AD_INIT     = 0x00U;
+const uint8_t PUT_DATA        = 0x10U;
+const uint8_t GET_DATA        = 0x11U;
+const uint8_t GET_HEADER      = 0x21U;
+const uint8_t GET_AD_STATUS   = 0x30U;
+const uint8_t GET_REMAINSPACE = 0x50U;
+const uint8_t GET_VERSION     = 0xFFU;
+
+const unsigned char COS_OnOff = 0x02U;
+
+const char VERSION[] = "Mock GMSK 1.0";
+
+const unsigned int MAX_PENDING = 32U;
+
+struct libusb_context {
+	int m_dummy;
+};
+
+struct libusb_device_handle {
+	int m_dummy;
+};
+
+struct CPending {
+	libusb_transfer* m_transfer;
+	wxUint64         m_due;
+	bool             m_cancelled;
+};
+
+static libusb_context       s_context;
+static libusb_device_handle s_handle;
+
+static unsigned int s_latency      = 1000U;
+static unsigned int s_failures     = 0U;
+static wxUint64     s_headerTime   = 0U;
+static unsigned int s_headerPos    = RADIO_HEADER_LENGTH_BYTES;
+static unsigned int s_versionPos   = 0U;
+static unsigned int s_transfers    = 0U;
+static unsigned int s_failed       = 0U;
+static unsigned int s_data         = 0U;
+static wxUint64     s_pipeFree     = 0U;
+
+static CPending     s_pending[MAX_PENDING];
+static unsigned int s_pendingCount = 0U;
+
+// The control pipe takes one transfer at a time, so each one finishes the set latency after the one before
+static wxUint64 takePipe()
+{
+	wxUint64 now = CUtils::getTimestamp();
+	if (s_pipeFree < now)
+		s_pipeFree = now;
+
+	s_pipeFree += s_latency;
+
+	return s_pipeFree;
+}
+
+static bool headerReady()
+{
+	return s_headerPos < RADIO_HEADER_LENGTH_BYTES && CUtils::getTimestamp() >= s_headerTime;
+}
+
+// Returns what the modem would for one control transfer
+static int process(uint8_t request, unsigned char* data, uint16_t length)
+{
+	s_transfers++;
+
+	if (s_failures > 0U && (unsigned int)(::rand() % 1000) < s_failures) {
+		s_failed++;
+		return LIBUSB_ERROR_TIMEOUT;
+	}
+
+	switch (request) {
+		case GET_VERSION: {
+				unsigned int n = sizeof(VERSION) - 1U - s_versionPos;
+				if (n > length)
+					n = length;
+				::memcpy(data, VERSION + s_versionPos, n);
+				s_versionPos += n;
+				return int(n);
+			}
+
+		case PUT_DATA:
+			s_data += length;
+			return length;
+
+		case GET_DATA:
+			return 0;
+
+		case GET_HEADER: {
+				if (!headerReady())
+					return 0;
+
+				unsigned int n = RADIO_HEADER_LENGTH_BYTES - s_headerPos;
+				if (n > GMSK_MODEM_DATA_LENGTH)
+					n = GMSK_MODEM_DATA_LENGTH;
+				if (n > length)
+					n = length;
+
+				// The header bytes are only counted, the contents don't matter here
+				::memset(data, 0x20U, n);
+				s_headerPos += n;
+				return int(n);
+			}
+
+		case GET_AD_STATUS:
+			if (length < 1U)
+				return 0;
+			data[0U] = headerReady() ? COS_OnOff : 0x00U;
+			return 1;
+
+		case GET_REMAINSPACE:
+			if (length < 1U)
+				return 0;
+			data[0U] = 0xFFU;
+			return 1;
+
+		default:
+			return length;
+	}
+}
+
+static void complete(CPending& pending)
+{
+	libusb_transfer* transfer = pending.m_transfer;
+
+	if (pending.m_cancelled) {
+		transfer->status        = LIBUSB_TRANSFER_CANCELLED;
+		transfer->actual_length = 0;
+	} else {
+		unsigned char* setup = transfer->buffer;
+		uint16_t length = uint16_t(setup[6U] | (setup[7U] << 8));
+
+		int ret = process(setup[1U], transfer->buffer + LIBUSB_CONTROL_SETUP_SIZE, length);
+		if (ret < 0) {
+			transfer->status        = LIBUSB_TRANSFER_TIMED_OUT;
+			transfer->actual_length = 0;
+		} else {
+			transfer->status        = LIBUSB_TRANSFER_COMPLETED;
+			transfer->actual_length = ret;
+		}
+	}
+
+	// The callback may submit the transfer again, it has a new place on the pipe by then
+	transfer->callback(transfer);
+
+	if ((transfer->flags & LIBUSB_TRANSFER_FREE_BUFFER) != 0U)
+		::free(transfer->buffer);
+	if ((transfer->flags & LIBUSB_TRANSFER_FREE_TRANSFER) != 0U)
+		::libusb_free_transfer(transfer);
+}
+
+// Completes the first of the transfers due by the given time, in the order they are on the pipe
+static bool completeNext(wxUint64 time)
+{
+	unsigned int next = s_pendingCount;
+	for (unsigned int i = 0U; i < s_pendingCount; i++) {
+		if (s_pending[i].m_due <= time && (next == s_pendingCount || s_pending[i].m_due < s_pending[next].m_due))
+			next = i;
+	}
+
+	if (next == s_pendingCount)
+		return false;
+
+	CPending pending = s_pending[next];
+	s_pending[next] = s_pending[--s_pendingCount];
+
+	complete(pending);
+
+	return true;
+}
+
+static void sleepUntil(wxUint64 time)
+{
+	wxUint64 now = CUtils::getTimestamp();
+	if (time > now)
+		::wxMicroSleep((unsigned long)(time - now));
+}
+
+void CMockGMSK::setLatency(unsigned int us)
+{
+	s_latency = us;
+}
+
+void CMockGMSK::setFailures(unsigned int perMille)
+{
+	s_failures = perMille;
+}
+
+void CMockGMSK::setHeader(wxUint64 time)
+{
+	s_headerTime = time;
+	s_headerPos  = 0U;
+}
+
+bool CMockGMSK::hasHeader()
+{
+	return s_headerPos < RADIO_HEADER_LENGTH_BYTES;
+}
+
+void CMockGMSK::clearCounts()
+{
+	s_transfers = 0U;
+	s_failed    = 0U;
+	s_data      = 0U;
+}
+
+unsigned int CMockGMSK::getTransfers()
+{
+	return s_transfers;
+}
+
+unsigned int CMockGMSK::getFailures()
+{
+	return s_failed;
+}
+
+unsigned int CMockGMSK::getData()
+{
+	return s_data;
+}
+
+int LIBUSB_CALL libusb_init(libusb_context** context)
+{
+	*context = &s_context;
+	return 0;
+}
+
+void LIBUSB_CALL libusb_exit(libusb_context*)
+{
+}
+
+libusb_device_handle* LIBUSB_CALL libusb_open_device_with_vid_pid(libusb_context*, uint16_t, uint16_t)
+{
+	s_versionPos = 0U;
+	return &s_handle;
+}
+
+void LIBUSB_CALL libusb_close(libusb_device_handle*)
+{
+}
+
+int LIBUSB_CALL libusb_set_configuration(libusb_device_handle*, int)
+{
+	return 0;
+}
+
+const char* LIBUSB_CALL libusb_error_name(int error)
+{
+	return error == LIBUSB_ERROR_TIMEOUT ? "LIBUSB_ERROR_TIMEOUT" : "LIBUSB_ERROR_OTHER";
+}
+
+int LIBUSB_CALL libusb_control_transfer(libusb_device_handle*, uint8_t, uint8_t request, uint16_t, uint16_t, unsigned char* data, uint16_t length, unsigned int)
+{
+	wxUint64 due = takePipe();
+
+	// The transfers submitted before this one go first, and their callbacks are run while it waits, as
+	// libusb handles events inside its synchronous calls
+	for (;;) {
+		wxUint64 next = due;
+		for (unsigned int i = 0U; i < s_pendingCount; i++) {
+			if (s_pending[i].m_due < next)
+				next = s_pending[i].m_due;
+		}
+
+		if (next >= due)
+			break;
+
+		sleepUntil(next);
+		completeNext(next);
+	}
+
+	sleepUntil(due);
+
+	return process(request, data, length);
+}
+
+libusb_transfer* LIBUSB_CALL libusb_alloc_transfer(int)
+{
+	libusb_transfer* transfer = (libusb_transfer*)::calloc(1U, sizeof(libusb_transfer));
+
+	return transfer;
+}
+
+void LIBUSB_CALL libusb_free_transfer(libusb_transfer* transfer)
+{
+	::free(transfer);
+}
+
+int LIBUSB_CALL libusb_submit_transfer(libusb_transfer* transfer)
+{
+	if (s_pendingCount >= MAX_PENDING)
+		return LIBUSB_ERROR_NO_MEM;
+
+	CPending& pending = s_pending[s_pendingCount++];
+	pending.m_transfer  = transfer;
+	pending.m_due       = takePipe();
+	pending.m_cancelled = false;
+
+	return 0;
+}
+
+int LIBUSB_CALL libusb_cancel_transfer(libusb_transfer* transfer)
+{
+	for (unsigned int i = 0U; i < s_pendingCount; i++) {
+		if (s_pending[i].m_transfer == transfer) {
+			s_pending[i].m_cancelled = true;
+			s_pending[i].m_due       = 0U;
+			return 0;
+		}
+	}
+
+	return LIBUSB_ERROR_NOT_FOUND;
+}
+
+int LIBUSB_CALL libusb_handle_events_timeout_completed(libusb_context*, struct timeval* tv, int*)
+{
+	wxUint64 timeout = wxUint64(tv->tv_sec) * 1000000U + tv->tv_usec;
+	wxUint64 end     = CUtils::getTimestamp() + timeout;
+
+	for (;;) {
+		wxUint64 now = CUtils::getTimestamp();
+
+		bool done = false;
+		while (completeNext(now))
+			done = true;
+
+		if (done || now >= end)
+			return 0;
+
+		wxUint64 next = end;
+		for (unsigned int i = 0U; i < s_pendingCount; i++) {
+			if (s_pending[i].m_due < next)
+				next = s_pending[i].m_due;
+		}
+
+		sleepUntil(next);
+	}
+}
@@ -0,0 +1,41 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	MockLibUsb_H
+#define	MockLibUsb_H
+
+#include <wx/wx.h>
+
+// The GMSK modem behind the mock libusb in this directory. Every control transfer, synchronous or
+// not, takes the set latency on the one control pipe and a set share of them fail with a timeout. The modem has one header
+// ready from the given time, which it hands out eight bytes at a time.
+class CMockGMSK {
+public:
+	static void setLatency(unsigned int us);
+	static void setFailures(unsigned int perMille);
+
+	static void setHeader(wxUint64 time);
+	static bool hasHeader();
+
+	static void         clearCounts();
+	static unsigned int getTransfers();
+	static unsigned int getFailures();
+	static unsigned int getData();
+};
+
+#endif
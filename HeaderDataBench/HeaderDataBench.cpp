@@ -0,0 +1,297 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+#include "ReferenceHeaderData.h"
+#include "DStarDefines.h"
+#include "OutputQueue.h"
+#include "HeaderData.h"
+#include "Bench.h"
+#include "Utils.h"
+
+#include <wx/wx.h>
+
+#include <cstdlib>
+#include <new>
+
+const char BENCH_NAME[] = "headerdatabench";
+
+const CBenchOption BENCH_OPTIONS[] = {
+	{wxT("count"), wxT("times to run each operation"), 100000L, 1L, 100000000L}};
+
+const unsigned int BENCH_OPTION_COUNT = 1U;
+
+// Every allocation made by the program goes through these
+static unsigned long m_allocations = 0UL;
+
+void* operator new(size_t size)
+{
+	m_allocations++;
+
+	void* p = ::malloc(size > 0U ? size : 1U);
+	if (p == NULL)
+		throw std::bad_alloc();
+
+	return p;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* p) throw()
+{
+	::free(p);
+}
+
+void operator delete[](void* p) throw()
+{
+	::free(p);
+}
+
+static unsigned char          m_data[RADIO_HEADER_LENGTH_BYTES];
+static unsigned char          m_callsign[LONG_CALLSIGN_LENGTH];
+static CHeaderData*           m_header = NULL;
+static CHeaderData*           m_other  = NULL;
+static COutputQueue*          m_queue  = NULL;
+static CReferenceHeaderData*  m_oldHeader = NULL;
+static CReferenceHeaderData*  m_oldOther  = NULL;
+static wxString*              m_myCall = NULL;
+static unsigned int           m_matches = 0U;
+
+// The same operations on the string based CHeaderData from before, done the way its callers did them
+static void oldParse()
+{
+	CReferenceHeaderData header(m_data, RADIO_HEADER_LENGTH_BYTES, true);
+	if (header.isValid())
+		m_matches++;
+}
+
+static void oldCopy()
+{
+	CReferenceHeaderData header(*m_oldHeader);
+	if (header.isValid())
+		m_matches++;
+}
+
+static void oldAssign()
+{
+	*m_oldOther = *m_oldHeader;
+}
+
+// A header passed between threads or queues on the heap, as the callers did
+static void oldHandoff()
+{
+	CReferenceHeaderData* header = new CReferenceHeaderData(*m_oldHeader);
+	delete header;
+}
+
+static void oldSetCallsign()
+{
+	m_oldOther->setRptCall2(*m_myCall);
+}
+
+static void oldCompareString()
+{
+	if (m_oldHeader->getMyCall1().IsSameAs(*m_myCall))
+		m_matches++;
+}
+
+static void oldComparePrefix()
+{
+	if (m_oldHeader->getMyCall1().Left(4U).IsSameAs(m_myCall->Left(4U)))
+		m_matches++;
+}
+
+static void oldSetFlags()
+{
+	m_oldOther->setRepeaterMode(true);
+	m_oldOther->setFlag2(0x00U);
+}
+
+static void oldGetString()
+{
+	wxString callsign = m_oldHeader->getMyCall1();
+	if (callsign.Len() == LONG_CALLSIGN_LENGTH)
+		m_matches++;
+}
+
+static void oldSetString()
+{
+	m_oldOther->setMyCall1(*m_myCall);
+}
+
+static void parse()
+{
+	CHeaderData header(m_data, RADIO_HEADER_LENGTH_BYTES, true);
+	if (header.isValid())
+		m_matches++;
+}
+
+static void copy()
+{
+	CHeaderData header(*m_header);
+	if (header.isValid())
+		m_matches++;
+}
+
+static void assign()
+{
+	*m_other = *m_header;
+}
+
+// The same through an output queue, which now holds the header by value
+static void handoff()
+{
+	m_queue->setHeader(*m_header);
+	m_queue->getHeader(*m_other);
+}
+
+static void getData()
+{
+	m_header->getData(m_data, RADIO_HEADER_LENGTH_BYTES, true);
+}
+
+static void getCallsign()
+{
+	m_header->getMyCall1(m_callsign);
+}
+
+static void setCallsign()
+{
+	m_other->setRptCall2(m_callsign);
+}
+
+static void compareString()
+{
+	if (m_header->isMyCall1(*m_myCall))
+		m_matches++;
+}
+
+static void comparePrefix()
+{
+	if (m_header->isMyCall1(m_myCall->wc_str(), 4U))
+		m_matches++;
+}
+
+static void setFlags()
+{
+	m_other->setRepeaterMode(true);
+	m_other->setFlag2(0x00U);
+}
+
+static void getString()
+{
+	wxString callsign = m_header->getMyCall1();
+	if (callsign.Len() == LONG_CALLSIGN_LENGTH)
+		m_matches++;
+}
+
+static void setString()
+{
+	m_other->setMyCall1(*m_myCall);
+}
+
+struct CHeaderOperation {
+	const wxChar* m_name;
+	void        (*m_before)();	// NULL where the old CHeaderData had no equivalent
+	void        (*m_after)();
+	bool          m_hot;		// Used on the path of every header and must not allocate
+};
+
+static const CHeaderOperation OPERATIONS[] = {
+	{wxT("Parse with checksum"),   oldParse,         parse,         true},
+	{wxT("Copy construct"),        oldCopy,          copy,          true},
+	{wxT("Assign"),                oldAssign,        assign,        true},
+	{wxT("Queue handoff"),         oldHandoff,       handoff,       true},
+	{wxT("getData()"),             NULL,             getData,       true},
+	{wxT("getMyCall1(bytes)"),     NULL,             getCallsign,   true},
+	{wxT("setRptCall2(bytes)"),    oldSetCallsign,   setCallsign,   true},
+	{wxT("isMyCall1(string)"),     oldCompareString, compareString, true},
+	{wxT("isMyCall1(prefix)"),     oldComparePrefix, comparePrefix, true},
+	{wxT("Set flags"),             oldSetFlags,      setFlags,      true},
+	{wxT("getMyCall1() string"),   oldGetString,     getString,     false},
+	{wxT("setMyCall1(string)"),    oldSetString,     setString,     false}
+};
+
+// Runs an operation count times, giving back the allocations and the time in ns a call
+static void measure(void (*function)(), long count, double& allocations, double& ns)
+{
+	unsigned long before = m_allocations;
+	wxUint64 start = CUtils::getTimestamp();
+
+	for (long i = 0L; i < count; i++)
+		function();
+
+	wxUint64 elapsed = CUtils::getTimestamp() - start;
+
+	allocations = double(m_allocations - before) / double(count);
+	ns          = CBench::perItem(elapsed, (unsigned int)count);
+}
+
+int run()
+{
+	long count = CBench::getOption(wxT("count"));
+
+	CHeaderData header(wxT("G4KLX   "), wxT("ID51"), wxT("CQCQCQ  "), wxT("GB7XX  B"), wxT("GB7XX  G"));
+	header.getData(m_data, RADIO_HEADER_LENGTH_BYTES, true);
+
+	m_header    = new CHeaderData(header);
+	m_other     = new CHeaderData;
+	m_queue     = new COutputQueue(DV_FRAME_LENGTH_BYTES + 2U, 1U);
+	m_oldHeader = new CReferenceHeaderData(m_data, RADIO_HEADER_LENGTH_BYTES, true);
+	m_oldOther  = new CReferenceHeaderData;
+	m_myCall    = new wxString(wxT("G4KLX   "));
+
+	bool failed = false;
+
+	wxPrintf(wxT("%-22s %-24s %s\n"), wxT("Operation"), wxT("Before"), wxT("After"));
+
+	for (unsigned int i = 0U; i < (sizeof(OPERATIONS) / sizeof(OPERATIONS[0])); i++) {
+		wxString before = wxT("-");
+		if (OPERATIONS[i].m_before != NULL) {
+			double allocations, ns;
+			measure(OPERATIONS[i].m_before, count, allocations, ns);
+			before.Printf(wxT("%.2f allocs, %6.0f ns"), allocations, ns);
+		}
+
+		double allocations, ns;
+		measure(OPERATIONS[i].m_after, count, allocations, ns);
+
+		bool bad = OPERATIONS[i].m_hot && allocations > 0.0;
+		if (bad)
+			failed = true;
+
+		wxPrintf(wxT("%-22s %-24s %.2f allocs, %6.0f ns%s\n"), OPERATIONS[i].m_name, before.c_str(), allocations, ns, bad ? wxT(" - FAILED") : wxT(""));
+	}
+
+	CBench::sink(m_matches);
+
+	delete m_myCall;
+	delete m_oldOther;
+	delete m_oldHeader;
+	delete m_queue;
+	delete m_other;
+	delete m_header;
+
+	if (failed) {
+		CBench::error("a header operation on the hot path allocated");
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ *   Copyright (C) 2009,2011,2013 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "CCITTChecksumReverse.h"
+#include "ReferenceHeaderData.h"
+#include "DStarDefines.h"
+
+CReferenceHeaderData::CReferenceHeaderData() :
+m_time(),
+m_myCall1(),
+m_myCall2(),
+m_yourCall(),
+m_rptCall1(),
+m_rptCall2(),
+m_flag1(0x00),
+m_flag2(0x00),
+m_flag3(0x00),
+m_valid(false)
+{
+}
+
+CReferenceHeaderData::CReferenceHeaderData(const CReferenceHeaderData& header) :
+m_time(header.m_time),
+m_myCall1(header.m_myCall1),
+m_myCall2(header.m_myCall2),
+m_yourCall(header.m_yourCall),
+m_rptCall1(header.m_rptCall1),
+m_rptCall2(header.m_rptCall2),
+m_flag1(header.m_flag1),
+m_flag2(header.m_flag2),
+m_flag3(header.m_flag3),
+m_valid(header.m_valid)
+{
+}
+
+CReferenceHeaderData::CReferenceHeaderData(const unsigned char* data, unsigned int length, bool check) :
+m_time(),
+m_myCall1(),
+m_myCall2(),
+m_yourCall(),
+m_rptCall1(),
+m_rptCall2(),
+m_flag1(0x00),
+m_flag2(0x00),
+m_flag3(0x00),
+m_valid(true)
+{
+	wxASSERT(data != NULL);
+	wxASSERT(length >= (RADIO_HEADER_LENGTH_BYTES - 2U));
+
+	const unsigned char* p = data;
+	m_flag1 = *p++;
+	m_flag2 = *p++;
+	m_flag3 = *p++;
+
+	m_rptCall2 = wxString((const char*)p, wxConvLocal, LONG_CALLSIGN_LENGTH);
+	p += LONG_CALLSIGN_LENGTH;
+
+	m_rptCall1 = wxString((const char*)p, wxConvLocal, LONG_CALLSIGN_LENGTH);
+	p += LONG_CALLSIGN_LENGTH;
+
+	m_yourCall = wxString((const char*)p, wxConvLocal, LONG_CALLSIGN_LENGTH);
+	p += LONG_CALLSIGN_LENGTH;
+
+	m_myCall1  = wxString((const char*)p,  wxConvLocal, LONG_CALLSIGN_LENGTH);
+	p += LONG_CALLSIGN_LENGTH;
+
+	m_myCall2  = wxString((const char*)p,  wxConvLocal, SHORT_CALLSIGN_LENGTH);
+
+	m_time.SetToCurrent();
+
+	// We have a checksum, check it if asked
+	if (length >= RADIO_HEADER_LENGTH_BYTES && check) {
+		CCCITTChecksumReverse cksum;
+
+		cksum.update(data, RADIO_HEADER_LENGTH_BYTES - 2U);
+
+		m_valid = cksum.check(data + RADIO_HEADER_LENGTH_BYTES - 2U);
+	}
+}
+
+CReferenceHeaderData::CReferenceHeaderData(const wxString& myCall1,  const wxString& myCall2, const wxString& yourCall,
+						 const wxString& rptCall1, const wxString& rptCall2, unsigned char flag1,
+						 unsigned char flag2, unsigned char flag3) :
+m_time(),
+m_myCall1(myCall1),
+m_myCall2(myCall2),
+m_yourCall(yourCall),
+m_rptCall1(rptCall1),
+m_rptCall2(rptCall2),
+m_flag1(flag1),
+m_flag2(flag2),
+m_flag3(flag3),
+m_valid(true)
+{
+	m_time.SetToCurrent();
+
+	m_myCall1.Append(wxT(' '),  LONG_CALLSIGN_LENGTH);
+	m_myCall2.Append(wxT(' '),  SHORT_CALLSIGN_LENGTH);
+	m_yourCall.Append(wxT(' '), LONG_CALLSIGN_LENGTH);
+	m_rptCall1.Append(wxT(' '), LONG_CALLSIGN_LENGTH);
+	m_rptCall2.Append(wxT(' '), LONG_CALLSIGN_LENGTH);
+
+	m_myCall1.Truncate(LONG_CALLSIGN_LENGTH);
+	m_myCall2.Truncate(SHORT_CALLSIGN_LENGTH);
+	m_yourCall.Truncate(LONG_CALLSIGN_LENGTH);
+	m_rptCall1.Truncate(LONG_CALLSIGN_LENGTH);
+	m_rptCall2.Truncate(LONG_CALLSIGN_LENGTH);
+}
+
+CReferenceHeaderData::~CReferenceHeaderData()
+{
+}
+
+wxString CReferenceHeaderData::getMyCall1() const
+{
+	return m_myCall1;
+}
+
+void CReferenceHeaderData::setMyCall1(const wxString& callsign)
+{
+	m_myCall1 = callsign;
+	m_myCall1.Append(wxT(' '), LONG_CALLSIGN_LENGTH);
+	m_myCall1.Truncate(LONG_CALLSIGN_LENGTH);
+}
+
+void CReferenceHeaderData::setRptCall2(const wxString& callsign)
+{
+	m_rptCall2 = callsign;
+	m_rptCall2.Append(wxT(' '), LONG_CALLSIGN_LENGTH);
+	m_rptCall2.Truncate(LONG_CALLSIGN_LENGTH);
+}
+
+void CReferenceHeaderData::setRepeaterMode(bool set)
+{
+	if (set)
+		m_flag1 |= REPEATER_MASK;
+	else
+		m_flag1 &= ~REPEATER_MASK;
+}
+
+void CReferenceHeaderData::setFlag2(unsigned char flag)
+{
+	m_flag2 = flag;
+}
+
+bool CReferenceHeaderData::isValid() const
+{
+	return m_valid;
+}
+
+CReferenceHeaderData& CReferenceHeaderData::operator=(const CReferenceHeaderData& header)
+{
+	if (&header != this) {
+		m_time     = header.m_time;
+		m_myCall1  = header.m_myCall1;
+		m_myCall2  = header.m_myCall2;
+		m_yourCall = header.m_yourCall;
+		m_rptCall1 = header.m_rptCall1;
+		m_rptCall2 = header.m_rptCall2;
+		m_flag1    = header.m_flag1;
+		m_flag2    = header.m_flag2;
+		m_flag3    = header.m_flag3;
+		m_valid    = header.m_valid;
+	}
+
+	return *this;
+}
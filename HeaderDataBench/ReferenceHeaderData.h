@@ -0,0 +1,62 @@
+/*
+ *   Copyright (C) 2009,2013 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	ReferenceHeaderData_H
+#define	ReferenceHeaderData_H
+
+#include <wx/wx.h>
+#include <wx/datetime.h>
+
+// CHeaderData when it held its callsigns as wxStrings, kept here to measure it against
+class CReferenceHeaderData {
+public:
+	CReferenceHeaderData();
+	CReferenceHeaderData(const CReferenceHeaderData& header);
+	CReferenceHeaderData(const unsigned char* data, unsigned int length, bool check);
+	CReferenceHeaderData(const wxString& myCall1,  const wxString& myCall2, const wxString& yourCall,
+				const wxString& rptCall1, const wxString& rptCall2, unsigned char flag1 = 0x00,
+				unsigned char flag2 = 0x00, unsigned char flag3 = 0x00);
+	~CReferenceHeaderData();
+
+	wxString   getMyCall1() const;
+
+	void setFlag2(unsigned char flag);
+
+	void setMyCall1(const wxString& callsign);
+	void setRptCall2(const wxString& callsign);
+
+	void setRepeaterMode(bool set);
+
+	bool isValid() const;
+
+	CReferenceHeaderData& operator=(const CReferenceHeaderData& header);
+
+private:
+	wxDateTime    m_time;
+	wxString      m_myCall1;
+	wxString      m_myCall2;
+	wxString      m_yourCall;
+	wxString      m_rptCall1;
+	wxString      m_rptCall2;
+	unsigned char m_flag1;
+	unsigned char m_flag2;
+	unsigned char m_flag3;
+	bool          m_valid;
+};
+
+#endif
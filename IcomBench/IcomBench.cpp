@@ -0,0 +1,139 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+#include "IcomController.h"
+#include "DStarDefines.h"
+#include "HeaderData.h"
+#include "IcomRadio.h"
+#include "Bench.h"
+#include "Utils.h"
+
+#include <wx/wx.h>
+
+const char BENCH_NAME[] = "icombench";
+
+const CBenchOption BENCH_OPTIONS[] = {
+	{wxT("loss"),   wxT("frames and ACKs lost on the link, per thousand"),                    20L, 0L, 1000L},
+	{wxT("delay"),  wxT("time from the header to the first frame going over the air in ms"), 100L, 0L, 10000L},
+	{wxT("burst"),  wxT("data frames arriving together from the network"),                     1L, 1L, 100L},
+	{wxT("frames"), wxT("data frames in each transmission"),                                 500L, 1L, 100000L}};
+
+const unsigned int BENCH_OPTION_COUNT = 4U;
+
+// How many frames the radio holds waiting to be played, around the window of the controller
+const unsigned int RADIO_DEPTHS[] = {2U, 3U, 4U, 6U, 8U};
+
+static bool transmit(CIcomController& controller, CIcomRadio& radio, unsigned int frames, unsigned int burst, unsigned int delay)
+{
+	CHeaderData header;
+	header.setMyCall1(wxT("G4KLX"));
+	header.setYourCall(wxT("CQCQCQ"));
+
+	unsigned char frame[DV_FRAME_LENGTH_BYTES];
+	::memset(frame, 0x55U, DV_FRAME_LENGTH_BYTES);
+
+	controller.writeHeader(header);
+
+	// The frames come in from the network at the frame rate, in bursts if the network is uneven
+	wxUint64 start = CUtils::getTimestamp();
+
+	for (unsigned int i = 0U; i < frames; i++) {
+		wxUint64 due = start + wxUint64((i / burst) + 1U) * burst * DSTAR_FRAME_TIME_MS * 1000U;
+
+		wxUint64 now = CUtils::getTimestamp();
+		if (due > now)
+			::wxMicroSleep((unsigned long)(due - now));
+
+		controller.writeData(frame, DV_FRAME_LENGTH_BYTES, false);
+	}
+
+	controller.writeData(frame, DV_FRAME_LENGTH_BYTES, true);
+
+	wxUint64 end = CUtils::getTimestamp() + wxUint64(delay + 2000U) * 1000U;
+	while (!radio.isIdle()) {
+		if (CUtils::getTimestamp() > end)
+			return false;
+
+		::wxMilliSleep(10UL);
+	}
+
+	return true;
+}
+
+int run()
+{
+	long loss   = CBench::getOption(wxT("loss"));
+	long delay  = CBench::getOption(wxT("delay"));
+	long burst  = CBench::getOption(wxT("burst"));
+	long frames = CBench::getOption(wxT("frames"));
+
+	CIcomRadio radio;
+	if (!radio.open()) {
+		CBench::error("cannot open the pseudo terminal");
+		return 1;
+	}
+
+	radio.setDelay((unsigned int)delay);
+
+	radio.Create();
+	radio.Run();
+
+	// A pseudo terminal has no RTS line to assert
+	CIcomController controller(radio.getPort(), false);
+	if (!controller.start()) {
+		CBench::error("cannot start the Icom controller");
+		radio.stop();
+		return 1;
+	}
+
+	// The controller polls for two seconds before the first ping
+	wxUint64 end = CUtils::getTimestamp() + 5000000U;
+	while (!radio.isConnected() && CUtils::getTimestamp() < end)
+		::wxMilliSleep(10UL);
+
+	if (!radio.isConnected()) {
+		CBench::error("the controller never pinged the radio");
+		controller.stop();
+		radio.stop();
+		return 1;
+	}
+
+	// Only lose frames once connected, as the pings are not sent again
+	radio.setLoss((unsigned int)loss);
+
+	wxPrintf(wxT("Window of %u frames, %ld per thousand frames and ACKs lost, %ld ms to the first frame over the air, frames arriving %ld at a time\n"), ICOM_TX_WINDOW, loss, delay, burst);
+
+	for (unsigned int i = 0U; i < (sizeof(RADIO_DEPTHS) / sizeof(RADIO_DEPTHS[0])); i++) {
+		radio.setDepth(RADIO_DEPTHS[i]);
+		radio.clearStats();
+
+		bool ok = transmit(controller, radio, (unsigned int)frames, (unsigned int)burst, (unsigned int)delay);
+
+		CIcomRadioStats stats = radio.getStats();
+
+		unsigned int retries = stats.m_sent > ((unsigned int)frames + 1U) ? stats.m_sent - ((unsigned int)frames + 1U) : 0U;
+
+		wxPrintf(wxT("Radio holds %u: %u retries (%.1f%%), %u lost, %u repeats, %u refused, %u/%ld played, %u gaps, held at most %u, at most %u ahead%s\n"),
+			RADIO_DEPTHS[i], retries, float(retries) * 100.0F / float(frames + 1L), stats.m_lost, stats.m_duplicates, stats.m_overflows,
+			stats.m_played, frames, stats.m_missing, stats.m_maxHeld, stats.m_maxAhead, ok ? wxT("") : wxT(", never ended"));
+	}
+
+	controller.stop();
+	radio.stop();
+
+	return 0;
+}
@@ -0,0 +1,324 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+#include "IcomRadio.h"
+#include "Utils.h"
+
+#include <sys/select.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <fcntl.h>
+#include <cerrno>
+
+CIcomRadio::CIcomRadio() :
+wxThread(wxTHREAD_JOINABLE),
+m_fd(-1),
+m_port(),
+m_stopped(false),
+m_mutex(),
+m_loss(0U),
+m_depth(4U),
+m_delay(100U),
+m_connected(false),
+m_length(0U),
+m_active(false),
+m_start(0U),
+m_next(0U),
+m_end(0U),
+m_heldCount(0U),
+m_stats()
+{
+	::memset(m_held, 0x00U, 256U * sizeof(bool));
+	::memset(&m_stats, 0x00U, sizeof(CIcomRadioStats));
+}
+
+CIcomRadio::~CIcomRadio()
+{
+}
+
+bool CIcomRadio::open()
+{
+	m_fd = ::posix_openpt(O_RDWR | O_NOCTTY);
+	if (m_fd < 0) {
+		wxLogError(wxT("Cannot open a pseudo terminal, errno=%d"), errno);
+		return false;
+	}
+
+	if (::grantpt(m_fd) < 0 || ::unlockpt(m_fd) < 0) {
+		wxLogError(wxT("Cannot unlock the pseudo terminal, errno=%d"), errno);
+		::close(m_fd);
+		m_fd = -1;
+		return false;
+	}
+
+	m_port = wxString(::ptsname(m_fd), wxConvLocal);
+
+	return true;
+}
+
+wxString CIcomRadio::getPort() const
+{
+	return m_port;
+}
+
+void CIcomRadio::setLoss(unsigned int perMille)
+{
+	wxMutexLocker locker(m_mutex);
+
+	m_loss = perMille;
+}
+
+void CIcomRadio::setDepth(unsigned int depth)
+{
+	wxASSERT(depth > 0U && depth < 128U);
+
+	wxMutexLocker locker(m_mutex);
+
+	m_depth = depth;
+}
+
+void CIcomRadio::setDelay(unsigned int ms)
+{
+	wxMutexLocker locker(m_mutex);
+
+	m_delay = ms;
+}
+
+bool CIcomRadio::isConnected()
+{
+	wxMutexLocker locker(m_mutex);
+
+	return m_connected;
+}
+
+bool CIcomRadio::isIdle()
+{
+	wxMutexLocker locker(m_mutex);
+
+	return !m_active;
+}
+
+CIcomRadioStats CIcomRadio::getStats()
+{
+	wxMutexLocker locker(m_mutex);
+
+	return m_stats;
+}
+
+void CIcomRadio::clearStats()
+{
+	wxMutexLocker locker(m_mutex);
+
+	::memset(&m_stats, 0x00U, sizeof(CIcomRadioStats));
+}
+
+void* CIcomRadio::Entry()
+{
+	while (!m_stopped) {
+		fd_set fds;
+		FD_ZERO(&fds);
+		FD_SET(m_fd, &fds);
+
+		struct timeval tv;
+		tv.tv_sec  = 0;
+		tv.tv_usec = 1000;
+
+		unsigned char buffer[100U];
+		ssize_t len = 0;
+
+		// Until the controller opens its end a read fails with EIO
+		int n = ::select(m_fd + 1, &fds, NULL, NULL, &tv);
+		if (n > 0)
+			len = ::read(m_fd, buffer, 100U);
+
+		if (n > 0 && len <= 0)
+			::wxMilliSleep(1UL);
+
+		wxMutexLocker locker(m_mutex);
+
+		if (len > 0)
+			receive(buffer, len);
+
+		play();
+	}
+
+	::close(m_fd);
+	m_fd = -1;
+
+	return NULL;
+}
+
+void CIcomRadio::stop()
+{
+	m_stopped = true;
+
+	Wait();
+}
+
+void CIcomRadio::receive(const unsigned char* data, unsigned int length)
+{
+	for (unsigned int i = 0U; i < length; i++) {
+		// Polls and the ends of frames
+		if (m_length == 0U && data[i] == 0xFFU)
+			continue;
+
+		m_buffer[m_length++] = data[i];
+
+		// The length byte counts the rest of the frame
+		unsigned int total = m_buffer[0U] + 1U;
+		if (total > 50U) {
+			wxLogWarning(wxT("Invalid frame length from the controller - 0x%02X"), m_buffer[0U]);
+			m_length = 0U;
+			continue;
+		}
+
+		if (m_length < 2U || m_length < total)
+			continue;
+
+		switch (m_buffer[1U]) {
+			case 0x02U:
+				write((unsigned char*)"\x03\x03\x00\xFF", 4U);
+				m_connected = true;
+				break;
+			case 0x20U:
+				receiveHeader();
+				break;
+			case 0x22U:
+				receiveData();
+				break;
+			default:
+				wxLogWarning(wxT("Unknown frame type from the controller - 0x%02X"), m_buffer[1U]);
+				break;
+		}
+
+		m_length = 0U;
+	}
+}
+
+void CIcomRadio::receiveHeader()
+{
+	if (isLost()) {
+		m_stats.m_lost++;
+		return;
+	}
+
+	// A header repeated while transmitting had its ACK lost
+	if (!m_active) {
+		::memset(m_held, 0x00U, 256U * sizeof(bool));
+		m_heldCount = 0U;
+		m_next      = 0U;
+		m_end       = 0xFFFFFFFFU;
+		m_start     = CUtils::getTimestamp();
+		m_active    = true;
+	}
+
+	if (isLost())
+		m_stats.m_lost++;
+	else
+		write((unsigned char*)"\x03\x21\x00\xFF", 4U);
+}
+
+void CIcomRadio::receiveData()
+{
+	m_stats.m_sent++;
+
+	if (isLost()) {
+		m_stats.m_lost++;
+		return;
+	}
+
+	unsigned char seqNo = m_buffer[2U];
+	bool end = (m_buffer[3U] & 0x40U) == 0x40U;
+
+	// Anything at or after the next frame to play is a new frame or a repeat of one being held
+	unsigned int ahead = (seqNo - m_next) & 0xFFU;
+
+	if (!m_active || ahead >= 128U || m_held[seqNo]) {
+		m_stats.m_duplicates++;
+
+		// The end arriving after its slot still ends the transmission
+		if (m_active && end && ahead >= 128U)
+			m_active = false;
+	} else if (m_heldCount >= m_depth) {
+		m_stats.m_overflows++;
+		return;
+	} else {
+		m_held[seqNo] = true;
+		m_heldCount++;
+
+		if (m_heldCount > m_stats.m_maxHeld)
+			m_stats.m_maxHeld = m_heldCount;
+		if ((ahead + 1U) > m_stats.m_maxAhead)
+			m_stats.m_maxAhead = ahead + 1U;
+
+		if (end)
+			m_end = m_next + ahead;
+	}
+
+	if (isLost()) {
+		m_stats.m_lost++;
+		return;
+	}
+
+	unsigned char ack[5U];
+	ack[0U] = 0x04U;
+	ack[1U] = 0x23U;
+	ack[2U] = seqNo;
+	ack[3U] = 0x00U;
+	ack[4U] = 0xFFU;
+
+	write(ack, 5U);
+}
+
+// A frame goes over the air every 20ms, or nothing if it hasn't arrived in time
+void CIcomRadio::play()
+{
+	if (!m_active)
+		return;
+
+	wxUint64 now = CUtils::getTimestamp();
+
+	while (m_active && now >= (m_start + wxUint64(m_delay) * 1000U + wxUint64(m_next) * 20000U)) {
+		unsigned char seqNo = m_next & 0xFFU;
+
+		if (m_next == m_end) {
+			m_held[seqNo] = false;
+			m_heldCount--;
+			m_active = false;
+		} else if (m_held[seqNo]) {
+			m_held[seqNo] = false;
+			m_heldCount--;
+			m_stats.m_played++;
+		} else {
+			m_stats.m_missing++;
+		}
+
+		m_next++;
+	}
+}
+
+bool CIcomRadio::isLost() const
+{
+	return (unsigned int)(::rand() % 1000) < m_loss;
+}
+
+void CIcomRadio::write(const unsigned char* data, unsigned int length)
+{
+	ssize_t len = ::write(m_fd, data, length);
+	if (len != ssize_t(length))
+		wxLogWarning(wxT("Error when writing to the controller"));
+}
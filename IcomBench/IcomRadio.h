@@ -0,0 +1,90 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+#ifndef	IcomRadio_H
+#define	IcomRadio_H
+
+#include <wx/wx.h>
+
+// What the radio saw of one transmission
+struct CIcomRadioStats {
+	unsigned int m_sent;		// Data frames put on the link by the controller, first copies and retries
+	unsigned int m_lost;		// Frames and ACKs lost on the link
+	unsigned int m_duplicates;	// Frames received again after being ACKed
+	unsigned int m_overflows;	// Frames refused, without an ACK, as the radio was full
+	unsigned int m_played;		// Frames sent over the air in their slot
+	unsigned int m_missing;		// Slots with nothing to send
+	unsigned int m_maxHeld;		// Most frames held by the radio at once
+	unsigned int m_maxAhead;	// Most frames ahead of the next to be played
+};
+
+// An Icom radio at the far end of a pseudo terminal. It answers pings, ACKs headers and data frames
+// and plays them out every 20ms, starting the set delay after the header. It holds no more than the
+// set number of frames waiting to be played, refusing any more, and a set share of the frames and
+// ACKs are lost on the link.
+class CIcomRadio : public wxThread {
+public:
+	CIcomRadio();
+	virtual ~CIcomRadio();
+
+	bool open();
+
+	// The name of the pseudo terminal for the controller to open
+	wxString getPort() const;
+
+	void setLoss(unsigned int perMille);
+	void setDepth(unsigned int depth);
+	void setDelay(unsigned int ms);
+
+	bool isConnected();
+	bool isIdle();
+
+	CIcomRadioStats getStats();
+	void clearStats();
+
+	virtual void* Entry();
+
+	void stop();
+
+private:
+	int             m_fd;
+	wxString        m_port;
+	bool            m_stopped;
+	wxMutex         m_mutex;
+	unsigned int    m_loss;
+	unsigned int    m_depth;
+	unsigned int    m_delay;
+	bool            m_connected;
+	unsigned char   m_buffer[50U];
+	unsigned int    m_length;
+	bool            m_active;
+	wxUint64        m_start;
+	unsigned int    m_next;
+	unsigned int    m_end;
+	bool            m_held[256U];
+	unsigned int    m_heldCount;
+	CIcomRadioStats m_stats;
+
+	void receive(const unsigned char* data, unsigned int length);
+	void receiveHeader();
+	void receiveData();
+	void play();
+	bool isLost() const;
+	void write(const unsigned char* data, unsigned int length);
+};
+
+#endif
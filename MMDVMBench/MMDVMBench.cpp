@@ -0,0 +1,193 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+#include "MMDVMController.h"
+#include "DStarDefines.h"
+#include "EventPoller.h"
+#include "HeaderData.h"
+#include "MMDVMModem.h"
+#include "Bench.h"
+#include "Utils.h"
+
+#include <wx/wx.h>
+
+#include <sys/resource.h>
+#include <algorithm>
+#include <vector>
+
+const char BENCH_NAME[] = "mmdvmbench";
+
+const CBenchOption BENCH_OPTIONS[] = {
+	{wxT("seconds"), wxT("seconds to measure the idle controller for"),  10L, 1L, 3600L},
+	{wxT("frames"),  wxT("data frames in the received transmission"),   500L, 1L, 100000L}};
+
+const unsigned int BENCH_OPTION_COUNT = 2U;
+
+static double getSeconds(const struct timeval& tv)
+{
+	return double(tv.tv_sec) + double(tv.tv_usec) / 1000000.0;
+}
+
+// The CPU time and context switches between two samples
+static void difference(const struct rusage& before, const struct rusage& after, double& cpu, long& switches)
+{
+	cpu = getSeconds(after.ru_utime) + getSeconds(after.ru_stime) - getSeconds(before.ru_utime) - getSeconds(before.ru_stime);
+	switches = (after.ru_nvcsw + after.ru_nivcsw) - (before.ru_nvcsw + before.ru_nivcsw);
+}
+
+// The process less this thread and the modem is the controller thread
+static void idle(CMMDVMModem& modem, unsigned int seconds)
+{
+	struct rusage processBefore, mainBefore;
+	::getrusage(RUSAGE_SELF, &processBefore);
+	::getrusage(RUSAGE_THREAD, &mainBefore);
+	struct rusage modemBefore = modem.getUsage();
+	unsigned int pollsBefore = modem.getPolls();
+
+	::wxSleep(int(seconds));
+
+	struct rusage processAfter, mainAfter;
+	::getrusage(RUSAGE_SELF, &processAfter);
+	::getrusage(RUSAGE_THREAD, &mainAfter);
+	struct rusage modemAfter = modem.getUsage();
+	unsigned int pollsAfter = modem.getPolls();
+
+	double processCPU, mainCPU, modemCPU;
+	long processSwitches, mainSwitches, modemSwitches;
+	difference(processBefore, processAfter, processCPU, processSwitches);
+	difference(mainBefore, mainAfter, mainCPU, mainSwitches);
+	difference(modemBefore, modemAfter, modemCPU, modemSwitches);
+
+	double cpu = processCPU - mainCPU - modemCPU;
+	long switches = processSwitches - mainSwitches - modemSwitches;
+
+	wxPrintf(wxT("Idle for %u s: controller thread used %.3f%% of a CPU, %.1f wakeups/s, %.1f status polls/s\n"), seconds,
+		cpu * 100.0 / double(seconds), double(switches) / double(seconds), double(pollsAfter - pollsBefore) / double(seconds));
+}
+
+static void report(const wxChar* name, std::vector<wxUint64>& latencies)
+{
+	std::sort(latencies.begin(), latencies.end());
+
+	wxUint64 total = 0U;
+	for (unsigned int i = 0U; i < latencies.size(); i++)
+		total += latencies[i];
+
+	unsigned int count = latencies.size();
+
+	wxPrintf(wxT("%-22s mean %7.1f us, median %5u us, 99%% %5u us, max %5u us\n"), name, double(total) / double(count),
+		(unsigned int)latencies[count / 2U], (unsigned int)latencies[(count * 99U) / 100U], (unsigned int)latencies[count - 1U]);
+}
+
+// The repeater thread is woken by the poller when a record is queued, as here
+static bool receive(CMMDVMController& controller, CMMDVMModem& modem, unsigned int frames)
+{
+	CEventPoller poller;
+	if (!poller.open())
+		return false;
+
+	controller.setPoller(&poller);
+
+	std::vector<wxUint64> queued;
+	std::vector<wxUint64> taken;
+
+	modem.receive(frames);
+
+	bool ended = false;
+	wxUint64 end = CUtils::getTimestamp() + wxUint64(frames + 100U) * DSTAR_FRAME_TIME_MS * 1000U;
+
+	while (!ended && CUtils::getTimestamp() < end) {
+		poller.wait(DSTAR_FRAME_TIME_MS);
+
+		DSMT_TYPE type;
+		while ((type = controller.read()) != DSMTT_NONE) {
+			wxUint64 now = CUtils::getTimestamp();
+
+			if (type == DSMTT_HEADER) {
+				CHeaderData header;
+				controller.readHeader(header);
+			} else if (type == DSMTT_DATA) {
+				unsigned char data[DV_FRAME_LENGTH_BYTES];
+				controller.readData(data, DV_FRAME_LENGTH_BYTES);
+
+				wxUint64 sent;
+				::memcpy(&sent, data, sizeof(wxUint64));
+
+				queued.push_back(controller.getReadTime() - sent);
+				taken.push_back(now - sent);
+			} else if (type == DSMTT_EOT || type == DSMTT_LOST) {
+				ended = true;
+			}
+		}
+	}
+
+	controller.setPoller(NULL);
+	poller.close();
+
+	wxPrintf(wxT("Received %u/%u frames%s\n"), (unsigned int)queued.size(), frames, ended ? wxT("") : wxT(", never ended"));
+
+	if (queued.empty())
+		return false;
+
+	report(wxT("Written to queued"), queued);
+	report(wxT("Written to taken"), taken);
+
+	return ended && queued.size() == frames;
+}
+
+int run()
+{
+	long seconds = CBench::getOption(wxT("seconds"));
+	long frames  = CBench::getOption(wxT("frames"));
+
+	CMMDVMModem modem;
+	if (!modem.open()) {
+		CBench::error("cannot open the pseudo terminal");
+		return 1;
+	}
+
+	modem.Create();
+	modem.Run();
+
+	// A pseudo terminal has no RTS line to assert
+	CMMDVMController controller(modem.getPort(), wxEmptyString, false, false, false, 100U, 50U, 50U, false);
+	if (!controller.start()) {
+		CBench::error("cannot start the MMDVM controller");
+		modem.stop();
+		return 1;
+	}
+
+	// The controller has already waited two seconds for the modem before asking for its version
+	if (!modem.isConfigured()) {
+		CBench::error("the controller never configured the modem");
+		controller.stop();
+		modem.stop();
+		return 1;
+	}
+
+	// Let the thread settle into its loop
+	::wxSleep(1);
+
+	idle(modem, (unsigned int)seconds);
+
+	bool ok = receive(controller, modem, (unsigned int)frames);
+
+	controller.stop();
+	modem.stop();
+
+	return ok ? 0 : 1;
+}
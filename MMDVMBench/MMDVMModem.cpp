@@ -0,0 +1,259 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "MMDVMModem.h"
+#include "DStarDefines.h"
+#include "Utils.h"
+
+#include <sys/select.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <fcntl.h>
+#include <cerrno>
+
+const unsigned char MMDVM_FRAME_START  = 0xE0U;
+
+const unsigned char MMDVM_GET_VERSION  = 0x00U;
+const unsigned char MMDVM_GET_STATUS   = 0x01U;
+const unsigned char MMDVM_SET_CONFIG   = 0x02U;
+
+const unsigned char MMDVM_DSTAR_HEADER = 0x10U;
+const unsigned char MMDVM_DSTAR_DATA   = 0x11U;
+const unsigned char MMDVM_DSTAR_EOT    = 0x13U;
+
+const unsigned char MMDVM_ACK          = 0x70U;
+
+const unsigned int FRAME_TIME = 20000U;
+
+CMMDVMModem::CMMDVMModem() :
+wxThread(wxTHREAD_JOINABLE),
+m_fd(-1),
+m_port(),
+m_stopped(false),
+m_mutex(),
+m_configured(false),
+m_polls(0U),
+m_length(0U),
+m_frames(0U),
+m_sent(0U),
+m_start(0U),
+m_usage()
+{
+	::memset(&m_usage, 0x00U, sizeof(struct rusage));
+}
+
+CMMDVMModem::~CMMDVMModem()
+{
+}
+
+bool CMMDVMModem::open()
+{
+	m_fd = ::posix_openpt(O_RDWR | O_NOCTTY);
+	if (m_fd < 0) {
+		wxLogError(wxT("Cannot open a pseudo terminal, errno=%d"), errno);
+		return false;
+	}
+
+	if (::grantpt(m_fd) < 0 || ::unlockpt(m_fd) < 0) {
+		wxLogError(wxT("Cannot unlock the pseudo terminal, errno=%d"), errno);
+		::close(m_fd);
+		m_fd = -1;
+		return false;
+	}
+
+	m_port = wxString(::ptsname(m_fd), wxConvLocal);
+
+	return true;
+}
+
+wxString CMMDVMModem::getPort() const
+{
+	return m_port;
+}
+
+bool CMMDVMModem::isConfigured()
+{
+	wxMutexLocker locker(m_mutex);
+
+	return m_configured;
+}
+
+void CMMDVMModem::receive(unsigned int frames)
+{
+	wxMutexLocker locker(m_mutex);
+
+	m_frames = frames;
+	m_sent   = 0U;
+	m_start  = CUtils::getTimestamp();
+
+	// The header goes now and the first data frame one frame time later
+	unsigned char header[RADIO_HEADER_LENGTH_BYTES + 3U];
+	::memset(header, 0x00U, RADIO_HEADER_LENGTH_BYTES + 3U);
+	header[0U] = MMDVM_FRAME_START;
+	header[1U] = RADIO_HEADER_LENGTH_BYTES + 3U;
+	header[2U] = MMDVM_DSTAR_HEADER;
+	::memset(header + 6U, ' ', RADIO_HEADER_LENGTH_BYTES - 5U);
+
+	write(header, RADIO_HEADER_LENGTH_BYTES + 3U);
+}
+
+bool CMMDVMModem::isReceiving()
+{
+	wxMutexLocker locker(m_mutex);
+
+	return m_sent < m_frames;
+}
+
+unsigned int CMMDVMModem::getPolls()
+{
+	wxMutexLocker locker(m_mutex);
+
+	return m_polls;
+}
+
+struct rusage CMMDVMModem::getUsage()
+{
+	wxMutexLocker locker(m_mutex);
+
+	return m_usage;
+}
+
+void* CMMDVMModem::Entry()
+{
+	while (!m_stopped) {
+		fd_set fds;
+		FD_ZERO(&fds);
+		FD_SET(m_fd, &fds);
+
+		// Wake for the next frame to send, or to notice being stopped
+		struct timeval tv;
+		tv.tv_sec  = 0;
+		tv.tv_usec = 100000;
+
+		m_mutex.Lock();
+		if (m_sent < m_frames) {
+			wxUint64 due = m_start + wxUint64(m_sent + 1U) * FRAME_TIME;
+			wxUint64 now = CUtils::getTimestamp();
+			tv.tv_usec = due > now ? long(due - now) : 0L;
+		}
+		m_mutex.Unlock();
+
+		unsigned char buffer[200U];
+		ssize_t len = 0;
+
+		// Until the controller opens its end a read fails with EIO
+		int n = ::select(m_fd + 1, &fds, NULL, NULL, &tv);
+		if (n > 0)
+			len = ::read(m_fd, buffer, 200U);
+
+		if (n > 0 && len <= 0)
+			::wxMilliSleep(1UL);
+
+		wxMutexLocker locker(m_mutex);
+
+		if (len > 0)
+			command(buffer, len);
+
+		send();
+
+		::getrusage(RUSAGE_THREAD, &m_usage);
+	}
+
+	::close(m_fd);
+	m_fd = -1;
+
+	return NULL;
+}
+
+void CMMDVMModem::stop()
+{
+	m_stopped = true;
+
+	Wait();
+}
+
+void CMMDVMModem::command(const unsigned char* data, unsigned int length)
+{
+	for (unsigned int i = 0U; i < length; i++) {
+		if (m_length == 0U && data[i] != MMDVM_FRAME_START)
+			continue;
+
+		m_buffer[m_length++] = data[i];
+
+		if (m_length < 3U || m_length < m_buffer[1U])
+			continue;
+
+		switch (m_buffer[2U]) {
+			case MMDVM_GET_VERSION: {
+					unsigned char reply[] = {MMDVM_FRAME_START, 15U, MMDVM_GET_VERSION, 1U, 'M', 'M', 'D', 'V', 'M', 'M', 'o', 'd', 'e', 'm', ' '};
+					write(reply, 15U);
+				}
+				break;
+			case MMDVM_GET_STATUS: {
+					// D-Star enabled, not transmitting, with room for ten frames
+					unsigned char reply[] = {MMDVM_FRAME_START, 7U, MMDVM_GET_STATUS, 0x01U, 0x01U, 0x00U, 10U};
+					write(reply, 7U);
+					m_polls++;
+				}
+				break;
+			case MMDVM_SET_CONFIG: {
+					unsigned char reply[] = {MMDVM_FRAME_START, 4U, MMDVM_ACK, MMDVM_SET_CONFIG};
+					write(reply, 4U);
+					m_configured = true;
+				}
+				break;
+			default:
+				break;
+		}
+
+		m_length = 0U;
+	}
+}
+
+void CMMDVMModem::send()
+{
+	if (m_sent >= m_frames)
+		return;
+
+	wxUint64 now = CUtils::getTimestamp();
+	if (now < (m_start + wxUint64(m_sent + 1U) * FRAME_TIME))
+		return;
+
+	unsigned char frame[DV_FRAME_LENGTH_BYTES + 3U];
+	::memset(frame, 0x00U, DV_FRAME_LENGTH_BYTES + 3U);
+	frame[0U] = MMDVM_FRAME_START;
+	frame[1U] = DV_FRAME_LENGTH_BYTES + 3U;
+	frame[2U] = MMDVM_DSTAR_DATA;
+	::memcpy(frame + 3U, &now, sizeof(wxUint64));
+
+	write(frame, DV_FRAME_LENGTH_BYTES + 3U);
+
+	m_sent++;
+
+	if (m_sent == m_frames) {
+		unsigned char eot[] = {MMDVM_FRAME_START, 3U, MMDVM_DSTAR_EOT};
+		write(eot, 3U);
+	}
+}
+
+void CMMDVMModem::write(const unsigned char* data, unsigned int length)
+{
+	ssize_t len = ::write(m_fd, data, length);
+	if (len != ssize_t(length))
+		wxLogWarning(wxT("Error when writing to the controller"));
+}
@@ -0,0 +1,72 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	MMDVMModem_H
+#define	MMDVMModem_H
+
+#include <wx/wx.h>
+
+#include <sys/resource.h>
+
+// An MMDVM at the far end of a pseudo terminal. It answers the version, status and config commands,
+// and when asked receives a transmission, sending a header, a data frame every 20ms and an end. The
+// first eight bytes of each data frame hold the time it was written, from CUtils::getTimestamp().
+class CMMDVMModem : public wxThread {
+public:
+	CMMDVMModem();
+	virtual ~CMMDVMModem();
+
+	bool open();
+
+	// The name of the pseudo terminal for the controller to open
+	wxString getPort() const;
+
+	bool isConfigured();
+
+	void receive(unsigned int frames);
+	bool isReceiving();
+
+	unsigned int getPolls();
+
+	// The CPU used by this thread, which is not the controller's
+	struct rusage getUsage();
+
+	virtual void* Entry();
+
+	void stop();
+
+private:
+	int           m_fd;
+	wxString      m_port;
+	bool          m_stopped;
+	wxMutex       m_mutex;
+	bool          m_configured;
+	unsigned int  m_polls;
+	unsigned char m_buffer[200U];
+	unsigned int  m_length;
+	unsigned int  m_frames;
+	unsigned int  m_sent;
+	wxUint64      m_start;
+	struct rusage m_usage;
+
+	void command(const unsigned char* data, unsigned int length);
+	void send();
+	void write(const unsigned char* data, unsigned int length);
+};
+
+#endif
@@ -0,0 +1,227 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+#include "ReferenceRadioHeaderDecoder.h"
+#include "CCITTChecksumReverse.h"
+#include "DStarGMSKDemodulator.h"
+#include "DStarGMSKModulator.h"
+#include "RadioHeaderFEC.h"
+#include "DStarDefines.h"
+#include "Bench.h"
+
+#include <wx/wx.h>
+
+#include <cstdlib>
+#include <cmath>
+
+const char BENCH_NAME[] = "radioheaderbench";
+
+const CBenchOption BENCH_OPTIONS[] = {
+	{wxT("trials"), wxT("headers sent at each signal to noise ratio"), 1000L, 1L, 1000000L}};
+
+const unsigned int BENCH_OPTION_COUNT = 1U;
+
+// The noise is white and Gaussian, added to the 48 kHz audio from the modulator as a sound card would see
+// it after an FM discriminator with a flat response. The signal to noise ratio is the mean power of the
+// modulated audio over that of the noise across the whole 24 kHz, so Eb/N0 at 4800 bit/s is about 7 dB more.
+const wxFloat32 SNRS[] = {2.0F, 0.0F, -2.0F, -3.0F, -4.0F, -5.0F, -6.0F, -7.0F};
+
+const unsigned int FEC_SECTION_LENGTH_BITS = 660U;
+
+// As sent and matched by CSoundCardController
+const unsigned char BIT_SYNC    = 0xAAU;
+const unsigned char FRAME_SYNC0 = 0xEAU;
+const unsigned char FRAME_SYNC1 = 0xA6U;
+const unsigned char FRAME_SYNC2 = 0x00U;
+
+const wxUint32 FRAME_SYNC_DATA = 0x00557650U;
+const wxUint32 FRAME_SYNC_MASK = 0x00FFFFFFU;
+
+const unsigned int PREAMBLE_BYTES = 20U;
+const unsigned int TAIL_BYTES     = 10U;
+const unsigned int TX_BYTES       = PREAMBLE_BYTES + 2U + FEC_SECTION_LENGTH_BYTES + TAIL_BYTES;
+const unsigned int TX_SAMPLES     = TX_BYTES * 8U * DSTAR_RADIO_BIT_LENGTH;
+
+struct CSNRResult {
+	unsigned int m_noSync;
+	unsigned int m_soft;
+	unsigned int m_old;
+};
+
+// A sample of Gaussian noise with the given deviation
+static wxFloat32 noise(wxFloat32 sigma)
+{
+	wxFloat32 u1 = (wxFloat32(::rand()) + 1.0F) / (wxFloat32(RAND_MAX) + 2.0F);
+	wxFloat32 u2 =  wxFloat32(::rand()) / wxFloat32(RAND_MAX);
+
+	return sigma * ::sqrt(-2.0F * ::log(u1)) * ::cos(6.2831853F * u2);
+}
+
+// Sent as the sound card controller writes it: the bit sync preamble, the frame sync and the encoded header
+static unsigned int transmit(const unsigned char* header, wxFloat32* audio)
+{
+	CRadioHeaderFEC fec;
+
+	unsigned char data[TX_BYTES];
+	::memset(data, BIT_SYNC, TX_BYTES);
+
+	fec.encode(header, data + PREAMBLE_BYTES + 2U);
+
+	data[PREAMBLE_BYTES + 0U]  = FRAME_SYNC0;
+	data[PREAMBLE_BYTES + 1U]  = FRAME_SYNC1;
+	data[PREAMBLE_BYTES + 2U] |= FRAME_SYNC2;
+
+	CDStarGMSKModulator modulator;
+	modulator.setLevel(1.0F);
+
+	return modulator.code(data, TX_BYTES, audio, TX_SAMPLES);
+}
+
+// Received as the sound card controller does, up to the soft decisions for the header. The hard decisions
+// are packed as the controller stored them for its old decoder, first bit in the bottom of the first byte.
+static bool receive(const wxFloat32* audio, unsigned int length, wxFloat32* soft, unsigned char* hard)
+{
+	// The demodulator logs its DC offset at every lock
+	wxLogNull noLog;
+
+	CDStarGMSKDemodulator demodulator;
+
+	unsigned char bits[DSTAR_RADIO_BLOCK_SIZE / 8U];
+	wxFloat32 values[DSTAR_RADIO_BLOCK_SIZE];
+
+	::memset(hard, 0x00U, FEC_SECTION_LENGTH_BYTES);
+
+	wxUint32 pattern = 0x00U;
+	bool synced = false;
+	unsigned int count = 0U;
+
+	for (unsigned int offset = 0U; offset < length; offset += DSTAR_RADIO_BLOCK_SIZE) {
+		unsigned int n = length - offset;
+		if (n > DSTAR_RADIO_BLOCK_SIZE)
+			n = DSTAR_RADIO_BLOCK_SIZE;
+
+		unsigned int nBits = demodulator.decode(audio + offset, n, bits, values);
+
+		for (unsigned int i = 0U; i < nBits; i++) {
+			bool bit = (bits[i / 8U] & (0x01U << (i % 8U))) != 0x00U;
+
+			if (!synced) {
+				pattern = (pattern << 1) | (bit ? 0x01U : 0x00U);
+				if ((pattern & FRAME_SYNC_MASK) == FRAME_SYNC_DATA) {
+					demodulator.lock(true);
+					synced = true;
+				}
+			} else {
+				soft[count] = values[i];
+				if (bit)
+					hard[count / 8U] |= 0x01U << (count % 8U);
+
+				if (++count == FEC_SECTION_LENGTH_BITS)
+					return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+static bool decodeSoft(CRadioHeaderFEC& fec, const wxFloat32* soft, const unsigned char* header)
+{
+	unsigned char out[RADIO_HEADER_LENGTH_BYTES];
+	if (!fec.decode(soft, out))
+		return false;
+
+	return ::memcmp(out, header, RADIO_HEADER_LENGTH_BYTES) == 0;
+}
+
+static bool decodeOld(CReferenceRadioHeaderDecoder& decoder, unsigned char* hard, const unsigned char* header)
+{
+	unsigned char out[RADIO_HEADER_LENGTH_BYTES];
+	if (!decoder.decode(hard, out))
+		return false;
+
+	return ::memcmp(out, header, RADIO_HEADER_LENGTH_BYTES) == 0;
+}
+
+static CSNRResult runSNR(wxFloat32 snr, unsigned int trials)
+{
+	CSNRResult result;
+	::memset(&result, 0x00U, sizeof(CSNRResult));
+
+	CRadioHeaderFEC fec;
+	CReferenceRadioHeaderDecoder decoder;
+
+	wxFloat32* audio = new wxFloat32[TX_SAMPLES];
+	wxFloat32 soft[FEC_SECTION_LENGTH_BITS];
+	unsigned char hard[FEC_SECTION_LENGTH_BYTES];
+
+	for (unsigned int i = 0U; i < trials; i++) {
+		unsigned char header[RADIO_HEADER_LENGTH_BYTES];
+		for (unsigned int j = 0U; j < (RADIO_HEADER_LENGTH_BYTES - 2U); j++)
+			header[j] = ::rand() & 0xFFU;
+
+		CCCITTChecksumReverse cksum;
+		cksum.update(header, RADIO_HEADER_LENGTH_BYTES - 2U);
+		cksum.result(header + RADIO_HEADER_LENGTH_BYTES - 2U);
+
+		unsigned int length = transmit(header, audio);
+
+		wxFloat32 power = 0.0F;
+		for (unsigned int j = 0U; j < length; j++)
+			power += audio[j] * audio[j];
+		power /= wxFloat32(length);
+
+		wxFloat32 sigma = ::sqrt(power / ::pow(10.0F, snr / 10.0F));
+		for (unsigned int j = 0U; j < length; j++)
+			audio[j] += noise(sigma);
+
+		if (!receive(audio, length, soft, hard)) {
+			result.m_noSync++;
+			continue;
+		}
+
+		if (decodeSoft(fec, soft, header))
+			result.m_soft++;
+
+		if (decodeOld(decoder, hard, header))
+			result.m_old++;
+	}
+
+	delete[] audio;
+
+	return result;
+}
+
+int run()
+{
+	long trials = CBench::getOption(wxT("trials"));
+
+	wxPrintf(wxT("%ld headers at each SNR in white Gaussian noise, decoded from the same demodulated bits\n"), trials);
+
+	for (unsigned int i = 0U; i < (sizeof(SNRS) / sizeof(SNRS[0])); i++) {
+		CSNRResult result = runSNR(SNRS[i], (unsigned int)trials);
+
+		// The decoders can only be compared on the headers whose frame sync was found
+		unsigned int synced = (unsigned int)trials - result.m_noSync;
+		float scale = synced > 0U ? 100.0F / float(synced) : 0.0F;
+
+		wxPrintf(wxT("SNR %4.1f dB: %4u frame syncs found, %4u decoded by the old hard decoder (%5.1f%%), %4u with soft decisions (%5.1f%%)\n"),
+			SNRS[i], synced, result.m_old, float(result.m_old) * scale, result.m_soft, float(result.m_soft) * scale);
+	}
+
+	return 0;
+}
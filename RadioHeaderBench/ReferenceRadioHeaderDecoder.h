@@ -0,0 +1,47 @@
+/*
+ *   Copyright (C) 2009-2015 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef	ReferenceRadioHeaderDecoder_H
+#define	ReferenceRadioHeaderDecoder_H
+
+#include <wx/wx.h>
+
+// The hard decision header decoder of CSoundCardController before CRadioHeaderFEC, kept here to measure it
+// against. It takes the 660 received bits packed as the controller stored them, and descrambles them in place.
+class CReferenceRadioHeaderDecoder {
+public:
+	CReferenceRadioHeaderDecoder();
+	~CReferenceRadioHeaderDecoder();
+
+	bool decode(unsigned char* in, unsigned char* out);
+
+private:
+	unsigned int  m_mar;
+	int           m_pathMetric[4U];
+	unsigned int  m_pathMemory0[42U];
+	unsigned int  m_pathMemory1[42U];
+	unsigned int  m_pathMemory2[42U];
+	unsigned int  m_pathMemory3[42U];
+	unsigned char m_fecOutput[42U];
+
+	void acs(int* metric);
+	void viterbiDecode(int* data);
+	void traceBack();
+};
+
+#endif